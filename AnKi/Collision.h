@@ -13,6 +13,7 @@
 #include <AnKi/Collision/ConvexHullShape.h>
 #include <AnKi/Collision/Ray.h>
 #include <AnKi/Collision/Cone.h>
+#include <AnKi/Collision/ShapeSoa.h>
 
 #include <AnKi/Collision/Functions.h>
 
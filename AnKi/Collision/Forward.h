@@ -15,5 +15,8 @@ class Aabb;
 class ConvexHullShape;
 class Ray;
 class Cone;
+class AabbSoa;
+class SphereSoa;
+class ObbSoa;
 
 } // end namespace anki
@@ -207,6 +207,37 @@ inline F32 testCollisionInside(const Aabb& aabb, const Ray& ray)
 #undef ANKI_DEF_TEST_COLLISION_FUNC
 #undef ANKI_DEF_TEST_COLLISION_FUNC_PLANE
 
+// Batched. They test one shape against many shapes that are stored as structure of arrays and they process 4 shapes at a time. The variants
+// with the bitmask set one bit per shape (the array needs (count + 63) / 64 elements). The variants with the indices write the indices of the
+// colliding shapes and return their number. If the indices don't fit the remaining are dropped but they are still counted.
+
+void testCollision(const Aabb& a, const AabbSoa& b, WeakArray<U64> hitMask);
+U32 testCollision(const Aabb& a, const AabbSoa& b, WeakArray<U32> hitIndices);
+void testCollision(const Aabb& a, const SphereSoa& b, WeakArray<U64> hitMask);
+U32 testCollision(const Aabb& a, const SphereSoa& b, WeakArray<U32> hitIndices);
+void testCollision(const Aabb& a, const ObbSoa& b, WeakArray<U64> hitMask);
+U32 testCollision(const Aabb& a, const ObbSoa& b, WeakArray<U32> hitIndices);
+void testCollision(const Sphere& a, const AabbSoa& b, WeakArray<U64> hitMask);
+U32 testCollision(const Sphere& a, const AabbSoa& b, WeakArray<U32> hitIndices);
+void testCollision(const Sphere& a, const SphereSoa& b, WeakArray<U64> hitMask);
+U32 testCollision(const Sphere& a, const SphereSoa& b, WeakArray<U32> hitIndices);
+void testCollision(const Sphere& a, const ObbSoa& b, WeakArray<U64> hitMask);
+U32 testCollision(const Sphere& a, const ObbSoa& b, WeakArray<U32> hitIndices);
+
+/// Batched testPlane. Writes one distance per shape to an array that holds at least the number of shapes.
+void testPlane(const Plane& plane, const AabbSoa& shapes, WeakArray<F32> distances);
+
+/// @copydoc testPlane(const Plane&, const AabbSoa&, WeakArray<F32>)
+void testPlane(const Plane& plane, const SphereSoa& shapes, WeakArray<F32> distances);
+
+/// @copydoc testPlane(const Plane&, const AabbSoa&, WeakArray<F32>)
+void testPlane(const Plane& plane, const ObbSoa& shapes, WeakArray<F32> distances);
+
+/// Broadphase that finds all the colliding pairs between 2 sets of AABBs. The pairs are (index in a, index in b). Returns the number of pairs.
+/// If they don't fit the remaining are dropped but they are still counted. It's a brute force O(N*M) test so it's meant for sets of up to a
+/// few thousand boxes.
+U32 findCollidingPairs(const AabbSoa& a, const AabbSoa& b, WeakArray<Array<U32, 2>> pairs);
+
 /// Get the min distance of a point to a plane.
 inline F32 getPlanePointDistance(const Plane& plane, const Vec4& point)
 {
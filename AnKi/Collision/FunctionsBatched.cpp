@@ -0,0 +1,420 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Collision/Functions.h>
+#include <AnKi/Collision/ShapeSoa.h>
+#include <AnKi/Collision/Sphere.h>
+
+namespace anki {
+
+constexpr U32 kLaneCount = F32x4::kLaneCount;
+
+/// Load 4 elements starting from i. The lanes past the end are zero.
+static F32x4 loadLanes(const F32* arr, U32 i, U32 count)
+{
+	if(i + kLaneCount <= count) [[likely]]
+	{
+		return F32x4::load(arr + i);
+	}
+
+	Array<F32, kLaneCount> tmp = {};
+	for(U32 l = 0; i + l < count; ++l)
+	{
+		tmp[l] = arr[i + l];
+	}
+	return F32x4::load(tmp.getBegin());
+}
+
+/// The bits of the lanes that are not past the end.
+static U32 validLanesMask(U32 i, U32 count)
+{
+	const U32 validCount = min(kLaneCount, count - i);
+	return (1u << validCount) - 1u;
+}
+
+/// Run a test that returns a lane mask for every 4 shapes and write the results to a bitmask.
+template<typename TTestFunc>
+static void batchTest(U32 count, WeakArray<U64> hitMask, TTestFunc test)
+{
+	const U32 wordCount = (count + 63) / 64;
+	ANKI_ASSERT(hitMask.getSize() >= wordCount);
+	memset(hitMask.getBegin(), 0, wordCount * sizeof(U64));
+
+	for(U32 i = 0; i < count; i += kLaneCount)
+	{
+		const U32 mask = test(i) & validLanesMask(i, count);
+		hitMask[i / 64] |= U64(mask) << (i % 64);
+	}
+}
+
+/// Same as above but write indices.
+template<typename TTestFunc>
+static U32 batchTest(U32 count, WeakArray<U32> hitIndices, TTestFunc test)
+{
+	U32 hitCount = 0;
+	for(U32 i = 0; i < count; i += kLaneCount)
+	{
+		U32 mask = test(i) & validLanesMask(i, count);
+		while(mask)
+		{
+			const U32 lane = U32(__builtin_ctzll(mask));
+			mask &= mask - 1;
+
+			if(hitCount < hitIndices.getSize())
+			{
+				hitIndices[hitCount] = i + lane;
+			}
+			++hitCount;
+		}
+	}
+
+	return hitCount;
+}
+
+/// The lanes of an AABB.
+class AabbLanes
+{
+public:
+	Array<F32x4, 3> m_min;
+	Array<F32x4, 3> m_max;
+
+	AabbLanes(const Aabb& aabb)
+	{
+		for(U32 c = 0; c < 3; ++c)
+		{
+			m_min[c] = F32x4(aabb.getMin()[c]);
+			m_max[c] = F32x4(aabb.getMax()[c]);
+		}
+	}
+
+	AabbLanes(const AabbSoa& aabbs, U32 i)
+	{
+		for(U32 c = 0; c < 3; ++c)
+		{
+			m_min[c] = loadLanes(aabbs.m_min[c], i, aabbs.m_count);
+			m_max[c] = loadLanes(aabbs.m_max[c], i, aabbs.m_count);
+		}
+	}
+};
+
+/// The lanes of a sphere.
+class SphereLanes
+{
+public:
+	Array<F32x4, 3> m_center;
+	F32x4 m_radius;
+
+	SphereLanes(const Sphere& sphere)
+	{
+		for(U32 c = 0; c < 3; ++c)
+		{
+			m_center[c] = F32x4(sphere.getCenter()[c]);
+		}
+		m_radius = F32x4(sphere.getRadius());
+	}
+
+	SphereLanes(const SphereSoa& spheres, U32 i)
+	{
+		for(U32 c = 0; c < 3; ++c)
+		{
+			m_center[c] = loadLanes(spheres.m_center[c], i, spheres.m_count);
+		}
+		m_radius = loadLanes(spheres.m_radius, i, spheres.m_count);
+	}
+};
+
+/// The lanes of an OBB.
+class ObbLanes
+{
+public:
+	Array<F32x4, 3> m_center;
+	Array<Array<F32x4, 3>, 3> m_rotation; ///< [row][column]
+	Array<F32x4, 3> m_extend;
+
+	ObbLanes(const ObbSoa& obbs, U32 i)
+	{
+		for(U32 c = 0; c < 3; ++c)
+		{
+			m_center[c] = loadLanes(obbs.m_center[c], i, obbs.m_count);
+			m_extend[c] = loadLanes(obbs.m_extend[c], i, obbs.m_count);
+		}
+
+		for(U32 r = 0; r < 3; ++r)
+		{
+			for(U32 c = 0; c < 3; ++c)
+			{
+				m_rotation[r][c] = loadLanes(obbs.m_rotation[r * 3 + c], i, obbs.m_count);
+			}
+		}
+	}
+};
+
+static U32 testAabbAabb(const AabbLanes& a, const AabbLanes& b)
+{
+	F32x4 hit = (a.m_min[0] <= b.m_max[0]) & (b.m_min[0] <= a.m_max[0]);
+	hit = hit & (a.m_min[1] <= b.m_max[1]) & (b.m_min[1] <= a.m_max[1]);
+	hit = hit & (a.m_min[2] <= b.m_max[2]) & (b.m_min[2] <= a.m_max[2]);
+	return hit.getMask();
+}
+
+static U32 testAabbSphere(const AabbLanes& a, const SphereLanes& b)
+{
+	// Distance of the center to the closest point of the box
+	F32x4 distSq(0.0f);
+	for(U32 c = 0; c < 3; ++c)
+	{
+		const F32x4 d = b.m_center[c] - b.m_center[c].max(a.m_min[c]).min(a.m_max[c]);
+		distSq = distSq + d * d;
+	}
+
+	return (distSq <= b.m_radius * b.m_radius).getMask();
+}
+
+static U32 testSphereSphere(const SphereLanes& a, const SphereLanes& b)
+{
+	F32x4 distSq(0.0f);
+	for(U32 c = 0; c < 3; ++c)
+	{
+		const F32x4 d = a.m_center[c] - b.m_center[c];
+		distSq = distSq + d * d;
+	}
+
+	const F32x4 radius = a.m_radius + b.m_radius;
+	return (distSq <= radius * radius).getMask();
+}
+
+static U32 testSphereObb(const SphereLanes& a, const ObbLanes& b)
+{
+	// Move the center of the sphere to the space of the OBB and find its distance to the box
+	const Array<F32x4, 3> d = {a.m_center[0] - b.m_center[0], a.m_center[1] - b.m_center[1], a.m_center[2] - b.m_center[2]};
+	F32x4 distSq(0.0f);
+	for(U32 c = 0; c < 3; ++c)
+	{
+		const F32x4 local = d[0] * b.m_rotation[0][c] + d[1] * b.m_rotation[1][c] + d[2] * b.m_rotation[2][c];
+		const F32x4 diff = local - local.max(F32x4(0.0f) - b.m_extend[c]).min(b.m_extend[c]);
+		distSq = distSq + diff * diff;
+	}
+
+	return (distSq <= a.m_radius * a.m_radius).getMask();
+}
+
+/// Separating axis test. See "Real-Time Collision Detection" 4.4.1. Since the first box is axis aligned its rotation is the identity.
+static U32 testAabbObb(const AabbLanes& a, const ObbLanes& b)
+{
+	const F32x4 half(0.5f);
+	Array<F32x4, 3> ea; // Extends of A
+	Array<F32x4, 3> t; // Translation from A to B
+	for(U32 c = 0; c < 3; ++c)
+	{
+		ea[c] = (a.m_max[c] - a.m_min[c]) * half;
+		t[c] = b.m_center[c] - (a.m_max[c] + a.m_min[c]) * half;
+	}
+
+	// Add an epsilon to counteract the arithmetic errors when 2 edges are parallel
+	const F32x4 epsilon(kEpsilonf);
+	Array<Array<F32x4, 3>, 3> absR;
+	for(U32 i = 0; i < 3; ++i)
+	{
+		for(U32 j = 0; j < 3; ++j)
+		{
+			absR[i][j] = b.m_rotation[i][j].abs() + epsilon;
+		}
+	}
+
+	F32x4 separated(0.0f);
+
+	// The axes of A
+	for(U32 i = 0; i < 3; ++i)
+	{
+		const F32x4 rb = b.m_extend[0] * absR[i][0] + b.m_extend[1] * absR[i][1] + b.m_extend[2] * absR[i][2];
+		separated = separated | (t[i].abs() > ea[i] + rb);
+	}
+
+	// The axes of B
+	for(U32 j = 0; j < 3; ++j)
+	{
+		const F32x4 ra = ea[0] * absR[0][j] + ea[1] * absR[1][j] + ea[2] * absR[2][j];
+		const F32x4 dist = t[0] * b.m_rotation[0][j] + t[1] * b.m_rotation[1][j] + t[2] * b.m_rotation[2][j];
+		separated = separated | (dist.abs() > ra + b.m_extend[j]);
+	}
+
+	// The cross products of the axes
+	for(U32 i = 0; i < 3; ++i)
+	{
+		const U32 i1 = (i + 1) % 3;
+		const U32 i2 = (i + 2) % 3;
+		for(U32 j = 0; j < 3; ++j)
+		{
+			const U32 j1 = (j + 1) % 3;
+			const U32 j2 = (j + 2) % 3;
+			const F32x4 ra = ea[i1] * absR[i2][j] + ea[i2] * absR[i1][j];
+			const F32x4 rb = b.m_extend[j1] * absR[i][j2] + b.m_extend[j2] * absR[i][j1];
+			const F32x4 dist = t[i2] * b.m_rotation[i1][j] - t[i1] * b.m_rotation[i2][j];
+			separated = separated | (dist.abs() > ra + rb);
+		}
+	}
+
+	return ~separated.getMask() & 0xFu;
+}
+
+#define ANKI_DEF_BATCHED_TEST(TQuery, TQueryLanes, TSoa, TSoaLanes, testFunc) \
+	void testCollision(const TQuery& a, const TSoa& b, WeakArray<U64> hitMask) \
+	{ \
+		const TQueryLanes lanesA(a); \
+		batchTest(b.m_count, hitMask, [&](U32 i) { \
+			return testFunc(lanesA, TSoaLanes(b, i)); \
+		}); \
+	} \
+	U32 testCollision(const TQuery& a, const TSoa& b, WeakArray<U32> hitIndices) \
+	{ \
+		const TQueryLanes lanesA(a); \
+		return batchTest(b.m_count, hitIndices, [&](U32 i) { \
+			return testFunc(lanesA, TSoaLanes(b, i)); \
+		}); \
+	}
+
+ANKI_DEF_BATCHED_TEST(Aabb, AabbLanes, AabbSoa, AabbLanes, testAabbAabb)
+ANKI_DEF_BATCHED_TEST(Aabb, AabbLanes, SphereSoa, SphereLanes, testAabbSphere)
+ANKI_DEF_BATCHED_TEST(Aabb, AabbLanes, ObbSoa, ObbLanes, testAabbObb)
+ANKI_DEF_BATCHED_TEST(Sphere, SphereLanes, SphereSoa, SphereLanes, testSphereSphere)
+ANKI_DEF_BATCHED_TEST(Sphere, SphereLanes, ObbSoa, ObbLanes, testSphereObb)
+
+#undef ANKI_DEF_BATCHED_TEST
+
+void testCollision(const Sphere& a, const AabbSoa& b, WeakArray<U64> hitMask)
+{
+	const SphereLanes lanesA(a);
+	batchTest(b.m_count, hitMask, [&](U32 i) {
+		return testAabbSphere(AabbLanes(b, i), lanesA);
+	});
+}
+
+U32 testCollision(const Sphere& a, const AabbSoa& b, WeakArray<U32> hitIndices)
+{
+	const SphereLanes lanesA(a);
+	return batchTest(b.m_count, hitIndices, [&](U32 i) {
+		return testAabbSphere(AabbLanes(b, i), lanesA);
+	});
+}
+
+/// Write the distances of 4 shapes without going past the end of the array.
+static void storeDistances(F32x4 dist, U32 i, U32 count, WeakArray<F32> distances)
+{
+	if(i + kLaneCount <= count) [[likely]]
+	{
+		dist.store(&distances[i]);
+	}
+	else
+	{
+		Array<F32, kLaneCount> tmp;
+		dist.store(tmp.getBegin());
+		for(U32 l = 0; i + l < count; ++l)
+		{
+			distances[i + l] = tmp[l];
+		}
+	}
+}
+
+/// Given the distance of the center of a shape from a plane and the extend of the shape along the normal compute the same as testPlane.
+static F32x4 planeDistance(F32x4 centerDist, F32x4 extend)
+{
+	const F32x4 zero(0.0f);
+	const F32x4 outside = centerDist - extend;
+	const F32x4 inside = centerDist + extend;
+	return F32x4::select(outside > zero, outside, F32x4::select(inside < zero, inside, zero));
+}
+
+void testPlane(const Plane& plane, const AabbSoa& shapes, WeakArray<F32> distances)
+{
+	ANKI_ASSERT(distances.getSize() >= shapes.m_count);
+
+	const Array<F32x4, 3> normal = {F32x4(plane.getNormal().x()), F32x4(plane.getNormal().y()), F32x4(plane.getNormal().z())};
+	const Array<F32x4, 3> absNormal = {normal[0].abs(), normal[1].abs(), normal[2].abs()};
+	const F32x4 offset(plane.getOffset());
+	const F32x4 half(0.5f);
+
+	for(U32 i = 0; i < shapes.m_count; i += kLaneCount)
+	{
+		const AabbLanes aabb(shapes, i);
+		F32x4 centerDist = F32x4(0.0f) - offset;
+		F32x4 extend(0.0f);
+		for(U32 c = 0; c < 3; ++c)
+		{
+			centerDist = centerDist + normal[c] * (aabb.m_max[c] + aabb.m_min[c]) * half;
+			extend = extend + absNormal[c] * (aabb.m_max[c] - aabb.m_min[c]) * half;
+		}
+
+		storeDistances(planeDistance(centerDist, extend), i, shapes.m_count, distances);
+	}
+}
+
+void testPlane(const Plane& plane, const SphereSoa& shapes, WeakArray<F32> distances)
+{
+	ANKI_ASSERT(distances.getSize() >= shapes.m_count);
+
+	const Array<F32x4, 3> normal = {F32x4(plane.getNormal().x()), F32x4(plane.getNormal().y()), F32x4(plane.getNormal().z())};
+	const F32x4 offset(plane.getOffset());
+
+	for(U32 i = 0; i < shapes.m_count; i += kLaneCount)
+	{
+		const SphereLanes sphere(shapes, i);
+		const F32x4 centerDist = normal[0] * sphere.m_center[0] + normal[1] * sphere.m_center[1] + normal[2] * sphere.m_center[2] - offset;
+		storeDistances(planeDistance(centerDist, sphere.m_radius), i, shapes.m_count, distances);
+	}
+}
+
+void testPlane(const Plane& plane, const ObbSoa& shapes, WeakArray<F32> distances)
+{
+	ANKI_ASSERT(distances.getSize() >= shapes.m_count);
+
+	const Array<F32x4, 3> normal = {F32x4(plane.getNormal().x()), F32x4(plane.getNormal().y()), F32x4(plane.getNormal().z())};
+	const F32x4 offset(plane.getOffset());
+
+	for(U32 i = 0; i < shapes.m_count; i += kLaneCount)
+	{
+		const ObbLanes obb(shapes, i);
+		const F32x4 centerDist = normal[0] * obb.m_center[0] + normal[1] * obb.m_center[1] + normal[2] * obb.m_center[2] - offset;
+
+		// The extend along the normal. Project the normal to every axis of the box
+		F32x4 extend(0.0f);
+		for(U32 c = 0; c < 3; ++c)
+		{
+			const F32x4 proj = normal[0] * obb.m_rotation[0][c] + normal[1] * obb.m_rotation[1][c] + normal[2] * obb.m_rotation[2][c];
+			extend = extend + (proj * obb.m_extend[c]).abs();
+		}
+
+		storeDistances(planeDistance(centerDist, extend), i, shapes.m_count, distances);
+	}
+}
+
+U32 findCollidingPairs(const AabbSoa& a, const AabbSoa& b, WeakArray<Array<U32, 2>> pairs)
+{
+	U32 pairCount = 0;
+	for(U32 ia = 0; ia < a.m_count; ++ia)
+	{
+		const Aabb aabbA(Vec3(a.m_min[0][ia], a.m_min[1][ia], a.m_min[2][ia]), Vec3(a.m_max[0][ia], a.m_max[1][ia], a.m_max[2][ia]));
+		const AabbLanes lanesA(aabbA);
+
+		for(U32 ib = 0; ib < b.m_count; ib += kLaneCount)
+		{
+			U32 mask = testAabbAabb(lanesA, AabbLanes(b, ib)) & validLanesMask(ib, b.m_count);
+			while(mask)
+			{
+				const U32 lane = U32(__builtin_ctzll(mask));
+				mask &= mask - 1;
+
+				if(pairCount < pairs.getSize())
+				{
+					pairs[pairCount] = {ia, ib + lane};
+				}
+				++pairCount;
+			}
+		}
+	}
+
+	return pairCount;
+}
+
+} // end namespace anki
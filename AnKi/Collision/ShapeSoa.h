@@ -0,0 +1,49 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Collision/Common.h>
+#include <AnKi/Util/Array.h>
+
+namespace anki {
+
+/// @addtogroup collision
+/// @{
+
+/// Many AABBs stored as structure of arrays. It doesn't own the memory. All arrays hold m_count elements and they don't need to be aligned or
+/// padded. Used by the batched testCollision and testPlane functions.
+class AabbSoa
+{
+public:
+	Array<const F32*, 3> m_min = {}; ///< The X, Y and Z of the min corners.
+	Array<const F32*, 3> m_max = {}; ///< The X, Y and Z of the max corners.
+	U32 m_count = 0;
+};
+
+/// Many spheres stored as structure of arrays. See AabbSoa.
+class SphereSoa
+{
+public:
+	Array<const F32*, 3> m_center = {};
+	const F32* m_radius = nullptr;
+	U32 m_count = 0;
+};
+
+/// Many OBBs stored as structure of arrays. See AabbSoa.
+class ObbSoa
+{
+public:
+	Array<const F32*, 3> m_center = {};
+
+	/// The 3x3 rotation in row major order. The columns are the axes of the boxes (like Obb::getRotation()).
+	Array<const F32*, 9> m_rotation = {};
+
+	Array<const F32*, 3> m_extend = {};
+	U32 m_count = 0;
+};
+/// @}
+
+} // end namespace anki
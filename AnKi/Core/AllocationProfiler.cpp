@@ -0,0 +1,256 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Core/AllocationProfiler.h>
+#include <AnKi/Util/File.h>
+#include <AnKi/Util/System.h>
+#include <AnKi/Util/Hash.h>
+#include <algorithm>
+
+namespace anki {
+
+/// It's placed right before the memory that is returned to the pool.
+class AllocationProfiler::AllocationHeader
+{
+public:
+	void* m_base; ///< What the underlying callback returned.
+	PtrSize m_size;
+	Pool* m_pool;
+	Site* m_site;
+};
+
+AllocationProfiler::AllocationProfiler(AllocAlignedCallback allocCb, void* allocCbUserData)
+	: m_allocCb(allocCb)
+	, m_allocCbUserData(allocCbUserData)
+	, m_stackSampling(g_allocationProfilerStackSamplingCVar)
+{
+	ANKI_ASSERT(allocCb);
+
+	if(m_stackSampling)
+	{
+		m_sites = static_cast<Site*>(m_allocCb(m_allocCbUserData, nullptr, sizeof(Site) * kMaxSites, alignof(Site)));
+		for(U32 i = 0; i < kMaxSites; ++i)
+		{
+			callConstructor(m_sites[i]);
+		}
+	}
+
+	ANKI_CORE_LOGI("Allocation profiler enabled. Sampling the call stack of every %u allocations", m_stackSampling);
+}
+
+AllocationProfiler::~AllocationProfiler()
+{
+	if(m_sites)
+	{
+		for(U32 i = 0; i < kMaxSites; ++i)
+		{
+			callDestructor(m_sites[i]);
+		}
+
+		m_allocCb(m_allocCbUserData, m_sites, 0, 0);
+	}
+}
+
+void AllocationProfiler::getPoolAllocationCallback(CString poolName, AllocAlignedCallback& allocCb, void*& allocCbUserData)
+{
+	if(m_poolCount == kMaxPools)
+	{
+		ANKI_CORE_LOGW("Too many pools. The allocations of %s won't be profiled", poolName.cstr());
+		allocCb = m_allocCb;
+		allocCbUserData = m_allocCbUserData;
+		return;
+	}
+
+	Pool& pool = m_pools[m_poolCount++];
+	pool.m_profiler = this;
+	pool.m_name = poolName;
+
+	allocCb = allocCallback;
+	allocCbUserData = &pool;
+}
+
+void* AllocationProfiler::allocCallback(void* userData, void* ptr, PtrSize size, PtrSize alignment)
+{
+	ANKI_ASSERT(userData);
+	Pool& pool = *static_cast<Pool*>(userData);
+	AllocationProfiler& self = *pool.m_profiler;
+
+	if(ptr == nullptr)
+	{
+		// Allocate. Put the header right before the user memory while keeping the alignment
+		static_assert(isPowerOfTwo(sizeof(AllocationHeader)), "The padding needs to be a multiple of the alignment");
+		ANKI_ASSERT(size > 0 && isPowerOfTwo(alignment));
+		const PtrSize padding = max(alignment, sizeof(AllocationHeader));
+		U8* base = static_cast<U8*>(self.m_allocCb(self.m_allocCbUserData, nullptr, size + padding, max(alignment, alignof(AllocationHeader))));
+		if(base == nullptr) [[unlikely]]
+		{
+			return nullptr;
+		}
+
+		Site* site = nullptr;
+		if(self.m_stackSampling)
+		{
+			thread_local U32 allocationCount = 0;
+			if(++allocationCount >= self.m_stackSampling)
+			{
+				allocationCount = 0;
+				site = self.findOrCreateSite(U32(&pool - &self.m_pools[0]));
+			}
+		}
+
+		U8* out = base + padding;
+		AllocationHeader& header = *(reinterpret_cast<AllocationHeader*>(out) - 1);
+		header.m_base = base;
+		header.m_size = size;
+		header.m_pool = &pool;
+		header.m_site = site;
+
+		pool.m_counters.allocated(size);
+		if(site)
+		{
+			site->m_counters.allocated(size);
+		}
+
+		return out;
+	}
+	else
+	{
+		// Free
+		const AllocationHeader& header = *(static_cast<const AllocationHeader*>(ptr) - 1);
+		ANKI_ASSERT(header.m_pool == &pool);
+
+		pool.m_counters.freed(header.m_size);
+		if(header.m_site)
+		{
+			header.m_site->m_counters.freed(header.m_size);
+		}
+
+		self.m_allocCb(self.m_allocCbUserData, header.m_base, 0, 0);
+		return nullptr;
+	}
+}
+
+AllocationProfiler::Site* AllocationProfiler::findOrCreateSite(U32 poolIndex)
+{
+	Array<void*, kMaxSiteFrames> frames;
+	const U32 frameCount = getBacktraceAddresses(frames);
+	if(frameCount == 0)
+	{
+		return nullptr;
+	}
+
+	U64 hash = computeHash(&frames[0], frameCount * sizeof(void*), poolIndex + 1);
+	hash = (hash) ? hash : 1; // Zero means empty
+
+	for(U32 i = 0; i < kMaxSites; ++i)
+	{
+		Site& site = m_sites[(hash + i) & (kMaxSites - 1)];
+
+		U64 siteHash = site.m_hash.load();
+		while(siteHash == 0)
+		{
+			if(site.m_hash.compareExchange(siteHash, hash))
+			{
+				// Claimed it
+				site.m_poolIndex = poolIndex;
+				site.m_frameCount = frameCount;
+				memcpy(&site.m_frames[0], &frames[0], frameCount * sizeof(void*));
+				site.m_ready.store(1);
+				return &site;
+			}
+		}
+
+		if(siteHash == hash)
+		{
+			return &site;
+		}
+	}
+
+	// Full
+	return nullptr;
+}
+
+void AllocationProfiler::endFrame()
+{
+	for(U32 i = 0; i < m_poolCount; ++i)
+	{
+		m_pools[i].m_counters.endFrame();
+	}
+
+	m_frameAllocatingSiteCount = 0;
+	if(m_sites)
+	{
+		for(U32 i = 0; i < kMaxSites; ++i)
+		{
+			if(m_sites[i].m_ready.load())
+			{
+				m_sites[i].m_counters.endFrame();
+				m_frameAllocatingSiteCount += m_sites[i].m_counters.m_lastFrameAllocationCount > 0;
+			}
+		}
+	}
+}
+
+Error AllocationProfiler::dump(CString filename) const
+{
+	File file;
+	ANKI_CHECK(file.open(filename, FileOpenFlag::kWrite));
+
+	ANKI_CHECK(file.writeText("Pool,Live bytes,Allocations,Allocations last frame,Frees last frame\n"));
+	Error err = Error::kNone;
+	iteratePools([&](CString name, const AllocationProfilerStats& stats) {
+		if(!err)
+		{
+			err = file.writeTextf("%s,%" PRIi64 ",%" PRIu64 ",%u,%u\n", name.cstr(), stats.m_liveBytes, stats.m_allocationCount,
+								  stats.m_frameAllocationCount, stats.m_frameFreeCount);
+		}
+	});
+	ANKI_CHECK(err);
+
+	if(m_sites)
+	{
+		// Sort the sites by the churn of the last frame and then by the total allocations
+		CoreDynamicArray<const Site*> sites;
+		for(U32 i = 0; i < kMaxSites; ++i)
+		{
+			if(m_sites[i].m_ready.load())
+			{
+				sites.emplaceBack(&m_sites[i]);
+			}
+		}
+
+		std::sort(sites.getBegin(), sites.getEnd(), [](const Site* a, const Site* b) {
+			if(a->m_counters.m_lastFrameAllocationCount != b->m_counters.m_lastFrameAllocationCount)
+			{
+				return a->m_counters.m_lastFrameAllocationCount > b->m_counters.m_lastFrameAllocationCount;
+			}
+
+			return a->m_counters.m_allocationCount.load() > b->m_counters.m_allocationCount.load();
+		});
+
+		ANKI_CHECK(file.writeTextf("\nCall sites. Sampled every %u allocations so multiply the counts to get estimates\n", m_stackSampling));
+		for(const Site* site : sites)
+		{
+			AllocationProfilerStats stats;
+			site->m_counters.get(stats);
+			ANKI_CHECK(file.writeTextf("\nPool %s, live bytes %" PRIi64 ", allocations %" PRIu64 ", allocations last frame %u, frees last frame %u\n",
+									   m_pools[site->m_poolIndex].m_name.cstr(), stats.m_liveBytes, stats.m_allocationCount,
+									   stats.m_frameAllocationCount, stats.m_frameFreeCount));
+
+			resolveBacktraceAddresses(ConstWeakArray<void*>(&site->m_frames[0], site->m_frameCount), [&](CString symbol) {
+				if(!err)
+				{
+					err = file.writeTextf("\t%s\n", symbol.cstr());
+				}
+			});
+			ANKI_CHECK(err);
+		}
+	}
+
+	ANKI_CORE_LOGI("Allocation profile written to: %s", filename.cstr());
+	return Error::kNone;
+}
+
+} // end namespace anki
@@ -0,0 +1,155 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Core/Common.h>
+#include <AnKi/Util/CVarSet.h>
+#include <AnKi/Util/Atomic.h>
+
+namespace anki {
+
+/// @addtogroup core
+/// @{
+
+inline BoolCVar g_allocationProfilerCVar("Core", "AllocationProfiler", false, "Track the CPU allocations per memory pool and per call site");
+inline NumericCVar<U32> g_allocationProfilerStackSamplingCVar("Core", "AllocationProfilerStackSampling", 0, 0, kMaxU32,
+															  "Capture the call stack of every Nth allocation. 0 disables it");
+
+/// Statistics of the CPU allocations of a memory pool or a call site.
+class AllocationProfilerStats
+{
+public:
+	I64 m_liveBytes = 0;
+	U64 m_allocationCount = 0; ///< Since the start.
+	U32 m_frameAllocationCount = 0; ///< In the last frame.
+	U32 m_frameFreeCount = 0; ///< In the last frame.
+};
+
+/// An opt-in profiler that sits between the memory pools and the allocation callback. It tags the allocations with the pool that owns them and
+/// it optionally captures the call stack of some of them. The counters are kept in fixed tables that are updated without locks.
+class AllocationProfiler : public MakeSingleton<AllocationProfiler>
+{
+	template<typename>
+	friend class MakeSingleton;
+
+public:
+	/// Get the callback and the user data a memory pool should use so its allocations are profiled. Not thread-safe, call it during init.
+	/// @param poolName The name of the pool. It should outlive the profiler.
+	void getPoolAllocationCallback(CString poolName, AllocAlignedCallback& allocCb, void*& allocCbUserData);
+
+	/// Call it once per frame to gather the per frame counters.
+	void endFrame();
+
+	/// Iterate the pools.
+	template<typename TFunc>
+	void iteratePools(TFunc func) const
+	{
+		for(U32 i = 0; i < m_poolCount; ++i)
+		{
+			AllocationProfilerStats stats;
+			m_pools[i].m_counters.get(stats);
+			func(m_pools[i].m_name, stats);
+		}
+	}
+
+	/// Number of call sites that allocated in the last frame.
+	U32 getFrameAllocatingSiteCount() const
+	{
+		return m_frameAllocatingSiteCount;
+	}
+
+	/// Write the counters of all pools and sites to a text file. The sites are sorted by the allocations of the last frame and their call stacks
+	/// get resolved.
+	Error dump(CString filename) const;
+
+private:
+	static constexpr U32 kMaxPools = 32;
+	static constexpr U32 kMaxSites = 4 * 1024; ///< Power of two.
+	static constexpr U32 kMaxSiteFrames = 16;
+
+	class AllocationHeader;
+
+	class Counters
+	{
+	public:
+		Atomic<I64> m_liveBytes = {0};
+		Atomic<U64> m_allocationCount = {0};
+		Atomic<U32> m_frameAllocationCount = {0};
+		Atomic<U32> m_frameFreeCount = {0};
+		U32 m_lastFrameAllocationCount = 0;
+		U32 m_lastFrameFreeCount = 0;
+
+		void allocated(PtrSize size)
+		{
+			m_liveBytes.fetchAdd(I64(size));
+			m_allocationCount.fetchAdd(1);
+			m_frameAllocationCount.fetchAdd(1);
+		}
+
+		void freed(PtrSize size)
+		{
+			m_liveBytes.fetchSub(I64(size));
+			m_frameFreeCount.fetchAdd(1);
+		}
+
+		void endFrame()
+		{
+			m_lastFrameAllocationCount = m_frameAllocationCount.exchange(0);
+			m_lastFrameFreeCount = m_frameFreeCount.exchange(0);
+		}
+
+		void get(AllocationProfilerStats& stats) const
+		{
+			stats.m_liveBytes = m_liveBytes.load();
+			stats.m_allocationCount = m_allocationCount.load();
+			stats.m_frameAllocationCount = m_lastFrameAllocationCount;
+			stats.m_frameFreeCount = m_lastFrameFreeCount;
+		}
+	};
+
+	class Pool
+	{
+	public:
+		AllocationProfiler* m_profiler = nullptr;
+		CString m_name;
+		Counters m_counters;
+	};
+
+	/// A call site. It's inserted into an open addressing hash table. The thread that claims the hash also writes the frames and then marks it
+	/// ready.
+	class Site
+	{
+	public:
+		Atomic<U64> m_hash = {0};
+		Atomic<U32> m_ready = {0};
+		U32 m_poolIndex = 0;
+		U32 m_frameCount = 0;
+		Array<void*, kMaxSiteFrames> m_frames;
+		Counters m_counters;
+	};
+
+	AllocAlignedCallback m_allocCb = nullptr;
+	void* m_allocCbUserData = nullptr;
+	U32 m_stackSampling = 0;
+
+	Array<Pool, kMaxPools> m_pools;
+	U32 m_poolCount = 0;
+
+	Site* m_sites = nullptr; ///< A big array so allocate it.
+	U32 m_frameAllocatingSiteCount = 0;
+
+	/// @param allocCb The callback the profiled allocations will end up to.
+	AllocationProfiler(AllocAlignedCallback allocCb, void* allocCbUserData);
+
+	~AllocationProfiler();
+
+	static void* allocCallback(void* userData, void* ptr, PtrSize size, PtrSize alignment);
+
+	Site* findOrCreateSite(U32 poolIndex);
+};
+/// @}
+
+} // end namespace anki
@@ -14,6 +14,8 @@
 #include <AnKi/Util/Tracer.h>
 #include <AnKi/Util/HighRezTimer.h>
 #include <AnKi/Core/CoreTracer.h>
+#include <AnKi/Core/FrameReplay.h>
+#include <AnKi/Core/AllocationProfiler.h>
 #include <AnKi/Core/GpuMemory/RebarTransientMemoryPool.h>
 #include <AnKi/Core/GpuMemory/GpuVisibleTransientMemoryPool.h>
 #include <AnKi/Core/GpuMemory/GpuReadbackMemoryPool.h>
@@ -44,9 +46,9 @@ namespace anki {
 android_app* g_androidApp = nullptr;
 #endif
 
-StatCounter g_cpuAllocatedMemStatVar(StatCategory::kCpuMem, "Total", StatFlag::kBytes);
-StatCounter g_cpuAllocationCountStatVar(StatCategory::kCpuMem, "Allocations/frame", StatFlag::kBytes | StatFlag::kZeroEveryFrame);
-StatCounter g_cpuFreesCountStatVar(StatCategory::kCpuMem, "Frees/frame", StatFlag::kBytes | StatFlag::kZeroEveryFrame);
+ThreadedStatCounter g_cpuAllocatedMemStatVar(StatCategory::kCpuMem, "Total", StatFlag::kBytes);
+ThreadedStatCounter g_cpuAllocationCountStatVar(StatCategory::kCpuMem, "Allocations/frame", StatFlag::kBytes | StatFlag::kZeroEveryFrame);
+ThreadedStatCounter g_cpuFreesCountStatVar(StatCategory::kCpuMem, "Frees/frame", StatFlag::kBytes | StatFlag::kZeroEveryFrame);
 
 #if ANKI_PLATFORM_MOBILE
 inline StatCounter g_maliGpuActiveStatVar(StatCategory::kGpuMisc, "Mali active cycles", StatFlag::kMainThreadUpdates);
@@ -125,6 +127,9 @@ App::~App()
 
 void App::cleanup()
 {
+	// Write the pending messages while the subsystems that might have registered log handlers are still alive
+	Logger::getSingleton().enableAsync(false);
+
 	SceneGraph::freeSingleton();
 	ScriptManager::freeSingleton();
 	Renderer::freeSingleton();
@@ -154,6 +159,9 @@ void App::cleanup()
 
 	CoreMemoryPool::freeSingleton();
 	DefaultMemoryPool::freeSingleton();
+
+	// Last because all the pools allocate through it
+	AllocationProfiler::freeSingleton();
 }
 
 Error App::init()
@@ -172,12 +180,15 @@ Error App::initInternal()
 {
 	StatsSet::getSingleton().initFromMainThread();
 	Logger::getSingleton().enableVerbosity(g_verboseLogCVar);
+	Logger::getSingleton().enableAsync(g_asyncLogCVar);
 
 	AllocAlignedCallback allocCb = m_originalAllocCallback;
 	void* allocCbUserData = m_originalAllocUserData;
 	initMemoryCallbacks(allocCb, allocCbUserData);
 
+	getPoolAllocationCallback("DefaultMemoryPool", allocCb, allocCbUserData);
 	DefaultMemoryPool::allocateSingleton(allocCb, allocCbUserData);
+	getPoolAllocationCallback("CoreMemoryPool", allocCb, allocCbUserData);
 	CoreMemoryPool::allocateSingleton(allocCb, allocCbUserData);
 
 	ANKI_CHECK(initDirs());
@@ -227,13 +238,46 @@ Error App::initInternal()
 		g_vsyncCVar.set(false);
 	}
 
+	const Bool replayMode = CString(g_replayFramesCVar) != "";
+	if(replayMode && g_vsyncCVar)
+	{
+		ANKI_CORE_LOGW("Vsync is enabled and frame replay as well. Will turn vsync off");
+		g_vsyncCVar.set(false);
+	}
+
 	GlobalFrameIndex::allocateSingleton();
 
 	//
 	// Core tracer
 	//
 #if ANKI_TRACING_ENABLED
+	if(replayMode)
+	{
+		// The replay report is built from the tracer events
+		g_tracingEnabledCVar.set(true);
+	}
+
 	ANKI_CHECK(CoreTracer::allocateSingleton().init(m_settingsDir));
+
+	if(replayMode)
+	{
+		constexpr Array<CString, 8> kReportEvents = {"Frame",
+													 "SceneUpdate",
+													 "ScenePhysics",
+													 "CpuVisibility",
+													 "RGpuVisibility",
+													 "RGpuVisibilityNonRenderables",
+													 "GrRenderGraphCompile",
+													 "GrRenderGraphRecordAndSubmit"};
+		CoreString reportFilename;
+		reportFilename.sprintf("%s/ReplayReport.csv", m_settingsDir.cstr());
+		CoreTracer::getSingleton().enableEventReport(reportFilename, kReportEvents);
+	}
+#else
+	if(replayMode)
+	{
+		ANKI_CORE_LOGW("The frame replay needs a build with tracing enabled to write its report");
+	}
 #endif
 
 	//
@@ -266,8 +310,7 @@ Error App::initInternal()
 	// Graphics API
 	//
 	GrManagerInitInfo grInit;
-	grInit.m_allocCallback = allocCb;
-	grInit.m_allocCallbackUserData = allocCbUserData;
+	getPoolAllocationCallback("GrMemoryPool", grInit.m_allocCallback, grInit.m_allocCallbackUserData);
 	grInit.m_cacheDirectory = m_cacheDir.toCString();
 	ANKI_CHECK(GrManager::allocateSingleton().init(grInit));
 
@@ -294,6 +337,7 @@ Error App::initInternal()
 	// Physics
 	//
 	PhysicsWorld::allocateSingleton();
+	getPoolAllocationCallback("PhysicsMemoryPool", allocCb, allocCbUserData);
 	ANKI_CHECK(PhysicsWorld::getSingleton().init(allocCb, allocCbUserData));
 
 	//
@@ -313,11 +357,13 @@ Error App::initInternal()
 	g_dataPathsCVar.set(extraPaths);
 #endif
 
+	getPoolAllocationCallback("ResourceMemoryPool", allocCb, allocCbUserData);
 	ANKI_CHECK(ResourceManager::allocateSingleton().init(allocCb, allocCbUserData));
 
 	//
 	// UI
 	//
+	getPoolAllocationCallback("UiMemoryPool", allocCb, allocCbUserData);
 	ANKI_CHECK(UiManager::allocateSingleton().init(allocCb, allocCbUserData));
 
 	//
@@ -330,18 +376,19 @@ Error App::initInternal()
 	//
 	RendererInitInfo renderInit;
 	renderInit.m_swapchainSize = UVec2(NativeWindow::getSingleton().getWidth(), NativeWindow::getSingleton().getHeight());
-	renderInit.m_allocCallback = allocCb;
-	renderInit.m_allocCallbackUserData = allocCbUserData;
+	getPoolAllocationCallback("RendererMemoryPool", renderInit.m_allocCallback, renderInit.m_allocCallbackUserData);
 	ANKI_CHECK(Renderer::allocateSingleton().init(renderInit));
 
 	//
 	// Script
 	//
+	getPoolAllocationCallback("ScriptMemoryPool", allocCb, allocCbUserData);
 	ScriptManager::allocateSingleton(allocCb, allocCbUserData);
 
 	//
 	// Scene
 	//
+	getPoolAllocationCallback("SceneMemoryPool", allocCb, allocCbUserData);
 	ANKI_CHECK(SceneGraph::allocateSingleton().init(allocCb, allocCbUserData));
 
 	ANKI_CORE_LOGI("Application initialized");
@@ -398,6 +445,18 @@ Error App::mainLoop()
 	Second prevUpdateTime = HighRezTimer::getCurrentTime();
 	Second crntTime = prevUpdateTime;
 
+	// Frame recording and replay
+	FrameReplay frameReplay;
+	if(CString(g_replayFramesCVar) != "")
+	{
+		ANKI_CHECK(frameReplay.initReplay(g_replayFramesCVar));
+	}
+	else if(CString(g_recordFramesCVar) != "")
+	{
+		ANKI_CHECK(frameReplay.initRecording(g_recordFramesCVar));
+	}
+	const Bool replayMode = frameReplay.isReplaying();
+
 	// Benchmark mode stuff:
 	const Bool benchmarkMode = g_benchmarkModeCVar;
 	Second aggregatedCpuTime = 0.0;
@@ -425,9 +484,29 @@ Error App::mainLoop()
 			// Update
 			ANKI_CHECK(Input::getSingleton().handleEvents());
 
+			if(replayMode) [[unlikely]]
+			{
+				Second deltaTime;
+				if(!frameReplay.replayInput(deltaTime))
+				{
+					break;
+				}
+
+				crntTime = prevUpdateTime + deltaTime;
+			}
+
 			// User update
 			ANKI_CHECK(userMainLoop(quit, crntTime - prevUpdateTime));
 
+			if(replayMode) [[unlikely]]
+			{
+				frameReplay.replayCamera();
+			}
+			else if(frameReplay.isRecording()) [[unlikely]]
+			{
+				frameReplay.recordFrame(crntTime - prevUpdateTime);
+			}
+
 			ANKI_CHECK(SceneGraph::getSingleton().update(prevUpdateTime, crntTime));
 
 			// Render
@@ -458,7 +537,7 @@ Error App::mainLoop()
 			const Second endTime = HighRezTimer::getCurrentTime();
 			const Second frameTime = endTime - startTime;
 			g_cpuTotalTimeStatVar.set((frameTime - grTime) * 1000.0);
-			if(!benchmarkMode) [[likely]]
+			if(!benchmarkMode && !replayMode) [[likely]]
 			{
 				const Second timerTick = 1.0_sec / Second(g_targetFpsCVar);
 				if(frameTime < timerTick)
@@ -468,7 +547,7 @@ Error App::mainLoop()
 				}
 			}
 			// Benchmark stats
-			else
+			else if(benchmarkMode)
 			{
 				aggregatedCpuTime += frameTime - grTime;
 				aggregatedGpuTime += 0; // TODO
@@ -499,6 +578,11 @@ Error App::mainLoop()
 
 			StatsSet::getSingleton().endFrame();
 
+			if(AllocationProfiler::isAllocated()) [[unlikely]]
+			{
+				AllocationProfiler::getSingleton().endFrame();
+			}
+
 			++GlobalFrameIndex::getSingleton().m_value;
 
 			if(benchmarkMode) [[unlikely]]
@@ -521,6 +605,18 @@ Error App::mainLoop()
 		ANKI_CORE_LOGI("Benchmark file saved in: %s", benchmarkCsvFileFilename.cstr());
 	}
 
+	if(frameReplay.isRecording())
+	{
+		ANKI_CHECK(frameReplay.writeRecording());
+	}
+
+	if(AllocationProfiler::isAllocated())
+	{
+		CoreString filename;
+		filename.sprintf("%s/AllocationProfile.txt", m_settingsDir.cstr());
+		ANKI_CHECK(AllocationProfiler::getSingleton().dump(filename));
+	}
+
 	return Error::kNone;
 }
 
@@ -535,6 +631,27 @@ void App::initMemoryCallbacks(AllocAlignedCallback& allocCb, void*& allocCbUserD
 	{
 		// Leave the default
 	}
+
+	m_allocCallback = allocCb;
+	m_allocCallbackUserData = allocCbUserData;
+
+	if(g_allocationProfilerCVar)
+	{
+		AllocationProfiler::allocateSingleton(allocCb, allocCbUserData);
+	}
+}
+
+void App::getPoolAllocationCallback(CString poolName, AllocAlignedCallback& allocCb, void*& allocCbUserData) const
+{
+	if(AllocationProfiler::isAllocated())
+	{
+		AllocationProfiler::getSingleton().getPoolAllocationCallback(poolName, allocCb, allocCbUserData);
+	}
+	else
+	{
+		allocCb = m_allocCallback;
+		allocCbUserData = m_allocCallbackUserData;
+	}
 }
 
 Bool App::toggleDeveloperConsole()
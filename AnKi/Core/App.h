@@ -23,6 +23,7 @@ inline NumericCVar<U32> g_jobThreadCountCVar("Core", "JobThreadCount", clamp(get
 inline NumericCVar<U32> g_displayStatsCVar("Core", "DisplayStats", 0, 0, 2, "Display stats, 0: None, 1: Simple, 2: Detailed");
 inline BoolCVar g_clearCachesCVar("Core", "ClearCaches", false, "Clear all caches");
 inline BoolCVar g_verboseLogCVar("Core", "VerboseLog", false, "Verbose logging");
+inline BoolCVar g_asyncLogCVar("Core", "AsyncLog", false, "Format and write the log messages in a background thread");
 inline BoolCVar g_benchmarkModeCVar("Core", "BenchmarkMode", false, "Run in a benchmark mode. Fixed timestep, unlimited target FPS");
 inline NumericCVar<U32> g_benchmarkModeFrameCountCVar("Core", "BenchmarkModeFrameCount", 60 * 60 * 2, 1, kMaxU32,
 													  "How many frames the benchmark will run before it quits");
@@ -81,10 +82,16 @@ private:
 	void* m_originalAllocUserData = nullptr;
 	AllocAlignedCallback m_originalAllocCallback = nullptr;
 
+	void* m_allocCallbackUserData = nullptr; ///< The user data of m_allocCallback.
+	AllocAlignedCallback m_allocCallback = nullptr; ///< The callback after initMemoryCallbacks(). The pools end up to that.
+
 	static void* statsAllocCallback(void* userData, void* ptr, PtrSize size, PtrSize alignment);
 
 	void initMemoryCallbacks(AllocAlignedCallback& allocCb, void*& allocCbUserData);
 
+	/// Get the allocation callback of a subsystem's memory pool. If the allocation profiler is enabled the allocations get tagged with the pool.
+	void getPoolAllocationCallback(CString poolName, AllocAlignedCallback& allocCb, void*& allocCbUserData) const;
+
 	Error initInternal();
 
 	Error initDirs();
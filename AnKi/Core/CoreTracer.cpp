@@ -48,6 +48,13 @@ public:
 	U64 m_frame;
 };
 
+class CoreTracer::PerFrameEvents : public IntrusiveListEnabled<PerFrameEvents>
+{
+public:
+	CoreDynamicArray<Second> m_durations; ///< One for each of the CoreTracer::m_reportEventNames.
+	U64 m_frame;
+};
+
 CoreTracer::CoreTracer()
 	: m_thread("Tracer")
 {
@@ -72,6 +79,9 @@ CoreTracer::~CoreTracer()
 	// Write counter file
 	err = writeCountersOnShutdown();
 
+	// Write the event report
+	err = writeEventReportOnShutdown();
+
 	// Cleanup
 	while(!m_frameCounters.isEmpty())
 	{
@@ -79,6 +89,12 @@ CoreTracer::~CoreTracer()
 		deleteInstance(CoreMemoryPool::getSingleton(), frame);
 	}
 
+	while(!m_frameEvents.isEmpty())
+	{
+		PerFrameEvents* frame = m_frameEvents.popBack();
+		deleteInstance(CoreMemoryPool::getSingleton(), frame);
+	}
+
 	while(!m_workItems.isEmpty())
 	{
 		ThreadWorkItem* item = m_workItems.popBack();
@@ -155,6 +171,7 @@ Error CoreTracer::threadWorker()
 			if(!err)
 			{
 				gatherCounters(*item);
+				gatherReportEvents(*item);
 			}
 
 			deleteInstance(CoreMemoryPool::getSingleton(), item);
@@ -290,6 +307,50 @@ void CoreTracer::gatherCounters(ThreadWorkItem& item)
 	}
 }
 
+void CoreTracer::gatherReportEvents(ThreadWorkItem& item)
+{
+	if(m_reportEventNames.getSize() == 0 || item.m_events.getSize() == 0)
+	{
+		return;
+	}
+
+	// The items arrive in frame order
+	if(m_frameEvents.isEmpty() || m_frameEvents.getBack().m_frame != item.m_frame)
+	{
+		PerFrameEvents* newPerFrame = newInstance<PerFrameEvents>(CoreMemoryPool::getSingleton());
+		newPerFrame->m_durations.resize(m_reportEventNames.getSize(), 0.0);
+		newPerFrame->m_frame = item.m_frame;
+		m_frameEvents.pushBack(newPerFrame);
+	}
+
+	PerFrameEvents& frame = m_frameEvents.getBack();
+	for(const TracerEvent& event : item.m_events)
+	{
+		for(U32 i = 0; i < m_reportEventNames.getSize(); ++i)
+		{
+			if(m_reportEventNames[i] == event.m_name)
+			{
+				frame.m_durations[i] += event.m_duration;
+				break;
+			}
+		}
+	}
+}
+
+void CoreTracer::enableEventReport(CString csvFilename, ConstWeakArray<CString> eventNames)
+{
+	LockGuard<Mutex> lock(m_mtx);
+
+	m_eventReportCsvFilename = csvFilename;
+
+	m_reportEventNames.resize(eventNames.getSize());
+	for(U32 i = 0; i < eventNames.getSize(); ++i)
+	{
+		// Same as ANKI_TRACE_SCOPED_EVENT
+		m_reportEventNames[i].sprintf("t%s", eventNames[i].cstr());
+	}
+}
+
 void CoreTracer::flushFrame(U64 frame)
 {
 	struct Ctx
@@ -403,6 +464,70 @@ Error CoreTracer::writeCountersOnShutdown()
 	return Error::kNone;
 }
 
+Error CoreTracer::writeEventReportOnShutdown()
+{
+	if(m_frameEvents.getSize() == 0)
+	{
+		return Error::kNone;
+	}
+
+	File csvFile;
+	ANKI_CHECK(csvFile.open(m_eventReportCsvFilename, FileOpenFlag::kWrite));
+	ANKI_CORE_LOGI("Event report created: %s", m_eventReportCsvFilename.cstr());
+
+	// Write the header. Skip the "t" prefix
+	ANKI_CHECK(csvFile.writeText("Frame"));
+	for(const CoreString& name : m_reportEventNames)
+	{
+		ANKI_CHECK(csvFile.writeTextf(",%s (ms)", name.cstr() + 1));
+	}
+	ANKI_CHECK(csvFile.writeText("\n"));
+
+	// Write each frame
+	for(const PerFrameEvents& frame : m_frameEvents)
+	{
+		ANKI_CHECK(csvFile.writeTextf("%" PRIu64, frame.m_frame));
+		for(Second duration : frame.m_durations)
+		{
+			ANKI_CHECK(csvFile.writeTextf(",%f", duration * 1000.0));
+		}
+		ANKI_CHECK(csvFile.writeText("\n"));
+	}
+
+	// Write some statistics
+	CoreDynamicArray<Second> durations;
+	durations.resize(m_frameEvents.getSize());
+	Array<CoreDynamicArray<Second>, 3> stats; // Mean, median and 95th percentile
+	for(U32 i = 0; i < m_reportEventNames.getSize(); ++i)
+	{
+		U32 count = 0;
+		Second sum = 0.0;
+		for(const PerFrameEvents& frame : m_frameEvents)
+		{
+			durations[count++] = frame.m_durations[i];
+			sum += frame.m_durations[i];
+		}
+
+		std::sort(durations.getBegin(), durations.getEnd());
+		stats[0].emplaceBack(sum / Second(count));
+		stats[1].emplaceBack(durations[count / 2]);
+		stats[2].emplaceBack(durations[min(count - 1, U32(F32(count) * 0.95f))]);
+	}
+
+	Array<const char*, 3> statNames = {"Mean", "Median", "P95"};
+	for(U32 s = 0; s < stats.getSize(); ++s)
+	{
+		ANKI_CHECK(csvFile.writeText(statNames[s]));
+		for(Second duration : stats[s])
+		{
+			ANKI_CHECK(csvFile.writeTextf(",%f", duration * 1000.0));
+		}
+		ANKI_CHECK(csvFile.writeText("\n"));
+	}
+
+	return Error::kNone;
+}
+
 #endif
 
 } // end namespace anki
@@ -36,9 +36,16 @@ public:
 	/// It will flush everything.
 	void flushFrame(U64 frame);
 
+	/// Write a CSV with the CPU time of some events in every frame. The time of the events with the same name is accumulated per frame. Call it
+	/// before the first flushFrame().
+	/// @param csvFilename The report. It's written when the CoreTracer is destroyed.
+	/// @param eventNames The names of the events as given to ANKI_TRACE_SCOPED_EVENT.
+	void enableEventReport(CString csvFilename, ConstWeakArray<CString> eventNames);
+
 private:
 	class ThreadWorkItem;
 	class PerFrameCounters;
+	class PerFrameEvents;
 
 	Thread m_thread;
 	ConditionVariable m_cvar;
@@ -47,6 +54,10 @@ private:
 	CoreDynamicArray<CoreString> m_counterNames;
 	IntrusiveList<PerFrameCounters> m_frameCounters;
 
+	CoreDynamicArray<CoreString> m_reportEventNames;
+	IntrusiveList<PerFrameEvents> m_frameEvents;
+	CoreString m_eventReportCsvFilename;
+
 	IntrusiveList<ThreadWorkItem> m_workItems; ///< Items for the thread to process.
 	CoreString m_traceJsonFilename;
 	CoreString m_countersCsvFilename;
@@ -61,7 +72,9 @@ private:
 
 	Error writeEvents(ThreadWorkItem& item);
 	void gatherCounters(ThreadWorkItem& item);
+	void gatherReportEvents(ThreadWorkItem& item);
 	Error writeCountersOnShutdown();
+	Error writeEventReportOnShutdown();
 };
 
 #endif
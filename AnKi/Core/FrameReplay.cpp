@@ -0,0 +1,183 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Core/FrameReplay.h>
+#include <AnKi/Window/Input.h>
+#include <AnKi/Scene/SceneGraph.h>
+#include <AnKi/Util/Serializer.h>
+#include <AnKi/Util/File.h>
+
+namespace anki {
+
+FrameReplay::~FrameReplay()
+{
+	if(m_binary)
+	{
+		CoreMemoryPool::getSingleton().free(m_binary);
+	}
+}
+
+Error FrameReplay::initRecording(CString filename)
+{
+	ANKI_ASSERT(!isRecording() && !isReplaying());
+
+	// Fail early if the file can't be written
+	File file;
+	ANKI_CHECK(file.open(filename, FileOpenFlag::kWrite | FileOpenFlag::kBinary));
+
+	m_filename = filename;
+	ANKI_CORE_LOGI("Recording frames to: %s", filename.cstr());
+	return Error::kNone;
+}
+
+Error FrameReplay::initReplay(CString filename)
+{
+	ANKI_ASSERT(!isRecording() && !isReplaying());
+
+	File file;
+	ANKI_CHECK(file.open(filename, FileOpenFlag::kRead | FileOpenFlag::kBinary));
+	ANKI_CHECK(BinaryDeserializer::deserialize(m_binary, CoreMemoryPool::getSingleton(), file));
+
+	if(memcmp(&m_binary->m_magic[0], kFrameReplayBinaryMagic, m_binary->m_magic.getSize()) != 0)
+	{
+		ANKI_CORE_LOGE("Not a frame recording: %s", filename.cstr());
+		return Error::kUserData;
+	}
+
+	ANKI_CORE_LOGI("Replaying %u frames from: %s", m_binary->m_frames.getSize(), filename.cstr());
+	return Error::kNone;
+}
+
+void FrameReplay::recordFrame(Second deltaTime)
+{
+	ANKI_ASSERT(isRecording());
+	const Input& input = Input::getSingleton();
+
+	FrameReplayBinaryFrame& frame = *m_recordedFrames.emplaceBack();
+	frame.m_deltaTime = deltaTime;
+
+	// The arrays of the input are patched when writing the file because m_recordedInputs moves as it grows
+	U32 keyCount = 0;
+	input.iteratePressedKeys([&](KeyCode key, U32 value) {
+		FrameReplayBinaryInput& in = *m_recordedInputs.emplaceBack();
+		in.m_code = U32(key);
+		in.m_value = value;
+		++keyCount;
+	});
+	frame.m_keys = WeakArray<FrameReplayBinaryInput>(nullptr, keyCount);
+
+	U32 buttonCount = 0;
+	for(MouseButton button = MouseButton(0); button < MouseButton::kCount; ++button)
+	{
+		if(input.getMouseButton(button) > 0)
+		{
+			FrameReplayBinaryInput& in = *m_recordedInputs.emplaceBack();
+			in.m_code = U32(button);
+			in.m_value = input.getMouseButton(button);
+			++buttonCount;
+		}
+	}
+	frame.m_mouseButtons = WeakArray<FrameReplayBinaryInput>(nullptr, buttonCount);
+
+	frame.m_mousePosition[0] = input.getMousePosition().x();
+	frame.m_mousePosition[1] = input.getMousePosition().y();
+
+	const Transform& trf = SceneGraph::getSingleton().getActiveCameraNode().getLocalTransform();
+	for(U32 i = 0; i < 3; ++i)
+	{
+		frame.m_cameraOrigin[i] = trf.getOrigin()[i];
+		frame.m_cameraScale[i] = trf.getScale()[i];
+
+		for(U32 j = 0; j < 4; ++j)
+		{
+			frame.m_cameraRotation[i * 4 + j] = trf.getRotation()(i, j);
+		}
+	}
+}
+
+Error FrameReplay::writeRecording()
+{
+	ANKI_ASSERT(isRecording());
+
+	U32 inputIdx = 0;
+	for(FrameReplayBinaryFrame& frame : m_recordedFrames)
+	{
+		const U32 keyCount = frame.m_keys.getSize();
+		frame.m_keys = WeakArray<FrameReplayBinaryInput>((keyCount) ? &m_recordedInputs[inputIdx] : nullptr, keyCount);
+		inputIdx += keyCount;
+
+		const U32 buttonCount = frame.m_mouseButtons.getSize();
+		frame.m_mouseButtons = WeakArray<FrameReplayBinaryInput>((buttonCount) ? &m_recordedInputs[inputIdx] : nullptr, buttonCount);
+		inputIdx += buttonCount;
+	}
+	ANKI_ASSERT(inputIdx == m_recordedInputs.getSize());
+
+	FrameReplayBinary binary;
+	memcpy(&binary.m_magic[0], kFrameReplayBinaryMagic, binary.m_magic.getSize());
+	binary.m_frames = WeakArray<FrameReplayBinaryFrame>(m_recordedFrames);
+
+	File file;
+	ANKI_CHECK(file.open(m_filename, FileOpenFlag::kWrite | FileOpenFlag::kBinary));
+	BinarySerializer serializer;
+	ANKI_CHECK(serializer.serialize(binary, CoreMemoryPool::getSingleton(), file));
+
+	ANKI_CORE_LOGI("Recorded %u frames to: %s", m_recordedFrames.getSize(), m_filename.cstr());
+	return Error::kNone;
+}
+
+Bool FrameReplay::replayInput(Second& deltaTime)
+{
+	ANKI_ASSERT(isReplaying());
+	if(m_crntFrame >= m_binary->m_frames.getSize())
+	{
+		return false;
+	}
+
+	const FrameReplayBinaryFrame& frame = m_binary->m_frames[m_crntFrame];
+	deltaTime = frame.m_deltaTime;
+
+	Input& input = Input::getSingleton();
+	input.reset();
+
+	for(const FrameReplayBinaryInput& in : frame.m_keys)
+	{
+		if(in.m_code < U32(KeyCode::kCount))
+		{
+			input.setKey(KeyCode(in.m_code), in.m_value);
+		}
+	}
+
+	for(const FrameReplayBinaryInput& in : frame.m_mouseButtons)
+	{
+		if(in.m_code < U32(MouseButton::kCount))
+		{
+			input.setMouseButton(MouseButton(in.m_code), in.m_value);
+		}
+	}
+
+	input.moveCursor(Vec2(frame.m_mousePosition[0], frame.m_mousePosition[1]));
+	return true;
+}
+
+void FrameReplay::replayCamera()
+{
+	ANKI_ASSERT(isReplaying() && m_crntFrame < m_binary->m_frames.getSize());
+	const FrameReplayBinaryFrame& frame = m_binary->m_frames[m_crntFrame++];
+
+	Mat3x4 rotation;
+	for(U32 i = 0; i < 3; ++i)
+	{
+		for(U32 j = 0; j < 4; ++j)
+		{
+			rotation(i, j) = frame.m_cameraRotation[i * 4 + j];
+		}
+	}
+
+	const Vec3 origin(frame.m_cameraOrigin[0], frame.m_cameraOrigin[1], frame.m_cameraOrigin[2]);
+	const Vec3 scale(frame.m_cameraScale[0], frame.m_cameraScale[1], frame.m_cameraScale[2]);
+	SceneGraph::getSingleton().getActiveCameraNode().setLocalTransform(Transform(origin.xyz0(), rotation, scale.xyz0()));
+}
+
+} // end namespace anki
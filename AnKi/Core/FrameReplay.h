@@ -0,0 +1,74 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Core/Common.h>
+#include <AnKi/Core/FrameReplayBinary.h>
+#include <AnKi/Util/CVarSet.h>
+
+namespace anki {
+
+/// @addtogroup core
+/// @{
+
+inline StringCVar g_recordFramesCVar("Core", "RecordFrames", "", "Record the input and the camera of every frame to that file");
+inline StringCVar g_replayFramesCVar("Core", "ReplayFrames", "",
+									 "Replay a file written by RecordFrames. Fixed input and timestep and a per frame CPU report");
+
+/// Records the input, the frame time and the transform of the active camera of every frame. A recording can be replayed to get the exact same
+/// frames again which makes frame by frame CPU comparisons possible.
+class FrameReplay
+{
+public:
+	FrameReplay() = default;
+
+	FrameReplay(const FrameReplay&) = delete; // Non-copyable
+
+	~FrameReplay();
+
+	FrameReplay& operator=(const FrameReplay&) = delete; // Non-copyable
+
+	Error initRecording(CString filename);
+
+	Error initReplay(CString filename);
+
+	Bool isRecording() const
+	{
+		return !m_filename.isEmpty();
+	}
+
+	Bool isReplaying() const
+	{
+		return m_binary != nullptr;
+	}
+
+	/// Store the state of the current frame. Call it after the input and the camera have been updated.
+	void recordFrame(Second deltaTime);
+
+	/// Write the recorded frames to the file.
+	Error writeRecording();
+
+	/// Override the input with the recorded one.
+	/// @param[out] deltaTime The recorded time of the frame.
+	/// @return False if there are no more frames to replay.
+	Bool replayInput(Second& deltaTime);
+
+	/// Override the transform of the active camera with the recorded one. Call it after the user code has run.
+	void replayCamera();
+
+private:
+	// Recording
+	CoreString m_filename;
+	CoreDynamicArray<FrameReplayBinaryFrame> m_recordedFrames;
+	CoreDynamicArray<FrameReplayBinaryInput> m_recordedInputs; ///< The keys and the mouse buttons of all the frames one after the other.
+
+	// Replay
+	FrameReplayBinary* m_binary = nullptr;
+	U32 m_crntFrame = 0;
+};
+/// @}
+
+} // end namespace anki
@@ -0,0 +1,125 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+// WARNING: This file is auto generated.
+
+#pragma once
+
+#include <AnKi/Util/StdTypes.h>
+#include <AnKi/Util/Array.h>
+#include <AnKi/Util/WeakArray.h>
+
+namespace anki {
+
+/// @addtogroup core
+/// @{
+
+inline constexpr const char* kFrameReplayBinaryMagic = "ANKIFRP1";
+
+/// A key or a mouse button that was pressed.
+class FrameReplayBinaryInput
+{
+public:
+	/// KeyCode or MouseButton.
+	U32 m_code = 0;
+
+	/// For how many frames it's pressed. See Input::getKey().
+	U32 m_value = 0;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doValue("m_code", offsetof(FrameReplayBinaryInput, m_code), self.m_code);
+		s.doValue("m_value", offsetof(FrameReplayBinaryInput, m_value), self.m_value);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, FrameReplayBinaryInput&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const FrameReplayBinaryInput&>(serializer, *this);
+	}
+};
+
+/// The input and the camera of a single frame.
+class FrameReplayBinaryFrame
+{
+public:
+	/// The time that passed since the previous frame.
+	F64 m_deltaTime = 0.0;
+
+	WeakArray<FrameReplayBinaryInput> m_keys;
+	WeakArray<FrameReplayBinaryInput> m_mouseButtons;
+
+	/// In NDC.
+	Array<F32, 2> m_mousePosition = {};
+
+	Array<F32, 3> m_cameraOrigin = {};
+
+	/// A 3x4 matrix in row major order.
+	Array<F32, 12> m_cameraRotation = {};
+
+	Array<F32, 3> m_cameraScale = {};
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doValue("m_deltaTime", offsetof(FrameReplayBinaryFrame, m_deltaTime), self.m_deltaTime);
+		s.doValue("m_keys", offsetof(FrameReplayBinaryFrame, m_keys), self.m_keys);
+		s.doValue("m_mouseButtons", offsetof(FrameReplayBinaryFrame, m_mouseButtons), self.m_mouseButtons);
+		s.doArray("m_mousePosition", offsetof(FrameReplayBinaryFrame, m_mousePosition), &self.m_mousePosition[0], self.m_mousePosition.getSize());
+		s.doArray("m_cameraOrigin", offsetof(FrameReplayBinaryFrame, m_cameraOrigin), &self.m_cameraOrigin[0], self.m_cameraOrigin.getSize());
+		s.doArray("m_cameraRotation", offsetof(FrameReplayBinaryFrame, m_cameraRotation), &self.m_cameraRotation[0], self.m_cameraRotation.getSize());
+		s.doArray("m_cameraScale", offsetof(FrameReplayBinaryFrame, m_cameraScale), &self.m_cameraScale[0], self.m_cameraScale.getSize());
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, FrameReplayBinaryFrame&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const FrameReplayBinaryFrame&>(serializer, *this);
+	}
+};
+
+/// A recording of the input and the camera of a number of frames.
+class FrameReplayBinary
+{
+public:
+	Array<U8, 8> m_magic = {};
+	WeakArray<FrameReplayBinaryFrame> m_frames;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doArray("m_magic", offsetof(FrameReplayBinary, m_magic), &self.m_magic[0], self.m_magic.getSize());
+		s.doValue("m_frames", offsetof(FrameReplayBinary, m_frames), self.m_frames);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, FrameReplayBinary&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const FrameReplayBinary&>(serializer, *this);
+	}
+};
+
+/// @}
+
+} // end namespace anki
@@ -10,12 +10,15 @@ namespace anki {
 
 GpuReadbackMemoryPool::GpuReadbackMemoryPool()
 {
-	const Array classes = {64_B, 256_B, 1_MB, 5_MB};
+	m_ring.init(getAlignedRoundUp(256, PtrSize(g_readbackGpuMemoryPerFrameSizeCVar)));
 
-	const BufferUsageBit buffUsage = BufferUsageBit::kAllUav;
-	const BufferMapAccessBit mapAccess = BufferMapAccessBit::kRead;
+	BufferInitInfo buffInit("GpuReadback");
+	buffInit.m_mapAccess = BufferMapAccessBit::kRead;
+	buffInit.m_size = m_ring.getSize();
+	buffInit.m_usage = BufferUsageBit::kAllUav;
+	m_buffer = GrManager::getSingleton().newBuffer(buffInit);
 
-	m_pool.init(buffUsage, classes, classes.getBack(), "GpuReadback", false, mapAccess);
+	m_mappedMem = static_cast<const U8*>(m_buffer->map(0, kMaxPtrSize, BufferMapAccessBit::kRead));
 
 	if(!GrManager::getSingleton().getDeviceCapabilities().m_structuredBufferNaturalAlignment)
 	{
@@ -23,28 +26,30 @@ GpuReadbackMemoryPool::GpuReadbackMemoryPool()
 	}
 }
 
-GpuReadbackMemoryPool ::~GpuReadbackMemoryPool()
+GpuReadbackMemoryPool::~GpuReadbackMemoryPool()
 {
-}
+	GrManager::getSingleton().finish();
 
-GpuReadbackMemoryAllocation GpuReadbackMemoryPool::allocate(PtrSize size, U32 alignment)
-{
-	GpuReadbackMemoryAllocation out;
-	m_pool.allocate(size, alignment, out.m_token);
-	out.m_buffer = &m_pool.getGpuBuffer();
-	out.m_mappedMemory = static_cast<U8*>(m_pool.getGpuBufferMappedMemory()) + out.m_token.m_offset;
-	return out;
+	m_buffer->unmap();
+	m_buffer.reset(nullptr);
 }
 
-void GpuReadbackMemoryPool::deferredFree(GpuReadbackMemoryAllocation& allocation)
+BufferView GpuReadbackMemoryPool::allocate(PtrSize size, U32 alignment, GpuReadbackMemoryAllocation& allocation)
 {
-	m_pool.deferredFree(allocation.m_token);
-	::new(&allocation) GpuReadbackMemoryAllocation();
+	allocation = m_ring.allocate(size, alignment);
+	if(!allocation.isValid()) [[unlikely]]
+	{
+		ANKI_CORE_LOGF("Out of readback GPU memory. Increase %s", g_readbackGpuMemoryPerFrameSizeCVar.getFullName().cstr());
+	}
+
+	return BufferView(m_buffer.get(), allocation.m_offset, size);
 }
 
 void GpuReadbackMemoryPool::endFrame()
 {
-	m_pool.endFrame();
+	ANKI_ASSERT(m_frameFence.isCreated() && "Forgot to call setFrameFence()");
+	m_ring.endFrame(m_frameFence);
+	m_frameFence.reset(nullptr);
 }
 
 } // end namespace anki
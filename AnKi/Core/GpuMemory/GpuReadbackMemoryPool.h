@@ -6,110 +6,230 @@
 #pragma once
 
 #include <AnKi/Core/Common.h>
-#include <AnKi/Gr/Utils/SegregatedListsGpuMemoryPool.h>
+#include <AnKi/Util/CVarSet.h>
+#include <AnKi/Util/Atomic.h>
+#include <AnKi/Util/WeakArray.h>
+#include <AnKi/Gr/Buffer.h>
+#include <AnKi/Gr/Fence.h>
 
 namespace anki {
 
 /// @addtogroup core
 /// @{
 
+inline NumericCVar<PtrSize> g_readbackGpuMemoryPerFrameSizeCVar("Core", "ReadbackGpuMemoryPerFrameSize", 2_MB, 64_KB, 256_MB,
+																"GPU memory the GPU can write and the CPU read in a single frame");
+
+/// A range of the readback memory that the GPU writes in a single frame.
 /// @memberof GpuReadbackMemoryPool
 class GpuReadbackMemoryAllocation
 {
-	friend class GpuReadbackMemoryPool;
-
 public:
-	GpuReadbackMemoryAllocation() = default;
+	PtrSize m_offset = kMaxPtrSize; ///< Offset in the readback buffer.
+	PtrSize m_size = 0;
+	U64 m_frame = kMaxU64; ///< The frame that allocated it.
 
-	GpuReadbackMemoryAllocation(const GpuReadbackMemoryAllocation&) = delete;
-
-	GpuReadbackMemoryAllocation(GpuReadbackMemoryAllocation&& b)
+	Bool isValid() const
 	{
-		*this = std::move(b);
+		return m_offset != kMaxPtrSize;
 	}
+};
 
-	~GpuReadbackMemoryAllocation();
-
-	GpuReadbackMemoryAllocation& operator=(const GpuReadbackMemoryAllocation&) = delete;
+/// The allocation and the fence bookkeeping of GpuReadbackMemoryPool. The memory is split into kMaxFramesInFlight segments, one per frame. The
+/// producers of a frame bump allocate from its segment without locks. A segment can be read once the fence of its frame is signaled and it's
+/// recycled kMaxFramesInFlight frames later. It doesn't talk to the GPU so it can be tested with a fake fence.
+/// @tparam TFencePtr A pointer to a fence. It needs isCreated(), reset(nullptr) and ->clientWait(Second).
+template<typename TFencePtr>
+class GpuReadbackRing
+{
+public:
+	/// @param frameSize The memory of a single frame.
+	void init(PtrSize frameSize)
+	{
+		ANKI_ASSERT(frameSize > 0);
+		m_frameSize = frameSize;
+		for(U32 i = 0; i < kMaxFramesInFlight; ++i)
+		{
+			m_segments[i].m_frame = (i == 0) ? 0 : kMaxU64;
+		}
+	}
 
-	GpuReadbackMemoryAllocation& operator=(GpuReadbackMemoryAllocation&& b)
+	PtrSize getSize() const
 	{
-		ANKI_ASSERT(!isValid() && "Forgot to delete");
-		m_token = b.m_token;
-		b.m_token = {};
-		m_buffer = b.m_buffer;
-		m_mappedMemory = b.m_mappedMemory;
-		return *this;
+		return m_frameSize * kMaxFramesInFlight;
 	}
 
-	Bool isValid() const
+	U64 getFrame() const
 	{
-		return m_token.m_offset != kMaxPtrSize;
+		return m_frame;
 	}
 
-	/// Get offset in the Unified Geometry Buffer buffer.
-	U32 getOffset() const
+	/// Allocate memory for the current frame. Thread-safe.
+	/// @return An invalid allocation if the memory of the frame is exhausted.
+	GpuReadbackMemoryAllocation allocate(PtrSize size, U32 alignment)
 	{
-		ANKI_ASSERT(isValid());
-		return U32(m_token.m_offset);
+		ANKI_ASSERT(size > 0 && alignment > 0);
+		GpuReadbackMemoryAllocation out;
+
+		const PtrSize segmentOffset = m_offset.fetchAdd(size + alignment);
+		if(segmentOffset + size + alignment > m_frameSize) [[unlikely]]
+		{
+			return out;
+		}
+
+		out.m_offset = getAlignedRoundUp(alignment, (m_frame % kMaxFramesInFlight) * m_frameSize + segmentOffset);
+		out.m_size = size;
+		out.m_frame = m_frame;
+		return out;
 	}
 
-	U32 getAllocatedSize() const
+	/// Check if the GPU has written the allocation and its memory hasn't been recycled. Thread-safe.
+	Bool isReadable(const GpuReadbackMemoryAllocation& allocation) const
 	{
-		ANKI_ASSERT(isValid());
-		return U32(m_token.m_size);
+		if(!allocation.isValid())
+		{
+			return false;
+		}
+
+		const Segment& segment = m_segments[allocation.m_frame % kMaxFramesInFlight];
+		return segment.m_frame == allocation.m_frame && segment.m_signaled;
 	}
 
-	Buffer& getBuffer() const
+	/// Find the readable allocation of the latest frame. Thread-safe.
+	/// @return The index in the array or kMaxU32 if none is readable.
+	U32 findMostRecent(ConstWeakArray<GpuReadbackMemoryAllocation> allocations) const
 	{
-		ANKI_ASSERT(isValid());
-		return *m_buffer;
+		U32 idx = kMaxU32;
+		for(U32 i = 0; i < allocations.getSize(); ++i)
+		{
+			if(isReadable(allocations[i]) && (idx == kMaxU32 || allocations[i].m_frame > allocations[idx].m_frame))
+			{
+				idx = i;
+			}
+		}
+
+		return idx;
 	}
 
-	const void* getMappedMemory() const
+	/// Close the current frame. It polls the fences of the older frames once so the consumers don't have to and it waits for the GPU if the
+	/// segment of the next frame is still in use. Not thread-safe.
+	/// @param fence It will be signaled when the GPU is done with the work of the current frame.
+	void endFrame(TFencePtr fence)
 	{
-		ANKI_ASSERT(isValid());
-		return m_mappedMemory;
+		ANKI_ASSERT(fence.isCreated());
+
+		for(Segment& segment : m_segments)
+		{
+			if(segment.m_fence.isCreated() && segment.m_fence->clientWait(0.0))
+			{
+				segment.m_fence.reset(nullptr);
+				segment.m_signaled = true;
+			}
+		}
+
+		m_segments[m_frame % kMaxFramesInFlight].m_fence = fence;
+		++m_frame;
+
+		Segment& next = m_segments[m_frame % kMaxFramesInFlight];
+		if(next.m_fence.isCreated()) [[unlikely]]
+		{
+			ANKI_CORE_LOGW("Readback fence is not signaled. Need to wait it");
+			if(!next.m_fence->clientWait(10.0_sec))
+			{
+				ANKI_CORE_LOGF("Fence won't signal. Can't recover");
+			}
+
+			next.m_fence.reset(nullptr);
+		}
+
+		next.m_frame = m_frame;
+		next.m_signaled = false;
+		m_offset.setNonAtomically(0);
 	}
 
 private:
-	SegregatedListsGpuMemoryPoolToken m_token;
-	Buffer* m_buffer = nullptr;
-	void* m_mappedMemory = nullptr;
+	class Segment
+	{
+	public:
+		TFencePtr m_fence;
+		U64 m_frame = kMaxU64; ///< The frame that currently owns the segment.
+		Bool m_signaled = false;
+	};
+
+	Array<Segment, kMaxFramesInFlight> m_segments;
+	PtrSize m_frameSize = 0;
+	Atomic<PtrSize> m_offset = {0}; ///< Offset inside the segment of the current frame.
+	U64 m_frame = 0;
 };
 
+/// A persistently mapped buffer the GPU writes results to and the CPU reads them a few frames later. See GpuReadbackRing.
 class GpuReadbackMemoryPool : public MakeSingleton<GpuReadbackMemoryPool>
 {
 	template<typename>
 	friend class MakeSingleton;
 
 public:
-	GpuReadbackMemoryAllocation allocate(PtrSize size, U32 alignment);
+	GpuReadbackMemoryPool(const GpuReadbackMemoryPool&) = delete; // Non-copyable
+
+	GpuReadbackMemoryPool& operator=(const GpuReadbackMemoryPool&) = delete; // Non-copyable
 
+	/// Allocate memory the GPU will write in this frame. Thread-safe.
+	BufferView allocate(PtrSize size, U32 alignment, GpuReadbackMemoryAllocation& allocation);
+
+	/// @copydoc allocate
 	template<typename T>
-	GpuReadbackMemoryAllocation allocateStructuredBuffer(U32 count)
+	BufferView allocateStructuredBuffer(U32 count, GpuReadbackMemoryAllocation& allocation)
 	{
 		const U32 alignment = (m_structuredBufferAlignment == kMaxU32) ? sizeof(T) : m_structuredBufferAlignment;
-		return allocate(sizeof(T) * count, alignment);
+		return allocate(sizeof(T) * count, alignment, allocation);
 	}
 
-	void deferredFree(GpuReadbackMemoryAllocation& allocation);
+	/// Get a view of the memory the GPU has written. The memory is not copied and it stays valid until endFrame(). Thread-safe.
+	/// @return An empty array if the GPU hasn't finished writing or the memory is recycled.
+	template<typename T>
+	ConstWeakArray<T> getMappedMemory(const GpuReadbackMemoryAllocation& allocation) const
+	{
+		if(!m_ring.isReadable(allocation))
+		{
+			return {};
+		}
+
+		return ConstWeakArray<T>(reinterpret_cast<const T*>(m_mappedMem + allocation.m_offset), U32(allocation.m_size / sizeof(T)));
+	}
+
+	/// Same as getMappedMemory() but for the latest readable allocation of an array.
+	template<typename T>
+	ConstWeakArray<T> getMostRecentMappedMemory(ConstWeakArray<GpuReadbackMemoryAllocation> allocations) const
+	{
+		const U32 idx = m_ring.findMostRecent(allocations);
+		return (idx != kMaxU32) ? getMappedMemory<T>(allocations[idx]) : ConstWeakArray<T>();
+	}
 
+	/// Set the fence that will be signaled when the GPU is done with the work of the current frame. Call it before endFrame().
+	void setFrameFence(Fence* fence)
+	{
+		m_frameFence.reset(fence);
+	}
+
+	/// Close the current frame. See GpuReadbackRing::endFrame.
 	void endFrame();
 
+	U64 getFrame() const
+	{
+		return m_ring.getFrame();
+	}
+
 private:
-	SegregatedListsGpuMemoryPool m_pool;
+	BufferPtr m_buffer;
+	const U8* m_mappedMem = nullptr;
+	GpuReadbackRing<FencePtr> m_ring;
+	FencePtr m_frameFence;
 	U32 m_structuredBufferAlignment = kMaxU32;
 
 	GpuReadbackMemoryPool();
 
 	~GpuReadbackMemoryPool();
 };
-
-inline GpuReadbackMemoryAllocation::~GpuReadbackMemoryAllocation()
-{
-	GpuReadbackMemoryPool::getSingleton().deferredFree(*this);
-}
 /// @}
 
 } // end namespace anki
@@ -29,6 +29,11 @@ void StatsSet::endFrame()
 		const Bool atomic = !(counter.m_flags & StatFlag::kMainThreadUpdates);
 		const Bool isFloat = !!(counter.m_flags & StatFlag::kFloat);
 
+		if(counter.m_threadDeltas)
+		{
+			counter.m_atomic.fetchAdd(counter.m_threadDeltas->consume());
+		}
+
 		// Store the previous value
 		if(isFloat)
 		{
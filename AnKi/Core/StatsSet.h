@@ -9,6 +9,7 @@
 #include <AnKi/Util/Singleton.h>
 #include <AnKi/Util/Enum.h>
 #include <AnKi/Util/Thread.h>
+#include <AnKi/Util/ThreadReduction.h>
 #include <AnKi/Util/String.h>
 
 namespace anki {
@@ -50,6 +51,7 @@ inline constexpr Array<CString, U32(StatCategory::kCount)> kStatCategoryTexts =
 class StatCounter
 {
 	friend class StatsSet;
+	friend class ThreadedStatCounter;
 
 public:
 	/// Construct.
@@ -142,7 +144,9 @@ public:
 		}
 		else
 		{
-			orig = m_atomic.exchange(value);
+			// The per-thread increments that are not merged yet are overwritten like the rest. An increment that races with the set is either
+			// overwritten or it's added to the new value
+			orig = m_atomic.exchange(value) + consumeThreadDeltas();
 		}
 		return orig;
 #else
@@ -190,6 +194,7 @@ public:
 		}
 		else
 		{
+			m_atomic.fetchAdd(consumeThreadDeltas());
 			orig = m_atomic.max(value);
 		}
 		return orig;
@@ -217,7 +222,7 @@ public:
 #if ANKI_STATS_ENABLED
 		ANKI_ASSERT(!(m_flags & StatFlag::kFloat));
 		checkThread();
-		return !!(m_flags & StatFlag::kMainThreadUpdates) ? m_u : m_atomic.load();
+		return !!(m_flags & StatFlag::kMainThreadUpdates) ? m_u : m_atomic.load() + ((m_threadDeltas) ? m_threadDeltas->reduce() : 0);
 #else
 		return 0;
 #endif
@@ -262,10 +267,63 @@ private:
 
 	mutable SpinLock m_floatLock;
 
+	/// The per-thread increments of a ThreadedStatCounter. nullptr for the rest of the counters.
+	ThreadReduction<U64, ThreadReductionSum, 16>* m_threadDeltas = nullptr;
+
 	StatFlag m_flags = StatFlag::kNone;
 	StatCategory m_category = StatCategory::kCount;
 
 	void checkThread() const;
+
+	/// @note Thread-safe.
+	U64 consumeThreadDeltas()
+	{
+		return (m_threadDeltas) ? m_threadDeltas->consume() : 0;
+	}
+#endif
+};
+
+/// A StatCounter for the integer counters that many threads update all the time, like the CPU allocations. The increments go to a per-thread slot
+/// to avoid the contention on a single atomic and they are merged to the value at the end of the frame. This costs a cache line per slot so use it
+/// only for those counters.
+class ThreadedStatCounter : public StatCounter
+{
+public:
+	ThreadedStatCounter(StatCategory category, const Char* name, StatFlag flags);
+
+	/// Unlike StatCounter::increment() it doesn't return the previous value since the increments of the other threads might be pending.
+	template<std::integral T>
+	void increment(T value)
+	{
+#if ANKI_STATS_ENABLED
+		if(!m_deltas.tryUpdate(U64(value))) [[unlikely]]
+		{
+			// The threads past the slots update the value directly
+			m_atomic.fetchAdd(value);
+		}
+#else
+		(void)value;
+#endif
+	}
+
+	/// @copydoc increment
+	template<std::integral T>
+	void decrement(T value)
+	{
+#if ANKI_STATS_ENABLED
+		// The deltas wrap around and the sum of all of them will be correct
+		if(!m_deltas.tryUpdate(U64(0) - U64(value))) [[unlikely]]
+		{
+			m_atomic.fetchSub(value);
+		}
+#else
+		(void)value;
+#endif
+	}
+
+private:
+#if ANKI_STATS_ENABLED
+	ThreadReduction<U64, ThreadReductionSum, 16> m_deltas;
 #endif
 };
 
@@ -363,6 +421,19 @@ inline StatCounter::StatCounter(StatCategory category, const Char* name, StatFla
 }
 #endif
 
+inline ThreadedStatCounter::ThreadedStatCounter(StatCategory category, const Char* name, StatFlag flags)
+	: StatCounter(category, name, flags)
+#if ANKI_STATS_ENABLED
+	, m_deltas(0)
+{
+	ANKI_ASSERT(!(flags & (StatFlag::kFloat | StatFlag::kMainThreadUpdates)));
+	m_threadDeltas = &m_deltas;
+}
+#else
+{
+}
+#endif
+
 #if ANKI_STATS_ENABLED
 inline void StatCounter::checkThread() const
 {
@@ -8,6 +8,7 @@
 #include <AnKi/Util/ThreadJobManager.h>
 #include <AnKi/Util/StringList.h>
 #include <AnKi/Util/Xml.h>
+#include <AnKi/Util/Serializer.h>
 
 #if ANKI_COMPILER_GCC_COMPATIBLE
 #	pragma GCC diagnostic push
@@ -310,6 +311,13 @@ Error GltfImporter::init(const GltfImporterInitInfo& initInfo)
 	}
 
 	m_importTextures = initInfo.m_importTextures;
+	m_writeBinaryScene = initInfo.m_writeBinaryScene;
+
+	m_incremental = initInfo.m_incremental;
+	if(m_incremental)
+	{
+		ANKI_CHECK(loadManifest());
+	}
 
 	return Error::kNone;
 }
@@ -333,6 +341,11 @@ Error GltfImporter::writeAll()
 		}
 	}
 
+	if(m_writeBinaryScene)
+	{
+		ANKI_CHECK(writeBinaryScene());
+	}
+
 	// Fire up all requests
 	for(auto& req : m_meshImportRequests)
 	{
@@ -448,6 +461,11 @@ Error GltfImporter::writeAll()
 		ANKI_CHECK(writeAnimation(*anim));
 	}
 
+	if(m_incremental)
+	{
+		ANKI_CHECK(writeManifest());
+	}
+
 	ANKI_IMPORTER_LOGV("Importing GLTF has completed");
 	return Error::kNone;
 }
@@ -668,9 +686,12 @@ Error GltfImporter::visitNode(const cgltf_node& node, const Transform& parentTrf
 			if(!gpuParticles) // TODO Re-enable GPU particles
 			{
 				ANKI_CHECK(m_sceneFile.writeTextf("\nnode = scene:newSceneNode(\"%s\")\n", getNodeName(node).cstr()));
+				newBinaryNode(getNodeName(node));
 
 				ANKI_CHECK(m_sceneFile.writeTextf("comp = node:newParticleEmitterComponent()\n"));
 				ANKI_CHECK(m_sceneFile.writeTextf("comp:loadParticleEmitterResource(\"%s\")\n", extraValueStr.cstr()));
+				newBinaryComponent(SceneBinaryComponentType::kParticleEmitter);
+				newBinaryResourceProperty(SceneBinaryPropertyType::kResource, SceneBinaryResourceType::kParticleEmitter, extraValueStr);
 
 				Transform localTrf;
 				ANKI_CHECK(getNodeTransform(node, localTrf));
@@ -684,18 +705,22 @@ Error GltfImporter::visitNode(const cgltf_node& node, const Transform& parentTrf
 
 			ANKI_CHECK(m_sceneFile.writeTextf("\nnode = scene:newSceneNode(\"%s\")\n", getNodeName(node).cstr()));
 			ANKI_CHECK(m_sceneFile.writeText("comp = node:newSkyboxComponent()\n"));
+			newBinaryNode(getNodeName(node));
+			newBinaryComponent(SceneBinaryComponentType::kSkybox);
 
 			ANKI_CHECK(getExtra(extras, "skybox_solid_color", extraValueVec3, extraFound));
 			if(extraFound)
 			{
 				ANKI_CHECK(
 					m_sceneFile.writeTextf("comp:setSolidColor(Vec3.new(%f, %f, %f))\n", extraValueVec3.x(), extraValueVec3.y(), extraValueVec3.z()));
+				newBinaryProperty(SceneBinaryPropertyType::kSolidColor, extraValueVec3.xyz0());
 			}
 
 			ANKI_CHECK(getExtra(extras, "skybox_image", extraValueStr, extraFound));
 			if(extraFound)
 			{
 				ANKI_CHECK(m_sceneFile.writeTextf("comp:loadImageResource(\"%s\")\n", extraValueStr.cstr()));
+				newBinaryResourceProperty(SceneBinaryPropertyType::kResource, SceneBinaryResourceType::kImage, extraValueStr);
 			}
 
 			ANKI_CHECK(getExtra(extras, "skybox_image_scale", extraValueVec3, extraFound));
@@ -703,30 +728,35 @@ Error GltfImporter::visitNode(const cgltf_node& node, const Transform& parentTrf
 			{
 				ANKI_CHECK(
 					m_sceneFile.writeTextf("comp:setImageScale(Vec3.new(%f, %f, %f))\n", extraValueVec3.x(), extraValueVec3.y(), extraValueVec3.z()));
+				newBinaryProperty(SceneBinaryPropertyType::kImageScale, extraValueVec3.xyz0());
 			}
 
 			ANKI_CHECK(getExtra(extras, "fog_min_density", extraValuef, extraFound));
 			if(extraFound)
 			{
 				ANKI_CHECK(m_sceneFile.writeTextf("comp:setMinFogDensity(%f)\n", extraValuef));
+				newBinaryProperty(SceneBinaryPropertyType::kMinFogDensity, Vec4(extraValuef, 0.0f, 0.0f, 0.0f));
 			}
 
 			ANKI_CHECK(getExtra(extras, "fog_max_density", extraValuef, extraFound));
 			if(extraFound)
 			{
 				ANKI_CHECK(m_sceneFile.writeTextf("comp:setMaxFogDensity(%f)\n", extraValuef));
+				newBinaryProperty(SceneBinaryPropertyType::kMaxFogDensity, Vec4(extraValuef, 0.0f, 0.0f, 0.0f));
 			}
 
 			ANKI_CHECK(getExtra(extras, "fog_height_of_min_density", extraValuef, extraFound));
 			if(extraFound)
 			{
 				ANKI_CHECK(m_sceneFile.writeTextf("comp:setHeightOfMinFogDensity(%f)\n", extraValuef));
+				newBinaryProperty(SceneBinaryPropertyType::kHeightOfMinFogDensity, Vec4(extraValuef, 0.0f, 0.0f, 0.0f));
 			}
 
 			ANKI_CHECK(getExtra(extras, "fog_height_of_max_density", extraValuef, extraFound));
 			if(extraFound)
 			{
 				ANKI_CHECK(m_sceneFile.writeTextf("comp:setHeightOfMaxFogDensity(%f)\n", extraValuef));
+				newBinaryProperty(SceneBinaryPropertyType::kHeightOfMaxFogDensity, Vec4(extraValuef, 0.0f, 0.0f, 0.0f));
 			}
 
 			ANKI_CHECK(getExtra(extras, "fog_diffuse_color", extraValueVec3, extraFound));
@@ -734,12 +764,14 @@ Error GltfImporter::visitNode(const cgltf_node& node, const Transform& parentTrf
 			{
 				ANKI_CHECK(m_sceneFile.writeTextf("comp:setFogDiffuseColor(Vec3.new(%f, %f, %f))\n", extraValueVec3.x(), extraValueVec3.y(),
 												  extraValueVec3.z()));
+				newBinaryProperty(SceneBinaryPropertyType::kFogDiffuseColor, extraValueVec3.xyz0());
 			}
 
 			ANKI_CHECK(getExtra(extras, "skybox_generated", extraValueBool, extraFound));
 			if(extraFound && extraValueBool)
 			{
 				ANKI_CHECK(m_sceneFile.writeTextf("comp:setGeneratedSky()\n"));
+				newBinaryProperty(SceneBinaryPropertyType::kGeneratedSky);
 			}
 
 			Transform localTrf;
@@ -754,6 +786,12 @@ Error GltfImporter::visitNode(const cgltf_node& node, const Transform& parentTrf
 			const ImporterString meshFname = computeMeshResourceFilename(*node.mesh);
 			ANKI_CHECK(m_sceneFile.writeTextf("comp:loadMeshResource(\"%s%s\")\n", m_rpath.cstr(), meshFname.cstr()));
 
+			ImporterString meshPath;
+			meshPath.sprintf("%s%s", m_rpath.cstr(), meshFname.cstr());
+			newBinaryNode(getNodeName(node));
+			newBinaryComponent(SceneBinaryComponentType::kBody);
+			newBinaryResourceProperty(SceneBinaryPropertyType::kResource, SceneBinaryResourceType::kCpuMesh, meshPath);
+
 			Transform localTrf;
 			ANKI_CHECK(getNodeTransform(node, localTrf));
 			ANKI_CHECK(writeTransform(parentTrf.combineTransformations(localTrf)));
@@ -771,6 +809,9 @@ Error GltfImporter::visitNode(const cgltf_node& node, const Transform& parentTrf
 
 			ANKI_CHECK(m_sceneFile.writeText("comp = node:newReflectionProbeComponent()\n"));
 			ANKI_CHECK(m_sceneFile.writeTextf("comp:setBoxVolumeSize(Vec3.new(%f, %f, %f))\n", boxSize.x(), boxSize.y(), boxSize.z()));
+			newBinaryNode(getNodeName(node));
+			newBinaryComponent(SceneBinaryComponentType::kReflectionProbe);
+			newBinaryProperty(SceneBinaryPropertyType::kBoxVolumeSize, boxSize.xyz0());
 
 			const Transform localTrf = Transform(tsl.xyz0(), Mat3x4(Vec3(0.0f), rot), Vec4(1.0f, 1.0f, 1.0f, 0.0f));
 			ANKI_CHECK(writeTransform(parentTrf.combineTransformations(localTrf)));
@@ -787,17 +828,22 @@ Error GltfImporter::visitNode(const cgltf_node& node, const Transform& parentTrf
 			ANKI_CHECK(m_sceneFile.writeTextf("\nnode = scene:newSceneNode(\"%s\")\n", getNodeName(node).cstr()));
 			ANKI_CHECK(m_sceneFile.writeText("comp = node:newGlobalIlluminationProbeComponent()\n"));
 			ANKI_CHECK(m_sceneFile.writeTextf("comp:setBoxVolumeSize(Vec3.new(%f, %f, %f))\n", boxSize.x(), boxSize.y(), boxSize.z()));
+			newBinaryNode(getNodeName(node));
+			newBinaryComponent(SceneBinaryComponentType::kGlobalIlluminationProbe);
+			newBinaryProperty(SceneBinaryPropertyType::kBoxVolumeSize, boxSize.xyz0());
 
 			ANKI_CHECK(getExtra(extras, "gi_probe_fade_distance", extraValuef, extraFound));
 			if(extraFound && extraValuef > 0.0f)
 			{
 				ANKI_CHECK(m_sceneFile.writeTextf("comp:setFadeDistance(%f)\n", extraValuef));
+				newBinaryProperty(SceneBinaryPropertyType::kFadeDistance, Vec4(extraValuef, 0.0f, 0.0f, 0.0f));
 			}
 
 			ANKI_CHECK(getExtra(extras, "gi_probe_cell_size", extraValuef, extraFound));
 			if(extraFound && extraValuef > 0.0f)
 			{
 				ANKI_CHECK(m_sceneFile.writeTextf("comp:setCellSize(%f)\n", extraValuef));
+				newBinaryProperty(SceneBinaryPropertyType::kCellSize, Vec4(extraValuef, 0.0f, 0.0f, 0.0f));
 			}
 
 			const Transform localTrf = Transform(tsl.xyz0(), Mat3x4(Vec3(0.0f), rot), Vec4(1.0f, 1.0f, 1.0f, 0.0f));
@@ -807,6 +853,8 @@ Error GltfImporter::visitNode(const cgltf_node& node, const Transform& parentTrf
 		{
 			ANKI_CHECK(m_sceneFile.writeTextf("\nnode = scene:newSceneNode(\"%s\")\n", getNodeName(node).cstr()));
 			ANKI_CHECK(m_sceneFile.writeText("comp = node:newDecalComponent()\n"));
+			newBinaryNode(getNodeName(node));
+			newBinaryComponent(SceneBinaryComponentType::kDecal);
 
 			ANKI_CHECK(getExtra(extras, "decal_diffuse_atlas", extraValueStr, extraFound));
 			if(extraFound)
@@ -815,6 +863,8 @@ Error GltfImporter::visitNode(const cgltf_node& node, const Transform& parentTrf
 
 				ANKI_CHECK(
 					m_sceneFile.writeTextf("comp:loadDiffuseImageResource(\"%s\", %f)\n", extraValueStr.cstr(), (extraFound) ? extraValuef : -1.0f));
+				newBinaryResourceProperty(SceneBinaryPropertyType::kResource, SceneBinaryResourceType::kImage, extraValueStr,
+										  (extraFound) ? extraValuef : -1.0f);
 			}
 
 			ANKI_CHECK(getExtra(extras, "decal_diffuse_sub_texture", extraValueStr, extraFound));
@@ -824,6 +874,8 @@ Error GltfImporter::visitNode(const cgltf_node& node, const Transform& parentTrf
 
 				ANKI_CHECK(m_sceneFile.writeTextf("comp:loadRoughnessMetallnessTexture(\"%s\", %f)\n", extraValueStr.cstr(),
 												  (extraFound) ? extraValuef : -1.0f));
+				newBinaryResourceProperty(SceneBinaryPropertyType::kRoughnessMetalnessResource, SceneBinaryResourceType::kImage, extraValueStr,
+										  (extraFound) ? extraValuef : -1.0f);
 			}
 
 			Vec3 tsl;
@@ -878,6 +930,10 @@ Error GltfImporter::visitNode(const cgltf_node& node, const Transform& parentTrf
 
 					ANKI_CHECK(m_sceneFile.writeText("comp:setMeshFromModelComponent()\n"));
 					ANKI_CHECK(m_sceneFile.writeText("comp:teleportTo(trf)\n"));
+
+					// The loader teleports the bodies to the node's transform
+					newBinaryComponent(SceneBinaryComponentType::kBody);
+					newBinaryProperty(SceneBinaryPropertyType::kMeshFromModelComponent);
 				}
 			}
 		}
@@ -922,12 +978,33 @@ Error GltfImporter::writeTransform(const Transform& trf)
 
 	ANKI_CHECK(m_sceneFile.writeText("node:setLocalTransform(trf)\n"));
 
+	if(m_binaryNodes.getSize())
+	{
+		SceneBinaryNode& binNode = m_binaryNodes.getBack();
+		for(U32 i = 0; i < 9; ++i)
+		{
+			binNode.m_rotation[i] = trf.getRotation()(i / 3, i % 3);
+		}
+
+		for(U32 i = 0; i < 3; ++i)
+		{
+			binNode.m_origin[i] = trf.getOrigin()[i];
+			binNode.m_scale[i] = trf.getScale()[i];
+		}
+	}
+
 	return Error::kNone;
 }
 
 Error GltfImporter::writeModel(const cgltf_mesh& mesh) const
 {
 	const ImporterString modelFname = computeModelResourceFilename(mesh);
+
+	if(m_incremental && resourceUpToDate(modelFname, computeModelHash(mesh)))
+	{
+		return Error::kNone;
+	}
+
 	ANKI_IMPORTER_LOGV("Importing model %s", modelFname.cstr());
 
 	ImporterHashMap<CString, ImporterString> extras;
@@ -980,6 +1057,11 @@ Error GltfImporter::writeModel(const cgltf_mesh& mesh) const
 
 Error GltfImporter::writeSkeleton(const cgltf_skin& skin) const
 {
+	if(m_incremental && resourceUpToDate(computeSkeletonResourceFilename(skin), computeSkeletonHash(skin)))
+	{
+		return Error::kNone;
+	}
+
 	ImporterString fname;
 	fname.sprintf("%s%s", m_outDir.cstr(), computeSkeletonResourceFilename(skin).cstr());
 	ANKI_IMPORTER_LOGV("Importing skeleton %s", fname.cstr());
@@ -1055,16 +1137,20 @@ Error GltfImporter::writeLight(const cgltf_node& node, const ImporterHashMap<CSt
 	ANKI_CHECK(appendExtras(node.extras, extras));
 
 	CString lightTypeStr;
+	U32 lightType; // The value of the LightComponentType
 	switch(light.type)
 	{
 	case cgltf_light_type_point:
 		lightTypeStr = "Point";
+		lightType = 0;
 		break;
 	case cgltf_light_type_spot:
 		lightTypeStr = "Spot";
+		lightType = 1;
 		break;
 	case cgltf_light_type_directional:
 		lightTypeStr = "Directional";
+		lightType = 2;
 		break;
 	default:
 		ANKI_IMPORTER_LOGE("Unsupporter light type %d", light.type);
@@ -1074,11 +1160,15 @@ Error GltfImporter::writeLight(const cgltf_node& node, const ImporterHashMap<CSt
 	ANKI_CHECK(m_sceneFile.writeTextf("\nnode = scene:newSceneNode(\"%s\")\n", nodeName.cstr()));
 	ANKI_CHECK(m_sceneFile.writeText("lcomp = node:newLightComponent()\n"));
 	ANKI_CHECK(m_sceneFile.writeTextf("lcomp:setLightComponentType(LightComponentType.k%s)\n", lightTypeStr.cstr()));
+	newBinaryNode(nodeName);
+	newBinaryComponent(SceneBinaryComponentType::kLight);
+	newBinaryProperty(SceneBinaryPropertyType::kLightType, Vec4(0.0f), lightType);
 
 	Vec3 color(light.color[0], light.color[1], light.color[2]);
 	color *= light.intensity;
 	color *= m_lightIntensityScale;
 	ANKI_CHECK(m_sceneFile.writeTextf("lcomp:setDiffuseColor(Vec4.new(%f, %f, %f, 1))\n", color.x(), color.y(), color.z()));
+	newBinaryProperty(SceneBinaryPropertyType::kDiffuseColor, color.xyz1());
 
 	auto shadow = extras.find("shadow");
 	if(shadow != extras.getEnd())
@@ -1086,23 +1176,30 @@ Error GltfImporter::writeLight(const cgltf_node& node, const ImporterHashMap<CSt
 		if(*shadow == "true" || *shadow == "1")
 		{
 			ANKI_CHECK(m_sceneFile.writeText("lcomp:setShadowEnabled(1)\n"));
+			newBinaryProperty(SceneBinaryPropertyType::kShadow, Vec4(0.0f), 1);
 		}
 		else
 		{
 			ANKI_CHECK(m_sceneFile.writeText("lcomp:setShadowEnabled(0)\n"));
+			newBinaryProperty(SceneBinaryPropertyType::kShadow, Vec4(0.0f), 0);
 		}
 	}
 
 	if(light.type == cgltf_light_type_point)
 	{
-		ANKI_CHECK(m_sceneFile.writeTextf("lcomp:setRadius(%f)\n", (light.range > 0.0f) ? light.range : computeLightRadius(color)));
+		const F32 radius = (light.range > 0.0f) ? light.range : computeLightRadius(color);
+		ANKI_CHECK(m_sceneFile.writeTextf("lcomp:setRadius(%f)\n", radius));
+		newBinaryProperty(SceneBinaryPropertyType::kRadius, Vec4(radius, 0.0f, 0.0f, 0.0f));
 	}
 	else if(light.type == cgltf_light_type_spot)
 	{
-		ANKI_CHECK(m_sceneFile.writeTextf("lcomp:setDistance(%f)\n", (light.range > 0.0f) ? light.range : computeLightRadius(color)));
+		const F32 distance = (light.range > 0.0f) ? light.range : computeLightRadius(color);
+		ANKI_CHECK(m_sceneFile.writeTextf("lcomp:setDistance(%f)\n", distance));
+		newBinaryProperty(SceneBinaryPropertyType::kDistance, Vec4(distance, 0.0f, 0.0f, 0.0f));
 
 		const F32 outer = light.spot_outer_cone_angle * 2.0f;
 		ANKI_CHECK(m_sceneFile.writeTextf("lcomp:setOuterAngle(%f)\n", outer));
+		newBinaryProperty(SceneBinaryPropertyType::kOuterAngle, Vec4(outer, 0.0f, 0.0f, 0.0f));
 
 		auto angStr = extras.find("inner_cone_angle_factor");
 		F32 inner;
@@ -1123,6 +1220,34 @@ Error GltfImporter::writeLight(const cgltf_node& node, const ImporterHashMap<CSt
 		}
 
 		ANKI_CHECK(m_sceneFile.writeTextf("lcomp:setInnerAngle(%f)\n", inner));
+		newBinaryProperty(SceneBinaryPropertyType::kInnerAngle, Vec4(inner, 0.0f, 0.0f, 0.0f));
+	}
+
+	auto lightEventIntensity = extras.find("light_event_intensity");
+	auto lightEventFrequency = extras.find("light_event_frequency");
+	if(lightEventIntensity != extras.getEnd() || lightEventFrequency != extras.getEnd())
+	{
+		ANKI_CHECK(m_sceneFile.writeText("event = events:newLightEvent(0.0, -1.0, node)\n"));
+
+		if(lightEventIntensity != extras.getEnd())
+		{
+			ImporterDynamicArray<F64> numbers;
+			const U32 count = 4;
+			ANKI_CHECK(parseArrayOfNumbers(lightEventIntensity->toCString(), numbers, &count));
+			ANKI_CHECK(
+				m_sceneFile.writeTextf("event:setIntensityMultiplier(Vec4.new(%f, %f, %f, %f))\n", numbers[0], numbers[1], numbers[2], numbers[3]));
+			newBinaryProperty(SceneBinaryPropertyType::kLightEventIntensityMultiplier,
+							  Vec4(F32(numbers[0]), F32(numbers[1]), F32(numbers[2]), F32(numbers[3])));
+		}
+
+		if(lightEventFrequency != extras.getEnd())
+		{
+			ImporterDynamicArray<F64> numbers;
+			const U32 count = 2;
+			ANKI_CHECK(parseArrayOfNumbers(lightEventFrequency->toCString(), numbers, &count));
+			ANKI_CHECK(m_sceneFile.writeTextf("event:setFrequency(%f, %f)\n", numbers[0], numbers[1]));
+			newBinaryProperty(SceneBinaryPropertyType::kLightEventFrequency, Vec4(F32(numbers[0]), F32(numbers[1]), 0.0f, 0.0f));
+		}
 	}
 
 	auto lensFlaresFname = extras.find("lens_flare");
@@ -1130,6 +1255,8 @@ Error GltfImporter::writeLight(const cgltf_node& node, const ImporterHashMap<CSt
 	{
 		ANKI_CHECK(m_sceneFile.writeTextf("lfcomp = node:newLensFlareComponent()\n"));
 		ANKI_CHECK(m_sceneFile.writeTextf("lfcomp:loadImageResource(\"%s\")\n", lensFlaresFname->cstr()));
+		newBinaryComponent(SceneBinaryComponentType::kLensFlare);
+		newBinaryResourceProperty(SceneBinaryPropertyType::kResource, SceneBinaryResourceType::kImage, *lensFlaresFname);
 
 		auto lsSpriteSize = extras.find("lens_flare_first_sprite_size");
 		auto lsColor = extras.find("lens_flare_color");
@@ -1141,6 +1268,7 @@ Error GltfImporter::writeLight(const cgltf_node& node, const ImporterHashMap<CSt
 			ANKI_CHECK(parseArrayOfNumbers(lsSpriteSize->toCString(), numbers, &count));
 
 			ANKI_CHECK(m_sceneFile.writeTextf("lfcomp:setFirstFlareSize(Vec2.new(%f, %f))\n", numbers[0], numbers[1]));
+			newBinaryProperty(SceneBinaryPropertyType::kFirstFlareSize, Vec4(F32(numbers[0]), F32(numbers[1]), 0.0f, 0.0f));
 		}
 
 		if(lsColor != extras.getEnd())
@@ -1151,30 +1279,7 @@ Error GltfImporter::writeLight(const cgltf_node& node, const ImporterHashMap<CSt
 
 			ANKI_CHECK(
 				m_sceneFile.writeTextf("lfcomp:setColorMultiplier(Vec4.new(%f, %f, %f, %f))\n", numbers[0], numbers[1], numbers[2], numbers[3]));
-		}
-	}
-
-	auto lightEventIntensity = extras.find("light_event_intensity");
-	auto lightEventFrequency = extras.find("light_event_frequency");
-	if(lightEventIntensity != extras.getEnd() || lightEventFrequency != extras.getEnd())
-	{
-		ANKI_CHECK(m_sceneFile.writeText("event = events:newLightEvent(0.0, -1.0, node)\n"));
-
-		if(lightEventIntensity != extras.getEnd())
-		{
-			ImporterDynamicArray<F64> numbers;
-			const U32 count = 4;
-			ANKI_CHECK(parseArrayOfNumbers(lightEventIntensity->toCString(), numbers, &count));
-			ANKI_CHECK(
-				m_sceneFile.writeTextf("event:setIntensityMultiplier(Vec4.new(%f, %f, %f, %f))\n", numbers[0], numbers[1], numbers[2], numbers[3]));
-		}
-
-		if(lightEventFrequency != extras.getEnd())
-		{
-			ImporterDynamicArray<F64> numbers;
-			const U32 count = 2;
-			ANKI_CHECK(parseArrayOfNumbers(lightEventFrequency->toCString(), numbers, &count));
-			ANKI_CHECK(m_sceneFile.writeTextf("event:setFrequency(%f, %f)\n", numbers[0], numbers[1]));
+			newBinaryProperty(SceneBinaryPropertyType::kColorMultiplier, Vec4(F32(numbers[0]), F32(numbers[1]), F32(numbers[2]), F32(numbers[3])));
 		}
 	}
 
@@ -1199,6 +1304,11 @@ Error GltfImporter::writeCamera(const cgltf_node& node, [[maybe_unused]] const I
 	ANKI_CHECK(
 		m_sceneFile.writeTextf("comp:setPerspective(%f, %f, getRenderer():getAspectRatio() * %f, %f)\n", cam.znear, cam.zfar, cam.yfov, cam.yfov));
 
+	newBinaryNode(getNodeName(node));
+	newBinaryComponent(SceneBinaryComponentType::kCamera);
+	newBinaryProperty(SceneBinaryPropertyType::kActiveCamera);
+	newBinaryProperty(SceneBinaryPropertyType::kPerspective, Vec4(cam.znear, cam.zfar, cam.yfov, 0.0f));
+
 	return Error::kNone;
 }
 
@@ -1214,10 +1324,20 @@ Error GltfImporter::writeModelNode(const cgltf_node& node, const ImporterHashMap
 	ANKI_CHECK(m_sceneFile.writeTextf("\nnode = scene:newSceneNode(\"%s\")\n", getNodeName(node).cstr()));
 	ANKI_CHECK(m_sceneFile.writeTextf("node:newModelComponent():loadModelResource(\"%s%s\")\n", m_rpath.cstr(), modelFname.cstr()));
 
+	ImporterString path;
+	path.sprintf("%s%s", m_rpath.cstr(), modelFname.cstr());
+	newBinaryNode(getNodeName(node));
+	newBinaryComponent(SceneBinaryComponentType::kModel);
+	newBinaryResourceProperty(SceneBinaryPropertyType::kResource, SceneBinaryResourceType::kModel, path);
+
 	if(node.skin)
 	{
 		ANKI_CHECK(m_sceneFile.writeTextf("node:newSkinComponent():loadSkeletonResource(\"%s%s\")\n", m_rpath.cstr(),
 										  computeSkeletonResourceFilename(*node.skin).cstr()));
+
+		path.sprintf("%s%s", m_rpath.cstr(), computeSkeletonResourceFilename(*node.skin).cstr());
+		newBinaryComponent(SceneBinaryComponentType::kSkin);
+		newBinaryResourceProperty(SceneBinaryPropertyType::kResource, SceneBinaryResourceType::kSkeleton, path);
 	}
 
 	return Error::kNone;
@@ -1287,4 +1407,98 @@ ImporterString GltfImporter::computeSkeletonResourceFilename(const cgltf_skin& s
 	return out;
 }
 
+U32 GltfImporter::newBinaryString(CString str)
+{
+	const U32 offset = m_binaryStrings.getSize();
+	for(Char c : str)
+	{
+		m_binaryStrings.emplaceBack(c);
+	}
+	m_binaryStrings.emplaceBack('\0');
+	return offset;
+}
+
+void GltfImporter::newBinaryNode(CString name)
+{
+	SceneBinaryNode& node = *m_binaryNodes.emplaceBack();
+	node.m_nameOffset = newBinaryString(name);
+	node.m_firstComponent = m_binaryComponents.getSize();
+	node.m_scale = {1.0f, 1.0f, 1.0f};
+	node.m_rotation = {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+}
+
+void GltfImporter::newBinaryComponent(SceneBinaryComponentType type)
+{
+	ANKI_ASSERT(m_binaryNodes.getSize());
+
+	SceneBinaryComponent& comp = *m_binaryComponents.emplaceBack();
+	comp.m_type = type;
+	comp.m_firstProperty = m_binaryProperties.getSize();
+
+	++m_binaryNodes.getBack().m_componentCount;
+}
+
+void GltfImporter::newBinaryProperty(SceneBinaryPropertyType type, const Vec4& floatValues, U32 uintValue)
+{
+	ANKI_ASSERT(m_binaryComponents.getSize());
+
+	SceneBinaryProperty& prop = *m_binaryProperties.emplaceBack();
+	prop.m_type = type;
+	for(U32 i = 0; i < 4; ++i)
+	{
+		prop.m_floatValues[i] = floatValues[i];
+	}
+	prop.m_uintValue = uintValue;
+
+	++m_binaryComponents.getBack().m_propertyCount;
+}
+
+void GltfImporter::newBinaryResourceProperty(SceneBinaryPropertyType type, SceneBinaryResourceType rsrcType, CString filename, F32 floatValue)
+{
+	// Resources are shared between the components, load them once
+	const U64 hash = appendHash(&rsrcType, sizeof(rsrcType), computeHash(filename.cstr(), filename.getLength()));
+
+	U32 rsrcIdx;
+	auto it = m_binaryResourceIndices.find(hash);
+	if(it != m_binaryResourceIndices.getEnd())
+	{
+		rsrcIdx = *it;
+	}
+	else
+	{
+		rsrcIdx = m_binaryResources.getSize();
+
+		SceneBinaryResource& rsrc = *m_binaryResources.emplaceBack();
+		rsrc.m_type = rsrcType;
+		rsrc.m_filenameOffset = newBinaryString(filename);
+
+		m_binaryResourceIndices.emplace(hash, rsrcIdx);
+	}
+
+	newBinaryProperty(type, Vec4(floatValue, 0.0f, 0.0f, 0.0f), rsrcIdx);
+}
+
+Error GltfImporter::writeBinaryScene()
+{
+	SceneBinary binary;
+	memcpy(binary.m_magic.getBegin(), kSceneBinaryMagic, sizeof(binary.m_magic));
+	binary.m_nodes = WeakArray<SceneBinaryNode>(m_binaryNodes);
+	binary.m_components = WeakArray<SceneBinaryComponent>(m_binaryComponents);
+	binary.m_properties = WeakArray<SceneBinaryProperty>(m_binaryProperties);
+	binary.m_resources = WeakArray<SceneBinaryResource>(m_binaryResources);
+	binary.m_strings = WeakArray<Char>(m_binaryStrings);
+
+	ImporterString fname;
+	fname.sprintf("%sScene.ankiscene", m_outDir.cstr());
+	ANKI_IMPORTER_LOGV("Writing binary scene: %s", fname.cstr());
+
+	File file;
+	ANKI_CHECK(file.open(fname.toCString(), FileOpenFlag::kWrite | FileOpenFlag::kBinary));
+
+	BinarySerializer serializer;
+	ANKI_CHECK(serializer.serialize(binary, ImporterMemoryPool::getSingleton(), file));
+
+	return Error::kNone;
+}
+
 } // end namespace anki
@@ -10,7 +10,9 @@
 #include <AnKi/Util/StringList.h>
 #include <AnKi/Util/File.h>
 #include <AnKi/Util/HashMap.h>
+#include <AnKi/Util/Thread.h>
 #include <AnKi/Resource/Common.h>
+#include <AnKi/Scene/SceneBinary.h>
 #include <AnKi/Math.h>
 #include <Cgltf/cgltf.h>
 
@@ -35,6 +37,8 @@ public:
 	U32 m_threadCount = kMaxU32;
 	CString m_comment;
 	Bool m_importTextures = false;
+	Bool m_writeBinaryScene = false; ///< Write the scene in the SceneBinary format as well.
+	Bool m_incremental = false; ///< Don't re-write the resources whose source data and settings haven't changed since the last import.
 };
 
 /// Import GLTF and spit AnKi scenes.
@@ -80,6 +84,30 @@ private:
 
 	Bool m_importTextures = false;
 
+	// The scene binary. It's populated at the same time with the scene script
+	Bool m_writeBinaryScene = false;
+	ImporterDynamicArray<SceneBinaryNode> m_binaryNodes;
+	ImporterDynamicArray<SceneBinaryComponent> m_binaryComponents;
+	ImporterDynamicArray<SceneBinaryProperty> m_binaryProperties;
+	ImporterDynamicArray<SceneBinaryResource> m_binaryResources;
+	ImporterDynamicArray<Char> m_binaryStrings;
+	ImporterHashMap<U64, U32> m_binaryResourceIndices; ///< The hash of the filename of a resource to an index in m_binaryResources.
+
+	// Incremental import. The manifest holds the hash of the source data (and the settings) of every resource that was written
+	Bool m_incremental = false;
+	U64 m_settingsHash = 0;
+	ImporterHashMap<ImporterString, U64> m_prevManifest; ///< Read only after init().
+
+	class ManifestEntry
+	{
+	public:
+		ImporterString m_filename;
+		U64 m_hash = 0;
+	};
+
+	mutable ImporterDynamicArray<ManifestEntry> m_manifest;
+	mutable Mutex m_manifestMtx;
+
 	template<typename T>
 	class ImportRequest
 	{
@@ -187,6 +215,30 @@ private:
 	Error writeLight(const cgltf_node& node, const ImporterHashMap<CString, ImporterString>& parentExtras);
 	Error writeCamera(const cgltf_node& node, const ImporterHashMap<CString, ImporterString>& parentExtras);
 	Error writeModelNode(const cgltf_node& node, const ImporterHashMap<CString, ImporterString>& parentExtras);
+
+	// Manifest
+	ImporterString computeManifestFilename() const;
+	Error loadManifest();
+	Error writeManifest() const;
+	U64 computeMeshHash(const cgltf_mesh& mesh) const;
+	Error computeMaterialHash(const cgltf_material& mtl, U64& hash) const;
+	U64 computeModelHash(const cgltf_mesh& mesh) const;
+	U64 computeSkeletonHash(const cgltf_skin& skin) const;
+	U64 computeAnimationHash(const cgltf_animation& anim) const;
+	U64 appendExtrasHash(const cgltf_extras& extras, U64 hash) const;
+
+	/// Record the hash of a resource in the new manifest and check if the resource can be skipped.
+	/// @param filename The filename of the resource relative to the output directory.
+	/// @return True if the resource was written by a previous import with the same hash.
+	Bool resourceUpToDate(CString filename, U64 hash) const;
+
+	// Scene binary
+	U32 newBinaryString(CString str);
+	void newBinaryNode(CString name);
+	void newBinaryComponent(SceneBinaryComponentType type);
+	void newBinaryProperty(SceneBinaryPropertyType type, const Vec4& floatValues = Vec4(0.0f), U32 uintValue = kMaxU32);
+	void newBinaryResourceProperty(SceneBinaryPropertyType type, SceneBinaryResourceType rsrcType, CString filename, F32 floatValue = 0.0f);
+	Error writeBinaryScene();
 };
 /// @}
 
@@ -111,6 +111,12 @@ Error GltfImporter::writeAnimation(const cgltf_animation& anim)
 	ImporterString animFname = computeAnimationResourceFilename(anim);
 	fname.sprintf("%s%s", m_outDir.cstr(), animFname.cstr());
 	fname = fixFilename(fname);
+
+	if(m_incremental && resourceUpToDate(fixFilename(animFname), computeAnimationHash(anim)))
+	{
+		return Error::kNone;
+	}
+
 	ANKI_IMPORTER_LOGV("Importing animation %s", fname.cstr());
 
 	// Gather the channels
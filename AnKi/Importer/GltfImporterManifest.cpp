@@ -0,0 +1,310 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Importer/GltfImporter.h>
+#include <AnKi/Util/Filesystem.h>
+#include <algorithm>
+
+namespace anki {
+
+/// Bump it every time the output of the importer changes to invalidate the manifests of previous imports.
+inline constexpr U64 kImporterVersion = 1;
+
+static U64 appendStringHash(CString str, U64 hash)
+{
+	const U64 len = str.getLength();
+	hash = appendObjectHash(len, hash);
+	return (len) ? appendHash(str.cstr(), len, hash) : hash;
+}
+
+static U64 appendAccessorHash(const cgltf_accessor* accessor, U64 hash)
+{
+	if(!accessor)
+	{
+		return appendObjectHash(kMaxU64, hash);
+	}
+
+	hash = appendObjectHash(accessor->count, hash);
+	hash = appendObjectHash(accessor->type, hash);
+	hash = appendObjectHash(accessor->component_type, hash);
+	hash = appendObjectHash(accessor->normalized, hash);
+
+	if(!accessor->buffer_view || !accessor->buffer_view->buffer->data || accessor->count == 0)
+	{
+		return hash;
+	}
+
+	const U8* base = static_cast<const U8*>(accessor->buffer_view->buffer->data) + accessor->offset + accessor->buffer_view->offset;
+	const PtrSize elementSize = accessor->stride; // cgltf sets it to the size of the element
+	const PtrSize stride = (accessor->buffer_view->stride) ? accessor->buffer_view->stride : accessor->stride;
+
+	if(stride == elementSize)
+	{
+		hash = appendHash(base, elementSize * accessor->count, hash);
+	}
+	else
+	{
+		// Interleaved, skip the bytes of the other attributes
+		for(cgltf_size i = 0; i < accessor->count; ++i)
+		{
+			hash = appendHash(base + i * stride, elementSize, hash);
+		}
+	}
+
+	return hash;
+}
+
+static U64 appendNodeTransformHash(const cgltf_node& node, U64 hash)
+{
+	hash = appendObjectHash(node.has_matrix, hash);
+	if(node.has_matrix)
+	{
+		return appendHash(node.matrix, sizeof(node.matrix), hash);
+	}
+
+	hash = appendHash(node.translation, sizeof(node.translation), hash);
+	hash = appendHash(node.rotation, sizeof(node.rotation), hash);
+	hash = appendHash(node.scale, sizeof(node.scale), hash);
+	return hash;
+}
+
+/// The material reads the textures so hash their contents.
+static Error appendTextureHash(const cgltf_texture_view& view, U64& hash)
+{
+	if(!view.texture || !view.texture->image || !view.texture->image->uri)
+	{
+		hash = appendObjectHash(kMaxU64, hash);
+		return Error::kNone;
+	}
+
+	ImporterString uri = view.texture->image->uri;
+	uri.replaceAll("%20", " ");
+	hash = appendStringHash(uri, hash);
+
+	File file;
+	ANKI_CHECK(file.open(uri, FileOpenFlag::kRead | FileOpenFlag::kBinary));
+
+	ImporterDynamicArrayLarge<U8> data;
+	data.resize(file.getSize());
+	if(data.getSize())
+	{
+		ANKI_CHECK(file.read(&data[0], data.getSize()));
+		hash = appendHash(&data[0], data.getSize(), hash);
+	}
+
+	return Error::kNone;
+}
+
+ImporterString GltfImporter::computeManifestFilename() const
+{
+	ImporterString fname;
+	fname.sprintf("%sImportManifest.txt", m_outDir.cstr());
+	return fname;
+}
+
+Error GltfImporter::loadManifest()
+{
+	// Everything that affects the output goes to the settings hash
+	U64 hash = computeObjectHash(kImporterVersion);
+	hash = appendStringHash(m_rpath, hash);
+	hash = appendStringHash(m_texrpath, hash);
+	hash = appendObjectHash(m_optimizeMeshes, hash);
+	hash = appendObjectHash(m_optimizeAnimations, hash);
+	hash = appendObjectHash(m_lodCount, hash);
+	hash = appendObjectHash(m_lodFactor, hash);
+	hash = appendObjectHash(m_normalsMergeAngle, hash);
+	hash = appendObjectHash(m_skipLodVertexCountThreshold, hash);
+	hash = appendObjectHash(m_importTextures, hash);
+	m_settingsHash = hash;
+
+	const ImporterString fname = computeManifestFilename();
+	if(!fileExists(fname))
+	{
+		ANKI_IMPORTER_LOGI("No import manifest found. Will import everything");
+		return Error::kNone;
+	}
+
+	File file;
+	ANKI_CHECK(file.open(fname, FileOpenFlag::kRead));
+	ImporterString txt;
+	ANKI_CHECK(file.readAllText(txt));
+
+	ImporterStringList lines;
+	lines.splitString(txt, '\n');
+	for(const ImporterString& line : lines)
+	{
+		// Format: <hash in hex> <filename>
+		if(line.isEmpty() || line[0] == '#')
+		{
+			continue;
+		}
+
+		U64 resourceHash;
+		Array<Char, 512> resourceFname;
+		if(sscanf(line.cstr(), "%" SCNx64 " %511s", &resourceHash, &resourceFname[0]) != 2)
+		{
+			ANKI_IMPORTER_LOGW("Ignoring corrupted import manifest: %s", fname.cstr());
+			m_prevManifest.destroy();
+			break;
+		}
+
+		m_prevManifest.emplace(ImporterString(&resourceFname[0]), resourceHash);
+	}
+
+	return Error::kNone;
+}
+
+Error GltfImporter::writeManifest() const
+{
+	// Sort to make the file deterministic. The resources are written from multiple threads
+	std::sort(m_manifest.getBegin(), m_manifest.getEnd(), [](const ManifestEntry& a, const ManifestEntry& b) {
+		return a.m_filename < b.m_filename;
+	});
+
+	File file;
+	ANKI_CHECK(file.open(computeManifestFilename(), FileOpenFlag::kWrite));
+	ANKI_CHECK(file.writeTextf("# Generated by: %s\n", m_comment.cstr()));
+	for(U32 i = 0; i < m_manifest.getSize(); ++i)
+	{
+		// Some resources are requested more than once (eg the materials with and without ray tracing)
+		if(i > 0 && m_manifest[i].m_filename == m_manifest[i - 1].m_filename)
+		{
+			continue;
+		}
+
+		ANKI_CHECK(file.writeTextf("%016" PRIx64 " %s\n", m_manifest[i].m_hash, m_manifest[i].m_filename.cstr()));
+	}
+
+	return Error::kNone;
+}
+
+Bool GltfImporter::resourceUpToDate(CString filename, U64 hash) const
+{
+	ANKI_ASSERT(m_incremental);
+
+	{
+		LockGuard lock(m_manifestMtx);
+		ManifestEntry& entry = *m_manifest.emplaceBack();
+		entry.m_filename = filename;
+		entry.m_hash = hash;
+	}
+
+	auto it = m_prevManifest.find(ImporterString(filename));
+	if(it == m_prevManifest.getEnd() || *it != hash)
+	{
+		return false;
+	}
+
+	// Someone might have deleted it
+	ImporterString fullFname;
+	fullFname.sprintf("%s%s", m_outDir.cstr(), filename.cstr());
+	if(!fileExists(fullFname))
+	{
+		return false;
+	}
+
+	ANKI_IMPORTER_LOGV("Resource is up to date, skipping: %s", filename.cstr());
+	return true;
+}
+
+U64 GltfImporter::appendExtrasHash(const cgltf_extras& extras, U64 hash) const
+{
+	const PtrSize size = extras.end_offset - extras.start_offset;
+	hash = appendObjectHash(size, hash);
+	return (size) ? appendHash(m_gltf->json + extras.start_offset, size, hash) : hash;
+}
+
+U64 GltfImporter::computeMeshHash(const cgltf_mesh& mesh) const
+{
+	U64 hash = appendStringHash(computeMeshResourceFilename(mesh), m_settingsHash);
+
+	for(const cgltf_primitive* prim = mesh.primitives; prim < mesh.primitives + mesh.primitives_count; ++prim)
+	{
+		hash = appendObjectHash(prim->type, hash);
+		hash = appendAccessorHash(prim->indices, hash);
+
+		for(const cgltf_attribute* attrib = prim->attributes; attrib < prim->attributes + prim->attributes_count; ++attrib)
+		{
+			hash = appendObjectHash(attrib->type, hash);
+			hash = appendObjectHash(attrib->index, hash);
+			hash = appendAccessorHash(attrib->data, hash);
+		}
+	}
+
+	return hash;
+}
+
+Error GltfImporter::computeMaterialHash(const cgltf_material& mtl, U64& hash) const
+{
+	hash = appendStringHash(computeMaterialResourceFilename(mtl), m_settingsHash);
+	hash = appendExtrasHash(mtl.extras, hash);
+
+	hash = appendObjectHash(mtl.has_pbr_metallic_roughness, hash);
+	const cgltf_pbr_metallic_roughness& pbr = mtl.pbr_metallic_roughness;
+	hash = appendHash(pbr.base_color_factor, sizeof(pbr.base_color_factor), hash);
+	hash = appendObjectHash(pbr.metallic_factor, hash);
+	hash = appendObjectHash(pbr.roughness_factor, hash);
+	hash = appendHash(mtl.emissive_factor, sizeof(mtl.emissive_factor), hash);
+	hash = appendObjectHash(mtl.alpha_mode, hash);
+	hash = appendObjectHash(mtl.alpha_cutoff, hash);
+	hash = appendObjectHash(mtl.double_sided, hash);
+
+	ANKI_CHECK(appendTextureHash(pbr.base_color_texture, hash));
+	ANKI_CHECK(appendTextureHash(pbr.metallic_roughness_texture, hash));
+	ANKI_CHECK(appendTextureHash(mtl.normal_texture, hash));
+	ANKI_CHECK(appendTextureHash(mtl.emissive_texture, hash));
+
+	return Error::kNone;
+}
+
+U64 GltfImporter::computeModelHash(const cgltf_mesh& mesh) const
+{
+	U64 hash = appendStringHash(computeModelResourceFilename(mesh), m_settingsHash);
+	hash = appendStringHash(computeMeshResourceFilename(mesh), hash);
+	hash = appendObjectHash(mesh.primitives_count, hash);
+
+	for(const cgltf_primitive* prim = mesh.primitives; prim < mesh.primitives + mesh.primitives_count; ++prim)
+	{
+		// The extras might override the material
+		hash = appendStringHash(computeMaterialResourceFilename(*prim->material), hash);
+		hash = appendExtrasHash(prim->material->extras, hash);
+	}
+
+	return hash;
+}
+
+U64 GltfImporter::computeSkeletonHash(const cgltf_skin& skin) const
+{
+	U64 hash = appendStringHash(computeSkeletonResourceFilename(skin), m_settingsHash);
+	hash = appendAccessorHash(skin.inverse_bind_matrices, hash);
+
+	for(U32 i = 0; i < skin.joints_count; ++i)
+	{
+		const cgltf_node& boneNode = *skin.joints[i];
+		hash = appendStringHash(getNodeName(boneNode), hash);
+		hash = appendStringHash((boneNode.parent) ? getNodeName(*boneNode.parent) : ImporterString(), hash);
+		hash = appendNodeTransformHash(boneNode, hash);
+	}
+
+	return hash;
+}
+
+U64 GltfImporter::computeAnimationHash(const cgltf_animation& anim) const
+{
+	U64 hash = appendStringHash(computeAnimationResourceFilename(anim), m_settingsHash);
+
+	for(const cgltf_animation_channel* channel = anim.channels; channel < anim.channels + anim.channels_count; ++channel)
+	{
+		hash = appendStringHash(getNodeName(*channel->target_node), hash);
+		hash = appendObjectHash(channel->target_path, hash);
+		hash = appendObjectHash(channel->sampler->interpolation, hash);
+		hash = appendAccessorHash(channel->sampler->input, hash);
+		hash = appendAccessorHash(channel->sampler->output, hash);
+	}
+
+	return hash;
+}
+
+} // end namespace anki
@@ -110,10 +110,8 @@ static Error importImage(CString in, CString out, Bool alpha)
 	config.m_tempDirectory = tmp;
 
 #if ANKI_OS_WINDOWS
-	config.m_compressonatorFilename = ANKI_SOURCE_DIRECTORY "/ThirdParty/Bin/Windows64/Compressonator/compressonatorcli.exe";
 	config.m_astcencFilename = ANKI_SOURCE_DIRECTORY "/ThirdParty/Bin/Windows64/astcenc-avx2.exe";
 #elif ANKI_OS_LINUX
-	config.m_compressonatorFilename = ANKI_SOURCE_DIRECTORY "/ThirdParty/Bin/Linux64/Compressonator/compressonatorcli";
 	config.m_astcencFilename = ANKI_SOURCE_DIRECTORY "/ThirdParty/Bin/Linux64/astcenc-avx2";
 #else
 #	error "Unupported"
@@ -137,6 +135,16 @@ static void fixImageUri(ImporterString& uri)
 
 Error GltfImporter::writeMaterial(const cgltf_material& mtl, Bool writeRayTracing) const
 {
+	if(m_incremental)
+	{
+		U64 hash;
+		ANKI_CHECK(computeMaterialHash(mtl, hash));
+		if(resourceUpToDate(computeMaterialResourceFilename(mtl), hash))
+		{
+			return Error::kNone;
+		}
+	}
+
 	const Error err = writeMaterialInternal(mtl, writeRayTracing);
 	if(err)
 	{
@@ -492,6 +492,11 @@ U32 GltfImporter::getMeshTotalVertexCount(const cgltf_mesh& mesh)
 
 Error GltfImporter::writeMesh(const cgltf_mesh& mesh) const
 {
+	if(m_incremental && resourceUpToDate(computeMeshResourceFilename(mesh), computeMeshHash(mesh)))
+	{
+		return Error::kNone;
+	}
+
 	const Error err = writeMeshInternal(mesh);
 	if(err)
 	{
@@ -10,6 +10,7 @@
 #include <AnKi/Util/Process.h>
 #include <AnKi/Util/File.h>
 #include <AnKi/Util/Filesystem.h>
+#include <AnKi/Util/ThreadJobManager.h>
 
 namespace anki {
 
@@ -219,77 +220,6 @@ static Error checkInputImages(const ImageImporterConfig& config, U32& width, U32
 	return Error::kNone;
 }
 
-static Error resizeImage(CString inImageFilename, U32 outWidth, U32 outHeight, CString tempDirectory, ImporterString& tmpFilename)
-{
-	U32 inWidth, inHeight, channelCount;
-	Bool hdr;
-	ANKI_CHECK(identifyImage(inImageFilename, inWidth, inHeight, channelCount, hdr));
-
-	// Load
-	void* inPixels;
-	if(!hdr)
-	{
-		I32 width, height;
-		inPixels = stbi_load(inImageFilename.cstr(), &width, &height, nullptr, channelCount);
-	}
-	else
-	{
-		I32 width, height;
-		inPixels = stbi_loadf(inImageFilename.cstr(), &width, &height, nullptr, channelCount);
-	}
-
-	if(!inPixels)
-	{
-		ANKI_IMPORTER_LOGE("STB load failed: %s", inImageFilename.cstr());
-		return Error::kFunctionFailed;
-	}
-
-	// Resize
-	I ok;
-	ImporterDynamicArray<U8> outPixels;
-	if(!hdr)
-	{
-		outPixels.resize(outWidth * outHeight * channelCount);
-		ok = stbir_resize_uint8(static_cast<const U8*>(inPixels), inWidth, inHeight, 0, outPixels.getBegin(), outWidth, outHeight, 0, channelCount);
-	}
-	else
-	{
-		outPixels.resize(outWidth * outHeight * channelCount * sizeof(F32));
-		ok = stbir_resize_float(static_cast<const F32*>(inPixels), inWidth, inHeight, 0, reinterpret_cast<F32*>(outPixels.getBegin()), outWidth,
-								outHeight, 0, channelCount);
-	}
-
-	stbi_image_free(inPixels);
-
-	if(!ok)
-	{
-		ANKI_IMPORTER_LOGE("stbir_resize_xxx() failed to resize the image: %s", inImageFilename.cstr());
-		return Error::kFunctionFailed;
-	}
-
-	// Store
-	tmpFilename.sprintf("%s/AnKiImageImporter_%u.%s", tempDirectory.cstr(), g_tempFileIndex.fetchAdd(1), (hdr) ? "exr" : "png");
-	ANKI_IMPORTER_LOGV("Will store: %s", tmpFilename.cstr());
-
-	if(!hdr)
-	{
-		ok = stbi_write_png(tmpFilename.cstr(), outWidth, outHeight, channelCount, outPixels.getBegin(), 0);
-	}
-	else
-	{
-		const I ret = SaveEXR(reinterpret_cast<const F32*>(outPixels.getBegin()), outWidth, outHeight, channelCount, 0, tmpFilename.cstr(), nullptr);
-		ok = ret >= 0;
-	}
-
-	if(!ok)
-	{
-		ANKI_IMPORTER_LOGE("Failed to create: %s", tmpFilename.cstr());
-		return Error::kFunctionFailed;
-	}
-
-	return Error::kNone;
-}
-
 static Vec3 linearToSRgb(Vec3 p)
 {
 	Vec3 cutoff;
@@ -408,6 +338,33 @@ static Error loadFirstMipmap(const ImageImporterConfig& config, ImageImporterCon
 			return Error::kFunctionFailed;
 		}
 
+		// Resize in memory if the image is smaller than the min mipmap dimension
+		ImporterDynamicArrayLarge<U8> resizedPixels;
+		if(U32(width) != ctx.m_width || U32(height) != ctx.m_height)
+		{
+			resizedPixels.resize(PtrSize(ctx.m_width) * ctx.m_height * ctx.m_pixelSize);
+			I ok;
+			if(!ctx.m_hdr)
+			{
+				ok = stbir_resize_uint8(static_cast<const U8*>(data), width, height, 0, resizedPixels.getBegin(), ctx.m_width, ctx.m_height, 0,
+										ctx.m_channelCount);
+			}
+			else
+			{
+				ok = stbir_resize_float(static_cast<const F32*>(data), width, height, 0, reinterpret_cast<F32*>(resizedPixels.getBegin()),
+										ctx.m_width, ctx.m_height, 0, ctx.m_channelCount);
+			}
+
+			stbi_image_free(data);
+			data = resizedPixels.getBegin();
+
+			if(!ok)
+			{
+				ANKI_IMPORTER_LOGE("stbir_resize_xxx() failed to resize the image: %s", config.m_inputFilenames[i].cstr());
+				return Error::kFunctionFailed;
+			}
+		}
+
 		const PtrSize dataSize = PtrSize(ctx.m_width) * ctx.m_height * ctx.m_pixelSize;
 
 		// To conversions in place
@@ -483,7 +440,10 @@ static Error loadFirstMipmap(const ImageImporterConfig& config, ImageImporterCon
 			memcpy(mip0.m_surfacesOrVolume[i].m_pixels.getBegin(), data, dataSize);
 		}
 
-		stbi_image_free(data);
+		if(resizedPixels.isEmpty())
+		{
+			stbi_image_free(data);
+		}
 	}
 
 	return Error::kNone;
@@ -862,32 +822,13 @@ static Error importImageInternal(const ImageImporterConfig& configOriginal)
 	Bool isHdr;
 	ANKI_CHECK(checkInputImages(config, width, height, channelCount, isHdr));
 
-	// Resize
-	ImporterDynamicArray<ImporterString> newFilenames;
-	ImporterDynamicArray<CString> newFilenamesCString;
-	ImporterDynamicArray<CleanupFile> resizedImagesCleanup;
+	// The first mipmap will be resized in memory while loading
 	if(width < config.m_minMipmapDimension || height < config.m_minMipmapDimension)
 	{
-		const U32 newWidth = max(width, config.m_minMipmapDimension);
-		const U32 newHeight = max(height, config.m_minMipmapDimension);
+		width = max(width, config.m_minMipmapDimension);
+		height = max(height, config.m_minMipmapDimension);
 
-		ANKI_IMPORTER_LOGV("Image is smaller than the min mipmap dimension. Will resize it to %ux%u", newWidth, newHeight);
-
-		newFilenames.resize(config.m_inputFilenames.getSize());
-		newFilenamesCString.resize(config.m_inputFilenames.getSize());
-
-		for(U32 i = 0; i < config.m_inputFilenames.getSize(); ++i)
-		{
-			ANKI_CHECK(resizeImage(config.m_inputFilenames[i], newWidth, newHeight, config.m_tempDirectory, newFilenames[i]));
-
-			newFilenamesCString[i] = newFilenames[i];
-			resizedImagesCleanup.emplaceBack(newFilenames[i]);
-		}
-
-		// Override config
-		config.m_inputFilenames = newFilenamesCString;
-		width = newWidth;
-		height = newHeight;
+		ANKI_IMPORTER_LOGV("Image is smaller than the min mipmap dimension. Will resize it to %ux%u", width, height);
 	}
 
 	// Init image
@@ -1021,8 +962,18 @@ static Error importImageInternal(const ImageImporterConfig& configOriginal)
 
 					surface.m_s3tcPixels.resize(s3tcImageSize);
 
-					ANKI_CHECK(compressS3tc(config.m_tempDirectory, config.m_compressonatorFilename, ConstWeakArray<U8, PtrSize>(surface.m_pixels),
-											width, height, ctx.m_channelCount, ctx.m_hdr, WeakArray<U8, PtrSize>(surface.m_s3tcPixels)));
+					if(config.m_compressonatorFilename.getLength())
+					{
+						ANKI_CHECK(compressS3tc(config.m_tempDirectory, config.m_compressonatorFilename,
+												ConstWeakArray<U8, PtrSize>(surface.m_pixels), width, height, ctx.m_channelCount, ctx.m_hdr,
+												WeakArray<U8, PtrSize>(surface.m_s3tcPixels)));
+					}
+					else
+					{
+						// The encoder splits the surface to tasks on its own
+						compressS3tcSurface(ConstWeakArray<U8, PtrSize>(surface.m_pixels), width, height, ctx.m_channelCount, ctx.m_hdr,
+											config.m_s3tcQuality, WeakArray<U8, PtrSize>(surface.m_s3tcPixels), config.m_jobManager);
+					}
 				}
 			}
 		}
@@ -1032,6 +983,8 @@ static Error importImageInternal(const ImageImporterConfig& configOriginal)
 	{
 		ANKI_IMPORTER_LOGV("Will compress in ASTC");
 
+		// astcenc runs as a separate process per surface. Spawn them in parallel if possible
+		Atomic<U32> errorCount = {0};
 		for(U32 mip = 0; mip < mipCount; ++mip)
 		{
 			for(U32 l = 0; l < ctx.m_layerCount; ++l)
@@ -1048,12 +1001,37 @@ static Error importImageInternal(const ImageImporterConfig& configOriginal)
 
 					surface.m_astcPixels.resize(astcImageSize);
 
-					ANKI_CHECK(compressAstc(config.m_tempDirectory, config.m_astcencFilename, ConstWeakArray<U8, PtrSize>(surface.m_pixels), width,
-											height, ctx.m_channelCount, config.m_astcBlockSize, ctx.m_hdr,
-											WeakArray<U8, PtrSize>(surface.m_astcPixels)));
+					auto func = [&config, &ctx, &surface, &errorCount, width, height]([[maybe_unused]] U32 threadId) {
+						const Error err =
+							compressAstc(config.m_tempDirectory, config.m_astcencFilename, ConstWeakArray<U8, PtrSize>(surface.m_pixels), width,
+										 height, ctx.m_channelCount, config.m_astcBlockSize, ctx.m_hdr, WeakArray<U8, PtrSize>(surface.m_astcPixels));
+						if(err)
+						{
+							errorCount.fetchAdd(1);
+						}
+					};
+
+					if(config.m_jobManager)
+					{
+						config.m_jobManager->dispatchTask(func);
+					}
+					else
+					{
+						func(0);
+					}
 				}
 			}
 		}
+
+		if(config.m_jobManager)
+		{
+			config.m_jobManager->waitForAllTasksToFinish();
+		}
+
+		if(errorCount.load())
+		{
+			return Error::kFunctionFailed;
+		}
 	}
 
 	if(!!(config.m_compressions & ImageBinaryDataCompression::kEtc))
@@ -4,12 +4,16 @@
 // http://www.anki3d.org/LICENSE
 
 #include <AnKi/Importer/Common.h>
+#include <AnKi/Importer/S3tcEncoder.h>
 #include <AnKi/Util/String.h>
 #include <AnKi/Util/WeakArray.h>
 #include <AnKi/Resource/ImageBinary.h>
 
 namespace anki {
 
+// Forward
+class ThreadJobManager;
+
 /// @addtogroup importer
 /// @{
 
@@ -26,7 +30,8 @@ public:
 	U32 m_mipmapCount = kMaxU32;
 	Bool m_noAlpha = true;
 	CString m_tempDirectory;
-	CString m_compressonatorFilename; ///< Optional.
+	CString m_compressonatorFilename; ///< Optional. If set the S3TC compression is done by compressonator instead of the built-in encoder.
+	S3tcEncoderQuality m_s3tcQuality = S3tcEncoderQuality::kNormal; ///< Quality of the built-in S3TC encoder.
 	CString m_astcencFilename; ///< Optional.
 	Vec3 m_hdrScale = Vec3(1.0f); ///< Scale the values of HDR textures.
 	Vec3 m_hdrBias = Vec3(0.0f); ///< Add that value to the HDR textures.
@@ -34,6 +39,7 @@ public:
 	Bool m_sRgbToLinear = false;
 	Bool m_linearToSRgb = false;
 	Bool m_flipImage = true;
+	ThreadJobManager* m_jobManager = nullptr; ///< Optional. If set the compression happens in parallel. Don't call importImage() from its threads.
 };
 
 /// Converts images to AnKi's specific format.
@@ -0,0 +1,564 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Importer/S3tcEncoder.h>
+#include <AnKi/Util/ThreadJobManager.h>
+#include <AnKi/Util/F16.h>
+
+namespace anki {
+
+namespace {
+
+/// Writes bits starting from the LSB of the first byte.
+class BitWriter
+{
+public:
+	BitWriter(WeakArray<U8> out)
+		: m_out(out)
+	{
+		memset(m_out.getBegin(), 0, m_out.getSizeInBytes());
+	}
+
+	void write(U32 value, U32 bitCount)
+	{
+		for(U32 i = 0; i < bitCount; ++i)
+		{
+			if((value >> i) & 1u)
+			{
+				m_out[m_bit / 8] |= U8(1u << (m_bit % 8));
+			}
+			++m_bit;
+		}
+	}
+
+	U32 getBitCount() const
+	{
+		return m_bit;
+	}
+
+private:
+	WeakArray<U8> m_out;
+	U32 m_bit = 0;
+};
+
+class Bc1Candidate
+{
+public:
+	U16 m_color0 = 0;
+	U16 m_color1 = 0;
+	U32 m_indices = 0;
+	F32 m_error = kMaxF32;
+};
+
+class Bc6hCandidate
+{
+public:
+	Array<UVec3, 2> m_endpoints; ///< Quantized to 10 bits.
+	Array<U8, 16> m_indices;
+	F32 m_error = kMaxF32;
+};
+
+} // namespace
+
+/// The weights of the 4bit indices of BC6H.
+static constexpr Array<U32, 16> kBc6hWeights = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/// The interpolation factors of the 4 BC1 indices.
+static constexpr Array<F32, 4> kBc1Weights = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+
+/// Find the endpoints of a segment that goes through a set of points.
+/// @param paletteSize The number of interpolated values between the endpoints. Used to inset the bounding box.
+static void findEndpoints(const Array<Vec3, 16>& points, S3tcEncoderQuality quality, U32 paletteSize, Vec3& a, Vec3& b)
+{
+	Vec3 mean(0.0f);
+	Vec3 minp(kMaxF32);
+	Vec3 maxp(kMinF32);
+	for(const Vec3& p : points)
+	{
+		mean += p;
+		minp = minp.min(p);
+		maxp = maxp.max(p);
+	}
+	mean /= 16.0f;
+
+	// Covariance matrix
+	F32 xx = 0.0f, xy = 0.0f, xz = 0.0f, yy = 0.0f, yz = 0.0f, zz = 0.0f;
+	for(const Vec3& p : points)
+	{
+		const Vec3 d = p - mean;
+		xx += d.x() * d.x();
+		xy += d.x() * d.y();
+		xz += d.x() * d.z();
+		yy += d.y() * d.y();
+		yz += d.y() * d.z();
+		zz += d.z() * d.z();
+	}
+
+	if(quality == S3tcEncoderQuality::kFast)
+	{
+		// Pick the diagonal of the bounding box that follows the correlation of the channels
+		a = minp;
+		b = maxp;
+		const F32 primary = max(xx, max(yy, zz));
+		const F32 corrY = (primary == yy) ? 1.0f : ((primary == xx) ? xy : yz);
+		const F32 corrZ = (primary == zz) ? 1.0f : ((primary == xx) ? xz : yz);
+		const F32 corrX = (primary == xx) ? 1.0f : ((primary == yy) ? xy : xz);
+		if(corrX < 0.0f)
+		{
+			std::swap(a.x(), b.x());
+		}
+		if(corrY < 0.0f)
+		{
+			std::swap(a.y(), b.y());
+		}
+		if(corrZ < 0.0f)
+		{
+			std::swap(a.z(), b.z());
+		}
+
+		// Inset by half a palette step to reduce the error of the extremes
+		const Vec3 inset = (b - a) / F32(4 * (paletteSize - 1));
+		a += inset;
+		b -= inset;
+		return;
+	}
+
+	// Principal axis using power iteration
+	Vec3 axis = maxp - minp;
+	if(axis.getLengthSquared() < kEpsilonf)
+	{
+		a = mean;
+		b = mean;
+		return;
+	}
+
+	for(U32 i = 0; i < 8; ++i)
+	{
+		const Vec3 newAxis(xx * axis.x() + xy * axis.y() + xz * axis.z(), xy * axis.x() + yy * axis.y() + yz * axis.z(),
+						   xz * axis.x() + yz * axis.y() + zz * axis.z());
+		const F32 len = newAxis.getLength();
+		if(len < kEpsilonf)
+		{
+			break;
+		}
+		axis = newAxis / len;
+	}
+
+	F32 minProj = kMaxF32;
+	F32 maxProj = kMinF32;
+	for(const Vec3& p : points)
+	{
+		const F32 proj = (p - mean).dot(axis);
+		minProj = min(minProj, proj);
+		maxProj = max(maxProj, proj);
+	}
+
+	a = mean + axis * minProj;
+	b = mean + axis * maxProj;
+}
+
+/// Given the interpolation factor of every point find the endpoints that minimize the error.
+static Bool leastSquaresEndpoints(const Array<Vec3, 16>& points, const Array<F32, 16>& factors, Vec3& a, Vec3& b)
+{
+	F32 aa = 0.0f, bb = 0.0f, ab = 0.0f;
+	Vec3 ax(0.0f), bx(0.0f);
+	for(U32 i = 0; i < 16; ++i)
+	{
+		const F32 beta = factors[i];
+		const F32 alpha = 1.0f - beta;
+		aa += alpha * alpha;
+		bb += beta * beta;
+		ab += alpha * beta;
+		ax += points[i] * alpha;
+		bx += points[i] * beta;
+	}
+
+	const F32 det = aa * bb - ab * ab;
+	if(absolute(det) < kEpsilonf)
+	{
+		return false;
+	}
+
+	a = (ax * bb - bx * ab) / det;
+	b = (bx * aa - ax * ab) / det;
+	return true;
+}
+
+static U16 packRgb565(Vec3 c)
+{
+	c = c.clamp(0.0f, 255.0f);
+	const U32 r = U32(c.x() * 31.0f / 255.0f + 0.5f);
+	const U32 g = U32(c.y() * 63.0f / 255.0f + 0.5f);
+	const U32 b = U32(c.z() * 31.0f / 255.0f + 0.5f);
+	return U16((r << 11) | (g << 5) | b);
+}
+
+static Vec3 unpackRgb565(U16 c)
+{
+	const U32 r = (c >> 11) & 31u;
+	const U32 g = (c >> 5) & 63u;
+	const U32 b = c & 31u;
+	return Vec3(F32((r << 3) | (r >> 2)), F32((g << 2) | (g >> 4)), F32((b << 3) | (b >> 2)));
+}
+
+static Bc1Candidate encodeBc1Candidate(const Array<Vec3, 16>& points, Vec3 a, Vec3 b)
+{
+	Bc1Candidate c;
+	c.m_color0 = packRgb565(a);
+	c.m_color1 = packRgb565(b);
+
+	// color0 > color1 selects the 4 color mode
+	if(c.m_color0 < c.m_color1)
+	{
+		std::swap(c.m_color0, c.m_color1);
+	}
+
+	Array<Vec3, 4> palette;
+	palette[0] = unpackRgb565(c.m_color0);
+	palette[1] = unpackRgb565(c.m_color1);
+	palette[2] = (palette[0] * 2.0f + palette[1]) / 3.0f;
+	palette[3] = (palette[0] + palette[1] * 2.0f) / 3.0f;
+
+	const U32 paletteSize = (c.m_color0 == c.m_color1) ? 1 : 4;
+
+	c.m_error = 0.0f;
+	for(U32 i = 0; i < 16; ++i)
+	{
+		U32 bestIdx = 0;
+		F32 bestError = kMaxF32;
+		for(U32 p = 0; p < paletteSize; ++p)
+		{
+			const F32 error = (points[i] - palette[p]).getLengthSquared();
+			if(error < bestError)
+			{
+				bestError = error;
+				bestIdx = p;
+			}
+		}
+
+		c.m_indices |= bestIdx << (i * 2);
+		c.m_error += bestError;
+	}
+
+	return c;
+}
+
+static Bc1Candidate encodeBc1Color(const Array<Vec3, 16>& points, S3tcEncoderQuality quality)
+{
+	Vec3 a, b;
+	findEndpoints(points, quality, 4, a, b);
+	Bc1Candidate best = encodeBc1Candidate(points, a, b);
+
+	if(quality == S3tcEncoderQuality::kHigh)
+	{
+		for(U32 iteration = 0; iteration < 2 && best.m_error > 0.0f; ++iteration)
+		{
+			Array<F32, 16> factors;
+			for(U32 i = 0; i < 16; ++i)
+			{
+				factors[i] = kBc1Weights[(best.m_indices >> (i * 2)) & 3u];
+			}
+
+			if(!leastSquaresEndpoints(points, factors, a, b))
+			{
+				break;
+			}
+
+			const Bc1Candidate candidate = encodeBc1Candidate(points, a, b);
+			if(candidate.m_error >= best.m_error)
+			{
+				break;
+			}
+			best = candidate;
+		}
+	}
+
+	return best;
+}
+
+static void writeBc1Color(const Bc1Candidate& c, U8* out)
+{
+	out[0] = U8(c.m_color0 & 0xFF);
+	out[1] = U8(c.m_color0 >> 8);
+	out[2] = U8(c.m_color1 & 0xFF);
+	out[3] = U8(c.m_color1 >> 8);
+	memcpy(out + 4, &c.m_indices, sizeof(c.m_indices));
+}
+
+void encodeBc1Block(const Array<U8Vec3, 16>& pixels, S3tcEncoderQuality quality, Array<U8, 8>& out)
+{
+	Array<Vec3, 16> points;
+	for(U32 i = 0; i < 16; ++i)
+	{
+		points[i] = Vec3(pixels[i]);
+	}
+
+	writeBc1Color(encodeBc1Color(points, quality), &out[0]);
+}
+
+void encodeBc3Block(const Array<U8Vec4, 16>& pixels, S3tcEncoderQuality quality, Array<U8, 16>& out)
+{
+	// Alpha block. The 8 values mode is always used since there is no need for explicit 0 and 255
+	U8 alpha0 = 0;
+	U8 alpha1 = 255;
+	Array<Vec3, 16> points;
+	for(U32 i = 0; i < 16; ++i)
+	{
+		alpha0 = max(alpha0, pixels[i].w());
+		alpha1 = min(alpha1, pixels[i].w());
+		points[i] = Vec3(pixels[i].xyz());
+	}
+
+	Array<U32, 8> alphaPalette;
+	alphaPalette[0] = alpha0;
+	alphaPalette[1] = alpha1;
+	for(U32 i = 2; i < 8; ++i)
+	{
+		alphaPalette[i] = ((8 - i) * alpha0 + (i - 1) * alpha1) / 7;
+	}
+
+	BitWriter writer(WeakArray<U8>(&out[0], 8));
+	writer.write(alpha0, 8);
+	writer.write(alpha1, 8);
+	for(U32 i = 0; i < 16; ++i)
+	{
+		U32 bestIdx = 0;
+		U32 bestError = kMaxU32;
+		for(U32 p = 0; p < ((alpha0 == alpha1) ? 1u : 8u); ++p)
+		{
+			const U32 error = absolute(I32(alphaPalette[p]) - I32(pixels[i].w()));
+			if(error < bestError)
+			{
+				bestError = error;
+				bestIdx = p;
+			}
+		}
+
+		writer.write(bestIdx, 3);
+	}
+	ANKI_ASSERT(writer.getBitCount() == 64);
+
+	// Color block
+	writeBc1Color(encodeBc1Color(points, quality), &out[8]);
+}
+
+/// Map the 16bit float representation to a 10bit endpoint. It's the inverse of unquantizeBc6h and finishBc6h combined.
+static U32 quantizeBc6h(F32 halfBits)
+{
+	const F32 unquantized = halfBits * 64.0f / 31.0f;
+	return U32(clamp((unquantized - 32.0f) / 64.0f + 0.5f, 0.0f, 1023.0f));
+}
+
+static U32 unquantizeBc6h(U32 q)
+{
+	if(q == 0)
+	{
+		return 0;
+	}
+	else if(q == 1023)
+	{
+		return 0xFFFF;
+	}
+	else
+	{
+		return ((q << 16) + 0x8000) >> 10;
+	}
+}
+
+static Bc6hCandidate encodeBc6hCandidate(const Array<Vec3, 16>& points, Vec3 a, Vec3 b)
+{
+	Bc6hCandidate c;
+	for(U32 comp = 0; comp < 3; ++comp)
+	{
+		c.m_endpoints[0][comp] = quantizeBc6h(a[comp]);
+		c.m_endpoints[1][comp] = quantizeBc6h(b[comp]);
+	}
+
+	Array<Vec3, 16> palette;
+	for(U32 p = 0; p < 16; ++p)
+	{
+		for(U32 comp = 0; comp < 3; ++comp)
+		{
+			const U32 e0 = unquantizeBc6h(c.m_endpoints[0][comp]);
+			const U32 e1 = unquantizeBc6h(c.m_endpoints[1][comp]);
+			const U32 interpolated = ((64 - kBc6hWeights[p]) * e0 + kBc6hWeights[p] * e1 + 32) >> 6;
+			palette[p][comp] = F32((interpolated * 31) >> 6);
+		}
+	}
+
+	c.m_error = 0.0f;
+	for(U32 i = 0; i < 16; ++i)
+	{
+		U32 bestIdx = 0;
+		F32 bestError = kMaxF32;
+		for(U32 p = 0; p < 16; ++p)
+		{
+			const F32 error = (points[i] - palette[p]).getLengthSquared();
+			if(error < bestError)
+			{
+				bestError = error;
+				bestIdx = p;
+			}
+		}
+
+		c.m_indices[i] = U8(bestIdx);
+		c.m_error += bestError;
+	}
+
+	return c;
+}
+
+void encodeBc6hBlock(const Array<Vec3, 16>& pixels, S3tcEncoderQuality quality, Array<U8, 16>& out)
+{
+	// Work with the bits of the half floats. BC6H interpolates them as integers
+	constexpr F32 kMaxHalf = 65504.0f;
+	Array<Vec3, 16> points;
+	for(U32 i = 0; i < 16; ++i)
+	{
+		for(U32 comp = 0; comp < 3; ++comp)
+		{
+			points[i][comp] = F32(F16(clamp(pixels[i][comp], 0.0f, kMaxHalf)).toU16());
+		}
+	}
+
+	Vec3 a, b;
+	findEndpoints(points, quality, 16, a, b);
+	Bc6hCandidate best = encodeBc6hCandidate(points, a, b);
+
+	if(quality == S3tcEncoderQuality::kHigh)
+	{
+		for(U32 iteration = 0; iteration < 2 && best.m_error > 0.0f; ++iteration)
+		{
+			Array<F32, 16> factors;
+			for(U32 i = 0; i < 16; ++i)
+			{
+				factors[i] = F32(kBc6hWeights[best.m_indices[i]]) / 64.0f;
+			}
+
+			if(!leastSquaresEndpoints(points, factors, a, b))
+			{
+				break;
+			}
+
+			const Bc6hCandidate candidate = encodeBc6hCandidate(points, a, b);
+			if(candidate.m_error >= best.m_error)
+			{
+				break;
+			}
+			best = candidate;
+		}
+	}
+
+	// The MSB of the first index is implicitly zero. Swap the endpoints if it's not
+	if(best.m_indices[0] & 8u)
+	{
+		std::swap(best.m_endpoints[0], best.m_endpoints[1]);
+		for(U8& idx : best.m_indices)
+		{
+			idx = U8(15u - idx);
+		}
+	}
+
+	BitWriter writer(WeakArray<U8>(&out[0], 16));
+	writer.write(0b00011, 5); // Mode 11
+	for(U32 e = 0; e < 2; ++e)
+	{
+		for(U32 comp = 0; comp < 3; ++comp)
+		{
+			writer.write(best.m_endpoints[e][comp], 10);
+		}
+	}
+
+	writer.write(best.m_indices[0], 3);
+	for(U32 i = 1; i < 16; ++i)
+	{
+		writer.write(best.m_indices[i], 4);
+	}
+	ANKI_ASSERT(writer.getBitCount() == 128);
+}
+
+void compressS3tcSurface(ConstWeakArray<U8, PtrSize> inPixels, U32 width, U32 height, U32 channelCount, Bool hdr, S3tcEncoderQuality quality,
+						 WeakArray<U8, PtrSize> outPixels, ThreadJobManager* jobManager)
+{
+	ANKI_ASSERT(channelCount == 3 || (channelCount == 4 && !hdr));
+	ANKI_ASSERT(inPixels.getSizeInBytes() == PtrSize(width) * height * channelCount * ((hdr) ? sizeof(F32) : sizeof(U8)));
+	ANKI_ASSERT(width > 0 && (width % 4) == 0 && height > 0 && (height % 4) == 0);
+
+	const U32 blockCountX = width / 4;
+	const U32 blockCountY = height / 4;
+	const PtrSize blockSize = (hdr || channelCount == 4) ? 16 : 8;
+	ANKI_ASSERT(outPixels.getSizeInBytes() == blockSize * blockCountX * blockCountY);
+
+	auto encodeRows = [&, quality](U32 firstRow, U32 rowCount) {
+		for(U32 by = firstRow; by < firstRow + rowCount; ++by)
+		{
+			for(U32 bx = 0; bx < blockCountX; ++bx)
+			{
+				U8* out = &outPixels[(PtrSize(by) * blockCountX + bx) * blockSize];
+
+				if(hdr)
+				{
+					Array<Vec3, 16> block;
+					for(U32 i = 0; i < 16; ++i)
+					{
+						const PtrSize pixelIdx = PtrSize(by * 4 + i / 4) * width + bx * 4 + i % 4;
+						memcpy(&block[i], &inPixels[pixelIdx * sizeof(Vec3)], sizeof(Vec3));
+					}
+
+					Array<U8, 16> encoded;
+					encodeBc6hBlock(block, quality, encoded);
+					memcpy(out, &encoded[0], sizeof(encoded));
+				}
+				else if(channelCount == 4)
+				{
+					Array<U8Vec4, 16> block;
+					for(U32 i = 0; i < 16; ++i)
+					{
+						const PtrSize pixelIdx = PtrSize(by * 4 + i / 4) * width + bx * 4 + i % 4;
+						memcpy(&block[i], &inPixels[pixelIdx * 4], 4);
+					}
+
+					Array<U8, 16> encoded;
+					encodeBc3Block(block, quality, encoded);
+					memcpy(out, &encoded[0], sizeof(encoded));
+				}
+				else
+				{
+					Array<U8Vec3, 16> block;
+					for(U32 i = 0; i < 16; ++i)
+					{
+						const PtrSize pixelIdx = PtrSize(by * 4 + i / 4) * width + bx * 4 + i % 4;
+						memcpy(&block[i], &inPixels[pixelIdx * 3], 3);
+					}
+
+					Array<U8, 8> encoded;
+					encodeBc1Block(block, quality, encoded);
+					memcpy(out, &encoded[0], sizeof(encoded));
+				}
+			}
+		}
+	};
+
+	if(!jobManager || blockCountY == 1)
+	{
+		encodeRows(0, blockCountY);
+		return;
+	}
+
+	// A few tasks per thread to balance the load
+	const U32 taskCount = min(blockCountY, jobManager->getThreadCount() * 4);
+	const U32 rowsPerTask = (blockCountY + taskCount - 1) / taskCount;
+	for(U32 firstRow = 0; firstRow < blockCountY; firstRow += rowsPerTask)
+	{
+		const U32 rowCount = min(rowsPerTask, blockCountY - firstRow);
+		jobManager->dispatchTask([&encodeRows, firstRow, rowCount]([[maybe_unused]] U32 threadId) {
+			encodeRows(firstRow, rowCount);
+		});
+	}
+
+	jobManager->waitForAllTasksToFinish();
+}
+
+} // end namespace anki
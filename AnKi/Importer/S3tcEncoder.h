@@ -0,0 +1,46 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Importer/Common.h>
+#include <AnKi/Util/WeakArray.h>
+#include <AnKi/Math.h>
+
+namespace anki {
+
+// Forward
+class ThreadJobManager;
+
+/// @addtogroup importer
+/// @{
+
+/// Quality presets of the S3TC encoder. Higher quality is slower.
+enum class S3tcEncoderQuality : U8
+{
+	kFast, ///< Endpoints from the bounding box of the block.
+	kNormal, ///< Endpoints from the principal axis of the block.
+	kHigh, ///< Same as kNormal plus least squares refinement of the endpoints.
+
+	kCount
+};
+
+/// Encode a 4x4 block of pixels in BC1.
+void encodeBc1Block(const Array<U8Vec3, 16>& pixels, S3tcEncoderQuality quality, Array<U8, 8>& out);
+
+/// Encode a 4x4 block of pixels in BC3.
+void encodeBc3Block(const Array<U8Vec4, 16>& pixels, S3tcEncoderQuality quality, Array<U8, 16>& out);
+
+/// Encode a 4x4 block of pixels in BC6H unsigned. Only mode 11 (a single region with 10bit endpoints) is used. Negative values are clamped to
+/// zero.
+void encodeBc6hBlock(const Array<Vec3, 16>& pixels, S3tcEncoderQuality quality, Array<U8, 16>& out);
+
+/// Compress a surface in the S3TC flavor that ImageResource expects: BC1 for 3 channels, BC3 for 4 channels and BC6H for HDR (3 channels).
+/// @param jobManager Optional. If it's not nullptr the rows of blocks are compressed in parallel.
+void compressS3tcSurface(ConstWeakArray<U8, PtrSize> inPixels, U32 width, U32 height, U32 channelCount, Bool hdr, S3tcEncoderQuality quality,
+						 WeakArray<U8, PtrSize> outPixels, ThreadJobManager* jobManager = nullptr);
+/// @}
+
+} // end namespace anki
@@ -264,9 +264,8 @@ public:
 	}
 
 	/// @note 16 muls, 12 adds
-	TQuat combineRotations(const TQuat& b) const
+	TQuat combineRotations(const TQuat& b) const requires(!Base::kVec4Simd)
 	{
-		// XXX See if this can be optimized
 		TQuat out;
 		out.x() = x() * b.w() + y() * b.z() - z() * b.y() + w() * b.x();
 		out.y() = -x() * b.z() + y() * b.w() + z() * b.x() + w() * b.y();
@@ -275,14 +274,67 @@ public:
 		return out;
 	}
 
+#if ANKI_ENABLE_SIMD
+	/// @note The same as the scalar version but each row of the scalar version is a column here:
+	///       out = w * b + x * (bw, -bz, by, -bx) + y * (bz, bw, -bx, -by) + z * (-by, bx, bw, -bz)
+	TQuat combineRotations(const TQuat& b) const requires(Base::kVec4Simd)
+	{
+		const typename Base::Simd& a = Base::getSimd();
+		const typename Base::Simd& bs = b.getSimd();
+#	if ANKI_SIMD_SSE
+		const __m128 ax = _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0));
+		const __m128 ay = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1));
+		const __m128 az = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2));
+		const __m128 aw = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3));
+
+		// Flip the signs by xor-ing the sign bit
+		const __m128 b0 = _mm_xor_ps(_mm_shuffle_ps(bs, bs, _MM_SHUFFLE(0, 1, 2, 3)), _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f));
+		const __m128 b1 = _mm_xor_ps(_mm_shuffle_ps(bs, bs, _MM_SHUFFLE(1, 0, 3, 2)), _mm_set_ps(-0.0f, -0.0f, 0.0f, 0.0f));
+		const __m128 b2 = _mm_xor_ps(_mm_shuffle_ps(bs, bs, _MM_SHUFFLE(2, 3, 0, 1)), _mm_set_ps(-0.0f, 0.0f, 0.0f, -0.0f));
+
+		__m128 out = _mm_mul_ps(aw, bs);
+		out = _mm_add_ps(out, _mm_mul_ps(ax, b0));
+		out = _mm_add_ps(out, _mm_mul_ps(ay, b1));
+		out = _mm_add_ps(out, _mm_mul_ps(az, b2));
+		return TQuat(out);
+#	else
+		const float32x4_t b0 = __builtin_shufflevector(bs, bs, 3, 2, 1, 0) * float32x4_t{1.0f, -1.0f, 1.0f, -1.0f};
+		const float32x4_t b1 = __builtin_shufflevector(bs, bs, 2, 3, 0, 1) * float32x4_t{1.0f, 1.0f, -1.0f, -1.0f};
+		const float32x4_t b2 = __builtin_shufflevector(bs, bs, 1, 0, 3, 2) * float32x4_t{-1.0f, 1.0f, 1.0f, -1.0f};
+
+		float32x4_t out = vmulq_laneq_f32(bs, a, 3);
+		out = vfmaq_laneq_f32(out, b0, a, 0);
+		out = vfmaq_laneq_f32(out, b1, a, 1);
+		out = vfmaq_laneq_f32(out, b2, a, 2);
+		return TQuat(out);
+#	endif
+	}
+#endif
+
 	/// Returns q * this * q.Conjucated() aka returns a rotated this. 18 muls, 12 adds
-	TVec<T, 3> rotate(const TVec<T, 3>& v) const
+	TVec<T, 3> rotate(const TVec<T, 3>& v) const requires(!Base::kVec4Simd)
 	{
 		ANKI_ASSERT(isZero<T>(1.0 - Base::getLength())); // Not normalized quat
 		TVec<T, 3> qXyz(Base::xyz());
 		return v + qXyz.cross(qXyz.cross(v) + v * Base::w()) * 2.0;
 	}
 
+	/// @copydoc rotate
+	TVec<T, 3> rotate(const TVec<T, 3>& v) const requires(Base::kVec4Simd)
+	{
+		return rotate(v.xyz0()).xyz();
+	}
+
+	/// @copydoc rotate
+	TVec<T, 4> rotate(const TVec<T, 4>& v) const
+	{
+		ANKI_ASSERT(isZero<T>(1.0 - Base::getLength())); // Not normalized quat
+		ANKI_ASSERT(v.w() == T(0));
+		TVec<T, 4> qXyz = *this;
+		qXyz.w() = T(0);
+		return v + qXyz.cross(qXyz.cross(v) + v * Base::w()) * T(2);
+	}
+
 	void setIdentity()
 	{
 		*this = getIdentity();
@@ -46,4 +46,282 @@ public:
 };
 #endif
 
+/// 4 independent floats for structure-of-arrays kernels that process 4 objects at a time. Unlike Vec4 the lanes have no meaning. The
+/// comparison operators return masks where all the bits of a lane are set or clear.
+class F32x4
+{
+public:
+	static constexpr U32 kLaneCount = 4;
+
+	F32x4() = default;
+
+	explicit F32x4(F32 f)
+	{
+#if ANKI_SIMD_SSE
+		m_simd = _mm_set1_ps(f);
+#elif ANKI_SIMD_NEON
+		m_simd = vdupq_n_f32(f);
+#else
+		for(F32& x : m_simd)
+		{
+			x = f;
+		}
+#endif
+	}
+
+	/// Load from memory that doesn't need to be aligned.
+	static F32x4 load(const F32* p)
+	{
+		F32x4 out;
+#if ANKI_SIMD_SSE
+		out.m_simd = _mm_loadu_ps(p);
+#elif ANKI_SIMD_NEON
+		out.m_simd = vld1q_f32(p);
+#else
+		for(U32 i = 0; i < kLaneCount; ++i)
+		{
+			out.m_simd[i] = p[i];
+		}
+#endif
+		return out;
+	}
+
+	/// Store to memory that doesn't need to be aligned.
+	void store(F32* p) const
+	{
+#if ANKI_SIMD_SSE
+		_mm_storeu_ps(p, m_simd);
+#elif ANKI_SIMD_NEON
+		vst1q_f32(p, m_simd);
+#else
+		for(U32 i = 0; i < kLaneCount; ++i)
+		{
+			p[i] = m_simd[i];
+		}
+#endif
+	}
+
+	F32x4 operator+(F32x4 b) const
+	{
+		F32x4 out;
+#if ANKI_SIMD_SSE
+		out.m_simd = _mm_add_ps(m_simd, b.m_simd);
+#elif ANKI_SIMD_NEON
+		out.m_simd = vaddq_f32(m_simd, b.m_simd);
+#else
+		for(U32 i = 0; i < kLaneCount; ++i)
+		{
+			out.m_simd[i] = m_simd[i] + b.m_simd[i];
+		}
+#endif
+		return out;
+	}
+
+	F32x4 operator-(F32x4 b) const
+	{
+		F32x4 out;
+#if ANKI_SIMD_SSE
+		out.m_simd = _mm_sub_ps(m_simd, b.m_simd);
+#elif ANKI_SIMD_NEON
+		out.m_simd = vsubq_f32(m_simd, b.m_simd);
+#else
+		for(U32 i = 0; i < kLaneCount; ++i)
+		{
+			out.m_simd[i] = m_simd[i] - b.m_simd[i];
+		}
+#endif
+		return out;
+	}
+
+	F32x4 operator*(F32x4 b) const
+	{
+		F32x4 out;
+#if ANKI_SIMD_SSE
+		out.m_simd = _mm_mul_ps(m_simd, b.m_simd);
+#elif ANKI_SIMD_NEON
+		out.m_simd = vmulq_f32(m_simd, b.m_simd);
+#else
+		for(U32 i = 0; i < kLaneCount; ++i)
+		{
+			out.m_simd[i] = m_simd[i] * b.m_simd[i];
+		}
+#endif
+		return out;
+	}
+
+	F32x4 min(F32x4 b) const
+	{
+		F32x4 out;
+#if ANKI_SIMD_SSE
+		out.m_simd = _mm_min_ps(m_simd, b.m_simd);
+#elif ANKI_SIMD_NEON
+		out.m_simd = vminq_f32(m_simd, b.m_simd);
+#else
+		for(U32 i = 0; i < kLaneCount; ++i)
+		{
+			out.m_simd[i] = (m_simd[i] < b.m_simd[i]) ? m_simd[i] : b.m_simd[i];
+		}
+#endif
+		return out;
+	}
+
+	F32x4 max(F32x4 b) const
+	{
+		F32x4 out;
+#if ANKI_SIMD_SSE
+		out.m_simd = _mm_max_ps(m_simd, b.m_simd);
+#elif ANKI_SIMD_NEON
+		out.m_simd = vmaxq_f32(m_simd, b.m_simd);
+#else
+		for(U32 i = 0; i < kLaneCount; ++i)
+		{
+			out.m_simd[i] = (m_simd[i] > b.m_simd[i]) ? m_simd[i] : b.m_simd[i];
+		}
+#endif
+		return out;
+	}
+
+	F32x4 abs() const
+	{
+		return max(F32x4(0.0f) - *this);
+	}
+
+	F32x4 sqrt() const
+	{
+		F32x4 out;
+#if ANKI_SIMD_SSE
+		out.m_simd = _mm_sqrt_ps(m_simd);
+#elif ANKI_SIMD_NEON
+		out.m_simd = vsqrtq_f32(m_simd);
+#else
+		for(U32 i = 0; i < kLaneCount; ++i)
+		{
+			out.m_simd[i] = __builtin_sqrtf(m_simd[i]);
+		}
+#endif
+		return out;
+	}
+
+	F32x4 operator>=(F32x4 b) const
+	{
+		F32x4 out;
+#if ANKI_SIMD_SSE
+		out.m_simd = _mm_cmpge_ps(m_simd, b.m_simd);
+#elif ANKI_SIMD_NEON
+		out.m_simd = vreinterpretq_f32_u32(vcgeq_f32(m_simd, b.m_simd));
+#else
+		for(U32 i = 0; i < kLaneCount; ++i)
+		{
+			out.m_simd[i] = maskLane(m_simd[i] >= b.m_simd[i]);
+		}
+#endif
+		return out;
+	}
+
+	F32x4 operator>(F32x4 b) const
+	{
+		F32x4 out;
+#if ANKI_SIMD_SSE
+		out.m_simd = _mm_cmpgt_ps(m_simd, b.m_simd);
+#elif ANKI_SIMD_NEON
+		out.m_simd = vreinterpretq_f32_u32(vcgtq_f32(m_simd, b.m_simd));
+#else
+		for(U32 i = 0; i < kLaneCount; ++i)
+		{
+			out.m_simd[i] = maskLane(m_simd[i] > b.m_simd[i]);
+		}
+#endif
+		return out;
+	}
+
+	F32x4 operator<=(F32x4 b) const
+	{
+		return b >= *this;
+	}
+
+	F32x4 operator<(F32x4 b) const
+	{
+		return b > *this;
+	}
+
+	/// Bitwise and. Used to combine masks or to clear the lanes that are not in a mask.
+	F32x4 operator&(F32x4 b) const
+	{
+		F32x4 out;
+#if ANKI_SIMD_SSE
+		out.m_simd = _mm_and_ps(m_simd, b.m_simd);
+#elif ANKI_SIMD_NEON
+		out.m_simd = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(m_simd), vreinterpretq_u32_f32(b.m_simd)));
+#else
+		for(U32 i = 0; i < kLaneCount; ++i)
+		{
+			out.m_simd[i] = __builtin_bit_cast(F32, __builtin_bit_cast(U32, m_simd[i]) & __builtin_bit_cast(U32, b.m_simd[i]));
+		}
+#endif
+		return out;
+	}
+
+	/// Bitwise or.
+	F32x4 operator|(F32x4 b) const
+	{
+		F32x4 out;
+#if ANKI_SIMD_SSE
+		out.m_simd = _mm_or_ps(m_simd, b.m_simd);
+#elif ANKI_SIMD_NEON
+		out.m_simd = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(m_simd), vreinterpretq_u32_f32(b.m_simd)));
+#else
+		for(U32 i = 0; i < kLaneCount; ++i)
+		{
+			out.m_simd[i] = __builtin_bit_cast(F32, __builtin_bit_cast(U32, m_simd[i]) | __builtin_bit_cast(U32, b.m_simd[i]));
+		}
+#endif
+		return out;
+	}
+
+	/// Pick the lanes of a where the mask is set and the lanes of b elsewhere.
+	static F32x4 select(F32x4 mask, F32x4 a, F32x4 b)
+	{
+		F32x4 out;
+#if ANKI_SIMD_SSE
+		out.m_simd = _mm_blendv_ps(b.m_simd, a.m_simd, mask.m_simd);
+#elif ANKI_SIMD_NEON
+		out.m_simd = vbslq_f32(vreinterpretq_u32_f32(mask.m_simd), a.m_simd, b.m_simd);
+#else
+		for(U32 i = 0; i < kLaneCount; ++i)
+		{
+			out.m_simd[i] = (__builtin_bit_cast(U32, mask.m_simd[i])) ? a.m_simd[i] : b.m_simd[i];
+		}
+#endif
+		return out;
+	}
+
+	/// Get one bit per lane of a mask.
+	U32 getMask() const
+	{
+#if ANKI_SIMD_SSE
+		return U32(_mm_movemask_ps(m_simd));
+#elif ANKI_SIMD_NEON
+		const uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(m_simd), 31);
+		return vgetq_lane_u32(bits, 0) | (vgetq_lane_u32(bits, 1) << 1) | (vgetq_lane_u32(bits, 2) << 2) | (vgetq_lane_u32(bits, 3) << 3);
+#else
+		U32 out = 0;
+		for(U32 i = 0; i < kLaneCount; ++i)
+		{
+			out |= (__builtin_bit_cast(U32, m_simd[i]) >> 31u) << i;
+		}
+		return out;
+#endif
+	}
+
+private:
+	MathSimd<F32, 4>::Type m_simd;
+
+#if ANKI_SIMD_NONE
+	static F32 maskLane(Bool b)
+	{
+		return __builtin_bit_cast(F32, (b) ? 0xFFFFFFFFu : 0u);
+	}
+#endif
+};
+
 } // end namespace anki
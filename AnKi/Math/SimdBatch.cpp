@@ -0,0 +1,138 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Math/SimdBatch.h>
+
+namespace anki {
+
+// Implemented in SimdBatchAvx2.cpp
+#if ANKI_SIMD_SSE
+void transformPointsAvx2(ConstWeakArray<Mat3x4x8> transforms, ConstWeakArray<Vec3x8> points, WeakArray<Vec3x8> out);
+void combineTransformationsAvx2(ConstWeakArray<Mat3x4x8> a, ConstWeakArray<Mat3x4x8> b, WeakArray<Mat3x4x8> out);
+#endif
+
+static SimdBatchLevel g_forcedSimdBatchLevel = SimdBatchLevel::kCount;
+
+static SimdBatchLevel detectCpuSimdBatchLevel()
+{
+#if ANKI_SIMD_SSE && ANKI_COMPILER_GCC_COMPATIBLE
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+	{
+		return SimdBatchLevel::kAvx2;
+	}
+#elif ANKI_SIMD_SSE && ANKI_COMPILER_MSVC
+	int info[4];
+	__cpuid(info, 1);
+	const Bool fma = (info[2] & (1 << 12)) != 0;
+	const Bool osxsave = (info[2] & (1 << 27)) != 0;
+	__cpuidex(info, 7, 0);
+	const Bool avx2 = (info[1] & (1 << 5)) != 0;
+
+	// The OS also needs to save the YMM registers
+	if(fma && osxsave && avx2 && (_xgetbv(0) & 6) == 6)
+	{
+		return SimdBatchLevel::kAvx2;
+	}
+#endif
+
+	return SimdBatchLevel::kGeneric;
+}
+
+SimdBatchLevel getCpuSimdBatchLevel()
+{
+	static const SimdBatchLevel level = detectCpuSimdBatchLevel();
+	return level;
+}
+
+void setSimdBatchLevel(SimdBatchLevel level)
+{
+	ANKI_ASSERT(level < SimdBatchLevel::kCount);
+	g_forcedSimdBatchLevel = min(level, getCpuSimdBatchLevel());
+}
+
+SimdBatchLevel getSimdBatchLevel()
+{
+	return (g_forcedSimdBatchLevel != SimdBatchLevel::kCount) ? g_forcedSimdBatchLevel : getCpuSimdBatchLevel();
+}
+
+void transformPoints(ConstWeakArray<Mat3x4x8> transforms, ConstWeakArray<Vec3x8> points, WeakArray<Vec3x8> out)
+{
+	ANKI_ASSERT(transforms.getSize() == points.getSize() && out.getSize() == points.getSize());
+
+#if ANKI_SIMD_SSE
+	if(getSimdBatchLevel() == SimdBatchLevel::kAvx2)
+	{
+		transformPointsAvx2(transforms, points, out);
+		return;
+	}
+#endif
+
+	for(U32 i = 0; i < points.getSize(); ++i)
+	{
+		const Mat3x4x8& m = transforms[i];
+		const Vec3x8& p = points[i];
+		Vec3x8& o = out[i];
+
+		// Do the 8 lanes in 2 halves
+		for(U32 half = 0; half < Vec3x8::kLaneCount; half += F32x4::kLaneCount)
+		{
+			const F32x4 x = F32x4::load(&p.m_x[half]);
+			const F32x4 y = F32x4::load(&p.m_y[half]);
+			const F32x4 z = F32x4::load(&p.m_z[half]);
+
+			Array<F32*, 3> outRows = {&o.m_x[half], &o.m_y[half], &o.m_z[half]};
+			for(U32 r = 0; r < 3; ++r)
+			{
+				const F32x4 result = F32x4::load(&m.m_elements[r * 4 + 0][half]) * x + F32x4::load(&m.m_elements[r * 4 + 1][half]) * y
+									 + F32x4::load(&m.m_elements[r * 4 + 2][half]) * z + F32x4::load(&m.m_elements[r * 4 + 3][half]);
+				result.store(outRows[r]);
+			}
+		}
+	}
+}
+
+void combineTransformations(ConstWeakArray<Mat3x4x8> a, ConstWeakArray<Mat3x4x8> b, WeakArray<Mat3x4x8> out)
+{
+	ANKI_ASSERT(a.getSize() == b.getSize() && out.getSize() == a.getSize());
+
+#if ANKI_SIMD_SSE
+	if(getSimdBatchLevel() == SimdBatchLevel::kAvx2)
+	{
+		combineTransformationsAvx2(a, b, out);
+		return;
+	}
+#endif
+
+	for(U32 i = 0; i < a.getSize(); ++i)
+	{
+		for(U32 half = 0; half < Mat3x4x8::kLaneCount; half += F32x4::kLaneCount)
+		{
+			Array<F32x4, 12> ma;
+			Array<F32x4, 12> mb;
+			for(U32 e = 0; e < 12; ++e)
+			{
+				ma[e] = F32x4::load(&a[i].m_elements[e][half]);
+				mb[e] = F32x4::load(&b[i].m_elements[e][half]);
+			}
+
+			for(U32 r = 0; r < 3; ++r)
+			{
+				for(U32 c = 0; c < 4; ++c)
+				{
+					F32x4 result = ma[r * 4 + 0] * mb[0 * 4 + c] + ma[r * 4 + 1] * mb[1 * 4 + c] + ma[r * 4 + 2] * mb[2 * 4 + c];
+					if(c == 3)
+					{
+						result = result + ma[r * 4 + 3];
+					}
+
+					result.store(&out[i].m_elements[r * 4 + c][half]);
+				}
+			}
+		}
+	}
+}
+
+} // end namespace anki
@@ -0,0 +1,94 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Math/Common.h>
+#include <AnKi/Math/Vec.h>
+#include <AnKi/Math/Mat.h>
+#include <AnKi/Util/Array.h>
+#include <AnKi/Util/WeakArray.h>
+
+namespace anki {
+
+/// @addtogroup math
+/// @{
+
+/// The instruction sets the batch kernels can use.
+enum class SimdBatchLevel : U8
+{
+	kGeneric, ///< Uses F32x4 so it's SSE4, NEON or scalar depending on the build.
+	kAvx2,
+
+	kCount
+};
+
+/// 8 Vec3 stored as structure of arrays. The unit of work of the batch kernels.
+class alignas(32) Vec3x8
+{
+public:
+	static constexpr U32 kLaneCount = 8;
+
+	Array<F32, kLaneCount> m_x;
+	Array<F32, kLaneCount> m_y;
+	Array<F32, kLaneCount> m_z;
+
+	Vec3 get(U32 lane) const
+	{
+		return Vec3(m_x[lane], m_y[lane], m_z[lane]);
+	}
+
+	void set(U32 lane, const Vec3& v)
+	{
+		m_x[lane] = v.x();
+		m_y[lane] = v.y();
+		m_z[lane] = v.z();
+	}
+};
+
+/// 8 Mat3x4 stored as structure of arrays. See Vec3x8.
+class alignas(32) Mat3x4x8
+{
+public:
+	static constexpr U32 kLaneCount = 8;
+
+	Array<Array<F32, kLaneCount>, 12> m_elements; ///< The elements of the matrices in row major order.
+
+	Mat3x4 get(U32 lane) const
+	{
+		Mat3x4 m;
+		for(U32 i = 0; i < 12; ++i)
+		{
+			m(i / 4, i % 4) = m_elements[i][lane];
+		}
+		return m;
+	}
+
+	void set(U32 lane, const Mat3x4& m)
+	{
+		for(U32 i = 0; i < 12; ++i)
+		{
+			m_elements[i][lane] = m(i / 4, i % 4);
+		}
+	}
+};
+
+/// The best level the CPU supports. It's detected once.
+SimdBatchLevel getCpuSimdBatchLevel();
+
+/// Force the batch kernels to use a level. Useful for testing and benchmarking. If the CPU doesn't support it the best level is used.
+void setSimdBatchLevel(SimdBatchLevel level);
+
+/// The level the batch kernels use.
+SimdBatchLevel getSimdBatchLevel();
+
+/// out[i] = transforms[i] * points[i]. Same as Mat3x4 * Vec4(point, 1).
+void transformPoints(ConstWeakArray<Mat3x4x8> transforms, ConstWeakArray<Vec3x8> points, WeakArray<Vec3x8> out);
+
+/// out[i] = a[i].combineTransformations(b[i]).
+void combineTransformations(ConstWeakArray<Mat3x4x8> a, ConstWeakArray<Mat3x4x8> b, WeakArray<Mat3x4x8> out);
+/// @}
+
+} // end namespace anki
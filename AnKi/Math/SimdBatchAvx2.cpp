@@ -0,0 +1,78 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+// The AVX2 variants of the batch kernels. The rest of the engine is built for SSE4 so the functions here enable AVX2 one by one and they are
+// only called if the CPU supports it (see getCpuSimdBatchLevel).
+
+#include <AnKi/Math/SimdBatch.h>
+
+#if ANKI_SIMD_SSE
+
+#	include <immintrin.h>
+
+#	if ANKI_COMPILER_GCC_COMPATIBLE
+#		define ANKI_AVX2_FUNC __attribute__((target("avx2,fma")))
+#	else
+#		define ANKI_AVX2_FUNC
+#	endif
+
+namespace anki {
+
+ANKI_AVX2_FUNC void transformPointsAvx2(ConstWeakArray<Mat3x4x8> transforms, ConstWeakArray<Vec3x8> points, WeakArray<Vec3x8> out)
+{
+	for(U32 i = 0; i < points.getSize(); ++i)
+	{
+		const Mat3x4x8& m = transforms[i];
+		const Vec3x8& p = points[i];
+
+		const __m256 x = _mm256_load_ps(p.m_x.getBegin());
+		const __m256 y = _mm256_load_ps(p.m_y.getBegin());
+		const __m256 z = _mm256_load_ps(p.m_z.getBegin());
+
+		Array<F32*, 3> outRows = {out[i].m_x.getBegin(), out[i].m_y.getBegin(), out[i].m_z.getBegin()};
+		for(U32 r = 0; r < 3; ++r)
+		{
+			__m256 result = _mm256_load_ps(m.m_elements[r * 4 + 3].getBegin());
+			result = _mm256_fmadd_ps(_mm256_load_ps(m.m_elements[r * 4 + 0].getBegin()), x, result);
+			result = _mm256_fmadd_ps(_mm256_load_ps(m.m_elements[r * 4 + 1].getBegin()), y, result);
+			result = _mm256_fmadd_ps(_mm256_load_ps(m.m_elements[r * 4 + 2].getBegin()), z, result);
+			_mm256_store_ps(outRows[r], result);
+		}
+	}
+}
+
+ANKI_AVX2_FUNC void combineTransformationsAvx2(ConstWeakArray<Mat3x4x8> a, ConstWeakArray<Mat3x4x8> b, WeakArray<Mat3x4x8> out)
+{
+	for(U32 i = 0; i < a.getSize(); ++i)
+	{
+		Array<__m256, 12> mb;
+		for(U32 e = 0; e < 12; ++e)
+		{
+			mb[e] = _mm256_load_ps(b[i].m_elements[e].getBegin());
+		}
+
+		for(U32 r = 0; r < 3; ++r)
+		{
+			const __m256 a0 = _mm256_load_ps(a[i].m_elements[r * 4 + 0].getBegin());
+			const __m256 a1 = _mm256_load_ps(a[i].m_elements[r * 4 + 1].getBegin());
+			const __m256 a2 = _mm256_load_ps(a[i].m_elements[r * 4 + 2].getBegin());
+
+			for(U32 c = 0; c < 4; ++c)
+			{
+				__m256 result = (c == 3) ? _mm256_load_ps(a[i].m_elements[r * 4 + 3].getBegin()) : _mm256_setzero_ps();
+				result = _mm256_fmadd_ps(a0, mb[0 * 4 + c], result);
+				result = _mm256_fmadd_ps(a1, mb[1 * 4 + c], result);
+				result = _mm256_fmadd_ps(a2, mb[2 * 4 + c], result);
+				_mm256_store_ps(out[i].m_elements[r * 4 + c].getBegin(), result);
+			}
+		}
+	}
+}
+
+} // end namespace anki
+
+#	undef ANKI_AVX2_FUNC
+
+#endif
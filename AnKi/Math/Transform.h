@@ -183,12 +183,19 @@ public:
 	}
 
 	/// Transform a TVec3
-	[[nodiscard]] TVec<T, 3> transform(const TVec<T, 3>& b) const
+	[[nodiscard]] TVec<T, 3> transform(const TVec<T, 3>& b) const requires(!TMat<T, 3, 4>::kHasSimd)
 	{
 		check();
 		return (m_rotation.getRotationPart() * (b * m_scale.xyz())) + m_origin.xyz();
 	}
 
+	/// Transform a TVec3. SIMD optimized
+	[[nodiscard]] TVec<T, 3> transform(const TVec<T, 3>& b) const requires(TMat<T, 3, 4>::kHasSimd)
+	{
+		check();
+		return (m_rotation * (b.xyz0() * m_scale)) + m_origin.xyz();
+	}
+
 	/// Transform a TVec4. SIMD optimized
 	[[nodiscard]] TVec<T, 4> transform(const TVec<T, 4>& b) const
 	{
@@ -9,7 +9,12 @@
 #include <AnKi/Physics/PhysicsTrigger.h>
 #include <AnKi/Physics/PhysicsPlayerController.h>
 #include <AnKi/Util/Rtti.h>
+#include <AnKi/Util/ThreadJobManager.h>
 #include <BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h>
+#include <BulletCollision/NarrowPhaseCollision/btPointCollector.h>
+#include <BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h>
 
 namespace anki {
 
@@ -134,6 +139,112 @@ public:
 	}
 };
 
+/// Per-thread state of the scene queries.
+class PhysicsWorld::SceneQueryContext
+{
+public:
+	btAlignedObjectArray<const btDbvtNode*> m_stack; ///< Broadphase traversal stack. Bullet's broadphase has a single one.
+	btAlignedObjectArray<PhysicsFilteredObject*> m_overlaps;
+	PhysicsSceneQueryBatch* m_batch = nullptr;
+	Atomic<U32>* m_overlapCount = nullptr;
+};
+
+/// Gathers the broadphase leaves that pass the material mask and calls a functor for each.
+template<typename TFunc>
+class SceneQueryBroadphaseCallback : public btDbvt::ICollide
+{
+public:
+	PhysicsMaterialBit m_materialMask;
+	TFunc m_func;
+
+	SceneQueryBroadphaseCallback(PhysicsMaterialBit materialMask, TFunc func)
+		: m_materialMask(materialMask)
+		, m_func(func)
+	{
+	}
+
+	void Process(const btDbvtNode* leaf) override
+	{
+		const btBroadphaseProxy* proxy = static_cast<const btBroadphaseProxy*>(leaf->data);
+		btCollisionObject* cobj = static_cast<btCollisionObject*>(proxy->m_clientObject);
+		ANKI_ASSERT(cobj);
+
+		PhysicsObject* pobj = static_cast<PhysicsObject*>(cobj->getUserPointer());
+		if(pobj == nullptr)
+		{
+			return;
+		}
+
+		PhysicsFilteredObject& fobj = dcast<PhysicsFilteredObject&>(*pobj);
+		if(!!(fobj.getMaterialGroup() & m_materialMask))
+		{
+			m_func(*cobj, fobj);
+		}
+	}
+};
+
+/// Collects the triangles of a concave shape that overlap with a convex one.
+class SceneQueryTriangleOverlapCallback : public btTriangleCallback
+{
+public:
+	const btConvexShape* m_shape = nullptr;
+	btTransform m_shapeTrf; ///< In the space of the concave shape.
+	Bool m_overlaps = false;
+
+	void processTriangle(btVector3* triangle, [[maybe_unused]] int partId, [[maybe_unused]] int triangleIndex) override
+	{
+		if(m_overlaps)
+		{
+			return;
+		}
+
+		btTriangleShape tri(triangle[0], triangle[1], triangle[2]);
+		btTransform identity;
+		identity.setIdentity();
+		m_overlaps = convexOverlap(*m_shape, m_shapeTrf, tri, identity);
+	}
+
+	static Bool convexOverlap(const btConvexShape& a, const btTransform& aTrf, const btConvexShape& b, const btTransform& bTrf)
+	{
+		btVoronoiSimplexSolver simplexSolver;
+		btGjkEpaPenetrationDepthSolver penetrationSolver;
+		btGjkPairDetector gjk(&a, &b, &simplexSolver, &penetrationSolver);
+
+		btGjkPairDetector::ClosestPointInput input;
+		input.m_transformA = aTrf;
+		input.m_transformB = bTrf;
+
+		btPointCollector collector;
+		gjk.getClosestPoints(input, collector, nullptr);
+
+		return collector.m_hasResult && collector.m_distance <= 0.0f;
+	}
+};
+
+/// Closest ray hit. The filtering is done in the broadphase.
+class SceneQueryRayCallback : public btCollisionWorld::ClosestRayResultCallback
+{
+public:
+	using ClosestRayResultCallback::ClosestRayResultCallback;
+
+	Bool needsCollision([[maybe_unused]] btBroadphaseProxy* proxy) const override
+	{
+		return true;
+	}
+};
+
+/// Closest sweep hit. The filtering is done in the broadphase.
+class SceneQuerySweepCallback : public btCollisionWorld::ClosestConvexResultCallback
+{
+public:
+	using ClosestConvexResultCallback::ClosestConvexResultCallback;
+
+	Bool needsCollision([[maybe_unused]] btBroadphaseProxy* proxy) const override
+	{
+		return true;
+	}
+};
+
 PhysicsWorld::PhysicsWorld()
 {
 }
@@ -282,6 +393,271 @@ void PhysicsWorld::rayCast(WeakArray<PhysicsWorldRayCastCallback*> rayCasts) con
 	}
 }
 
+void PhysicsWorld::sceneQueries(PhysicsSceneQueryBatch& batch) const
+{
+	ANKI_ASSERT(batch.m_results.getSize() >= batch.m_queries.getSize());
+	ANKI_ASSERT(batch.m_queriesPerJob > 0);
+
+	const U32 queryCount = batch.m_queries.getSize();
+	Atomic<U32> overlapCount = {0};
+
+	if(batch.m_jobManager == nullptr || queryCount <= batch.m_queriesPerJob)
+	{
+		SceneQueryContext ctx;
+		ctx.m_batch = &batch;
+		ctx.m_overlapCount = &overlapCount;
+
+		for(U32 i = 0; i < queryCount; ++i)
+		{
+			runSceneQuery(batch.m_queries[i], batch.m_results[i], ctx);
+		}
+	}
+	else
+	{
+		// The state the tasks share. It's on the heap because a task may start after sceneQueries() returns, if the job manager is busy. The
+		// last one to finish deletes it
+		class Jobs
+		{
+		public:
+			Atomic<U32> m_nextJob = {0};
+			Atomic<U32> m_doneJobCount = {0};
+			Atomic<U32> m_refCount = {0};
+		};
+
+		const U32 jobCount = (queryCount + batch.m_queriesPerJob - 1) / batch.m_queriesPerJob;
+		const U32 taskCount = min(jobCount, batch.m_jobManager->getThreadCount());
+		Jobs* jobs = anki::newInstance<Jobs>(PhysicsMemoryPool::getSingleton());
+		jobs->m_refCount.setNonAtomically(taskCount + 1);
+
+		auto runJobs = [this, &batch, &overlapCount, queryCount, jobCount](Jobs& jobs) {
+			SceneQueryContext ctx;
+			ctx.m_batch = &batch;
+			ctx.m_overlapCount = &overlapCount;
+
+			U32 job;
+			while((job = jobs.m_nextJob.fetchAdd(1)) < jobCount)
+			{
+				const U32 begin = job * batch.m_queriesPerJob;
+				const U32 end = min(begin + batch.m_queriesPerJob, queryCount);
+				for(U32 q = begin; q < end; ++q)
+				{
+					runSceneQuery(batch.m_queries[q], batch.m_results[q], ctx);
+				}
+
+				jobs.m_doneJobCount.fetchAdd(1);
+			}
+		};
+
+		auto releaseJobs = [](Jobs* jobs) {
+			if(jobs->m_refCount.fetchSub(1) == 1)
+			{
+				anki::deleteInstance(PhysicsMemoryPool::getSingleton(), jobs);
+			}
+		};
+
+		for(U32 i = 0; i < taskCount; ++i)
+		{
+			batch.m_jobManager->dispatchTask([jobs, runJobs, releaseJobs]([[maybe_unused]] U32 tid) {
+				runJobs(*jobs);
+				releaseJobs(jobs);
+			});
+		}
+
+		// Help and then wait only for the jobs of this batch. If this runs in a job of the same manager the tasks might not start at all
+		runJobs(*jobs);
+		while(jobs->m_doneJobCount.load() < jobCount)
+		{
+			std::this_thread::yield();
+		}
+
+		releaseJobs(jobs);
+	}
+
+	batch.m_overlapCount = min(overlapCount.load(), batch.m_overlaps.getSize());
+}
+
+void PhysicsWorld::runSceneQuery(const PhysicsSceneQuery& query, PhysicsSceneQueryResult& result, SceneQueryContext& ctx) const
+{
+	result = {};
+
+	const btDbvt* trees = m_broadphase->m_sets;
+
+	// The query shapes. Construct them on the stack, they are cheap
+	btSphereShape sphere(query.m_extend.x());
+	btBoxShape box(toBt(query.m_extend));
+	btTransform shapeTrf;
+	shapeTrf.setIdentity();
+	shapeTrf.setOrigin(toBt(query.m_from));
+
+	const btConvexShape* shape = nullptr;
+	if(query.m_type == PhysicsSceneQueryType::kSphereSweep || query.m_type == PhysicsSceneQueryType::kSphereOverlap)
+	{
+		shape = &sphere;
+	}
+	else if(query.m_type == PhysicsSceneQueryType::kBoxSweep || query.m_type == PhysicsSceneQueryType::kBoxOverlap)
+	{
+		shape = &box;
+		shapeTrf.setRotation(btQuaternion(query.m_rotation.x(), query.m_rotation.y(), query.m_rotation.z(), query.m_rotation.w()));
+	}
+
+	switch(query.m_type)
+	{
+	case PhysicsSceneQueryType::kRayCast:
+	case PhysicsSceneQueryType::kSphereSweep:
+	case PhysicsSceneQueryType::kBoxSweep:
+	{
+		const btVector3 from = toBt(query.m_from);
+		const btVector3 to = toBt(query.m_to);
+
+		btTransform fromTrf = shapeTrf;
+		btTransform toTrf = shapeTrf;
+		toTrf.setOrigin(to);
+
+		// Compute the ray params the same way Bullet does
+		btVector3 rayDir = to - from;
+		const btScalar lambdaMax = rayDir.length();
+		if(lambdaMax > 0.0f)
+		{
+			rayDir /= lambdaMax;
+		}
+
+		btVector3 rayDirInverse;
+		rayDirInverse[0] = (rayDir[0] == 0.0f) ? btScalar(BT_LARGE_FLOAT) : 1.0f / rayDir[0];
+		rayDirInverse[1] = (rayDir[1] == 0.0f) ? btScalar(BT_LARGE_FLOAT) : 1.0f / rayDir[1];
+		rayDirInverse[2] = (rayDir[2] == 0.0f) ? btScalar(BT_LARGE_FLOAT) : 1.0f / rayDir[2];
+		unsigned int signs[3] = {rayDirInverse[0] < 0.0f, rayDirInverse[1] < 0.0f, rayDirInverse[2] < 0.0f};
+
+		btVector3 aabbMin(0.0f, 0.0f, 0.0f);
+		btVector3 aabbMax(0.0f, 0.0f, 0.0f);
+
+		SceneQueryRayCallback rayCallback(from, to);
+		SceneQuerySweepCallback sweepCallback(from, to);
+		PhysicsFilteredObject* closest = nullptr;
+
+		if(shape == nullptr)
+		{
+			SceneQueryBroadphaseCallback broadphaseCallback(query.m_materialMask, [&](btCollisionObject& cobj, PhysicsFilteredObject& fobj) {
+				const btScalar prevFraction = rayCallback.m_closestHitFraction;
+				btCollisionWorld::rayTestSingle(fromTrf, toTrf, &cobj, cobj.getCollisionShape(), cobj.getWorldTransform(), rayCallback);
+				if(rayCallback.m_closestHitFraction < prevFraction)
+				{
+					closest = &fobj;
+				}
+			});
+
+			for(U32 i = 0; i < 2; ++i)
+			{
+				trees[i].rayTestInternal(trees[i].m_root, from, to, rayDirInverse, signs, lambdaMax, aabbMin, aabbMax, ctx.m_stack,
+										 broadphaseCallback);
+			}
+		}
+		else
+		{
+			// Expand the ray by the AABB of the shape
+			btTransform rotation;
+			rotation.setIdentity();
+			rotation.setRotation(shapeTrf.getRotation());
+			shape->getAabb(rotation, aabbMin, aabbMax);
+
+			SceneQueryBroadphaseCallback broadphaseCallback(query.m_materialMask, [&](btCollisionObject& cobj, PhysicsFilteredObject& fobj) {
+				const btScalar prevFraction = sweepCallback.m_closestHitFraction;
+				btCollisionWorld::objectQuerySingle(shape, fromTrf, toTrf, &cobj, cobj.getCollisionShape(), cobj.getWorldTransform(), sweepCallback,
+													0.0f);
+				if(sweepCallback.m_closestHitFraction < prevFraction)
+				{
+					closest = &fobj;
+				}
+			});
+
+			for(U32 i = 0; i < 2; ++i)
+			{
+				trees[i].rayTestInternal(trees[i].m_root, from, to, rayDirInverse, signs, lambdaMax, aabbMin, aabbMax, ctx.m_stack,
+										 broadphaseCallback);
+			}
+		}
+
+		if(closest)
+		{
+			result.m_object = closest;
+			if(shape == nullptr)
+			{
+				result.m_worldPosition = toAnki(rayCallback.m_hitPointWorld);
+				result.m_worldNormal = toAnki(rayCallback.m_hitNormalWorld);
+				result.m_hitFraction = rayCallback.m_closestHitFraction;
+			}
+			else
+			{
+				result.m_worldPosition = toAnki(sweepCallback.m_hitPointWorld);
+				result.m_worldNormal = toAnki(sweepCallback.m_hitNormalWorld);
+				result.m_hitFraction = sweepCallback.m_closestHitFraction;
+			}
+		}
+		break;
+	}
+	case PhysicsSceneQueryType::kSphereOverlap:
+	case PhysicsSceneQueryType::kBoxOverlap:
+	{
+		ctx.m_overlaps.resizeNoInitialize(0);
+
+		SceneQueryBroadphaseCallback broadphaseCallback(query.m_materialMask, [&](btCollisionObject& cobj, PhysicsFilteredObject& fobj) {
+			const btCollisionShape* otherShape = cobj.getCollisionShape();
+			Bool overlaps = false;
+
+			if(otherShape->isConvex())
+			{
+				overlaps = SceneQueryTriangleOverlapCallback::convexOverlap(*shape, shapeTrf, static_cast<const btConvexShape&>(*otherShape),
+																			cobj.getWorldTransform());
+			}
+			else if(otherShape->isConcave())
+			{
+				SceneQueryTriangleOverlapCallback triangleCallback;
+				triangleCallback.m_shape = shape;
+				triangleCallback.m_shapeTrf = cobj.getWorldTransform().inverse() * shapeTrf;
+
+				btVector3 localAabbMin, localAabbMax;
+				shape->getAabb(triangleCallback.m_shapeTrf, localAabbMin, localAabbMax);
+
+				static_cast<const btConcaveShape*>(otherShape)->processAllTriangles(&triangleCallback, localAabbMin, localAabbMax);
+				overlaps = triangleCallback.m_overlaps;
+			}
+
+			if(overlaps)
+			{
+				ctx.m_overlaps.push_back(&fobj);
+			}
+		});
+
+		btVector3 aabbMin, aabbMax;
+		shape->getAabb(shapeTrf, aabbMin, aabbMax);
+		const btDbvtVolume volume = btDbvtVolume::FromMM(aabbMin, aabbMax);
+
+		for(U32 i = 0; i < 2; ++i)
+		{
+			trees[i].collideTV(trees[i].m_root, volume, broadphaseCallback);
+		}
+
+		if(ctx.m_overlaps.size())
+		{
+			result.m_object = ctx.m_overlaps[0];
+
+			// Allocate space in the flat array and copy the objects
+			const U32 overlapCount = U32(ctx.m_overlaps.size());
+			const U32 offset = ctx.m_overlapCount->fetchAdd(overlapCount);
+			WeakArray<PhysicsFilteredObject*>& overlaps = ctx.m_batch->m_overlaps;
+			if(offset < overlaps.getSize())
+			{
+				result.m_overlapsOffset = offset;
+				result.m_overlapCount = min(overlapCount, overlaps.getSize() - offset);
+				memcpy(&overlaps[offset], &ctx.m_overlaps[0], result.m_overlapCount * sizeof(ctx.m_overlaps[0]));
+			}
+		}
+		break;
+	}
+	default:
+		ANKI_ASSERT(0);
+	}
+}
+
 PhysicsTriggerFilteredPair* PhysicsWorld::getOrCreatePhysicsTriggerFilteredPair(PhysicsTrigger* trigger, PhysicsFilteredObject* filtered, Bool& isNew)
 {
 	ANKI_ASSERT(trigger && filtered);
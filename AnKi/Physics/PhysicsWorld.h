@@ -13,6 +13,9 @@
 
 namespace anki {
 
+// Forward
+class ThreadJobManager;
+
 /// @addtogroup physics
 /// @{
 
@@ -36,6 +39,68 @@ public:
 	virtual void processResult(PhysicsFilteredObject& obj, const Vec3& worldNormal, const Vec3& worldPosition) = 0;
 };
 
+/// The type of a PhysicsSceneQuery.
+enum class PhysicsSceneQueryType : U8
+{
+	kRayCast,
+	kSphereSweep,
+	kBoxSweep,
+	kSphereOverlap,
+	kBoxOverlap,
+
+	kCount
+};
+
+/// A single query of a batch of scene queries. See PhysicsWorld::sceneQueries.
+class PhysicsSceneQuery
+{
+public:
+	Vec3 m_from = Vec3(0.0f); ///< Start of the ray or the sweep. Center of the shape for overlaps.
+	Vec3 m_to = Vec3(0.0f); ///< End of the ray or the sweep. Ignored for overlaps.
+	Vec3 m_extend = Vec3(0.0f); ///< The radius of the sphere is the x component. The half extents for boxes.
+	Quat m_rotation = Quat::getIdentity(); ///< Rotation of the box. Ignored by the rest.
+	PhysicsMaterialBit m_materialMask = PhysicsMaterialBit::kAll; ///< Materials to check.
+	PhysicsSceneQueryType m_type = PhysicsSceneQueryType::kRayCast;
+};
+
+/// The result of a PhysicsSceneQuery.
+class PhysicsSceneQueryResult
+{
+public:
+	/// The closest object hit by a ray or a sweep or the first overlapping object. nullptr if nothing was hit.
+	PhysicsFilteredObject* m_object = nullptr;
+
+	Vec3 m_worldPosition = Vec3(0.0f); ///< Hit position. Only for rays and sweeps.
+	Vec3 m_worldNormal = Vec3(0.0f); ///< Hit normal. Only for rays and sweeps.
+	F32 m_hitFraction = 1.0f; ///< Where in the [from, to] segment the hit happened. Only for rays and sweeps.
+
+	U32 m_overlapsOffset = 0; ///< Where the overlapping objects start in PhysicsSceneQueryBatch::m_overlaps.
+	U32 m_overlapCount = 0; ///< The number of overlapping objects written in PhysicsSceneQueryBatch::m_overlaps.
+};
+
+/// A batch of scene queries. Results are written to flat arrays.
+class PhysicsSceneQueryBatch
+{
+public:
+	ConstWeakArray<PhysicsSceneQuery> m_queries;
+
+	/// One result per query.
+	WeakArray<PhysicsSceneQueryResult> m_results;
+
+	/// Optional. All the objects of all overlap queries. Each query writes into a sub-range of the array. If the array is too small the
+	/// remaining objects are dropped.
+	WeakArray<PhysicsFilteredObject*> m_overlaps;
+
+	/// Optional. If present the queries will be split across the threads of the job manager.
+	ThreadJobManager* m_jobManager = nullptr;
+
+	/// The number of queries a single job processes.
+	U32 m_queriesPerJob = 64;
+
+	/// Written by PhysicsWorld::sceneQueries. The total number of objects written to m_overlaps.
+	U32 m_overlapCount = 0;
+};
+
 /// The master container for all physics related stuff.
 class PhysicsWorld : public MakeSingleton<PhysicsWorld>
 {
@@ -78,6 +143,10 @@ public:
 		rayCast(arr);
 	}
 
+	/// Run a batch of ray casts, sweeps and overlap tests. The queries only read the broadphase so they can run in parallel, but not in
+	/// parallel with update(). It only waits for its own jobs so it can be called from a job of PhysicsSceneQueryBatch::m_jobManager.
+	void sceneQueries(PhysicsSceneQueryBatch& batch) const;
+
 	ANKI_INTERNAL btDynamicsWorld& getBtWorld()
 	{
 		return *m_world;
@@ -101,6 +170,7 @@ public:
 private:
 	class MyOverlapFilterCallback;
 	class MyRaycastCallback;
+	class SceneQueryContext;
 
 	StackMemoryPool m_tmpPool;
 
@@ -127,6 +197,8 @@ private:
 	~PhysicsWorld();
 
 	void destroyMarkedForDeletion();
+
+	void runSceneQuery(const PhysicsSceneQuery& query, PhysicsSceneQueryResult& result, SceneQueryContext& ctx) const;
 };
 /// @}
 
@@ -103,8 +103,7 @@ void PrimaryNonRenderableVisibility::populateRenderGraph(RenderingContext& ctx)
 			if(feedbackType != GpuSceneNonRenderableObjectTypeWithFeedback::kCount)
 			{
 				// Read feedback from the GPU
-				DynamicArray<U32, MemoryPoolPtrWrapper<StackMemoryPool>> readbackData(&getRenderer().getFrameMemoryPool());
-				getRenderer().getReadbackManager().readMostRecentData(m_readbacks[feedbackType], readbackData);
+				const ConstWeakArray<U32> readbackData = getRenderer().getReadbackManager().readMostRecentData<U32>(m_readbacks[feedbackType]);
 
 				if(readbackData.getSize())
 				{
@@ -113,7 +112,7 @@ void PrimaryNonRenderableVisibility::populateRenderGraph(RenderingContext& ctx)
 
 					if(pairCount)
 					{
-						WeakArray<UVec2> pairs(reinterpret_cast<UVec2*>(&readbackData[1]), pairCount);
+						ConstWeakArray<UVec2> pairs(reinterpret_cast<const UVec2*>(&readbackData[1]), pairCount);
 						if(feedbackType == GpuSceneNonRenderableObjectTypeWithFeedback::kLight)
 						{
 							m_runCtx.m_interestingComponents.m_shadowLights = gatherComponents<LightComponent>(
@@ -13,6 +13,7 @@
 #include <AnKi/Collision/Functions.h>
 #include <AnKi/Shaders/Include/GpuVisibilityTypes.h>
 #include <AnKi/Core/GpuMemory/UnifiedGeometryBuffer.h>
+#include <AnKi/Util/Tracer.h>
 #include <AnKi/Core/StatsSet.h>
 #include <AnKi/Util/CVarSet.h>
 #include <AnKi/Core/App.h>
@@ -182,6 +183,7 @@ Error GpuVisibility::init()
 
 void GpuVisibility::populateRenderGraphInternal(Bool distanceBased, BaseGpuVisibilityInput& in, GpuVisibilityOutput& out)
 {
+	ANKI_TRACE_SCOPED_EVENT(RGpuVisibility);
 	ANKI_ASSERT(in.m_lodReferencePoint.x() != kMaxF32);
 
 	if(RenderStateBucketContainer::getSingleton().getBucketsActiveUserCount(in.m_technique) == 0) [[unlikely]]
@@ -243,14 +245,12 @@ void GpuVisibility::populateRenderGraphInternal(Bool distanceBased, BaseGpuVisib
 	// OoM
 	if(firstCallInFrame)
 	{
-		U32 data;
-		PtrSize dataReadSize;
-		getRenderer().getReadbackManager().readMostRecentData(m_outOfMemoryReadback, &data, sizeof(data), dataReadSize);
+		const ConstWeakArray<U32> data = getRenderer().getReadbackManager().readMostRecentData<U32>(m_outOfMemoryReadback);
 
-		if(dataReadSize == sizeof(U32) && data != 0)
+		if(data.getSize() && data[0] != 0)
 		{
 			CString who;
-			switch(data)
+			switch(data[0])
 			{
 			case 0b1:
 				who = "Stage 1";
@@ -918,6 +918,7 @@ Error GpuVisibilityNonRenderables::init()
 
 void GpuVisibilityNonRenderables::populateRenderGraph(GpuVisibilityNonRenderablesInput& in, GpuVisibilityNonRenderablesOutput& out)
 {
+	ANKI_TRACE_SCOPED_EVENT(RGpuVisibilityNonRenderables);
 	ANKI_ASSERT(in.m_viewProjectionMat != Mat4::getZero());
 	RenderGraphBuilder& rgraph = *in.m_rgraph;
 
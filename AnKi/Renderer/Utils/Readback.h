@@ -13,15 +13,13 @@ namespace anki {
 /// @addtogroup renderer
 /// @{
 
-/// A persistent GPU readback token. It's essentially a group of allocations.
+/// A persistent GPU readback token. It's essentially the allocations of the last frames.
 class MultiframeReadbackToken
 {
 	friend class ReadbackManager;
 
 private:
-	Array<GpuReadbackMemoryAllocation, kMaxFramesInFlight> m_allocations;
-	Array<U64, kMaxFramesInFlight> m_frameIds = {};
-	U32 m_slot = 0;
+	Array<GpuReadbackMemoryAllocation, kMaxFramesInFlight> m_allocations; ///< Indexed by the frame.
 };
 
 /// A small class that is used to streamling the use of GPU readbacks.
@@ -34,25 +32,11 @@ public:
 		return Error::kNone;
 	}
 
-	/// Read the most up to date data from the GPU. 1st thing to call in a frame.
-	void readMostRecentData(const MultiframeReadbackToken& token, void* data, PtrSize dataSize, PtrSize& dataOut) const;
-
-	/// Read the most up to date data from the GPU.
-	template<typename T, typename TMemPool>
-	void readMostRecentData(const MultiframeReadbackToken& token, DynamicArray<T, TMemPool>& data) const
+	/// Get the most up to date data the GPU has written. The memory is not copied and it's valid until endFrame(). 1st thing to call in a frame.
+	template<typename T>
+	ConstWeakArray<T> readMostRecentData(const MultiframeReadbackToken& token) const
 	{
-		const U32 slot = findBestSlot(token);
-		if(slot != kMaxU32 && token.m_allocations[slot].isValid())
-		{
-			const GpuReadbackMemoryAllocation& allocation = token.m_allocations[slot];
-
-			data.resize(allocation.getAllocatedSize() / sizeof(T));
-			memcpy(&data[0], static_cast<const U8*>(allocation.getMappedMemory()), allocation.getAllocatedSize());
-		}
-		else
-		{
-			data.resize(0);
-		}
+		return GpuReadbackMemoryPool::getSingleton().getMostRecentMappedMemory<T>(token.m_allocations);
 	}
 
 	/// Allocate new data for the following frame. 2nd thing to call in a frame.
@@ -60,44 +44,20 @@ public:
 	BufferView allocateStructuredBuffer(MultiframeReadbackToken& token, U32 count) const
 	{
 		ANKI_ASSERT(count > 0);
+		GpuReadbackMemoryPool& pool = GpuReadbackMemoryPool::getSingleton();
+		const U64 frame = pool.getFrame();
 
-		for([[maybe_unused]] U64 frame : token.m_frameIds)
-		{
-			ANKI_ASSERT(frame != m_frameId && "Can't allocate multiple times in a frame");
-		}
-
-		GpuReadbackMemoryAllocation& allocation = token.m_allocations[token.m_slot];
-
-		if(allocation.isValid() && allocation.getAllocatedSize() != sizeof(T) * count)
-		{
-			GpuReadbackMemoryPool::getSingleton().deferredFree(allocation);
-		}
-
-		if(!allocation.isValid())
-		{
-			allocation = GpuReadbackMemoryPool::getSingleton().allocateStructuredBuffer<T>(count);
-		}
-		token.m_frameIds[token.m_slot] = m_frameId;
+		GpuReadbackMemoryAllocation& allocation = token.m_allocations[frame % kMaxFramesInFlight];
+		ANKI_ASSERT(allocation.m_frame != frame && "Can't allocate multiple times in a frame");
 
-		token.m_slot = (token.m_slot + 1) % kMaxFramesInFlight;
-
-		return BufferView(&allocation.getBuffer(), allocation.getOffset(), sizeof(T) * count);
+		return pool.allocateStructuredBuffer<T>(count, allocation);
 	}
 
-	/// Last thing to call in a frame.
-	void endFrame(Fence* fence);
-
-private:
-	class Frame
+	/// Last thing to call in a frame. The App closes the frame of the GpuReadbackMemoryPool.
+	void endFrame(Fence* fence)
 	{
-	public:
-		FencePtr m_fence;
-	};
-
-	Array<Frame, kMaxFramesInFlight> m_frames;
-	U64 m_frameId = kMaxFramesInFlight;
-
-	U32 findBestSlot(const MultiframeReadbackToken& token) const;
+		GpuReadbackMemoryPool::getSingleton().setFrameFence(fence);
+	}
 };
 /// @}
 
@@ -4,7 +4,7 @@
 // http://www.anki3d.org/LICENSE
 
 #include <AnKi/Resource/AnimationResource.h>
-#include <AnKi/Util/Xml.h>
+#include <AnKi/Resource/ResourceDescriptor.h>
 
 namespace anki {
 
@@ -14,148 +14,92 @@ Error AnimationResource::load(const ResourceFilename& filename, [[maybe_unused]]
 	Second maxTime = kMinSecond;
 
 	// Document
-	ResourceXmlDocument doc;
-	ANKI_CHECK(openFileParseXml(filename, doc));
-	XmlElement rootel;
-	ANKI_CHECK(doc.getChildElement("animation", rootel));
-
-	// Count the number of identity keys. If all of the keys are identities drop a vector
-	U identPosCount = 0;
-	U identRotCount = 0;
-	U identScaleCount = 0;
+	ResourceFilePtr file;
+	ANKI_CHECK(openFile(filename, file));
+	ResourceDescriptor<AnimationBinary> desc;
+	ANKI_CHECK(desc.load(*file));
+	const AnimationBinary& binary = desc.getBinary();
 
 	// <channels>
-	XmlElement channelsEl;
-	ANKI_CHECK(rootel.getChildElement("channels", channelsEl));
-	XmlElement chEl;
-	ANKI_CHECK(channelsEl.getChildElement("channel", chEl));
-
-	U32 channelCount = 0;
-	ANKI_CHECK(chEl.getSiblingElementsCount(channelCount));
-	++channelCount;
-	if(channelCount == 0)
+	if(binary.m_channels.getSize() == 0)
 	{
 		ANKI_RESOURCE_LOGE("Didn't found any channels");
 		return Error::kUserData;
 	}
-	m_channels.resize(channelCount);
+	m_channels.resize(binary.m_channels.getSize());
 
 	// For all channels
-	channelCount = 0;
-	do
+	for(U32 channelIdx = 0; channelIdx < binary.m_channels.getSize(); ++channelIdx)
 	{
-		AnimationChannel& ch = m_channels[channelCount];
+		const AnimationBinaryChannel& inCh = binary.m_channels[channelIdx];
+		AnimationChannel& ch = m_channels[channelIdx];
 
 		// <name>
-		CString strtmp;
-		ANKI_CHECK(chEl.getAttributeText("name", strtmp));
-		ch.m_name = strtmp;
+		ch.m_name = desc.getString(inCh.m_nameOffset);
 
-		XmlElement keysEl, keyEl;
+		// Count the number of identity keys. If all of the keys are identities drop a vector
+		U32 identPosCount = 0;
+		U32 identRotCount = 0;
+		U32 identScaleCount = 0;
 
 		// <positionKeys>
-		ANKI_CHECK(chEl.getChildElementOptional("positionKeys", keysEl));
-		if(keysEl)
+		ch.m_positions.resize(inCh.m_positionKeyCount);
+		for(U32 i = 0; i < inCh.m_positionKeyCount; ++i)
 		{
-			ANKI_CHECK(keysEl.getChildElement("key", keyEl));
-
-			U32 count = 0;
-			ANKI_CHECK(keyEl.getSiblingElementsCount(count));
-			++count;
-			ch.m_positions.resize(count);
-
-			count = 0;
-			do
-			{
-				AnimationKeyframe<Vec3>& key = ch.m_positions[count++];
-
-				// time
-				ANKI_CHECK(keyEl.getAttributeNumber("time", key.m_time));
-				m_startTime = min(m_startTime, key.m_time);
-				maxTime = max(maxTime, key.m_time);
+			const AnimationBinaryKeyframe& inKey = binary.m_keyframes[inCh.m_firstPositionKey + i];
+			AnimationKeyframe<Vec3>& key = ch.m_positions[i];
 
-				// value
-				ANKI_CHECK(keyEl.getNumbers(key.m_value));
+			key.m_time = inKey.m_time;
+			m_startTime = min(m_startTime, key.m_time);
+			maxTime = max(maxTime, key.m_time);
 
-				// Check ident
-				if(key.m_value == Vec3(0.0))
-				{
-					++identPosCount;
-				}
+			key.m_value = Vec3(inKey.m_value[0], inKey.m_value[1], inKey.m_value[2]);
 
-				// Move to next
-				ANKI_CHECK(keyEl.getNextSiblingElement("key", keyEl));
-			} while(keyEl);
+			// Check ident
+			if(key.m_value == Vec3(0.0))
+			{
+				++identPosCount;
+			}
 		}
 
 		// <rotationKeys>
-		ANKI_CHECK(chEl.getChildElementOptional("rotationKeys", keysEl));
-		if(keysEl)
+		ch.m_rotations.resize(inCh.m_rotationKeyCount);
+		for(U32 i = 0; i < inCh.m_rotationKeyCount; ++i)
 		{
-			ANKI_CHECK(keysEl.getChildElement("key", keyEl));
-
-			U32 count = 0;
-			ANKI_CHECK(keyEl.getSiblingElementsCount(count));
-			++count;
-			ch.m_rotations.resize(count);
-
-			count = 0;
-			do
-			{
-				AnimationKeyframe<Quat>& key = ch.m_rotations[count++];
-
-				// time
-				ANKI_CHECK(keyEl.getAttributeNumber("time", key.m_time));
-				m_startTime = min(m_startTime, key.m_time);
-				maxTime = max(maxTime, key.m_time);
+			const AnimationBinaryKeyframe& inKey = binary.m_keyframes[inCh.m_firstRotationKey + i];
+			AnimationKeyframe<Quat>& key = ch.m_rotations[i];
 
-				// value
-				ANKI_CHECK(keyEl.getNumbers(key.m_value));
+			key.m_time = inKey.m_time;
+			m_startTime = min(m_startTime, key.m_time);
+			maxTime = max(maxTime, key.m_time);
 
-				// Check ident
-				if(key.m_value == Quat::getIdentity())
-				{
-					++identRotCount;
-				}
+			key.m_value = Quat(inKey.m_value[0], inKey.m_value[1], inKey.m_value[2], inKey.m_value[3]);
 
-				// Move to next
-				ANKI_CHECK(keyEl.getNextSiblingElement("key", keyEl));
-			} while(keyEl);
+			// Check ident
+			if(key.m_value == Quat::getIdentity())
+			{
+				++identRotCount;
+			}
 		}
 
 		// <scalingKeys>
-		ANKI_CHECK(chEl.getChildElementOptional("scaleKeys", keysEl));
-		if(keysEl)
+		ch.m_scales.resize(inCh.m_scaleKeyCount);
+		for(U32 i = 0; i < inCh.m_scaleKeyCount; ++i)
 		{
-			ANKI_CHECK(keysEl.getChildElement("key", keyEl));
-
-			U32 count = 0;
-			ANKI_CHECK(keyEl.getSiblingElementsCount(count));
-			++count;
-			ch.m_scales.resize(count);
-
-			count = 0;
-			do
-			{
-				AnimationKeyframe<F32>& key = ch.m_scales[count++];
+			const AnimationBinaryKeyframe& inKey = binary.m_keyframes[inCh.m_firstScaleKey + i];
+			AnimationKeyframe<F32>& key = ch.m_scales[i];
 
-				// time
-				ANKI_CHECK(keyEl.getAttributeNumber("time", key.m_time));
-				m_startTime = std::min(m_startTime, key.m_time);
-				maxTime = std::max(maxTime, key.m_time);
+			key.m_time = inKey.m_time;
+			m_startTime = min(m_startTime, key.m_time);
+			maxTime = max(maxTime, key.m_time);
 
-				// value
-				ANKI_CHECK(keyEl.getNumber(key.m_value));
+			key.m_value = inKey.m_value[0];
 
-				// Check ident
-				if(isZero(key.m_value - 1.0f))
-				{
-					++identScaleCount;
-				}
-
-				// Move to next
-				ANKI_CHECK(keyEl.getNextSiblingElement("key", keyEl));
-			} while(keyEl);
+			// Check ident
+			if(isZero(key.m_value - 1.0f))
+			{
+				++identScaleCount;
+			}
 		}
 
 		// Remove identity vectors
@@ -173,11 +117,7 @@ Error AnimationResource::load(const ResourceFilename& filename, [[maybe_unused]]
 		{
 			ch.m_scales.destroy();
 		}
-
-		// Move to next channel
-		++channelCount;
-		ANKI_CHECK(chEl.getNextSiblingElement("channel", chEl));
-	} while(chEl);
+	}
 
 	m_duration = maxTime - m_startTime;
 
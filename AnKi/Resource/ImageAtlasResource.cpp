@@ -5,29 +5,22 @@
 
 #include <AnKi/Resource/ImageAtlasResource.h>
 #include <AnKi/Resource/ResourceManager.h>
-#include <AnKi/Util/Xml.h>
+#include <AnKi/Resource/ResourceDescriptor.h>
 
 namespace anki {
 
 Error ImageAtlasResource::load(const ResourceFilename& filename, Bool async)
 {
-	ResourceXmlDocument doc;
-	ANKI_CHECK(openFileParseXml(filename, doc));
-
-	XmlElement rootel, el;
-
-	//
-	// <imageAtlas>
-	//
-	ANKI_CHECK(doc.getChildElement("imageAtlas", rootel));
+	ResourceFilePtr file;
+	ANKI_CHECK(openFile(filename, file));
+	ResourceDescriptor<ImageAtlasBinary> desc;
+	ANKI_CHECK(desc.load(*file));
+	const ImageAtlasBinary& binary = desc.getBinary();
 
 	//
 	// <image>
 	//
-	ANKI_CHECK(rootel.getChildElement("image", el));
-	CString texFname;
-	ANKI_CHECK(el.getText(texFname));
-	ANKI_CHECK(ResourceManager::getSingleton().loadResource<ImageResource>(texFname, m_image, async));
+	ANKI_CHECK(ResourceManager::getSingleton().loadResource<ImageResource>(desc.getString(binary.m_imageOffset), m_image, async));
 
 	m_size[0] = m_image->getWidth();
 	m_size[1] = m_image->getHeight();
@@ -35,9 +28,7 @@ Error ImageAtlasResource::load(const ResourceFilename& filename, Bool async)
 	//
 	// <subImageMargin>
 	//
-	ANKI_CHECK(rootel.getChildElement("subImageMargin", el));
-	I64 margin = 0;
-	ANKI_CHECK(el.getNumber(margin));
+	const I64 margin = binary.m_subImageMargin;
 	if(margin >= I(m_image->getWidth()) || margin >= I(m_image->getHeight()) || margin < 0)
 	{
 		ANKI_RESOURCE_LOGE("Too big margin %d", I32(margin));
@@ -51,16 +42,9 @@ Error ImageAtlasResource::load(const ResourceFilename& filename, Bool async)
 
 	// Get counts
 	U32 namesSize = 0;
-	U32 subTexesCount = 0;
-	XmlElement subTexesEl, subTexEl;
-	ANKI_CHECK(rootel.getChildElement("subImages", subTexesEl));
-	ANKI_CHECK(subTexesEl.getChildElement("subImage", subTexEl));
-	do
+	for(const ImageAtlasBinarySubImage& subImage : binary.m_subImages)
 	{
-		ANKI_CHECK(subTexEl.getChildElement("name", el));
-		CString name;
-		ANKI_CHECK(el.getText(name));
-
+		const CString name = desc.getString(subImage.m_nameOffset);
 		if(name.getLength() < 1)
 		{
 			ANKI_RESOURCE_LOGE("Something wrong with the <name> tag. Probably empty");
@@ -68,39 +52,26 @@ Error ImageAtlasResource::load(const ResourceFilename& filename, Bool async)
 		}
 
 		namesSize += U32(name.getLength()) + 1;
-		++subTexesCount;
-
-		ANKI_CHECK(subTexEl.getNextSiblingElement("subImage", subTexEl));
-	} while(subTexEl);
+	}
 
 	// Allocate
 	m_subTexNames.resize(namesSize);
-	m_subTexes.resize(subTexesCount);
+	m_subTexes.resize(binary.m_subImages.getSize());
 
 	// Iterate again and populate
-	subTexesCount = 0;
 	char* names = &m_subTexNames[0];
-	ANKI_CHECK(subTexesEl.getChildElement("subImage", subTexEl));
-	do
+	for(U32 i = 0; i < binary.m_subImages.getSize(); ++i)
 	{
-		ANKI_CHECK(subTexEl.getChildElement("name", el));
-		CString name;
-		ANKI_CHECK(el.getText(name));
+		const ImageAtlasBinarySubImage& subImage = binary.m_subImages[i];
+		const CString name = desc.getString(subImage.m_nameOffset);
 
 		memcpy(names, &name[0], name.getLength() + 1);
 
-		m_subTexes[subTexesCount].m_name = names;
-
-		ANKI_CHECK(subTexEl.getChildElement("uv", el));
-		Vec4 uv;
-		ANKI_CHECK(el.getNumbers(uv));
-		m_subTexes[subTexesCount].m_uv = {uv[0], uv[1], uv[2], uv[3]};
+		m_subTexes[i].m_name = names;
+		m_subTexes[i].m_uv = {subImage.m_uv[0], subImage.m_uv[1], subImage.m_uv[2], subImage.m_uv[3]};
 
 		names += name.getLength() + 1;
-		++subTexesCount;
-
-		ANKI_CHECK(subTexEl.getNextSiblingElement("subImage", subTexEl));
-	} while(subTexEl);
+	}
 
 	return Error::kNone;
 }
@@ -7,53 +7,42 @@
 #include <AnKi/Resource/ResourceManager.h>
 #include <AnKi/Resource/ImageResource.h>
 #include <AnKi/Core/App.h>
-#include <AnKi/Util/Xml.h>
+#include <AnKi/Resource/ResourceDescriptor.h>
 
 namespace anki {
 
 inline constexpr Array<CString, U32(BuiltinMutatorId::kCount)> kBuiltinMutatorNames = {{"NONE", "ANKI_BONES", "ANKI_VELOCITY"}};
 
-// This is some trickery to select calling between XmlElement::getAttributeNumber and XmlElement::getAttributeNumbers
-namespace {
-
-template<typename T>
-class IsShaderVarDataTypeAnArray
-{
-public:
-	static constexpr Bool kValue = false;
-};
-
-#define ANKI_SVDT_MACRO(type, baseType, rowCount, columnCount, isIntagralType) \
-	template<> \
-	class IsShaderVarDataTypeAnArray<type> \
-	{ \
-	public: \
-		static constexpr Bool kValue = rowCount * columnCount > 1; \
-	};
-#include <AnKi/Gr/ShaderVariableDataType.def.h>
-#undef ANKI_SVDT_MACRO
-
-template<typename T, Bool isArray = IsShaderVarDataTypeAnArray<T>::kValue>
-class GetAttribute
+/// Set the value of a variable from the numbers of the descriptor.
+template<typename T, typename TBaseType, U32 kComponentCount, Bool kIntegral>
+static Error setVariableValue(ConstWeakArray<F64> numbers, CString varName, T& out)
 {
-public:
-	Error operator()(const XmlElement& el, T& out)
+	if(numbers.getSize() != kComponentCount)
 	{
-		return el.getAttributeNumbers("value", out);
+		ANKI_RESOURCE_LOGE("Wrong number of values for input: %s", varName.cstr());
+		return Error::kUserData;
 	}
-};
 
-template<typename T>
-class GetAttribute<T, false>
-{
-public:
-	Error operator()(const XmlElement& el, T& out)
+	for(U32 i = 0; i < kComponentCount; ++i)
 	{
-		return el.getAttributeNumber("value", out);
+		if(kIntegral && numbers[i] != std::floor(numbers[i]))
+		{
+			ANKI_RESOURCE_LOGE("Input expects integral values: %s", varName.cstr());
+			return Error::kUserData;
+		}
+
+		if constexpr(kComponentCount == 1)
+		{
+			out = T(TBaseType(numbers[i]));
+		}
+		else
+		{
+			out[i] = TBaseType(numbers[i]);
+		}
 	}
-};
 
-} // namespace
+	return Error::kNone;
+}
 
 static Bool mutatorValueExists(const ShaderBinaryMutator& m, MutatorValue val)
 {
@@ -101,33 +90,21 @@ const MaterialVariable* MaterialResource::tryFindVariableInternal(CString name)
 
 Error MaterialResource::load(const ResourceFilename& filename, Bool async)
 {
-	ResourceXmlDocument doc;
-	XmlElement el;
-	ANKI_CHECK(openFileParseXml(filename, doc));
-
-	// <material>
-	XmlElement rootEl;
-	ANKI_CHECK(doc.getChildElement("material", rootEl));
+	ResourceFilePtr file;
+	ANKI_CHECK(openFile(filename, file));
+	ResourceDescriptor<MaterialBinary> desc;
+	ANKI_CHECK(desc.load(*file));
 
 	// <shaderPrograms>
-	XmlElement shaderProgramEl;
-	ANKI_CHECK(rootEl.getChildElement("shaderProgram", shaderProgramEl));
-	ANKI_CHECK(parseShaderProgram(shaderProgramEl, async));
+	ANKI_CHECK(parseShaderProgram(desc, async));
 
 	ANKI_ASSERT(!!m_techniquesMask);
 
 	// <inputs>
 	BitSet<128> varsSet(false);
-	ANKI_CHECK(rootEl.getChildElementOptional("inputs", el));
-	if(el)
+	for(const MaterialBinaryInput& input : desc.getBinary().m_inputs)
 	{
-		XmlElement inputEl;
-		ANKI_CHECK(el.getChildElement("input", inputEl));
-		do
-		{
-			ANKI_CHECK(parseInput(inputEl, async, varsSet));
-			ANKI_CHECK(inputEl.getNextSiblingElement("input", inputEl));
-		} while(inputEl);
+		ANKI_CHECK(parseInput(desc, input, async, varsSet));
 	}
 
 	if(varsSet.getSetBitCount() != m_vars.getSize())
@@ -152,11 +129,10 @@ Error MaterialResource::load(const ResourceFilename& filename, Bool async)
 	return Error::kNone;
 }
 
-Error MaterialResource::parseShaderProgram(XmlElement shaderProgramEl, Bool async)
+Error MaterialResource::parseShaderProgram(const ResourceDescriptor<MaterialBinary>& desc, Bool async)
 {
 	// name
-	CString shaderName;
-	ANKI_CHECK(shaderProgramEl.getAttributeText("name", shaderName));
+	const CString shaderName = desc.getString(desc.getBinary().m_shaderProgramOffset);
 
 	ResourceString fname;
 	fname.sprintf("ShaderBinaries/%s.ankiprogbin", shaderName.cstr());
@@ -223,11 +199,9 @@ Error MaterialResource::parseShaderProgram(XmlElement shaderProgramEl, Bool asyn
 	}
 
 	// <mutation>
-	XmlElement mutatorsEl;
-	ANKI_CHECK(shaderProgramEl.getChildElementOptional("mutation", mutatorsEl));
-	if(mutatorsEl)
+	if(desc.getBinary().m_mutations.getSize())
 	{
-		ANKI_CHECK(parseMutators(mutatorsEl));
+		ANKI_CHECK(parseMutators(desc));
 	}
 
 	// And find the builtin mutators
@@ -239,25 +213,18 @@ Error MaterialResource::parseShaderProgram(XmlElement shaderProgramEl, Bool asyn
 	return Error::kNone;
 }
 
-Error MaterialResource::parseMutators(XmlElement mutatorsEl)
+Error MaterialResource::parseMutators(const ResourceDescriptor<MaterialBinary>& desc)
 {
-	XmlElement mutatorEl;
-	ANKI_CHECK(mutatorsEl.getChildElement("mutator", mutatorEl));
-
-	U32 mutatorCount = 0;
-	ANKI_CHECK(mutatorEl.getSiblingElementsCount(mutatorCount));
-	++mutatorCount;
-	ANKI_ASSERT(mutatorCount > 0);
-	m_partialMutation.resize(mutatorCount);
-	mutatorCount = 0;
+	const ConstWeakArray<MaterialBinaryMutation> mutations = desc.getBinary().m_mutations;
+	ANKI_ASSERT(mutations.getSize() > 0);
+	m_partialMutation.resize(mutations.getSize());
 
-	do
+	for(U32 mutatorIdx = 0; mutatorIdx < mutations.getSize(); ++mutatorIdx)
 	{
-		PartialMutation& pmutation = m_partialMutation[mutatorCount];
+		PartialMutation& pmutation = m_partialMutation[mutatorIdx];
 
 		// name
-		CString mutatorName;
-		ANKI_CHECK(mutatorEl.getAttributeText("name", mutatorName));
+		const CString mutatorName = desc.getString(mutations[mutatorIdx].m_nameOffset);
 		if(mutatorName.isEmpty())
 		{
 			ANKI_RESOURCE_LOGE("Mutator name is empty");
@@ -285,7 +252,7 @@ Error MaterialResource::parseMutators(XmlElement mutatorsEl)
 		}
 
 		// value
-		ANKI_CHECK(mutatorEl.getAttributeNumber("value", pmutation.m_value));
+		pmutation.m_value = mutations[mutatorIdx].m_value;
 
 		// Find mutator
 		pmutation.m_mutator = m_prog->tryFindMutator(mutatorName);
@@ -301,13 +268,7 @@ Error MaterialResource::parseMutators(XmlElement mutatorsEl)
 			ANKI_RESOURCE_LOGE("Value %d is not part of the mutator %s", pmutation.m_value, mutatorName.cstr());
 			return Error::kUserData;
 		}
-
-		// Advance
-		++mutatorCount;
-		ANKI_CHECK(mutatorEl.getNextSiblingElement("mutator", mutatorEl));
-	} while(mutatorEl);
-
-	ANKI_ASSERT(mutatorCount == m_partialMutation.getSize());
+	}
 
 	return Error::kNone;
 }
@@ -408,11 +369,10 @@ Error MaterialResource::createVars()
 	return Error::kNone;
 }
 
-Error MaterialResource::parseInput(XmlElement inputEl, Bool async, BitSet<128>& varsSet)
+Error MaterialResource::parseInput(const ResourceDescriptor<MaterialBinary>& desc, const MaterialBinaryInput& input, Bool async, BitSet<128>& varsSet)
 {
 	// Get var name
-	CString varName;
-	ANKI_CHECK(inputEl.getAttributeText("name", varName));
+	const CString varName = desc.getString(input.m_nameOffset);
 
 	// Try find var
 	MaterialVariable* foundVar = tryFindVariable(varName);
@@ -432,18 +392,18 @@ Error MaterialResource::parseInput(XmlElement inputEl, Bool async, BitSet<128>&
 	varsSet.set(idx);
 
 	// Set the value
+	const ConstWeakArray<F64> numbers(desc.getBinary().m_numbers.getBegin() + input.m_firstNumber, input.m_numberCount);
 	if(foundVar->m_dataType == ShaderVariableDataType::kU32)
 	{
 		// U32 is a bit special. It might be a number or a bindless texture
 
-		CString value;
-		ANKI_CHECK(inputEl.getAttributeText("value", value));
+		const CString value = desc.getString(input.m_valueOffset);
 
 		// Check if the value has letters
 		Bool containsAlpharithmetic = false;
 		for(Char c : value)
 		{
-			if((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'a'))
+			if((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'))
 			{
 				containsAlpharithmetic = true;
 				break;
@@ -459,7 +419,7 @@ Error MaterialResource::parseInput(XmlElement inputEl, Bool async, BitSet<128>&
 		}
 		else
 		{
-			ANKI_CHECK(GetAttribute<U32>()(inputEl, foundVar->m_U32));
+			ANKI_CHECK((setVariableValue<U32, U32, 1, true>(numbers, varName, foundVar->m_U32)));
 		}
 	}
 	else
@@ -468,7 +428,8 @@ Error MaterialResource::parseInput(XmlElement inputEl, Bool async, BitSet<128>&
 		{
 #define ANKI_SVDT_MACRO(type, baseType, rowCount, columnCount, isIntagralType) \
 	case ShaderVariableDataType::k##type: \
-		ANKI_CHECK(GetAttribute<type>()(inputEl, foundVar->ANKI_CONCATENATE(m_, type))); \
+		ANKI_CHECK( \
+			(setVariableValue<type, baseType, rowCount * columnCount, isIntagralType>(numbers, varName, foundVar->ANKI_CONCATENATE(m_, type)))); \
 		break;
 #include <AnKi/Gr/ShaderVariableDataType.def.h>
 #undef ANKI_SVDT_MACRO
@@ -509,7 +470,20 @@ void MaterialResource::prefillLocalConstants()
 	}
 }
 
-const MaterialVariant& MaterialResource::getOrCreateVariant(const RenderingKey& key_) const
+const MaterialVariant& MaterialResource::getOrCreateVariant(const RenderingKey& key) const
+{
+	const MaterialVariant* variant;
+	[[maybe_unused]] const Bool ready = getOrCreateVariantInternal(key, true, variant);
+	ANKI_ASSERT(ready);
+	return *variant;
+}
+
+Bool MaterialResource::tryGetOrCreateVariant(const RenderingKey& key, const MaterialVariant*& variant) const
+{
+	return getOrCreateVariantInternal(key, false, variant);
+}
+
+Bool MaterialResource::getOrCreateVariantInternal(const RenderingKey& key_, Bool block, const MaterialVariant*& outVariant) const
 {
 	RenderingKey key = key_;
 
@@ -544,19 +518,12 @@ const MaterialVariant& MaterialResource::getOrCreateVariant(const RenderingKey&
 		RLockGuard<RWMutex> lock(m_variantMatrixMtx);
 		if(variant.m_prog.isCreated()) [[likely]]
 		{
-			return variant;
+			outVariant = &variant;
+			return true;
 		}
 	}
 
-	// Not initialized, init it
-	WLockGuard<RWMutex> lock(m_variantMatrixMtx);
-
-	// Check again
-	if(variant.m_prog.isCreated())
-	{
-		return variant;
-	}
-
+	// Not initialized, init it. The program resource doesn't compile the same variant twice so do it outside the lock
 	ShaderProgramResourceVariantInitInfo initInfo(m_prog);
 
 	for(const PartialMutation& m : m_partialMutation)
@@ -618,21 +585,62 @@ const MaterialVariant& MaterialResource::getOrCreateVariant(const RenderingKey&
 	}
 
 	const ShaderProgramResourceVariant* progVariant = nullptr;
-	m_prog->getOrCreateVariant(initInfo, progVariant);
+	if(block)
+	{
+		m_prog->getOrCreateVariant(initInfo, progVariant);
+	}
+	else if(!m_prog->tryGetOrCreateVariant(initInfo, progVariant))
+	{
+		// Still compiling, draw with another variant for now
+		outVariant = tryFindFallbackVariant(key);
+		if(outVariant)
+		{
+			return false;
+		}
+
+		// Nothing to fallback to
+		m_prog->getOrCreateVariant(initInfo, progVariant);
+	}
 
 	if(!progVariant)
 	{
 		ANKI_RESOURCE_LOGF("Fetched skipped mutation on program %s", getFilename().cstr());
 	}
 
-	variant.m_prog.reset(&progVariant->getProgram());
+	WLockGuard<RWMutex> lock(m_variantMatrixMtx);
 
-	if(!!(RenderingTechniqueBit(1 << key.getRenderingTechnique()) & RenderingTechniqueBit::kAllRt))
+	// Check again, another thread might have set it in the meantime
+	if(!variant.m_prog.isCreated())
 	{
-		variant.m_rtShaderGroupHandleIndex = progVariant->getShaderGroupHandleIndex();
+		variant.m_prog.reset(&progVariant->getProgram());
+
+		if(!!(RenderingTechniqueBit(1 << key.getRenderingTechnique()) & RenderingTechniqueBit::kAllRt))
+		{
+			variant.m_rtShaderGroupHandleIndex = progVariant->getShaderGroupHandleIndex();
+		}
 	}
 
-	return variant;
+	outVariant = &variant;
+	return true;
+}
+
+const MaterialVariant* MaterialResource::tryFindFallbackVariant(const RenderingKey& key) const
+{
+	// The variants of the same technique have the same shader types. Prefer the ones with the same skinning
+	RLockGuard<RWMutex> lock(m_variantMatrixMtx);
+	for(U32 skinned : {U32(key.getSkinned()), U32(!key.getSkinned())})
+	{
+		for(U32 velocity : {U32(key.getVelocity()), U32(!key.getVelocity())})
+		{
+			const MaterialVariant& variant = m_variantMatrix[key.getRenderingTechnique()][skinned][velocity][key.getMeshletRendering()];
+			if(variant.m_prog.isCreated())
+			{
+				return &variant;
+			}
+		}
+	}
+
+	return nullptr;
 }
 
 } // end namespace anki
@@ -16,7 +16,10 @@
 namespace anki {
 
 // Forward
-class XmlElement;
+class MaterialBinary;
+class MaterialBinaryInput;
+template<typename>
+class ResourceDescriptor;
 
 /// @addtogroup resource
 /// @{
@@ -210,9 +213,16 @@ public:
 		return m_techniquesMask;
 	}
 
+	/// If the program is deferred and the variant is still compiling it blocks until the compilation is done. See tryGetOrCreateVariant().
 	/// @note It's thread-safe.
 	const MaterialVariant& getOrCreateVariant(const RenderingKey& key) const;
 
+	/// Same as getOrCreateVariant() but it doesn't block on the variants of deferred programs. While the variant is compiling it returns a ready
+	/// variant of the same technique with different skinning or velocity. It only blocks if there is no such variant.
+	/// @return False if the variant is a fallback. Try again later.
+	/// @note It's thread-safe.
+	Bool tryGetOrCreateVariant(const RenderingKey& key, const MaterialVariant*& variant) const;
+
 	/// Get a buffer with prefilled uniforms.
 	ConstWeakArray<U8> getPrefilledLocalConstants() const
 	{
@@ -254,15 +264,20 @@ private:
 	RenderingTechniqueBit m_techniquesMask = RenderingTechniqueBit::kNone;
 	ShaderTechniqueBit m_shaderTechniques = ShaderTechniqueBit::kNone;
 
-	Error parseMutators(XmlElement mutatorsEl);
-	Error parseShaderProgram(XmlElement techniqueEl, Bool async);
-	Error parseInput(XmlElement inputEl, Bool async, BitSet<128>& varsSet);
+	Error parseMutators(const ResourceDescriptor<MaterialBinary>& desc);
+	Error parseShaderProgram(const ResourceDescriptor<MaterialBinary>& desc, Bool async);
+	Error parseInput(const ResourceDescriptor<MaterialBinary>& desc, const MaterialBinaryInput& input, Bool async, BitSet<128>& varsSet);
 	Error findBuiltinMutators();
 	Error createVars();
 	void prefillLocalConstants();
 
 	const MaterialVariable* tryFindVariableInternal(CString name) const;
 
+	Bool getOrCreateVariantInternal(const RenderingKey& key, Bool block, const MaterialVariant*& variant) const;
+
+	/// Find a ready variant that has the same technique as the key.
+	const MaterialVariant* tryFindFallbackVariant(const RenderingKey& key) const;
+
 	const MaterialVariable* tryFindVariable(CString name) const
 	{
 		return tryFindVariableInternal(name);
@@ -35,7 +35,7 @@ Error MeshBinaryLoader::load(const ResourceFilename& filename)
 {
 	// Load header + submeshes
 	ANKI_CHECK(ResourceManager::getSingleton().getFilesystem().openFile(filename, m_file));
-	ANKI_CHECK(m_file->read(&m_header, sizeof(m_header)));
+	ANKI_CHECK(readAt(0, &m_header, sizeof(m_header)));
 	ANKI_CHECK(checkHeader());
 	ANKI_CHECK(loadSubmeshes());
 
@@ -45,7 +45,7 @@ Error MeshBinaryLoader::load(const ResourceFilename& filename)
 Error MeshBinaryLoader::loadSubmeshes()
 {
 	m_subMeshes.resize(m_header.m_subMeshCount);
-	ANKI_CHECK(m_file->read(&m_subMeshes[0], m_subMeshes.getSizeInBytes()));
+	ANKI_CHECK(readAt(sizeof(m_header), &m_subMeshes[0], m_subMeshes.getSizeInBytes()));
 
 	// Checks
 	const U32 indicesPerFace = 3;
@@ -283,8 +283,7 @@ Error MeshBinaryLoader::storeIndexBuffer(U32 lod, void* ptr, PtrSize size)
 		seek += getLodBuffersSize(l);
 	}
 
-	ANKI_CHECK(m_file->seek(seek, FileSeekOrigin::kBeginning));
-	ANKI_CHECK(m_file->read(ptr, size));
+	ANKI_CHECK(readAt(seek, ptr, size));
 
 	return Error::kNone;
 }
@@ -310,8 +309,7 @@ Error MeshBinaryLoader::storeVertexBuffer(U32 lod, U32 bufferIdx, void* ptr, Ptr
 		seek += getVertexBufferSize(lod, i);
 	}
 
-	ANKI_CHECK(m_file->seek(seek, FileSeekOrigin::kBeginning));
-	ANKI_CHECK(m_file->read(ptr, size));
+	ANKI_CHECK(readAt(seek, ptr, size));
 
 	return Error::kNone;
 }
@@ -339,8 +337,7 @@ Error MeshBinaryLoader::storeMeshletIndicesBuffer(U32 lod, void* ptr, PtrSize si
 
 	seek += getMeshletsBufferSize(lod);
 
-	ANKI_CHECK(m_file->seek(seek, FileSeekOrigin::kBeginning));
-	ANKI_CHECK(m_file->read(ptr, size));
+	ANKI_CHECK(readAt(seek, ptr, size));
 
 	return Error::kNone;
 }
@@ -365,8 +362,7 @@ Error MeshBinaryLoader::storeMeshletBuffer(U32 lod, WeakArray<MeshBinaryMeshlet>
 		seek += getVertexBufferSize(lod, i);
 	}
 
-	ANKI_CHECK(m_file->seek(seek, FileSeekOrigin::kBeginning));
-	ANKI_CHECK(m_file->read(&out[0], out.getSizeInBytes()));
+	ANKI_CHECK(readAt(seek, &out[0], out.getSizeInBytes()));
 
 	return Error::kNone;
 }
@@ -414,6 +410,17 @@ Error MeshBinaryLoader::storeIndicesAndPosition(U32 lod, ResourceDynamicArray<U3
 	return Error::kNone;
 }
 
+Error MeshBinaryLoader::readAt(PtrSize offset, void* ptr, PtrSize size) const
+{
+	if(offset + size > m_file->getSize())
+	{
+		ANKI_RESOURCE_LOGE("Mesh file is too small");
+		return Error::kUserData;
+	}
+
+	return m_file->readAt(offset, ptr, size);
+}
+
 PtrSize MeshBinaryLoader::getLodBuffersSize(U32 lod) const
 {
 	ANKI_ASSERT(lod < m_header.m_lodCount);
@@ -108,6 +108,9 @@ private:
 	Error checkHeader() const;
 	Error checkFormat(VertexStreamId stream, Bool isOptional, Bool canBeTransformed) const;
 	Error loadSubmeshes();
+
+	/// Copy a part of the file.
+	Error readAt(PtrSize offset, void* ptr, PtrSize size) const;
 };
 /// @}
 
@@ -6,7 +6,7 @@
 #include <AnKi/Resource/ModelResource.h>
 #include <AnKi/Resource/ResourceManager.h>
 #include <AnKi/Resource/MeshResource.h>
-#include <AnKi/Util/Xml.h>
+#include <AnKi/Resource/ResourceDescriptor.h>
 #include <AnKi/Util/Logger.h>
 #include <AnKi/Core/App.h>
 
@@ -134,73 +134,35 @@ Error ModelResource::load(const ResourceFilename& filename, Bool async)
 {
 	// Load
 	//
-	ResourceXmlDocument doc;
-	ANKI_CHECK(openFileParseXml(filename, doc));
-
-	XmlElement rootEl;
-	ANKI_CHECK(doc.getChildElement("model", rootEl));
+	ResourceFilePtr file;
+	ANKI_CHECK(openFile(filename, file));
+	ResourceDescriptor<ModelBinary> desc;
+	ANKI_CHECK(desc.load(*file));
 
 	// <modelPatches>
-	XmlElement modelPatchesEl;
-	ANKI_CHECK(rootEl.getChildElement("modelPatches", modelPatchesEl));
-
-	XmlElement modelPatchEl;
-	ANKI_CHECK(modelPatchesEl.getChildElement("modelPatch", modelPatchEl));
-
-	// Count
-	U32 count = 0;
-	do
-	{
-		++count;
-		// Move to next
-		ANKI_CHECK(modelPatchEl.getNextSiblingElement("modelPatch", modelPatchEl));
-	} while(modelPatchEl);
+	const ConstWeakArray<ModelBinaryPatch> patches = desc.getBinary().m_patches;
 
 	// Check number of model patches
-	if(count < 1)
+	if(patches.getSize() < 1)
 	{
 		ANKI_RESOURCE_LOGE("Zero number of model patches");
 		return Error::kUserData;
 	}
 
-	m_modelPatches.resize(count);
+	m_modelPatches.resize(patches.getSize());
 
-	count = 0;
-	ANKI_CHECK(modelPatchesEl.getChildElement("modelPatch", modelPatchEl));
-	do
+	for(U32 count = 0; count < patches.getSize(); ++count)
 	{
-		XmlElement materialEl;
-		ANKI_CHECK(modelPatchEl.getChildElement("material", materialEl));
-
-		XmlElement meshEl;
-		ANKI_CHECK(modelPatchEl.getChildElement("mesh", meshEl));
-		CString meshFname;
-		ANKI_CHECK(meshEl.getText(meshFname));
-
-		U32 subMeshIndex;
-		Bool subMeshIndexPresent;
-		ANKI_CHECK(meshEl.getAttributeNumberOptional("subMeshIndex", subMeshIndex, subMeshIndexPresent));
-		if(!subMeshIndexPresent)
-		{
-			subMeshIndex = kMaxU32;
-		}
-
-		CString cstr;
-		ANKI_CHECK(materialEl.getText(cstr));
-
-		ANKI_CHECK(m_modelPatches[count].init(this, meshFname, cstr, subMeshIndex, async));
+		const ModelBinaryPatch& patch = patches[count];
+		ANKI_CHECK(m_modelPatches[count].init(this, desc.getString(patch.m_meshOffset), desc.getString(patch.m_materialOffset), patch.m_subMeshIndex,
+											  async));
 
 		if(count > 0 && m_modelPatches[count].supportsSkinning() != m_modelPatches[count - 1].supportsSkinning())
 		{
 			ANKI_RESOURCE_LOGE("All model patches should support skinning or all shouldn't support skinning");
 			return Error::kUserData;
 		}
-
-		// Move to next
-		ANKI_CHECK(modelPatchEl.getNextSiblingElement("modelPatch", modelPatchEl));
-		++count;
-	} while(modelPatchEl);
-	ANKI_ASSERT(count == m_modelPatches.getSize());
+	}
 
 	// Calculate compound bounding volume
 	m_boundingVolume = m_modelPatches[0].m_aabb;
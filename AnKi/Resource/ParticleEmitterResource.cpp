@@ -7,119 +7,79 @@
 #include <AnKi/Resource/ResourceManager.h>
 #include <AnKi/Resource/ModelResource.h>
 #include <AnKi/Util/StringList.h>
-#include <AnKi/Util/Xml.h>
+#include <AnKi/Resource/ResourceDescriptor.h>
 #include <cstring>
 
 namespace anki {
 
 template<typename T>
-static Error getXmlVal(const XmlElement& el, const CString& tag, T& out, Bool& found)
+static void getRangeVal(const Array<F64, 3>& in, T& out)
 {
-	return el.getAttributeNumberOptional(tag, out, found);
+	out = T(in[0]);
 }
 
 template<>
-Error getXmlVal(const XmlElement& el, const CString& tag, Vec3& out, Bool& found)
+void getRangeVal(const Array<F64, 3>& in, Vec3& out)
 {
-	return el.getAttributeNumbersOptional(tag, out, found);
+	out = Vec3(F32(in[0]), F32(in[1]), F32(in[2]));
 }
 
 Error ParticleEmitterResource::load(const ResourceFilename& filename, Bool async)
 {
-	ResourceXmlDocument doc;
-	ANKI_CHECK(openFileParseXml(filename, doc));
-	XmlElement rootEl; // Root element
-	ANKI_CHECK(doc.getChildElement("particleEmitter", rootEl));
-
-#define ANKI_XML(varName, VarName) \
-	ANKI_CHECK(readVar(rootEl, #varName, m_particle.m_min##VarName, m_particle.m_max##VarName, &m_particle.m_min##VarName))
-
-	ANKI_XML(life, Life);
-	ANKI_XML(mass, Mass);
-	ANKI_XML(initialSize, InitialSize);
-	ANKI_XML(finalSize, FinalSize);
-	ANKI_XML(initialAlpha, InitialAlpha);
-	ANKI_XML(finalAlpha, FinalAlpha);
-	ANKI_XML(forceDirection, ForceDirection);
-	ANKI_XML(forceMagnitude, ForceMagnitude);
-	ANKI_XML(gravity, Gravity);
-	ANKI_XML(startingPosition, StartingPosition);
-
-#undef ANKI_XML
-
-	XmlElement el;
-	ANKI_CHECK(rootEl.getChildElement("maxNumberOfParticles", el));
-	ANKI_CHECK(el.getAttributeNumber("value", m_maxNumOfParticles));
-
-	ANKI_CHECK(rootEl.getChildElement("emissionPeriod", el));
-	ANKI_CHECK(el.getAttributeNumber("value", m_emissionPeriod));
-
-	ANKI_CHECK(rootEl.getChildElement("particlesPerEmission", el));
-	ANKI_CHECK(el.getAttributeNumber("value", m_particlesPerEmission));
-
-	ANKI_CHECK(rootEl.getChildElementOptional("usePhysicsEngine", el));
-	if(el)
-	{
-		ANKI_CHECK(el.getAttributeNumber("value", m_usePhysicsEngine));
-	}
-
-	ANKI_CHECK(rootEl.getChildElementOptional("emitterBoundingVolume", el));
-	if(el)
-	{
-		ANKI_CHECK(el.getAttributeNumbers("min", m_emitterBoundingVolumeMin));
-		ANKI_CHECK(el.getAttributeNumbers("max", m_emitterBoundingVolumeMax));
-	}
-
-	CString cstr;
-	ANKI_CHECK(rootEl.getChildElement("material", el));
-	ANKI_CHECK(el.getAttributeText("value", cstr));
-	ANKI_CHECK(ResourceManager::getSingleton().loadResource(cstr, m_material, async));
+	ResourceFilePtr file;
+	ANKI_CHECK(openFile(filename, file));
+	ResourceDescriptor<ParticleEmitterBinary> desc;
+	ANKI_CHECK(desc.load(*file));
+	const ParticleEmitterBinary& binary = desc.getBinary();
+
+#define ANKI_RANGE(varName, VarName) \
+	ANKI_CHECK(readVar(binary.m_##varName, #varName, m_particle.m_min##VarName, m_particle.m_max##VarName, &m_particle.m_min##VarName))
+
+	ANKI_RANGE(life, Life);
+	ANKI_RANGE(mass, Mass);
+	ANKI_RANGE(initialSize, InitialSize);
+	ANKI_RANGE(finalSize, FinalSize);
+	ANKI_RANGE(initialAlpha, InitialAlpha);
+	ANKI_RANGE(finalAlpha, FinalAlpha);
+	ANKI_RANGE(forceDirection, ForceDirection);
+	ANKI_RANGE(forceMagnitude, ForceMagnitude);
+	ANKI_RANGE(gravity, Gravity);
+	ANKI_RANGE(startingPosition, StartingPosition);
+
+#undef ANKI_RANGE
+
+	m_maxNumOfParticles = binary.m_maxNumOfParticles;
+	m_emissionPeriod = binary.m_emissionPeriod;
+	m_particlesPerEmission = binary.m_particlesPerEmission;
+	m_usePhysicsEngine = binary.m_usePhysicsEngine;
+	m_emitterBoundingVolumeMin =
+		Vec3(binary.m_emitterBoundingVolumeMin[0], binary.m_emitterBoundingVolumeMin[1], binary.m_emitterBoundingVolumeMin[2]);
+	m_emitterBoundingVolumeMax =
+		Vec3(binary.m_emitterBoundingVolumeMax[0], binary.m_emitterBoundingVolumeMax[1], binary.m_emitterBoundingVolumeMax[2]);
+
+	ANKI_CHECK(ResourceManager::getSingleton().loadResource(desc.getString(binary.m_materialOffset), m_material, async));
 
 	return Error::kNone;
 }
 
 template<typename T>
-Error ParticleEmitterResource::readVar(const XmlElement& rootEl, CString varName, T& minVal, T& maxVal, const T* defaultVal)
+Error ParticleEmitterResource::readVar(const ParticleEmitterBinaryRange& range, CString varName, T& minVal, T& maxVal, const T* defaultVal)
 {
-	XmlElement el;
-
 	// <varName>
-	ANKI_CHECK(rootEl.getChildElementOptional(varName, el));
-	if(!el && !defaultVal)
+	if(!range.m_present && !defaultVal)
 	{
 		ANKI_RESOURCE_LOGE("<%s> is missing", varName.cstr());
 		return Error::kUserData;
 	}
 
-	if(!el)
+	if(!range.m_present)
 	{
 		maxVal = minVal = *defaultVal;
 		return Error::kNone;
 	}
 
-	// value tag
-	Bool found;
-	ANKI_CHECK(getXmlVal(el, "value", minVal, found));
-	if(found)
-	{
-		maxVal = minVal;
-		return Error::kNone;
-	}
-
-	// min & max value tags
-	ANKI_CHECK(getXmlVal(el, "min", minVal, found));
-	if(!found)
-	{
-		ANKI_RESOURCE_LOGE("tag min is missing for <%s>", varName.cstr());
-		return Error::kUserData;
-	}
-
-	ANKI_CHECK(getXmlVal(el, "max", maxVal, found));
-	if(!found)
-	{
-		ANKI_RESOURCE_LOGE("tag max is missing for <%s>", varName.cstr());
-		return Error::kUserData;
-	}
+	getRangeVal(range.m_min, minVal);
+	getRangeVal(range.m_max, maxVal);
 
 	if(minVal > maxVal)
 	{
@@ -13,7 +13,7 @@
 
 namespace anki {
 
-class XmlElement;
+class ParticleEmitterBinaryRange;
 
 /// @addtogroup resource
 /// @{
@@ -127,10 +127,8 @@ private:
 	MaterialResourcePtr m_material;
 	U8 m_lodCount = 1; ///< Cache the value from the material
 
-	void loadInternal(const XmlElement& el);
-
 	template<typename T>
-	Error readVar(const XmlElement& rootEl, CString varName, T& minVal, T& maxVal, const T* defaultVal);
+	Error readVar(const ParticleEmitterBinaryRange& range, CString varName, T& minVal, T& maxVal, const T* defaultVal);
 };
 /// @}
 
@@ -0,0 +1,572 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Resource/ResourceDescriptor.h>
+#include <AnKi/Util/Xml.h>
+#include <AnKi/Util/File.h>
+#include <AnKi/Math.h>
+#include <cerrno>
+
+namespace anki {
+
+namespace {
+
+using CookerXmlDocument = XmlDocument<MemoryPoolPtrWrapper<BaseMemoryPool>>;
+
+/// Helps building a binary.
+class BinaryBuilder
+{
+public:
+	BaseMemoryPool* m_pool;
+	DynamicArray<Char, MemoryPoolPtrWrapper<BaseMemoryPool>> m_strings;
+
+	BinaryBuilder(BaseMemoryPool* pool)
+		: m_pool(pool)
+		, m_strings(pool)
+	{
+	}
+
+	template<typename TBinary>
+	TBinary* newBinary()
+	{
+		TBinary* binary = newInstance<TBinary>(*m_pool);
+		memcpy(&binary->m_magic[0], ResourceDescriptorTraits<TBinary>::kMagic, binary->m_magic.getSize());
+		return binary;
+	}
+
+	template<typename T>
+	WeakArray<T> newArray(U32 count)
+	{
+		T* arr = (count) ? static_cast<T*>(m_pool->allocate(sizeof(T) * count, alignof(T))) : nullptr;
+		for(U32 i = 0; i < count; ++i)
+		{
+			callConstructor(arr[i]);
+		}
+
+		return WeakArray<T>(arr, count);
+	}
+
+	U32 addString(CString str)
+	{
+		const U32 offset = m_strings.getSize();
+		for(Char c : str)
+		{
+			m_strings.emplaceBack(c);
+		}
+		m_strings.emplaceBack('\0');
+		return offset;
+	}
+
+	WeakArray<Char> finalizeStrings()
+	{
+		WeakArray<Char> out = newArray<Char>(m_strings.getSize());
+		if(m_strings.getSize())
+		{
+			memcpy(out.getBegin(), m_strings.getBegin(), m_strings.getSizeInBytes());
+		}
+		return out;
+	}
+};
+
+template<typename TBinary>
+Error parseXml(CString xmlText, CookerXmlDocument& doc, XmlElement& rootEl)
+{
+	ANKI_CHECK(doc.parse(xmlText));
+	ANKI_CHECK(doc.getChildElement(ResourceDescriptorTraits<TBinary>::kXmlRootElement, rootEl));
+	return Error::kNone;
+}
+
+U32 countSiblings(XmlElement firstEl)
+{
+	U32 count = 0;
+	if(firstEl)
+	{
+		[[maybe_unused]] const Error err = firstEl.getSiblingElementsCount(count);
+		++count;
+	}
+
+	return count;
+}
+
+/// Parse a list of numbers. Unlike the XmlElement it doesn't complain on failure.
+Bool parseNumbers(CString txt, DynamicArray<F64, MemoryPoolPtrWrapper<BaseMemoryPool>>& out)
+{
+	const Char* ptr = txt.cstr();
+	while(true)
+	{
+		while(*ptr == ' ')
+		{
+			++ptr;
+		}
+
+		if(*ptr == '\0')
+		{
+			break;
+		}
+
+		errno = 0;
+		Char* end;
+		const F64 number = std::strtod(ptr, &end);
+		if(end == ptr || errno || (*end != ' ' && *end != '\0'))
+		{
+			errno = 0;
+			return false;
+		}
+
+		out.emplaceBack(number);
+		ptr = end;
+	}
+
+	return out.getSize() > 0;
+}
+
+template<typename T>
+Error readRange(XmlElement rootEl, CString name, ParticleEmitterBinaryRange& range)
+{
+	XmlElement el;
+	ANKI_CHECK(rootEl.getChildElementOptional(name, el));
+	if(!el)
+	{
+		return Error::kNone;
+	}
+
+	range.m_present = true;
+
+	auto readValue = [&](CString attrib, Array<F64, 3>& out, Bool& found) -> Error {
+		T value;
+		if constexpr(std::is_same_v<T, Vec3>)
+		{
+			ANKI_CHECK(el.getAttributeNumbersOptional(attrib, value, found));
+			out = {value.x(), value.y(), value.z()};
+		}
+		else
+		{
+			ANKI_CHECK(el.getAttributeNumberOptional(attrib, value, found));
+			out = {F64(value), 0.0, 0.0};
+		}
+		return Error::kNone;
+	};
+
+	// value tag
+	Bool found;
+	ANKI_CHECK(readValue("value", range.m_min, found));
+	if(found)
+	{
+		range.m_max = range.m_min;
+		return Error::kNone;
+	}
+
+	// min & max value tags
+	ANKI_CHECK(readValue("min", range.m_min, found));
+	if(!found)
+	{
+		ANKI_RESOURCE_LOGE("tag min is missing for <%s>", name.cstr());
+		return Error::kUserData;
+	}
+
+	ANKI_CHECK(readValue("max", range.m_max, found));
+	if(!found)
+	{
+		ANKI_RESOURCE_LOGE("tag max is missing for <%s>", name.cstr());
+		return Error::kUserData;
+	}
+
+	return Error::kNone;
+}
+
+template<U32 kComponentCount>
+Error readKeyframes(XmlElement channelEl, CString keysName, DynamicArray<AnimationBinaryKeyframe, MemoryPoolPtrWrapper<BaseMemoryPool>>& keyframes,
+					U32& first, U32& count)
+{
+	XmlElement keysEl;
+	ANKI_CHECK(channelEl.getChildElementOptional(keysName, keysEl));
+	first = keyframes.getSize();
+	count = 0;
+	if(!keysEl)
+	{
+		return Error::kNone;
+	}
+
+	XmlElement keyEl;
+	ANKI_CHECK(keysEl.getChildElement("key", keyEl));
+	do
+	{
+		AnimationBinaryKeyframe& key = *keyframes.emplaceBack();
+		ANKI_CHECK(keyEl.getAttributeNumber("time", key.m_time));
+
+		if constexpr(kComponentCount == 1)
+		{
+			ANKI_CHECK(keyEl.getNumber(key.m_value[0]));
+		}
+		else
+		{
+			Array<F32, kComponentCount> value;
+			ANKI_CHECK(keyEl.getNumbers(value));
+			for(U32 i = 0; i < kComponentCount; ++i)
+			{
+				key.m_value[i] = value[i];
+			}
+		}
+
+		++count;
+		ANKI_CHECK(keyEl.getNextSiblingElement("key", keyEl));
+	} while(keyEl);
+
+	return Error::kNone;
+}
+
+} // namespace
+
+Error ResourceDescriptorCooker::cook(CString xmlText, MaterialBinary*& binary)
+{
+	CookerXmlDocument doc(m_pool);
+	XmlElement rootEl, el;
+	ANKI_CHECK(parseXml<MaterialBinary>(xmlText, doc, rootEl));
+
+	BinaryBuilder builder(m_pool);
+	binary = builder.newBinary<MaterialBinary>();
+
+	// <shaderProgram>
+	XmlElement shaderProgramEl;
+	ANKI_CHECK(rootEl.getChildElement("shaderProgram", shaderProgramEl));
+	CString shaderName;
+	ANKI_CHECK(shaderProgramEl.getAttributeText("name", shaderName));
+	binary->m_shaderProgramOffset = builder.addString(shaderName);
+
+	// <mutation>
+	XmlElement mutatorEl;
+	ANKI_CHECK(shaderProgramEl.getChildElementOptional("mutation", el));
+	if(el)
+	{
+		ANKI_CHECK(el.getChildElement("mutator", mutatorEl));
+	}
+
+	binary->m_mutations = builder.newArray<MaterialBinaryMutation>(countSiblings(mutatorEl));
+	for(MaterialBinaryMutation& mutation : binary->m_mutations)
+	{
+		CString name;
+		ANKI_CHECK(mutatorEl.getAttributeText("name", name));
+		mutation.m_nameOffset = builder.addString(name);
+		ANKI_CHECK(mutatorEl.getAttributeNumber("value", mutation.m_value));
+
+		ANKI_CHECK(mutatorEl.getNextSiblingElement("mutator", mutatorEl));
+	}
+
+	// <inputs>
+	XmlElement inputEl;
+	ANKI_CHECK(rootEl.getChildElementOptional("inputs", el));
+	if(el)
+	{
+		ANKI_CHECK(el.getChildElement("input", inputEl));
+	}
+
+	DynamicArray<F64, MemoryPoolPtrWrapper<BaseMemoryPool>> numbers(m_pool);
+	binary->m_inputs = builder.newArray<MaterialBinaryInput>(countSiblings(inputEl));
+	for(MaterialBinaryInput& input : binary->m_inputs)
+	{
+		CString name;
+		ANKI_CHECK(inputEl.getAttributeText("name", name));
+		input.m_nameOffset = builder.addString(name);
+
+		// The type of the input is known only after the shader program is loaded so keep the value both as text and as numbers
+		CString value;
+		ANKI_CHECK(inputEl.getAttributeText("value", value));
+		input.m_valueOffset = builder.addString(value);
+
+		input.m_firstNumber = numbers.getSize();
+		if(parseNumbers(value, numbers))
+		{
+			input.m_numberCount = numbers.getSize() - input.m_firstNumber;
+		}
+		else
+		{
+			numbers.resize(input.m_firstNumber);
+		}
+
+		ANKI_CHECK(inputEl.getNextSiblingElement("input", inputEl));
+	}
+
+	binary->m_numbers = builder.newArray<F64>(numbers.getSize());
+	if(numbers.getSize())
+	{
+		memcpy(binary->m_numbers.getBegin(), numbers.getBegin(), numbers.getSizeInBytes());
+	}
+
+	binary->m_strings = builder.finalizeStrings();
+	return Error::kNone;
+}
+
+Error ResourceDescriptorCooker::cook(CString xmlText, ModelBinary*& binary)
+{
+	CookerXmlDocument doc(m_pool);
+	XmlElement rootEl;
+	ANKI_CHECK(parseXml<ModelBinary>(xmlText, doc, rootEl));
+
+	BinaryBuilder builder(m_pool);
+	binary = builder.newBinary<ModelBinary>();
+
+	// <modelPatches>
+	XmlElement modelPatchesEl, modelPatchEl;
+	ANKI_CHECK(rootEl.getChildElement("modelPatches", modelPatchesEl));
+	ANKI_CHECK(modelPatchesEl.getChildElement("modelPatch", modelPatchEl));
+
+	binary->m_patches = builder.newArray<ModelBinaryPatch>(countSiblings(modelPatchEl));
+	for(ModelBinaryPatch& patch : binary->m_patches)
+	{
+		XmlElement meshEl;
+		ANKI_CHECK(modelPatchEl.getChildElement("mesh", meshEl));
+		CString meshFname;
+		ANKI_CHECK(meshEl.getText(meshFname));
+		patch.m_meshOffset = builder.addString(meshFname);
+
+		Bool subMeshIndexPresent;
+		ANKI_CHECK(meshEl.getAttributeNumberOptional("subMeshIndex", patch.m_subMeshIndex, subMeshIndexPresent));
+		if(!subMeshIndexPresent)
+		{
+			patch.m_subMeshIndex = kMaxU32;
+		}
+
+		XmlElement materialEl;
+		ANKI_CHECK(modelPatchEl.getChildElement("material", materialEl));
+		CString mtlFname;
+		ANKI_CHECK(materialEl.getText(mtlFname));
+		patch.m_materialOffset = builder.addString(mtlFname);
+
+		ANKI_CHECK(modelPatchEl.getNextSiblingElement("modelPatch", modelPatchEl));
+	}
+
+	binary->m_strings = builder.finalizeStrings();
+	return Error::kNone;
+}
+
+Error ResourceDescriptorCooker::cook(CString xmlText, ParticleEmitterBinary*& binary)
+{
+	CookerXmlDocument doc(m_pool);
+	XmlElement rootEl, el;
+	ANKI_CHECK(parseXml<ParticleEmitterBinary>(xmlText, doc, rootEl));
+
+	BinaryBuilder builder(m_pool);
+	binary = builder.newBinary<ParticleEmitterBinary>();
+
+	ANKI_CHECK(readRange<Second>(rootEl, "life", binary->m_life));
+	ANKI_CHECK(readRange<F32>(rootEl, "mass", binary->m_mass));
+	ANKI_CHECK(readRange<F32>(rootEl, "initialSize", binary->m_initialSize));
+	ANKI_CHECK(readRange<F32>(rootEl, "finalSize", binary->m_finalSize));
+	ANKI_CHECK(readRange<F32>(rootEl, "initialAlpha", binary->m_initialAlpha));
+	ANKI_CHECK(readRange<F32>(rootEl, "finalAlpha", binary->m_finalAlpha));
+	ANKI_CHECK(readRange<Vec3>(rootEl, "forceDirection", binary->m_forceDirection));
+	ANKI_CHECK(readRange<F32>(rootEl, "forceMagnitude", binary->m_forceMagnitude));
+	ANKI_CHECK(readRange<Vec3>(rootEl, "gravity", binary->m_gravity));
+	ANKI_CHECK(readRange<Vec3>(rootEl, "startingPosition", binary->m_startingPosition));
+
+	ANKI_CHECK(rootEl.getChildElement("maxNumberOfParticles", el));
+	ANKI_CHECK(el.getAttributeNumber("value", binary->m_maxNumOfParticles));
+
+	ANKI_CHECK(rootEl.getChildElement("emissionPeriod", el));
+	ANKI_CHECK(el.getAttributeNumber("value", binary->m_emissionPeriod));
+
+	ANKI_CHECK(rootEl.getChildElement("particlesPerEmission", el));
+	ANKI_CHECK(el.getAttributeNumber("value", binary->m_particlesPerEmission));
+
+	ANKI_CHECK(rootEl.getChildElementOptional("usePhysicsEngine", el));
+	if(el)
+	{
+		U32 usePhysicsEngine;
+		ANKI_CHECK(el.getAttributeNumber("value", usePhysicsEngine));
+		binary->m_usePhysicsEngine = usePhysicsEngine != 0;
+	}
+
+	ANKI_CHECK(rootEl.getChildElementOptional("emitterBoundingVolume", el));
+	if(el)
+	{
+		ANKI_CHECK(el.getAttributeNumbers("min", binary->m_emitterBoundingVolumeMin));
+		ANKI_CHECK(el.getAttributeNumbers("max", binary->m_emitterBoundingVolumeMax));
+	}
+
+	CString cstr;
+	ANKI_CHECK(rootEl.getChildElement("material", el));
+	ANKI_CHECK(el.getAttributeText("value", cstr));
+	binary->m_materialOffset = builder.addString(cstr);
+
+	binary->m_strings = builder.finalizeStrings();
+	return Error::kNone;
+}
+
+Error ResourceDescriptorCooker::cook(CString xmlText, SkeletonBinary*& binary)
+{
+	CookerXmlDocument doc(m_pool);
+	XmlElement rootEl;
+	ANKI_CHECK(parseXml<SkeletonBinary>(xmlText, doc, rootEl));
+
+	BinaryBuilder builder(m_pool);
+	binary = builder.newBinary<SkeletonBinary>();
+
+	// <bones>
+	XmlElement bonesEl, boneEl;
+	ANKI_CHECK(rootEl.getChildElement("bones", bonesEl));
+	ANKI_CHECK(bonesEl.getChildElement("bone", boneEl));
+
+	binary->m_bones = builder.newArray<SkeletonBinaryBone>(countSiblings(boneEl));
+	for(SkeletonBinaryBone& bone : binary->m_bones)
+	{
+		CString name;
+		ANKI_CHECK(boneEl.getAttributeText("name", name));
+		bone.m_nameOffset = builder.addString(name);
+
+		ANKI_CHECK(boneEl.getAttributeNumbers("transform", bone.m_transform));
+		ANKI_CHECK(boneEl.getAttributeNumbers("boneTransform", bone.m_boneTransform));
+
+		CString parent;
+		Bool hasParent;
+		ANKI_CHECK(boneEl.getAttributeTextOptional("parent", parent, hasParent));
+		if(hasParent)
+		{
+			bone.m_parentOffset = builder.addString(parent);
+		}
+
+		ANKI_CHECK(boneEl.getNextSiblingElement("bone", boneEl));
+	}
+
+	binary->m_strings = builder.finalizeStrings();
+	return Error::kNone;
+}
+
+Error ResourceDescriptorCooker::cook(CString xmlText, AnimationBinary*& binary)
+{
+	CookerXmlDocument doc(m_pool);
+	XmlElement rootEl;
+	ANKI_CHECK(parseXml<AnimationBinary>(xmlText, doc, rootEl));
+
+	BinaryBuilder builder(m_pool);
+	binary = builder.newBinary<AnimationBinary>();
+
+	// <channels>
+	XmlElement channelsEl, channelEl;
+	ANKI_CHECK(rootEl.getChildElement("channels", channelsEl));
+	ANKI_CHECK(channelsEl.getChildElement("channel", channelEl));
+
+	DynamicArray<AnimationBinaryKeyframe, MemoryPoolPtrWrapper<BaseMemoryPool>> keyframes(m_pool);
+	binary->m_channels = builder.newArray<AnimationBinaryChannel>(countSiblings(channelEl));
+	for(AnimationBinaryChannel& channel : binary->m_channels)
+	{
+		CString name;
+		ANKI_CHECK(channelEl.getAttributeText("name", name));
+		channel.m_nameOffset = builder.addString(name);
+
+		ANKI_CHECK(readKeyframes<3>(channelEl, "positionKeys", keyframes, channel.m_firstPositionKey, channel.m_positionKeyCount));
+		ANKI_CHECK(readKeyframes<4>(channelEl, "rotationKeys", keyframes, channel.m_firstRotationKey, channel.m_rotationKeyCount));
+		ANKI_CHECK(readKeyframes<1>(channelEl, "scaleKeys", keyframes, channel.m_firstScaleKey, channel.m_scaleKeyCount));
+
+		ANKI_CHECK(channelEl.getNextSiblingElement("channel", channelEl));
+	}
+
+	binary->m_keyframes = builder.newArray<AnimationBinaryKeyframe>(keyframes.getSize());
+	if(keyframes.getSize())
+	{
+		memcpy(binary->m_keyframes.getBegin(), keyframes.getBegin(), keyframes.getSizeInBytes());
+	}
+
+	binary->m_strings = builder.finalizeStrings();
+	return Error::kNone;
+}
+
+Error ResourceDescriptorCooker::cook(CString xmlText, ImageAtlasBinary*& binary)
+{
+	CookerXmlDocument doc(m_pool);
+	XmlElement rootEl, el;
+	ANKI_CHECK(parseXml<ImageAtlasBinary>(xmlText, doc, rootEl));
+
+	BinaryBuilder builder(m_pool);
+	binary = builder.newBinary<ImageAtlasBinary>();
+
+	// <image>
+	ANKI_CHECK(rootEl.getChildElement("image", el));
+	CString texFname;
+	ANKI_CHECK(el.getText(texFname));
+	binary->m_imageOffset = builder.addString(texFname);
+
+	// <subImageMargin>
+	ANKI_CHECK(rootEl.getChildElement("subImageMargin", el));
+	ANKI_CHECK(el.getNumber(binary->m_subImageMargin));
+
+	// <subImages>
+	XmlElement subTexesEl, subTexEl;
+	ANKI_CHECK(rootEl.getChildElement("subImages", subTexesEl));
+	ANKI_CHECK(subTexesEl.getChildElement("subImage", subTexEl));
+
+	binary->m_subImages = builder.newArray<ImageAtlasBinarySubImage>(countSiblings(subTexEl));
+	for(ImageAtlasBinarySubImage& subImage : binary->m_subImages)
+	{
+		ANKI_CHECK(subTexEl.getChildElement("name", el));
+		CString name;
+		ANKI_CHECK(el.getText(name));
+		if(name.getLength() < 1)
+		{
+			ANKI_RESOURCE_LOGE("Something wrong with the <name> tag. Probably empty");
+			return Error::kUserData;
+		}
+		subImage.m_nameOffset = builder.addString(name);
+
+		ANKI_CHECK(subTexEl.getChildElement("uv", el));
+		ANKI_CHECK(el.getNumbers(subImage.m_uv));
+
+		ANKI_CHECK(subTexEl.getNextSiblingElement("subImage", subTexEl));
+	}
+
+	binary->m_strings = builder.finalizeStrings();
+	return Error::kNone;
+}
+
+Error ResourceDescriptorCooker::cookFile(CString inFilename, CString outFilename)
+{
+	File inFile;
+	ANKI_CHECK(inFile.open(inFilename, FileOpenFlag::kRead));
+	BaseString<MemoryPoolPtrWrapper<BaseMemoryPool>> xmlText(m_pool);
+	ANKI_CHECK(inFile.readAllText(xmlText));
+	inFile.close();
+
+	// Find the type from the root element
+	CookerXmlDocument doc(m_pool);
+	ANKI_CHECK(doc.parse(xmlText.toCString()));
+
+	Bool cooked = false;
+	auto tryCook = [&](auto* binary) -> Error {
+		using TBinary = std::remove_pointer_t<decltype(binary)>;
+
+		XmlElement rootEl;
+		ANKI_CHECK(doc.getChildElementOptional(ResourceDescriptorTraits<TBinary>::kXmlRootElement, rootEl));
+		if(cooked || !rootEl)
+		{
+			return Error::kNone;
+		}
+
+		ANKI_CHECK(cook(xmlText.toCString(), binary));
+
+		File outFile;
+		ANKI_CHECK(outFile.open(outFilename, FileOpenFlag::kWrite | FileOpenFlag::kBinary));
+		BinarySerializer serializer;
+		ANKI_CHECK(serializer.serialize(*binary, *m_pool, outFile));
+
+		cooked = true;
+		return Error::kNone;
+	};
+
+	ANKI_CHECK(tryCook(static_cast<MaterialBinary*>(nullptr)));
+	ANKI_CHECK(tryCook(static_cast<ModelBinary*>(nullptr)));
+	ANKI_CHECK(tryCook(static_cast<ParticleEmitterBinary*>(nullptr)));
+	ANKI_CHECK(tryCook(static_cast<SkeletonBinary*>(nullptr)));
+	ANKI_CHECK(tryCook(static_cast<AnimationBinary*>(nullptr)));
+	ANKI_CHECK(tryCook(static_cast<ImageAtlasBinary*>(nullptr)));
+
+	if(!cooked)
+	{
+		ANKI_RESOURCE_LOGE("%s is not a resource descriptor", inFilename.cstr());
+		return Error::kUserData;
+	}
+
+	return Error::kNone;
+}
+
+} // end namespace anki
@@ -0,0 +1,157 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Resource/ResourceDescriptorBinary.h>
+#include <AnKi/Resource/ResourceFilesystem.h>
+#include <AnKi/Util/MemoryPool.h>
+#include <AnKi/Util/Serializer.h>
+
+namespace anki {
+
+/// @addtogroup resource
+/// @{
+
+/// Information about the binary form of a descriptor.
+template<typename TBinary>
+class ResourceDescriptorTraits;
+
+#define ANKI_RESOURCE_DESCRIPTOR_TRAITS(type, magic, rootElement) \
+	template<> \
+	class ResourceDescriptorTraits<type> \
+	{ \
+	public: \
+		static constexpr const char* kMagic = magic; \
+		static constexpr const char* kXmlRootElement = rootElement; \
+	};
+
+ANKI_RESOURCE_DESCRIPTOR_TRAITS(MaterialBinary, kMaterialBinaryMagic, "material")
+ANKI_RESOURCE_DESCRIPTOR_TRAITS(ModelBinary, kModelBinaryMagic, "model")
+ANKI_RESOURCE_DESCRIPTOR_TRAITS(ParticleEmitterBinary, kParticleEmitterBinaryMagic, "particleEmitter")
+ANKI_RESOURCE_DESCRIPTOR_TRAITS(SkeletonBinary, kSkeletonBinaryMagic, "skeleton")
+ANKI_RESOURCE_DESCRIPTOR_TRAITS(AnimationBinary, kAnimationBinaryMagic, "animation")
+ANKI_RESOURCE_DESCRIPTOR_TRAITS(ImageAtlasBinary, kImageAtlasBinaryMagic, "imageAtlas")
+
+#undef ANKI_RESOURCE_DESCRIPTOR_TRAITS
+
+/// Compiles the XML descriptors of the resources (materials, models, particle emitters, skeletons, animations and image atlases) to their binary
+/// form. The resources use it when they load XML descriptors and the ResourceCooker tool uses it to compile the descriptors offline.
+class ResourceDescriptorCooker
+{
+public:
+	/// @param pool The binaries are allocated from that pool and they are never freed. It should be something like a StackMemoryPool.
+	ResourceDescriptorCooker(BaseMemoryPool& pool)
+		: m_pool(&pool)
+	{
+	}
+
+	/// Cook the text of an XML descriptor. The binary will point to memory allocated from the pool.
+	Error cook(CString xmlText, MaterialBinary*& binary);
+
+	/// @copydoc cook(CString, MaterialBinary*&)
+	Error cook(CString xmlText, ModelBinary*& binary);
+
+	/// @copydoc cook(CString, MaterialBinary*&)
+	Error cook(CString xmlText, ParticleEmitterBinary*& binary);
+
+	/// @copydoc cook(CString, MaterialBinary*&)
+	Error cook(CString xmlText, SkeletonBinary*& binary);
+
+	/// @copydoc cook(CString, MaterialBinary*&)
+	Error cook(CString xmlText, AnimationBinary*& binary);
+
+	/// @copydoc cook(CString, MaterialBinary*&)
+	Error cook(CString xmlText, ImageAtlasBinary*& binary);
+
+	/// Cook an XML descriptor file and write the binary to another file. The type of the descriptor is deduced from the root element.
+	Error cookFile(CString inFilename, CString outFilename);
+
+private:
+	BaseMemoryPool* m_pool;
+};
+
+/// A resource descriptor that was loaded from a file. If the file contains a cooked binary the binary is used in place without parsing or
+/// copying anything. If the file contains XML it's cooked on the fly.
+template<typename TBinary>
+class ResourceDescriptor
+{
+public:
+	ResourceDescriptor()
+		: m_pool(ResourceMemoryPool::getSingleton().getAllocationCallback(), ResourceMemoryPool::getSingleton().getAllocationCallbackUserData(), 4_KB)
+	{
+	}
+
+	ResourceDescriptor(const ResourceDescriptor&) = delete; // Non-copyable
+
+	ResourceDescriptor& operator=(const ResourceDescriptor&) = delete; // Non-copyable
+
+	Error load(ResourceFile& file);
+
+	const TBinary& getBinary() const
+	{
+		ANKI_ASSERT(m_binary);
+		return *m_binary;
+	}
+
+	/// Get a string of the TBinary::m_strings.
+	CString getString(U32 offset) const
+	{
+		ANKI_ASSERT(offset < m_binary->m_strings.getSize());
+		return &m_binary->m_strings[offset];
+	}
+
+	/// True if the file was a cooked binary.
+	Bool isCooked() const
+	{
+		return m_cooked;
+	}
+
+private:
+	StackMemoryPool m_pool;
+	TBinary* m_binary = nullptr;
+	Bool m_cooked = false;
+};
+
+template<typename TBinary>
+Error ResourceDescriptor<TBinary>::load(ResourceFile& file)
+{
+	ANKI_ASSERT(!m_binary);
+
+	// Read the whole file with one read. Leave space for the null terminator of the XML text
+	const PtrSize size = file.getSize();
+	U8* data = static_cast<U8*>(m_pool.allocate(size + 1, ANKI_SAFE_ALIGNMENT));
+	ANKI_CHECK(file.read(data, size));
+	data[size] = 0;
+
+	if(BinaryDeserializer::isSerializedBinary(ConstWeakArray<U8, PtrSize>(data, size)))
+	{
+		ANKI_CHECK(BinaryDeserializer::deserializeInPlace(m_binary, WeakArray<U8, PtrSize>(data, size)));
+
+		if(memcmp(&m_binary->m_magic[0], ResourceDescriptorTraits<TBinary>::kMagic, m_binary->m_magic.getSize()) != 0)
+		{
+			ANKI_RESOURCE_LOGE("The binary is not a %s descriptor", ResourceDescriptorTraits<TBinary>::kXmlRootElement);
+			return Error::kUserData;
+		}
+
+		if(m_binary->m_strings.getSize() && m_binary->m_strings.getBack() != '\0')
+		{
+			ANKI_RESOURCE_LOGE("Corrupt strings");
+			return Error::kUserData;
+		}
+
+		m_cooked = true;
+	}
+	else
+	{
+		ResourceDescriptorCooker cooker(m_pool);
+		ANKI_CHECK(cooker.cook(CString(reinterpret_cast<const Char*>(data)), m_binary));
+	}
+
+	return Error::kNone;
+}
+/// @}
+
+} // end namespace anki
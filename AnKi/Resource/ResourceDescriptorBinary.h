@@ -0,0 +1,543 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+// WARNING: This file is auto generated.
+
+#pragma once
+
+#include <AnKi/Util/StdTypes.h>
+#include <AnKi/Util/Array.h>
+#include <AnKi/Util/WeakArray.h>
+
+namespace anki {
+
+/// @addtogroup resource
+/// @{
+
+inline constexpr const char* kMaterialBinaryMagic = "ANKIMTL1";
+inline constexpr const char* kModelBinaryMagic = "ANKIMDL1";
+inline constexpr const char* kParticleEmitterBinaryMagic = "ANKIPEM1";
+inline constexpr const char* kSkeletonBinaryMagic = "ANKISKL1";
+inline constexpr const char* kAnimationBinaryMagic = "ANKIANI1";
+inline constexpr const char* kImageAtlasBinaryMagic = "ANKIATL1";
+
+/// A mutator value of a material.
+class MaterialBinaryMutation
+{
+public:
+	/// Points to MaterialBinary::m_strings.
+	U32 m_nameOffset = kMaxU32;
+
+	I32 m_value = 0;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doValue("m_nameOffset", offsetof(MaterialBinaryMutation, m_nameOffset), self.m_nameOffset);
+		s.doValue("m_value", offsetof(MaterialBinaryMutation, m_value), self.m_value);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, MaterialBinaryMutation&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const MaterialBinaryMutation&>(serializer, *this);
+	}
+};
+
+/// The value of an input of a material.
+class MaterialBinaryInput
+{
+public:
+	/// Points to MaterialBinary::m_strings.
+	U32 m_nameOffset = kMaxU32;
+
+	/// The value as text. Points to MaterialBinary::m_strings. Used for the images.
+	U32 m_valueOffset = kMaxU32;
+
+	/// Points to MaterialBinary::m_numbers.
+	U32 m_firstNumber = 0;
+
+	/// It's zero if the value is not a list of numbers.
+	U32 m_numberCount = 0;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doValue("m_nameOffset", offsetof(MaterialBinaryInput, m_nameOffset), self.m_nameOffset);
+		s.doValue("m_valueOffset", offsetof(MaterialBinaryInput, m_valueOffset), self.m_valueOffset);
+		s.doValue("m_firstNumber", offsetof(MaterialBinaryInput, m_firstNumber), self.m_firstNumber);
+		s.doValue("m_numberCount", offsetof(MaterialBinaryInput, m_numberCount), self.m_numberCount);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, MaterialBinaryInput&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const MaterialBinaryInput&>(serializer, *this);
+	}
+};
+
+/// The binary form of a material descriptor.
+class MaterialBinary
+{
+public:
+	Array<U8, 8> m_magic = {};
+
+	/// The name of the shader program. Points to m_strings.
+	U32 m_shaderProgramOffset = kMaxU32;
+
+	WeakArray<MaterialBinaryMutation> m_mutations;
+	WeakArray<MaterialBinaryInput> m_inputs;
+
+	/// The numeric values of all the inputs.
+	WeakArray<F64> m_numbers;
+
+	/// Null terminated strings one after the other.
+	WeakArray<Char> m_strings;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doArray("m_magic", offsetof(MaterialBinary, m_magic), &self.m_magic[0], self.m_magic.getSize());
+		s.doValue("m_shaderProgramOffset", offsetof(MaterialBinary, m_shaderProgramOffset), self.m_shaderProgramOffset);
+		s.doValue("m_mutations", offsetof(MaterialBinary, m_mutations), self.m_mutations);
+		s.doValue("m_inputs", offsetof(MaterialBinary, m_inputs), self.m_inputs);
+		s.doValue("m_numbers", offsetof(MaterialBinary, m_numbers), self.m_numbers);
+		s.doValue("m_strings", offsetof(MaterialBinary, m_strings), self.m_strings);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, MaterialBinary&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const MaterialBinary&>(serializer, *this);
+	}
+};
+
+/// A model patch.
+class ModelBinaryPatch
+{
+public:
+	/// Points to ModelBinary::m_strings.
+	U32 m_meshOffset = kMaxU32;
+
+	/// Points to ModelBinary::m_strings.
+	U32 m_materialOffset = kMaxU32;
+
+	/// If it's kMaxU32 the patch uses the whole mesh.
+	U32 m_subMeshIndex = kMaxU32;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doValue("m_meshOffset", offsetof(ModelBinaryPatch, m_meshOffset), self.m_meshOffset);
+		s.doValue("m_materialOffset", offsetof(ModelBinaryPatch, m_materialOffset), self.m_materialOffset);
+		s.doValue("m_subMeshIndex", offsetof(ModelBinaryPatch, m_subMeshIndex), self.m_subMeshIndex);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, ModelBinaryPatch&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const ModelBinaryPatch&>(serializer, *this);
+	}
+};
+
+/// The binary form of a model descriptor.
+class ModelBinary
+{
+public:
+	Array<U8, 8> m_magic = {};
+	WeakArray<ModelBinaryPatch> m_patches;
+
+	/// Null terminated strings one after the other.
+	WeakArray<Char> m_strings;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doArray("m_magic", offsetof(ModelBinary, m_magic), &self.m_magic[0], self.m_magic.getSize());
+		s.doValue("m_patches", offsetof(ModelBinary, m_patches), self.m_patches);
+		s.doValue("m_strings", offsetof(ModelBinary, m_strings), self.m_strings);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, ModelBinary&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const ModelBinary&>(serializer, *this);
+	}
+};
+
+/// A property of the particles that is randomized in a range. Scalars use only the first component.
+class ParticleEmitterBinaryRange
+{
+public:
+	Array<F64, 3> m_min = {};
+	Array<F64, 3> m_max = {};
+
+	/// If it's false the default value will be used.
+	Bool m_present = false;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doArray("m_min", offsetof(ParticleEmitterBinaryRange, m_min), &self.m_min[0], self.m_min.getSize());
+		s.doArray("m_max", offsetof(ParticleEmitterBinaryRange, m_max), &self.m_max[0], self.m_max.getSize());
+		s.doValue("m_present", offsetof(ParticleEmitterBinaryRange, m_present), self.m_present);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, ParticleEmitterBinaryRange&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const ParticleEmitterBinaryRange&>(serializer, *this);
+	}
+};
+
+/// The binary form of a particle emitter descriptor.
+class ParticleEmitterBinary
+{
+public:
+	Array<U8, 8> m_magic = {};
+	ParticleEmitterBinaryRange m_life;
+	ParticleEmitterBinaryRange m_mass;
+	ParticleEmitterBinaryRange m_initialSize;
+	ParticleEmitterBinaryRange m_finalSize;
+	ParticleEmitterBinaryRange m_initialAlpha;
+	ParticleEmitterBinaryRange m_finalAlpha;
+	ParticleEmitterBinaryRange m_forceDirection;
+	ParticleEmitterBinaryRange m_forceMagnitude;
+	ParticleEmitterBinaryRange m_gravity;
+	ParticleEmitterBinaryRange m_startingPosition;
+	U32 m_maxNumOfParticles = 0;
+	U32 m_particlesPerEmission = 0;
+	F32 m_emissionPeriod = 0.0f;
+	Array<F32, 3> m_emitterBoundingVolumeMin = {};
+	Array<F32, 3> m_emitterBoundingVolumeMax = {};
+	Bool m_usePhysicsEngine = false;
+
+	/// Points to m_strings.
+	U32 m_materialOffset = kMaxU32;
+
+	/// Null terminated strings one after the other.
+	WeakArray<Char> m_strings;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doArray("m_magic", offsetof(ParticleEmitterBinary, m_magic), &self.m_magic[0], self.m_magic.getSize());
+		s.doValue("m_life", offsetof(ParticleEmitterBinary, m_life), self.m_life);
+		s.doValue("m_mass", offsetof(ParticleEmitterBinary, m_mass), self.m_mass);
+		s.doValue("m_initialSize", offsetof(ParticleEmitterBinary, m_initialSize), self.m_initialSize);
+		s.doValue("m_finalSize", offsetof(ParticleEmitterBinary, m_finalSize), self.m_finalSize);
+		s.doValue("m_initialAlpha", offsetof(ParticleEmitterBinary, m_initialAlpha), self.m_initialAlpha);
+		s.doValue("m_finalAlpha", offsetof(ParticleEmitterBinary, m_finalAlpha), self.m_finalAlpha);
+		s.doValue("m_forceDirection", offsetof(ParticleEmitterBinary, m_forceDirection), self.m_forceDirection);
+		s.doValue("m_forceMagnitude", offsetof(ParticleEmitterBinary, m_forceMagnitude), self.m_forceMagnitude);
+		s.doValue("m_gravity", offsetof(ParticleEmitterBinary, m_gravity), self.m_gravity);
+		s.doValue("m_startingPosition", offsetof(ParticleEmitterBinary, m_startingPosition), self.m_startingPosition);
+		s.doValue("m_maxNumOfParticles", offsetof(ParticleEmitterBinary, m_maxNumOfParticles), self.m_maxNumOfParticles);
+		s.doValue("m_particlesPerEmission", offsetof(ParticleEmitterBinary, m_particlesPerEmission), self.m_particlesPerEmission);
+		s.doValue("m_emissionPeriod", offsetof(ParticleEmitterBinary, m_emissionPeriod), self.m_emissionPeriod);
+		s.doArray("m_emitterBoundingVolumeMin", offsetof(ParticleEmitterBinary, m_emitterBoundingVolumeMin), &self.m_emitterBoundingVolumeMin[0],
+				  self.m_emitterBoundingVolumeMin.getSize());
+		s.doArray("m_emitterBoundingVolumeMax", offsetof(ParticleEmitterBinary, m_emitterBoundingVolumeMax), &self.m_emitterBoundingVolumeMax[0],
+				  self.m_emitterBoundingVolumeMax.getSize());
+		s.doValue("m_usePhysicsEngine", offsetof(ParticleEmitterBinary, m_usePhysicsEngine), self.m_usePhysicsEngine);
+		s.doValue("m_materialOffset", offsetof(ParticleEmitterBinary, m_materialOffset), self.m_materialOffset);
+		s.doValue("m_strings", offsetof(ParticleEmitterBinary, m_strings), self.m_strings);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, ParticleEmitterBinary&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const ParticleEmitterBinary&>(serializer, *this);
+	}
+};
+
+/// A bone of a skeleton.
+class SkeletonBinaryBone
+{
+public:
+	/// A 3x4 matrix in row major order.
+	Array<F32, 12> m_transform = {};
+
+	/// A 3x4 matrix in row major order.
+	Array<F32, 12> m_boneTransform = {};
+
+	/// Points to SkeletonBinary::m_strings.
+	U32 m_nameOffset = kMaxU32;
+
+	/// The name of the parent. Points to SkeletonBinary::m_strings. If it's kMaxU32 this is the root bone.
+	U32 m_parentOffset = kMaxU32;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doArray("m_transform", offsetof(SkeletonBinaryBone, m_transform), &self.m_transform[0], self.m_transform.getSize());
+		s.doArray("m_boneTransform", offsetof(SkeletonBinaryBone, m_boneTransform), &self.m_boneTransform[0], self.m_boneTransform.getSize());
+		s.doValue("m_nameOffset", offsetof(SkeletonBinaryBone, m_nameOffset), self.m_nameOffset);
+		s.doValue("m_parentOffset", offsetof(SkeletonBinaryBone, m_parentOffset), self.m_parentOffset);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, SkeletonBinaryBone&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const SkeletonBinaryBone&>(serializer, *this);
+	}
+};
+
+/// The binary form of a skeleton descriptor.
+class SkeletonBinary
+{
+public:
+	Array<U8, 8> m_magic = {};
+	WeakArray<SkeletonBinaryBone> m_bones;
+
+	/// Null terminated strings one after the other.
+	WeakArray<Char> m_strings;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doArray("m_magic", offsetof(SkeletonBinary, m_magic), &self.m_magic[0], self.m_magic.getSize());
+		s.doValue("m_bones", offsetof(SkeletonBinary, m_bones), self.m_bones);
+		s.doValue("m_strings", offsetof(SkeletonBinary, m_strings), self.m_strings);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, SkeletonBinary&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const SkeletonBinary&>(serializer, *this);
+	}
+};
+
+/// A keyframe of an animation channel. Positions use 3 components, rotations 4 and scales 1.
+class AnimationBinaryKeyframe
+{
+public:
+	F64 m_time = 0.0;
+	Array<F32, 4> m_value = {};
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doValue("m_time", offsetof(AnimationBinaryKeyframe, m_time), self.m_time);
+		s.doArray("m_value", offsetof(AnimationBinaryKeyframe, m_value), &self.m_value[0], self.m_value.getSize());
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, AnimationBinaryKeyframe&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const AnimationBinaryKeyframe&>(serializer, *this);
+	}
+};
+
+/// An animation channel.
+class AnimationBinaryChannel
+{
+public:
+	/// Points to AnimationBinary::m_strings.
+	U32 m_nameOffset = kMaxU32;
+
+	/// Points to AnimationBinary::m_keyframes.
+	U32 m_firstPositionKey = 0;
+
+	U32 m_positionKeyCount = 0;
+
+	/// Points to AnimationBinary::m_keyframes.
+	U32 m_firstRotationKey = 0;
+
+	U32 m_rotationKeyCount = 0;
+
+	/// Points to AnimationBinary::m_keyframes.
+	U32 m_firstScaleKey = 0;
+
+	U32 m_scaleKeyCount = 0;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doValue("m_nameOffset", offsetof(AnimationBinaryChannel, m_nameOffset), self.m_nameOffset);
+		s.doValue("m_firstPositionKey", offsetof(AnimationBinaryChannel, m_firstPositionKey), self.m_firstPositionKey);
+		s.doValue("m_positionKeyCount", offsetof(AnimationBinaryChannel, m_positionKeyCount), self.m_positionKeyCount);
+		s.doValue("m_firstRotationKey", offsetof(AnimationBinaryChannel, m_firstRotationKey), self.m_firstRotationKey);
+		s.doValue("m_rotationKeyCount", offsetof(AnimationBinaryChannel, m_rotationKeyCount), self.m_rotationKeyCount);
+		s.doValue("m_firstScaleKey", offsetof(AnimationBinaryChannel, m_firstScaleKey), self.m_firstScaleKey);
+		s.doValue("m_scaleKeyCount", offsetof(AnimationBinaryChannel, m_scaleKeyCount), self.m_scaleKeyCount);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, AnimationBinaryChannel&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const AnimationBinaryChannel&>(serializer, *this);
+	}
+};
+
+/// The binary form of an animation descriptor.
+class AnimationBinary
+{
+public:
+	Array<U8, 8> m_magic = {};
+	WeakArray<AnimationBinaryChannel> m_channels;
+	WeakArray<AnimationBinaryKeyframe> m_keyframes;
+
+	/// Null terminated strings one after the other.
+	WeakArray<Char> m_strings;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doArray("m_magic", offsetof(AnimationBinary, m_magic), &self.m_magic[0], self.m_magic.getSize());
+		s.doValue("m_channels", offsetof(AnimationBinary, m_channels), self.m_channels);
+		s.doValue("m_keyframes", offsetof(AnimationBinary, m_keyframes), self.m_keyframes);
+		s.doValue("m_strings", offsetof(AnimationBinary, m_strings), self.m_strings);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, AnimationBinary&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const AnimationBinary&>(serializer, *this);
+	}
+};
+
+/// A sub-image of an image atlas.
+class ImageAtlasBinarySubImage
+{
+public:
+	Array<F32, 4> m_uv = {};
+
+	/// Points to ImageAtlasBinary::m_strings.
+	U32 m_nameOffset = kMaxU32;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doArray("m_uv", offsetof(ImageAtlasBinarySubImage, m_uv), &self.m_uv[0], self.m_uv.getSize());
+		s.doValue("m_nameOffset", offsetof(ImageAtlasBinarySubImage, m_nameOffset), self.m_nameOffset);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, ImageAtlasBinarySubImage&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const ImageAtlasBinarySubImage&>(serializer, *this);
+	}
+};
+
+/// The binary form of an image atlas descriptor.
+class ImageAtlasBinary
+{
+public:
+	Array<U8, 8> m_magic = {};
+
+	/// Points to m_strings.
+	U32 m_imageOffset = kMaxU32;
+
+	I64 m_subImageMargin = 0;
+	WeakArray<ImageAtlasBinarySubImage> m_subImages;
+
+	/// Null terminated strings one after the other.
+	WeakArray<Char> m_strings;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doArray("m_magic", offsetof(ImageAtlasBinary, m_magic), &self.m_magic[0], self.m_magic.getSize());
+		s.doValue("m_imageOffset", offsetof(ImageAtlasBinary, m_imageOffset), self.m_imageOffset);
+		s.doValue("m_subImageMargin", offsetof(ImageAtlasBinary, m_subImageMargin), self.m_subImageMargin);
+		s.doValue("m_subImages", offsetof(ImageAtlasBinary, m_subImages), self.m_subImages);
+		s.doValue("m_strings", offsetof(ImageAtlasBinary, m_strings), self.m_strings);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, ImageAtlasBinary&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const ImageAtlasBinary&>(serializer, *this);
+	}
+};
+
+/// @}
+
+} // end namespace anki
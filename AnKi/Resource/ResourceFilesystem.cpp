@@ -97,6 +97,17 @@ public:
 	{
 		return m_file.getSize();
 	}
+
+	Error readAt(PtrSize offset, void* buff, PtrSize size) override
+	{
+		ANKI_TRACE_SCOPED_EVENT(RsrcFileRead);
+		return m_file.readAt(offset, buff, size);
+	}
+
+	Error map(ConstWeakArray<U8, PtrSize>& data) override
+	{
+		return m_file.map(data);
+	}
 };
 
 /// ZIP file
@@ -105,6 +116,9 @@ class ZipResourceFile final : public ResourceFile
 public:
 	unzFile m_archive = nullptr;
 	PtrSize m_size = 0;
+	PtrSize m_position = 0; ///< The position of the decompression.
+	Mutex m_readAtMtx;
+	ResourceDynamicArrayLarge<U8> m_mappedData; ///< The whole file, decompressed when map() is called.
 
 	~ZipResourceFile()
 	{
@@ -174,6 +188,7 @@ public:
 			return Error::kFileAccess;
 		}
 
+		m_position += size;
 		return Error::kNone;
 	}
 
@@ -208,6 +223,8 @@ public:
 				ANKI_RESOURCE_LOGE("Rewind failed");
 				return Error::kFunctionFailed;
 			}
+
+			m_position = 0;
 		}
 
 		// Move forward by reading dummy data
@@ -227,6 +244,38 @@ public:
 		ANKI_ASSERT(m_size > 0);
 		return m_size;
 	}
+
+	Error readAt(PtrSize offset, void* buff, PtrSize size) override
+	{
+		ANKI_TRACE_SCOPED_EVENT(RsrcFileRead);
+		LockGuard lock(m_readAtMtx);
+
+		// The archive can only be decompressed forward so rewind only if the range is behind
+		if(offset < m_position)
+		{
+			ANKI_CHECK(seek(offset, FileSeekOrigin::kBeginning));
+		}
+		else
+		{
+			ANKI_CHECK(seek(offset - m_position, FileSeekOrigin::kCurrent));
+		}
+
+		return read(buff, size);
+	}
+
+	Error map(ConstWeakArray<U8, PtrSize>& data) override
+	{
+		if(m_mappedData.getSize() == 0)
+		{
+			ANKI_TRACE_SCOPED_EVENT(RsrcFileRead);
+			ANKI_CHECK(seek(0, FileSeekOrigin::kBeginning));
+			m_mappedData.resize(m_size);
+			ANKI_CHECK(read(m_mappedData.getBegin(), m_size));
+		}
+
+		data = ConstWeakArray<U8, PtrSize>(m_mappedData.getBegin(), m_mappedData.getSize());
+		return Error::kNone;
+	}
 };
 
 ResourceFilesystem::~ResourceFilesystem()
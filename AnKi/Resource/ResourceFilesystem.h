@@ -54,6 +54,14 @@ public:
 	/// Get the size of the file.
 	virtual PtrSize getSize() const = 0;
 
+	/// Read from an offset of the file. It's thread-safe but don't mix it with read() and seek(). Archived files are decompressed only up to the end
+	/// of the range.
+	virtual Error readAt(PtrSize offset, void* buff, PtrSize size) = 0;
+
+	/// Get a read-only view of the whole file. Regular files are memory-mapped and archived files are decompressed in memory. The view stays valid
+	/// while the file is alive.
+	virtual Error map(ConstWeakArray<U8, PtrSize>& data) = 0;
+
 	void retain() const
 	{
 		m_refcount.fetchAdd(1);
@@ -38,6 +38,11 @@ ResourceManager::~ResourceManager()
 	deleteInstance(ResourceMemoryPool::getSingleton(), m_transferGpuAlloc);
 	deleteInstance(ResourceMemoryPool::getSingleton(), m_fs);
 
+	if(m_ownsShaderCompilerMemoryPool)
+	{
+		ShaderCompilerMemoryPool::freeSingleton();
+	}
+
 	ResourceMemoryPool::freeSingleton();
 }
 
@@ -56,7 +61,13 @@ Error ResourceManager::init(AllocAlignedCallback allocCallback, void* allocCallb
 	m_transferGpuAlloc = newInstance<TransferGpuAllocator>(ResourceMemoryPool::getSingleton());
 	ANKI_CHECK(m_transferGpuAlloc->init(g_transferScratchMemorySizeCVar));
 
-	// Init the programs
+	// Init the programs. The tools might have allocated the shader compiler pool already
+	if(!ShaderCompilerMemoryPool::isAllocated())
+	{
+		ShaderCompilerMemoryPool::allocateSingleton(allocCallback, allocCallbackData);
+		m_ownsShaderCompilerMemoryPool = true;
+	}
+
 	m_shaderProgramSystem = newInstance<ShaderProgramResourceSystem>(ResourceMemoryPool::getSingleton());
 	ANKI_CHECK(m_shaderProgramSystem->init());
 
@@ -68,44 +79,46 @@ Error ResourceManager::loadResource(const CString& filename, ResourcePtr<T>& out
 {
 	ANKI_ASSERT(!out.isCreated() && "Already loaded");
 
-	Error err = Error::kNone;
-
-	T* const other = findLoadedResource<T>(filename);
-
-	if(other)
+	T* other;
+	if(TypeResourceManager<T>::findOrReserve(filename, other) == TypeResourceManager<T>::FindResult::kFound)
 	{
 		// Found
 		out.reset(other);
+
+		// Decrement because findOrReserve() retained it
+		other->release();
+		return Error::kNone;
 	}
-	else
+
+	// Not found. This thread loads it and the other threads that ask for the same file will wait for it
+
+	// Allocate ptr
+	T* ptr = newInstance<T>(ResourceMemoryPool::getSingleton());
+	ANKI_ASSERT(ptr->getRefcount() == 0);
+
+	// Increment the refcount in that case where async jobs increment it and decrement it in the scope of a load()
+	ptr->retain();
+
+	const Error err = ptr->load(filename, async);
+	if(err)
 	{
-		// Allocate ptr
-		T* ptr = newInstance<T>(ResourceMemoryPool::getSingleton());
-		ANKI_ASSERT(ptr->getRefcount() == 0);
-
-		// Increment the refcount in that case where async jobs increment it and decrement it in the scope of a load()
-		ptr->retain();
-
-		err = ptr->load(filename, async);
-		if(err)
-		{
-			ANKI_RESOURCE_LOGE("Failed to load resource: %s", &filename[0]);
-			deleteInstance(ResourceMemoryPool::getSingleton(), ptr);
-			return err;
-		}
-
-		ptr->setFilename(filename);
-		ptr->setUuid(++m_uuid);
-
-		// Register resource
-		registerResource(ptr);
-		out.reset(ptr);
-
-		// Decrement because of the increment happened a few lines above
-		ptr->release();
+		ANKI_RESOURCE_LOGE("Failed to load resource: %s", &filename[0]);
+		deleteInstance(ResourceMemoryPool::getSingleton(), ptr);
+		TypeResourceManager<T>::finishLoading(filename, nullptr);
+		return err;
 	}
 
-	return err;
+	ptr->setFilename(filename);
+	ptr->setUuid(m_uuid.fetchAdd(1) + 1);
+
+	// Register resource
+	TypeResourceManager<T>::finishLoading(filename, ptr);
+	out.reset(ptr);
+
+	// Decrement because of the increment happened a few lines above
+	ptr->release();
+
+	return Error::kNone;
 }
 
 // Instansiate the ResourceManager::loadResource()
@@ -7,7 +7,8 @@
 
 #include <AnKi/Resource/TransferGpuAllocator.h>
 #include <AnKi/Resource/ResourceFilesystem.h>
-#include <AnKi/Util/List.h>
+#include <AnKi/Util/HashMap.h>
+#include <AnKi/Util/Thread.h>
 #include <AnKi/Util/Functions.h>
 #include <AnKi/Util/String.h>
 
@@ -28,58 +29,201 @@ class ShaderProgramResourceSystem;
 inline NumericCVar<PtrSize> g_transferScratchMemorySizeCVar("Rsrc", "TransferScratchMemorySize", 256_MB, 1_MB, 4_GB,
 															"Memory that is used fot texture and buffer uploads");
 
-/// Manage resources of a certain type
+/// Manage resources of a certain type. The loaded resources live in a hash map keyed by the hash of the filename. The map is split into a few
+/// shards, each with its own lock, so lookups from many threads rarely contend. While a resource is being loaded it has an entry in the map as
+/// well and the threads that ask for the same file wait for the in-flight load instead of loading it again.
 template<typename Type>
 class TypeResourceManager
 {
 protected:
-	TypeResourceManager()
+	/// The result of findOrReserve().
+	enum class FindResult : U8
 	{
-	}
+		kFound,
+		kLoad ///< Not found. The caller should load the resource and call finishLoading().
+	};
+
+	TypeResourceManager() = default;
 
 	~TypeResourceManager()
 	{
-		ANKI_ASSERT(m_ptrs.isEmpty() && "Forgot to delete some resources");
-		m_ptrs.destroy();
+		for(Shard& shard : m_shards)
+		{
+			ANKI_ASSERT(shard.m_entries.isEmpty() && "Forgot to delete some resources");
+			shard.m_entries.destroy();
+		}
 	}
 
-	Type* findLoadedResource(const CString& filename)
+	/// Find a loaded resource. If it's not loaded the filename is reserved and the caller should load it. If another thread is loading it then
+	/// wait for it.
+	/// @param[out] resource If the resource is found it's already retained. The caller should release it.
+	/// @note Thread-safe.
+	FindResult findOrReserve(CString filename, Type*& resource)
 	{
-		auto it = find(filename);
-		return (it != m_ptrs.end()) ? *it : nullptr;
+		const U64 hash = filename.computeHash();
+		Shard& shard = getShard(hash);
+
+		// Fast path, the resource is loaded
+		{
+			RLockGuard<RWMutex> lock(shard.m_mtx);
+			const Entry* entry = findEntry(shard, hash, filename);
+			if(entry && !entry->m_loading && entry->m_resource->tryRetain())
+			{
+				resource = entry->m_resource;
+				return FindResult::kFound;
+			}
+		}
+
+		// Slow path, the resource is missing, is being deleted or is being loaded
+		LockGuard<Mutex> loadingLock(shard.m_loadingMtx);
+		while(true)
+		{
+			{
+				WLockGuard<RWMutex> lock(shard.m_mtx);
+				Entry* entry = findEntry(shard, hash, filename);
+				if(entry == nullptr)
+				{
+					auto it = shard.m_entries.find(hash);
+					if(it == shard.m_entries.getEnd())
+					{
+						it = shard.m_entries.emplace(hash);
+					}
+
+					it->emplaceBack()->m_filename = filename;
+					return FindResult::kLoad;
+				}
+				else if(!entry->m_loading)
+				{
+					if(entry->m_resource->tryRetain())
+					{
+						resource = entry->m_resource;
+						return FindResult::kFound;
+					}
+
+					// The refcount reached zero and the resource is about to be deleted. Replace it
+					entry->m_resource = nullptr;
+					entry->m_loading = true;
+					return FindResult::kLoad;
+				}
+			}
+
+			// Some other thread is loading it, wait. If that load fails the entry will be gone and this thread will try to load it
+			shard.m_loadingCondVar.wait(shard.m_loadingMtx);
+		}
 	}
 
-	void registerResource(Type* ptr)
+	/// Publish a resource that was loaded after findOrReserve() returned FindResult::kLoad.
+	/// @param resource The loaded resource or nullptr if the load failed.
+	/// @note Thread-safe.
+	void finishLoading(CString filename, Type* resource)
 	{
-		ANKI_ASSERT(find(ptr->getFilename()) == m_ptrs.getEnd());
-		m_ptrs.pushBack(ptr);
+		const U64 hash = filename.computeHash();
+		Shard& shard = getShard(hash);
+
+		{
+			WLockGuard<RWMutex> lock(shard.m_mtx);
+			Entry* entry = findEntry(shard, hash, filename);
+			ANKI_ASSERT(entry && entry->m_loading);
+			if(resource)
+			{
+				entry->m_resource = resource;
+				entry->m_loading = false;
+			}
+			else
+			{
+				eraseEntry(shard, hash, entry);
+			}
+		}
+
+		LockGuard<Mutex> loadingLock(shard.m_loadingMtx);
+		shard.m_loadingCondVar.notifyAll();
 	}
 
+	/// @note Thread-safe.
 	void unregisterResource(Type* ptr)
 	{
-		auto it = find(ptr->getFilename());
-		ANKI_ASSERT(it != m_ptrs.end());
-		m_ptrs.erase(it);
+		const CString filename = ptr->getFilename();
+		const U64 hash = filename.computeHash();
+		Shard& shard = getShard(hash);
+
+		WLockGuard<RWMutex> lock(shard.m_mtx);
+		Entry* entry = findEntry(shard, hash, filename);
+		// The entry might have been replaced by a new load of the same file while this resource was dying
+		if(entry && entry->m_resource == ptr)
+		{
+			eraseEntry(shard, hash, entry);
+		}
 	}
 
 private:
-	using Container = ResourceList<Type*>;
+	static constexpr U32 kShardBits = 4;
+	static constexpr U32 kShardCount = 1u << kShardBits;
+
+	class Entry
+	{
+	public:
+		ResourceString m_filename; ///< Different files may have the same hash so compare the filenames as well.
+		Type* m_resource = nullptr;
+		Bool m_loading = true;
+	};
 
-	Container m_ptrs;
+	/// The entries of the files that have the same hash. Almost always a single one.
+	using Bucket = ResourceDynamicArray<Entry>;
 
-	typename Container::Iterator find(const CString& filename)
+	/// The keys are already hashes.
+	class Hasher
 	{
-		typename Container::Iterator it;
+	public:
+		U64 operator()(U64 hash) const
+		{
+			return hash;
+		}
+	};
+
+	class Shard
+	{
+	public:
+		RWMutex m_mtx; ///< Protects m_entries.
+		ResourceHashMap<U64, Bucket, Hasher> m_entries;
+
+		Mutex m_loadingMtx;
+		ConditionVariable m_loadingCondVar; ///< Signaled when a load finishes.
+	};
+
+	Array<Shard, kShardCount> m_shards;
+
+	Shard& getShard(U64 hash)
+	{
+		// Use the high bits. The hash map of the shard uses the low ones
+		return m_shards[hash >> (64 - kShardBits)];
+	}
 
-		for(it = m_ptrs.getBegin(); it != m_ptrs.getEnd(); ++it)
+	static Entry* findEntry(Shard& shard, U64 hash, CString filename)
+	{
+		auto it = shard.m_entries.find(hash);
+		if(it != shard.m_entries.getEnd())
 		{
-			if((*it)->getFilename() == filename)
+			for(Entry& entry : *it)
 			{
-				break;
+				if(entry.m_filename == filename)
+				{
+					return &entry;
+				}
 			}
 		}
 
-		return it;
+		return nullptr;
+	}
+
+	static void eraseEntry(Shard& shard, U64 hash, Entry* entry)
+	{
+		auto it = shard.m_entries.find(hash);
+		ANKI_ASSERT(it != shard.m_entries.getEnd());
+		it->erase(it->getBegin() + (entry - it->getBegin()));
+		if(it->isEmpty())
+		{
+			shard.m_entries.erase(it);
+		}
 	}
 };
 
@@ -118,18 +262,6 @@ public:
 		return *m_transferGpuAlloc;
 	}
 
-	template<typename T>
-	ANKI_INTERNAL T* findLoadedResource(const CString& filename)
-	{
-		return TypeResourceManager<T>::findLoadedResource(filename);
-	}
-
-	template<typename T>
-	ANKI_INTERNAL void registerResource(T* ptr)
-	{
-		TypeResourceManager<T>::registerResource(ptr);
-	}
-
 	template<typename T>
 	ANKI_INTERNAL void unregisterResource(T* ptr)
 	{
@@ -150,6 +282,11 @@ public:
 		return *m_shaderProgramSystem;
 	}
 
+	ANKI_INTERNAL ShaderProgramResourceSystem& getShaderProgramResourceSystem()
+	{
+		return *m_shaderProgramSystem;
+	}
+
 	ANKI_INTERNAL ResourceFilesystem& getFilesystem()
 	{
 		return *m_fs;
@@ -159,9 +296,10 @@ private:
 	ResourceFilesystem* m_fs = nullptr;
 	AsyncLoader* m_asyncLoader = nullptr; ///< Async loading thread
 	ShaderProgramResourceSystem* m_shaderProgramSystem = nullptr;
+	Bool m_ownsShaderCompilerMemoryPool = false; ///< The deferred shader variants need the pool.
 	TransferGpuAllocator* m_transferGpuAlloc = nullptr;
 
-	U64 m_uuid = 0;
+	Atomic<U64> m_uuid = {0};
 
 	ResourceManager();
 
@@ -35,6 +35,21 @@ public:
 		return m_refcount.fetchSub(1);
 	}
 
+	/// Retain only if the refcount is not zero. A zero refcount means that the resource is being deleted.
+	Bool tryRetain() const
+	{
+		I32 count = m_refcount.load();
+		while(count > 0)
+		{
+			if(m_refcount.compareExchange(count, count + 1))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
 	I32 getRefcount() const
 	{
 		return m_refcount.load();
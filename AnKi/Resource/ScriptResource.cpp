@@ -4,10 +4,41 @@
 // http://www.anki3d.org/LICENSE
 
 #include <AnKi/Resource/ScriptResource.h>
+#include <AnKi/Gr/GrManager.h>
 #include <AnKi/Util/File.h>
+#include <AnKi/Util/Filesystem.h>
+#include <AnKi/Util/Tracer.h>
+#include <Lua/lua.hpp>
 
 namespace anki {
 
+static void* luaAllocCallback([[maybe_unused]] void* userData, void* ptr, PtrSize osize, PtrSize nsize)
+{
+	if(nsize == 0)
+	{
+		ResourceMemoryPool::getSingleton().free(ptr);
+		return nullptr;
+	}
+
+	void* newPtr = ResourceMemoryPool::getSingleton().allocate(nsize, ANKI_SAFE_ALIGNMENT);
+	if(ptr)
+	{
+		memcpy(newPtr, ptr, min(osize, nsize));
+		ResourceMemoryPool::getSingleton().free(ptr);
+	}
+
+	return newPtr;
+}
+
+static int luaWriterCallback([[maybe_unused]] lua_State* l, const void* data, size_t size, void* userData)
+{
+	ResourceDynamicArray<U8>& out = *static_cast<ResourceDynamicArray<U8>*>(userData);
+	const U32 offset = out.getSize();
+	out.resize(offset + U32(size));
+	memcpy(&out[offset], data, size);
+	return 0;
+}
+
 Error ScriptResource::load(const ResourceFilename& filename, [[maybe_unused]] Bool async)
 {
 	ResourceFilePtr file;
@@ -17,6 +48,99 @@ Error ScriptResource::load(const ResourceFilename& filename, [[maybe_unused]] Bo
 	ANKI_CHECK(file->readAllText(src));
 	m_source = std::move(src);
 
+	// The chunk name is stored in the bytecode and it appears in the error messages
+	ResourceString chunkName;
+	chunkName.sprintf("@%s", filename.cstr());
+
+	// The cache is keyed by the source and the chunk name so edited or renamed scripts will be recompiled
+	ResourceString cacheFilename;
+	const Bool diskCache = g_scriptBytecodeDiskCacheCVar && GrManager::isAllocated();
+	if(diskCache)
+	{
+		U64 hash = computeHash(m_source.cstr(), m_source.getLength(), LUA_VERSION_NUM);
+		hash = appendHash(chunkName.cstr(), chunkName.getLength(), hash);
+		cacheFilename.sprintf("%s/ScriptBytecode_%016" PRIx64 ".luabin", GrManager::getSingleton().getCacheDirectory().cstr(), hash);
+
+		Bool found;
+		ANKI_CHECK(loadBytecodeFromDiskCache(cacheFilename.toCString(), found));
+		if(found)
+		{
+			return Error::kNone;
+		}
+	}
+
+	// Compile once. The environments will only load the bytecode
+	ANKI_CHECK(compile(m_source.toCString(), chunkName.toCString(), m_bytecode));
+
+	if(diskCache)
+	{
+		// The cache is just an optimization. Don't fail the load if the directory is read-only
+		File cacheFile;
+		if(cacheFile.open(cacheFilename.toCString(), FileOpenFlag::kWrite | FileOpenFlag::kBinary)
+		   || cacheFile.write(&m_bytecode[0], m_bytecode.getSizeInBytes()))
+		{
+			ANKI_RESOURCE_LOGW("Failed to write the script bytecode cache. Will continue without it: %s", cacheFilename.cstr());
+			cacheFile.close();
+			if(fileExists(cacheFilename.toCString()))
+			{
+				[[maybe_unused]] const Error err = removeFile(cacheFilename.toCString());
+			}
+		}
+	}
+
+	return Error::kNone;
+}
+
+Error ScriptResource::compile(CString source, CString chunkName, ResourceDynamicArray<U8>& bytecode)
+{
+	ANKI_TRACE_SCOPED_EVENT(LuaCompile);
+
+	// Use a throwaway state so the resource module doesn't depend on the script module. The bytecode doesn't depend on the state
+	lua_State* l = lua_newstate(luaAllocCallback, nullptr);
+	if(!l)
+	{
+		ANKI_RESOURCE_LOGE("lua_newstate() failed");
+		return Error::kOutOfMemory;
+	}
+
+	Error err = Error::kNone;
+	if(luaL_loadbufferx(l, source.cstr(), source.getLength(), chunkName.cstr(), "t"))
+	{
+		ANKI_RESOURCE_LOGE("%s", lua_tostring(l, -1));
+		err = Error::kUserData;
+	}
+	else if(lua_dump(l, luaWriterCallback, &bytecode))
+	{
+		ANKI_RESOURCE_LOGE("Failed to dump the bytecode of: %s", chunkName.cstr());
+		err = Error::kFunctionFailed;
+	}
+
+	lua_close(l);
+	return err;
+}
+
+Error ScriptResource::loadBytecodeFromDiskCache(CString cacheFilename, Bool& found)
+{
+	found = fileExists(cacheFilename);
+	if(!found)
+	{
+		return Error::kNone;
+	}
+
+	File cacheFile;
+	ANKI_CHECK(cacheFile.open(cacheFilename, FileOpenFlag::kRead | FileOpenFlag::kBinary));
+
+	const PtrSize size = cacheFile.getSize();
+	if(size == 0)
+	{
+		ANKI_RESOURCE_LOGW("Empty script bytecode cache file. Will recompile: %s", cacheFilename.cstr());
+		found = false;
+		return Error::kNone;
+	}
+
+	m_bytecode.resize(U32(size));
+	ANKI_CHECK(cacheFile.read(&m_bytecode[0], size));
+
 	return Error::kNone;
 }
 
@@ -6,13 +6,19 @@
 #pragma once
 
 #include <AnKi/Resource/ResourceObject.h>
+#include <AnKi/Util/WeakArray.h>
+#include <AnKi/Util/CVarSet.h>
 
 namespace anki {
 
+inline BoolCVar g_scriptBytecodeDiskCacheCVar("Rsrc", "ScriptBytecodeDiskCache", false,
+											  "Store the compiled bytecode of the scripts to the cache directory");
+
 /// @addtogroup resource
 /// @{
 
-/// Script resource.
+/// Script resource. It holds the source and the compiled bytecode. The bytecode is compiled once and can be evaluated to many
+/// ScriptEnvironments.
 class ScriptResource : public ResourceObject
 {
 public:
@@ -27,8 +33,22 @@ public:
 		return m_source.toCString();
 	}
 
+	/// The bytecode can be evaluated to any ScriptEnvironment. See ScriptEnvironment::evalBytecode().
+	ConstWeakArray<U8> getBytecode() const
+	{
+		return m_bytecode;
+	}
+
+	/// Compile LUA source to bytecode without running it. It's the only place that compiles scripts.
+	/// @param chunkName The name that will appear in error messages.
+	/// @note It's thread-safe.
+	static Error compile(CString source, CString chunkName, ResourceDynamicArray<U8>& bytecode);
+
 private:
 	ResourceString m_source;
+	ResourceDynamicArray<U8> m_bytecode;
+
+	Error loadBytecodeFromDiskCache(CString cacheFilename, Bool& found);
 };
 /// @}
 
@@ -50,6 +50,48 @@ Error ShaderProgramResource::load(const ResourceFilename& filename, [[maybe_unus
 void ShaderProgramResource::getOrCreateVariant(const ShaderProgramResourceVariantInitInfo& info_, const ShaderProgramResourceVariant*& variant) const
 {
 	ShaderProgramResourceVariantInitInfo info = info_;
+	Bool dispatchCompilation;
+	ShaderProgramResourceVariant* v = findOrCreateVariant(info, dispatchCompilation);
+
+	if(v->m_state.load() != ShaderProgramResourceVariant::State::kReady)
+	{
+		// Compile it on this thread if no other thread has started. The compile threads might be busy with other variants
+		compileDeferredVariant(info, *v);
+		waitDeferredVariant(*v);
+	}
+
+	variant = (v->m_prog.isCreated()) ? v : nullptr;
+}
+
+Bool ShaderProgramResource::tryGetOrCreateVariant(const ShaderProgramResourceVariantInitInfo& info_,
+												  const ShaderProgramResourceVariant*& variant) const
+{
+	ShaderProgramResourceVariantInitInfo info = info_;
+	Bool dispatchCompilation;
+	ShaderProgramResourceVariant* v = findOrCreateVariant(info, dispatchCompilation);
+
+	if(dispatchCompilation)
+	{
+		// The task holds a reference so the program outlives it
+		ShaderProgramResourcePtr self(const_cast<ShaderProgramResource*>(this));
+		ResourceManager::getSingleton().getShaderProgramResourceSystem().dispatchDeferredShaderTask([self, info, v]([[maybe_unused]] U32 tid) {
+			self->compileDeferredVariant(info, *v);
+		});
+	}
+
+	if(v->m_state.load() != ShaderProgramResourceVariant::State::kReady)
+	{
+		variant = nullptr;
+		return false;
+	}
+
+	variant = (v->m_prog.isCreated()) ? v : nullptr;
+	return true;
+}
+
+ShaderProgramResourceVariant* ShaderProgramResource::findOrCreateVariant(ShaderProgramResourceVariantInitInfo& info, Bool& dispatchCompilation) const
+{
+	dispatchCompilation = false;
 
 	// Sanity checks
 	ANKI_ASSERT(info.m_setMutators.getSetBitCount() == m_binary->m_mutators.getSize());
@@ -105,38 +147,66 @@ void ShaderProgramResource::getOrCreateVariant(const ShaderProgramResourceVarian
 		auto it = m_variants.find(hash);
 		if(it != m_variants.getEnd())
 		{
-			// Done
-			variant = *it;
-			if(!!(info.m_shaderTypes & ShaderTypeBit::kAllGraphics))
-			{
-				ANKI_ASSERT(variant->m_prog->getShaderTypes() == info.m_shaderTypes);
-			}
-			return;
+			return *it;
 		}
 	}
 
-	// Create the variant
 	WLockGuard<RWMutex> lock(m_mtx);
 
-	// Check again
+	// Check again, another thread might have created it in the meantime
 	auto it = m_variants.find(hash);
 	if(it != m_variants.getEnd())
 	{
-		// Done
-		variant = *it;
-		return;
+		return *it;
 	}
 
-	// Create
-	ShaderProgramResourceVariant* v = createNewVariant(info);
-	if(v)
+	ShaderProgramResourceVariant* v = newInstance<ShaderProgramResourceVariant>(ResourceMemoryPool::getSingleton());
+	if(isDeferred())
 	{
-		m_variants.emplace(hash, v);
+		// Publish it before compiling so no other thread will compile it again. The compilation happens outside the lock and it doesn't
+		// block the threads that ask for other variants
+		v->m_state.setNonAtomically(ShaderProgramResourceVariant::State::kPending);
+		dispatchCompilation = true;
 	}
-	variant = v;
-	if(!!(info.m_shaderTypes & ShaderTypeBit::kAllGraphics))
+	else
 	{
-		ANKI_ASSERT(variant->m_prog->getShaderTypes() == info.m_shaderTypes);
+		// Nothing to compile, it's cheap to create it under the lock
+		initVariant(info, *v);
+	}
+
+	m_variants.emplace(hash, v);
+	return v;
+}
+
+void ShaderProgramResource::compileDeferredVariant(const ShaderProgramResourceVariantInitInfo& info, ShaderProgramResourceVariant& variant) const
+{
+	using State = ShaderProgramResourceVariant::State;
+
+	State state = State::kPending;
+	while(!variant.m_state.compareExchange(state, State::kCompiling))
+	{
+		if(state != State::kPending)
+		{
+			// Another thread got it
+			return;
+		}
+	}
+
+	initVariant(info, variant);
+
+	{
+		LockGuard lock(m_variantReadyMtx);
+		variant.m_state.store(State::kReady);
+	}
+	m_variantReadyCond.notifyAll();
+}
+
+void ShaderProgramResource::waitDeferredVariant(const ShaderProgramResourceVariant& variant) const
+{
+	LockGuard lock(m_variantReadyMtx);
+	while(variant.m_state.load() != ShaderProgramResourceVariant::State::kReady)
+	{
+		m_variantReadyCond.wait(m_variantReadyMtx);
 	}
 }
 
@@ -156,7 +226,7 @@ U32 ShaderProgramResource::findTechnique(CString name) const
 	return techniqueIdx;
 }
 
-ShaderProgramResourceVariant* ShaderProgramResource::createNewVariant(const ShaderProgramResourceVariantInitInfo& info) const
+void ShaderProgramResource::initVariant(const ShaderProgramResourceVariantInitInfo& info, ShaderProgramResourceVariant& variant) const
 {
 	// Get the binary program variant
 	const ShaderBinaryVariant* binaryVariant = nullptr;
@@ -175,21 +245,20 @@ ShaderProgramResourceVariant* ShaderProgramResource::createNewVariant(const Shad
 				if(mutation.m_variantIndex == kMaxU32)
 				{
 					// Skipped mutation, nothing to create
-					return nullptr;
+					return;
 				}
 
-				binaryVariant = &m_binary->m_variants[mutation.m_variantIndex];
+				binaryVariant = (isDeferred()) ? nullptr : &m_binary->m_variants[mutation.m_variantIndex];
 				break;
 			}
 		}
 	}
-	else
+	else if(!isDeferred())
 	{
 		ANKI_ASSERT(m_binary->m_variants.getSize() == 1);
 		binaryVariant = &m_binary->m_variants[0];
 	}
-	ANKI_ASSERT(binaryVariant);
-	ShaderProgramResourceVariant* variant = newInstance<ShaderProgramResourceVariant>(ResourceMemoryPool::getSingleton());
+	ANKI_ASSERT(binaryVariant || isDeferred());
 
 	// Time to init the shaders
 	if(!!(info.m_shaderTypes & (ShaderTypeBit::kAllGraphics | ShaderTypeBit::kCompute)))
@@ -208,13 +277,26 @@ ShaderProgramResourceVariant* ShaderProgramResource::createNewVariant(const Shad
 			ANKI_ASSERT(!!(m_binary->m_techniques[techniqueIdx].m_shaderTypes & shaderBit));
 
 			const ResourceString shaderName = (progName + "_" + m_binary->m_techniques[techniqueIdx].m_name.getBegin()).cstr();
-			ShaderInitInfo inf(shaderName);
-			inf.m_shaderType = shaderType;
-			const ShaderBinaryCodeBlock& binBlock =
-				m_binary->m_codeBlocks[binaryVariant->m_techniqueCodeBlocks[techniqueIdx].m_codeBlockIndices[shaderType]];
-			inf.m_binary = binBlock.m_binary;
-			inf.m_reflection = binBlock.m_reflection;
-			ShaderPtr shader = GrManager::getSingleton().newShader(inf);
+			ShaderPtr shader;
+			if(isDeferred())
+			{
+				shader = getOrCreateDeferredShader(ConstWeakArray<MutatorValue>(info.m_mutation.getBegin(), m_binary->m_mutators.getSize()),
+												   techniqueIdx, shaderType, shaderName);
+				if(!shader)
+				{
+					return;
+				}
+			}
+			else
+			{
+				ShaderInitInfo inf(shaderName);
+				inf.m_shaderType = shaderType;
+				const ShaderBinaryCodeBlock& binBlock =
+					m_binary->m_codeBlocks[binaryVariant->m_techniqueCodeBlocks[techniqueIdx].m_codeBlockIndices[shaderType]];
+				inf.m_binary = binBlock.m_binary;
+				inf.m_reflection = binBlock.m_reflection;
+				shader = GrManager::getSingleton().newShader(inf);
+			}
 			shaderRefs[shaderType] = shader;
 
 			if(!!(shaderBit & ShaderTypeBit::kAllGraphics))
@@ -232,7 +314,12 @@ ShaderProgramResourceVariant* ShaderProgramResource::createNewVariant(const Shad
 		}
 
 		// Create the program
-		variant->m_prog = GrManager::getSingleton().newShaderProgram(progInf);
+		variant.m_prog = GrManager::getSingleton().newShaderProgram(progInf);
+
+		if(!!(info.m_shaderTypes & ShaderTypeBit::kAllGraphics))
+		{
+			ANKI_ASSERT(variant.m_prog->getShaderTypes() == info.m_shaderTypes);
+		}
 	}
 	else
 	{
@@ -269,7 +356,7 @@ ShaderProgramResourceVariant* ShaderProgramResource::createNewVariant(const Shad
 		}
 		ANKI_ASSERT(foundLib);
 
-		variant->m_prog = foundLib->getShaderProgram();
+		variant.m_prog = foundLib->getShaderProgram();
 
 		RayTracingShaderGroupType groupType;
 		if(!!(info.m_shaderTypes & ShaderTypeBit::kRayGen))
@@ -287,10 +374,51 @@ ShaderProgramResourceVariant* ShaderProgramResource::createNewVariant(const Shad
 		}
 
 		// Set the group handle index
-		variant->m_shaderGroupHandleIndex = foundLib->getShaderGroupHandleIndex(getFilename(), mutationHash, groupType);
+		variant.m_shaderGroupHandleIndex = foundLib->getShaderGroupHandleIndex(getFilename(), mutationHash, groupType);
+	}
+}
+
+ShaderPtr ShaderProgramResource::getOrCreateDeferredShader(ConstWeakArray<MutatorValue> mutation, U32 techniqueIdx, ShaderType shaderType,
+														   CString shaderName) const
+{
+	ShaderCompilerString source;
+	generateDeferredShaderSource(*m_binary, mutation, techniqueIdx, shaderType, source);
+
+	// Many mutations produce the same source. Search for a shader that was created before
+	const U64 hash = source.computeHash();
+	{
+		LockGuard lock(m_deferredShadersMtx);
+		auto it = m_deferredShaders.find(hash);
+		if(it != m_deferredShaders.getEnd())
+		{
+			return *it;
+		}
+	}
+
+	ResourceDynamicArray<U8> il;
+	ShaderReflection refl;
+	if(ResourceManager::getSingleton().getShaderProgramResourceSystem().getOrCompileDeferredShader(*m_binary, source, shaderType, il, refl))
+	{
+		ANKI_RESOURCE_LOGE("Failed to compile a variant of: %s", getFilename().cstr());
+		return ShaderPtr();
+	}
+
+	ShaderInitInfo inf(shaderName);
+	inf.m_shaderType = shaderType;
+	inf.m_binary = ConstWeakArray<U8>(il.getBegin(), il.getSize());
+	inf.m_reflection = refl;
+	ShaderPtr shader = GrManager::getSingleton().newShader(inf);
+
+	LockGuard lock(m_deferredShadersMtx);
+	auto it = m_deferredShaders.find(hash);
+	if(it != m_deferredShaders.getEnd())
+	{
+		// Another thread created it in the meantime
+		return *it;
 	}
 
-	return variant;
+	m_deferredShaders.emplace(hash, shader);
+	return shader;
 }
 
 } // end namespace anki
@@ -47,8 +47,17 @@ public:
 	}
 
 private:
-	ShaderProgramPtr m_prog;
+	/// The variants of deferred binaries are published before their shaders are compiled.
+	enum class State : U32
+	{
+		kPending,
+		kCompiling,
+		kReady
+	};
+
+	ShaderProgramPtr m_prog; ///< Not created if the mutation is skipped or the compilation failed.
 	U32 m_shaderGroupHandleIndex = kMaxU32; ///< Cache the index of the handle here.
+	Atomic<State> m_state = {State::kReady};
 };
 
 class ShaderProgramResourceVariantInitInfo
@@ -129,16 +138,48 @@ public:
 	}
 
 	/// Get or create a graphics shader program variant. If returned variant is nullptr then it means that the mutation is skipped and thus incorrect.
+	/// If the binary is deferred and the variant is still compiling it blocks until the compilation is done. See tryGetOrCreateVariant().
 	/// @note It's thread-safe.
 	void getOrCreateVariant(const ShaderProgramResourceVariantInitInfo& info, const ShaderProgramResourceVariant*& variant) const;
 
+	/// Same as getOrCreateVariant() but it doesn't block. If the binary is deferred the first request dispatches the compilation of the variant
+	/// to the ShaderProgramResourceSystem's threads.
+	/// @return False if the variant is not ready yet. Try again later.
+	/// @note It's thread-safe.
+	Bool tryGetOrCreateVariant(const ShaderProgramResourceVariantInitInfo& info, const ShaderProgramResourceVariant*& variant) const;
+
+	/// True if the variants are compiled at runtime. See ShaderBinary::m_deferredSource.
+	Bool isDeferred() const
+	{
+		return m_binary->m_deferredSource.getSize() > 0;
+	}
+
 private:
 	ShaderBinary* m_binary = nullptr;
 
 	mutable ResourceHashMap<U64, ShaderProgramResourceVariant*> m_variants;
 	mutable RWMutex m_mtx;
 
-	ShaderProgramResourceVariant* createNewVariant(const ShaderProgramResourceVariantInitInfo& info) const;
+	/// Signaled when the compilation of a deferred variant is done.
+	mutable ConditionVariable m_variantReadyCond;
+	mutable Mutex m_variantReadyMtx;
+
+	/// The shaders of the deferred binaries. Many variants share shaders. The key is the hash of the source.
+	mutable ResourceHashMap<U64, ShaderPtr> m_deferredShaders;
+	mutable Mutex m_deferredShadersMtx;
+
+	/// Find the variant or publish a new one. The variants of the deferred binaries might still be pending.
+	/// @param[in,out] info The default technique will be filled if the user didn't request one.
+	ShaderProgramResourceVariant* findOrCreateVariant(ShaderProgramResourceVariantInitInfo& info, Bool& dispatchCompilation) const;
+
+	void initVariant(const ShaderProgramResourceVariantInitInfo& info, ShaderProgramResourceVariant& variant) const;
+
+	/// Compile the shaders of a pending deferred variant. Does nothing if another thread has started compiling it.
+	void compileDeferredVariant(const ShaderProgramResourceVariantInitInfo& info, ShaderProgramResourceVariant& variant) const;
+
+	void waitDeferredVariant(const ShaderProgramResourceVariant& variant) const;
+
+	ShaderPtr getOrCreateDeferredShader(ConstWeakArray<MutatorValue> mutation, U32 techniqueIdx, ShaderType shaderType, CString shaderName) const;
 
 	U32 findTechnique(CString name) const;
 };
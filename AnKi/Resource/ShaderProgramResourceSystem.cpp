@@ -136,8 +136,28 @@ U64 ShaderProgramRaytracingLibrary::generateShaderGroupGroupHash(CString resourc
 	return hash;
 }
 
+ShaderProgramResourceSystem::~ShaderProgramResourceSystem()
+{
+	if(m_deferredShaderJobManager)
+	{
+		// The tasks hold references to the programs. Let them finish before the resources go away
+		m_deferredShaderJobManager->waitForAllTasksToFinish();
+		deleteInstance(ResourceMemoryPool::getSingleton(), m_deferredShaderJobManager);
+	}
+}
+
 Error ShaderProgramResourceSystem::init()
 {
+	// The cache of the deferred shader variants
+	if(g_shaderVariantDiskCacheCVar && GrManager::getSingleton().getCacheDirectory().getLength())
+	{
+		m_deferredShaderCacheDir.sprintf("%s/ShaderVariants", GrManager::getSingleton().getCacheDirectory().cstr());
+		if(!directoryExists(m_deferredShaderCacheDir))
+		{
+			ANKI_CHECK(createDirectory(m_deferredShaderCacheDir));
+		}
+	}
+
 	if(!GrManager::getSingleton().getDeviceCapabilities().m_rayTracingEnabled)
 	{
 		return Error::kNone;
@@ -419,4 +439,101 @@ Error ShaderProgramResourceSystem::createRayTracingPrograms(ResourceDynamicArray
 	return Error::kNone;
 }
 
+Error ShaderProgramResourceSystem::getOrCompileDeferredShader(const ShaderBinary& binary, CString source, ShaderType shaderType,
+															  ResourceDynamicArray<U8>& il, ShaderReflection& refl)
+{
+	ANKI_TRACE_SCOPED_EVENT(CompileDeferredShader);
+
+	const Bool spirv = ANKI_GR_BACKEND_VULKAN;
+	constexpr Bool debugInfo = false;
+
+	// The key of the cache. Changing the compiler flags or the binary version invalidates the cache
+	U64 hash = source.computeHash();
+	hash = appendHash(&spirv, sizeof(spirv), hash);
+	hash = appendHash(&kShaderBinaryVersion, sizeof(kShaderBinaryVersion), hash);
+
+	ResourceString cacheFilename;
+	if(m_deferredShaderCacheDir.getLength())
+	{
+		cacheFilename.sprintf("%s/%016" PRIx64 ".ankishader", m_deferredShaderCacheDir.cstr(), hash);
+	}
+
+	// Search the cache
+	if(cacheFilename.getLength())
+	{
+		LockGuard lock(m_deferredShaderCacheMtx);
+
+		if(fileExists(cacheFilename))
+		{
+			ShaderBinaryCodeBlock* codeBlock = nullptr;
+			File file;
+			Error err = file.open(cacheFilename, FileOpenFlag::kRead | FileOpenFlag::kBinary);
+			if(!err)
+			{
+				err = BinaryDeserializer::deserialize(codeBlock, ResourceMemoryPool::getSingleton(), file);
+			}
+
+			if(!err && codeBlock->m_hash == hash)
+			{
+				il.resize(codeBlock->m_binary.getSize());
+				memcpy(il.getBegin(), codeBlock->m_binary.getBegin(), codeBlock->m_binary.getSizeInBytes());
+				refl = codeBlock->m_reflection;
+				ResourceMemoryPool::getSingleton().free(codeBlock);
+				return Error::kNone;
+			}
+
+			// Corrupted or stale. It will be overwritten
+			ANKI_RESOURCE_LOGW("Ignoring shader cache file: %s", cacheFilename.cstr());
+			ResourceMemoryPool::getSingleton().free(codeBlock);
+		}
+	}
+
+	// Compile. Do that outside the lock, compilation is slow
+	ShaderCompilerDynamicArray<U8> compiledIl;
+	ANKI_CHECK(compileDeferredShader(binary, source, shaderType, spirv, debugInfo, compiledIl, refl));
+
+	il.resize(compiledIl.getSize());
+	memcpy(il.getBegin(), compiledIl.getBegin(), compiledIl.getSizeInBytes());
+
+	// Store to the cache. Failing to do so is not fatal
+	if(cacheFilename.getLength())
+	{
+		LockGuard lock(m_deferredShaderCacheMtx);
+
+		ShaderBinaryCodeBlock codeBlock;
+		codeBlock.m_binary = WeakArray<U8>(il.getBegin(), il.getSize());
+		codeBlock.m_hash = hash;
+		codeBlock.m_reflection = refl;
+
+		File file;
+		Error err = file.open(cacheFilename, FileOpenFlag::kWrite | FileOpenFlag::kBinary);
+		if(!err)
+		{
+			BinarySerializer serializer;
+			err = serializer.serialize(codeBlock, ResourceMemoryPool::getSingleton(), file);
+		}
+
+		if(err)
+		{
+			ANKI_RESOURCE_LOGW("Failed to write shader cache file: %s", cacheFilename.cstr());
+		}
+	}
+
+	return Error::kNone;
+}
+
+void ShaderProgramResourceSystem::dispatchDeferredShaderTask(const ThreadJobManager::Func& func)
+{
+	{
+		// Most programs are not deferred so create the threads when they are needed
+		LockGuard lock(m_deferredShaderJobManagerMtx);
+		if(!m_deferredShaderJobManager)
+		{
+			m_deferredShaderJobManager = newInstance<ThreadJobManager>(ResourceMemoryPool::getSingleton(), g_shaderVariantCompileThreadCountCVar);
+		}
+	}
+
+	m_deferredShaderJobManager->dispatchTask(func);
+}
+
 } // end namespace anki
@@ -9,10 +9,17 @@
 #include <AnKi/Gr/ShaderProgram.h>
 #include <AnKi/Util/HashMap.h>
 #include <AnKi/Util/StringList.h>
+#include <AnKi/Util/CVarSet.h>
+#include <AnKi/Util/ThreadJobManager.h>
 #include <AnKi/ShaderCompiler/ShaderBinary.h>
 
 namespace anki {
 
+inline BoolCVar g_shaderVariantDiskCacheCVar("Rsrc", "ShaderVariantDiskCache", true,
+											 "Store the shader variants that are compiled at runtime to the cache directory");
+inline NumericCVar<U32> g_shaderVariantCompileThreadCountCVar("Rsrc", "ShaderVariantCompileThreadCount", 2, 1, 64,
+															  "The threads that compile the shader variants at runtime");
+
 /// @addtogroup resource
 /// @{
 
@@ -80,7 +87,7 @@ public:
 	{
 	}
 
-	~ShaderProgramResourceSystem() = default;
+	~ShaderProgramResourceSystem();
 
 	Error init();
 
@@ -89,6 +96,18 @@ public:
 		return m_rtLibraries;
 	}
 
+	/// Get the IL of a shader of a deferred ShaderBinary (see ShaderBinary::m_deferredSource). The IL is searched in a cache on disk first. If
+	/// it's not there it's compiled and stored in the cache for the next runs.
+	/// @param source The source that generateDeferredShaderSource() generated.
+	/// @note It's thread-safe.
+	Error getOrCompileDeferredShader(const ShaderBinary& binary, CString source, ShaderType shaderType, ResourceDynamicArray<U8>& il,
+									 ShaderReflection& refl);
+
+	/// Run a task in the threads that compile the shader variants of the deferred binaries. They are not the threads of the
+	/// CoreThreadJobManager so a long compilation won't stall the code that waits for the core jobs. The threads are created by the first task.
+	/// @note It's thread-safe.
+	void dispatchDeferredShaderTask(const ThreadJobManager::Func& func);
+
 private:
 	class ShaderH;
 	class ShaderGroup;
@@ -96,6 +115,12 @@ private:
 
 	ResourceDynamicArray<ShaderProgramRaytracingLibrary> m_rtLibraries;
 
+	ResourceString m_deferredShaderCacheDir; ///< Empty if there is no cache.
+	Mutex m_deferredShaderCacheMtx;
+
+	ThreadJobManager* m_deferredShaderJobManager = nullptr;
+	Mutex m_deferredShaderJobManagerMtx;
+
 	static Error createRayTracingPrograms(ResourceDynamicArray<ShaderProgramRaytracingLibrary>& outLibs);
 };
 /// @}
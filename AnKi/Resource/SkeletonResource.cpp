@@ -5,88 +5,61 @@
 
 #include <AnKi/Resource/SkeletonResource.h>
 #include <AnKi/Resource/ResourceManager.h>
-#include <AnKi/Util/Xml.h>
-#include <AnKi/Util/StringList.h>
+#include <AnKi/Resource/ResourceDescriptor.h>
 
 namespace anki {
 
 Error SkeletonResource::load(const ResourceFilename& filename, [[maybe_unused]] Bool async)
 {
-	ResourceXmlDocument doc;
-	ANKI_CHECK(openFileParseXml(filename, doc));
+	ResourceFilePtr file;
+	ANKI_CHECK(openFile(filename, file));
+	ResourceDescriptor<SkeletonBinary> desc;
+	ANKI_CHECK(desc.load(*file));
 
-	XmlElement rootEl;
-	ANKI_CHECK(doc.getChildElement("skeleton", rootEl));
-	XmlElement bonesEl;
-	ANKI_CHECK(rootEl.getChildElement("bones", bonesEl));
-
-	// count the bones count
-	XmlElement boneEl;
-	U32 boneCount = 0;
-
-	ANKI_CHECK(bonesEl.getChildElement("bone", boneEl));
-	ANKI_CHECK(boneEl.getSiblingElementsCount(boneCount));
-	++boneCount;
-
-	m_bones.resize(boneCount);
-
-	ResourceStringList boneParents;
+	// <bones>
+	const ConstWeakArray<SkeletonBinaryBone> bones = desc.getBinary().m_bones;
+	m_bones.resize(bones.getSize());
 
 	// Load every bone
-	boneCount = 0;
-	do
+	for(U32 boneIdx = 0; boneIdx < bones.getSize(); ++boneIdx)
 	{
-		Bone& bone = m_bones[boneCount];
-		bone.m_idx = boneCount;
+		Bone& bone = m_bones[boneIdx];
+		bone.m_idx = boneIdx;
 
 		// name
-		CString name;
-		ANKI_CHECK(boneEl.getAttributeText("name", name));
-		bone.m_name = name;
+		bone.m_name = desc.getString(bones[boneIdx].m_nameOffset);
 
-		// transform
-		ANKI_CHECK(boneEl.getAttributeNumbers("transform", bone.m_transform));
-
-		// boneTransform
-		ANKI_CHECK(boneEl.getAttributeNumbers("boneTransform", bone.m_vertTrf));
-
-		// parent
-		CString parent;
-		Bool hasParent;
-		ANKI_CHECK(boneEl.getAttributeTextOptional("parent", parent, hasParent));
-		if(hasParent)
+		// transform & boneTransform
+		for(U32 i = 0; i < 12; ++i)
 		{
-			boneParents.pushBack(parent);
+			bone.m_transform[i] = bones[boneIdx].m_transform[i];
+			bone.m_vertTrf[i] = bones[boneIdx].m_boneTransform[i];
 		}
-		else
-		{
-			boneParents.pushBack("");
 
+		// parent
+		if(bones[boneIdx].m_parentOffset == kMaxU32)
+		{
 			if(m_rootBoneIdx != kMaxU32)
 			{
 				ANKI_RESOURCE_LOGE("Skeleton cannot have more than one root nodes");
 				return Error::kUserData;
 			}
 
-			m_rootBoneIdx = boneCount;
+			m_rootBoneIdx = boneIdx;
 		}
-
-		// Advance
-		ANKI_CHECK(boneEl.getNextSiblingElement("bone", boneEl));
-		++boneCount;
-	} while(boneEl);
+	}
 
 	// Resolve the parents
-	auto it = boneParents.getBegin();
 	for(U32 i = 0; i < m_bones.getSize(); ++i)
 	{
 		Bone& bone = m_bones[i];
+		const CString parent = (bones[i].m_parentOffset != kMaxU32) ? desc.getString(bones[i].m_parentOffset) : CString("");
 
-		if(it->getLength() > 0)
+		if(parent.getLength() > 0)
 		{
 			for(U32 j = 0; j < m_bones.getSize(); ++j)
 			{
-				if(m_bones[j].m_name == *it)
+				if(m_bones[j].m_name == parent)
 				{
 					bone.m_parent = &m_bones[j];
 					break;
@@ -95,7 +68,7 @@ Error SkeletonResource::load(const ResourceFilename& filename, [[maybe_unused]]
 
 			if(bone.m_parent == nullptr)
 			{
-				ANKI_RESOURCE_LOGE("Bone \"%s\" is referencing an unknown parent \"%s\"", &bone.m_name[0], &it->toCString()[0]);
+				ANKI_RESOURCE_LOGE("Bone \"%s\" is referencing an unknown parent \"%s\"", &bone.m_name[0], parent.cstr());
 				return Error::kUserData;
 			}
 
@@ -107,8 +80,6 @@ Error SkeletonResource::load(const ResourceFilename& filename, [[maybe_unused]]
 
 			bone.m_parent->m_children[bone.m_parent->m_childrenCount++] = &bone;
 		}
-
-		++it;
 	}
 
 	return Error::kNone;
@@ -8,6 +8,7 @@
 #include <AnKi/Resource/ResourceManager.h>
 #include <AnKi/Shaders/Include/ClusteredShadingTypes.h>
 #include <AnKi/Core/GpuMemory/GpuSceneBuffer.h>
+#include <AnKi/Collision/Functions.h>
 
 namespace anki {
 
@@ -19,6 +20,7 @@ DecalComponent::DecalComponent(SceneNode* node)
 
 DecalComponent::~DecalComponent()
 {
+	SceneGraph::getSingleton().getSpatialIndex().tryDeleteObject(m_spatialIndexObject);
 }
 
 void DecalComponent::setLayer(CString fname, F32 blendFactor, LayerType type)
@@ -68,6 +70,7 @@ Error DecalComponent::update(SceneComponentUpdateInfo& info, Bool& updated)
 		const Vec4 extend(halfBoxSize.x(), halfBoxSize.y(), halfBoxSize.z(), 0.0f);
 		const Obb obbL(center, Mat3x4::getIdentity(), extend);
 		const Obb obbW = obbL.getTransformed(info.m_node->getWorldTransform());
+		SceneGraph::getSingleton().getSpatialIndex().newOrMoveObject(m_spatialIndexObject, computeAabb(obbW), static_cast<SceneComponent*>(this));
 
 		// Upload to the GPU scene
 		GpuSceneDecal gpuDecal;
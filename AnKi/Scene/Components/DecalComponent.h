@@ -7,6 +7,7 @@
 
 #include <AnKi/Scene/Components/SceneComponent.h>
 #include <AnKi/Scene/GpuSceneArray.h>
+#include <AnKi/Scene/DynamicAabbTree.h>
 #include <AnKi/Resource/ImageAtlasResource.h>
 #include <AnKi/Collision/Obb.h>
 
@@ -77,6 +78,8 @@ private:
 
 	GpuSceneArrays::Decal::Allocation m_gpuSceneDecal;
 
+	U32 m_spatialIndexObject = DynamicAabbTree::kInvalidObject;
+
 	Bool m_dirty = true;
 
 	void setLayer(CString fname, F32 blendFactor, LayerType type);
@@ -8,6 +8,7 @@
 #include <AnKi/Scene/Components/SceneComponent.h>
 #include <AnKi/Scene/Frustum.h>
 #include <AnKi/Scene/GpuSceneArray.h>
+#include <AnKi/Scene/DynamicAabbTree.h>
 #include <AnKi/Collision/Aabb.h>
 
 namespace anki {
@@ -132,6 +133,8 @@ private:
 
 	GpuSceneArrays::GlobalIlluminationProbe::Allocation m_gpuSceneProbe;
 
+	U32 m_spatialIndexObject = DynamicAabbTree::kInvalidObject;
+
 	ShaderProgramResourcePtr m_clearTextureProg;
 
 	U32 m_uuid = 0;
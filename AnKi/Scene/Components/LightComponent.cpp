@@ -27,6 +27,8 @@ LightComponent::LightComponent(SceneNode* node)
 
 LightComponent::~LightComponent()
 {
+	SceneGraph::getSingleton().getSpatialIndex().tryDeleteObject(m_spatialIndexObject);
+
 	if(m_type == LightComponentType::kDirectional)
 	{
 		SceneGraph::getSingleton().removeDirectionalLight(this);
@@ -98,6 +100,13 @@ Error LightComponent::update(SceneComponentUpdateInfo& info, Bool& updated)
 			}
 		}
 
+		if(m_shapeDirty || moveUpdated)
+		{
+			const Vec3 center = m_worldTransform.getOrigin().xyz();
+			const Aabb aabb(center - m_point.m_radius, center + m_point.m_radius);
+			SceneGraph::getSingleton().getSpatialIndex().newOrMoveObject(m_spatialIndexObject, aabb, static_cast<SceneComponent*>(this));
+		}
+
 		// Upload to the GPU scene
 		GpuSceneLight gpuLight = {};
 		gpuLight.m_position = m_worldTransform.getOrigin().xyz();
@@ -163,10 +172,20 @@ Error LightComponent::update(SceneComponentUpdateInfo& info, Bool& updated)
 
 		Array<Vec3, 4> points;
 		computeEdgesOfFrustum(m_spot.m_distance, m_spot.m_outerAngle, m_spot.m_outerAngle, &points[0]);
+		Vec3 aabbMin = m_worldTransform.getOrigin().xyz();
+		Vec3 aabbMax = aabbMin;
 		for(U32 i = 0; i < 4; ++i)
 		{
 			points[i] = m_worldTransform.transform(points[i]);
 			gpuLight.m_edgePoints[i] = points[i].xyz0();
+			aabbMin = aabbMin.min(points[i]);
+			aabbMax = aabbMax.max(points[i]);
+		}
+
+		if(m_shapeDirty || moveUpdated)
+		{
+			SceneGraph::getSingleton().getSpatialIndex().newOrMoveObject(m_spatialIndexObject, Aabb(aabbMin, aabbMax),
+																		 static_cast<SceneComponent*>(this));
 		}
 
 		if(reallyShadow)
@@ -196,6 +215,9 @@ Error LightComponent::update(SceneComponentUpdateInfo& info, Bool& updated)
 	else if(m_type == LightComponentType::kDirectional)
 	{
 		m_gpuSceneLight.free();
+
+		// Directional lights are everywhere
+		SceneGraph::getSingleton().getSpatialIndex().tryDeleteObject(m_spatialIndexObject);
 	}
 
 	m_shapeDirty = false;
@@ -7,6 +7,7 @@
 
 #include <AnKi/Scene/Components/SceneComponent.h>
 #include <AnKi/Scene/GpuSceneArray.h>
+#include <AnKi/Scene/DynamicAabbTree.h>
 #include <AnKi/Math.h>
 #include <AnKi/Collision/Common.h>
 
@@ -189,6 +190,8 @@ private:
 	GpuSceneArrays::Light::Allocation m_gpuSceneLight;
 	GpuSceneArrays::LightVisibleRenderablesHash::Allocation m_hash;
 
+	U32 m_spatialIndexObject = DynamicAabbTree::kInvalidObject;
+
 	Array<Vec4, 6> m_shadowAtlasUvViewports;
 
 	U32 m_uuid = 0;
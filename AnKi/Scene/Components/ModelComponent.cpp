@@ -23,6 +23,7 @@ ModelComponent::ModelComponent(SceneNode* node)
 
 ModelComponent::~ModelComponent()
 {
+	SceneGraph::getSingleton().getSpatialIndex().tryDeleteObject(m_spatialIndexObject);
 }
 
 void ModelComponent::freeGpuScene()
@@ -133,7 +134,10 @@ Error ModelComponent::update(SceneComponentUpdateInfo& info, Bool& updated)
 	m_movedLastFrame = moved;
 	const Bool hasSkin = m_skinComponent != nullptr && m_skinComponent->isEnabled();
 
-	updated = resourceUpdated || moved || movedLastFrame;
+	const Bool fallbackVariants = m_fallbackVariants;
+	m_fallbackVariants = false;
+
+	updated = resourceUpdated || moved || movedLastFrame || fallbackVariants;
 
 	// Upload GpuSceneMeshLod, uniforms and GpuSceneRenderable
 	if(resourceUpdated) [[unlikely]]
@@ -260,10 +264,11 @@ Error ModelComponent::update(SceneComponentUpdateInfo& info, Bool& updated)
 	{
 		const Aabb aabbWorld = computeAabbWorldSpace(info.m_node->getWorldTransform());
 		SceneGraph::getSingleton().updateSceneBounds(aabbWorld.getMin().xyz(), aabbWorld.getMax().xyz());
+		SceneGraph::getSingleton().getSpatialIndex().newOrMoveObject(m_spatialIndexObject, aabbWorld, static_cast<SceneComponent*>(this));
 	}
 
 	// Update the buckets
-	const Bool bucketsNeedUpdate = resourceUpdated || moved != movedLastFrame;
+	const Bool bucketsNeedUpdate = resourceUpdated || moved != movedLastFrame || fallbackVariants;
 	if(bucketsNeedUpdate)
 	{
 		const U32 modelPatchCount = m_model->getModelPatches().getSize();
@@ -287,12 +292,17 @@ Error ModelComponent::update(SceneComponentUpdateInfo& info, Bool& updated)
 				key.setVelocity(moved);
 				key.setMeshletRendering(GrManager::getSingleton().getDeviceCapabilities().m_meshShaders || g_meshletRenderingCVar);
 
-				const MaterialVariant& mvariant = m_model->getModelPatches()[i].getMaterial()->getOrCreateVariant(key);
+				// Don't stall the frame if the variant needs compiling. Draw with a fallback and refresh the buckets later
+				const MaterialVariant* mvariant;
+				if(!m_model->getModelPatches()[i].getMaterial()->tryGetOrCreateVariant(key, mvariant))
+				{
+					m_fallbackVariants = true;
+				}
 
 				RenderStateInfo state;
 				state.m_primitiveTopology = PrimitiveTopology::kTriangles;
 				state.m_indexedDrawcall = true;
-				state.m_program = mvariant.getShaderProgram();
+				state.m_program = mvariant->getShaderProgram();
 
 				ModelPatchGeometryInfo inf;
 				m_model->getModelPatches()[i].getGeometryInfo(0, inf);
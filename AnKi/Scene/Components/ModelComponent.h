@@ -8,6 +8,7 @@
 #include <AnKi/Scene/Components/SceneComponent.h>
 #include <AnKi/Scene/RenderStateBucket.h>
 #include <AnKi/Scene/GpuSceneArray.h>
+#include <AnKi/Scene/DynamicAabbTree.h>
 #include <AnKi/Resource/Forward.h>
 #include <AnKi/Util/WeakArray.h>
 #include <AnKi/Collision/Aabb.h>
@@ -69,11 +70,14 @@ private:
 	GpuSceneBufferAllocation m_gpuSceneConstants;
 	GpuSceneArrays::Transform::Allocation m_gpuSceneTransforms;
 
+	U32 m_spatialIndexObject = DynamicAabbTree::kInvalidObject;
+
 	// Other stuff
 	Bool m_resourceChanged : 1 = true;
 	Bool m_castsShadow : 1 = false;
 	Bool m_movedLastFrame : 1 = true;
 	Bool m_firstTimeUpdate : 1 = true; ///< Extra flag in case the component is added in a node that hasn't been moved.
+	Bool m_fallbackVariants : 1 = false; ///< Some buckets use fallback material variants. Update them when the real ones are compiled.
 
 	RenderingTechniqueBit m_presentRenderingTechniques = RenderingTechniqueBit::kNone;
 
@@ -10,7 +10,7 @@ namespace anki {
 
 Error MoveComponent::update(SceneComponentUpdateInfo& info, Bool& updated)
 {
-	updated = info.m_node->updateTransform();
+	updated = info.m_node->movedThisFrame();
 	return Error::kNone;
 }
 
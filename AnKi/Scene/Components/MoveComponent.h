@@ -12,7 +12,7 @@ namespace anki {
 /// @addtogroup scene
 /// @{
 
-/// A simple implicit component that updates the SceneNode's transform.
+/// A simple implicit component that reports if the SceneNode moved. The world transforms are computed by the TransformHierarchy.
 class MoveComponent : public SceneComponent
 {
 	ANKI_SCENE_COMPONENT(MoveComponent)
@@ -34,6 +34,7 @@ ReflectionProbeComponent::ReflectionProbeComponent(SceneNode* node)
 
 ReflectionProbeComponent::~ReflectionProbeComponent()
 {
+	SceneGraph::getSingleton().getSpatialIndex().tryDeleteObject(m_spatialIndexObject);
 }
 
 Error ReflectionProbeComponent::update(SceneComponentUpdateInfo& info, Bool& updated)
@@ -62,6 +63,7 @@ Error ReflectionProbeComponent::update(SceneComponentUpdateInfo& info, Bool& upd
 		const Aabb aabbWorld(-m_halfSize + m_worldPos, m_halfSize + m_worldPos);
 		gpuProbe.m_aabbMin = aabbWorld.getMin().xyz();
 		gpuProbe.m_aabbMax = aabbWorld.getMax().xyz();
+		SceneGraph::getSingleton().getSpatialIndex().newOrMoveObject(m_spatialIndexObject, aabbWorld, static_cast<SceneComponent*>(this));
 
 		gpuProbe.m_uuid = m_uuid;
 		gpuProbe.m_componentArrayIndex = getArrayIndex();
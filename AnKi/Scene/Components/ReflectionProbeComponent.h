@@ -8,6 +8,7 @@
 #include <AnKi/Scene/Components/SceneComponent.h>
 #include <AnKi/Scene/Frustum.h>
 #include <AnKi/Scene/GpuSceneArray.h>
+#include <AnKi/Scene/DynamicAabbTree.h>
 #include <AnKi/Collision/Aabb.h>
 
 namespace anki {
@@ -84,6 +85,8 @@ private:
 
 	GpuSceneArrays::ReflectionProbe::Allocation m_gpuSceneProbe;
 
+	U32 m_spatialIndexObject = DynamicAabbTree::kInvalidObject;
+
 	TexturePtr m_reflectionTex;
 	U32 m_reflectionTexBindlessIndex = kMaxU32;
 	U32 m_uuid = 0;
@@ -74,9 +74,11 @@ class SceneComponent
 {
 public:
 	/// Construct the scene component.
-	SceneComponent([[maybe_unused]] SceneNode* node, SceneComponentType type)
-		: m_type(type)
+	SceneComponent(SceneNode* node, SceneComponentType type)
+		: m_ownerNode(node)
+		, m_type(type)
 	{
+		ANKI_ASSERT(node);
 	}
 
 	virtual ~SceneComponent() = default;
@@ -91,6 +93,12 @@ public:
 		return m_timestamp;
 	}
 
+	/// The node that owns the component.
+	ANKI_INTERNAL SceneNode& getSceneNode() const
+	{
+		return *m_ownerNode;
+	}
+
 	ANKI_INTERNAL U32 getArrayIndex() const
 	{
 		ANKI_ASSERT(m_arrayIdx != kMaxU32);
@@ -127,6 +135,7 @@ public:
 
 private:
 	Timestamp m_timestamp = 1; ///< Indicates when an update happened
+	SceneNode* m_ownerNode = nullptr;
 	U32 m_arrayIdx = kMaxU32;
 	SceneComponentType m_type; ///< Cache the type ID.
 
@@ -39,7 +39,7 @@ void ScriptComponent::loadScriptResource(CString fname)
 	// Exec the script
 	if(!err)
 	{
-		err = newEnv->evalString(m_script->getSource());
+		err = newEnv->evalBytecode(rsrc->getBytecode(), fname);
 	}
 
 	// Error
@@ -0,0 +1,290 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Scene/CpuVisibility.h>
+#include <AnKi/Util/ThreadJobManager.h>
+#include <AnKi/Util/Tracer.h>
+
+namespace anki {
+
+void CpuVisibilityBounds::resize(U32 count)
+{
+	// Pad the arrays so the SIMD loads never read outside
+	const U32 paddedCount = getAlignedRoundUp(kSimdWidth, count);
+	for(U32 c = 0; c < getComponentCount(); ++c)
+	{
+		const U32 oldSize = m_components[c].getSize();
+		m_components[c].resize(paddedCount);
+
+		for(U32 i = min(oldSize, min(m_count, count)); i < paddedCount; ++i)
+		{
+			// Invalid. AABBs get min > max and spheres a negative radius. Both are outside any plane
+			const Bool isMin = (m_shape == CpuVisibilityShape::kAabb && c < 3);
+			const Bool isRadius = (m_shape == CpuVisibilityShape::kSphere && c == 3);
+			m_components[c][i] = (isMin) ? kMaxF32 : ((m_shape == CpuVisibilityShape::kAabb || isRadius) ? kMinF32 : 0.0f);
+		}
+	}
+
+	m_count = count;
+}
+
+void CpuVisibilityBounds::setAabb(U32 idx, const Aabb& aabb)
+{
+	ANKI_ASSERT(m_shape == CpuVisibilityShape::kAabb && idx < m_count);
+	for(U32 c = 0; c < 3; ++c)
+	{
+		m_components[c][idx] = aabb.getMin()[c];
+		m_components[c + 3][idx] = aabb.getMax()[c];
+	}
+}
+
+void CpuVisibilityBounds::setSphere(U32 idx, const Sphere& sphere)
+{
+	ANKI_ASSERT(m_shape == CpuVisibilityShape::kSphere && idx < m_count);
+	for(U32 c = 0; c < 3; ++c)
+	{
+		m_components[c][idx] = sphere.getCenter()[c];
+	}
+	m_components[3][idx] = sphere.getRadius();
+}
+
+void CpuVisibilityBounds::invalidate(U32 idx)
+{
+	ANKI_ASSERT(idx < m_count);
+	if(m_shape == CpuVisibilityShape::kAabb)
+	{
+		for(U32 c = 0; c < 3; ++c)
+		{
+			m_components[c][idx] = kMaxF32;
+			m_components[c + 3][idx] = kMinF32;
+		}
+	}
+	else
+	{
+		m_components[3][idx] = kMinF32;
+	}
+}
+
+U32 CpuVisibilityBounds::cullRange(const CpuVisibilityQuery& query, U32 begin, U32 end, U32* indices, U8* lods) const
+{
+	ANKI_ASSERT(isAligned(kSimdWidth, begin) && isAligned(kSimdWidth, end));
+
+	constexpr U32 kMaxPlanes = 8;
+	constexpr U32 kMaxLods = 8;
+	ANKI_ASSERT(query.m_planes.getSize() > 0 && query.m_planes.getSize() <= kMaxPlanes);
+	ANKI_ASSERT(query.m_lodDistances.getSize() <= kMaxLods);
+
+	// Splat the planes once
+	const U32 planeCount = query.m_planes.getSize();
+	Array<Array<F32x4, 4>, kMaxPlanes> planes;
+	Array<Array<Bool, 3>, kMaxPlanes> positiveNormal;
+	for(U32 p = 0; p < planeCount; ++p)
+	{
+		const Plane& plane = query.m_planes[p];
+		for(U32 c = 0; c < 3; ++c)
+		{
+			planes[p][c] = F32x4(plane.getNormal()[c]);
+			positiveNormal[p][c] = plane.getNormal()[c] >= 0.0f;
+		}
+		planes[p][3] = F32x4(plane.getOffset());
+	}
+
+	const U32 lodCount = query.m_lodDistances.getSize();
+	Array<F32x4, kMaxLods> lodDistances;
+	for(U32 l = 0; l < lodCount; ++l)
+	{
+		lodDistances[l] = F32x4(query.m_lodDistances[l]);
+	}
+
+	const F32x4 originX(query.m_viewOrigin.x());
+	const F32x4 originY(query.m_viewOrigin.y());
+	const F32x4 originZ(query.m_viewOrigin.z());
+	const F32x4 maxDistance(query.m_maxDistance);
+	const F32x4 zero(0.0f);
+	const F32x4 one(1.0f);
+
+	U32 visibleCount = 0;
+	for(U32 i = begin; i < end; i += kSimdWidth)
+	{
+		F32x4 visible;
+		F32x4 distance;
+
+		if(m_shape == CpuVisibilityShape::kAabb)
+		{
+			const F32x4 minX = F32x4::load(&m_components[0][i]);
+			const F32x4 minY = F32x4::load(&m_components[1][i]);
+			const F32x4 minZ = F32x4::load(&m_components[2][i]);
+			const F32x4 maxX = F32x4::load(&m_components[3][i]);
+			const F32x4 maxY = F32x4::load(&m_components[4][i]);
+			const F32x4 maxZ = F32x4::load(&m_components[5][i]);
+
+			// Test the corner that is the furthest along the normal of each plane
+			visible = maxX >= minX;
+			for(U32 p = 0; p < planeCount; ++p)
+			{
+				const F32x4 px = (positiveNormal[p][0]) ? maxX : minX;
+				const F32x4 py = (positiveNormal[p][1]) ? maxY : minY;
+				const F32x4 pz = (positiveNormal[p][2]) ? maxZ : minZ;
+				const F32x4 dist = planes[p][0] * px + planes[p][1] * py + planes[p][2] * pz;
+				visible = visible & (dist >= planes[p][3]);
+			}
+
+			if(visible.getMask() == 0)
+			{
+				continue;
+			}
+
+			// Distance to the closest point of the box
+			const F32x4 dx = (minX - originX).max(originX - maxX).max(zero);
+			const F32x4 dy = (minY - originY).max(originY - maxY).max(zero);
+			const F32x4 dz = (minZ - originZ).max(originZ - maxZ).max(zero);
+			distance = (dx * dx + dy * dy + dz * dz).sqrt();
+		}
+		else
+		{
+			const F32x4 centerX = F32x4::load(&m_components[0][i]);
+			const F32x4 centerY = F32x4::load(&m_components[1][i]);
+			const F32x4 centerZ = F32x4::load(&m_components[2][i]);
+			const F32x4 radius = F32x4::load(&m_components[3][i]);
+
+			visible = radius >= zero;
+			for(U32 p = 0; p < planeCount; ++p)
+			{
+				const F32x4 dist = planes[p][0] * centerX + planes[p][1] * centerY + planes[p][2] * centerZ + radius;
+				visible = visible & (dist >= planes[p][3]);
+			}
+
+			if(visible.getMask() == 0)
+			{
+				continue;
+			}
+
+			const F32x4 dx = centerX - originX;
+			const F32x4 dy = centerY - originY;
+			const F32x4 dz = centerZ - originZ;
+			distance = ((dx * dx + dy * dy + dz * dz).sqrt() - radius).max(zero);
+		}
+
+		visible = visible & (maxDistance >= distance);
+		U32 mask = visible.getMask();
+		if(mask == 0)
+		{
+			continue;
+		}
+
+		// The LOD is the number of LOD distances that are smaller
+		Array<F32, kSimdWidth> lodsF;
+		if(lods)
+		{
+			F32x4 lod = zero;
+			for(U32 l = 0; l < lodCount; ++l)
+			{
+				lod = lod + ((distance > lodDistances[l]) & one);
+			}
+			lod.store(lodsF.getBegin());
+		}
+
+		while(mask)
+		{
+			const U32 lane = U32(__builtin_ctzll(mask));
+			mask &= mask - 1;
+
+			indices[visibleCount] = i + lane;
+			if(lods)
+			{
+				lods[visibleCount] = U8(lodsF[lane]);
+			}
+			++visibleCount;
+		}
+	}
+
+	return visibleCount;
+}
+
+void CpuVisibilityBounds::cull(CpuVisibilityQuery& query) const
+{
+	ANKI_TRACE_SCOPED_EVENT(CpuVisibility);
+	ANKI_ASSERT(query.m_visibleLods.getSize() == 0 || query.m_visibleLods.getSize() == query.m_visibleIndices.getSize());
+
+	const U32 end = getAlignedRoundUp(kSimdWidth, m_count);
+	const Bool wantLods = query.m_visibleLods.getSize() > 0;
+	const Bool outputFitsAll = query.m_visibleIndices.getSize() >= end;
+
+	if(!query.m_jobManager || end <= kObjectsPerJob)
+	{
+		if(outputFitsAll)
+		{
+			// Write directly to the output
+			query.m_visibleCount = cullRange(query, 0, end, query.m_visibleIndices.getBegin(), (wantLods) ? query.m_visibleLods.getBegin() : nullptr);
+		}
+		else
+		{
+			// Go through a temp array that can hold a whole job
+			Array<U32, kObjectsPerJob> indices;
+			Array<U8, kObjectsPerJob> lods;
+			U32 visibleCount = 0;
+			for(U32 begin = 0; begin < end; begin += kObjectsPerJob)
+			{
+				const U32 count = cullRange(query, begin, min(end, begin + kObjectsPerJob), indices.getBegin(), lods.getBegin());
+				const U32 copyCount = min(count, query.m_visibleIndices.getSize() - visibleCount);
+				memcpy(&query.m_visibleIndices[visibleCount], indices.getBegin(), copyCount * sizeof(U32));
+				if(wantLods)
+				{
+					memcpy(&query.m_visibleLods[visibleCount], lods.getBegin(), copyCount);
+				}
+				visibleCount += copyCount;
+			}
+
+			query.m_visibleCount = visibleCount;
+		}
+
+		return;
+	}
+
+	// Each job culls into a local array and then copies the visible to the output
+	const U32 jobCount = (end + kObjectsPerJob - 1) / kObjectsPerJob;
+	Atomic<U32> jobIdx = {0};
+	Atomic<U32> visibleCount = {0};
+
+	const U32 taskCount = min(jobCount, query.m_jobManager->getThreadCount());
+	for(U32 t = 0; t < taskCount; ++t)
+	{
+		query.m_jobManager->dispatchTask([&]([[maybe_unused]] U32 tid) {
+			ANKI_TRACE_SCOPED_EVENT(CpuVisibilityJob);
+
+			Array<U32, kObjectsPerJob> indices;
+			Array<U8, kObjectsPerJob> lods;
+
+			U32 job;
+			while((job = jobIdx.fetchAdd(1)) < jobCount)
+			{
+				const U32 begin = job * kObjectsPerJob;
+				const U32 count = cullRange(query, begin, min(end, begin + kObjectsPerJob), indices.getBegin(), lods.getBegin());
+				if(count == 0)
+				{
+					continue;
+				}
+
+				const U32 offset = visibleCount.fetchAdd(count);
+				if(offset >= query.m_visibleIndices.getSize())
+				{
+					continue;
+				}
+
+				const U32 copyCount = min(count, query.m_visibleIndices.getSize() - offset);
+				memcpy(&query.m_visibleIndices[offset], indices.getBegin(), copyCount * sizeof(U32));
+				if(wantLods)
+				{
+					memcpy(&query.m_visibleLods[offset], lods.getBegin(), copyCount);
+				}
+			}
+		});
+	}
+
+	query.m_jobManager->waitForAllTasksToFinish();
+	query.m_visibleCount = min(visibleCount.load(), query.m_visibleIndices.getSize());
+}
+
+} // end namespace anki
@@ -0,0 +1,117 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Scene/Common.h>
+#include <AnKi/Collision/Aabb.h>
+#include <AnKi/Collision/Sphere.h>
+#include <AnKi/Collision/Plane.h>
+#include <AnKi/Util/DynamicArray.h>
+#include <AnKi/Util/WeakArray.h>
+
+namespace anki {
+
+/// @addtogroup scene
+/// @{
+
+/// The shape of the volumes of CpuVisibilityBounds.
+enum class CpuVisibilityShape : U8
+{
+	kAabb,
+	kSphere
+};
+
+/// Input and output of CpuVisibilityBounds::cull.
+class CpuVisibilityQuery
+{
+public:
+	/// The planes to test against. Typically Frustum::getViewPlanes(). The normals should point inwards. Can't be empty and up to 8.
+	ConstWeakArray<Plane> m_planes;
+
+	/// Used for the distance culling and the LOD selection.
+	Vec3 m_viewOrigin = Vec3(0.0f);
+
+	/// Objects further than that are culled. The distance is from m_viewOrigin to the closest point of the volume.
+	F32 m_maxDistance = kMaxF32;
+
+	/// Optional. Ascending distances. An object gets the LOD that is equal to the number of distances that are smaller than its distance.
+	ConstWeakArray<F32> m_lodDistances;
+
+	/// Optional. If present the work will be split across the threads of the job manager.
+	ThreadJobManager* m_jobManager = nullptr;
+
+	/// The indices of the visible objects. If the array is too small the remaining objects are dropped. When a job manager is used the indices
+	/// are not sorted.
+	WeakArray<U32> m_visibleIndices;
+
+	/// Optional. The LOD of each visible object. Same size as m_visibleIndices.
+	WeakArray<U8> m_visibleLods;
+
+	/// Written by CpuVisibilityBounds::cull. The number of indices written to m_visibleIndices.
+	U32 m_visibleCount = 0;
+};
+
+/// Holds the bounding volumes of many objects in a structure of arrays layout so they can be culled 4 at a time with SIMD. The arrays are
+/// indexed by the same indices the user uses for its objects (eg the index of the component in its array). Free slots are never visible.
+class CpuVisibilityBounds
+{
+public:
+	/// The number of objects culled per SIMD iteration.
+	static constexpr U32 kSimdWidth = F32x4::kLaneCount;
+
+	CpuVisibilityBounds(CpuVisibilityShape shape)
+		: m_shape(shape)
+	{
+	}
+
+	CpuVisibilityShape getShape() const
+	{
+		return m_shape;
+	}
+
+	U32 getSize() const
+	{
+		return m_count;
+	}
+
+	/// Change the number of objects. The new objects are not visible.
+	/// @note Not thread-safe.
+	void resize(U32 count);
+
+	/// @note Thread-safe if different threads touch different objects.
+	void setAabb(U32 idx, const Aabb& aabb);
+
+	/// @note Thread-safe if different threads touch different objects.
+	void setSphere(U32 idx, const Sphere& sphere);
+
+	/// Make an object never visible.
+	/// @note Thread-safe if different threads touch different objects.
+	void invalidate(U32 idx);
+
+	/// Test all the objects against some planes and gather the visible.
+	/// @note It's not thread-safe to call it from a job of CpuVisibilityQuery::m_jobManager.
+	void cull(CpuVisibilityQuery& query) const;
+
+private:
+	static constexpr U32 kObjectsPerJob = 2048; ///< Keep it a multiple of kSimdWidth.
+
+	/// AABBs: min x, min y, min z, max x, max y, max z. Spheres: center x, center y, center z, radius.
+	Array<SceneDynamicArray<F32>, 6> m_components;
+
+	U32 m_count = 0;
+	CpuVisibilityShape m_shape;
+
+	U32 getComponentCount() const
+	{
+		return (m_shape == CpuVisibilityShape::kAabb) ? 6 : 4;
+	}
+
+	/// Cull [begin, end) and write the visible to the arrays.
+	U32 cullRange(const CpuVisibilityQuery& query, U32 begin, U32 end, U32* indices, U8* lods) const;
+};
+/// @}
+
+} // end namespace anki
@@ -0,0 +1,505 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Scene/DynamicAabbTree.h>
+#include <AnKi/Util/ThreadJobManager.h>
+#include <AnKi/Util/Tracer.h>
+
+namespace anki {
+
+/// How much to extend the fat AABBs towards the direction the objects move.
+constexpr F32 kDisplacementMultiplier = 2.0f;
+
+/// Leaves whose fat AABB got that much bigger than needed get re-inserted.
+constexpr F32 kMaxFatSurfaceAreaRatio = 4.0f;
+
+U32 DynamicAabbTree::newObject(const Aabb& aabb, void* userData)
+{
+	LockGuard lock(m_pendingMtx);
+
+	U32 objectIdx;
+	if(m_freeObject != kInvalidObject)
+	{
+		objectIdx = m_freeObject;
+		m_freeObject = m_objects[objectIdx].m_leaf;
+	}
+	else
+	{
+		objectIdx = m_objects.getSize();
+		m_objects.emplaceBack();
+	}
+
+	m_objects[objectIdx].m_userData = userData;
+	m_objects[objectIdx].m_leaf = kInvalidNode;
+
+	Pending& pending = *m_pending.emplaceBack();
+	pending.m_min = aabb.getMin().xyz();
+	pending.m_max = aabb.getMax().xyz();
+	pending.m_objectIdx = objectIdx;
+	pending.m_operation = PendingOperation::kMove;
+
+	return objectIdx;
+}
+
+void DynamicAabbTree::moveObject(U32 objectIdx, const Aabb& aabb)
+{
+	LockGuard lock(m_pendingMtx);
+	ANKI_ASSERT(objectIdx < m_objects.getSize());
+
+	Pending& pending = *m_pending.emplaceBack();
+	pending.m_min = aabb.getMin().xyz();
+	pending.m_max = aabb.getMax().xyz();
+	pending.m_objectIdx = objectIdx;
+	pending.m_operation = PendingOperation::kMove;
+}
+
+void DynamicAabbTree::deleteObject(U32 objectIdx)
+{
+	LockGuard lock(m_pendingMtx);
+	ANKI_ASSERT(objectIdx < m_objects.getSize());
+
+	Pending& pending = *m_pending.emplaceBack();
+	pending.m_objectIdx = objectIdx;
+	pending.m_operation = PendingOperation::kDelete;
+}
+
+void DynamicAabbTree::flush()
+{
+	if(m_pending.getSize() == 0)
+	{
+		return;
+	}
+
+	ANKI_TRACE_SCOPED_EVENT(DynamicAabbTreeFlush);
+
+	for(const Pending& pending : m_pending)
+	{
+		if(pending.m_operation == PendingOperation::kMove)
+		{
+			applyMove(pending);
+		}
+		else
+		{
+			applyDelete(pending.m_objectIdx);
+		}
+	}
+
+	m_pending.resize(0);
+}
+
+void DynamicAabbTree::applyMove(const Pending& pending)
+{
+	Object& obj = m_objects[pending.m_objectIdx];
+
+	Vec3 displacement(0.0f);
+	if(obj.m_leaf != kInvalidNode)
+	{
+		const Node& leaf = m_nodes[obj.m_leaf];
+
+		// A zero margin means the leaves are always tight
+		if(m_fatMargin > 0.0f)
+		{
+			// Skip if the fat AABB still contains the object and it's not too big
+			const F32 fatArea = surfaceArea(leaf.m_min, leaf.m_max);
+			const F32 neededArea = surfaceArea(pending.m_min - m_fatMargin, pending.m_max + m_fatMargin);
+			if(aabbContains(leaf.m_min, leaf.m_max, pending.m_min, pending.m_max) && fatArea <= neededArea * kMaxFatSurfaceAreaRatio)
+			{
+				return;
+			}
+
+			displacement = (pending.m_min + pending.m_max - leaf.m_min - leaf.m_max) * 0.5f;
+		}
+
+		removeLeaf(obj.m_leaf);
+	}
+	else
+	{
+		obj.m_leaf = newNode();
+		Node& leaf = m_nodes[obj.m_leaf];
+		leaf.m_height = 0;
+		leaf.m_children = {kInvalidNode, kInvalidNode};
+		leaf.m_userData = obj.m_userData;
+		leaf.m_objectIdx = pending.m_objectIdx;
+		++m_leafCount;
+	}
+
+	Node& leaf = m_nodes[obj.m_leaf];
+	leaf.m_min = pending.m_min - m_fatMargin + displacement.min(Vec3(0.0f)) * kDisplacementMultiplier;
+	leaf.m_max = pending.m_max + m_fatMargin + displacement.max(Vec3(0.0f)) * kDisplacementMultiplier;
+
+	insertLeaf(obj.m_leaf);
+}
+
+void DynamicAabbTree::applyDelete(U32 objectIdx)
+{
+	Object& obj = m_objects[objectIdx];
+
+	if(obj.m_leaf != kInvalidNode)
+	{
+		removeLeaf(obj.m_leaf);
+		deleteNode(obj.m_leaf);
+		--m_leafCount;
+	}
+
+	obj.m_userData = nullptr;
+	obj.m_leaf = m_freeObject;
+	m_freeObject = objectIdx;
+}
+
+U32 DynamicAabbTree::newNode()
+{
+	U32 idx;
+	if(m_freeNode != kInvalidNode)
+	{
+		idx = m_freeNode;
+		m_freeNode = m_nodes[idx].m_parent;
+	}
+	else
+	{
+		idx = m_nodes.getSize();
+		m_nodes.emplaceBack();
+	}
+
+	Node& node = m_nodes[idx];
+	node.m_parent = kInvalidNode;
+	node.m_height = 0;
+	node.m_children = {kInvalidNode, kInvalidNode};
+	node.m_userData = nullptr;
+	node.m_objectIdx = kInvalidObject;
+	return idx;
+}
+
+void DynamicAabbTree::deleteNode(U32 idx)
+{
+	m_nodes[idx].m_height = -1;
+	m_nodes[idx].m_parent = m_freeNode;
+	m_freeNode = idx;
+}
+
+void DynamicAabbTree::insertLeaf(U32 leaf)
+{
+	if(m_root == kInvalidNode)
+	{
+		m_root = leaf;
+		m_nodes[leaf].m_parent = kInvalidNode;
+		return;
+	}
+
+	// Find the best sibling. Go down the tree picking the child with the lowest cost where the cost is the area of the new node plus the area
+	// that the ancestors will grow
+	const Vec3 leafMin = m_nodes[leaf].m_min;
+	const Vec3 leafMax = m_nodes[leaf].m_max;
+	U32 idx = m_root;
+	while(!m_nodes[idx].isLeaf())
+	{
+		const Node& node = m_nodes[idx];
+
+		const F32 area = surfaceArea(node.m_min, node.m_max);
+		const F32 combinedArea = surfaceArea(node.m_min.min(leafMin), node.m_max.max(leafMax));
+
+		// Cost of making a new parent for this node and the new leaf
+		const F32 cost = 2.0f * combinedArea;
+
+		// Minimum cost of pushing the leaf further down the tree
+		const F32 inheritanceCost = 2.0f * (combinedArea - area);
+
+		Array<F32, 2> childCosts;
+		for(U32 i = 0; i < 2; ++i)
+		{
+			const Node& child = m_nodes[node.m_children[i]];
+			const F32 newArea = surfaceArea(child.m_min.min(leafMin), child.m_max.max(leafMax));
+			childCosts[i] = (child.isLeaf()) ? newArea + inheritanceCost : newArea - surfaceArea(child.m_min, child.m_max) + inheritanceCost;
+		}
+
+		if(cost < childCosts[0] && cost < childCosts[1])
+		{
+			break;
+		}
+
+		idx = (childCosts[0] < childCosts[1]) ? node.m_children[0] : node.m_children[1];
+	}
+
+	// Create a new parent
+	const U32 sibling = idx;
+	const U32 oldParent = m_nodes[sibling].m_parent;
+	const U32 newParent = newNode();
+	{
+		Node& parent = m_nodes[newParent];
+		parent.m_parent = oldParent;
+		parent.m_min = m_nodes[sibling].m_min.min(leafMin);
+		parent.m_max = m_nodes[sibling].m_max.max(leafMax);
+		parent.m_height = m_nodes[sibling].m_height + 1;
+		parent.m_children = {sibling, leaf};
+	}
+
+	if(oldParent != kInvalidNode)
+	{
+		Node& parent = m_nodes[oldParent];
+		parent.m_children[(parent.m_children[0] == sibling) ? 0 : 1] = newParent;
+	}
+	else
+	{
+		m_root = newParent;
+	}
+
+	m_nodes[sibling].m_parent = newParent;
+	m_nodes[leaf].m_parent = newParent;
+
+	refitAncestors(m_nodes[leaf].m_parent);
+}
+
+void DynamicAabbTree::removeLeaf(U32 leaf)
+{
+	if(leaf == m_root)
+	{
+		m_root = kInvalidNode;
+		return;
+	}
+
+	const U32 parent = m_nodes[leaf].m_parent;
+	const U32 grandParent = m_nodes[parent].m_parent;
+	const U32 sibling = (m_nodes[parent].m_children[0] == leaf) ? m_nodes[parent].m_children[1] : m_nodes[parent].m_children[0];
+
+	// Replace the parent with the sibling
+	m_nodes[sibling].m_parent = grandParent;
+	if(grandParent != kInvalidNode)
+	{
+		Node& node = m_nodes[grandParent];
+		node.m_children[(node.m_children[0] == parent) ? 0 : 1] = sibling;
+		deleteNode(parent);
+		refitAncestors(grandParent);
+	}
+	else
+	{
+		m_root = sibling;
+		deleteNode(parent);
+	}
+
+	m_nodes[leaf].m_parent = kInvalidNode;
+}
+
+void DynamicAabbTree::refitAncestors(U32 idx)
+{
+	while(idx != kInvalidNode)
+	{
+		idx = balance(idx);
+
+		Node& node = m_nodes[idx];
+		const Node& child0 = m_nodes[node.m_children[0]];
+		const Node& child1 = m_nodes[node.m_children[1]];
+		node.m_height = 1 + max(child0.m_height, child1.m_height);
+		node.m_min = child0.m_min.min(child1.m_min);
+		node.m_max = child0.m_max.max(child1.m_max);
+
+		idx = node.m_parent;
+	}
+}
+
+U32 DynamicAabbTree::balance(U32 idxA)
+{
+	Node& a = m_nodes[idxA];
+	if(a.isLeaf() || a.m_height < 2)
+	{
+		return idxA;
+	}
+
+	// Children of A
+	const U32 idxB = a.m_children[0];
+	const U32 idxC = a.m_children[1];
+	Node& b = m_nodes[idxB];
+	Node& c = m_nodes[idxC];
+
+	const I32 balance = c.m_height - b.m_height;
+
+	// Rotate the taller child up. Same as the AVL trees
+	auto rotate = [&](U32 idxUp, Node& up, U32 upSlot, Node& other) -> U32 {
+		const U32 idxF = up.m_children[0];
+		const U32 idxG = up.m_children[1];
+		Node& f = m_nodes[idxF];
+		Node& g = m_nodes[idxG];
+
+		// Swap A and the child that goes up
+		up.m_children[0] = idxA;
+		up.m_parent = a.m_parent;
+		a.m_parent = idxUp;
+
+		if(up.m_parent != kInvalidNode)
+		{
+			Node& parent = m_nodes[up.m_parent];
+			parent.m_children[(parent.m_children[0] == idxA) ? 0 : 1] = idxUp;
+		}
+		else
+		{
+			m_root = idxUp;
+		}
+
+		// The taller grandchild stays with the node that goes up and the other one goes to A
+		const Bool fTaller = f.m_height > g.m_height;
+		const U32 idxKeep = (fTaller) ? idxF : idxG;
+		const U32 idxMove = (fTaller) ? idxG : idxF;
+		Node& keep = m_nodes[idxKeep];
+		Node& move = m_nodes[idxMove];
+
+		up.m_children[1] = idxKeep;
+		a.m_children[upSlot] = idxMove;
+		move.m_parent = idxA;
+
+		a.m_min = other.m_min.min(move.m_min);
+		a.m_max = other.m_max.max(move.m_max);
+		a.m_height = 1 + max(other.m_height, move.m_height);
+
+		up.m_min = a.m_min.min(keep.m_min);
+		up.m_max = a.m_max.max(keep.m_max);
+		up.m_height = 1 + max(a.m_height, keep.m_height);
+
+		return idxUp;
+	};
+
+	if(balance > 1)
+	{
+		return rotate(idxC, c, 1, b);
+	}
+	else if(balance < -1)
+	{
+		return rotate(idxB, b, 0, c);
+	}
+
+	return idxA;
+}
+
+void DynamicAabbTree::validate() const
+{
+	if(m_root == kInvalidNode)
+	{
+		ANKI_ASSERT(m_leafCount == 0);
+		return;
+	}
+
+	ANKI_ASSERT(m_nodes[m_root].m_parent == kInvalidNode);
+
+	U32 leafCount = 0;
+	SceneDynamicArray<U32> stack;
+	stack.emplaceBack(m_root);
+	while(stack.getSize())
+	{
+		const U32 idx = stack.getBack();
+		stack.popBack();
+		const Node& node = m_nodes[idx];
+
+		if(node.isLeaf())
+		{
+			ANKI_ASSERT(node.m_height == 0);
+			ANKI_ASSERT(m_objects[node.m_objectIdx].m_leaf == idx);
+			++leafCount;
+			continue;
+		}
+
+		const Node& child0 = m_nodes[node.m_children[0]];
+		const Node& child1 = m_nodes[node.m_children[1]];
+		ANKI_ASSERT(child0.m_parent == idx && child1.m_parent == idx);
+		ANKI_ASSERT(node.m_height == 1 + max(child0.m_height, child1.m_height));
+		ANKI_ASSERT(absolute(child0.m_height - child1.m_height) <= 1);
+		ANKI_ASSERT(node.m_min == child0.m_min.min(child1.m_min) && node.m_max == child0.m_max.max(child1.m_max));
+		(void)child0;
+		(void)child1;
+
+		stack.emplaceBack(node.m_children[0]);
+		stack.emplaceBack(node.m_children[1]);
+	}
+
+	ANKI_ASSERT(leafCount == m_leafCount);
+	(void)leafCount;
+}
+
+void DynamicAabbTree::runQuery(const SpatialQuery& query, SpatialQueryResult& result, SpatialQueryBatch& batch, Atomic<U32>& objectCount,
+							   SceneDynamicArray<void*>& tmpObjects) const
+{
+	// Gather the objects in a temp array first so the objects of the query end up in a contiguous range. The array is reused between queries
+	// so only grow it
+	U32 tmpCount = 0;
+	auto visit = [&](void* userData) {
+		if(tmpCount == tmpObjects.getSize())
+		{
+			tmpObjects.resize(max(64u, tmpCount * 2));
+		}
+		tmpObjects[tmpCount++] = userData;
+	};
+
+	switch(query.m_type)
+	{
+	case SpatialQueryType::kAabb:
+		queryAabb(Aabb(query.m_from, query.m_to), visit);
+		break;
+	case SpatialQueryType::kSphere:
+		querySphere(Sphere(query.m_from, query.m_radius), visit);
+		break;
+	case SpatialQueryType::kRay:
+		queryRay(query.m_from, query.m_to, visit);
+		break;
+	case SpatialQueryType::kFrustum:
+		queryPlanes(query.m_planes, visit);
+		break;
+	default:
+		ANKI_ASSERT(0);
+	}
+
+	const U32 offset = (tmpCount) ? objectCount.fetchAdd(tmpCount) : 0;
+	const U32 count = (offset < batch.m_objects.getSize()) ? min(tmpCount, batch.m_objects.getSize() - offset) : 0;
+	if(count)
+	{
+		memcpy(&batch.m_objects[offset], tmpObjects.getBegin(), count * sizeof(void*));
+	}
+
+	result.m_objectsOffset = offset;
+	result.m_objectCount = count;
+}
+
+void DynamicAabbTree::queries(SpatialQueryBatch& batch) const
+{
+	ANKI_TRACE_SCOPED_EVENT(DynamicAabbTreeQueries);
+	ANKI_ASSERT(batch.m_results.getSize() >= batch.m_queries.getSize());
+	ANKI_ASSERT(batch.m_queriesPerJob > 0);
+
+	Atomic<U32> objectCount = {0};
+	const U32 queryCount = batch.m_queries.getSize();
+
+	if(!batch.m_jobManager || queryCount <= batch.m_queriesPerJob)
+	{
+		SceneDynamicArray<void*> tmpObjects;
+		for(U32 i = 0; i < queryCount; ++i)
+		{
+			runQuery(batch.m_queries[i], batch.m_results[i], batch, objectCount, tmpObjects);
+		}
+	}
+	else
+	{
+		const U32 jobCount = (queryCount + batch.m_queriesPerJob - 1) / batch.m_queriesPerJob;
+		Atomic<U32> jobIdx = {0};
+
+		const U32 taskCount = min(jobCount, batch.m_jobManager->getThreadCount());
+		for(U32 i = 0; i < taskCount; ++i)
+		{
+			batch.m_jobManager->dispatchTask([&]([[maybe_unused]] U32 tid) {
+				SceneDynamicArray<void*> tmpObjects;
+				U32 job;
+				while((job = jobIdx.fetchAdd(1)) < jobCount)
+				{
+					const U32 begin = job * batch.m_queriesPerJob;
+					const U32 end = min(queryCount, begin + batch.m_queriesPerJob);
+					for(U32 q = begin; q < end; ++q)
+					{
+						runQuery(batch.m_queries[q], batch.m_results[q], batch, objectCount, tmpObjects);
+					}
+				}
+			});
+		}
+
+		batch.m_jobManager->waitForAllTasksToFinish();
+	}
+
+	batch.m_objectCount = min(objectCount.load(), batch.m_objects.getSize());
+}
+
+} // end namespace anki
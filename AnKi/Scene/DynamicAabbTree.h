@@ -0,0 +1,370 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Scene/Common.h>
+#include <AnKi/Collision/Aabb.h>
+#include <AnKi/Collision/Sphere.h>
+#include <AnKi/Collision/Plane.h>
+#include <AnKi/Util/DynamicArray.h>
+#include <AnKi/Util/WeakArray.h>
+#include <AnKi/Util/Thread.h>
+#include <AnKi/Util/Atomic.h>
+
+namespace anki {
+
+/// @addtogroup scene
+/// @{
+
+/// The type of a SpatialQuery.
+enum class SpatialQueryType : U8
+{
+	kAabb,
+	kSphere,
+	kRay,
+	kFrustum,
+
+	kCount
+};
+
+/// A single query of a SpatialQueryBatch.
+class SpatialQuery
+{
+public:
+	Vec3 m_from = Vec3(0.0f); ///< Min of the box, center of the sphere or start of the ray.
+	Vec3 m_to = Vec3(0.0f); ///< Max of the box or end of the ray. Ignored by the rest.
+	F32 m_radius = 0.0f; ///< Radius of the sphere. Ignored by the rest.
+	ConstWeakArray<Plane> m_planes; ///< The planes of a frustum (or any convex volume). Ignored by the rest.
+	SpatialQueryType m_type = SpatialQueryType::kAabb;
+};
+
+/// The result of a SpatialQuery.
+class SpatialQueryResult
+{
+public:
+	U32 m_objectsOffset = 0; ///< Where the objects start in SpatialQueryBatch::m_objects.
+	U32 m_objectCount = 0; ///< The number of objects written in SpatialQueryBatch::m_objects.
+};
+
+/// A batch of spatial queries. Results are written to flat arrays.
+class SpatialQueryBatch
+{
+public:
+	ConstWeakArray<SpatialQuery> m_queries;
+
+	/// One result per query.
+	WeakArray<SpatialQueryResult> m_results;
+
+	/// The user data of the objects of all queries. Each query writes into a sub-range of the array. If the array is too small the remaining
+	/// objects are dropped.
+	WeakArray<void*> m_objects;
+
+	/// Optional. If present the queries will be split across the threads of the job manager.
+	ThreadJobManager* m_jobManager = nullptr;
+
+	/// The number of queries a single job processes.
+	U32 m_queriesPerJob = 16;
+
+	/// Written by DynamicAabbTree::queries. The total number of objects written to m_objects.
+	U32 m_objectCount = 0;
+};
+
+/// An incremental bounding volume hierarchy of AABBs. The leaves store fat AABBs so objects that move a little don't touch the tree. New leaves
+/// are placed using the surface area heuristic and the tree is kept balanced with rotations.
+/// The modifications (newObject, moveObject and deleteObject) are thread-safe and are deferred until flush(). That way the queries can run from
+/// any thread and they see the tree as it was after the last flush().
+class DynamicAabbTree
+{
+public:
+	static constexpr U32 kInvalidObject = kMaxU32;
+
+	/// @param fatMargin How much to grow the AABBs of the leaves. If it's zero the leaves are tight and every move touches the tree.
+	DynamicAabbTree(F32 fatMargin = 0.1f)
+		: m_fatMargin(fatMargin)
+	{
+		ANKI_ASSERT(fatMargin >= 0.0f);
+	}
+
+	DynamicAabbTree(const DynamicAabbTree&) = delete;
+
+	DynamicAabbTree& operator=(const DynamicAabbTree&) = delete;
+
+	/// Add a new object. It will be visible to the queries after the next flush().
+	/// @note It's thread-safe.
+	U32 newObject(const Aabb& aabb, void* userData);
+
+	/// Change the bounds of an object.
+	/// @note It's thread-safe.
+	void moveObject(U32 objectIdx, const Aabb& aabb);
+
+	/// Remove an object. The index can't be used after that.
+	/// @note It's thread-safe.
+	void deleteObject(U32 objectIdx);
+
+	/// Convenience method that creates the object if it doesn't exist or moves it if it does.
+	/// @note It's thread-safe.
+	void newOrMoveObject(U32& objectIdx, const Aabb& aabb, void* userData)
+	{
+		if(objectIdx == kInvalidObject)
+		{
+			objectIdx = newObject(aabb, userData);
+		}
+		else
+		{
+			moveObject(objectIdx, aabb);
+		}
+	}
+
+	/// Convenience method that deletes the object if it exists.
+	/// @note It's thread-safe.
+	void tryDeleteObject(U32& objectIdx)
+	{
+		if(objectIdx != kInvalidObject)
+		{
+			deleteObject(objectIdx);
+			objectIdx = kInvalidObject;
+		}
+	}
+
+	/// Apply the pending modifications.
+	/// @note Not thread-safe. Nothing else should be touching the tree.
+	void flush();
+
+	/// Visit the objects that overlap an AABB. The functor is called with the user data of the objects.
+	template<typename TFunc>
+	void queryAabb(const Aabb& aabb, TFunc func) const
+	{
+		const Vec3 qmin = aabb.getMin().xyz();
+		const Vec3 qmax = aabb.getMax().xyz();
+		traverse(
+			[&](const Vec3& min, const Vec3& max) {
+				return aabbsOverlap(min, max, qmin, qmax);
+			},
+			func);
+	}
+
+	/// Visit the objects that overlap a sphere. The functor is called with the user data of the objects.
+	template<typename TFunc>
+	void querySphere(const Sphere& sphere, TFunc func) const
+	{
+		const Vec3 center = sphere.getCenter().xyz();
+		const F32 radiusSq = sphere.getRadius() * sphere.getRadius();
+		traverse(
+			[&](const Vec3& min, const Vec3& max) {
+				const Vec3 closest = center.max(min).min(max);
+				return (closest - center).getLengthSquared() <= radiusSq;
+			},
+			func);
+	}
+
+	/// Visit the objects whose bounds are hit by the segment [from, to]. The objects are not sorted by distance.
+	template<typename TFunc>
+	void queryRay(const Vec3& from, const Vec3& to, TFunc func) const
+	{
+		const Vec3 dir = to - from;
+		const Vec3 invDir(1.0f / dir.x(), 1.0f / dir.y(), 1.0f / dir.z()); // Infinities are fine
+		traverse(
+			[&](const Vec3& min, const Vec3& max) {
+				return segmentHitsAabb(from, invDir, min, max);
+			},
+			func);
+	}
+
+	/// Visit the objects that are inside or intersect a convex volume defined by some planes (eg the planes of a Frustum). The normals should
+	/// point inwards.
+	template<typename TFunc>
+	void queryPlanes(ConstWeakArray<Plane> planes, TFunc func) const
+	{
+		traverse(
+			[&](const Vec3& min, const Vec3& max) {
+				for(const Plane& plane : planes)
+				{
+					// Test the corner that is the furthest along the normal
+					const Vec3 n = plane.getNormal().xyz();
+					const Vec3 p((n.x() >= 0.0f) ? max.x() : min.x(), (n.y() >= 0.0f) ? max.y() : min.y(), (n.z() >= 0.0f) ? max.z() : min.z());
+					if(n.dot(p) < plane.getOffset())
+					{
+						return false;
+					}
+				}
+				return true;
+			},
+			func);
+	}
+
+	/// Run a batch of queries.
+	/// @note It's not thread-safe to call it from a job of SpatialQueryBatch::m_jobManager.
+	void queries(SpatialQueryBatch& batch) const;
+
+	/// Number of objects in the tree (excluding the ones pending insertion).
+	U32 getObjectCount() const
+	{
+		return m_leafCount;
+	}
+
+	/// The height of the tree. 0 for a single leaf.
+	U32 getHeight() const
+	{
+		return (m_root != kInvalidNode) ? U32(m_nodes[m_root].m_height) : 0;
+	}
+
+	/// Check the structure of the tree. Only for debugging.
+	void validate() const;
+
+private:
+	static constexpr U32 kInvalidNode = kMaxU32;
+	static constexpr U32 kMaxStackSize = 128; ///< The tree is balanced so that's way more than needed. See traverse().
+
+	class Node
+	{
+	public:
+		Vec3 m_min;
+		U32 m_parent; ///< Next free node if the node is free.
+		Vec3 m_max;
+		I32 m_height; ///< 0 for leaves and -1 for free nodes.
+		Array<U32, 2> m_children;
+		void* m_userData;
+		U32 m_objectIdx;
+
+		Bool isLeaf() const
+		{
+			return m_children[0] == kInvalidNode;
+		}
+	};
+
+	class Object
+	{
+	public:
+		void* m_userData = nullptr;
+		U32 m_leaf = kInvalidNode; ///< Next free object if the object is free.
+	};
+
+	enum class PendingOperation : U8
+	{
+		kMove,
+		kDelete
+	};
+
+	class Pending
+	{
+	public:
+		Vec3 m_min;
+		U32 m_objectIdx;
+		Vec3 m_max;
+		PendingOperation m_operation;
+	};
+
+	SceneDynamicArray<Node> m_nodes;
+	U32 m_root = kInvalidNode;
+	U32 m_freeNode = kInvalidNode;
+	U32 m_leafCount = 0;
+
+	SceneDynamicArray<Object> m_objects;
+	U32 m_freeObject = kInvalidObject;
+
+	SceneDynamicArray<Pending> m_pending;
+	SpinLock m_pendingMtx;
+
+	F32 m_fatMargin;
+
+	template<typename TTestFunc, typename TFunc>
+	void traverse(TTestFunc testAabb, TFunc func) const
+	{
+		if(m_root == kInvalidNode)
+		{
+			return;
+		}
+
+		// The tree is balanced so the fixed stack is enough. Fall back to the heap if a degenerate tree fills it
+		Array<U32, kMaxStackSize> fixedStack;
+		SceneDynamicArray<U32> heapStack;
+		U32* stack = &fixedStack[0];
+		U32 stackCapacity = kMaxStackSize;
+		U32 stackSize = 0;
+		stack[stackSize++] = m_root;
+		while(stackSize)
+		{
+			const Node& node = m_nodes[stack[--stackSize]];
+			if(!testAabb(node.m_min, node.m_max))
+			{
+				continue;
+			}
+
+			if(node.isLeaf())
+			{
+				func(node.m_userData);
+			}
+			else
+			{
+				if(stackSize + 2 > stackCapacity) [[unlikely]]
+				{
+					heapStack.resize(stackCapacity * 2);
+					if(stack == &fixedStack[0])
+					{
+						memcpy(&heapStack[0], &fixedStack[0], sizeof(U32) * stackSize);
+					}
+
+					stack = &heapStack[0];
+					stackCapacity = heapStack.getSize();
+				}
+
+				stack[stackSize++] = node.m_children[0];
+				stack[stackSize++] = node.m_children[1];
+			}
+		}
+	}
+
+	static Bool aabbsOverlap(const Vec3& minA, const Vec3& maxA, const Vec3& minB, const Vec3& maxB)
+	{
+		return minA.x() <= maxB.x() && minA.y() <= maxB.y() && minA.z() <= maxB.z() && maxA.x() >= minB.x() && maxA.y() >= minB.y()
+			   && maxA.z() >= minB.z();
+	}
+
+	static Bool aabbContains(const Vec3& outerMin, const Vec3& outerMax, const Vec3& innerMin, const Vec3& innerMax)
+	{
+		return outerMin.x() <= innerMin.x() && outerMin.y() <= innerMin.y() && outerMin.z() <= innerMin.z() && outerMax.x() >= innerMax.x()
+			   && outerMax.y() >= innerMax.y() && outerMax.z() >= innerMax.z();
+	}
+
+	static Bool segmentHitsAabb(const Vec3& from, const Vec3& invDir, const Vec3& aabbMin, const Vec3& aabbMax)
+	{
+		// Slab test in the [0, 1] range of the segment
+		const Vec3 t0 = (aabbMin - from) * invDir;
+		const Vec3 t1 = (aabbMax - from) * invDir;
+		const Vec3 tmin = t0.min(t1);
+		const Vec3 tmax = t0.max(t1);
+		const F32 enter = max(max(tmin.x(), tmin.y()), max(tmin.z(), 0.0f));
+		const F32 exit = min(min(tmax.x(), tmax.y()), min(tmax.z(), 1.0f));
+		return enter <= exit;
+	}
+
+	static F32 surfaceArea(const Vec3& min, const Vec3& max)
+	{
+		const Vec3 d = max - min;
+		return 2.0f * (d.x() * d.y() + d.y() * d.z() + d.z() * d.x());
+	}
+
+	U32 newNode();
+	void deleteNode(U32 idx);
+
+	void insertLeaf(U32 leaf);
+	void removeLeaf(U32 leaf);
+
+	/// Rotate the subtree if it's not balanced. Returns the new root of the subtree.
+	U32 balance(U32 idx);
+
+	/// Walk to the root fixing the bounds and heights.
+	void refitAncestors(U32 idx);
+
+	void applyMove(const Pending& pending);
+	void applyDelete(U32 objectIdx);
+
+	void runQuery(const SpatialQuery& query, SpatialQueryResult& result, SpatialQueryBatch& batch, Atomic<U32>& objectCount,
+				  SceneDynamicArray<void*>& tmpObjects) const;
+};
+/// @}
+
+} // end namespace anki
@@ -0,0 +1,269 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+// WARNING: This file is auto generated.
+
+#pragma once
+
+#include <AnKi/Util/StdTypes.h>
+#include <AnKi/Util/Array.h>
+#include <AnKi/Util/WeakArray.h>
+#include <AnKi/Util/Enum.h>
+
+namespace anki {
+
+/// @addtogroup scene
+/// @{
+
+inline constexpr const char* kSceneBinaryMagic = "ANKISCN1";
+
+/// The components a scene binary can create.
+enum class SceneBinaryComponentType : U8
+{
+	kModel,
+	kSkin,
+	kLight,
+	kLensFlare,
+	kBody,
+	kReflectionProbe,
+	kGlobalIlluminationProbe,
+	kDecal,
+	kParticleEmitter,
+	kSkybox,
+	kCamera,
+
+	kCount,
+	kFirst = 0
+};
+ANKI_ENUM_ALLOW_NUMERIC_OPERATIONS(SceneBinaryComponentType)
+
+/// The type of the resources that get loaded before the nodes are created.
+enum class SceneBinaryResourceType : U8
+{
+	kModel,
+	kSkeleton,
+	kImage,
+	kCpuMesh,
+	kParticleEmitter,
+
+	kCount,
+	kFirst = 0
+};
+ANKI_ENUM_ALLOW_NUMERIC_OPERATIONS(SceneBinaryResourceType)
+
+/// A property maps to a setter of a component. The comments show which members of SceneBinaryProperty the property uses.
+enum class SceneBinaryPropertyType : U8
+{
+	kResource, ///< m_uintValue is the resource. m_floatValues[0] is the blend factor of the decals.
+	kRoughnessMetalnessResource, ///< Decal. Same as kResource.
+	kLightType, ///< m_uintValue is a LightComponentType.
+	kDiffuseColor, ///< Vec4.
+	kRadius, ///< F32.
+	kDistance, ///< F32.
+	kInnerAngle, ///< F32.
+	kOuterAngle, ///< F32.
+	kShadow, ///< m_uintValue is a Bool.
+	kLightEventIntensityMultiplier, ///< Vec4. Creates a LightEvent.
+	kLightEventFrequency, ///< Vec2. Creates a LightEvent.
+	kFirstFlareSize, ///< Vec2.
+	kColorMultiplier, ///< Vec4.
+	kMeshFromModelComponent,
+	kBoxVolumeSize, ///< Vec3.
+	kFadeDistance, ///< F32.
+	kCellSize, ///< F32.
+	kSolidColor, ///< Vec3.
+	kImageScale, ///< Vec3.
+	kGeneratedSky,
+	kMinFogDensity, ///< F32.
+	kMaxFogDensity, ///< F32.
+	kHeightOfMinFogDensity, ///< F32.
+	kHeightOfMaxFogDensity, ///< F32.
+	kFogDiffuseColor, ///< Vec3.
+	kPerspective, ///< Near, far and FOV Y. The FOV X is computed from the aspect ratio of the window.
+	kActiveCamera,
+
+	kCount,
+	kFirst = 0
+};
+ANKI_ENUM_ALLOW_NUMERIC_OPERATIONS(SceneBinaryPropertyType)
+
+/// A resource that is referenced by the components.
+class SceneBinaryResource
+{
+public:
+	/// Points to SceneBinary::m_strings.
+	U32 m_filenameOffset = kMaxU32;
+
+	SceneBinaryResourceType m_type = SceneBinaryResourceType::kCount;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doValue("m_filenameOffset", offsetof(SceneBinaryResource, m_filenameOffset), self.m_filenameOffset);
+		s.doValue("m_type", offsetof(SceneBinaryResource, m_type), self.m_type);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, SceneBinaryResource&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const SceneBinaryResource&>(serializer, *this);
+	}
+};
+
+/// A value that will be passed to a component.
+class SceneBinaryProperty
+{
+public:
+	Array<F32, 4> m_floatValues = {};
+
+	/// Resource index, enum or boolean.
+	U32 m_uintValue = kMaxU32;
+
+	SceneBinaryPropertyType m_type = SceneBinaryPropertyType::kCount;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doArray("m_floatValues", offsetof(SceneBinaryProperty, m_floatValues), &self.m_floatValues[0], self.m_floatValues.getSize());
+		s.doValue("m_uintValue", offsetof(SceneBinaryProperty, m_uintValue), self.m_uintValue);
+		s.doValue("m_type", offsetof(SceneBinaryProperty, m_type), self.m_type);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, SceneBinaryProperty&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const SceneBinaryProperty&>(serializer, *this);
+	}
+};
+
+/// A component descriptor.
+class SceneBinaryComponent
+{
+public:
+	/// Points to SceneBinary::m_properties.
+	U32 m_firstProperty = 0;
+
+	U32 m_propertyCount = 0;
+	SceneBinaryComponentType m_type = SceneBinaryComponentType::kCount;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doValue("m_firstProperty", offsetof(SceneBinaryComponent, m_firstProperty), self.m_firstProperty);
+		s.doValue("m_propertyCount", offsetof(SceneBinaryComponent, m_propertyCount), self.m_propertyCount);
+		s.doValue("m_type", offsetof(SceneBinaryComponent, m_type), self.m_type);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, SceneBinaryComponent&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const SceneBinaryComponent&>(serializer, *this);
+	}
+};
+
+/// A scene node.
+class SceneBinaryNode
+{
+public:
+	/// A 3x3 matrix in row major order.
+	Array<F32, 9> m_rotation = {};
+
+	Array<F32, 3> m_origin = {};
+	Array<F32, 3> m_scale = {};
+
+	/// Points to SceneBinary::m_strings. If it's kMaxU32 the node doesn't have a name.
+	U32 m_nameOffset = kMaxU32;
+
+	/// Points to a previous node in SceneBinary::m_nodes. If it's kMaxU32 the node doesn't have a parent.
+	U32 m_parent = kMaxU32;
+
+	/// Points to SceneBinary::m_components.
+	U32 m_firstComponent = 0;
+
+	U32 m_componentCount = 0;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doArray("m_rotation", offsetof(SceneBinaryNode, m_rotation), &self.m_rotation[0], self.m_rotation.getSize());
+		s.doArray("m_origin", offsetof(SceneBinaryNode, m_origin), &self.m_origin[0], self.m_origin.getSize());
+		s.doArray("m_scale", offsetof(SceneBinaryNode, m_scale), &self.m_scale[0], self.m_scale.getSize());
+		s.doValue("m_nameOffset", offsetof(SceneBinaryNode, m_nameOffset), self.m_nameOffset);
+		s.doValue("m_parent", offsetof(SceneBinaryNode, m_parent), self.m_parent);
+		s.doValue("m_firstComponent", offsetof(SceneBinaryNode, m_firstComponent), self.m_firstComponent);
+		s.doValue("m_componentCount", offsetof(SceneBinaryNode, m_componentCount), self.m_componentCount);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, SceneBinaryNode&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const SceneBinaryNode&>(serializer, *this);
+	}
+};
+
+/// The binary scene format. It replaces the scene scripts that are expensive to parse and run.
+class SceneBinary
+{
+public:
+	Array<U8, 8> m_magic = {};
+	WeakArray<SceneBinaryNode> m_nodes;
+	WeakArray<SceneBinaryComponent> m_components;
+	WeakArray<SceneBinaryProperty> m_properties;
+	WeakArray<SceneBinaryResource> m_resources;
+
+	/// Null terminated strings one after the other.
+	WeakArray<Char> m_strings;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doArray("m_magic", offsetof(SceneBinary, m_magic), &self.m_magic[0], self.m_magic.getSize());
+		s.doValue("m_nodes", offsetof(SceneBinary, m_nodes), self.m_nodes);
+		s.doValue("m_components", offsetof(SceneBinary, m_components), self.m_components);
+		s.doValue("m_properties", offsetof(SceneBinary, m_properties), self.m_properties);
+		s.doValue("m_resources", offsetof(SceneBinary, m_resources), self.m_resources);
+		s.doValue("m_strings", offsetof(SceneBinary, m_strings), self.m_strings);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, SceneBinary&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const SceneBinary&>(serializer, *this);
+	}
+};
+
+/// @}
+
+} // end namespace anki
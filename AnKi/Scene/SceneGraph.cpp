@@ -43,6 +43,35 @@ static StatCounter g_scenePhysicsTimeStatVar(StatCategory::kTime, "Physics",
 
 constexpr U32 kUpdateNodeBatchSize = 10;
 
+/// Components lighter than that run before the world transforms are computed. They are the ones that move the nodes.
+constexpr F32 kTransformUpdateWeight = SceneComponent::getUpdateOrderWeight(SceneComponentType::kMove);
+
+/// Components of these types are not updated one type at a time but by walking the node hierarchy. Scripts can touch any other node so
+/// keep the parents updating before their children.
+constexpr SceneComponentTypeMask kHierarchicalUpdateComponentTypes = SceneComponentTypeMask::kScript;
+static_assert(SceneComponent::getUpdateOrderWeight(SceneComponentType::kScript) < kTransformUpdateWeight,
+			  "The hierarchical pass runs at the start of the update");
+
+/// The component types sorted by their update weight. That's the order of the per-type passes.
+static Array<SceneComponentType, U32(SceneComponentType::kCount)> computeComponentUpdateOrder()
+{
+	Array<SceneComponentType, U32(SceneComponentType::kCount)> order;
+	for(SceneComponentType type : EnumIterable<SceneComponentType>())
+	{
+		order[type] = type;
+	}
+
+	std::sort(order.getBegin(), order.getEnd(), [](SceneComponentType a, SceneComponentType b) {
+		const F32 weightA = SceneComponent::getUpdateOrderWeight(a);
+		const F32 weightB = SceneComponent::getUpdateOrderWeight(b);
+		return (weightA != weightB) ? weightA < weightB : a < b;
+	});
+
+	return order;
+}
+
+static const Array<SceneComponentType, U32(SceneComponentType::kCount)> g_componentUpdateOrder = computeComponentUpdateOrder();
+
 class SceneGraph::UpdateSceneNodesCtx
 {
 public:
@@ -51,6 +80,9 @@ public:
 
 	Second m_prevUpdateTime;
 	Second m_crntTime;
+
+	SceneComponentTypeMask m_componentTypes = SceneComponentTypeMask::kNone;
+	Bool m_frameUpdate = false;
 };
 
 SceneGraph::SceneGraph()
@@ -66,6 +98,11 @@ SceneGraph::~SceneGraph()
 
 	deleteNodesMarkedForDeletion();
 
+	if(TransformHierarchy::isAllocated())
+	{
+		TransformHierarchy::freeSingleton();
+	}
+
 #define ANKI_CAT_TYPE(arrayName, gpuSceneType, id, cvarName) GpuSceneArrays::arrayName::freeSingleton();
 #include <AnKi/Scene/GpuSceneArrays.def.h>
 
@@ -75,6 +112,7 @@ SceneGraph::~SceneGraph()
 Error SceneGraph::init(AllocAlignedCallback allocCallback, void* allocCallbackData)
 {
 	SceneMemoryPool::allocateSingleton(allocCallback, allocCallbackData);
+	TransformHierarchy::allocateSingleton();
 
 	m_framePool.init(allocCallback, allocCallbackData, 1_MB, 2.0, 0, true, "SceneGraphFramePool");
 
@@ -203,6 +241,9 @@ Error SceneGraph::update(Second prevUpdateTime, Second crntTime)
 		const Bool fullCleanup = m_objectsMarkedForDeletionCount.load() != 0;
 		m_events.deleteEventsMarkedForDeletion(fullCleanup);
 		deleteNodesMarkedForDeletion();
+
+		// Remove the deleted components from the spatial index before someone queries it
+		m_spatialIndex.flush();
 	}
 
 	// Update
@@ -219,24 +260,11 @@ Error SceneGraph::update(Second prevUpdateTime, Second crntTime)
 		ANKI_TRACE_SCOPED_EVENT(SceneNodesUpdate);
 		ANKI_CHECK(m_events.updateAllEvents(prevUpdateTime, crntTime));
 
-		UpdateSceneNodesCtx updateCtx;
-		updateCtx.m_crntNode = m_nodes.getBegin();
-		updateCtx.m_prevUpdateTime = prevUpdateTime;
-		updateCtx.m_crntTime = crntTime;
-
-		for(U i = 0; i < CoreThreadJobManager::getSingleton().getThreadCount(); i++)
-		{
-			CoreThreadJobManager::getSingleton().dispatchTask([this, &updateCtx]([[maybe_unused]] U32 tid) {
-				if(updateNodes(updateCtx))
-				{
-					ANKI_SCENE_LOGF("Will not recover");
-				}
-			});
-		}
-
-		CoreThreadJobManager::getSingleton().waitForAllTasksToFinish();
+		updateNodesAndComponents(prevUpdateTime, crntTime);
 	}
 
+	m_spatialIndex.flush();
+
 #define ANKI_CAT_TYPE(arrayName, gpuSceneType, id, cvarName) GpuSceneArrays::arrayName::getSingleton().flush();
 #include <AnKi/Scene/GpuSceneArrays.def.h>
 
@@ -244,56 +272,144 @@ Error SceneGraph::update(Second prevUpdateTime, Second crntTime)
 	return Error::kNone;
 }
 
-Error SceneGraph::updateNode(Second prevTime, Second crntTime, SceneNode& node)
+void SceneGraph::updateNodesAndComponents(Second prevUpdateTime, Second crntTime)
 {
-	ANKI_TRACE_INC_COUNTER(SceneNodeUpdated, 1);
+	// First run the components that move the nodes (scripts, physics etc), then compute all world transforms in one go and then run the
+	// components that depend on the world transforms
+	SceneComponentTypeMask beforeTransformUpdateTypes = SceneComponentTypeMask::kNone;
+	for(SceneComponentType type : EnumIterable<SceneComponentType>())
+	{
+		if(SceneComponent::getUpdateOrderWeight(type) < kTransformUpdateWeight)
+		{
+			beforeTransformUpdateTypes |= SceneComponentTypeMask(1 << U32(type));
+		}
+	}
+	const SceneComponentTypeMask afterTransformUpdateTypes = ~beforeTransformUpdateTypes;
+
+	Bool componentsBeforeTransformUpdate = false;
+#define ANKI_DEFINE_SCENE_COMPONENT(name, weight) \
+	componentsBeforeTransformUpdate = \
+		componentsBeforeTransformUpdate || (weight < kTransformUpdateWeight && !m_componentArrays.get##name##s().isEmpty());
+#include <AnKi/Scene/Components/SceneComponentClasses.def.h>
+
+	// The components that move the nodes need the world transforms of the parents. Compute them before those components run so they include
+	// the physics, the events and whatever moved the nodes since the last update. What these components change is computed after they run. So a
+	// script sees the changes that the script of its parent made in the same frame only in the next frame
+	TransformHierarchy& transforms = TransformHierarchy::getSingleton();
+	Bool newTransformFrame = true;
+	if(componentsBeforeTransformUpdate)
+	{
+		transforms.update();
+		newTransformFrame = false;
+	}
 
-	Error err = Error::kNone;
+	if(g_typeBatchedComponentUpdateCVar)
+	{
+		// Some types need the hierarchy
+		updateNodesHierarchically(prevUpdateTime, crntTime, kHierarchicalUpdateComponentTypes, false);
 
-	// Components update
-	SceneComponentUpdateInfo componentUpdateInfo(prevTime, crntTime);
-	componentUpdateInfo.m_framePool = &m_framePool;
+		// The rest are updated one type at a time in the order of their weights
+		Bool transformsUpdated = false;
+		for(SceneComponentType type : g_componentUpdateOrder)
+		{
+			if(!!(kHierarchicalUpdateComponentTypes & SceneComponentTypeMask(1 << U32(type))))
+			{
+				continue;
+			}
 
-	Bool atLeastOneComponentUpdated = false;
-	node.iterateComponents([&](SceneComponent& comp) {
-		if(err)
+			if(!transformsUpdated && !!(afterTransformUpdateTypes & SceneComponentTypeMask(1 << U32(type))))
+			{
+				transforms.update(newTransformFrame);
+				transformsUpdated = true;
+			}
+
+			updateComponentsOfType(prevUpdateTime, crntTime, type);
+		}
+
+		if(!transformsUpdated)
 		{
-			return;
+			transforms.update(newTransformFrame);
 		}
 
+		frameUpdateNodes(prevUpdateTime, crntTime);
+	}
+	else
+	{
+		updateNodesHierarchically(prevUpdateTime, crntTime, beforeTransformUpdateTypes, false);
+		transforms.update(newTransformFrame);
+		updateNodesHierarchically(prevUpdateTime, crntTime, afterTransformUpdateTypes, true);
+	}
+}
+
+void SceneGraph::updateNodesHierarchically(Second prevTime, Second crntTime, SceneComponentTypeMask componentTypes, Bool frameUpdate)
+{
+	UpdateSceneNodesCtx updateCtx;
+	updateCtx.m_crntNode = m_nodes.getBegin();
+	updateCtx.m_prevUpdateTime = prevTime;
+	updateCtx.m_crntTime = crntTime;
+	updateCtx.m_componentTypes = componentTypes;
+	updateCtx.m_frameUpdate = frameUpdate;
+
+	for(U i = 0; i < CoreThreadJobManager::getSingleton().getThreadCount(); i++)
+	{
+		CoreThreadJobManager::getSingleton().dispatchTask([this, &updateCtx]([[maybe_unused]] U32 tid) {
+			if(updateNodes(updateCtx))
+			{
+				ANKI_SCENE_LOGF("Will not recover");
+			}
+		});
+	}
+
+	CoreThreadJobManager::getSingleton().waitForAllTasksToFinish();
+
+	mergeSceneBounds();
+}
+
+Error SceneGraph::updateNode(const UpdateSceneNodesCtx& ctx, SceneNode& node)
+{
+	if(ctx.m_frameUpdate)
+	{
+		ANKI_TRACE_INC_COUNTER(SceneNodeUpdated, 1);
+	}
+
+	Error err = Error::kNone;
+
+	// Components update
+	if(!!(node.getComponentTypeMask() & ctx.m_componentTypes))
+	{
+		SceneComponentUpdateInfo componentUpdateInfo(ctx.m_prevUpdateTime, ctx.m_crntTime);
+		componentUpdateInfo.m_framePool = &m_framePool;
 		componentUpdateInfo.m_node = &node;
-		Bool updated = false;
-		err = comp.update(componentUpdateInfo, updated);
 
-		if(updated)
-		{
-			ANKI_TRACE_INC_COUNTER(SceneComponentUpdated, 1);
-			comp.setTimestamp(GlobalFrameIndex::getSingleton().m_value);
-			atLeastOneComponentUpdated = true;
-		}
-	});
+		node.iterateComponents([&](SceneComponent& comp) {
+			if(err || !(ctx.m_componentTypes & SceneComponentTypeMask(1 << U32(comp.getType()))))
+			{
+				return;
+			}
+
+			Bool updated = false;
+			err = comp.update(componentUpdateInfo, updated);
+
+			if(updated)
+			{
+				ANKI_TRACE_INC_COUNTER(SceneComponentUpdated, 1);
+				comp.setTimestamp(GlobalFrameIndex::getSingleton().m_value);
+			}
+		});
+	}
 
 	// Update children
 	if(!err)
 	{
 		err = node.visitChildrenMaxDepth(0, [&](SceneNode& child) -> Error {
-			return updateNode(prevTime, crntTime, child);
+			return updateNode(ctx, child);
 		});
 	}
 
 	// Frame update
-	if(!err)
+	if(!err && ctx.m_frameUpdate)
 	{
-		if(atLeastOneComponentUpdated)
-		{
-			node.setComponentMaxTimestamp(GlobalFrameIndex::getSingleton().m_value);
-		}
-		else
-		{
-			// No components or nothing updated, don't change the timestamp
-		}
-
-		err = node.frameUpdate(prevTime, crntTime);
+		err = node.frameUpdate(ctx.m_prevUpdateTime, ctx.m_crntTime);
 	}
 
 	return err;
@@ -342,13 +458,141 @@ Error SceneGraph::updateNodes(UpdateSceneNodesCtx& ctx)
 		// Process nodes
 		for(U i = 0; i < batchSize && !err; ++i)
 		{
-			err = updateNode(ctx.m_prevUpdateTime, ctx.m_crntTime, *batch[i]);
+			err = updateNode(ctx, *batch[i]);
 		}
 	}
 
 	return err;
 }
 
+void SceneGraph::frameUpdateNodes(Second prevTime, Second crntTime)
+{
+	ANKI_TRACE_SCOPED_EVENT(SceneNodeUpdate);
+
+	IntrusiveList<SceneNode>::Iterator crntNode = m_nodes.getBegin();
+	const IntrusiveList<SceneNode>::Iterator end = m_nodes.getEnd();
+	SpinLock crntNodeLock;
+
+	auto frameUpdateBatches = [&]() {
+		Bool quit = false;
+		while(!quit)
+		{
+			// Fetch a batch of scene nodes. The order doesn't matter, the components are all updated
+			Array<SceneNode*, kUpdateNodeBatchSize> batch;
+			U32 batchSize = 0;
+
+			{
+				LockGuard<SpinLock> lock(crntNodeLock);
+				while(batchSize < batch.getSize() && crntNode != end)
+				{
+					batch[batchSize++] = &(*crntNode);
+					++crntNode;
+				}
+
+				quit = crntNode == end;
+			}
+
+			for(U32 i = 0; i < batchSize; ++i)
+			{
+				ANKI_TRACE_INC_COUNTER(SceneNodeUpdated, 1);
+				if(batch[i]->frameUpdate(prevTime, crntTime))
+				{
+					ANKI_SCENE_LOGF("Will not recover");
+				}
+			}
+		}
+	};
+
+	const U32 taskCount = CoreThreadJobManager::getSingleton().getThreadCount();
+	if(taskCount <= 1)
+	{
+		frameUpdateBatches();
+		return;
+	}
+
+	for(U32 i = 0; i < taskCount; ++i)
+	{
+		CoreThreadJobManager::getSingleton().dispatchTask([&]([[maybe_unused]] U32 tid) {
+			frameUpdateBatches();
+		});
+	}
+
+	CoreThreadJobManager::getSingleton().waitForAllTasksToFinish();
+}
+
+void SceneGraph::updateComponentsOfType(Second prevTime, Second crntTime, SceneComponentType type)
+{
+	switch(type)
+	{
+#define ANKI_DEFINE_SCENE_COMPONENT(name, weight) \
+	case SceneComponentType::k##name: \
+		updateComponentArray(prevTime, crntTime, m_componentArrays.get##name##s()); \
+		break;
+#include <AnKi/Scene/Components/SceneComponentClasses.def.h>
+	default:
+		ANKI_ASSERT(0);
+	}
+
+	mergeSceneBounds();
+}
+
+template<typename TComponent>
+void SceneGraph::updateComponentArray(Second prevTime, Second crntTime, SceneBlockArray<TComponent>& components)
+{
+	if(components.isEmpty())
+	{
+		return;
+	}
+
+	ANKI_TRACE_SCOPED_EVENT(SceneComponentsUpdate);
+
+	const U32 blockCount = components.getBlockCount();
+	const Timestamp timestamp = GlobalFrameIndex::getSingleton().m_value;
+	Atomic<U32> crntBlock = {0};
+
+	auto updateBlocks = [&]() {
+		SceneComponentUpdateInfo componentUpdateInfo(prevTime, crntTime);
+		componentUpdateInfo.m_framePool = &m_framePool;
+
+		U32 blockIdx;
+		while((blockIdx = crntBlock.fetchAdd(1)) < blockCount)
+		{
+			components.iterateBlockElements(blockIdx, [&](TComponent& comp) {
+				SceneComponent& base = comp;
+				componentUpdateInfo.m_node = &base.getSceneNode();
+
+				Bool updated = false;
+				if(base.update(componentUpdateInfo, updated))
+				{
+					ANKI_SCENE_LOGF("Will not recover");
+				}
+
+				if(updated)
+				{
+					ANKI_TRACE_INC_COUNTER(SceneComponentUpdated, 1);
+					base.setTimestamp(timestamp);
+				}
+			});
+		}
+	};
+
+	const U32 taskCount = min(blockCount, CoreThreadJobManager::getSingleton().getThreadCount());
+	if(taskCount <= 1)
+	{
+		updateBlocks();
+		return;
+	}
+
+	for(U32 i = 0; i < taskCount; ++i)
+	{
+		CoreThreadJobManager::getSingleton().dispatchTask([&]([[maybe_unused]] U32 tid) {
+			updateBlocks();
+		});
+	}
+
+	CoreThreadJobManager::getSingleton().waitForAllTasksToFinish();
+}
+
 LightComponent* SceneGraph::getDirectionalLight() const
 {
 	LightComponent* out = (m_dirLights.getSize()) ? m_dirLights[0] : nullptr;
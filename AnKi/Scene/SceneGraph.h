@@ -7,9 +7,11 @@
 
 #include <AnKi/Scene/Common.h>
 #include <AnKi/Scene/SceneNode.h>
+#include <AnKi/Scene/DynamicAabbTree.h>
 #include <AnKi/Math.h>
 #include <AnKi/Util/HashMap.h>
 #include <AnKi/Util/BlockArray.h>
+#include <AnKi/Util/ThreadReduction.h>
 #include <AnKi/Scene/Events/EventManager.h>
 #include <AnKi/Resource/Common.h>
 #include <AnKi/Util/CVarSet.h>
@@ -17,12 +19,17 @@
 
 namespace anki {
 
+// Forward
+class SceneBinary;
+
 /// @addtogroup scene
 /// @{
 
 inline NumericCVar<F32> g_probeEffectiveDistanceCVar("Scene", "ProbeEffectiveDistance", 256.0f, 1.0f, kMaxF32, "How far various probes can render");
 inline NumericCVar<F32> g_probeShadowEffectiveDistanceCVar("Scene", "ProbeShadowEffectiveDistance", 32.0f, 1.0f, kMaxF32,
 														   "How far to render shadows for the various probes");
+inline BoolCVar g_typeBatchedComponentUpdateCVar("Scene", "TypeBatchedComponentUpdate", false,
+												 "Update the components one type at a time instead of walking the nodes");
 
 // Gpu scene arrays
 inline NumericCVar<U32> g_minGpuSceneTransformsCVar("Scene", "MinGpuSceneTransforms", 2 * 10 * 1024, 8, 100 * 1024,
@@ -112,6 +119,10 @@ public:
 
 	Error update(Second prevUpdateTime, Second crntTime);
 
+	/// The part of update() that runs the components of all nodes and computes the world transforms. It doesn't delete nodes, step the physics
+	/// or flush the GPU scene.
+	void updateNodesAndComponents(Second prevUpdateTime, Second crntTime);
+
 	SceneNode& findSceneNode(const CString& name);
 	SceneNode* tryFindSceneNode(const CString& name);
 
@@ -139,6 +150,14 @@ public:
 	template<typename Node, typename... Args>
 	Error newSceneNode(const CString& name, Node*& node, Args&&... args);
 
+	/// Create the nodes of a scene that is stored in the SceneBinary format (see GltfImporter). The resources are loaded before the nodes are
+	/// created and the component arrays are preallocated.
+	Error loadSceneBinary(CString filename);
+
+	/// Same as loadSceneBinary(CString) but the binary is already deserialized. It's validated before anything is created.
+	/// @param filename Only used in the logs.
+	Error loadSceneBinary(const SceneBinary& binary, CString filename);
+
 	/// Delete a scene node. It actualy marks it for deletion
 	void deleteSceneNode(SceneNode* node)
 	{
@@ -213,18 +232,28 @@ public:
 		return (m_skyboxes.getSize()) ? m_skyboxes[0] : nullptr;
 	}
 
+	/// The bounds of the components that have a volume (models, lights, probes etc). The user data of the objects are SceneComponent pointers.
+	/// The modifications become visible to the queries at the end of update() so it's safe to query it from the components.
+	DynamicAabbTree& getSpatialIndex()
+	{
+		return m_spatialIndex;
+	}
+
+	const DynamicAabbTree& getSpatialIndex() const
+	{
+		return m_spatialIndex;
+	}
+
+	/// The bounds are accumulated per thread and they become visible after the components of the current update pass finish.
 	/// @note It's thread-safe.
 	void updateSceneBounds(const Vec3& min, const Vec3& max)
 	{
-		LockGuard lock(m_sceneBoundsMtx);
-		m_sceneMin = m_sceneMin.min(min);
-		m_sceneMax = m_sceneMax.max(max);
+		m_sceneBoundsReduction.update({min, max});
 	}
 
 	/// @note It's thread-safe.
 	Array<Vec3, 2> getSceneBounds() const
 	{
-		LockGuard lock(m_sceneBoundsMtx);
 		ANKI_ASSERT(m_sceneMin < m_sceneMax);
 		return {m_sceneMin, m_sceneMax};
 	}
@@ -232,6 +261,15 @@ public:
 private:
 	class UpdateSceneNodesCtx;
 
+	class SceneBoundsUnion
+	{
+	public:
+		Array<Vec3, 2> operator()(const Array<Vec3, 2>& a, const Array<Vec3, 2>& b) const
+		{
+			return {a[0].min(b[0]), a[1].max(b[1])};
+		}
+	};
+
 	class InitMemPoolDummy
 	{
 	public:
@@ -255,7 +293,7 @@ private:
 
 	Vec3 m_sceneMin = Vec3(kMaxF32);
 	Vec3 m_sceneMax = Vec3(kMinF32);
-	mutable SpinLock m_sceneBoundsMtx;
+	ThreadReduction<Array<Vec3, 2>, SceneBoundsUnion> m_sceneBoundsReduction = {{Vec3(kMaxF32), Vec3(kMinF32)}};
 
 	Atomic<U32> m_objectsMarkedForDeletionCount = {0};
 
@@ -263,6 +301,8 @@ private:
 
 	SceneComponentArrays m_componentArrays;
 
+	DynamicAabbTree m_spatialIndex;
+
 	SceneDynamicArray<LightComponent*> m_dirLights;
 	SceneDynamicArray<SkyboxComponent*> m_skyboxes;
 
@@ -277,8 +317,27 @@ private:
 	/// Delete the nodes that are marked for deletion
 	void deleteNodesMarkedForDeletion();
 
+	/// Walk the node hierarchies (parents before children) and update the components of some types.
+	void updateNodesHierarchically(Second prevTime, Second crntTime, SceneComponentTypeMask componentTypes, Bool frameUpdate);
 	Error updateNodes(UpdateSceneNodesCtx& ctx);
-	Error updateNode(Second prevTime, Second crntTime, SceneNode& node);
+	Error updateNode(const UpdateSceneNodesCtx& ctx, SceneNode& node);
+
+	/// Call SceneNode::frameUpdate() of all nodes. Unlike updateNodesHierarchically() it doesn't walk the hierarchy.
+	void frameUpdateNodes(Second prevTime, Second crntTime);
+
+	/// Update all components of a type. The blocks of the component array are split among the threads.
+	void updateComponentsOfType(Second prevTime, Second crntTime, SceneComponentType type);
+
+	/// Merge the per-thread scene bounds. Call it when no component is updating.
+	void mergeSceneBounds()
+	{
+		const Array<Vec3, 2> bounds = m_sceneBoundsReduction.consume();
+		m_sceneMin = m_sceneMin.min(bounds[0]);
+		m_sceneMax = m_sceneMax.max(bounds[1]);
+	}
+
+	template<typename TComponent>
+	void updateComponentArray(Second prevTime, Second crntTime, SceneBlockArray<TComponent>& components);
 };
 
 template<typename Node, typename... Args>
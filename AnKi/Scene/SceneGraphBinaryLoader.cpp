@@ -0,0 +1,566 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Scene/SceneGraph.h>
+#include <AnKi/Scene/SceneBinary.h>
+#include <AnKi/Scene/Events/LightEvent.h>
+#include <AnKi/Scene/Components/BodyComponent.h>
+#include <AnKi/Scene/Components/CameraComponent.h>
+#include <AnKi/Scene/Components/DecalComponent.h>
+#include <AnKi/Scene/Components/GlobalIlluminationProbeComponent.h>
+#include <AnKi/Scene/Components/LensFlareComponent.h>
+#include <AnKi/Scene/Components/LightComponent.h>
+#include <AnKi/Scene/Components/ModelComponent.h>
+#include <AnKi/Scene/Components/MoveComponent.h>
+#include <AnKi/Scene/Components/ParticleEmitterComponent.h>
+#include <AnKi/Scene/Components/ReflectionProbeComponent.h>
+#include <AnKi/Scene/Components/SkinComponent.h>
+#include <AnKi/Scene/Components/SkyboxComponent.h>
+#include <AnKi/Resource/ResourceManager.h>
+#include <AnKi/Resource/ModelResource.h>
+#include <AnKi/Resource/SkeletonResource.h>
+#include <AnKi/Resource/ImageResource.h>
+#include <AnKi/Resource/CpuMeshResource.h>
+#include <AnKi/Resource/ParticleEmitterResource.h>
+#include <AnKi/Util/Serializer.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/Tracer.h>
+#include <AnKi/Core/App.h>
+
+namespace anki {
+
+static Bool isPropertyWithResource(SceneBinaryPropertyType type)
+{
+	return type == SceneBinaryPropertyType::kResource || type == SceneBinaryPropertyType::kRoughnessMetalnessResource;
+}
+
+/// Check all the offsets and indices of the binary so the rest of the code doesn't have to.
+static Error validateSceneBinary(const SceneBinary& binary)
+{
+	if(memcmp(kSceneBinaryMagic, &binary.m_magic[0], sizeof(binary.m_magic)) != 0)
+	{
+		ANKI_SCENE_LOGE("Corrupted or wrong version of scene binary");
+		return Error::kUserData;
+	}
+
+	const U32 stringsSize = binary.m_strings.getSize();
+	if(stringsSize > 0 && binary.m_strings[stringsSize - 1] != '\0')
+	{
+		ANKI_SCENE_LOGE("The strings of the scene binary are not null terminated");
+		return Error::kUserData;
+	}
+
+	auto validString = [&](U32 offset, Bool optional) {
+		return (optional && offset == kMaxU32) || offset < stringsSize;
+	};
+
+	for(const SceneBinaryResource& rsrc : binary.m_resources)
+	{
+		if(!validString(rsrc.m_filenameOffset, false) || rsrc.m_type >= SceneBinaryResourceType::kCount)
+		{
+			ANKI_SCENE_LOGE("Wrong resource in scene binary");
+			return Error::kUserData;
+		}
+	}
+
+	for(const SceneBinaryProperty& prop : binary.m_properties)
+	{
+		if(prop.m_type >= SceneBinaryPropertyType::kCount
+		   || (isPropertyWithResource(prop.m_type) && prop.m_uintValue >= binary.m_resources.getSize()))
+		{
+			ANKI_SCENE_LOGE("Wrong property in scene binary");
+			return Error::kUserData;
+		}
+	}
+
+	for(const SceneBinaryComponent& comp : binary.m_components)
+	{
+		if(comp.m_type >= SceneBinaryComponentType::kCount || comp.m_firstProperty > binary.m_properties.getSize()
+		   || comp.m_propertyCount > binary.m_properties.getSize() - comp.m_firstProperty)
+		{
+			ANKI_SCENE_LOGE("Wrong component in scene binary");
+			return Error::kUserData;
+		}
+	}
+
+	for(U32 i = 0; i < binary.m_nodes.getSize(); ++i)
+	{
+		const SceneBinaryNode& node = binary.m_nodes[i];
+		if(!validString(node.m_nameOffset, true) || (node.m_parent != kMaxU32 && node.m_parent >= i)
+		   || node.m_firstComponent > binary.m_components.getSize() || node.m_componentCount > binary.m_components.getSize() - node.m_firstComponent)
+		{
+			ANKI_SCENE_LOGE("Wrong node in scene binary");
+			return Error::kUserData;
+		}
+	}
+
+	return Error::kNone;
+}
+
+/// Holds the resources of a scene binary so the components will find them already loaded.
+class SceneBinaryResources
+{
+public:
+	SceneDynamicArray<ModelResourcePtr> m_models;
+	SceneDynamicArray<SkeletonResourcePtr> m_skeletons;
+	SceneDynamicArray<ImageResourcePtr> m_images;
+	SceneDynamicArray<CpuMeshResourcePtr> m_cpuMeshes;
+	SceneDynamicArray<ParticleEmitterResourcePtr> m_particleEmitters;
+
+	template<typename TResourcePtr>
+	static Error load(CString filename, SceneDynamicArray<TResourcePtr>& arr)
+	{
+		TResourcePtr rsrc;
+		ANKI_CHECK(ResourceManager::getSingleton().loadResource(filename, rsrc));
+		arr.emplaceBack(std::move(rsrc));
+		return Error::kNone;
+	}
+};
+
+class SceneBinaryComponentCreator
+{
+public:
+	const SceneBinary* m_binary = nullptr;
+	SceneNode* m_node = nullptr;
+	Transform m_worldTransform;
+
+	CString getResourceFilename(const SceneBinaryProperty& prop) const
+	{
+		return &m_binary->m_strings[m_binary->m_resources[prop.m_uintValue].m_filenameOffset];
+	}
+
+	static Vec2 getVec2(const SceneBinaryProperty& prop)
+	{
+		return Vec2(prop.m_floatValues[0], prop.m_floatValues[1]);
+	}
+
+	static Vec3 getVec3(const SceneBinaryProperty& prop)
+	{
+		return Vec3(prop.m_floatValues[0], prop.m_floatValues[1], prop.m_floatValues[2]);
+	}
+
+	static Vec4 getVec4(const SceneBinaryProperty& prop)
+	{
+		return Vec4(prop.m_floatValues[0], prop.m_floatValues[1], prop.m_floatValues[2], prop.m_floatValues[3]);
+	}
+
+	/// Call a functor for all the properties of a component. The functor returns false if it doesn't know the property.
+	template<typename TFunc>
+	void iterateProperties(const SceneBinaryComponent& comp, TFunc func) const
+	{
+		for(U32 i = comp.m_firstProperty; i < comp.m_firstProperty + comp.m_propertyCount; ++i)
+		{
+			const SceneBinaryProperty& prop = m_binary->m_properties[i];
+			if(!func(prop))
+			{
+				ANKI_SCENE_LOGW("Ignoring property %u of component %u of node %s", U32(prop.m_type), U32(comp.m_type),
+								(m_node->getName()) ? m_node->getName().cstr() : "unnamed");
+			}
+		}
+	}
+
+	Error createComponent(const SceneBinaryComponent& comp);
+};
+
+Error SceneBinaryComponentCreator::createComponent(const SceneBinaryComponent& comp)
+{
+	using PType = SceneBinaryPropertyType;
+
+	switch(comp.m_type)
+	{
+	case SceneBinaryComponentType::kModel:
+	{
+		ModelComponent* c = m_node->newComponent<ModelComponent>();
+		iterateProperties(comp, [&](const SceneBinaryProperty& prop) {
+			if(prop.m_type == PType::kResource)
+			{
+				c->loadModelResource(getResourceFilename(prop));
+				return true;
+			}
+			return false;
+		});
+		break;
+	}
+	case SceneBinaryComponentType::kSkin:
+	{
+		SkinComponent* c = m_node->newComponent<SkinComponent>();
+		iterateProperties(comp, [&](const SceneBinaryProperty& prop) {
+			if(prop.m_type == PType::kResource)
+			{
+				c->loadSkeletonResource(getResourceFilename(prop));
+				return true;
+			}
+			return false;
+		});
+		break;
+	}
+	case SceneBinaryComponentType::kLight:
+	{
+		LightComponent* c = m_node->newComponent<LightComponent>();
+		const SceneBinaryProperty* eventIntensity = nullptr;
+		const SceneBinaryProperty* eventFrequency = nullptr;
+		iterateProperties(comp, [&](const SceneBinaryProperty& prop) {
+			switch(prop.m_type)
+			{
+			case PType::kLightType:
+				if(prop.m_uintValue >= U32(LightComponentType::kCount))
+				{
+					return false;
+				}
+				c->setLightComponentType(LightComponentType(prop.m_uintValue));
+				break;
+			case PType::kDiffuseColor:
+				c->setDiffuseColor(getVec4(prop));
+				break;
+			case PType::kRadius:
+				c->setRadius(prop.m_floatValues[0]);
+				break;
+			case PType::kDistance:
+				c->setDistance(prop.m_floatValues[0]);
+				break;
+			case PType::kInnerAngle:
+				c->setInnerAngle(prop.m_floatValues[0]);
+				break;
+			case PType::kOuterAngle:
+				c->setOuterAngle(prop.m_floatValues[0]);
+				break;
+			case PType::kShadow:
+				c->setShadowEnabled(prop.m_uintValue != 0);
+				break;
+			case PType::kLightEventIntensityMultiplier:
+				eventIntensity = &prop;
+				break;
+			case PType::kLightEventFrequency:
+				eventFrequency = &prop;
+				break;
+			default:
+				return false;
+			}
+			return true;
+		});
+
+		if(eventIntensity || eventFrequency)
+		{
+			LightEvent* event;
+			ANKI_CHECK(SceneGraph::getSingleton().getEventManager().newEvent(event, 0.0, -1.0, m_node));
+
+			if(eventIntensity)
+			{
+				event->setIntensityMultiplier(getVec4(*eventIntensity));
+			}
+
+			if(eventFrequency)
+			{
+				event->setFrequency(eventFrequency->m_floatValues[0], eventFrequency->m_floatValues[1]);
+			}
+		}
+		break;
+	}
+	case SceneBinaryComponentType::kLensFlare:
+	{
+		LensFlareComponent* c = m_node->newComponent<LensFlareComponent>();
+		iterateProperties(comp, [&](const SceneBinaryProperty& prop) {
+			switch(prop.m_type)
+			{
+			case PType::kResource:
+				c->loadImageResource(getResourceFilename(prop));
+				break;
+			case PType::kFirstFlareSize:
+				c->setFirstFlareSize(getVec2(prop));
+				break;
+			case PType::kColorMultiplier:
+				c->setColorMultiplier(getVec4(prop));
+				break;
+			default:
+				return false;
+			}
+			return true;
+		});
+		break;
+	}
+	case SceneBinaryComponentType::kBody:
+	{
+		BodyComponent* c = m_node->newComponent<BodyComponent>();
+		iterateProperties(comp, [&](const SceneBinaryProperty& prop) {
+			switch(prop.m_type)
+			{
+			case PType::kResource:
+				c->loadMeshResource(getResourceFilename(prop));
+				break;
+			case PType::kMeshFromModelComponent:
+				c->setMeshFromModelComponent();
+				break;
+			default:
+				return false;
+			}
+			return true;
+		});
+
+		c->teleportTo(m_worldTransform);
+		break;
+	}
+	case SceneBinaryComponentType::kReflectionProbe:
+	{
+		ReflectionProbeComponent* c = m_node->newComponent<ReflectionProbeComponent>();
+		iterateProperties(comp, [&](const SceneBinaryProperty& prop) {
+			if(prop.m_type == PType::kBoxVolumeSize)
+			{
+				c->setBoxVolumeSize(getVec3(prop));
+				return true;
+			}
+			return false;
+		});
+		break;
+	}
+	case SceneBinaryComponentType::kGlobalIlluminationProbe:
+	{
+		GlobalIlluminationProbeComponent* c = m_node->newComponent<GlobalIlluminationProbeComponent>();
+		iterateProperties(comp, [&](const SceneBinaryProperty& prop) {
+			switch(prop.m_type)
+			{
+			case PType::kBoxVolumeSize:
+				c->setBoxVolumeSize(getVec3(prop));
+				break;
+			case PType::kFadeDistance:
+				c->setFadeDistance(prop.m_floatValues[0]);
+				break;
+			case PType::kCellSize:
+				c->setCellSize(prop.m_floatValues[0]);
+				break;
+			default:
+				return false;
+			}
+			return true;
+		});
+		break;
+	}
+	case SceneBinaryComponentType::kDecal:
+	{
+		DecalComponent* c = m_node->newComponent<DecalComponent>();
+		iterateProperties(comp, [&](const SceneBinaryProperty& prop) {
+			switch(prop.m_type)
+			{
+			case PType::kResource:
+				c->loadDiffuseImageResource(getResourceFilename(prop), prop.m_floatValues[0]);
+				break;
+			case PType::kRoughnessMetalnessResource:
+				c->loadRoughnessMetalnessImageResource(getResourceFilename(prop), prop.m_floatValues[0]);
+				break;
+			case PType::kBoxVolumeSize:
+				c->setBoxVolumeSize(getVec3(prop));
+				break;
+			default:
+				return false;
+			}
+			return true;
+		});
+		break;
+	}
+	case SceneBinaryComponentType::kParticleEmitter:
+	{
+		ParticleEmitterComponent* c = m_node->newComponent<ParticleEmitterComponent>();
+		iterateProperties(comp, [&](const SceneBinaryProperty& prop) {
+			if(prop.m_type == PType::kResource)
+			{
+				c->loadParticleEmitterResource(getResourceFilename(prop));
+				return true;
+			}
+			return false;
+		});
+		break;
+	}
+	case SceneBinaryComponentType::kSkybox:
+	{
+		SkyboxComponent* c = m_node->newComponent<SkyboxComponent>();
+		iterateProperties(comp, [&](const SceneBinaryProperty& prop) {
+			switch(prop.m_type)
+			{
+			case PType::kResource:
+				c->loadImageResource(getResourceFilename(prop));
+				break;
+			case PType::kSolidColor:
+				c->setSolidColor(getVec3(prop));
+				break;
+			case PType::kImageScale:
+				c->setImageScale(getVec3(prop));
+				break;
+			case PType::kGeneratedSky:
+				c->setGeneratedSky();
+				break;
+			case PType::kMinFogDensity:
+				c->setMinFogDensity(prop.m_floatValues[0]);
+				break;
+			case PType::kMaxFogDensity:
+				c->setMaxFogDensity(prop.m_floatValues[0]);
+				break;
+			case PType::kHeightOfMinFogDensity:
+				c->setHeightOfMinFogDensity(prop.m_floatValues[0]);
+				break;
+			case PType::kHeightOfMaxFogDensity:
+				c->setHeightOfMaxFogDensity(prop.m_floatValues[0]);
+				break;
+			case PType::kFogDiffuseColor:
+				c->setFogDiffuseColor(getVec3(prop));
+				break;
+			default:
+				return false;
+			}
+			return true;
+		});
+		break;
+	}
+	case SceneBinaryComponentType::kCamera:
+	{
+		CameraComponent* c = m_node->newComponent<CameraComponent>();
+		iterateProperties(comp, [&](const SceneBinaryProperty& prop) {
+			switch(prop.m_type)
+			{
+			case PType::kPerspective:
+			{
+				const F32 aspectRatio = F32(g_windowWidthCVar) / F32(g_windowHeightCVar);
+				const F32 fovY = prop.m_floatValues[2];
+				c->setPerspective(prop.m_floatValues[0], prop.m_floatValues[1], aspectRatio * fovY, fovY);
+				break;
+			}
+			case PType::kActiveCamera:
+				SceneGraph::getSingleton().setActiveCameraNode(m_node);
+				break;
+			default:
+				return false;
+			}
+			return true;
+		});
+		break;
+	}
+	default:
+		ANKI_ASSERT(0);
+	}
+
+	return Error::kNone;
+}
+
+Error SceneGraph::loadSceneBinary(CString filename)
+{
+	SceneBinary* binary = nullptr;
+	{
+		ResourceFilePtr file;
+		ANKI_CHECK(ResourceManager::getSingleton().getFilesystem().openFile(filename, file));
+		BinaryDeserializer deserializer;
+		ANKI_CHECK(deserializer.deserialize(binary, SceneMemoryPool::getSingleton(), *file));
+	}
+
+	const Error err = loadSceneBinary(*binary, filename);
+	SceneMemoryPool::getSingleton().free(binary);
+	return err;
+}
+
+Error SceneGraph::loadSceneBinary(const SceneBinary& binary, CString filename)
+{
+	ANKI_TRACE_SCOPED_EVENT(SceneLoadBinary);
+	const Second startTime = HighRezTimer::getCurrentTime();
+
+	ANKI_CHECK(validateSceneBinary(binary));
+
+	// Load all resources before the nodes. The components will find them in the resource cache
+	SceneBinaryResources resources;
+	for(const SceneBinaryResource& rsrc : binary.m_resources)
+	{
+		const CString rsrcFilename = &binary.m_strings[rsrc.m_filenameOffset];
+		switch(rsrc.m_type)
+		{
+		case SceneBinaryResourceType::kModel:
+			ANKI_CHECK(SceneBinaryResources::load(rsrcFilename, resources.m_models));
+			break;
+		case SceneBinaryResourceType::kSkeleton:
+			ANKI_CHECK(SceneBinaryResources::load(rsrcFilename, resources.m_skeletons));
+			break;
+		case SceneBinaryResourceType::kImage:
+			ANKI_CHECK(SceneBinaryResources::load(rsrcFilename, resources.m_images));
+			break;
+		case SceneBinaryResourceType::kCpuMesh:
+			ANKI_CHECK(SceneBinaryResources::load(rsrcFilename, resources.m_cpuMeshes));
+			break;
+		case SceneBinaryResourceType::kParticleEmitter:
+			ANKI_CHECK(SceneBinaryResources::load(rsrcFilename, resources.m_particleEmitters));
+			break;
+		default:
+			ANKI_ASSERT(0);
+		}
+	}
+
+	// Preallocate the components
+	Array<U32, U32(SceneBinaryComponentType::kCount)> componentCounts = {};
+	for(const SceneBinaryComponent& comp : binary.m_components)
+	{
+		++componentCounts[comp.m_type];
+	}
+
+	auto reserve = [](auto& componentArray, U32 newCount) {
+		componentArray.reserve(componentArray.getSize() + newCount);
+	};
+	reserve(m_componentArrays.getMoves(), binary.m_nodes.getSize());
+	reserve(m_componentArrays.getModels(), componentCounts[SceneBinaryComponentType::kModel]);
+	reserve(m_componentArrays.getSkins(), componentCounts[SceneBinaryComponentType::kSkin]);
+	reserve(m_componentArrays.getLights(), componentCounts[SceneBinaryComponentType::kLight]);
+	reserve(m_componentArrays.getLensFlares(), componentCounts[SceneBinaryComponentType::kLensFlare]);
+	reserve(m_componentArrays.getBodys(), componentCounts[SceneBinaryComponentType::kBody]);
+	reserve(m_componentArrays.getReflectionProbes(), componentCounts[SceneBinaryComponentType::kReflectionProbe]);
+	reserve(m_componentArrays.getGlobalIlluminationProbes(), componentCounts[SceneBinaryComponentType::kGlobalIlluminationProbe]);
+	reserve(m_componentArrays.getDecals(), componentCounts[SceneBinaryComponentType::kDecal]);
+	reserve(m_componentArrays.getParticleEmitters(), componentCounts[SceneBinaryComponentType::kParticleEmitter]);
+	reserve(m_componentArrays.getSkyboxs(), componentCounts[SceneBinaryComponentType::kSkybox]);
+	reserve(m_componentArrays.getCameras(), componentCounts[SceneBinaryComponentType::kCamera]);
+
+	// Create the nodes
+	SceneDynamicArray<SceneNode*> nodes;
+	SceneDynamicArray<Transform> worldTransforms;
+	nodes.resize(binary.m_nodes.getSize(), nullptr);
+	worldTransforms.resize(binary.m_nodes.getSize());
+
+	SceneBinaryComponentCreator creator;
+	creator.m_binary = &binary;
+
+	for(U32 i = 0; i < binary.m_nodes.getSize(); ++i)
+	{
+		const SceneBinaryNode& inNode = binary.m_nodes[i];
+		const CString name = (inNode.m_nameOffset != kMaxU32) ? CString(&binary.m_strings[inNode.m_nameOffset]) : CString();
+
+		ANKI_CHECK(newSceneNode(name, nodes[i]));
+		SceneNode& node = *nodes[i];
+
+		Mat3 rotation;
+		for(U32 j = 0; j < 9; ++j)
+		{
+			rotation(j / 3, j % 3) = inNode.m_rotation[j];
+		}
+		const Transform localTrf(Vec3(inNode.m_origin[0], inNode.m_origin[1], inNode.m_origin[2]), rotation,
+								 Vec3(inNode.m_scale[0], inNode.m_scale[1], inNode.m_scale[2]));
+		node.setLocalTransform(localTrf);
+
+		if(inNode.m_parent != kMaxU32)
+		{
+			nodes[inNode.m_parent]->addChild(&node);
+			worldTransforms[i] = worldTransforms[inNode.m_parent].combineTransformations(localTrf);
+		}
+		else
+		{
+			worldTransforms[i] = localTrf;
+		}
+
+		creator.m_node = &node;
+		creator.m_worldTransform = worldTransforms[i];
+		for(U32 c = inNode.m_firstComponent; c < inNode.m_firstComponent + inNode.m_componentCount; ++c)
+		{
+			ANKI_CHECK(creator.createComponent(binary.m_components[c]));
+		}
+	}
+
+	ANKI_SCENE_LOGI("Loaded scene binary %s: %u nodes, %u components, %u resources in %.2fms", filename.cstr(), binary.m_nodes.getSize(),
+					binary.m_components.getSize(), binary.m_resources.getSize(), (HighRezTimer::getCurrentTime() - startTime) * 1000.0);
+
+	return Error::kNone;
+}
+
+} // end namespace anki
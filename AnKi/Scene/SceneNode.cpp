@@ -49,6 +49,8 @@ SceneNode::SceneNode(CString name)
 		m_name = name;
 	}
 
+	m_transformIndex = TransformHierarchy::getSingleton().newTransform(this);
+
 	// Add the implicit MoveComponent
 	newComponent<MoveComponent>();
 }
@@ -70,6 +72,8 @@ SceneNode::~SceneNode()
 			ANKI_ASSERT(0);
 		}
 	}
+
+	TransformHierarchy::getSingleton().deleteTransform(m_transformIndex);
 }
 
 void SceneNode::setMarkedForDeletion()
@@ -120,40 +124,4 @@ void SceneNode::newComponentInternal(SceneComponent* newc)
 	});
 }
 
-Bool SceneNode::updateTransform()
-{
-	const Bool needsUpdate = m_localTransformDirty;
-	m_localTransformDirty = false;
-	const Bool updatedLastFrame = m_transformUpdatedThisFrame;
-	m_transformUpdatedThisFrame = needsUpdate;
-
-	if(needsUpdate || updatedLastFrame)
-	{
-		m_prevWTrf = m_wtrf;
-	}
-
-	// Update world transform
-	if(needsUpdate)
-	{
-		const SceneNode* parent = getParent();
-
-		if(parent == nullptr || m_ignoreParentNodeTransform)
-		{
-			m_wtrf = m_ltrf;
-		}
-		else
-		{
-			m_wtrf = parent->getWorldTransform().combineTransformations(m_ltrf);
-		}
-
-		// Make children dirty as well. Don't walk the whole tree because you will re-walk it later
-		[[maybe_unused]] const Error err = visitChildrenMaxDepth(1, [](SceneNode& childNode) -> Error {
-			childNode.m_localTransformDirty = true;
-			return Error::kNone;
-		});
-	}
-
-	return needsUpdate;
-}
-
 } // end namespace anki
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <AnKi/Scene/Components/SceneComponent.h>
+#include <AnKi/Scene/TransformHierarchy.h>
 #include <AnKi/Util/Hierarchy.h>
 #include <AnKi/Util/BitMask.h>
 #include <AnKi/Util/BitSet.h>
@@ -21,6 +22,7 @@ namespace anki {
 class SceneNode : public SceneHierarchy<SceneNode>, public IntrusiveListEnabled<SceneNode>
 {
 	friend class SceneComponent;
+	friend class TransformHierarchy;
 
 public:
 	using Base = SceneHierarchy<SceneNode>;
@@ -57,20 +59,38 @@ public:
 
 	void setMarkedForDeletion();
 
-	Timestamp getComponentMaxTimestamp() const
+	void addChild(SceneNode* obj)
 	{
-		return m_maxComponentTimestamp;
+		Base::addChild(obj);
+		TransformHierarchy::getSingleton().markHierarchyChanged(obj->m_transformIndex);
+		TransformHierarchy::getSingleton().markLocalDirty(obj->m_transformIndex);
 	}
 
-	void setComponentMaxTimestamp(Timestamp maxComponentTimestamp)
+	/// Detach a child. It becomes a root node.
+	void removeChild(SceneNode* obj)
 	{
-		ANKI_ASSERT(maxComponentTimestamp > 0);
-		m_maxComponentTimestamp = maxComponentTimestamp;
+		Base::removeChild(obj);
+		TransformHierarchy::getSingleton().markHierarchyChanged(obj->m_transformIndex);
+		TransformHierarchy::getSingleton().markLocalDirty(obj->m_transformIndex);
 	}
 
-	void addChild(SceneNode* obj)
+	/// Move the node under a new parent. If the parent is nullptr it becomes a root node.
+	void setParent(SceneNode* parent)
 	{
-		Base::addChild(obj);
+		if(getParent() == parent)
+		{
+			return;
+		}
+
+		if(getParent())
+		{
+			getParent()->removeChild(this);
+		}
+
+		if(parent)
+		{
+			parent->addChild(this);
+		}
 	}
 
 	/// This is called by the scenegraph every frame after all component updates. By default it does nothing.
@@ -81,6 +101,12 @@ public:
 		return Error::kNone;
 	}
 
+	/// The types of the components the node has.
+	SceneComponentTypeMask getComponentTypeMask() const
+	{
+		return m_componentTypeMask;
+	}
+
 	/// Iterate all components.
 	template<typename TFunct>
 	void iterateComponents(TFunct func) const
@@ -250,133 +276,137 @@ public:
 		return count;
 	}
 
+	Bool getIgnoreParentTransform() const
+	{
+		return m_ignoreParentNodeTransform;
+	}
+
 	/// Ignore parent nodes's transform.
 	void setIgnoreParentTransform(Bool ignore)
 	{
-		m_ignoreParentNodeTransform = ignore;
+		if(m_ignoreParentNodeTransform != ignore)
+		{
+			m_ignoreParentNodeTransform = ignore;
+			TransformHierarchy::getSingleton().markHierarchyChanged(m_transformIndex);
+			TransformHierarchy::getSingleton().markLocalDirty(m_transformIndex);
+		}
 	}
 
 	const Transform& getLocalTransform() const
 	{
-		return m_ltrf;
+		return TransformHierarchy::getSingleton().m_localTransforms[m_transformIndex];
 	}
 
 	void setLocalTransform(const Transform& x)
 	{
-		m_ltrf = x;
-		m_localTransformDirty = true;
+		getLocalTransformForWrite() = x;
 	}
 
 	void setLocalOrigin(const Vec4& x)
 	{
-		m_ltrf.setOrigin(x);
-		m_localTransformDirty = true;
+		getLocalTransformForWrite().setOrigin(x);
 	}
 
 	const Vec4& getLocalOrigin() const
 	{
-		return m_ltrf.getOrigin();
+		return getLocalTransform().getOrigin();
 	}
 
 	void setLocalRotation(const Mat3x4& x)
 	{
-		m_ltrf.setRotation(x);
-		m_localTransformDirty = true;
+		getLocalTransformForWrite().setRotation(x);
 	}
 
 	const Mat3x4& getLocalRotation() const
 	{
-		return m_ltrf.getRotation();
+		return getLocalTransform().getRotation();
 	}
 
 	void setLocalScale(const Vec4& x)
 	{
-		m_ltrf.setScale(x);
-		m_localTransformDirty = true;
+		getLocalTransformForWrite().setScale(x);
 	}
 
 	const Vec4& getLocalScale() const
 	{
-		return m_ltrf.getScale();
+		return getLocalTransform().getScale();
 	}
 
 	const Transform& getWorldTransform() const
 	{
-		return m_wtrf;
+		return TransformHierarchy::getSingleton().m_worldTransforms[m_transformIndex];
 	}
 
 	const Transform& getPreviousWorldTransform() const
 	{
-		return m_prevWTrf;
+		return TransformHierarchy::getSingleton().m_prevWorldTransforms[m_transformIndex];
 	}
 
 	/// @name Mess with the local transform
 	/// @{
 	void rotateLocalX(F32 angleRad)
 	{
-		Mat3x4 r = m_ltrf.getRotation();
+		Transform& ltrf = getLocalTransformForWrite();
+		Mat3x4 r = ltrf.getRotation();
 		r.rotateXAxis(angleRad);
-		m_ltrf.setRotation(r);
-		m_localTransformDirty = true;
+		ltrf.setRotation(r);
 	}
 
 	void rotateLocalY(F32 angleRad)
 	{
-		Mat3x4 r = m_ltrf.getRotation();
+		Transform& ltrf = getLocalTransformForWrite();
+		Mat3x4 r = ltrf.getRotation();
 		r.rotateYAxis(angleRad);
-		m_ltrf.setRotation(r);
-		m_localTransformDirty = true;
+		ltrf.setRotation(r);
 	}
 
 	void rotateLocalZ(F32 angleRad)
 	{
-		Mat3x4 r = m_ltrf.getRotation();
+		Transform& ltrf = getLocalTransformForWrite();
+		Mat3x4 r = ltrf.getRotation();
 		r.rotateZAxis(angleRad);
-		m_ltrf.setRotation(r);
-		m_localTransformDirty = true;
+		ltrf.setRotation(r);
 	}
 
 	void moveLocalX(F32 distance)
 	{
-		Vec3 x_axis = m_ltrf.getRotation().getColumn(0);
-		m_ltrf.setOrigin(m_ltrf.getOrigin() + Vec4(x_axis, 0.0f) * distance);
-		m_localTransformDirty = true;
+		Transform& ltrf = getLocalTransformForWrite();
+		Vec3 x_axis = ltrf.getRotation().getColumn(0);
+		ltrf.setOrigin(ltrf.getOrigin() + Vec4(x_axis, 0.0f) * distance);
 	}
 
 	void moveLocalY(F32 distance)
 	{
-		Vec3 y_axis = m_ltrf.getRotation().getColumn(1);
-		m_ltrf.setOrigin(m_ltrf.getOrigin() + Vec4(y_axis, 0.0) * distance);
-		m_localTransformDirty = true;
+		Transform& ltrf = getLocalTransformForWrite();
+		Vec3 y_axis = ltrf.getRotation().getColumn(1);
+		ltrf.setOrigin(ltrf.getOrigin() + Vec4(y_axis, 0.0) * distance);
 	}
 
 	void moveLocalZ(F32 distance)
 	{
-		Vec3 z_axis = m_ltrf.getRotation().getColumn(2);
-		m_ltrf.setOrigin(m_ltrf.getOrigin() + Vec4(z_axis, 0.0) * distance);
-		m_localTransformDirty = true;
+		Transform& ltrf = getLocalTransformForWrite();
+		Vec3 z_axis = ltrf.getRotation().getColumn(2);
+		ltrf.setOrigin(ltrf.getOrigin() + Vec4(z_axis, 0.0) * distance);
 	}
 
 	void scale(F32 s)
 	{
-		m_ltrf.setScale(m_ltrf.getScale() * s);
-		m_localTransformDirty = true;
+		Transform& ltrf = getLocalTransformForWrite();
+		ltrf.setScale(ltrf.getScale() * s);
 	}
 
 	void lookAtPoint(const Vec4& point)
 	{
-		m_ltrf.lookAt(point, Vec4(0.0f, 1.0f, 0.0f, 0.0f));
-		m_localTransformDirty = true;
+		getLocalTransformForWrite().lookAt(point, Vec4(0.0f, 1.0f, 0.0f, 0.0f));
 	}
 	/// @}
 
+	/// The world transform changed in this frame's TransformHierarchy::update().
 	Bool movedThisFrame() const
 	{
-		return m_transformUpdatedThisFrame;
+		return TransformHierarchy::getSingleton().updatedThisFrame(m_transformIndex);
 	}
 
-	ANKI_INTERNAL Bool updateTransform();
-
 	/// Create and append a component to the components container. The SceneNode has the ownership.
 	template<typename TComponent>
 	TComponent* newComponent();
@@ -389,24 +419,20 @@ private:
 
 	GrDynamicArray<SceneComponent*> m_components;
 
-	Timestamp m_maxComponentTimestamp = 0;
-
-	/// The transformation in local space.
-	Transform m_ltrf = Transform::getIdentity();
-
-	/// The transformation in world space (local combined with parent's transformation).
-	Transform m_wtrf = Transform::getIdentity();
-
-	/// Keep the previous transformation for checking if it moved.
-	Transform m_prevWTrf = Transform::getIdentity();
+	/// The index of the local, world and previous world transforms inside the TransformHierarchy.
+	U32 m_transformIndex = kMaxU32;
 
 	// Flags
 	Bool m_markedForDeletion : 1 = false;
-	Bool m_localTransformDirty : 1 = true;
 	Bool m_ignoreParentNodeTransform : 1 = false;
-	Bool m_transformUpdatedThisFrame : 1 = true;
 
 	void newComponentInternal(SceneComponent* newc);
+
+	Transform& getLocalTransformForWrite()
+	{
+		TransformHierarchy::getSingleton().markLocalDirty(m_transformIndex);
+		return TransformHierarchy::getSingleton().m_localTransforms[m_transformIndex];
+	}
 };
 /// @}
 
@@ -7,6 +7,7 @@
 #include <AnKi/Scene/Components/UiComponent.h>
 #include <AnKi/Core/StatsSet.h>
 #include <AnKi/Core/App.h>
+#include <AnKi/Core/AllocationProfiler.h>
 #include <AnKi/Ui/UiManager.h>
 #include <AnKi/Ui/Font.h>
 #include <AnKi/Renderer/Renderer.h>
@@ -157,6 +158,20 @@ void StatsUiNode::draw(CanvasPtr& canvas)
 					ImGui::Text("%s: %f", name, value);
 					++count;
 				});
+
+			if(AllocationProfiler::isAllocated())
+			{
+				ImGui::Text("-- CPU allocations per pool --");
+				AllocationProfiler::getSingleton().iteratePools([](CString name, const AllocationProfilerStats& stats) {
+					ImGui::Text("%s: %u/frame", name.cstr(), stats.m_frameAllocationCount);
+					labelBytes(max<I64>(stats.m_liveBytes, 0), "  Live");
+				});
+
+				if(g_allocationProfilerStackSamplingCVar)
+				{
+					ImGui::Text("Sampled sites allocating: %u", AllocationProfiler::getSingleton().getFrameAllocatingSiteCount());
+				}
+			}
 		}
 		else
 		{
@@ -0,0 +1,512 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Scene/TransformHierarchy.h>
+#include <AnKi/Scene/SceneNode.h>
+#include <AnKi/Core/Common.h>
+#include <AnKi/Util/Tracer.h>
+
+namespace anki {
+
+TransformHierarchy::~TransformHierarchy()
+{
+	ANKI_ASSERT(std::find_if(m_nodes.getBegin(), m_nodes.getEnd(),
+							 [](const SceneNode* node) {
+								 return node != nullptr;
+							 })
+					== m_nodes.getEnd()
+				&& "Some nodes are still alive");
+}
+
+U32 TransformHierarchy::newTransform(SceneNode* node)
+{
+	ANKI_ASSERT(node);
+
+	// New nodes are roots. Take a slot of the first level or put it past the levels and find a slot in the next update()
+	U32 idx = allocateSlot(0);
+	if(idx == kInvalidIndex)
+	{
+		idx = m_nodes.getSize();
+		resizeArrays(idx + 1);
+		++m_unplacedCount;
+		markHierarchyChanged(idx);
+	}
+
+	m_localTransforms[idx] = Transform::getIdentity();
+	m_worldTransforms[idx] = Transform::getIdentity();
+	m_prevWorldTransforms[idx] = Transform::getIdentity();
+	m_parents[idx] = kInvalidIndex;
+	m_nodes[idx] = node;
+
+	markLocalDirty(idx);
+	m_updatedThisFrame[idx / kBitsPerWord] |= U64(1) << (idx % kBitsPerWord);
+
+	return idx;
+}
+
+void TransformHierarchy::deleteTransform(U32 idx)
+{
+	ANKI_ASSERT(m_nodes[idx]);
+	freeSlot(idx); // The free slots are compacted in update()
+}
+
+void TransformHierarchy::freeSlot(U32 idx)
+{
+	m_nodes[idx] = nullptr;
+	m_parents[idx] = kInvalidIndex;
+
+	const U64 mask = ~(U64(1) << (idx % kBitsPerWord));
+	m_localDirty[idx / kBitsPerWord].fetchAnd(mask);
+	m_updatedThisFrame[idx / kBitsPerWord] &= mask;
+
+	const U32 level = getLevel(idx);
+	if(level != kInvalidIndex)
+	{
+		m_levelFreeSlots[level].emplaceBack(idx);
+		++m_freeSlotCount;
+	}
+	else
+	{
+		ANKI_ASSERT(m_unplacedCount > 0);
+		--m_unplacedCount;
+	}
+}
+
+U32 TransformHierarchy::getLevel(U32 idx) const
+{
+	if(m_levelOffsets.getSize() == 0 || idx >= m_levelOffsets.getBack())
+	{
+		return kInvalidIndex;
+	}
+
+	const U32* it = std::upper_bound(m_levelOffsets.getBegin(), m_levelOffsets.getEnd(), idx);
+	return U32(it - m_levelOffsets.getBegin()) - 1;
+}
+
+U32 TransformHierarchy::allocateSlot(U32 level)
+{
+	const U32 levelCount = getHierarchyLevelCount();
+	if(level < levelCount && m_levelFreeSlots[level].getSize())
+	{
+		const U32 idx = m_levelFreeSlots[level].getBack();
+		m_levelFreeSlots[level].popBack();
+		--m_freeSlotCount;
+		return idx;
+	}
+
+	// Only the last level can grow and only if there are no transforms past it
+	if(m_unplacedCount > 0 || level + 1 < levelCount || level > levelCount)
+	{
+		return kInvalidIndex;
+	}
+
+	if(level == levelCount)
+	{
+		// Add a level. It starts at a bitset word like the rest
+		const U32 levelsEnd = (levelCount) ? m_levelOffsets.getBack() : 0;
+		const U32 begin = getAlignedRoundUp(kBitsPerWord, levelsEnd);
+		if(levelCount)
+		{
+			for(U32 i = begin - 1; i != levelsEnd - 1; --i)
+			{
+				m_levelFreeSlots.getBack().emplaceBack(i);
+				++m_freeSlotCount;
+			}
+			m_levelOffsets.getBack() = begin;
+		}
+		else
+		{
+			m_levelOffsets.emplaceBack(0);
+		}
+
+		m_levelOffsets.emplaceBack(begin);
+		m_levelFreeSlots.emplaceBack();
+	}
+
+	// Grow the last level by a bitset word
+	const U32 oldEnd = m_levelOffsets.getBack();
+	const U32 newEnd = oldEnd + kBitsPerWord;
+	resizeArrays(newEnd);
+	m_levelOffsets.getBack() = newEnd;
+	for(U32 i = newEnd - 1; i > oldEnd; --i)
+	{
+		m_levelFreeSlots[level].emplaceBack(i);
+		++m_freeSlotCount;
+	}
+
+	return oldEnd;
+}
+
+void TransformHierarchy::resizeArrays(U32 transformCount)
+{
+	m_localTransforms.resize(transformCount, Transform::getIdentity());
+	m_worldTransforms.resize(transformCount, Transform::getIdentity());
+	m_prevWorldTransforms.resize(transformCount, Transform::getIdentity());
+	m_parents.resize(transformCount, kInvalidIndex);
+	m_nodes.resize(transformCount, nullptr);
+	resizeBitsets(transformCount);
+}
+
+Bool TransformHierarchy::placeTransform(U32 idx)
+{
+	SceneNode* node = (idx < m_nodes.getSize()) ? m_nodes[idx] : nullptr;
+	if(!node)
+	{
+		return true; // Deleted or moved
+	}
+
+	U32 level = 0;
+	U32 parentIdx = kInvalidIndex;
+	if(const SceneNode* parent = node->getParent())
+	{
+		const U32 parentLevel = getLevel(parent->m_transformIndex);
+		if(parentLevel == kInvalidIndex)
+		{
+			return false; // The parent is new and it will be placed later
+		}
+
+		level = parentLevel + 1;
+		parentIdx = (node->m_ignoreParentNodeTransform) ? kInvalidIndex : parent->m_transformIndex;
+	}
+
+	if(getLevel(idx) == level)
+	{
+		m_parents[idx] = parentIdx;
+		return true;
+	}
+
+	if(node->hasChildren())
+	{
+		return false; // The whole subtree changes level
+	}
+
+	const U32 newIdx = allocateSlot(level);
+	if(newIdx == kInvalidIndex)
+	{
+		return false;
+	}
+
+	m_localTransforms[newIdx] = m_localTransforms[idx];
+	m_worldTransforms[newIdx] = m_worldTransforms[idx];
+	m_prevWorldTransforms[newIdx] = m_prevWorldTransforms[idx];
+	m_parents[newIdx] = parentIdx;
+	m_nodes[newIdx] = node;
+	node->m_transformIndex = newIdx;
+
+	const U64 oldBit = U64(1) << (idx % kBitsPerWord);
+	const U64 newBit = U64(1) << (newIdx % kBitsPerWord);
+	if(m_localDirty[idx / kBitsPerWord].getNonAtomically() & oldBit)
+	{
+		markLocalDirty(newIdx);
+	}
+
+	if(m_updatedThisFrame[idx / kBitsPerWord] & oldBit)
+	{
+		m_updatedThisFrame[newIdx / kBitsPerWord] |= newBit;
+	}
+
+	freeSlot(idx);
+	return true;
+}
+
+Bool TransformHierarchy::placeChangedTransforms()
+{
+	ANKI_TRACE_SCOPED_EVENT(SceneTransformPlace);
+
+	for(U32 idx : m_hierarchyChanges)
+	{
+		if(!placeTransform(idx))
+		{
+			return false;
+		}
+	}
+
+	// Drop the levels that became empty
+	while(getHierarchyLevelCount() && m_unplacedCount == 0
+		  && m_levelFreeSlots.getBack().getSize() == m_levelOffsets.getBack() - m_levelOffsets[m_levelOffsets.getSize() - 2])
+	{
+		m_freeSlotCount -= m_levelFreeSlots.getBack().getSize();
+		m_levelFreeSlots.popBack();
+		m_levelOffsets.popBack();
+		resizeArrays(m_levelOffsets.getBack());
+
+		if(m_levelOffsets.getSize() == 1)
+		{
+			m_levelOffsets.destroy();
+		}
+	}
+
+	return true;
+}
+
+void TransformHierarchy::resizeBitsets(U32 transformCount)
+{
+	const U32 wordCount = (transformCount + kBitsPerWord - 1) / kBitsPerWord;
+	if(wordCount <= m_localDirty.getSize())
+	{
+		return;
+	}
+
+	// Atomics are not movable so create a new array and copy the bits manually
+	SceneDynamicArray<Atomic<U64>> newLocalDirty;
+	newLocalDirty.resize(max(wordCount, m_localDirty.getSize() * 2), 0);
+	for(U32 i = 0; i < m_localDirty.getSize(); ++i)
+	{
+		newLocalDirty[i].setNonAtomically(m_localDirty[i].getNonAtomically());
+	}
+	m_localDirty = std::move(newLocalDirty);
+
+	m_updatedThisFrame.resize(m_localDirty.getSize(), 0);
+}
+
+void TransformHierarchy::sort()
+{
+	ANKI_TRACE_SCOPED_EVENT(SceneTransformSort);
+
+	const U32 oldCount = m_nodes.getSize();
+
+	// Compute the depth of every node. Only happens when the levels can't be patched so walking the parents is fine
+	SceneDynamicArray<U32> depths;
+	depths.resize(oldCount, kInvalidIndex);
+	U32 levelCount = 0;
+	for(U32 i = 0; i < oldCount; ++i)
+	{
+		const SceneNode* node = m_nodes[i];
+		if(!node)
+		{
+			continue;
+		}
+
+		U32 depth = 0;
+		for(const SceneNode* parent = node->getParent(); parent; parent = parent->getParent())
+		{
+			++depth;
+		}
+
+		depths[i] = depth;
+		levelCount = max(levelCount, depth + 1);
+	}
+
+	// Counting sort. Every level starts at the beginning of a bitset word so the threads of a level never write to the words of another
+	SceneDynamicArray<U32> levelCounts;
+	levelCounts.resize(levelCount, 0);
+	for(U32 depth : depths)
+	{
+		if(depth != kInvalidIndex)
+		{
+			++levelCounts[depth];
+		}
+	}
+
+	// Leave some free slots in the levels for the nodes that will be added or moved later. The last level can grow at the end of the arrays
+	m_levelOffsets.destroy();
+	m_levelOffsets.resize(levelCount + 1, 0);
+	for(U32 level = 1; level < m_levelOffsets.getSize(); ++level)
+	{
+		m_levelOffsets[level] = m_levelOffsets[level - 1] + levelCounts[level - 1];
+		if(level < levelCount)
+		{
+			m_levelOffsets[level] = getAlignedRoundUp(kBitsPerWord, m_levelOffsets[level] + levelCounts[level - 1] / 4);
+		}
+	}
+	const U32 newCount = m_levelOffsets.getBack(); // Includes the padding
+
+	SceneDynamicArray<U32> levelCursors;
+	levelCursors.resize(levelCount);
+	memcpy(levelCursors.getBegin(), m_levelOffsets.getBegin(), levelCursors.getSizeInBytes());
+
+	SceneDynamicArray<Transform> localTransforms;
+	SceneDynamicArray<Transform> worldTransforms;
+	SceneDynamicArray<Transform> prevWorldTransforms;
+	SceneDynamicArray<SceneNode*> nodes;
+	localTransforms.resize(newCount);
+	worldTransforms.resize(newCount);
+	prevWorldTransforms.resize(newCount);
+	nodes.resize(newCount, nullptr);
+
+	const U32 newWordCount = (newCount + kBitsPerWord - 1) / kBitsPerWord;
+	SceneDynamicArray<Atomic<U64>> localDirty;
+	SceneDynamicArray<U64> updatedThisFrame;
+	localDirty.resize(newWordCount, 0);
+	updatedThisFrame.resize(newWordCount, 0);
+
+	for(U32 i = 0; i < oldCount; ++i)
+	{
+		if(depths[i] == kInvalidIndex)
+		{
+			continue;
+		}
+
+		const U32 newIdx = levelCursors[depths[i]]++;
+
+		localTransforms[newIdx] = m_localTransforms[i];
+		worldTransforms[newIdx] = m_worldTransforms[i];
+		prevWorldTransforms[newIdx] = m_prevWorldTransforms[i];
+		nodes[newIdx] = m_nodes[i];
+		nodes[newIdx]->m_transformIndex = newIdx;
+
+		const U64 oldBit = U64(1) << (i % kBitsPerWord);
+		const U64 newBit = U64(1) << (newIdx % kBitsPerWord);
+		if(m_localDirty[i / kBitsPerWord].getNonAtomically() & oldBit)
+		{
+			localDirty[newIdx / kBitsPerWord].setNonAtomically(localDirty[newIdx / kBitsPerWord].getNonAtomically() | newBit);
+		}
+
+		if(m_updatedThisFrame[i / kBitsPerWord] & oldBit)
+		{
+			updatedThisFrame[newIdx / kBitsPerWord] |= newBit;
+		}
+	}
+
+	// Now that all nodes have their final index fix the parents
+	m_parents.destroy();
+	m_parents.resize(newCount, kInvalidIndex);
+	for(U32 i = 0; i < newCount; ++i)
+	{
+		const SceneNode* node = nodes[i];
+		if(!node)
+		{
+			continue; // Padding
+		}
+
+		const SceneNode* parent = node->getParent();
+		m_parents[i] = (parent && !node->m_ignoreParentNodeTransform) ? parent->m_transformIndex : kInvalidIndex;
+		ANKI_ASSERT(m_parents[i] == kInvalidIndex || m_parents[i] < i);
+	}
+
+	// Gather the free slots. Iterate backwards so the free slots are given from the start of each level
+	m_levelFreeSlots.destroy();
+	m_levelFreeSlots.resize(levelCount);
+	m_freeSlotCount = 0;
+	for(U32 level = 0; level < levelCount; ++level)
+	{
+		for(U32 i = m_levelOffsets[level + 1] - 1; i != levelCursors[level] - 1; --i)
+		{
+			m_levelFreeSlots[level].emplaceBack(i);
+			++m_freeSlotCount;
+		}
+	}
+
+	m_unplacedCount = 0;
+	++m_sortCount;
+
+	m_localTransforms = std::move(localTransforms);
+	m_worldTransforms = std::move(worldTransforms);
+	m_prevWorldTransforms = std::move(prevWorldTransforms);
+	m_nodes = std::move(nodes);
+	m_localDirty = std::move(localDirty);
+	m_updatedThisFrame = std::move(updatedThisFrame);
+}
+
+void TransformHierarchy::update(Bool newFrame)
+{
+	ANKI_TRACE_SCOPED_EVENT(SceneTransformUpdate);
+
+	// Try to move the nodes that changed parent to free slots of their new levels. Sort everything if that doesn't work
+	if(!m_hierarchyDirty && m_hierarchyChanges.getSize())
+	{
+		m_hierarchyDirty = !placeChangedTransforms();
+	}
+	m_hierarchyChanges.destroy();
+
+	// Compact the arrays if they are mostly free slots
+	if(m_freeSlotCount > m_nodes.getSize() / 2 + kTransformsPerJob)
+	{
+		m_hierarchyDirty = true;
+	}
+
+	if(m_hierarchyDirty)
+	{
+		sort();
+		m_hierarchyDirty = false;
+	}
+
+	// Go level by level. All parents of a level are in the previous levels so they are already updated
+	for(U32 level = 0; level < getHierarchyLevelCount(); ++level)
+	{
+		const U32 levelBegin = m_levelOffsets[level];
+		const U32 levelEnd = m_levelOffsets[level + 1];
+
+		if(levelEnd - levelBegin <= kTransformsPerJob || CoreThreadJobManager::getSingleton().getThreadCount() <= 1)
+		{
+			updateRange(levelBegin, levelEnd, newFrame);
+			continue;
+		}
+
+		// Levels and jobs are aligned to the bitset words so different threads won't write to the same word
+		ANKI_ASSERT(isAligned(kBitsPerWord, levelBegin));
+		const U32 jobCount = (levelEnd - levelBegin + kTransformsPerJob - 1) / kTransformsPerJob;
+		Atomic<U32> jobIdx = {0};
+
+		auto updateJobs = [&]() {
+			ANKI_TRACE_SCOPED_EVENT(SceneTransformUpdateJob);
+
+			U32 job;
+			while((job = jobIdx.fetchAdd(1)) < jobCount)
+			{
+				const U32 begin = levelBegin + job * kTransformsPerJob;
+				const U32 end = min(levelEnd, begin + kTransformsPerJob);
+				updateRange(begin, end, newFrame);
+			}
+		};
+
+		// The calling thread takes jobs as well
+		const U32 taskCount = min(jobCount, CoreThreadJobManager::getSingleton().getThreadCount()) - 1;
+		Atomic<U32> runningTaskCount = {taskCount};
+		for(U32 i = 0; i < taskCount; ++i)
+		{
+			CoreThreadJobManager::getSingleton().dispatchTask([&]([[maybe_unused]] U32 tid) {
+				updateJobs();
+				runningTaskCount.fetchSub(1);
+			});
+		}
+
+		updateJobs();
+
+		// Wait only for the tasks of this level. Others might be using the job manager at the same time
+		while(runningTaskCount.load() != 0)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void TransformHierarchy::updateRange(U32 begin, U32 end, Bool newFrame)
+{
+	for(U32 i = begin; i < end; ++i)
+	{
+		const U32 word = i / kBitsPerWord;
+		const U64 bit = U64(1) << (i % kBitsPerWord);
+
+		const U32 parent = m_parents[i];
+		// In the later updates of a frame it's also true for the parents that moved in the earlier ones. Computing the children again is harmless
+		const Bool parentUpdated = parent != kInvalidIndex && updatedThisFrame(parent);
+
+		// Nothing else is touching the bitsets at this point so non-atomic access is fine
+		const U64 localDirtyWord = m_localDirty[word].getNonAtomically();
+		const Bool needsUpdate = (localDirtyWord & bit) || parentUpdated;
+		const Bool updatedLastFrame = !!(m_updatedThisFrame[word] & bit);
+
+		if(newFrame && (needsUpdate || updatedLastFrame))
+		{
+			m_prevWorldTransforms[i] = m_worldTransforms[i];
+		}
+
+		if(needsUpdate)
+		{
+			m_worldTransforms[i] =
+				(parent == kInvalidIndex) ? m_localTransforms[i] : m_worldTransforms[parent].combineTransformations(m_localTransforms[i]);
+
+			m_localDirty[word].setNonAtomically(localDirtyWord & ~bit);
+			m_updatedThisFrame[word] |= bit;
+		}
+		else if(newFrame)
+		{
+			m_updatedThisFrame[word] &= ~bit;
+		}
+	}
+}
+
+} // end namespace anki
@@ -0,0 +1,145 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Scene/Common.h>
+#include <AnKi/Math.h>
+#include <AnKi/Util/DynamicArray.h>
+#include <AnKi/Util/Atomic.h>
+#include <AnKi/Util/Thread.h>
+
+namespace anki {
+
+/// @addtogroup scene
+/// @{
+
+/// Holds the local, world and previous world transforms of all scene nodes in contiguous arrays. The arrays are sorted by the depth of the
+/// nodes in the hierarchy so the world transforms can be propagated one level at a time, in parallel and without chasing pointers.
+/// Every level has some free slots. New nodes and nodes without children that move to another level take one of them so most hierarchy changes
+/// don't have to sort the arrays again.
+class TransformHierarchy : public MakeSingleton<TransformHierarchy>
+{
+	template<typename>
+	friend class MakeSingleton;
+
+	friend class SceneNode;
+
+public:
+	/// Compute the world transforms of all the nodes that moved (or their parents moved). Levels that are big enough are split into jobs.
+	/// @param newFrame If true the world transforms of the last frame become the previous world transforms. Pass false to propagate the changes
+	///                 made after an earlier update() of the same frame. Those keep the previous world transforms as they were.
+	/// @note Not thread-safe. Should be called when nothing else is touching the transforms.
+	void update(Bool newFrame = true);
+
+	/// Number of the transforms (including some free slots).
+	U32 getTransformCount() const
+	{
+		return m_nodes.getSize();
+	}
+
+	U32 getHierarchyLevelCount() const
+	{
+		return (m_levelOffsets.getSize()) ? m_levelOffsets.getSize() - 1 : 0;
+	}
+
+	/// Number of times the arrays were sorted from scratch. For testing.
+	U32 getSortCount() const
+	{
+		return m_sortCount;
+	}
+
+private:
+	static constexpr U32 kBitsPerWord = 64;
+	static constexpr U32 kTransformsPerJob = 16 * kBitsPerWord; ///< Keep it a multiple of kBitsPerWord.
+	static constexpr U32 kInvalidIndex = kMaxU32;
+
+	SceneDynamicArray<Transform> m_localTransforms;
+	SceneDynamicArray<Transform> m_worldTransforms;
+	SceneDynamicArray<Transform> m_prevWorldTransforms;
+	SceneDynamicArray<U32> m_parents; ///< The index of the parent's transform or kInvalidIndex.
+	SceneDynamicArray<SceneNode*> m_nodes; ///< The owner of each transform. nullptr if the slot is free.
+
+	/// Bitset. The local transform changed. It's set by the nodes from any thread.
+	SceneDynamicArray<Atomic<U64>> m_localDirty;
+	/// Bitset. The world transform changed in the last update().
+	SceneDynamicArray<U64> m_updatedThisFrame;
+
+	/// The transforms of level N are in [m_levelOffsets[N], m_levelOffsets[N + 1]). The transforms past the levels are new ones that wait for
+	/// the next update() to find their level.
+	SceneDynamicArray<U32> m_levelOffsets;
+	SceneDynamicArray<SceneDynamicArray<U32>> m_levelFreeSlots;
+	U32 m_freeSlotCount = 0; ///< The free slots in all levels.
+	U32 m_unplacedCount = 0; ///< The transforms past the levels.
+
+	/// The transforms whose node changed parent. They find their level in the next update().
+	SceneDynamicArray<U32> m_hierarchyChanges;
+	SpinLock m_hierarchyChangesLock;
+
+	/// The levels need to be built from scratch.
+	Bool m_hierarchyDirty = false;
+
+	U32 m_sortCount = 0;
+
+	TransformHierarchy() = default;
+
+	~TransformHierarchy();
+
+	/// @note Not thread-safe, same as creating scene nodes.
+	U32 newTransform(SceneNode* node);
+
+	/// @note Not thread-safe, same as deleting scene nodes.
+	void deleteTransform(U32 idx);
+
+	/// The node of the transform changed parent.
+	/// @note It's thread-safe.
+	void markHierarchyChanged(U32 idx)
+	{
+		LockGuard lock(m_hierarchyChangesLock);
+		m_hierarchyChanges.emplaceBack(idx);
+	}
+
+	/// @note It's thread-safe.
+	void markLocalDirty(U32 idx)
+	{
+		m_localDirty[idx / kBitsPerWord].fetchOr(U64(1) << (idx % kBitsPerWord));
+	}
+
+	Bool updatedThisFrame(U32 idx) const
+	{
+		return !!(m_updatedThisFrame[idx / kBitsPerWord] & (U64(1) << (idx % kBitsPerWord)));
+	}
+
+	/// Sort the transforms based on their hierarchy depth. It removes the free slots and leaves a few new ones in each level.
+	void sort();
+
+	/// Move the transforms that changed parent to their new level.
+	/// @return False if some of them need a sort().
+	Bool placeChangedTransforms();
+
+	/// @return False if the transform needs a sort().
+	Bool placeTransform(U32 idx);
+
+	/// @return The level of the transform or kInvalidIndex if it's past the levels.
+	U32 getLevel(U32 idx) const;
+
+	/// Get a free slot of a level. Only the last level and a new level after it can grow.
+	/// @return The slot or kInvalidIndex if there is no space.
+	U32 allocateSlot(U32 level);
+
+	/// Set the size of the arrays. The new slots are free.
+	void resizeArrays(U32 transformCount);
+
+	/// Clear a slot and give it back to its level.
+	void freeSlot(U32 idx);
+
+	/// Grow the bitsets to be able to hold the transforms.
+	void resizeBitsets(U32 transformCount);
+
+	void updateRange(U32 begin, U32 end, Bool newFrame);
+};
+/// @}
+
+} // end namespace anki
@@ -6,9 +6,13 @@
 #include <AnKi/Script/LuaBinder.h>
 #include <AnKi/Util/Logger.h>
 #include <AnKi/Util/Tracer.h>
+#include <AnKi/Core/StatsSet.h>
 
 namespace anki {
 
+static ThreadedStatCounter g_luaMemoryStatVar(StatCategory::kCpuMem, "Lua", StatFlag::kBytes);
+static StatCounter g_luaStateCountStatVar(StatCategory::kMisc, "Lua states", StatFlag::kNone);
+
 // Forward
 #define ANKI_SCRIPT_CALL_WRAP(x_) void wrapModule##x_(lua_State*)
 ANKI_SCRIPT_CALL_WRAP(Logger);
@@ -36,6 +40,7 @@ static int luaPanic(lua_State* l)
 LuaBinder::LuaBinder()
 {
 	m_l = lua_newstate(luaAllocCallback, this);
+	g_luaStateCountStatVar.increment(1);
 	luaL_openlibs(m_l);
 	lua_atpanic(m_l, &luaPanic);
 
@@ -47,65 +52,233 @@ LuaBinder::~LuaBinder()
 	if(m_l)
 	{
 		lua_close(m_l);
+		g_luaStateCountStatVar.decrement(1);
 	}
 }
 
-void* LuaBinder::luaAllocCallback([[maybe_unused]] void* userData, void* ptr, PtrSize osize, PtrSize nsize)
+void* LuaBinder::luaAllocCallback(void* userData, void* ptr, PtrSize osize, PtrSize nsize)
 {
 	ANKI_ASSERT(userData);
+	return static_cast<LuaBinder*>(userData)->m_allocator.reallocate(ptr, osize, nsize);
+}
+
+LuaBinder::Allocator::~Allocator()
+{
+	ANKI_ASSERT(m_stats.m_allocationCount == 0 && "LUA should have freed everything");
+
+	// Release all the chunks at once
+	PtrSize releasedMemory = 0;
+	void* chunk = m_chunks;
+	while(chunk)
+	{
+		void* next = *static_cast<void**>(chunk);
+		ScriptMemoryPool::getSingleton().free(chunk);
+		releasedMemory += kChunkSize;
+		chunk = next;
+	}
+
+	m_stats.m_reservedMemory -= releasedMemory;
+	g_luaMemoryStatVar.decrement(releasedMemory);
+}
 
-#if 1
-	void* out = nullptr;
+void* LuaBinder::Allocator::reallocate(void* ptr, PtrSize osize, PtrSize nsize)
+{
+	// When ptr is null osize encodes the type of the object, ignore it
+	const U32 oldSizeClass = (ptr) ? computeSizeClass(osize) : kLargeSizeClass;
 
 	if(nsize == 0)
 	{
-		if(ptr != nullptr)
+		if(ptr)
 		{
-			ScriptMemoryPool::getSingleton().free(ptr);
+			free(ptr, osize, oldSizeClass);
 		}
+		return nullptr;
+	}
+
+	const U32 newSizeClass = computeSizeClass(nsize);
+
+	if(ptr == nullptr)
+	{
+		return allocate(nsize, newSizeClass);
+	}
+
+	if(oldSizeClass == newSizeClass && newSizeClass != kLargeSizeClass)
+	{
+		// Fits in the same block
+		m_stats.m_usedMemory = m_stats.m_usedMemory - osize + nsize;
+		return ptr;
+	}
+
+	void* out = allocate(nsize, newSizeClass);
+	if(out)
+	{
+		memcpy(out, ptr, min(osize, nsize));
+		free(ptr, osize, oldSizeClass);
+	}
+
+	return out;
+}
+
+void* LuaBinder::Allocator::allocate(PtrSize size, U32 sizeClass)
+{
+	void* out;
+
+	if(sizeClass == kLargeSizeClass)
+	{
+		out = ScriptMemoryPool::getSingleton().allocate(size, kSizeClassGranularity);
+		m_stats.m_reservedMemory += size;
+		g_luaMemoryStatVar.increment(size);
+	}
+	else if(m_freeLists[sizeClass])
+	{
+		// Pop from the free list
+		out = m_freeLists[sizeClass];
+		m_freeLists[sizeClass] = *static_cast<void**>(out);
 	}
 	else
 	{
-		// Should be doing something like realloc
+		const PtrSize blockSize = PtrSize(sizeClass + 1) * kSizeClassGranularity;
 
-		if(ptr == nullptr)
+		if(m_chunkTop + blockSize > m_chunkEnd)
 		{
-			out = ScriptMemoryPool::getSingleton().allocate(nsize, 16);
+			// Need a new chunk. The remaining of the old one is wasted but it's less than kMaxSmallAllocationSize
+			void* chunk = ScriptMemoryPool::getSingleton().allocate(kChunkSize, kSizeClassGranularity);
+			*static_cast<void**>(chunk) = m_chunks;
+			m_chunks = chunk;
+
+			m_chunkTop = static_cast<U8*>(chunk) + kChunkHeaderSize;
+			m_chunkEnd = static_cast<U8*>(chunk) + kChunkSize;
+
+			m_stats.m_reservedMemory += kChunkSize;
+			g_luaMemoryStatVar.increment(kChunkSize);
 		}
-		else if(nsize <= osize)
+
+		out = m_chunkTop;
+		m_chunkTop += blockSize;
+	}
+
+	m_stats.m_usedMemory += size;
+	++m_stats.m_allocationCount;
+	return out;
+}
+
+void LuaBinder::Allocator::free(void* ptr, PtrSize size, U32 sizeClass)
+{
+	ANKI_ASSERT(ptr);
+	ANKI_ASSERT(m_stats.m_allocationCount > 0 && m_stats.m_usedMemory >= size);
+
+	if(sizeClass == kLargeSizeClass)
+	{
+		ScriptMemoryPool::getSingleton().free(ptr);
+		m_stats.m_reservedMemory -= size;
+		g_luaMemoryStatVar.decrement(size);
+	}
+	else
+	{
+		// Push to the free list
+		*static_cast<void**>(ptr) = m_freeLists[sizeClass];
+		m_freeLists[sizeClass] = ptr;
+	}
+
+	m_stats.m_usedMemory -= size;
+	--m_stats.m_allocationCount;
+}
+
+Error LuaBinder::evalString(lua_State* state, const CString& str)
+{
+	ANKI_TRACE_SCOPED_EVENT(LuaExec);
+
+	Error err = Error::kNone;
+	int e = luaL_dostring(state, &str[0]);
+	if(e)
+	{
+		ANKI_SCRIPT_LOGE("%s", lua_tostring(state, -1));
+		lua_pop(state, 1);
+		err = Error::kUserData;
+	}
+
+	garbageCollect(state);
+	return err;
+}
+
+LuaUserData* LuaBinder::pushNewGarbageCollectedUserData(lua_State* l, const LuaUserDataTypeInfo& typeInfo)
+{
+	LuaUserData* ud = nullptr;
+
+	if(typeInfo.m_recyclable)
+	{
+		// Try to pop one from the free list. The free list is a table in the registry
+		lua_rawgetp(l, LUA_REGISTRYINDEX, &typeInfo); // push
+		const I32 count = lua_istable(l, -1) ? I32(lua_rawlen(l, -1)) : 0;
+		if(count > 0)
 		{
-			out = ptr;
+			lua_rawgeti(l, -1, count); // push
+			lua_pushnil(l); // push
+			lua_rawseti(l, -3, count); // pop
+			lua_remove(l, -2); // Remove the free list
+
+			ud = static_cast<LuaUserData*>(lua_touserdata(l, -1));
+			ANKI_ASSERT(ud && ud->getSig() == typeInfo.m_signature && ud->isGarbageCollected());
 		}
 		else
 		{
-			// realloc
-
-			out = ScriptMemoryPool::getSingleton().allocate(nsize, 16);
-			memcpy(out, ptr, osize);
-			ScriptMemoryPool::getSingleton().free(ptr);
+			lua_pop(l, 1);
 		}
 	}
-#else
-	void* out = nullptr;
-	if(nsize == 0)
+
+	if(ud == nullptr)
 	{
-		free(ptr);
+		ud = static_cast<LuaUserData*>(lua_newuserdata(l, typeInfo.m_structureSize));
 	}
-	else
+
+	// Setting the metatable also re-arms the finalizer of recycled user data
+	luaL_setmetatable(l, typeInfo.m_typeName);
+	ud->initGarbageCollected(&typeInfo);
+
+	return ud;
+}
+
+void LuaBinder::recycleGarbageCollectedUserData(lua_State* l, I32 stackIdx)
+{
+	LuaUserData* ud = static_cast<LuaUserData*>(lua_touserdata(l, stackIdx));
+	ANKI_ASSERT(ud && ud->isGarbageCollected());
+
+	const LuaUserDataTypeInfo& typeInfo = ud->getDataTypeInfo();
+	if(!typeInfo.m_recyclable)
 	{
-		out = realloc(ptr, nsize);
+		return;
 	}
-#endif
 
-	return out;
+	stackIdx = lua_absindex(l, stackIdx);
+
+	lua_rawgetp(l, LUA_REGISTRYINDEX, &typeInfo); // push
+	if(!lua_istable(l, -1))
+	{
+		lua_pop(l, 1);
+		lua_createtable(l, kMaxRecycledUserDataPerType, 0); // push
+		lua_pushvalue(l, -1); // push
+		lua_rawsetp(l, LUA_REGISTRYINDEX, &typeInfo); // pop
+	}
+
+	// Resurrect the user data by storing it to the free list
+	const I32 count = I32(lua_rawlen(l, -1));
+	if(count < kMaxRecycledUserDataPerType)
+	{
+		lua_pushvalue(l, stackIdx); // push
+		lua_rawseti(l, -2, count + 1); // pop
+	}
+
+	lua_pop(l, 1);
 }
 
-Error LuaBinder::evalString(lua_State* state, const CString& str)
+Error LuaBinder::evalBytecode(lua_State* state, ConstWeakArray<U8> bytecode, const CString& chunkName)
 {
 	ANKI_TRACE_SCOPED_EVENT(LuaExec);
+	ANKI_ASSERT(bytecode.getSize() > 0);
 
 	Error err = Error::kNone;
-	int e = luaL_dostring(state, &str[0]);
+	const int e = luaL_loadbufferx(state, reinterpret_cast<const char*>(&bytecode[0]), bytecode.getSize(), chunkName.cstr(), "b")
+				  || lua_pcall(state, 0, LUA_MULTRET, 0);
 	if(e)
 	{
 		ANKI_SCRIPT_LOGE("%s", lua_tostring(state, -1));
@@ -11,6 +11,9 @@
 #include <AnKi/Util/String.h>
 #include <AnKi/Util/Functions.h>
 #include <AnKi/Util/HashMap.h>
+#include <AnKi/Util/DynamicArray.h>
+#include <AnKi/Util/WeakArray.h>
+#include <AnKi/Util/Array.h>
 #include <Lua/lua.hpp>
 #ifndef ANKI_LUA_HPP
 #	error "Wrong LUA header included"
@@ -39,6 +42,7 @@ public:
 	PtrSize m_structureSize;
 	LuaUserDataSerializeCallback m_serializeCallback;
 	LuaUserDataDeserializeCallback m_deserializeCallback;
+	Bool m_recyclable = false; ///< Recycle the garbage collected user data. Used for types that are often temporaries.
 };
 
 /// LUA userdata.
@@ -135,6 +139,15 @@ public:
 	virtual void write(const void* data, PtrSize dataSize) = 0;
 };
 
+/// Memory statistics of a single lua_State.
+class LuaMemoryStats
+{
+public:
+	PtrSize m_usedMemory = 0; ///< Memory LUA thinks it has allocated.
+	PtrSize m_reservedMemory = 0; ///< Memory requested from the ScriptMemoryPool.
+	U32 m_allocationCount = 0; ///< Live allocations.
+};
+
 /// Lua binder class. A wrapper on top of LUA
 class LuaBinder
 {
@@ -153,6 +166,11 @@ public:
 		return m_l;
 	}
 
+	const LuaMemoryStats& getMemoryStats() const
+	{
+		return m_allocator.m_stats;
+	}
+
 	/// Expose a variable to the lua state
 	template<typename T>
 	static void exposeVariable(lua_State* state, CString name, T* y)
@@ -173,9 +191,20 @@ public:
 		luaL_setmetatable(state, LuaUserData::getDataTypeInfoFor<T>().m_typeName);
 	}
 
+	/// Push a new garbage collected user data to the stack. If the type is recyclable it will try to reuse a user data that was garbage
+	/// collected before instead of allocating a new one. The caller should construct the object.
+	static LuaUserData* pushNewGarbageCollectedUserData(lua_State* l, const LuaUserDataTypeInfo& typeInfo);
+
+	/// Called by the __gc of a garbage collected user data after its object has been destroyed. If the type is recyclable it keeps the
+	/// user data alive in a per lua_State free list.
+	static void recycleGarbageCollectedUserData(lua_State* l, I32 stackIdx);
+
 	/// Evaluate a string
 	static Error evalString(lua_State* state, const CString& str);
 
+	/// Evaluate the bytecode of a ScriptResource.
+	static Error evalBytecode(lua_State* state, ConstWeakArray<U8> bytecode, const CString& chunkName);
+
 	static void garbageCollect(lua_State* state)
 	{
 		lua_gc(state, LUA_GCCOLLECT, 0);
@@ -227,6 +256,48 @@ public:
 	static Error checkUserData(lua_State* l, I32 stackIdx, const LuaUserDataTypeInfo& typeInfo, LuaUserData*& out);
 
 private:
+	/// A size-class allocator for a single lua_State. LUA does a huge number of tiny allocations (strings, tables, closures) so small blocks
+	/// are carved out of big chunks and recycled using per size class free lists. The chunks are released all at once when the state dies.
+	class Allocator
+	{
+	public:
+		static constexpr U32 kSizeClassGranularity = 16;
+		static constexpr U32 kMaxSmallAllocationSize = 512;
+		static constexpr U32 kSizeClassCount = kMaxSmallAllocationSize / kSizeClassGranularity;
+		static constexpr U32 kLargeSizeClass = kMaxU32;
+		static constexpr PtrSize kChunkSize = 32_KB;
+		static constexpr PtrSize kChunkHeaderSize = kSizeClassGranularity;
+
+		Array<void*, kSizeClassCount> m_freeLists = {};
+		void* m_chunks = nullptr; ///< Singly linked list of chunks. The 1st word of a chunk points to the next.
+		U8* m_chunkTop = nullptr; ///< The unused part of the last chunk.
+		U8* m_chunkEnd = nullptr;
+		LuaMemoryStats m_stats;
+
+		Allocator() = default;
+
+		Allocator(const Allocator&) = delete; // Non-copyable
+
+		~Allocator();
+
+		Allocator& operator=(const Allocator&) = delete; // Non-copyable
+
+		void* reallocate(void* ptr, PtrSize osize, PtrSize nsize);
+
+		static U32 computeSizeClass(PtrSize size)
+		{
+			ANKI_ASSERT(size > 0);
+			return (size <= kMaxSmallAllocationSize) ? U32((size - 1) / kSizeClassGranularity) : kLargeSizeClass;
+		}
+
+	private:
+		void* allocate(PtrSize size, U32 sizeClass);
+		void free(void* ptr, PtrSize size, U32 sizeClass);
+	};
+
+	static constexpr I32 kMaxRecycledUserDataPerType = 256;
+
+	Allocator m_allocator;
 	lua_State* m_l = nullptr;
 	ScriptHashMap<I64, const LuaUserDataTypeInfo*> m_userDataSigToDataInfo;
 
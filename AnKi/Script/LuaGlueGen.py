@@ -161,14 +161,8 @@ def ret(ret_el):
             elif is_ref:
                 wglue("ud->initPointed(&luaUserDataTypeInfo%s, &ret);" % type)
         else:
-            wglue("size = LuaUserData::computeSizeForGarbageCollected<%s>();" % type)
-            wglue("voidp = lua_newuserdata(l, size);")
-            wglue("luaL_setmetatable(l, \"%s\");" % type)
-
-            wglue("ud = static_cast<LuaUserData*>(voidp);")
             wglue("extern LuaUserDataTypeInfo luaUserDataTypeInfo%s;" % type)
-            wglue("ud->initGarbageCollected(&luaUserDataTypeInfo%s);" % type)
-
+            wglue("ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfo%s);" % type)
             wglue("::new(ud->getData<%s>()) %s(std::move(ret));" % (type, type))
 
     wglue("")
@@ -279,9 +273,25 @@ def check_args(args_el, bias):
     wglue("")
 
 
-def get_meth_alias(meth_el):
+def get_meth_variant_base_name(meth_el):
+    """ Return a name for a method that can be used to derive the names of its variants """
+
+    meth_name = meth_el.get("name")
+    names = {"operator+": "add", "operator-": "sub", "operator*": "mul", "operator/": "div"}
+    if meth_name in names and meth_el.get("alias") is None:
+        return names[meth_name]
+
+    return get_meth_alias(meth_el)
+
+
+def get_meth_alias(meth_el, variant=None):
     """ Return the method alias """
 
+    if variant == "assign":
+        return get_meth_variant_base_name(meth_el) + "Assign"
+    elif variant == "out":
+        return get_meth_variant_base_name(meth_el) + "To"
+
     meth_name = meth_el.get("name")
 
     if meth_name == "operator+":
@@ -321,19 +331,49 @@ def write_local_vars():
     wglue("")
 
 
-def method(class_name, meth_el):
+def class_is_recyclable(class_el):
+    """ Classes that are used as temporaries (eg math types). Their garbage collected user data are recycled and their methods get
+    allocation-free variants """
+    return class_el.get("recycle") is not None and class_el.get("recycle") == "true"
+
+
+def method_variants(class_name, meth_el):
+    """ Return the allocation-free variants of a method. The "assign" variant writes the result to self (a:addAssign(b)) and the "out"
+    variant writes to an extra argument (a:addTo(b, out)) """
+
+    ret_el = meth_el.find("return")
+    if ret_el is None or meth_el.find("overrideCall") is not None:
+        return []
+
+    (type, is_ref, is_ptr, is_const) = parse_type_decl(ret_el.text)
+    if is_ref or is_ptr or type_is_bool(type) or type_is_number(type) or type_is_enum(type) or type == "CString" or type == "Error":
+        return []
+
+    variants = []
+    if type == class_name and get_meth_variant_base_name(meth_el) in ["add", "sub", "mul", "div"]:
+        variants.append("assign")
+    variants.append("out")
+    return variants
+
+
+def method(class_name, meth_el, variant=None):
     """ Handle a method """
 
     meth_name = meth_el.get("name")
-    meth_alias = get_meth_alias(meth_el)
+    meth_alias = get_meth_alias(meth_el, variant)
 
-    wglue("/// Pre-wrap method %s::%s." % (class_name, meth_name))
+    if variant is None:
+        wglue("/// Pre-wrap method %s::%s." % (class_name, meth_name))
+    elif variant == "assign":
+        wglue("/// Pre-wrap method %s::%s that writes the result to self." % (class_name, meth_name))
+    else:
+        wglue("/// Pre-wrap method %s::%s that writes the result to the last argument." % (class_name, meth_name))
     wglue("static inline int pwrap%s%s(lua_State* l)" % (class_name, meth_alias))
     wglue("{")
     ident(1)
     write_local_vars()
 
-    check_args(meth_el.find("args"), 1)
+    check_args(meth_el.find("args"), 2 if variant == "out" else 1)
 
     # Get this pointer
     wglue("// Get \"this\" as \"self\"")
@@ -355,6 +395,21 @@ def method(class_name, meth_el):
     if ret_el is not None:
         ret_txt = ret_el.text
 
+    # The output argument
+    if variant == "out":
+        out_stack_index = 2 + count_args(meth_el.find("args"))
+        wglue("// Get the output argument")
+        wglue("extern LuaUserDataTypeInfo luaUserDataTypeInfo%s;" % ret_txt)
+        wglue("if(LuaBinder::checkUserData(l, %d, luaUserDataTypeInfo%s, ud)) [[unlikely]]" % (out_stack_index, ret_txt))
+        wglue("{")
+        ident(1)
+        wglue("return -1;")
+        ident(-1)
+        wglue("}")
+        wglue("")
+        wglue("%s* out = ud->getData<%s>();" % (ret_txt, ret_txt))
+        wglue("")
+
     # Method call
     wglue("// Call the method")
     call = meth_el.find("overrideCall")
@@ -366,11 +421,24 @@ def method(class_name, meth_el):
     else:
         if ret_txt is None:
             wglue("self->%s(%s);" % (meth_name, args_str))
+        elif variant == "assign":
+            wglue("*self = self->%s(%s);" % (meth_name, args_str))
+        elif variant == "out":
+            wglue("*out = self->%s(%s);" % (meth_name, args_str))
         else:
             wglue("%s ret = self->%s(%s);" % (ret_txt, meth_name, args_str))
 
     wglue("")
-    ret(ret_el)
+    if variant == "assign":
+        wglue("// Push self, no allocation")
+        wglue("lua_pushvalue(l, 1);")
+        wglue("return 1;")
+    elif variant == "out":
+        wglue("// Push the output argument, no allocation")
+        wglue("lua_pushvalue(l, %d);" % out_stack_index)
+        wglue("return 1;")
+    else:
+        ret(ret_el)
 
     ident(-1)
     wglue("}")
@@ -470,12 +538,7 @@ def constructor(constr_el, class_name, constructor_idx):
     # Create new userdata
     wglue("// Create user data")
 
-    wglue("size = LuaUserData::computeSizeForGarbageCollected<%s>();" % class_name)
-    wglue("voidp = lua_newuserdata(l, size);")
-    wglue("luaL_setmetatable(l, luaUserDataTypeInfo%s.m_typeName);" % class_name)
-    wglue("ud = static_cast<LuaUserData*>(voidp);")
-    wglue("extern LuaUserDataTypeInfo luaUserDataTypeInfo%s;" % class_name)
-    wglue("ud->initGarbageCollected(&luaUserDataTypeInfo%s);" % class_name)
+    wglue("ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfo%s);" % class_name)
     wglue("::new(ud->getData<%s>()) %s(%s);" % (class_name, class_name, args_str))
     wglue("")
 
@@ -571,6 +634,7 @@ def destructor(class_name):
     ident(1)
     wglue("%s* inst = ud->getData<%s>();" % (class_name, class_name))
     wglue("inst->~%s();" % class_name)
+    wglue("LuaBinder::recycleGarbageCollectedUserData(l, 1);")
     ident(-1)
     wglue("}")
     wglue("")
@@ -620,10 +684,15 @@ def class_(class_el):
         deserialize_cb_name = "nullptr"
 
     # Write the type info
+    recycle = class_is_recyclable(class_el)
     wglue("LuaUserDataTypeInfo luaUserDataTypeInfo%s = {" % class_name)
     ident(1)
-    wglue("%d, \"%s\", LuaUserData::computeSizeForGarbageCollected<%s>(), %s, %s" %
-          (type_sig(class_name), class_name, class_name, serialize_cb_name, deserialize_cb_name))
+    if recycle:
+        wglue("%d, \"%s\", LuaUserData::computeSizeForGarbageCollected<%s>(), %s, %s, true" %
+              (type_sig(class_name), class_name, class_name, serialize_cb_name, deserialize_cb_name))
+    else:
+        wglue("%d, \"%s\", LuaUserData::computeSizeForGarbageCollected<%s>(), %s, %s" %
+              (type_sig(class_name), class_name, class_name, serialize_cb_name, deserialize_cb_name))
     ident(-1)
     wglue("};")
     wglue("")
@@ -666,6 +735,12 @@ def class_(class_el):
             meth_alias = get_meth_alias(meth_el)
             meth_names_aliases.append([meth_name, meth_alias, is_static])
 
+            # Allocation-free variants for the temporaries
+            if recycle and not is_static:
+                for variant in method_variants(class_name, meth_el):
+                    method(class_name, meth_el, variant)
+                    meth_names_aliases.append([meth_name, get_meth_alias(meth_el, variant), is_static])
+
     # Start class declaration
     wglue("/// Wrap class %s." % class_name)
     wglue("static inline void wrap%s(lua_State* l)" % class_name)
@@ -26,8 +26,8 @@ static void deserializeVec2(const void* data, LuaUserData& self)
 	obj->deserialize(data);
 }
 
-LuaUserDataTypeInfo luaUserDataTypeInfoVec2 = {594303304060146034, "Vec2", LuaUserData::computeSizeForGarbageCollected<Vec2>(), serializeVec2,
-											   deserializeVec2};
+LuaUserDataTypeInfo luaUserDataTypeInfoVec2 = {594303304060146034, "Vec2",          LuaUserData::computeSizeForGarbageCollected<Vec2>(),
+											   serializeVec2,      deserializeVec2, true};
 
 template<>
 const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<Vec2>()
@@ -48,12 +48,7 @@ static inline int pwrapVec2Ctor0(lua_State* l)
 	}
 
 	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Vec2>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoVec2.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec2);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec2);
 	::new(ud->getData<Vec2>()) Vec2();
 
 	return 1;
@@ -85,12 +80,7 @@ static inline int pwrapVec2Ctor1(lua_State* l)
 	}
 
 	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Vec2>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoVec2.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec2);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec2);
 	::new(ud->getData<Vec2>()) Vec2(arg0, arg1);
 
 	return 1;
@@ -145,6 +135,7 @@ static int wrapVec2Dtor(lua_State* l)
 	{
 		Vec2* inst = ud->getData<Vec2>();
 		inst->~Vec2();
+		LuaBinder::recycleGarbageCollectedUserData(l, 1);
 	}
 
 	return 0;
@@ -562,12 +553,8 @@ static inline int pwrapVec2__add(lua_State* l)
 	Vec2 ret = self->operator+(arg0);
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec2>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec2");
-	ud = static_cast<LuaUserData*>(voidp);
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec2);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec2);
 	::new(ud->getData<Vec2>()) Vec2(std::move(ret));
 
 	return 1;
@@ -586,8 +573,8 @@ static int wrapVec2__add(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::operator-.
-static inline int pwrapVec2__sub(lua_State* l)
+/// Pre-wrap method Vec2::operator+ that writes the result to self.
+static inline int pwrapVec2addAssign(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -617,24 +604,17 @@ static inline int pwrapVec2__sub(lua_State* l)
 	const Vec2& arg0(*iarg0);
 
 	// Call the method
-	Vec2 ret = self->operator-(arg0);
-
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec2>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec2");
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec2);
-	::new(ud->getData<Vec2>()) Vec2(std::move(ret));
+	*self = self->operator+(arg0);
 
+	// Push self, no allocation
+	lua_pushvalue(l, 1);
 	return 1;
 }
 
-/// Wrap method Vec2::operator-.
-static int wrapVec2__sub(lua_State* l)
+/// Wrap method Vec2::operator+.
+static int wrapVec2addAssign(lua_State* l)
 {
-	int res = pwrapVec2__sub(l);
+	int res = pwrapVec2addAssign(l);
 	if(res >= 0)
 	{
 		return res;
@@ -644,14 +624,14 @@ static int wrapVec2__sub(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::operator*.
-static inline int pwrapVec2__mul(lua_State* l)
+/// Pre-wrap method Vec2::operator+ that writes the result to the last argument.
+static inline int pwrapVec2addTo(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -674,25 +654,27 @@ static inline int pwrapVec2__mul(lua_State* l)
 	Vec2* iarg0 = ud->getData<Vec2>();
 	const Vec2& arg0(*iarg0);
 
-	// Call the method
-	Vec2 ret = self->operator*(arg0);
-
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec2>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec2");
-	ud = static_cast<LuaUserData*>(voidp);
+	// Get the output argument
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec2);
-	::new(ud->getData<Vec2>()) Vec2(std::move(ret));
+	if(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec2, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec2* out = ud->getData<Vec2>();
+
+	// Call the method
+	*out = self->operator+(arg0);
 
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 3);
 	return 1;
 }
 
-/// Wrap method Vec2::operator*.
-static int wrapVec2__mul(lua_State* l)
+/// Wrap method Vec2::operator+.
+static int wrapVec2addTo(lua_State* l)
 {
-	int res = pwrapVec2__mul(l);
+	int res = pwrapVec2addTo(l);
 	if(res >= 0)
 	{
 		return res;
@@ -702,8 +684,8 @@ static int wrapVec2__mul(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::operator/.
-static inline int pwrapVec2__div(lua_State* l)
+/// Pre-wrap method Vec2::operator-.
+static inline int pwrapVec2__sub(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -733,24 +715,20 @@ static inline int pwrapVec2__div(lua_State* l)
 	const Vec2& arg0(*iarg0);
 
 	// Call the method
-	Vec2 ret = self->operator/(arg0);
+	Vec2 ret = self->operator-(arg0);
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec2>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec2");
-	ud = static_cast<LuaUserData*>(voidp);
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec2);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec2);
 	::new(ud->getData<Vec2>()) Vec2(std::move(ret));
 
 	return 1;
 }
 
-/// Wrap method Vec2::operator/.
-static int wrapVec2__div(lua_State* l)
+/// Wrap method Vec2::operator-.
+static int wrapVec2__sub(lua_State* l)
 {
-	int res = pwrapVec2__div(l);
+	int res = pwrapVec2__sub(l);
 	if(res >= 0)
 	{
 		return res;
@@ -760,8 +738,8 @@ static int wrapVec2__div(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::operator==.
-static inline int pwrapVec2__eq(lua_State* l)
+/// Pre-wrap method Vec2::operator- that writes the result to self.
+static inline int pwrapVec2subAssign(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -791,18 +769,17 @@ static inline int pwrapVec2__eq(lua_State* l)
 	const Vec2& arg0(*iarg0);
 
 	// Call the method
-	Bool ret = self->operator==(arg0);
-
-	// Push return value
-	lua_pushboolean(l, ret);
+	*self = self->operator-(arg0);
 
+	// Push self, no allocation
+	lua_pushvalue(l, 1);
 	return 1;
 }
 
-/// Wrap method Vec2::operator==.
-static int wrapVec2__eq(lua_State* l)
+/// Wrap method Vec2::operator-.
+static int wrapVec2subAssign(lua_State* l)
 {
-	int res = pwrapVec2__eq(l);
+	int res = pwrapVec2subAssign(l);
 	if(res >= 0)
 	{
 		return res;
@@ -812,14 +789,14 @@ static int wrapVec2__eq(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::getLength.
-static inline int pwrapVec2getLength(lua_State* l)
+/// Pre-wrap method Vec2::operator- that writes the result to the last argument.
+static inline int pwrapVec2subTo(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -832,19 +809,37 @@ static inline int pwrapVec2getLength(lua_State* l)
 
 	Vec2* self = ud->getData<Vec2>();
 
-	// Call the method
-	F32 ret = self->getLength();
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)) [[unlikely]]
+	{
+		return -1;
+	}
 
-	// Push return value
-	lua_pushnumber(l, lua_Number(ret));
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
+
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec2, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec2* out = ud->getData<Vec2>();
 
+	// Call the method
+	*out = self->operator-(arg0);
+
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 3);
 	return 1;
 }
 
-/// Wrap method Vec2::getLength.
-static int wrapVec2getLength(lua_State* l)
+/// Wrap method Vec2::operator-.
+static int wrapVec2subTo(lua_State* l)
 {
-	int res = pwrapVec2getLength(l);
+	int res = pwrapVec2subTo(l);
 	if(res >= 0)
 	{
 		return res;
@@ -854,14 +849,14 @@ static int wrapVec2getLength(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::getNormalized.
-static inline int pwrapVec2getNormalized(lua_State* l)
+/// Pre-wrap method Vec2::operator*.
+static inline int pwrapVec2__mul(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -874,25 +869,31 @@ static inline int pwrapVec2getNormalized(lua_State* l)
 
 	Vec2* self = ud->getData<Vec2>();
 
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
+
 	// Call the method
-	Vec2 ret = self->getNormalized();
+	Vec2 ret = self->operator*(arg0);
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec2>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec2");
-	ud = static_cast<LuaUserData*>(voidp);
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec2);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec2);
 	::new(ud->getData<Vec2>()) Vec2(std::move(ret));
 
 	return 1;
 }
 
-/// Wrap method Vec2::getNormalized.
-static int wrapVec2getNormalized(lua_State* l)
+/// Wrap method Vec2::operator*.
+static int wrapVec2__mul(lua_State* l)
 {
-	int res = pwrapVec2getNormalized(l);
+	int res = pwrapVec2__mul(l);
 	if(res >= 0)
 	{
 		return res;
@@ -902,14 +903,14 @@ static int wrapVec2getNormalized(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::normalize.
-static inline int pwrapVec2normalize(lua_State* l)
+/// Pre-wrap method Vec2::operator* that writes the result to self.
+static inline int pwrapVec2mulAssign(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -922,16 +923,28 @@ static inline int pwrapVec2normalize(lua_State* l)
 
 	Vec2* self = ud->getData<Vec2>();
 
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
+
 	// Call the method
-	self->normalize();
+	*self = self->operator*(arg0);
 
-	return 0;
+	// Push self, no allocation
+	lua_pushvalue(l, 1);
+	return 1;
 }
 
-/// Wrap method Vec2::normalize.
-static int wrapVec2normalize(lua_State* l)
+/// Wrap method Vec2::operator*.
+static int wrapVec2mulAssign(lua_State* l)
 {
-	int res = pwrapVec2normalize(l);
+	int res = pwrapVec2mulAssign(l);
 	if(res >= 0)
 	{
 		return res;
@@ -941,14 +954,14 @@ static int wrapVec2normalize(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::dot.
-static inline int pwrapVec2dot(lua_State* l)
+/// Pre-wrap method Vec2::operator* that writes the result to the last argument.
+static inline int pwrapVec2mulTo(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -971,19 +984,27 @@ static inline int pwrapVec2dot(lua_State* l)
 	Vec2* iarg0 = ud->getData<Vec2>();
 	const Vec2& arg0(*iarg0);
 
-	// Call the method
-	F32 ret = self->dot(arg0);
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec2, ud)) [[unlikely]]
+	{
+		return -1;
+	}
 
-	// Push return value
-	lua_pushnumber(l, lua_Number(ret));
+	Vec2* out = ud->getData<Vec2>();
+
+	// Call the method
+	*out = self->operator*(arg0);
 
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 3);
 	return 1;
 }
 
-/// Wrap method Vec2::dot.
-static int wrapVec2dot(lua_State* l)
+/// Wrap method Vec2::operator*.
+static int wrapVec2mulTo(lua_State* l)
 {
-	int res = pwrapVec2dot(l);
+	int res = pwrapVec2mulTo(l);
 	if(res >= 0)
 	{
 		return res;
@@ -993,177 +1014,102 @@ static int wrapVec2dot(lua_State* l)
 	return 0;
 }
 
-/// Wrap class Vec2.
-static inline void wrapVec2(lua_State* l)
-{
-	LuaBinder::createClass(l, &luaUserDataTypeInfoVec2);
-	LuaBinder::pushLuaCFuncStaticMethod(l, luaUserDataTypeInfoVec2.m_typeName, "new", wrapVec2Ctor);
-	LuaBinder::pushLuaCFuncMethod(l, "__gc", wrapVec2Dtor);
-	LuaBinder::pushLuaCFuncMethod(l, "getX", wrapVec2getX);
-	LuaBinder::pushLuaCFuncMethod(l, "getY", wrapVec2getY);
-	LuaBinder::pushLuaCFuncMethod(l, "setX", wrapVec2setX);
-	LuaBinder::pushLuaCFuncMethod(l, "setY", wrapVec2setY);
-	LuaBinder::pushLuaCFuncMethod(l, "setAll", wrapVec2setAll);
-	LuaBinder::pushLuaCFuncMethod(l, "getAt", wrapVec2getAt);
-	LuaBinder::pushLuaCFuncMethod(l, "setAt", wrapVec2setAt);
-	LuaBinder::pushLuaCFuncMethod(l, "copy", wrapVec2copy);
-	LuaBinder::pushLuaCFuncMethod(l, "__add", wrapVec2__add);
-	LuaBinder::pushLuaCFuncMethod(l, "__sub", wrapVec2__sub);
-	LuaBinder::pushLuaCFuncMethod(l, "__mul", wrapVec2__mul);
-	LuaBinder::pushLuaCFuncMethod(l, "__div", wrapVec2__div);
-	LuaBinder::pushLuaCFuncMethod(l, "__eq", wrapVec2__eq);
-	LuaBinder::pushLuaCFuncMethod(l, "getLength", wrapVec2getLength);
-	LuaBinder::pushLuaCFuncMethod(l, "getNormalized", wrapVec2getNormalized);
-	LuaBinder::pushLuaCFuncMethod(l, "normalize", wrapVec2normalize);
-	LuaBinder::pushLuaCFuncMethod(l, "dot", wrapVec2dot);
-	lua_settop(l, 0);
-}
-
-/// Serialize Vec3
-static void serializeVec3(LuaUserData& self, void* data, PtrSize& size)
-{
-	Vec3* obj = self.getData<Vec3>();
-	obj->serialize(data, size);
-}
-
-/// De-serialize Vec3
-static void deserializeVec3(const void* data, LuaUserData& self)
-{
-	ANKI_ASSERT(data);
-	Vec3* obj = self.getData<Vec3>();
-	::new(obj) Vec3();
-	obj->deserialize(data);
-}
-
-LuaUserDataTypeInfo luaUserDataTypeInfoVec3 = {5669632566763941038, "Vec3", LuaUserData::computeSizeForGarbageCollected<Vec3>(), serializeVec3,
-											   deserializeVec3};
-
-template<>
-const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<Vec3>()
-{
-	return luaUserDataTypeInfoVec3;
-}
-
-/// Pre-wrap constructor for Vec3.
-static inline int pwrapVec3Ctor0(lua_State* l)
+/// Pre-wrap method Vec2::operator/.
+static inline int pwrapVec2__div(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 0)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoVec3.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3();
-
-	return 1;
-}
-
-/// Pre-wrap constructor for Vec3.
-static inline int pwrapVec3Ctor1(lua_State* l)
-{
-	[[maybe_unused]] LuaUserData* ud;
-	[[maybe_unused]] void* voidp;
-	[[maybe_unused]] PtrSize size;
-
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
+	Vec2* self = ud->getData<Vec2>();
+
 	// Pop arguments
-	F32 arg0;
-	if(LuaBinder::checkNumber(l, 1, arg0)) [[unlikely]]
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoVec3.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3(arg0);
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
+
+	// Call the method
+	Vec2 ret = self->operator/(arg0);
+
+	// Push return value
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec2);
+	::new(ud->getData<Vec2>()) Vec2(std::move(ret));
 
 	return 1;
 }
 
-/// Pre-wrap constructor for Vec3.
-static inline int pwrapVec3Ctor2(lua_State* l)
+/// Wrap method Vec2::operator/.
+static int wrapVec2__div(lua_State* l)
+{
+	int res = pwrapVec2__div(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec2::operator/ that writes the result to self.
+static inline int pwrapVec2divAssign(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	// Pop arguments
-	F32 arg0;
-	if(LuaBinder::checkNumber(l, 1, arg0)) [[unlikely]]
-	{
-		return -1;
-	}
-
-	F32 arg1;
-	if(LuaBinder::checkNumber(l, 2, arg1)) [[unlikely]]
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	F32 arg2;
-	if(LuaBinder::checkNumber(l, 3, arg2)) [[unlikely]]
+	Vec2* self = ud->getData<Vec2>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoVec3.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3(arg0, arg1, arg2);
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
+
+	// Call the method
+	*self = self->operator/(arg0);
 
+	// Push self, no allocation
+	lua_pushvalue(l, 1);
 	return 1;
 }
 
-/// Wrap constructors for Vec3.
-static int wrapVec3Ctor(lua_State* l)
+/// Wrap method Vec2::operator/.
+static int wrapVec2divAssign(lua_State* l)
 {
-	// Chose the right overload
-	const int argCount = lua_gettop(l);
-	int res = 0;
-	switch(argCount)
-	{
-	case 0:
-		res = pwrapVec3Ctor0(l);
-		break;
-	case 1:
-		res = pwrapVec3Ctor1(l);
-		break;
-	case 3:
-		res = pwrapVec3Ctor2(l);
-		break;
-	default:
-		lua_pushfstring(l, "Wrong overloaded new. Wrong number of arguments: %d", argCount);
-		res = -1;
-	}
-
+	int res = pwrapVec2divAssign(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1173,65 +1119,57 @@ static int wrapVec3Ctor(lua_State* l)
 	return 0;
 }
 
-/// Wrap destructor for Vec3.
-static int wrapVec3Dtor(lua_State* l)
+/// Pre-wrap method Vec2::operator/ that writes the result to the last argument.
+static inline int pwrapVec2divTo(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	if(ud->isGarbageCollected())
-	{
-		Vec3* inst = ud->getData<Vec3>();
-		inst->~Vec3();
-	}
-
-	return 0;
-}
-
-/// Pre-wrap method Vec3::getX.
-static inline int pwrapVec3getX(lua_State* l)
-{
-	[[maybe_unused]] LuaUserData* ud;
-	[[maybe_unused]] void* voidp;
-	[[maybe_unused]] PtrSize size;
+	Vec2* self = ud->getData<Vec2>();
 
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
+
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec2, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	Vec2* out = ud->getData<Vec2>();
 
 	// Call the method
-	F32 ret = (*self).x();
-
-	// Push return value
-	lua_pushnumber(l, lua_Number(ret));
+	*out = self->operator/(arg0);
 
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 3);
 	return 1;
 }
 
-/// Wrap method Vec3::getX.
-static int wrapVec3getX(lua_State* l)
+/// Wrap method Vec2::operator/.
+static int wrapVec2divTo(lua_State* l)
 {
-	int res = pwrapVec3getX(l);
+	int res = pwrapVec2divTo(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1241,39 +1179,49 @@ static int wrapVec3getX(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::getY.
-static inline int pwrapVec3getY(lua_State* l)
+/// Pre-wrap method Vec2::operator==.
+static inline int pwrapVec2__eq(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	Vec2* self = ud->getData<Vec2>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
 
 	// Call the method
-	F32 ret = (*self).y();
+	Bool ret = self->operator==(arg0);
 
 	// Push return value
-	lua_pushnumber(l, lua_Number(ret));
+	lua_pushboolean(l, ret);
 
 	return 1;
 }
 
-/// Wrap method Vec3::getY.
-static int wrapVec3getY(lua_State* l)
+/// Wrap method Vec2::operator==.
+static int wrapVec2__eq(lua_State* l)
 {
-	int res = pwrapVec3getY(l);
+	int res = pwrapVec2__eq(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1283,8 +1231,8 @@ static int wrapVec3getY(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::getZ.
-static inline int pwrapVec3getZ(lua_State* l)
+/// Pre-wrap method Vec2::getLength.
+static inline int pwrapVec2getLength(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -1296,15 +1244,15 @@ static inline int pwrapVec3getZ(lua_State* l)
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	Vec2* self = ud->getData<Vec2>();
 
 	// Call the method
-	F32 ret = (*self).z();
+	F32 ret = self->getLength();
 
 	// Push return value
 	lua_pushnumber(l, lua_Number(ret));
@@ -1312,10 +1260,10 @@ static inline int pwrapVec3getZ(lua_State* l)
 	return 1;
 }
 
-/// Wrap method Vec3::getZ.
-static int wrapVec3getZ(lua_State* l)
+/// Wrap method Vec2::getLength.
+static int wrapVec2getLength(lua_State* l)
 {
-	int res = pwrapVec3getZ(l);
+	int res = pwrapVec2getLength(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1325,43 +1273,41 @@ static int wrapVec3getZ(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::setX.
-static inline int pwrapVec3setX(lua_State* l)
+/// Pre-wrap method Vec2::getNormalized.
+static inline int pwrapVec2getNormalized(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
-
-	// Pop arguments
-	F32 arg0;
-	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
-	{
-		return -1;
-	}
+	Vec2* self = ud->getData<Vec2>();
 
 	// Call the method
-	(*self).x() = arg0;
+	Vec2 ret = self->getNormalized();
 
-	return 0;
+	// Push return value
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec2);
+	::new(ud->getData<Vec2>()) Vec2(std::move(ret));
+
+	return 1;
 }
 
-/// Wrap method Vec3::setX.
-static int wrapVec3setX(lua_State* l)
+/// Wrap method Vec2::getNormalized.
+static int wrapVec2getNormalized(lua_State* l)
 {
-	int res = pwrapVec3setX(l);
+	int res = pwrapVec2getNormalized(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1371,8 +1317,8 @@ static int wrapVec3setX(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::setY.
-static inline int pwrapVec3setY(lua_State* l)
+/// Pre-wrap method Vec2::getNormalized that writes the result to the last argument.
+static inline int pwrapVec2getNormalizedTo(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -1384,30 +1330,34 @@ static inline int pwrapVec3setY(lua_State* l)
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	Vec2* self = ud->getData<Vec2>();
 
-	// Pop arguments
-	F32 arg0;
-	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
+	Vec2* out = ud->getData<Vec2>();
+
 	// Call the method
-	(*self).y() = arg0;
+	*out = self->getNormalized();
 
-	return 0;
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 2);
+	return 1;
 }
 
-/// Wrap method Vec3::setY.
-static int wrapVec3setY(lua_State* l)
+/// Wrap method Vec2::getNormalized.
+static int wrapVec2getNormalizedTo(lua_State* l)
 {
-	int res = pwrapVec3setY(l);
+	int res = pwrapVec2getNormalizedTo(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1417,43 +1367,36 @@ static int wrapVec3setY(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::setZ.
-static inline int pwrapVec3setZ(lua_State* l)
+/// Pre-wrap method Vec2::normalize.
+static inline int pwrapVec2normalize(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
-
-	// Pop arguments
-	F32 arg0;
-	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
-	{
-		return -1;
-	}
+	Vec2* self = ud->getData<Vec2>();
 
 	// Call the method
-	(*self).z() = arg0;
+	self->normalize();
 
 	return 0;
 }
 
-/// Wrap method Vec3::setZ.
-static int wrapVec3setZ(lua_State* l)
+/// Wrap method Vec2::normalize.
+static int wrapVec2normalize(lua_State* l)
 {
-	int res = pwrapVec3setZ(l);
+	int res = pwrapVec2normalize(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1463,55 +1406,49 @@ static int wrapVec3setZ(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::setAll.
-static inline int pwrapVec3setAll(lua_State* l)
+/// Pre-wrap method Vec2::dot.
+static inline int pwrapVec2dot(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 4)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	Vec2* self = ud->getData<Vec2>();
 
 	// Pop arguments
-	F32 arg0;
-	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
-	{
-		return -1;
-	}
-
-	F32 arg1;
-	if(LuaBinder::checkNumber(l, 3, arg1)) [[unlikely]]
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	F32 arg2;
-	if(LuaBinder::checkNumber(l, 4, arg2)) [[unlikely]]
-	{
-		return -1;
-	}
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
 
 	// Call the method
-	(*self) = Vec3(arg0, arg1, arg2);
+	F32 ret = self->dot(arg0);
 
-	return 0;
+	// Push return value
+	lua_pushnumber(l, lua_Number(ret));
+
+	return 1;
 }
 
-/// Wrap method Vec3::setAll.
-static int wrapVec3setAll(lua_State* l)
+/// Wrap method Vec2::dot.
+static int wrapVec2dot(lua_State* l)
 {
-	int res = pwrapVec3setAll(l);
+	int res = pwrapVec2dot(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1521,57 +1458,113 @@ static int wrapVec3setAll(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::getAt.
-static inline int pwrapVec3getAt(lua_State* l)
+/// Wrap class Vec2.
+static inline void wrapVec2(lua_State* l)
 {
-	[[maybe_unused]] LuaUserData* ud;
-	[[maybe_unused]] void* voidp;
-	[[maybe_unused]] PtrSize size;
-
-	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
-	{
-		return -1;
-	}
+	LuaBinder::createClass(l, &luaUserDataTypeInfoVec2);
+	LuaBinder::pushLuaCFuncStaticMethod(l, luaUserDataTypeInfoVec2.m_typeName, "new", wrapVec2Ctor);
+	LuaBinder::pushLuaCFuncMethod(l, "__gc", wrapVec2Dtor);
+	LuaBinder::pushLuaCFuncMethod(l, "getX", wrapVec2getX);
+	LuaBinder::pushLuaCFuncMethod(l, "getY", wrapVec2getY);
+	LuaBinder::pushLuaCFuncMethod(l, "setX", wrapVec2setX);
+	LuaBinder::pushLuaCFuncMethod(l, "setY", wrapVec2setY);
+	LuaBinder::pushLuaCFuncMethod(l, "setAll", wrapVec2setAll);
+	LuaBinder::pushLuaCFuncMethod(l, "getAt", wrapVec2getAt);
+	LuaBinder::pushLuaCFuncMethod(l, "setAt", wrapVec2setAt);
+	LuaBinder::pushLuaCFuncMethod(l, "copy", wrapVec2copy);
+	LuaBinder::pushLuaCFuncMethod(l, "__add", wrapVec2__add);
+	LuaBinder::pushLuaCFuncMethod(l, "addAssign", wrapVec2addAssign);
+	LuaBinder::pushLuaCFuncMethod(l, "addTo", wrapVec2addTo);
+	LuaBinder::pushLuaCFuncMethod(l, "__sub", wrapVec2__sub);
+	LuaBinder::pushLuaCFuncMethod(l, "subAssign", wrapVec2subAssign);
+	LuaBinder::pushLuaCFuncMethod(l, "subTo", wrapVec2subTo);
+	LuaBinder::pushLuaCFuncMethod(l, "__mul", wrapVec2__mul);
+	LuaBinder::pushLuaCFuncMethod(l, "mulAssign", wrapVec2mulAssign);
+	LuaBinder::pushLuaCFuncMethod(l, "mulTo", wrapVec2mulTo);
+	LuaBinder::pushLuaCFuncMethod(l, "__div", wrapVec2__div);
+	LuaBinder::pushLuaCFuncMethod(l, "divAssign", wrapVec2divAssign);
+	LuaBinder::pushLuaCFuncMethod(l, "divTo", wrapVec2divTo);
+	LuaBinder::pushLuaCFuncMethod(l, "__eq", wrapVec2__eq);
+	LuaBinder::pushLuaCFuncMethod(l, "getLength", wrapVec2getLength);
+	LuaBinder::pushLuaCFuncMethod(l, "getNormalized", wrapVec2getNormalized);
+	LuaBinder::pushLuaCFuncMethod(l, "getNormalizedTo", wrapVec2getNormalizedTo);
+	LuaBinder::pushLuaCFuncMethod(l, "normalize", wrapVec2normalize);
+	LuaBinder::pushLuaCFuncMethod(l, "dot", wrapVec2dot);
+	lua_settop(l, 0);
+}
 
-	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
-	{
-		return -1;
-	}
+/// Serialize Vec3
+static void serializeVec3(LuaUserData& self, void* data, PtrSize& size)
+{
+	Vec3* obj = self.getData<Vec3>();
+	obj->serialize(data, size);
+}
 
-	Vec3* self = ud->getData<Vec3>();
+/// De-serialize Vec3
+static void deserializeVec3(const void* data, LuaUserData& self)
+{
+	ANKI_ASSERT(data);
+	Vec3* obj = self.getData<Vec3>();
+	::new(obj) Vec3();
+	obj->deserialize(data);
+}
 
-	// Pop arguments
-	U arg0;
-	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+LuaUserDataTypeInfo luaUserDataTypeInfoVec3 = {5669632566763941038, "Vec3",          LuaUserData::computeSizeForGarbageCollected<Vec3>(),
+											   serializeVec3,       deserializeVec3, true};
+
+template<>
+const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<Vec3>()
+{
+	return luaUserDataTypeInfoVec3;
+}
+
+/// Pre-wrap constructor for Vec3.
+static inline int pwrapVec3Ctor0(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 0)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	// Call the method
-	F32 ret = (*self)[arg0];
-
-	// Push return value
-	lua_pushnumber(l, lua_Number(ret));
+	// Create user data
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3();
 
 	return 1;
 }
 
-/// Wrap method Vec3::getAt.
-static int wrapVec3getAt(lua_State* l)
+/// Pre-wrap constructor for Vec3.
+static inline int pwrapVec3Ctor1(lua_State* l)
 {
-	int res = pwrapVec3getAt(l);
-	if(res >= 0)
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
 	{
-		return res;
+		return -1;
 	}
 
-	lua_error(l);
-	return 0;
+	// Pop arguments
+	F32 arg0;
+	if(LuaBinder::checkNumber(l, 1, arg0)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Create user data
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(arg0);
+
+	return 1;
 }
 
-/// Pre-wrap method Vec3::setAt.
-static inline int pwrapVec3setAt(lua_State* l)
+/// Pre-wrap constructor for Vec3.
+static inline int pwrapVec3Ctor2(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -1582,37 +1575,54 @@ static inline int pwrapVec3setAt(lua_State* l)
 		return -1;
 	}
 
-	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	// Pop arguments
+	F32 arg0;
+	if(LuaBinder::checkNumber(l, 1, arg0)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
-
-	// Pop arguments
-	U arg0;
-	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	F32 arg1;
+	if(LuaBinder::checkNumber(l, 2, arg1)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	F32 arg1;
-	if(LuaBinder::checkNumber(l, 3, arg1)) [[unlikely]]
+	F32 arg2;
+	if(LuaBinder::checkNumber(l, 3, arg2)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	// Call the method
-	(*self)[arg0] = arg1;
+	// Create user data
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(arg0, arg1, arg2);
 
-	return 0;
+	return 1;
 }
 
-/// Wrap method Vec3::setAt.
-static int wrapVec3setAt(lua_State* l)
+/// Wrap constructors for Vec3.
+static int wrapVec3Ctor(lua_State* l)
 {
-	int res = pwrapVec3setAt(l);
+	// Chose the right overload
+	const int argCount = lua_gettop(l);
+	int res = 0;
+	switch(argCount)
+	{
+	case 0:
+		res = pwrapVec3Ctor0(l);
+		break;
+	case 1:
+		res = pwrapVec3Ctor1(l);
+		break;
+	case 3:
+		res = pwrapVec3Ctor2(l);
+		break;
+	default:
+		lua_pushfstring(l, "Wrong overloaded new. Wrong number of arguments: %d", argCount);
+		res = -1;
+	}
+
 	if(res >= 0)
 	{
 		return res;
@@ -1622,46 +1632,66 @@ static int wrapVec3setAt(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::operator=.
-static inline int pwrapVec3copy(lua_State* l)
+/// Wrap destructor for Vec3.
+static int wrapVec3Dtor(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	if(ud->isGarbageCollected())
+	{
+		Vec3* inst = ud->getData<Vec3>();
+		inst->~Vec3();
+		LuaBinder::recycleGarbageCollectedUserData(l, 1);
+	}
 
-	// Pop arguments
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	return 0;
+}
+
+/// Pre-wrap method Vec3::getX.
+static inline int pwrapVec3getX(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	Vec3* iarg0 = ud->getData<Vec3>();
-	const Vec3& arg0(*iarg0);
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
 
 	// Call the method
-	self->operator=(arg0);
+	F32 ret = (*self).x();
 
-	return 0;
+	// Push return value
+	lua_pushnumber(l, lua_Number(ret));
+
+	return 1;
 }
 
-/// Wrap method Vec3::operator=.
-static int wrapVec3copy(lua_State* l)
+/// Wrap method Vec3::getX.
+static int wrapVec3getX(lua_State* l)
 {
-	int res = pwrapVec3copy(l);
+	int res = pwrapVec3getX(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1671,14 +1701,14 @@ static int wrapVec3copy(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::operator+.
-static inline int pwrapVec3__add(lua_State* l)
+/// Pre-wrap method Vec3::getY.
+static inline int pwrapVec3getY(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -1691,35 +1721,19 @@ static inline int pwrapVec3__add(lua_State* l)
 
 	Vec3* self = ud->getData<Vec3>();
 
-	// Pop arguments
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
-	{
-		return -1;
-	}
-
-	Vec3* iarg0 = ud->getData<Vec3>();
-	const Vec3& arg0(*iarg0);
-
 	// Call the method
-	Vec3 ret = self->operator+(arg0);
+	F32 ret = (*self).y();
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec3");
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+	lua_pushnumber(l, lua_Number(ret));
 
 	return 1;
 }
 
-/// Wrap method Vec3::operator+.
-static int wrapVec3__add(lua_State* l)
+/// Wrap method Vec3::getY.
+static int wrapVec3getY(lua_State* l)
 {
-	int res = pwrapVec3__add(l);
+	int res = pwrapVec3getY(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1729,14 +1743,14 @@ static int wrapVec3__add(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::operator-.
-static inline int pwrapVec3__sub(lua_State* l)
+/// Pre-wrap method Vec3::getZ.
+static inline int pwrapVec3getZ(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -1749,35 +1763,19 @@ static inline int pwrapVec3__sub(lua_State* l)
 
 	Vec3* self = ud->getData<Vec3>();
 
-	// Pop arguments
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
-	{
-		return -1;
-	}
-
-	Vec3* iarg0 = ud->getData<Vec3>();
-	const Vec3& arg0(*iarg0);
-
 	// Call the method
-	Vec3 ret = self->operator-(arg0);
+	F32 ret = (*self).z();
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec3");
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+	lua_pushnumber(l, lua_Number(ret));
 
 	return 1;
 }
 
-/// Wrap method Vec3::operator-.
-static int wrapVec3__sub(lua_State* l)
+/// Wrap method Vec3::getZ.
+static int wrapVec3getZ(lua_State* l)
 {
-	int res = pwrapVec3__sub(l);
+	int res = pwrapVec3getZ(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1787,8 +1785,8 @@ static int wrapVec3__sub(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::operator*.
-static inline int pwrapVec3__mul(lua_State* l)
+/// Pre-wrap method Vec3::setX.
+static inline int pwrapVec3setX(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -1808,34 +1806,22 @@ static inline int pwrapVec3__mul(lua_State* l)
 	Vec3* self = ud->getData<Vec3>();
 
 	// Pop arguments
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	F32 arg0;
+	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	Vec3* iarg0 = ud->getData<Vec3>();
-	const Vec3& arg0(*iarg0);
-
 	// Call the method
-	Vec3 ret = self->operator*(arg0);
-
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec3");
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+	(*self).x() = arg0;
 
-	return 1;
+	return 0;
 }
 
-/// Wrap method Vec3::operator*.
-static int wrapVec3__mul(lua_State* l)
+/// Wrap method Vec3::setX.
+static int wrapVec3setX(lua_State* l)
 {
-	int res = pwrapVec3__mul(l);
+	int res = pwrapVec3setX(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1845,8 +1831,8 @@ static int wrapVec3__mul(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::operator/.
-static inline int pwrapVec3__div(lua_State* l)
+/// Pre-wrap method Vec3::setY.
+static inline int pwrapVec3setY(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -1866,34 +1852,22 @@ static inline int pwrapVec3__div(lua_State* l)
 	Vec3* self = ud->getData<Vec3>();
 
 	// Pop arguments
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	F32 arg0;
+	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	Vec3* iarg0 = ud->getData<Vec3>();
-	const Vec3& arg0(*iarg0);
-
 	// Call the method
-	Vec3 ret = self->operator/(arg0);
-
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec3");
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+	(*self).y() = arg0;
 
-	return 1;
+	return 0;
 }
 
-/// Wrap method Vec3::operator/.
-static int wrapVec3__div(lua_State* l)
+/// Wrap method Vec3::setY.
+static int wrapVec3setY(lua_State* l)
 {
-	int res = pwrapVec3__div(l);
+	int res = pwrapVec3setY(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1903,8 +1877,8 @@ static int wrapVec3__div(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::operator==.
-static inline int pwrapVec3__eq(lua_State* l)
+/// Pre-wrap method Vec3::setZ.
+static inline int pwrapVec3setZ(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -1924,28 +1898,22 @@ static inline int pwrapVec3__eq(lua_State* l)
 	Vec3* self = ud->getData<Vec3>();
 
 	// Pop arguments
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	F32 arg0;
+	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	Vec3* iarg0 = ud->getData<Vec3>();
-	const Vec3& arg0(*iarg0);
-
 	// Call the method
-	Bool ret = self->operator==(arg0);
-
-	// Push return value
-	lua_pushboolean(l, ret);
+	(*self).z() = arg0;
 
-	return 1;
+	return 0;
 }
 
-/// Wrap method Vec3::operator==.
-static int wrapVec3__eq(lua_State* l)
+/// Wrap method Vec3::setZ.
+static int wrapVec3setZ(lua_State* l)
 {
-	int res = pwrapVec3__eq(l);
+	int res = pwrapVec3setZ(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1955,14 +1923,14 @@ static int wrapVec3__eq(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::getLength.
-static inline int pwrapVec3getLength(lua_State* l)
+/// Pre-wrap method Vec3::setAll.
+static inline int pwrapVec3setAll(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 4)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -1975,19 +1943,35 @@ static inline int pwrapVec3getLength(lua_State* l)
 
 	Vec3* self = ud->getData<Vec3>();
 
-	// Call the method
-	F32 ret = self->getLength();
+	// Pop arguments
+	F32 arg0;
+	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	{
+		return -1;
+	}
 
-	// Push return value
-	lua_pushnumber(l, lua_Number(ret));
+	F32 arg1;
+	if(LuaBinder::checkNumber(l, 3, arg1)) [[unlikely]]
+	{
+		return -1;
+	}
 
-	return 1;
+	F32 arg2;
+	if(LuaBinder::checkNumber(l, 4, arg2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Call the method
+	(*self) = Vec3(arg0, arg1, arg2);
+
+	return 0;
 }
 
-/// Wrap method Vec3::getLength.
-static int wrapVec3getLength(lua_State* l)
+/// Wrap method Vec3::setAll.
+static int wrapVec3setAll(lua_State* l)
 {
-	int res = pwrapVec3getLength(l);
+	int res = pwrapVec3setAll(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1997,14 +1981,14 @@ static int wrapVec3getLength(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::getNormalized.
-static inline int pwrapVec3getNormalized(lua_State* l)
+/// Pre-wrap method Vec3::getAt.
+static inline int pwrapVec3getAt(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -2017,25 +2001,26 @@ static inline int pwrapVec3getNormalized(lua_State* l)
 
 	Vec3* self = ud->getData<Vec3>();
 
+	// Pop arguments
+	U arg0;
+	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	{
+		return -1;
+	}
+
 	// Call the method
-	Vec3 ret = self->getNormalized();
+	F32 ret = (*self)[arg0];
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec3");
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+	lua_pushnumber(l, lua_Number(ret));
 
 	return 1;
 }
 
-/// Wrap method Vec3::getNormalized.
-static int wrapVec3getNormalized(lua_State* l)
+/// Wrap method Vec3::getAt.
+static int wrapVec3getAt(lua_State* l)
 {
-	int res = pwrapVec3getNormalized(l);
+	int res = pwrapVec3getAt(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2045,14 +2030,14 @@ static int wrapVec3getNormalized(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::normalize.
-static inline int pwrapVec3normalize(lua_State* l)
+/// Pre-wrap method Vec3::setAt.
+static inline int pwrapVec3setAt(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -2065,16 +2050,29 @@ static inline int pwrapVec3normalize(lua_State* l)
 
 	Vec3* self = ud->getData<Vec3>();
 
+	// Pop arguments
+	U arg0;
+	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	F32 arg1;
+	if(LuaBinder::checkNumber(l, 3, arg1)) [[unlikely]]
+	{
+		return -1;
+	}
+
 	// Call the method
-	self->normalize();
+	(*self)[arg0] = arg1;
 
 	return 0;
 }
 
-/// Wrap method Vec3::normalize.
-static int wrapVec3normalize(lua_State* l)
+/// Wrap method Vec3::setAt.
+static int wrapVec3setAt(lua_State* l)
 {
-	int res = pwrapVec3normalize(l);
+	int res = pwrapVec3setAt(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2084,8 +2082,8 @@ static int wrapVec3normalize(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::dot.
-static inline int pwrapVec3dot(lua_State* l)
+/// Pre-wrap method Vec3::operator=.
+static inline int pwrapVec3copy(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -2115,18 +2113,15 @@ static inline int pwrapVec3dot(lua_State* l)
 	const Vec3& arg0(*iarg0);
 
 	// Call the method
-	F32 ret = self->dot(arg0);
-
-	// Push return value
-	lua_pushnumber(l, lua_Number(ret));
+	self->operator=(arg0);
 
-	return 1;
+	return 0;
 }
 
-/// Wrap method Vec3::dot.
-static int wrapVec3dot(lua_State* l)
+/// Wrap method Vec3::operator=.
+static int wrapVec3copy(lua_State* l)
 {
-	int res = pwrapVec3dot(l);
+	int res = pwrapVec3copy(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2136,185 +2131,1451 @@ static int wrapVec3dot(lua_State* l)
 	return 0;
 }
 
-/// Wrap class Vec3.
-static inline void wrapVec3(lua_State* l)
-{
-	LuaBinder::createClass(l, &luaUserDataTypeInfoVec3);
-	LuaBinder::pushLuaCFuncStaticMethod(l, luaUserDataTypeInfoVec3.m_typeName, "new", wrapVec3Ctor);
-	LuaBinder::pushLuaCFuncMethod(l, "__gc", wrapVec3Dtor);
-	LuaBinder::pushLuaCFuncMethod(l, "getX", wrapVec3getX);
-	LuaBinder::pushLuaCFuncMethod(l, "getY", wrapVec3getY);
-	LuaBinder::pushLuaCFuncMethod(l, "getZ", wrapVec3getZ);
-	LuaBinder::pushLuaCFuncMethod(l, "setX", wrapVec3setX);
-	LuaBinder::pushLuaCFuncMethod(l, "setY", wrapVec3setY);
-	LuaBinder::pushLuaCFuncMethod(l, "setZ", wrapVec3setZ);
-	LuaBinder::pushLuaCFuncMethod(l, "setAll", wrapVec3setAll);
-	LuaBinder::pushLuaCFuncMethod(l, "getAt", wrapVec3getAt);
-	LuaBinder::pushLuaCFuncMethod(l, "setAt", wrapVec3setAt);
-	LuaBinder::pushLuaCFuncMethod(l, "copy", wrapVec3copy);
-	LuaBinder::pushLuaCFuncMethod(l, "__add", wrapVec3__add);
-	LuaBinder::pushLuaCFuncMethod(l, "__sub", wrapVec3__sub);
-	LuaBinder::pushLuaCFuncMethod(l, "__mul", wrapVec3__mul);
-	LuaBinder::pushLuaCFuncMethod(l, "__div", wrapVec3__div);
-	LuaBinder::pushLuaCFuncMethod(l, "__eq", wrapVec3__eq);
-	LuaBinder::pushLuaCFuncMethod(l, "getLength", wrapVec3getLength);
-	LuaBinder::pushLuaCFuncMethod(l, "getNormalized", wrapVec3getNormalized);
-	LuaBinder::pushLuaCFuncMethod(l, "normalize", wrapVec3normalize);
-	LuaBinder::pushLuaCFuncMethod(l, "dot", wrapVec3dot);
-	lua_settop(l, 0);
-}
-
-/// Serialize Vec4
-static void serializeVec4(LuaUserData& self, void* data, PtrSize& size)
-{
-	Vec4* obj = self.getData<Vec4>();
-	obj->serialize(data, size);
-}
-
-/// De-serialize Vec4
-static void deserializeVec4(const void* data, LuaUserData& self)
-{
-	ANKI_ASSERT(data);
-	Vec4* obj = self.getData<Vec4>();
-	::new(obj) Vec4();
-	obj->deserialize(data);
-}
-
-LuaUserDataTypeInfo luaUserDataTypeInfoVec4 = {-7510298399639860788, "Vec4", LuaUserData::computeSizeForGarbageCollected<Vec4>(), serializeVec4,
-											   deserializeVec4};
-
-template<>
-const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<Vec4>()
-{
-	return luaUserDataTypeInfoVec4;
-}
-
-/// Pre-wrap constructor for Vec4.
-static inline int pwrapVec4Ctor0(lua_State* l)
+/// Pre-wrap method Vec3::operator+.
+static inline int pwrapVec3__add(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 0)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoVec4.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
-	::new(ud->getData<Vec4>()) Vec4();
-
-	return 1;
-}
-
-/// Pre-wrap constructor for Vec4.
-static inline int pwrapVec4Ctor1(lua_State* l)
-{
-	[[maybe_unused]] LuaUserData* ud;
-	[[maybe_unused]] void* voidp;
-	[[maybe_unused]] PtrSize size;
-
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
 	{
 		return -1;
 	}
 
+	Vec3* self = ud->getData<Vec3>();
+
 	// Pop arguments
-	F32 arg0;
-	if(LuaBinder::checkNumber(l, 1, arg0)) [[unlikely]]
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoVec4.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator+(arg0);
+
+	// Push return value
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec3::operator+.
+static int wrapVec3__add(lua_State* l)
+{
+	int res = pwrapVec3__add(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator+ that writes the result to self.
+static inline int pwrapVec3addAssign(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	*self = self->operator+(arg0);
+
+	// Push self, no allocation
+	lua_pushvalue(l, 1);
+	return 1;
+}
+
+/// Wrap method Vec3::operator+.
+static int wrapVec3addAssign(lua_State* l)
+{
+	int res = pwrapVec3addAssign(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator+ that writes the result to the last argument.
+static inline int pwrapVec3addTo(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* out = ud->getData<Vec3>();
+
+	// Call the method
+	*out = self->operator+(arg0);
+
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 3);
+	return 1;
+}
+
+/// Wrap method Vec3::operator+.
+static int wrapVec3addTo(lua_State* l)
+{
+	int res = pwrapVec3addTo(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator-.
+static inline int pwrapVec3__sub(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator-(arg0);
+
+	// Push return value
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec3::operator-.
+static int wrapVec3__sub(lua_State* l)
+{
+	int res = pwrapVec3__sub(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator- that writes the result to self.
+static inline int pwrapVec3subAssign(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	*self = self->operator-(arg0);
+
+	// Push self, no allocation
+	lua_pushvalue(l, 1);
+	return 1;
+}
+
+/// Wrap method Vec3::operator-.
+static int wrapVec3subAssign(lua_State* l)
+{
+	int res = pwrapVec3subAssign(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator- that writes the result to the last argument.
+static inline int pwrapVec3subTo(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* out = ud->getData<Vec3>();
+
+	// Call the method
+	*out = self->operator-(arg0);
+
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 3);
+	return 1;
+}
+
+/// Wrap method Vec3::operator-.
+static int wrapVec3subTo(lua_State* l)
+{
+	int res = pwrapVec3subTo(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator*.
+static inline int pwrapVec3__mul(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator*(arg0);
+
+	// Push return value
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec3::operator*.
+static int wrapVec3__mul(lua_State* l)
+{
+	int res = pwrapVec3__mul(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator* that writes the result to self.
+static inline int pwrapVec3mulAssign(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	*self = self->operator*(arg0);
+
+	// Push self, no allocation
+	lua_pushvalue(l, 1);
+	return 1;
+}
+
+/// Wrap method Vec3::operator*.
+static int wrapVec3mulAssign(lua_State* l)
+{
+	int res = pwrapVec3mulAssign(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator* that writes the result to the last argument.
+static inline int pwrapVec3mulTo(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* out = ud->getData<Vec3>();
+
+	// Call the method
+	*out = self->operator*(arg0);
+
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 3);
+	return 1;
+}
+
+/// Wrap method Vec3::operator*.
+static int wrapVec3mulTo(lua_State* l)
+{
+	int res = pwrapVec3mulTo(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator/.
+static inline int pwrapVec3__div(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator/(arg0);
+
+	// Push return value
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec3::operator/.
+static int wrapVec3__div(lua_State* l)
+{
+	int res = pwrapVec3__div(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator/ that writes the result to self.
+static inline int pwrapVec3divAssign(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	*self = self->operator/(arg0);
+
+	// Push self, no allocation
+	lua_pushvalue(l, 1);
+	return 1;
+}
+
+/// Wrap method Vec3::operator/.
+static int wrapVec3divAssign(lua_State* l)
+{
+	int res = pwrapVec3divAssign(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator/ that writes the result to the last argument.
+static inline int pwrapVec3divTo(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* out = ud->getData<Vec3>();
+
+	// Call the method
+	*out = self->operator/(arg0);
+
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 3);
+	return 1;
+}
+
+/// Wrap method Vec3::operator/.
+static int wrapVec3divTo(lua_State* l)
+{
+	int res = pwrapVec3divTo(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator==.
+static inline int pwrapVec3__eq(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Bool ret = self->operator==(arg0);
+
+	// Push return value
+	lua_pushboolean(l, ret);
+
+	return 1;
+}
+
+/// Wrap method Vec3::operator==.
+static int wrapVec3__eq(lua_State* l)
+{
+	int res = pwrapVec3__eq(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::getLength.
+static inline int pwrapVec3getLength(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Call the method
+	F32 ret = self->getLength();
+
+	// Push return value
+	lua_pushnumber(l, lua_Number(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec3::getLength.
+static int wrapVec3getLength(lua_State* l)
+{
+	int res = pwrapVec3getLength(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::getNormalized.
+static inline int pwrapVec3getNormalized(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Call the method
+	Vec3 ret = self->getNormalized();
+
+	// Push return value
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec3::getNormalized.
+static int wrapVec3getNormalized(lua_State* l)
+{
+	int res = pwrapVec3getNormalized(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::getNormalized that writes the result to the last argument.
+static inline int pwrapVec3getNormalizedTo(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* out = ud->getData<Vec3>();
+
+	// Call the method
+	*out = self->getNormalized();
+
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 2);
+	return 1;
+}
+
+/// Wrap method Vec3::getNormalized.
+static int wrapVec3getNormalizedTo(lua_State* l)
+{
+	int res = pwrapVec3getNormalizedTo(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::normalize.
+static inline int pwrapVec3normalize(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Call the method
+	self->normalize();
+
+	return 0;
+}
+
+/// Wrap method Vec3::normalize.
+static int wrapVec3normalize(lua_State* l)
+{
+	int res = pwrapVec3normalize(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::dot.
+static inline int pwrapVec3dot(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	F32 ret = self->dot(arg0);
+
+	// Push return value
+	lua_pushnumber(l, lua_Number(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec3::dot.
+static int wrapVec3dot(lua_State* l)
+{
+	int res = pwrapVec3dot(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Wrap class Vec3.
+static inline void wrapVec3(lua_State* l)
+{
+	LuaBinder::createClass(l, &luaUserDataTypeInfoVec3);
+	LuaBinder::pushLuaCFuncStaticMethod(l, luaUserDataTypeInfoVec3.m_typeName, "new", wrapVec3Ctor);
+	LuaBinder::pushLuaCFuncMethod(l, "__gc", wrapVec3Dtor);
+	LuaBinder::pushLuaCFuncMethod(l, "getX", wrapVec3getX);
+	LuaBinder::pushLuaCFuncMethod(l, "getY", wrapVec3getY);
+	LuaBinder::pushLuaCFuncMethod(l, "getZ", wrapVec3getZ);
+	LuaBinder::pushLuaCFuncMethod(l, "setX", wrapVec3setX);
+	LuaBinder::pushLuaCFuncMethod(l, "setY", wrapVec3setY);
+	LuaBinder::pushLuaCFuncMethod(l, "setZ", wrapVec3setZ);
+	LuaBinder::pushLuaCFuncMethod(l, "setAll", wrapVec3setAll);
+	LuaBinder::pushLuaCFuncMethod(l, "getAt", wrapVec3getAt);
+	LuaBinder::pushLuaCFuncMethod(l, "setAt", wrapVec3setAt);
+	LuaBinder::pushLuaCFuncMethod(l, "copy", wrapVec3copy);
+	LuaBinder::pushLuaCFuncMethod(l, "__add", wrapVec3__add);
+	LuaBinder::pushLuaCFuncMethod(l, "addAssign", wrapVec3addAssign);
+	LuaBinder::pushLuaCFuncMethod(l, "addTo", wrapVec3addTo);
+	LuaBinder::pushLuaCFuncMethod(l, "__sub", wrapVec3__sub);
+	LuaBinder::pushLuaCFuncMethod(l, "subAssign", wrapVec3subAssign);
+	LuaBinder::pushLuaCFuncMethod(l, "subTo", wrapVec3subTo);
+	LuaBinder::pushLuaCFuncMethod(l, "__mul", wrapVec3__mul);
+	LuaBinder::pushLuaCFuncMethod(l, "mulAssign", wrapVec3mulAssign);
+	LuaBinder::pushLuaCFuncMethod(l, "mulTo", wrapVec3mulTo);
+	LuaBinder::pushLuaCFuncMethod(l, "__div", wrapVec3__div);
+	LuaBinder::pushLuaCFuncMethod(l, "divAssign", wrapVec3divAssign);
+	LuaBinder::pushLuaCFuncMethod(l, "divTo", wrapVec3divTo);
+	LuaBinder::pushLuaCFuncMethod(l, "__eq", wrapVec3__eq);
+	LuaBinder::pushLuaCFuncMethod(l, "getLength", wrapVec3getLength);
+	LuaBinder::pushLuaCFuncMethod(l, "getNormalized", wrapVec3getNormalized);
+	LuaBinder::pushLuaCFuncMethod(l, "getNormalizedTo", wrapVec3getNormalizedTo);
+	LuaBinder::pushLuaCFuncMethod(l, "normalize", wrapVec3normalize);
+	LuaBinder::pushLuaCFuncMethod(l, "dot", wrapVec3dot);
+	lua_settop(l, 0);
+}
+
+/// Serialize Vec4
+static void serializeVec4(LuaUserData& self, void* data, PtrSize& size)
+{
+	Vec4* obj = self.getData<Vec4>();
+	obj->serialize(data, size);
+}
+
+/// De-serialize Vec4
+static void deserializeVec4(const void* data, LuaUserData& self)
+{
+	ANKI_ASSERT(data);
+	Vec4* obj = self.getData<Vec4>();
+	::new(obj) Vec4();
+	obj->deserialize(data);
+}
+
+LuaUserDataTypeInfo luaUserDataTypeInfoVec4 = {-7510298399639860788, "Vec4",          LuaUserData::computeSizeForGarbageCollected<Vec4>(),
+											   serializeVec4,        deserializeVec4, true};
+
+template<>
+const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<Vec4>()
+{
+	return luaUserDataTypeInfoVec4;
+}
+
+/// Pre-wrap constructor for Vec4.
+static inline int pwrapVec4Ctor0(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 0)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Create user data
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec4);
+	::new(ud->getData<Vec4>()) Vec4();
+
+	return 1;
+}
+
+/// Pre-wrap constructor for Vec4.
+static inline int pwrapVec4Ctor1(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Pop arguments
+	F32 arg0;
+	if(LuaBinder::checkNumber(l, 1, arg0)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Create user data
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec4);
 	::new(ud->getData<Vec4>()) Vec4(arg0);
 
 	return 1;
 }
 
-/// Pre-wrap constructor for Vec4.
-static inline int pwrapVec4Ctor2(lua_State* l)
+/// Pre-wrap constructor for Vec4.
+static inline int pwrapVec4Ctor2(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 4)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Pop arguments
+	F32 arg0;
+	if(LuaBinder::checkNumber(l, 1, arg0)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	F32 arg1;
+	if(LuaBinder::checkNumber(l, 2, arg1)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	F32 arg2;
+	if(LuaBinder::checkNumber(l, 3, arg2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	F32 arg3;
+	if(LuaBinder::checkNumber(l, 4, arg3)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Create user data
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec4);
+	::new(ud->getData<Vec4>()) Vec4(arg0, arg1, arg2, arg3);
+
+	return 1;
+}
+
+/// Wrap constructors for Vec4.
+static int wrapVec4Ctor(lua_State* l)
+{
+	// Chose the right overload
+	const int argCount = lua_gettop(l);
+	int res = 0;
+	switch(argCount)
+	{
+	case 0:
+		res = pwrapVec4Ctor0(l);
+		break;
+	case 1:
+		res = pwrapVec4Ctor1(l);
+		break;
+	case 4:
+		res = pwrapVec4Ctor2(l);
+		break;
+	default:
+		lua_pushfstring(l, "Wrong overloaded new. Wrong number of arguments: %d", argCount);
+		res = -1;
+	}
+
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Wrap destructor for Vec4.
+static int wrapVec4Dtor(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	if(ud->isGarbageCollected())
+	{
+		Vec4* inst = ud->getData<Vec4>();
+		inst->~Vec4();
+		LuaBinder::recycleGarbageCollectedUserData(l, 1);
+	}
+
+	return 0;
+}
+
+/// Pre-wrap method Vec4::getX.
+static inline int pwrapVec4getX(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
+	{
+		return -1;
+	}
+
+	Vec4* self = ud->getData<Vec4>();
+
+	// Call the method
+	F32 ret = (*self).x();
+
+	// Push return value
+	lua_pushnumber(l, lua_Number(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec4::getX.
+static int wrapVec4getX(lua_State* l)
+{
+	int res = pwrapVec4getX(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec4::getY.
+static inline int pwrapVec4getY(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
+	{
+		return -1;
+	}
+
+	Vec4* self = ud->getData<Vec4>();
+
+	// Call the method
+	F32 ret = (*self).y();
+
+	// Push return value
+	lua_pushnumber(l, lua_Number(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec4::getY.
+static int wrapVec4getY(lua_State* l)
+{
+	int res = pwrapVec4getY(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec4::getZ.
+static inline int pwrapVec4getZ(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
+	{
+		return -1;
+	}
+
+	Vec4* self = ud->getData<Vec4>();
+
+	// Call the method
+	F32 ret = (*self).z();
+
+	// Push return value
+	lua_pushnumber(l, lua_Number(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec4::getZ.
+static int wrapVec4getZ(lua_State* l)
+{
+	int res = pwrapVec4getZ(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec4::getW.
+static inline int pwrapVec4getW(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 4)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
+	{
+		return -1;
+	}
+
+	Vec4* self = ud->getData<Vec4>();
+
+	// Call the method
+	F32 ret = (*self).w();
+
+	// Push return value
+	lua_pushnumber(l, lua_Number(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec4::getW.
+static int wrapVec4getW(lua_State* l)
+{
+	int res = pwrapVec4getW(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec4::setX.
+static inline int pwrapVec4setX(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
 	{
 		return -1;
 	}
 
+	Vec4* self = ud->getData<Vec4>();
+
 	// Pop arguments
 	F32 arg0;
-	if(LuaBinder::checkNumber(l, 1, arg0)) [[unlikely]]
+	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	F32 arg1;
-	if(LuaBinder::checkNumber(l, 2, arg1)) [[unlikely]]
+	// Call the method
+	(*self).x() = arg0;
+
+	return 0;
+}
+
+/// Wrap method Vec4::setX.
+static int wrapVec4setX(lua_State* l)
+{
+	int res = pwrapVec4setX(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec4::setY.
+static inline int pwrapVec4setY(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	F32 arg2;
-	if(LuaBinder::checkNumber(l, 3, arg2)) [[unlikely]]
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
 	{
 		return -1;
 	}
 
-	F32 arg3;
-	if(LuaBinder::checkNumber(l, 4, arg3)) [[unlikely]]
+	Vec4* self = ud->getData<Vec4>();
+
+	// Pop arguments
+	F32 arg0;
+	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoVec4.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
-	::new(ud->getData<Vec4>()) Vec4(arg0, arg1, arg2, arg3);
+	// Call the method
+	(*self).y() = arg0;
 
-	return 1;
+	return 0;
 }
 
-/// Wrap constructors for Vec4.
-static int wrapVec4Ctor(lua_State* l)
+/// Wrap method Vec4::setY.
+static int wrapVec4setY(lua_State* l)
 {
-	// Chose the right overload
-	const int argCount = lua_gettop(l);
-	int res = 0;
-	switch(argCount)
+	int res = pwrapVec4setY(l);
+	if(res >= 0)
 	{
-	case 0:
-		res = pwrapVec4Ctor0(l);
-		break;
-	case 1:
-		res = pwrapVec4Ctor1(l);
-		break;
-	case 4:
-		res = pwrapVec4Ctor2(l);
-		break;
-	default:
-		lua_pushfstring(l, "Wrong overloaded new. Wrong number of arguments: %d", argCount);
-		res = -1;
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec4::setZ.
+static inline int pwrapVec4setZ(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
+	{
+		return -1;
+	}
+
+	Vec4* self = ud->getData<Vec4>();
+
+	// Pop arguments
+	F32 arg0;
+	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	{
+		return -1;
 	}
 
+	// Call the method
+	(*self).z() = arg0;
+
+	return 0;
+}
+
+/// Wrap method Vec4::setZ.
+static int wrapVec4setZ(lua_State* l)
+{
+	int res = pwrapVec4setZ(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2324,40 +3585,60 @@ static int wrapVec4Ctor(lua_State* l)
 	return 0;
 }
 
-/// Wrap destructor for Vec4.
-static int wrapVec4Dtor(lua_State* l)
+/// Pre-wrap method Vec4::setW.
+static inline int pwrapVec4setW(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
 	{
 		return -1;
 	}
 
-	if(ud->isGarbageCollected())
+	Vec4* self = ud->getData<Vec4>();
+
+	// Pop arguments
+	F32 arg0;
+	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
 	{
-		Vec4* inst = ud->getData<Vec4>();
-		inst->~Vec4();
+		return -1;
 	}
 
+	// Call the method
+	(*self).w() = arg0;
+
 	return 0;
 }
 
-/// Pre-wrap method Vec4::getX.
-static inline int pwrapVec4getX(lua_State* l)
+/// Wrap method Vec4::setW.
+static int wrapVec4setW(lua_State* l)
+{
+	int res = pwrapVec4setW(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec4::setAll.
+static inline int pwrapVec4setAll(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 5)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -2370,19 +3651,41 @@ static inline int pwrapVec4getX(lua_State* l)
 
 	Vec4* self = ud->getData<Vec4>();
 
-	// Call the method
-	F32 ret = (*self).x();
+	// Pop arguments
+	F32 arg0;
+	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	{
+		return -1;
+	}
 
-	// Push return value
-	lua_pushnumber(l, lua_Number(ret));
+	F32 arg1;
+	if(LuaBinder::checkNumber(l, 3, arg1)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	F32 arg2;
+	if(LuaBinder::checkNumber(l, 4, arg2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	F32 arg3;
+	if(LuaBinder::checkNumber(l, 5, arg3)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Call the method
+	(*self) = Vec4(arg0, arg1, arg2, arg3);
 
-	return 1;
+	return 0;
 }
 
-/// Wrap method Vec4::getX.
-static int wrapVec4getX(lua_State* l)
+/// Wrap method Vec4::setAll.
+static int wrapVec4setAll(lua_State* l)
 {
-	int res = pwrapVec4getX(l);
+	int res = pwrapVec4setAll(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2392,14 +3695,14 @@ static int wrapVec4getX(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::getY.
-static inline int pwrapVec4getY(lua_State* l)
+/// Pre-wrap method Vec4::getAt.
+static inline int pwrapVec4getAt(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -2412,8 +3715,15 @@ static inline int pwrapVec4getY(lua_State* l)
 
 	Vec4* self = ud->getData<Vec4>();
 
+	// Pop arguments
+	U arg0;
+	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	{
+		return -1;
+	}
+
 	// Call the method
-	F32 ret = (*self).y();
+	F32 ret = (*self)[arg0];
 
 	// Push return value
 	lua_pushnumber(l, lua_Number(ret));
@@ -2421,10 +3731,10 @@ static inline int pwrapVec4getY(lua_State* l)
 	return 1;
 }
 
-/// Wrap method Vec4::getY.
-static int wrapVec4getY(lua_State* l)
+/// Wrap method Vec4::getAt.
+static int wrapVec4getAt(lua_State* l)
 {
-	int res = pwrapVec4getY(l);
+	int res = pwrapVec4getAt(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2434,14 +3744,14 @@ static int wrapVec4getY(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::getZ.
-static inline int pwrapVec4getZ(lua_State* l)
+/// Pre-wrap method Vec4::setAt.
+static inline int pwrapVec4setAt(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -2454,19 +3764,29 @@ static inline int pwrapVec4getZ(lua_State* l)
 
 	Vec4* self = ud->getData<Vec4>();
 
-	// Call the method
-	F32 ret = (*self).z();
+	// Pop arguments
+	U arg0;
+	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	{
+		return -1;
+	}
 
-	// Push return value
-	lua_pushnumber(l, lua_Number(ret));
+	F32 arg1;
+	if(LuaBinder::checkNumber(l, 3, arg1)) [[unlikely]]
+	{
+		return -1;
+	}
 
-	return 1;
+	// Call the method
+	(*self)[arg0] = arg1;
+
+	return 0;
 }
 
-/// Wrap method Vec4::getZ.
-static int wrapVec4getZ(lua_State* l)
+/// Wrap method Vec4::setAt.
+static int wrapVec4setAt(lua_State* l)
 {
-	int res = pwrapVec4getZ(l);
+	int res = pwrapVec4setAt(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2476,14 +3796,14 @@ static int wrapVec4getZ(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::getW.
-static inline int pwrapVec4getW(lua_State* l)
+/// Pre-wrap method Vec4::operator=.
+static inline int pwrapVec4copy(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 1)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -2496,19 +3816,26 @@ static inline int pwrapVec4getW(lua_State* l)
 
 	Vec4* self = ud->getData<Vec4>();
 
-	// Call the method
-	F32 ret = (*self).w();
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
+	{
+		return -1;
+	}
 
-	// Push return value
-	lua_pushnumber(l, lua_Number(ret));
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
 
-	return 1;
+	// Call the method
+	self->operator=(arg0);
+
+	return 0;
 }
 
-/// Wrap method Vec4::getW.
-static int wrapVec4getW(lua_State* l)
+/// Wrap method Vec4::operator=.
+static int wrapVec4copy(lua_State* l)
 {
-	int res = pwrapVec4getW(l);
+	int res = pwrapVec4copy(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2518,8 +3845,8 @@ static int wrapVec4getW(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::setX.
-static inline int pwrapVec4setX(lua_State* l)
+/// Pre-wrap method Vec4::operator+.
+static inline int pwrapVec4__add(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -2539,22 +3866,30 @@ static inline int pwrapVec4setX(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	F32 arg0;
-	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
+
 	// Call the method
-	(*self).x() = arg0;
+	Vec4 ret = self->operator+(arg0);
 
-	return 0;
+	// Push return value
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec4);
+	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
+
+	return 1;
 }
 
-/// Wrap method Vec4::setX.
-static int wrapVec4setX(lua_State* l)
+/// Wrap method Vec4::operator+.
+static int wrapVec4__add(lua_State* l)
 {
-	int res = pwrapVec4setX(l);
+	int res = pwrapVec4__add(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2564,8 +3899,8 @@ static int wrapVec4setX(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::setY.
-static inline int pwrapVec4setY(lua_State* l)
+/// Pre-wrap method Vec4::operator+ that writes the result to self.
+static inline int pwrapVec4addAssign(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -2585,22 +3920,27 @@ static inline int pwrapVec4setY(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	F32 arg0;
-	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
+
 	// Call the method
-	(*self).y() = arg0;
+	*self = self->operator+(arg0);
 
-	return 0;
+	// Push self, no allocation
+	lua_pushvalue(l, 1);
+	return 1;
 }
 
-/// Wrap method Vec4::setY.
-static int wrapVec4setY(lua_State* l)
+/// Wrap method Vec4::operator+.
+static int wrapVec4addAssign(lua_State* l)
 {
-	int res = pwrapVec4setY(l);
+	int res = pwrapVec4addAssign(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2610,14 +3950,14 @@ static int wrapVec4setY(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::setZ.
-static inline int pwrapVec4setZ(lua_State* l)
+/// Pre-wrap method Vec4::operator+ that writes the result to the last argument.
+static inline int pwrapVec4addTo(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -2631,22 +3971,36 @@ static inline int pwrapVec4setZ(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	F32 arg0;
-	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
+
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
+	Vec4* out = ud->getData<Vec4>();
+
 	// Call the method
-	(*self).z() = arg0;
+	*out = self->operator+(arg0);
 
-	return 0;
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 3);
+	return 1;
 }
 
-/// Wrap method Vec4::setZ.
-static int wrapVec4setZ(lua_State* l)
+/// Wrap method Vec4::operator+.
+static int wrapVec4addTo(lua_State* l)
 {
-	int res = pwrapVec4setZ(l);
+	int res = pwrapVec4addTo(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2656,8 +4010,8 @@ static int wrapVec4setZ(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::setW.
-static inline int pwrapVec4setW(lua_State* l)
+/// Pre-wrap method Vec4::operator-.
+static inline int pwrapVec4__sub(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -2677,22 +4031,30 @@ static inline int pwrapVec4setW(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	F32 arg0;
-	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
+
 	// Call the method
-	(*self).w() = arg0;
+	Vec4 ret = self->operator-(arg0);
 
-	return 0;
+	// Push return value
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec4);
+	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
+
+	return 1;
 }
 
-/// Wrap method Vec4::setW.
-static int wrapVec4setW(lua_State* l)
+/// Wrap method Vec4::operator-.
+static int wrapVec4__sub(lua_State* l)
 {
-	int res = pwrapVec4setW(l);
+	int res = pwrapVec4__sub(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2702,14 +4064,14 @@ static int wrapVec4setW(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::setAll.
-static inline int pwrapVec4setAll(lua_State* l)
+/// Pre-wrap method Vec4::operator- that writes the result to self.
+static inline int pwrapVec4subAssign(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 5)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -2723,40 +4085,27 @@ static inline int pwrapVec4setAll(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	F32 arg0;
-	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
-	{
-		return -1;
-	}
-
-	F32 arg1;
-	if(LuaBinder::checkNumber(l, 3, arg1)) [[unlikely]]
-	{
-		return -1;
-	}
-
-	F32 arg2;
-	if(LuaBinder::checkNumber(l, 4, arg2)) [[unlikely]]
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	F32 arg3;
-	if(LuaBinder::checkNumber(l, 5, arg3)) [[unlikely]]
-	{
-		return -1;
-	}
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
 
 	// Call the method
-	(*self) = Vec4(arg0, arg1, arg2, arg3);
+	*self = self->operator-(arg0);
 
-	return 0;
+	// Push self, no allocation
+	lua_pushvalue(l, 1);
+	return 1;
 }
 
-/// Wrap method Vec4::setAll.
-static int wrapVec4setAll(lua_State* l)
+/// Wrap method Vec4::operator-.
+static int wrapVec4subAssign(lua_State* l)
 {
-	int res = pwrapVec4setAll(l);
+	int res = pwrapVec4subAssign(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2766,14 +4115,14 @@ static int wrapVec4setAll(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::getAt.
-static inline int pwrapVec4getAt(lua_State* l)
+/// Pre-wrap method Vec4::operator- that writes the result to the last argument.
+static inline int pwrapVec4subTo(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -2787,25 +4136,36 @@ static inline int pwrapVec4getAt(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	U arg0;
-	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	// Call the method
-	F32 ret = (*self)[arg0];
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
 
-	// Push return value
-	lua_pushnumber(l, lua_Number(ret));
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec4* out = ud->getData<Vec4>();
+
+	// Call the method
+	*out = self->operator-(arg0);
 
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 3);
 	return 1;
 }
 
-/// Wrap method Vec4::getAt.
-static int wrapVec4getAt(lua_State* l)
+/// Wrap method Vec4::operator-.
+static int wrapVec4subTo(lua_State* l)
 {
-	int res = pwrapVec4getAt(l);
+	int res = pwrapVec4subTo(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2815,14 +4175,14 @@ static int wrapVec4getAt(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::setAt.
-static inline int pwrapVec4setAt(lua_State* l)
+/// Pre-wrap method Vec4::operator*.
+static inline int pwrapVec4__mul(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -2836,28 +4196,30 @@ static inline int pwrapVec4setAt(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	U arg0;
-	if(LuaBinder::checkNumber(l, 2, arg0)) [[unlikely]]
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
 	{
 		return -1;
 	}
 
-	F32 arg1;
-	if(LuaBinder::checkNumber(l, 3, arg1)) [[unlikely]]
-	{
-		return -1;
-	}
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
 
 	// Call the method
-	(*self)[arg0] = arg1;
+	Vec4 ret = self->operator*(arg0);
 
-	return 0;
+	// Push return value
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec4);
+	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
+
+	return 1;
 }
 
-/// Wrap method Vec4::setAt.
-static int wrapVec4setAt(lua_State* l)
+/// Wrap method Vec4::operator*.
+static int wrapVec4__mul(lua_State* l)
 {
-	int res = pwrapVec4setAt(l);
+	int res = pwrapVec4__mul(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2867,8 +4229,8 @@ static int wrapVec4setAt(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::operator=.
-static inline int pwrapVec4copy(lua_State* l)
+/// Pre-wrap method Vec4::operator* that writes the result to self.
+static inline int pwrapVec4mulAssign(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -2898,15 +4260,17 @@ static inline int pwrapVec4copy(lua_State* l)
 	const Vec4& arg0(*iarg0);
 
 	// Call the method
-	self->operator=(arg0);
+	*self = self->operator*(arg0);
 
-	return 0;
+	// Push self, no allocation
+	lua_pushvalue(l, 1);
+	return 1;
 }
 
-/// Wrap method Vec4::operator=.
-static int wrapVec4copy(lua_State* l)
+/// Wrap method Vec4::operator*.
+static int wrapVec4mulAssign(lua_State* l)
 {
-	int res = pwrapVec4copy(l);
+	int res = pwrapVec4mulAssign(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2916,14 +4280,14 @@ static int wrapVec4copy(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::operator+.
-static inline int pwrapVec4__add(lua_State* l)
+/// Pre-wrap method Vec4::operator* that writes the result to the last argument.
+static inline int pwrapVec4mulTo(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -2946,25 +4310,27 @@ static inline int pwrapVec4__add(lua_State* l)
 	Vec4* iarg0 = ud->getData<Vec4>();
 	const Vec4& arg0(*iarg0);
 
-	// Call the method
-	Vec4 ret = self->operator+(arg0);
-
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec4");
-	ud = static_cast<LuaUserData*>(voidp);
+	// Get the output argument
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
-	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
+	if(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec4* out = ud->getData<Vec4>();
+
+	// Call the method
+	*out = self->operator*(arg0);
 
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 3);
 	return 1;
 }
 
-/// Wrap method Vec4::operator+.
-static int wrapVec4__add(lua_State* l)
+/// Wrap method Vec4::operator*.
+static int wrapVec4mulTo(lua_State* l)
 {
-	int res = pwrapVec4__add(l);
+	int res = pwrapVec4mulTo(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2974,8 +4340,8 @@ static int wrapVec4__add(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::operator-.
-static inline int pwrapVec4__sub(lua_State* l)
+/// Pre-wrap method Vec4::operator/.
+static inline int pwrapVec4__div(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -3005,24 +4371,20 @@ static inline int pwrapVec4__sub(lua_State* l)
 	const Vec4& arg0(*iarg0);
 
 	// Call the method
-	Vec4 ret = self->operator-(arg0);
+	Vec4 ret = self->operator/(arg0);
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec4");
-	ud = static_cast<LuaUserData*>(voidp);
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec4);
 	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
 
 	return 1;
 }
 
-/// Wrap method Vec4::operator-.
-static int wrapVec4__sub(lua_State* l)
+/// Wrap method Vec4::operator/.
+static int wrapVec4__div(lua_State* l)
 {
-	int res = pwrapVec4__sub(l);
+	int res = pwrapVec4__div(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3032,8 +4394,8 @@ static int wrapVec4__sub(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::operator*.
-static inline int pwrapVec4__mul(lua_State* l)
+/// Pre-wrap method Vec4::operator/ that writes the result to self.
+static inline int pwrapVec4divAssign(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
@@ -3063,24 +4425,17 @@ static inline int pwrapVec4__mul(lua_State* l)
 	const Vec4& arg0(*iarg0);
 
 	// Call the method
-	Vec4 ret = self->operator*(arg0);
-
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec4");
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
-	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
+	*self = self->operator/(arg0);
 
+	// Push self, no allocation
+	lua_pushvalue(l, 1);
 	return 1;
 }
 
-/// Wrap method Vec4::operator*.
-static int wrapVec4__mul(lua_State* l)
+/// Wrap method Vec4::operator/.
+static int wrapVec4divAssign(lua_State* l)
 {
-	int res = pwrapVec4__mul(l);
+	int res = pwrapVec4divAssign(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3090,14 +4445,14 @@ static int wrapVec4__mul(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::operator/.
-static inline int pwrapVec4__div(lua_State* l)
+/// Pre-wrap method Vec4::operator/ that writes the result to the last argument.
+static inline int pwrapVec4divTo(lua_State* l)
 {
 	[[maybe_unused]] LuaUserData* ud;
 	[[maybe_unused]] void* voidp;
 	[[maybe_unused]] PtrSize size;
 
-	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	if(LuaBinder::checkArgsCount(l, 3)) [[unlikely]]
 	{
 		return -1;
 	}
@@ -3120,25 +4475,27 @@ static inline int pwrapVec4__div(lua_State* l)
 	Vec4* iarg0 = ud->getData<Vec4>();
 	const Vec4& arg0(*iarg0);
 
-	// Call the method
-	Vec4 ret = self->operator/(arg0);
-
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec4");
-	ud = static_cast<LuaUserData*>(voidp);
+	// Get the output argument
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
-	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
+	if(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec4* out = ud->getData<Vec4>();
+
+	// Call the method
+	*out = self->operator/(arg0);
 
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 3);
 	return 1;
 }
 
 /// Wrap method Vec4::operator/.
-static int wrapVec4__div(lua_State* l)
+static int wrapVec4divTo(lua_State* l)
 {
-	int res = pwrapVec4__div(l);
+	int res = pwrapVec4divTo(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3266,12 +4623,8 @@ static inline int pwrapVec4getNormalized(lua_State* l)
 	Vec4 ret = self->getNormalized();
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec4");
-	ud = static_cast<LuaUserData*>(voidp);
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec4);
 	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
 
 	return 1;
@@ -3290,6 +4643,56 @@ static int wrapVec4getNormalized(lua_State* l)
 	return 0;
 }
 
+/// Pre-wrap method Vec4::getNormalized that writes the result to the last argument.
+static inline int pwrapVec4getNormalizedTo(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
+	{
+		return -1;
+	}
+
+	Vec4* self = ud->getData<Vec4>();
+
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec4* out = ud->getData<Vec4>();
+
+	// Call the method
+	*out = self->getNormalized();
+
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 2);
+	return 1;
+}
+
+/// Wrap method Vec4::getNormalized.
+static int wrapVec4getNormalizedTo(lua_State* l)
+{
+	int res = pwrapVec4getNormalizedTo(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
 /// Pre-wrap method Vec4::normalize.
 static inline int pwrapVec4normalize(lua_State* l)
 {
@@ -3400,18 +4803,28 @@ static inline void wrapVec4(lua_State* l)
 	LuaBinder::pushLuaCFuncMethod(l, "setAt", wrapVec4setAt);
 	LuaBinder::pushLuaCFuncMethod(l, "copy", wrapVec4copy);
 	LuaBinder::pushLuaCFuncMethod(l, "__add", wrapVec4__add);
+	LuaBinder::pushLuaCFuncMethod(l, "addAssign", wrapVec4addAssign);
+	LuaBinder::pushLuaCFuncMethod(l, "addTo", wrapVec4addTo);
 	LuaBinder::pushLuaCFuncMethod(l, "__sub", wrapVec4__sub);
+	LuaBinder::pushLuaCFuncMethod(l, "subAssign", wrapVec4subAssign);
+	LuaBinder::pushLuaCFuncMethod(l, "subTo", wrapVec4subTo);
 	LuaBinder::pushLuaCFuncMethod(l, "__mul", wrapVec4__mul);
+	LuaBinder::pushLuaCFuncMethod(l, "mulAssign", wrapVec4mulAssign);
+	LuaBinder::pushLuaCFuncMethod(l, "mulTo", wrapVec4mulTo);
 	LuaBinder::pushLuaCFuncMethod(l, "__div", wrapVec4__div);
+	LuaBinder::pushLuaCFuncMethod(l, "divAssign", wrapVec4divAssign);
+	LuaBinder::pushLuaCFuncMethod(l, "divTo", wrapVec4divTo);
 	LuaBinder::pushLuaCFuncMethod(l, "__eq", wrapVec4__eq);
 	LuaBinder::pushLuaCFuncMethod(l, "getLength", wrapVec4getLength);
 	LuaBinder::pushLuaCFuncMethod(l, "getNormalized", wrapVec4getNormalized);
+	LuaBinder::pushLuaCFuncMethod(l, "getNormalizedTo", wrapVec4getNormalizedTo);
 	LuaBinder::pushLuaCFuncMethod(l, "normalize", wrapVec4normalize);
 	LuaBinder::pushLuaCFuncMethod(l, "dot", wrapVec4dot);
 	lua_settop(l, 0);
 }
 
-LuaUserDataTypeInfo luaUserDataTypeInfoMat3 = {-8522796721639548452, "Mat3", LuaUserData::computeSizeForGarbageCollected<Mat3>(), nullptr, nullptr};
+LuaUserDataTypeInfo luaUserDataTypeInfoMat3 = {
+	-8522796721639548452, "Mat3", LuaUserData::computeSizeForGarbageCollected<Mat3>(), nullptr, nullptr, true};
 
 template<>
 const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<Mat3>()
@@ -3432,12 +4845,7 @@ static inline int pwrapMat3Ctor0(lua_State* l)
 	}
 
 	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Mat3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoMat3.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoMat3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoMat3);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoMat3);
 	::new(ud->getData<Mat3>()) Mat3();
 
 	return 1;
@@ -3463,12 +4871,7 @@ static inline int pwrapMat3Ctor1(lua_State* l)
 	}
 
 	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Mat3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoMat3.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoMat3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoMat3);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoMat3);
 	::new(ud->getData<Mat3>()) Mat3(arg0);
 
 	return 1;
@@ -3523,6 +4926,7 @@ static int wrapMat3Dtor(lua_State* l)
 	{
 		Mat3* inst = ud->getData<Mat3>();
 		inst->~Mat3();
+		LuaBinder::recycleGarbageCollectedUserData(l, 1);
 	}
 
 	return 0;
@@ -3797,8 +5201,8 @@ static inline void wrapMat3(lua_State* l)
 	lua_settop(l, 0);
 }
 
-LuaUserDataTypeInfo luaUserDataTypeInfoMat3x4 = {6107000574328002637, "Mat3x4", LuaUserData::computeSizeForGarbageCollected<Mat3x4>(), nullptr,
-												 nullptr};
+LuaUserDataTypeInfo luaUserDataTypeInfoMat3x4 = {
+	6107000574328002637, "Mat3x4", LuaUserData::computeSizeForGarbageCollected<Mat3x4>(), nullptr, nullptr, true};
 
 template<>
 const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<Mat3x4>()
@@ -3819,12 +5223,7 @@ static inline int pwrapMat3x4Ctor0(lua_State* l)
 	}
 
 	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Mat3x4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoMat3x4.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoMat3x4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoMat3x4);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoMat3x4);
 	::new(ud->getData<Mat3x4>()) Mat3x4();
 
 	return 1;
@@ -3850,12 +5249,7 @@ static inline int pwrapMat3x4Ctor1(lua_State* l)
 	}
 
 	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Mat3x4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoMat3x4.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoMat3x4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoMat3x4);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoMat3x4);
 	::new(ud->getData<Mat3x4>()) Mat3x4(arg0);
 
 	return 1;
@@ -3910,6 +5304,7 @@ static int wrapMat3x4Dtor(lua_State* l)
 	{
 		Mat3x4* inst = ud->getData<Mat3x4>();
 		inst->~Mat3x4();
+		LuaBinder::recycleGarbageCollectedUserData(l, 1);
 	}
 
 	return 0;
@@ -4202,8 +5597,8 @@ static inline void wrapMat3x4(lua_State* l)
 	lua_settop(l, 0);
 }
 
-LuaUserDataTypeInfo luaUserDataTypeInfoTransform = {-1440284075251026678, "Transform", LuaUserData::computeSizeForGarbageCollected<Transform>(),
-													nullptr, nullptr};
+LuaUserDataTypeInfo luaUserDataTypeInfoTransform = {
+	-1440284075251026678, "Transform", LuaUserData::computeSizeForGarbageCollected<Transform>(), nullptr, nullptr, true};
 
 template<>
 const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<Transform>()
@@ -4224,12 +5619,7 @@ static inline int pwrapTransformCtor0(lua_State* l)
 	}
 
 	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Transform>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoTransform.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoTransform;
-	ud->initGarbageCollected(&luaUserDataTypeInfoTransform);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoTransform);
 	::new(ud->getData<Transform>()) Transform();
 
 	return 1;
@@ -4276,12 +5666,7 @@ static inline int pwrapTransformCtor1(lua_State* l)
 	Vec4 arg2(*iarg2);
 
 	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Transform>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoTransform.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoTransform;
-	ud->initGarbageCollected(&luaUserDataTypeInfoTransform);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoTransform);
 	::new(ud->getData<Transform>()) Transform(arg0, arg1, arg2);
 
 	return 1;
@@ -4336,6 +5721,7 @@ static int wrapTransformDtor(lua_State* l)
 	{
 		Transform* inst = ud->getData<Transform>();
 		inst->~Transform();
+		LuaBinder::recycleGarbageCollectedUserData(l, 1);
 	}
 
 	return 0;
@@ -4414,12 +5800,8 @@ static inline int pwrapTransformgetOrigin(lua_State* l)
 	Vec4 ret = self->getOrigin();
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec4");
-	ud = static_cast<LuaUserData*>(voidp);
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec4);
 	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
 
 	return 1;
@@ -4438,6 +5820,56 @@ static int wrapTransformgetOrigin(lua_State* l)
 	return 0;
 }
 
+/// Pre-wrap method Transform::getOrigin that writes the result to the last argument.
+static inline int pwrapTransformgetOriginTo(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoTransform, ud))
+	{
+		return -1;
+	}
+
+	Transform* self = ud->getData<Transform>();
+
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec4* out = ud->getData<Vec4>();
+
+	// Call the method
+	*out = self->getOrigin();
+
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 2);
+	return 1;
+}
+
+/// Wrap method Transform::getOrigin.
+static int wrapTransformgetOriginTo(lua_State* l)
+{
+	int res = pwrapTransformgetOriginTo(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
 /// Pre-wrap method Transform::setOrigin.
 static inline int pwrapTransformsetOrigin(lua_State* l)
 {
@@ -4511,12 +5943,8 @@ static inline int pwrapTransformgetRotation(lua_State* l)
 	Mat3x4 ret = self->getRotation();
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Mat3x4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Mat3x4");
-	ud = static_cast<LuaUserData*>(voidp);
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoMat3x4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoMat3x4);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoMat3x4);
 	::new(ud->getData<Mat3x4>()) Mat3x4(std::move(ret));
 
 	return 1;
@@ -4535,6 +5963,56 @@ static int wrapTransformgetRotation(lua_State* l)
 	return 0;
 }
 
+/// Pre-wrap method Transform::getRotation that writes the result to the last argument.
+static inline int pwrapTransformgetRotationTo(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoTransform, ud))
+	{
+		return -1;
+	}
+
+	Transform* self = ud->getData<Transform>();
+
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoMat3x4;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoMat3x4, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Mat3x4* out = ud->getData<Mat3x4>();
+
+	// Call the method
+	*out = self->getRotation();
+
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 2);
+	return 1;
+}
+
+/// Wrap method Transform::getRotation.
+static int wrapTransformgetRotationTo(lua_State* l)
+{
+	int res = pwrapTransformgetRotationTo(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
 /// Pre-wrap method Transform::setRotation.
 static inline int pwrapTransformsetRotation(lua_State* l)
 {
@@ -4608,12 +6086,8 @@ static inline int pwrapTransformgetScale(lua_State* l)
 	Vec4 ret = self->getScale();
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec4");
-	ud = static_cast<LuaUserData*>(voidp);
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec4);
 	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
 
 	return 1;
@@ -4632,6 +6106,56 @@ static int wrapTransformgetScale(lua_State* l)
 	return 0;
 }
 
+/// Pre-wrap method Transform::getScale that writes the result to the last argument.
+static inline int pwrapTransformgetScaleTo(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoTransform, ud))
+	{
+		return -1;
+	}
+
+	Transform* self = ud->getData<Transform>();
+
+	// Get the output argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	Vec4* out = ud->getData<Vec4>();
+
+	// Call the method
+	*out = self->getScale();
+
+	// Push the output argument, no allocation
+	lua_pushvalue(l, 2);
+	return 1;
+}
+
+/// Wrap method Transform::getScale.
+static int wrapTransformgetScaleTo(lua_State* l)
+{
+	int res = pwrapTransformgetScaleTo(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
 /// Pre-wrap method Transform::setScale.
 static inline int pwrapTransformsetScale(lua_State* l)
 {
@@ -4689,10 +6213,13 @@ static inline void wrapTransform(lua_State* l)
 	LuaBinder::pushLuaCFuncMethod(l, "__gc", wrapTransformDtor);
 	LuaBinder::pushLuaCFuncMethod(l, "copy", wrapTransformcopy);
 	LuaBinder::pushLuaCFuncMethod(l, "getOrigin", wrapTransformgetOrigin);
+	LuaBinder::pushLuaCFuncMethod(l, "getOriginTo", wrapTransformgetOriginTo);
 	LuaBinder::pushLuaCFuncMethod(l, "setOrigin", wrapTransformsetOrigin);
 	LuaBinder::pushLuaCFuncMethod(l, "getRotation", wrapTransformgetRotation);
+	LuaBinder::pushLuaCFuncMethod(l, "getRotationTo", wrapTransformgetRotationTo);
 	LuaBinder::pushLuaCFuncMethod(l, "setRotation", wrapTransformsetRotation);
 	LuaBinder::pushLuaCFuncMethod(l, "getScale", wrapTransformgetScale);
+	LuaBinder::pushLuaCFuncMethod(l, "getScaleTo", wrapTransformgetScaleTo);
 	LuaBinder::pushLuaCFuncMethod(l, "setScale", wrapTransformsetScale);
 	lua_settop(l, 0);
 }
@@ -1466,12 +1466,8 @@ static inline int pwrapTriggerComponentgetBodyComponentsEnter(lua_State* l)
 	WeakArrayBodyComponentPtr ret = self->getBodyComponentsEnter();
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<WeakArrayBodyComponentPtr>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "WeakArrayBodyComponentPtr");
-	ud = static_cast<LuaUserData*>(voidp);
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoWeakArrayBodyComponentPtr;
-	ud->initGarbageCollected(&luaUserDataTypeInfoWeakArrayBodyComponentPtr);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoWeakArrayBodyComponentPtr);
 	::new(ud->getData<WeakArrayBodyComponentPtr>()) WeakArrayBodyComponentPtr(std::move(ret));
 
 	return 1;
@@ -1514,12 +1510,8 @@ static inline int pwrapTriggerComponentgetBodyComponentsInside(lua_State* l)
 	WeakArrayBodyComponentPtr ret = self->getBodyComponentsInside();
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<WeakArrayBodyComponentPtr>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "WeakArrayBodyComponentPtr");
-	ud = static_cast<LuaUserData*>(voidp);
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoWeakArrayBodyComponentPtr;
-	ud->initGarbageCollected(&luaUserDataTypeInfoWeakArrayBodyComponentPtr);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoWeakArrayBodyComponentPtr);
 	::new(ud->getData<WeakArrayBodyComponentPtr>()) WeakArrayBodyComponentPtr(std::move(ret));
 
 	return 1;
@@ -1562,12 +1554,8 @@ static inline int pwrapTriggerComponentgetBodyComponentsExit(lua_State* l)
 	WeakArrayBodyComponentPtr ret = self->getBodyComponentsExit();
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<WeakArrayBodyComponentPtr>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "WeakArrayBodyComponentPtr");
-	ud = static_cast<LuaUserData*>(voidp);
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoWeakArrayBodyComponentPtr;
-	ud->initGarbageCollected(&luaUserDataTypeInfoWeakArrayBodyComponentPtr);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoWeakArrayBodyComponentPtr);
 	::new(ud->getData<WeakArrayBodyComponentPtr>()) WeakArrayBodyComponentPtr(std::move(ret));
 
 	return 1;
@@ -2209,12 +2197,8 @@ static inline int pwrapReflectionProbeComponentgetBoxVolumeSize(lua_State* l)
 	Vec3 ret = self->getBoxVolumeSize();
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec3");
-	ud = static_cast<LuaUserData*>(voidp);
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoVec3);
 	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
 
 	return 1;
@@ -4935,6 +4919,61 @@ static int wrapSceneGraphtryFindSceneNode(lua_State* l)
 	return 0;
 }
 
+/// Pre-wrap method SceneGraph::loadSceneBinary.
+static inline int pwrapSceneGraphloadSceneBinary(lua_State* l)
+{
+	[[maybe_unused]] LuaUserData* ud;
+	[[maybe_unused]] void* voidp;
+	[[maybe_unused]] PtrSize size;
+
+	if(LuaBinder::checkArgsCount(l, 2)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneGraph, ud))
+	{
+		return -1;
+	}
+
+	SceneGraph* self = ud->getData<SceneGraph>();
+
+	// Pop arguments
+	const char* arg0;
+	if(LuaBinder::checkString(l, 2, arg0)) [[unlikely]]
+	{
+		return -1;
+	}
+
+	// Call the method
+	Error ret = self->loadSceneBinary(arg0);
+
+	// Push return value
+	if(ret) [[unlikely]]
+	{
+		lua_pushstring(l, "Glue code returned an error");
+		return -1;
+	}
+
+	lua_pushnumber(l, lua_Number(!!ret));
+
+	return 1;
+}
+
+/// Wrap method SceneGraph::loadSceneBinary.
+static int wrapSceneGraphloadSceneBinary(lua_State* l)
+{
+	int res = pwrapSceneGraphloadSceneBinary(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
 /// Wrap class SceneGraph.
 static inline void wrapSceneGraph(lua_State* l)
 {
@@ -4942,6 +4981,7 @@ static inline void wrapSceneGraph(lua_State* l)
 	LuaBinder::pushLuaCFuncMethod(l, "newSceneNode", wrapSceneGraphnewSceneNode);
 	LuaBinder::pushLuaCFuncMethod(l, "setActiveCameraNode", wrapSceneGraphsetActiveCameraNode);
 	LuaBinder::pushLuaCFuncMethod(l, "tryFindSceneNode", wrapSceneGraphtryFindSceneNode);
+	LuaBinder::pushLuaCFuncMethod(l, "loadSceneBinary", wrapSceneGraphloadSceneBinary);
 	lua_settop(l, 0);
 }
 
@@ -4978,12 +5018,8 @@ static inline int pwrapEventgetAssociatedSceneNodes(lua_State* l)
 	WeakArraySceneNodePtr ret = self->getAssociatedSceneNodes();
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<WeakArraySceneNodePtr>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "WeakArraySceneNodePtr");
-	ud = static_cast<LuaUserData*>(voidp);
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoWeakArraySceneNodePtr;
-	ud->initGarbageCollected(&luaUserDataTypeInfoWeakArraySceneNodePtr);
+	ud = LuaBinder::pushNewGarbageCollectedUserData(l, luaUserDataTypeInfoWeakArraySceneNodePtr);
 	::new(ud->getData<WeakArraySceneNodePtr>()) WeakArraySceneNodePtr(std::move(ret));
 
 	return 1;
@@ -29,6 +29,12 @@ public:
 		return LuaBinder::evalString(m_thread.getLuaState(), str);
 	}
 
+	/// Evaluate the bytecode of a ScriptResource. See ScriptResource::getBytecode().
+	Error evalBytecode(ConstWeakArray<U8> bytecode, const CString& chunkName = "bytecode")
+	{
+		return LuaBinder::evalBytecode(m_thread.getLuaState(), bytecode, chunkName);
+	}
+
 	void serializeGlobals(LuaBinderSerializeGlobalsCallback& callback)
 	{
 		LuaBinder::serializeGlobals(m_thread.getLuaState(), callback);
@@ -44,6 +50,11 @@ public:
 		return *m_thread.getLuaState();
 	}
 
+	const LuaMemoryStats& getMemoryStats() const
+	{
+		return m_thread.getMemoryStats();
+	}
+
 private:
 	LuaBinder m_thread;
 };
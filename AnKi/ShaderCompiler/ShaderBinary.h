@@ -107,11 +107,15 @@ public:
 	Array<Char, kMaxShaderBinaryNameLength + 1> m_name;
 	ShaderTypeBit m_shaderTypes = ShaderTypeBit::kNone;
 
+	/// The mutators that affect each shader type. Only used by deferred binaries.
+	Array<U64, U32(ShaderType::kCount)> m_activeMutators = {};
+
 	template<typename TSerializer, typename TClass>
 	static void serializeCommon(TSerializer& s, TClass self)
 	{
 		s.doArray("m_name", offsetof(ShaderBinaryTechnique, m_name), &self.m_name[0], self.m_name.getSize());
 		s.doValue("m_shaderTypes", offsetof(ShaderBinaryTechnique, m_shaderTypes), self.m_shaderTypes);
+		s.doArray("m_activeMutators", offsetof(ShaderBinaryTechnique, m_activeMutators), &self.m_activeMutators[0], self.m_activeMutators.getSize());
 	}
 
 	template<typename TDeserializer>
@@ -216,7 +220,8 @@ public:
 	/// Mutation hash.
 	U64 m_hash = 0;
 
-	/// Points to ShaderBinary::m_variants.
+	/// Points to ShaderBinary::m_variants. It's kMaxU32 if the mutation is skipped. In deferred binaries it's 0 for the mutations that are not
+	/// skipped.
 	U32 m_variantIndex = kMaxU32;
 
 	template<typename TSerializer, typename TClass>
@@ -256,6 +261,16 @@ public:
 	WeakArray<ShaderBinaryTechnique> m_techniques;
 	WeakArray<ShaderBinaryStruct> m_structs;
 
+	/// If not empty the binary is deferred. It has no code blocks and no variants and the variants are compiled at runtime from this null terminated
+	/// source.
+	WeakArray<Char> m_deferredSource;
+
+	/// Extra compiler arguments of deferred binaries. Null terminated strings one after the other.
+	WeakArray<Char> m_deferredCompilerArgs;
+
+	/// Compile the deferred variants with 16bit types.
+	Bool m_16bitTypes = false;
+
 	template<typename TSerializer, typename TClass>
 	static void serializeCommon(TSerializer& s, TClass self)
 	{
@@ -267,6 +282,9 @@ public:
 		s.doValue("m_variants", offsetof(ShaderBinary, m_variants), self.m_variants);
 		s.doValue("m_techniques", offsetof(ShaderBinary, m_techniques), self.m_techniques);
 		s.doValue("m_structs", offsetof(ShaderBinary, m_structs), self.m_structs);
+		s.doValue("m_deferredSource", offsetof(ShaderBinary, m_deferredSource), self.m_deferredSource);
+		s.doValue("m_deferredCompilerArgs", offsetof(ShaderBinary, m_deferredCompilerArgs), self.m_deferredCompilerArgs);
+		s.doValue("m_16bitTypes", offsetof(ShaderBinary, m_16bitTypes), self.m_16bitTypes);
 	}
 
 	template<typename TDeserializer>
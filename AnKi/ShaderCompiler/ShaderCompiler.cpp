@@ -53,6 +53,9 @@ void freeShaderBinary(ShaderBinary*& binary)
 	}
 	mempool.free(binary->m_structs.getBegin());
 
+	mempool.free(binary->m_deferredSource.getBegin());
+	mempool.free(binary->m_deferredCompilerArgs.getBegin());
+
 	mempool.free(binary);
 
 	binary = nullptr;
@@ -94,6 +97,30 @@ static Bool spinDials(ShaderCompilerDynamicArray<U32>& dials, ConstWeakArray<Sha
 	return done;
 }
 
+/// Compile HLSL to IL and reflect it.
+static Error compileSource(CString source, ShaderType shaderType, Bool spirv, Bool debugInfo, Bool compileWith16bitTypes,
+						   ConstWeakArray<CString> compilerArgs, ShaderCompilerDynamicArray<U8>& il, ShaderReflection& refl,
+						   ShaderCompilerString& errorLog)
+{
+	if(spirv)
+	{
+		ANKI_CHECK(compileHlslToSpirv(source, shaderType, compileWith16bitTypes, debugInfo, compilerArgs, il, errorLog));
+		ANKI_CHECK(doReflectionSpirv(il, shaderType, refl, errorLog));
+	}
+	else
+	{
+		ANKI_CHECK(compileHlslToDxil(source, shaderType, compileWith16bitTypes, debugInfo, compilerArgs, il, errorLog));
+#if ANKI_OS_WINDOWS
+		ANKI_CHECK(doReflectionDxil(il, shaderType, refl, errorLog));
+#else
+		ANKI_SHADER_COMPILER_LOGE("Can't generate shader compilation on non-windows platforms");
+		return Error::kFunctionFailed;
+#endif
+	}
+
+	return Error::kNone;
+}
+
 static void compileVariantAsync(const ShaderParser& parser, Bool spirv, Bool debugInfo, ShaderBinaryMutation& mutation,
 								ShaderCompilerDynamicArray<ShaderBinaryVariant>& variants,
 								ShaderCompilerDynamicArray<ShaderBinaryCodeBlock>& codeBlocks, ShaderCompilerDynamicArray<U64>& sourceCodeHashes,
@@ -191,17 +218,9 @@ static void compileVariantAsync(const ShaderParser& parser, Bool spirv, Bool deb
 				}
 
 				ShaderCompilerDynamicArray<U8> il;
-				if(ctx.m_spirv)
-				{
-					err = compileHlslToSpirv(source, shaderType, ctx.m_parser->compileWith16bitTypes(), ctx.m_debugInfo,
-											 ctx.m_parser->getExtraCompilerArgs(), il, compilerErrorLog);
-				}
-				else
-				{
-					err = compileHlslToDxil(source, shaderType, ctx.m_parser->compileWith16bitTypes(), ctx.m_debugInfo,
-											ctx.m_parser->getExtraCompilerArgs(), il, compilerErrorLog);
-				}
-
+				ShaderReflection refl;
+				err = compileSource(source, shaderType, ctx.m_spirv, ctx.m_debugInfo, ctx.m_parser->compileWith16bitTypes(),
+									ctx.m_parser->getExtraCompilerArgs(), il, refl, compilerErrorLog);
 				if(err)
 				{
 					break;
@@ -209,26 +228,6 @@ static void compileVariantAsync(const ShaderParser& parser, Bool spirv, Bool deb
 
 				const U64 newHash = computeHash(il.getBegin(), il.getSizeInBytes());
 
-				ShaderReflection refl;
-				if(ctx.m_spirv)
-				{
-					err = doReflectionSpirv(il, shaderType, refl, compilerErrorLog);
-				}
-				else
-				{
-#if ANKI_OS_WINDOWS
-					err = doReflectionDxil(il, shaderType, refl, compilerErrorLog);
-#else
-					ANKI_SHADER_COMPILER_LOGE("Can't generate shader compilation on non-windows platforms");
-					err = Error::kFunctionFailed;
-#endif
-				}
-
-				if(err)
-				{
-					break;
-				}
-
 				// Add the binary if not already there
 				{
 					LockGuard lock(*ctx.m_mtx);
@@ -323,9 +322,73 @@ static void compileVariantAsync(const ShaderParser& parser, Bool spirv, Bool deb
 	taskManager.enqueueTask(callback, ctx);
 }
 
+/// Store the mutations and the source in the binary. The variants will be compiled at runtime.
+static void createDeferredBinary(const ShaderParser& parser, U32 mutationCount, ShaderBinary& binary)
+{
+	ShaderCompilerMemoryPool& memPool = ShaderCompilerMemoryPool::getSingleton();
+
+	if(parser.getMutators().getSize() > 0)
+	{
+		ShaderCompilerDynamicArray<MutatorValue> mutationValues;
+		mutationValues.resize(parser.getMutators().getSize());
+		ShaderCompilerDynamicArray<U32> dials;
+		dials.resize(parser.getMutators().getSize(), 0);
+
+		newArray(memPool, mutationCount, binary.m_mutations);
+		U32 count = 0;
+		do
+		{
+			for(U32 i = 0; i < parser.getMutators().getSize(); ++i)
+			{
+				mutationValues[i] = parser.getMutators()[i].m_values[dials[i]];
+			}
+
+			ShaderBinaryMutation& mutation = binary.m_mutations[count++];
+			newArray(memPool, mutationValues.getSize(), mutation.m_values);
+			memcpy(mutation.m_values.getBegin(), mutationValues.getBegin(), mutationValues.getSizeInBytes());
+
+			mutation.m_hash = computeHash(mutationValues.getBegin(), mutationValues.getSizeInBytes());
+			mutation.m_variantIndex = (parser.skipMutation(mutationValues)) ? kMaxU32 : 0;
+		} while(!spinDials(dials, parser.getMutators()));
+
+		ANKI_ASSERT(count == mutationCount);
+	}
+	else
+	{
+		newArray(memPool, 1, binary.m_mutations);
+		binary.m_mutations[0].m_hash = 1;
+		binary.m_mutations[0].m_variantIndex = 0;
+	}
+
+	ShaderCompilerString source;
+	parser.generateCommonSource(source);
+	newArray(memPool, source.getLength() + 1, binary.m_deferredSource);
+	memcpy(binary.m_deferredSource.getBegin(), source.cstr(), source.getLength() + 1);
+
+	PtrSize argsSize = 0;
+	for(CString arg : parser.getExtraCompilerArgs())
+	{
+		argsSize += arg.getLength() + 1;
+	}
+
+	if(argsSize)
+	{
+		newArray(memPool, argsSize, binary.m_deferredCompilerArgs);
+		Char* out = binary.m_deferredCompilerArgs.getBegin();
+		for(CString arg : parser.getExtraCompilerArgs())
+		{
+			memcpy(out, arg.cstr(), arg.getLength() + 1);
+			out += arg.getLength() + 1;
+		}
+	}
+
+	binary.m_16bitTypes = parser.compileWith16bitTypes();
+}
+
 static Error compileShaderProgramInternal(CString fname, Bool spirv, Bool debugInfo, ShaderCompilerFilesystemInterface& fsystem,
 										  ShaderCompilerPostParseInterface* postParseCallback, ShaderCompilerAsyncTaskInterface* taskManager_,
-										  ConstWeakArray<ShaderCompilerDefine> defines_, ShaderBinary*& binary)
+										  ConstWeakArray<ShaderCompilerDefine> defines_, ShaderBinary*& binary, ShaderParserFileCache* fileCache,
+										  Bool deferVariants)
 {
 	ShaderCompilerMemoryPool& memPool = ShaderCompilerMemoryPool::getSingleton();
 
@@ -340,7 +403,7 @@ static Error compileShaderProgramInternal(CString fname, Bool spirv, Bool debugI
 	memcpy(&binary->m_magic[0], kShaderBinaryMagic, 8);
 
 	// Parse source
-	ShaderParser parser(fname, &fsystem, defines);
+	ShaderParser parser(fname, &fsystem, defines, fileCache);
 	ANKI_CHECK(parser.parse());
 
 	if(postParseCallback && postParseCallback->skipCompilation(parser.getHash()))
@@ -375,6 +438,20 @@ static Error compileShaderProgramInternal(CString fname, Bool spirv, Bool debugI
 		ANKI_ASSERT(binary->m_mutators.getSize() == 0);
 	}
 
+	// Ray tracing programs are gathered into libraries when the engine starts so their variants can't be deferred
+	if(deferVariants)
+	{
+		for(const ShaderParserTechnique& technique : parser.getTechniques())
+		{
+			if(!!(technique.m_shaderTypes & ShaderTypeBit::kAllRayTracing))
+			{
+				ANKI_SHADER_COMPILER_LOGV("Program has ray tracing shaders, will compile all variants: %s", fname.cstr());
+				deferVariants = false;
+				break;
+			}
+		}
+	}
+
 	// Create all variants
 	Mutex mtx;
 	Atomic<I32> errorAtomic(0);
@@ -394,7 +471,11 @@ static Error compileShaderProgramInternal(CString fname, Bool spirv, Bool debugI
 	} syncTaskManager;
 	ShaderCompilerAsyncTaskInterface& taskManager = (taskManager_) ? *taskManager_ : syncTaskManager;
 
-	if(parser.getMutators().getSize() > 0)
+	if(deferVariants)
+	{
+		createDeferredBinary(parser, mutationCount, *binary);
+	}
+	else if(parser.getMutators().getSize() > 0)
 	{
 		// Initialize
 		ShaderCompilerDynamicArray<MutatorValue> mutationValues;
@@ -451,13 +532,13 @@ static Error compileShaderProgramInternal(CString fname, Bool spirv, Bool debugI
 		// Done, wait the threads
 		ANKI_CHECK(taskManager.joinTasks());
 
-		// Now error out
-		ANKI_CHECK(Error(errorAtomic.getNonAtomically()));
-
-		// Store temp containers to binary
+		// Store temp containers to binary. Do that before erroring out so freeShaderBinary() can free them
 		codeBlocks.moveAndReset(binary->m_codeBlocks);
 		mutations.moveAndReset(binary->m_mutations);
 		variants.moveAndReset(binary->m_variants);
+
+		// Now error out
+		ANKI_CHECK(Error(errorAtomic.getNonAtomically()));
 	}
 	else
 	{
@@ -494,6 +575,11 @@ static Error compileShaderProgramInternal(CString fname, Bool spirv, Bool debugI
 
 		binary->m_techniques[i].m_shaderTypes = parser.getTechniques()[i].m_shaderTypes;
 
+		if(deferVariants)
+		{
+			binary->m_techniques[i].m_activeMutators = parser.getTechniques()[i].m_activeMutators;
+		}
+
 		binary->m_shaderTypes |= parser.getTechniques()[i].m_shaderTypes;
 	}
 
@@ -533,9 +619,10 @@ static Error compileShaderProgramInternal(CString fname, Bool spirv, Bool debugI
 
 Error compileShaderProgram(CString fname, Bool spirv, Bool debugInfo, ShaderCompilerFilesystemInterface& fsystem,
 						   ShaderCompilerPostParseInterface* postParseCallback, ShaderCompilerAsyncTaskInterface* taskManager,
-						   ConstWeakArray<ShaderCompilerDefine> defines, ShaderBinary*& binary)
+						   ConstWeakArray<ShaderCompilerDefine> defines, ShaderBinary*& binary, ShaderParserFileCache* fileCache, Bool deferVariants)
 {
-	const Error err = compileShaderProgramInternal(fname, spirv, debugInfo, fsystem, postParseCallback, taskManager, defines, binary);
+	const Error err =
+		compileShaderProgramInternal(fname, spirv, debugInfo, fsystem, postParseCallback, taskManager, defines, binary, fileCache, deferVariants);
 	if(err)
 	{
 		ANKI_SHADER_COMPILER_LOGE("Failed to compile: %s", fname.cstr());
@@ -545,4 +632,60 @@ Error compileShaderProgram(CString fname, Bool spirv, Bool debugInfo, ShaderComp
 	return err;
 }
 
+void generateDeferredShaderSource(const ShaderBinary& binary, ConstWeakArray<MutatorValue> mutation, U32 techniqueIdx, ShaderType shaderType,
+								  ShaderCompilerString& source)
+{
+	ANKI_ASSERT(binary.m_deferredSource.getSize() > 0);
+	ANKI_ASSERT(mutation.getSize() == binary.m_mutators.getSize());
+	const ShaderBinaryTechnique& technique = binary.m_techniques[techniqueIdx];
+	ANKI_ASSERT(!!(technique.m_shaderTypes & ShaderTypeBit(1 << shaderType)));
+
+	// Same as ShaderParser::generateVariant()
+	source.destroy();
+
+	for(U32 i = 0; i < mutation.getSize(); ++i)
+	{
+		if(!!(technique.m_activeMutators[shaderType] & (1_U64 << U64(i))))
+		{
+			source += ShaderCompilerString().sprintf("#define %s %d\n", binary.m_mutators[i].m_name.getBegin(), mutation[i]);
+		}
+	}
+
+	for(U32 i = 0; i < binary.m_techniques.getSize(); ++i)
+	{
+		source += ShaderCompilerString().sprintf("#define ANKI_TECHNIQUE_%s %u\n", binary.m_techniques[i].m_name.getBegin(), U32(techniqueIdx == i));
+	}
+
+	ShaderCompilerString header;
+	ShaderParser::generateAnkiShaderHeader(shaderType, header);
+	source += header;
+
+	source += (binary.m_16bitTypes) ? "#define ANKI_SUPPORTS_16BIT_TYPES 1\n" : "#define ANKI_SUPPORTS_16BIT_TYPES 0\n";
+
+	source += binary.m_deferredSource.getBegin();
+}
+
+Error compileDeferredShader(const ShaderBinary& binary, CString source, ShaderType shaderType, Bool spirv, Bool debugInfo,
+							ShaderCompilerDynamicArray<U8>& il, ShaderReflection& refl)
+{
+	ANKI_ASSERT(binary.m_deferredSource.getSize() > 0);
+
+	ShaderCompilerDynamicArray<CString> compilerArgs;
+	const Char* arg = binary.m_deferredCompilerArgs.getBegin();
+	while(arg < binary.m_deferredCompilerArgs.getEnd())
+	{
+		compilerArgs.emplaceBack(arg);
+		arg += strlen(arg) + 1;
+	}
+
+	ShaderCompilerString errorLog;
+	const Error err = compileSource(source, shaderType, spirv, debugInfo, binary.m_16bitTypes, compilerArgs, il, refl, errorLog);
+	if(err)
+	{
+		ANKI_SHADER_COMPILER_LOGE("Shader compilation failed:\n%s", errorLog.cstr());
+	}
+
+	return err;
+}
+
 } // end namespace anki
@@ -11,11 +11,14 @@
 
 namespace anki {
 
+// Forward
+class ShaderParserFileCache;
+
 /// @addtogroup shader_compiler
 /// @{
 
-inline constexpr const char* kShaderBinaryMagic = "ANKISP1"; // WARNING: If changed change kShaderBinaryVersion
-constexpr U32 kShaderBinaryVersion = 1;
+inline constexpr const char* kShaderBinaryMagic = "ANKISP2"; // WARNING: If changed change kShaderBinaryVersion
+constexpr U32 kShaderBinaryVersion = 2;
 
 template<typename TFile>
 Error deserializeShaderBinaryFromAnyFile(TFile& file, ShaderBinary*& binary, BaseMemoryPool& pool)
@@ -40,9 +43,21 @@ inline Error deserializeShaderBinaryFromFile(CString fname, ShaderBinary*& binar
 }
 
 /// Takes an AnKi special shader program and spits a binary.
+/// @param fileCache Optional cache of the included files. Share it between the programs that are compiled in the same session.
+/// @param deferVariants Don't compile the variants. Store the source in the binary and let the runtime compile the variants it needs. It's
+///                      ignored for programs with ray tracing shaders.
 Error compileShaderProgram(CString fname, Bool spirv, Bool debugInfo, ShaderCompilerFilesystemInterface& fsystem,
 						   ShaderCompilerPostParseInterface* postParseCallback, ShaderCompilerAsyncTaskInterface* taskManager,
-						   ConstWeakArray<ShaderCompilerDefine> defines, ShaderBinary*& binary);
+						   ConstWeakArray<ShaderCompilerDefine> defines, ShaderBinary*& binary, ShaderParserFileCache* fileCache = nullptr,
+						   Bool deferVariants = false);
+
+/// Generate the source of a shader of a deferred binary. See ShaderBinary::m_deferredSource.
+void generateDeferredShaderSource(const ShaderBinary& binary, ConstWeakArray<MutatorValue> mutation, U32 techniqueIdx, ShaderType shaderType,
+								  ShaderCompilerString& source);
+
+/// Compile a source that was generated by generateDeferredShaderSource().
+Error compileDeferredShader(const ShaderBinary& binary, CString source, ShaderType shaderType, Bool spirv, Bool debugInfo,
+							ShaderCompilerDynamicArray<U8>& il, ShaderReflection& refl);
 
 /// Free the binary created ONLY by compileShaderProgram.
 void freeShaderBinary(ShaderBinary*& binary);
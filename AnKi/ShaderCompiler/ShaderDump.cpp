@@ -76,6 +76,11 @@ void dumpShaderBinary(const ShaderDumpOptions& options, const ShaderBinary& bina
 		}
 	}
 
+	if(binary.m_deferredSource.getSize())
+	{
+		lines.pushBackSprintf("\n**DEFERRED SOURCE (%u bytes)**\n", binary.m_deferredSource.getSize() - 1);
+	}
+
 	// Mutators
 	lines.pushBackSprintf("\n**MUTATORS (%u)**\n", binary.m_mutators.getSize());
 	if(binary.m_mutators.getSize() > 0)
@@ -110,7 +115,11 @@ void dumpShaderBinary(const ShaderDumpOptions& options, const ShaderBinary& bina
 	count = 0;
 	for(const ShaderBinaryMutation& mutation : binary.m_mutations)
 	{
-		if(mutation.m_variantIndex != kMaxU32)
+		if(mutation.m_variantIndex != kMaxU32 && binary.m_deferredSource.getSize())
+		{
+			lines.pushBackSprintf(ANKI_TAB "mut%05u variantIndex deferred hash 0x%016" PRIX64 " values (", count++, mutation.m_hash);
+		}
+		else if(mutation.m_variantIndex != kMaxU32)
 		{
 			lines.pushBackSprintf(ANKI_TAB "mut%05u variantIndex var%05u hash 0x%016" PRIX64 " values (", count++, mutation.m_variantIndex,
 								  mutation.m_hash);
@@ -85,45 +85,120 @@ static ShaderType strToShaderType(CString str)
 	return shaderType;
 }
 
-ShaderParser::ShaderParser(CString fname, ShaderCompilerFilesystemInterface* fsystem, ConstWeakArray<ShaderCompilerDefine> defines)
-	: m_fname(fname)
-	, m_fsystem(fsystem)
+Error ShaderParserFile::load(CString filename, ShaderCompilerFilesystemInterface& fsystem)
 {
-	for(const ShaderCompilerDefine& def : defines)
+	m_filename = filename;
+
+	ShaderCompilerString txt;
+	ANKI_CHECK(fsystem.readAllText(filename, txt));
+	m_hash = computeHash(txt.cstr(), txt.getLength());
+
+	ShaderCompilerStringList lines;
+	lines.splitString(txt, '\n', true);
+	if(lines.getSize() < 1)
 	{
-		m_defineNames.emplaceBack(def.m_name);
-		m_defineValues.emplaceBack(def.m_value);
+		ANKI_SHADER_COMPILER_LOGE("Source is empty");
 	}
+
+	m_lines.resize(U32(lines.getSize()));
+	U32 count = 0;
+	for(ShaderCompilerString& text : lines)
+	{
+		Line& line = m_lines[count++];
+
+		// Possibly a preprocessor directive we care. Tokenize it
+		if(!text.isEmpty() && (text.find("pragma") != ShaderCompilerString::kNpos || text.find("include") != ShaderCompilerString::kNpos))
+		{
+			ShaderCompilerString l = text;
+
+			// Replace all tabs with spaces
+			for(char& c : l)
+			{
+				if(c == '\t')
+				{
+					c = ' ';
+				}
+			}
+
+			ShaderCompilerStringList spaceTokens;
+			spaceTokens.splitString(l, ' ', false);
+			for(ShaderCompilerString& token : spaceTokens)
+			{
+				line.m_tokens.emplaceBack(std::move(token));
+			}
+		}
+
+		line.m_text = std::move(text);
+	}
+
+	return Error::kNone;
 }
 
-ShaderParser::~ShaderParser()
+ShaderParserFileCache::~ShaderParserFileCache()
 {
+	for(ShaderParserFile* file : m_files)
+	{
+		deleteInstance(ShaderCompilerMemoryPool::getSingleton(), file);
+	}
 }
 
-void ShaderParser::tokenizeLine(CString line, ShaderCompilerDynamicArray<ShaderCompilerString>& tokens) const
+Error ShaderParserFileCache::getOrLoadFile(CString filename, ShaderCompilerFilesystemInterface& fsystem, const ShaderParserFile*& file)
 {
-	ANKI_ASSERT(line.getLength() > 0);
-
-	ShaderCompilerString l = line;
+	const U64 hash = filename.computeHash();
 
-	// Replace all tabs with spaces
-	for(char& c : l)
+	// Search the cache
 	{
-		if(c == '\t')
+		RLockGuard lock(m_mtx);
+		auto it = m_files.find(hash);
+		if(it != m_files.getEnd())
 		{
-			c = ' ';
+			ANKI_ASSERT((*it)->m_filename == filename);
+			file = *it;
+			return Error::kNone;
 		}
 	}
 
-	// Split
-	ShaderCompilerStringList spaceTokens;
-	spaceTokens.splitString(l, ' ', false);
+	// Not found, load it outside the lock. Many threads might load the same file but only one will make it to the cache
+	m_missCount.fetchAdd(1);
+	ShaderParserFile* newFile = newInstance<ShaderParserFile>(ShaderCompilerMemoryPool::getSingleton());
+	const Error err = newFile->load(filename, fsystem);
+	if(err)
+	{
+		deleteInstance(ShaderCompilerMemoryPool::getSingleton(), newFile);
+		return err;
+	}
 
-	// Create the array
-	for(const ShaderCompilerString& s : spaceTokens)
+	WLockGuard lock(m_mtx);
+	auto it = m_files.find(hash);
+	if(it != m_files.getEnd())
+	{
+		deleteInstance(ShaderCompilerMemoryPool::getSingleton(), newFile);
+		file = *it;
+	}
+	else
 	{
-		tokens.emplaceBack(s);
+		m_files.emplace(hash, newFile);
+		file = newFile;
 	}
+
+	return Error::kNone;
+}
+
+ShaderParser::ShaderParser(CString fname, ShaderCompilerFilesystemInterface* fsystem, ConstWeakArray<ShaderCompilerDefine> defines,
+						   ShaderParserFileCache* fileCache)
+	: m_fname(fname)
+	, m_fsystem(fsystem)
+	, m_fileCache(fileCache)
+{
+	for(const ShaderCompilerDefine& def : defines)
+	{
+		m_defineNames.emplaceBack(def.m_name);
+		m_defineValues.emplaceBack(def.m_value);
+	}
+}
+
+ShaderParser::~ShaderParser()
+{
 }
 
 Error ShaderParser::parsePragmaTechnique(const ShaderCompilerString* begin, const ShaderCompilerString* end, CString line, CString fname)
@@ -413,15 +488,13 @@ Error ShaderParser::parseInclude(const ShaderCompilerString* begin, const Shader
 	return Error::kNone;
 }
 
-Error ShaderParser::parseLine(CString line, CString fname, Bool& foundPragmaOnce, U32 depth, U32 lineNo)
+Error ShaderParser::parseLine(const ShaderParserFile::Line& fileLine, CString fname, Bool& foundPragmaOnce, U32 depth, U32 lineNo)
 {
-	// Tokenize
-	ShaderCompilerDynamicArray<ShaderCompilerString> tokens;
-	tokenizeLine(line, tokens);
-	ANKI_ASSERT(tokens.getSize() > 0);
+	const CString line = fileLine.m_text;
+	ANKI_ASSERT(fileLine.m_tokens.getSize() > 0);
 
-	const ShaderCompilerString* token = tokens.getBegin();
-	const ShaderCompilerString* end = tokens.getEnd();
+	const ShaderCompilerString* token = fileLine.m_tokens.getBegin();
+	const ShaderCompilerString* end = fileLine.m_tokens.getEnd();
 
 	// Skip the hash
 	Bool foundAloneHash = false;
@@ -696,42 +769,45 @@ Error ShaderParser::parseFile(CString fname, U32 depth)
 	if(depth > kMaxIncludeDepth)
 	{
 		ANKI_SHADER_COMPILER_LOGE("The include depth is too high. Probably circular includance");
+		return Error::kUserData;
 	}
 
 	Bool foundPragmaOnce = false;
 
-	// Load file in lines
-	ShaderCompilerString txt;
-	ANKI_CHECK(m_fsystem->readAllText(fname, txt));
-
-	m_hash = (m_hash) ? computeHash(txt.cstr(), txt.getLength()) : appendHash(txt.cstr(), txt.getLength(), m_hash);
-
-	ShaderCompilerStringList lines;
-	lines.splitString(txt, '\n', true);
-	if(lines.getSize() < 1)
+	// Load file in lines. The includes go through the cache
+	ShaderParserFile localFile;
+	const ShaderParserFile* file;
+	if(m_fileCache && depth > 0)
 	{
-		ANKI_SHADER_COMPILER_LOGE("Source is empty");
+		ANKI_CHECK(m_fileCache->getOrLoadFile(fname, *m_fsystem, file));
+	}
+	else
+	{
+		ANKI_CHECK(localFile.load(fname, *m_fsystem));
+		file = &localFile;
 	}
 
+	m_hash = (m_hash) ? appendHash(&file->m_hash, sizeof(file->m_hash), m_hash) : file->m_hash;
+
 	m_sourceLines.pushBackSprintf("#line 0 \"%s\"", sanitizeFilename(fname).cstr());
 
 	// Parse lines
 	U32 lineNo = 1;
-	for(const ShaderCompilerString& line : lines)
+	for(const ShaderParserFile::Line& line : file->m_lines)
 	{
-		if(line.isEmpty())
+		if(line.m_text.isEmpty())
 		{
 			m_sourceLines.pushBack(" ");
 		}
-		else if(line.find("pragma") != ShaderCompilerString::kNpos || line.find("include") != ShaderCompilerString::kNpos)
+		else if(line.m_tokens.getSize())
 		{
 			// Possibly a preprocessor directive we care
-			ANKI_CHECK(parseLine(line.toCString(), fname, foundPragmaOnce, depth, lineNo));
+			ANKI_CHECK(parseLine(line, fname, foundPragmaOnce, depth, lineNo));
 		}
 		else
 		{
 			// Just append the line
-			m_sourceLines.pushBack(line.toCString());
+			m_sourceLines.pushBack(line.m_text.toCString());
 		}
 
 		++lineNo;
@@ -848,6 +924,18 @@ void ShaderParser::generateVariant(ConstWeakArray<MutatorValue> mutation, const
 	source += m_source;
 }
 
+void ShaderParser::generateCommonSource(ShaderCompilerString& source) const
+{
+	source.destroy();
+
+	for(U32 i = 0; i < m_defineNames.getSize(); ++i)
+	{
+		source += ShaderCompilerString().sprintf("#define %s %d\n", m_defineNames[i].cstr(), m_defineValues[i]);
+	}
+
+	source += m_source;
+}
+
 Bool ShaderParser::mutatorHasValue(const ShaderParserMutator& mutator, MutatorValue value)
 {
 	for(MutatorValue v : mutator.m_values)
@@ -9,6 +9,8 @@
 #include <AnKi/Util/StringList.h>
 #include <AnKi/Util/WeakArray.h>
 #include <AnKi/Util/DynamicArray.h>
+#include <AnKi/Util/Thread.h>
+#include <AnKi/Util/HashMap.h>
 
 namespace anki {
 
@@ -52,6 +54,62 @@ public:
 	Array<U64, U32(ShaderType::kCount)> m_activeMutators = {};
 };
 
+/// A source file split into lines. The lines that might contain a directive the ShaderParser cares about (includes and pragmas) are
+/// pre-tokenized.
+/// @memberof ShaderParser
+class ShaderParserFile
+{
+public:
+	class Line
+	{
+	public:
+		ShaderCompilerString m_text;
+		ShaderCompilerDynamicArray<ShaderCompilerString> m_tokens; ///< Empty if the line is not a directive.
+	};
+
+	ShaderCompilerString m_filename;
+	ShaderCompilerDynamicArray<Line> m_lines;
+	U64 m_hash = 0; ///< The hash of the contents.
+
+	/// Read a file and split it.
+	Error load(CString filename, ShaderCompilerFilesystemInterface& fsystem);
+};
+
+/// A cache of the files that the ShaderParser includes. It's thread-safe and it can be shared between ShaderParsers that run in parallel
+/// as long as their ShaderCompilerFilesystemInterfaces resolve the includes the same way. The files are read once and they are never
+/// invalidated.
+class ShaderParserFileCache
+{
+public:
+	ShaderParserFileCache() = default;
+
+	ShaderParserFileCache(const ShaderParserFileCache&) = delete; // Non-copyable
+
+	~ShaderParserFileCache();
+
+	ShaderParserFileCache& operator=(const ShaderParserFileCache&) = delete; // Non-copyable
+
+	/// Get a file from the cache or load it. It's thread-safe.
+	Error getOrLoadFile(CString filename, ShaderCompilerFilesystemInterface& fsystem, const ShaderParserFile*& file);
+
+	U32 getFileCount() const
+	{
+		RLockGuard lock(m_mtx);
+		return U32(m_files.getSize());
+	}
+
+	/// The number of requests that didn't hit the cache.
+	U32 getMissCount() const
+	{
+		return m_missCount.load();
+	}
+
+private:
+	ShaderCompilerHashMap<U64, ShaderParserFile*> m_files;
+	mutable RWMutex m_mtx;
+	Atomic<U32> m_missCount = {0};
+};
+
 /// This is a special preprocessor that run before the usual preprocessor. Its purpose is to add some meta information
 /// in the shader programs.
 ///
@@ -73,7 +131,9 @@ public:
 class ShaderParser
 {
 public:
-	ShaderParser(CString fname, ShaderCompilerFilesystemInterface* fsystem, ConstWeakArray<ShaderCompilerDefine> defines);
+	/// @param fileCache Optional cache for the included files.
+	ShaderParser(CString fname, ShaderCompilerFilesystemInterface* fsystem, ConstWeakArray<ShaderCompilerDefine> defines,
+				 ShaderParserFileCache* fileCache = nullptr);
 
 	ShaderParser(const ShaderParser&) = delete; // Non-copyable
 
@@ -91,6 +151,9 @@ public:
 	void generateVariant(ConstWeakArray<MutatorValue> mutation, const ShaderParserTechnique& technique, ShaderType shaderType,
 						 ShaderCompilerString& source) const;
 
+	/// Get the part of the source that is common to all variants. It's the source without the mutator, technique and shader type defines.
+	void generateCommonSource(ShaderCompilerString& source) const;
+
 	ConstWeakArray<ShaderParserMutator> getMutators() const
 	{
 		return m_mutators;
@@ -141,6 +204,7 @@ private:
 
 	ShaderCompilerString m_fname;
 	ShaderCompilerFilesystemInterface* m_fsystem = nullptr;
+	ShaderParserFileCache* m_fileCache = nullptr;
 
 	ShaderCompilerDynamicArray<ShaderCompilerString> m_defineNames;
 	ShaderCompilerDynamicArray<I32> m_defineValues;
@@ -164,7 +228,7 @@ private:
 	ShaderCompilerDynamicArray<CString> m_extraCompilerArgsCString;
 
 	Error parseFile(CString fname, U32 depth);
-	Error parseLine(CString line, CString fname, Bool& foundPragmaOnce, U32 depth, U32 lineNumber);
+	Error parseLine(const ShaderParserFile::Line& line, CString fname, Bool& foundPragmaOnce, U32 depth, U32 lineNumber);
 	Error parseInclude(const ShaderCompilerString* begin, const ShaderCompilerString* end, CString line, CString fname, U32 depth);
 	Error parsePragmaMutator(const ShaderCompilerString* begin, const ShaderCompilerString* end, CString line, CString fname);
 	Error parsePragmaTechnique(const ShaderCompilerString* begin, const ShaderCompilerString* end, CString line, CString fname);
@@ -175,8 +239,6 @@ private:
 	Error parsePragma16bit(const ShaderCompilerString* begin, const ShaderCompilerString* end, CString line, CString fname);
 	Error parseExtraCompilerArgs(const ShaderCompilerString* begin, const ShaderCompilerString* end, CString line, CString fname);
 
-	void tokenizeLine(CString line, ShaderCompilerDynamicArray<ShaderCompilerString>& tokens) const;
-
 	static Bool tokenIsComment(CString token)
 	{
 		return token.getLength() >= 2 && token[0] == '/' && (token[1] == '/' || token[1] == '*');
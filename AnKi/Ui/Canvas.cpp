@@ -278,7 +278,7 @@ void Canvas::appendToCommandBufferInternal(CommandBuffer& cmdb)
 					}
 					else if(data && data->m_textureView.isValid())
 					{
-						cmdb.bindShaderProgram(m_grProgs[kRgbaTex].get());
+						cmdb.bindShaderProgram(m_grProgs[(data->m_alphaTexture) ? kAlphaTex : kRgbaTex].get());
 					}
 					else
 					{
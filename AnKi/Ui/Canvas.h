@@ -77,6 +77,7 @@ private:
 	{
 		kNoTex,
 		kRgbaTex,
+		kAlphaTex,
 		kShaderCount
 	};
 
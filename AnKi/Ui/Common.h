@@ -76,6 +76,7 @@ public:
 	U8 m_extraFastConstantsSize = 0;
 	Array<U8, 64> m_extraFastConstants;
 	Bool m_pointSampling = false;
+	Bool m_alphaTexture = false; ///< The texture is single channel and it's used as alpha (eg font atlases).
 
 	void setExtraFastConstants(const void* ptr, PtrSize fastConstantsSize)
 	{
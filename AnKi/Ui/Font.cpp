@@ -12,9 +12,46 @@
 #include <AnKi/Gr/Texture.h>
 #include <AnKi/Gr/CommandBuffer.h>
 #include <AnKi/Gr/ShaderProgram.h>
+#include <AnKi/Util/File.h>
+#include <AnKi/Util/Filesystem.h>
 
 namespace anki {
 
+/// The header of the font atlas cache file. It's followed by the FontAtlasCacheFont array, the glyphs of every font, the custom rects and
+/// the R8 pixels of the atlas.
+class FontAtlasCacheHeader
+{
+public:
+	static constexpr Array<Char, 8> kMagic = {'A', 'N', 'K', 'I', 'F', 'N', 'T', '1'};
+
+	Array<Char, 8> m_magic;
+	U32 m_imguiVersion;
+	U32 m_width;
+	U32 m_height;
+	U32 m_fontCount;
+	U32 m_customRectCount;
+	I32 m_packIdMouseCursors;
+	I32 m_packIdLines;
+	ImVec2 m_texUvWhitePixel;
+	Array<ImVec4, IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1> m_texUvLines;
+};
+
+/// The metrics of a single font in the cache file.
+class FontAtlasCacheFont
+{
+public:
+	U32 m_height;
+	U32 m_glyphCount;
+	F32 m_fontSize;
+	F32 m_scale;
+	F32 m_ascent;
+	F32 m_descent;
+	I32 m_metricsTotalSurface;
+	U32 m_fallbackChar;
+	U32 m_ellipsisChar;
+	U32 m_dotChar;
+};
+
 Font::~Font()
 {
 	m_imFontAtlas.destroy();
@@ -32,28 +69,239 @@ Error Font::init(const CString& filename, ConstWeakArray<U32> fontHeights)
 
 	m_fonts.resize(U32(fontHeights.getSize()));
 
-	// Bake font
-	ImFontConfig cfg;
-	cfg.FontDataOwnedByAtlas = false;
-	U32 count = 0;
-	for(U32 height : fontHeights)
+	// Try the cache first. It's keyed by the font file and the heights
+	UiString cacheFilename;
+	const Bool useCache = g_fontAtlasCacheCVar && GrManager::getSingleton().getCacheDirectory().getLength() > 0;
+	Bool cached = false;
+	if(useCache)
 	{
-		cfg.SizePixels = F32(height);
+		const U64 heightsHash = computeHash(fontHeights.getBegin(), fontHeights.getSizeInBytes(), IMGUI_VERSION_NUM);
+		const U64 hash = computeHash(&m_fontData[0], m_fontData.getSizeInBytes(), heightsHash);
+		cacheFilename.sprintf("%s/FontAtlas_%016" PRIx64 ".ankifontcache", GrManager::getSingleton().getCacheDirectory().cstr(), hash);
 
-		m_fonts[count].m_imFont = m_imFontAtlas->AddFontFromMemoryTTF(&m_fontData[0], I32(m_fontData.getSize()), F32(height), &cfg);
-		m_fonts[count].m_height = height;
-		++count;
+		ANKI_CHECK(loadAtlasFromCache(cacheFilename.toCString(), fontHeights, cached));
 	}
 
-	[[maybe_unused]] const Bool ok = m_imFontAtlas->Build();
-	ANKI_ASSERT(ok);
+	if(cached)
+	{
+		// The TTF is not needed any more
+		m_fontData.destroy();
+	}
+	else
+	{
+		// Bake font
+		ImFontConfig cfg;
+		cfg.FontDataOwnedByAtlas = false;
+		U32 count = 0;
+		for(U32 height : fontHeights)
+		{
+			cfg.SizePixels = F32(height);
 
-	// Create the texture
+			m_fonts[count].m_imFont = m_imFontAtlas->AddFontFromMemoryTTF(&m_fontData[0], I32(m_fontData.getSize()), F32(height), &cfg);
+			m_fonts[count].m_height = height;
+			++count;
+		}
+
+		[[maybe_unused]] const Bool ok = m_imFontAtlas->Build();
+		ANKI_ASSERT(ok);
+
+		if(useCache)
+		{
+			// The cache is just an optimization
+			if(storeAtlasToCache(cacheFilename.toCString()))
+			{
+				ANKI_UI_LOGW("Failed to write the font atlas cache. Will continue without it: %s", cacheFilename.cstr());
+			}
+		}
+	}
+
+	// Create the texture. The atlas only needs the alpha channel
 	U8* img;
 	int width, height;
-	m_imFontAtlas->GetTexDataAsRGBA32(&img, &width, &height);
+	m_imFontAtlas->GetTexDataAsAlpha8(&img, &width, &height);
 	createTexture(img, width, height);
 
+	// The CPU copy of the pixels is not needed after the upload
+	m_imFontAtlas->ClearTexData();
+
+	return Error::kNone;
+}
+
+Error Font::loadAtlasFromCache(CString cacheFilename, ConstWeakArray<U32> fontHeights, Bool& found)
+{
+	found = false;
+	if(!fileExists(cacheFilename))
+	{
+		return Error::kNone;
+	}
+
+	// Read everything at once
+	UiDynamicArray<U8> data;
+	{
+		File file;
+		ANKI_CHECK(file.open(cacheFilename, FileOpenFlag::kRead | FileOpenFlag::kBinary));
+		data.resize(U32(file.getSize()));
+		if(data.getSize())
+		{
+			ANKI_CHECK(file.read(&data[0], data.getSizeInBytes()));
+		}
+	}
+
+	// Validate
+	auto invalidCache = [&]() {
+		ANKI_UI_LOGW("Font atlas cache file is invalid. Will rebuild the atlas: %s", cacheFilename.cstr());
+		return Error::kNone;
+	};
+
+	if(data.getSizeInBytes() < sizeof(FontAtlasCacheHeader))
+	{
+		return invalidCache();
+	}
+
+	FontAtlasCacheHeader header;
+	memcpy(&header, &data[0], sizeof(header));
+	if(header.m_magic != FontAtlasCacheHeader::kMagic || header.m_imguiVersion != IMGUI_VERSION_NUM || header.m_fontCount != fontHeights.getSize())
+	{
+		return invalidCache();
+	}
+
+	const PtrSize fontsOffset = sizeof(FontAtlasCacheHeader);
+	const PtrSize glyphsOffset = fontsOffset + sizeof(FontAtlasCacheFont) * header.m_fontCount;
+	if(data.getSizeInBytes() < glyphsOffset)
+	{
+		return invalidCache();
+	}
+
+	ConstWeakArray<FontAtlasCacheFont> fonts(reinterpret_cast<const FontAtlasCacheFont*>(data.getBegin() + fontsOffset), header.m_fontCount);
+	PtrSize glyphCount = 0;
+	for(U32 i = 0; i < header.m_fontCount; ++i)
+	{
+		if(fonts[i].m_height != fontHeights[i])
+		{
+			return invalidCache();
+		}
+
+		glyphCount += fonts[i].m_glyphCount;
+	}
+
+	const PtrSize customRectsOffset = glyphsOffset + sizeof(ImFontGlyph) * glyphCount;
+	const PtrSize pixelsOffset = customRectsOffset + sizeof(ImFontAtlasCustomRect) * header.m_customRectCount;
+	const PtrSize pixelsSize = PtrSize(header.m_width) * header.m_height;
+	if(data.getSizeInBytes() != pixelsOffset + pixelsSize || pixelsSize == 0)
+	{
+		return invalidCache();
+	}
+
+	// Re-create the fonts
+	ImFontAtlas& atlas = *m_imFontAtlas;
+	const ImFontGlyph* glyphs = reinterpret_cast<const ImFontGlyph*>(data.getBegin() + glyphsOffset);
+	for(U32 i = 0; i < header.m_fontCount; ++i)
+	{
+		const FontAtlasCacheFont& in = fonts[i];
+
+		ImFont* font = IM_NEW(ImFont);
+		atlas.Fonts.push_back(font);
+
+		font->ContainerAtlas = &atlas;
+		font->FontSize = in.m_fontSize;
+		font->Scale = in.m_scale;
+		font->Ascent = in.m_ascent;
+		font->Descent = in.m_descent;
+		font->MetricsTotalSurface = in.m_metricsTotalSurface;
+		font->FallbackChar = ImWchar(in.m_fallbackChar);
+		font->EllipsisChar = ImWchar(in.m_ellipsisChar);
+		font->DotChar = ImWchar(in.m_dotChar);
+
+		font->Glyphs.resize(I32(in.m_glyphCount));
+		memcpy(font->Glyphs.Data, glyphs, sizeof(ImFontGlyph) * in.m_glyphCount);
+		glyphs += in.m_glyphCount;
+
+		// The lookup tables are derived from the glyphs and they are cheap to build
+		font->BuildLookupTable();
+
+		m_fonts[i].m_imFont = font;
+		m_fonts[i].m_height = in.m_height;
+	}
+
+	// Re-create the atlas
+	atlas.CustomRects.resize(I32(header.m_customRectCount));
+	if(header.m_customRectCount)
+	{
+		memcpy(atlas.CustomRects.Data, data.getBegin() + customRectsOffset, sizeof(ImFontAtlasCustomRect) * header.m_customRectCount);
+		for(ImFontAtlasCustomRect& rect : atlas.CustomRects)
+		{
+			rect.Font = nullptr;
+		}
+	}
+
+	atlas.PackIdMouseCursors = header.m_packIdMouseCursors;
+	atlas.PackIdLines = header.m_packIdLines;
+	atlas.TexWidth = I32(header.m_width);
+	atlas.TexHeight = I32(header.m_height);
+	atlas.TexUvScale = ImVec2(1.0f / F32(header.m_width), 1.0f / F32(header.m_height));
+	atlas.TexUvWhitePixel = header.m_texUvWhitePixel;
+	memcpy(atlas.TexUvLines, header.m_texUvLines.getBegin(), sizeof(atlas.TexUvLines));
+
+	atlas.TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(pixelsSize));
+	memcpy(atlas.TexPixelsAlpha8, data.getBegin() + pixelsOffset, pixelsSize);
+	atlas.TexReady = true;
+
+	found = true;
+	return Error::kNone;
+}
+
+Error Font::storeAtlasToCache(CString cacheFilename) const
+{
+	const ImFontAtlas& atlas = *m_imFontAtlas;
+	ANKI_ASSERT(atlas.IsBuilt() && atlas.TexPixelsAlpha8);
+
+	FontAtlasCacheHeader header;
+	header.m_magic = FontAtlasCacheHeader::kMagic;
+	header.m_imguiVersion = IMGUI_VERSION_NUM;
+	header.m_width = U32(atlas.TexWidth);
+	header.m_height = U32(atlas.TexHeight);
+	header.m_fontCount = m_fonts.getSize();
+	header.m_customRectCount = U32(atlas.CustomRects.Size);
+	header.m_packIdMouseCursors = atlas.PackIdMouseCursors;
+	header.m_packIdLines = atlas.PackIdLines;
+	header.m_texUvWhitePixel = atlas.TexUvWhitePixel;
+	memcpy(header.m_texUvLines.getBegin(), atlas.TexUvLines, sizeof(header.m_texUvLines));
+
+	File file;
+	ANKI_CHECK(file.open(cacheFilename, FileOpenFlag::kWrite | FileOpenFlag::kBinary));
+	ANKI_CHECK(file.write(&header, sizeof(header)));
+
+	for(const FontEntry& entry : m_fonts)
+	{
+		const ImFont& font = *entry.m_imFont;
+
+		FontAtlasCacheFont out;
+		out.m_height = entry.m_height;
+		out.m_glyphCount = U32(font.Glyphs.Size);
+		out.m_fontSize = font.FontSize;
+		out.m_scale = font.Scale;
+		out.m_ascent = font.Ascent;
+		out.m_descent = font.Descent;
+		out.m_metricsTotalSurface = font.MetricsTotalSurface;
+		out.m_fallbackChar = font.FallbackChar;
+		out.m_ellipsisChar = font.EllipsisChar;
+		out.m_dotChar = font.DotChar;
+		ANKI_CHECK(file.write(&out, sizeof(out)));
+	}
+
+	for(const FontEntry& entry : m_fonts)
+	{
+		const ImFont& font = *entry.m_imFont;
+		ANKI_CHECK(file.write(font.Glyphs.Data, sizeof(ImFontGlyph) * font.Glyphs.Size));
+	}
+
+	if(atlas.CustomRects.Size)
+	{
+		ANKI_CHECK(file.write(atlas.CustomRects.Data, sizeof(ImFontAtlasCustomRect) * atlas.CustomRects.Size));
+	}
+
+	ANKI_CHECK(file.write(atlas.TexPixelsAlpha8, PtrSize(atlas.TexWidth) * atlas.TexHeight));
+
 	return Error::kNone;
 }
 
@@ -62,7 +310,7 @@ void Font::createTexture(const void* data, U32 width, U32 height)
 	ANKI_ASSERT(data && width > 0 && height > 0);
 
 	// Create and populate the buffer
-	const U32 buffSize = width * height * 4;
+	const U32 buffSize = width * height;
 	BufferPtr buff = GrManager::getSingleton().newBuffer(BufferInitInfo(buffSize, BufferUsageBit::kCopySource, BufferMapAccessBit::kWrite, "UI"));
 	void* mapped = buff->map(0, buffSize, BufferMapAccessBit::kWrite);
 	memcpy(mapped, data, buffSize);
@@ -73,7 +321,7 @@ void Font::createTexture(const void* data, U32 width, U32 height)
 	TextureInitInfo texInit("Font");
 	texInit.m_width = width;
 	texInit.m_height = height;
-	texInit.m_format = Format::kR8G8B8A8_Unorm;
+	texInit.m_format = Format::kR8_Unorm;
 	texInit.m_usage = TextureUsageBit::kCopyDestination | TextureUsageBit::kSrvPixel;
 	texInit.m_mipmapCount = 1; // No mips because it will appear blurry with trilinear filtering
 
@@ -81,6 +329,7 @@ void Font::createTexture(const void* data, U32 width, U32 height)
 
 	// Create the whole texture view
 	m_imgData.m_textureView = TextureView(m_tex.get(), TextureSubresourceDesc::all());
+	m_imgData.m_alphaTexture = true;
 	m_imFontAtlas->SetTexID(UiImageId(&m_imgData));
 
 	// Do the copy
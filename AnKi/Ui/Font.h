@@ -9,12 +9,16 @@
 #include <AnKi/Gr/Texture.h>
 #include <AnKi/Util/ClassWrapper.h>
 #include <AnKi/Util/WeakArray.h>
+#include <AnKi/Util/CVarSet.h>
 
 namespace anki {
 
 /// @addtogroup ui
 /// @{
 
+inline BoolCVar g_fontAtlasCacheCVar("Ui", "FontAtlasCache", true,
+									 "Store the built font atlases in the cache directory to avoid rasterizing the fonts on every startup");
+
 /// Font class.
 class Font : public UiObject
 {
@@ -73,6 +77,10 @@ private:
 	UiImageIdData m_imgData;
 
 	void createTexture(const void* data, U32 width, U32 height);
+
+	Error loadAtlasFromCache(CString cacheFilename, ConstWeakArray<U32> fontHeights, Bool& found);
+
+	Error storeAtlasToCache(CString cacheFilename) const;
 };
 /// @}
 
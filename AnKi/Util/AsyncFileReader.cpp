@@ -0,0 +1,368 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Util/AsyncFileReader.h>
+#include <AnKi/Util/ThreadJobManager.h>
+#include <AnKi/Util/Logger.h>
+#if ANKI_OS_LINUX
+#	include <linux/io_uring.h>
+#	include <sys/syscall.h>
+#	include <sys/mman.h>
+#	include <sys/uio.h>
+#	include <unistd.h>
+#	include <cerrno>
+#	include <atomic>
+#endif
+
+namespace anki {
+
+#if ANKI_OS_LINUX
+/// A minimal io_uring wrapper that talks to the kernel directly (no liburing).
+class AsyncFileReader::IoUring
+{
+public:
+	/// A read in flight. It's referenced by the user_data of the SQE.
+	class Slot
+	{
+	public:
+		AsyncFileReadRequest m_request; ///< What's left to read.
+		iovec m_iovec;
+	};
+
+	I32 m_ringFd = -1;
+
+	U8* m_sqRing = nullptr;
+	PtrSize m_sqRingSize = 0;
+	U8* m_cqRing = nullptr;
+	PtrSize m_cqRingSize = 0;
+	io_uring_sqe* m_sqes = nullptr;
+	PtrSize m_sqesSize = 0;
+
+	U32* m_sqTail = nullptr;
+	U32* m_sqArray = nullptr;
+	U32 m_sqMask = 0;
+	U32* m_cqHead = nullptr;
+	U32* m_cqTail = nullptr;
+	U32 m_cqMask = 0;
+	io_uring_cqe* m_cqes = nullptr;
+
+	DynamicArray<Slot> m_slots;
+	DynamicArray<U32> m_freeSlots;
+	DynamicArray<AsyncFileReadRequest> m_pending; ///< Requests that wait for a free slot.
+	U32 m_pendingFront = 0;
+	U32 m_unsubmittedCount = 0; ///< SQEs that the kernel doesn't know about yet.
+
+	~IoUring()
+	{
+		if(m_sqes)
+		{
+			munmap(m_sqes, m_sqesSize);
+		}
+
+		if(m_cqRing && m_cqRing != m_sqRing)
+		{
+			munmap(m_cqRing, m_cqRingSize);
+		}
+
+		if(m_sqRing)
+		{
+			munmap(m_sqRing, m_sqRingSize);
+		}
+
+		if(m_ringFd >= 0)
+		{
+			close(m_ringFd);
+		}
+	}
+
+	Error init(U32 queueDepth)
+	{
+		io_uring_params params = {};
+		const long fd = syscall(__NR_io_uring_setup, queueDepth, &params);
+		if(fd < 0)
+		{
+			return Error::kFunctionFailed;
+		}
+		m_ringFd = I32(fd);
+
+		m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(U32);
+		m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		const Bool singleMmap = !!(params.features & IORING_FEAT_SINGLE_MMAP);
+		if(singleMmap)
+		{
+			m_sqRingSize = m_cqRingSize = max(m_sqRingSize, m_cqRingSize);
+		}
+
+		void* mem = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQ_RING);
+		if(mem == MAP_FAILED)
+		{
+			return Error::kFunctionFailed;
+		}
+		m_sqRing = static_cast<U8*>(mem);
+
+		if(singleMmap)
+		{
+			m_cqRing = m_sqRing;
+		}
+		else
+		{
+			mem = mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_CQ_RING);
+			if(mem == MAP_FAILED)
+			{
+				return Error::kFunctionFailed;
+			}
+			m_cqRing = static_cast<U8*>(mem);
+		}
+
+		m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		mem = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQES);
+		if(mem == MAP_FAILED)
+		{
+			return Error::kFunctionFailed;
+		}
+		m_sqes = static_cast<io_uring_sqe*>(mem);
+
+		m_sqTail = reinterpret_cast<U32*>(m_sqRing + params.sq_off.tail);
+		m_sqArray = reinterpret_cast<U32*>(m_sqRing + params.sq_off.array);
+		m_sqMask = *reinterpret_cast<U32*>(m_sqRing + params.sq_off.ring_mask);
+		m_cqHead = reinterpret_cast<U32*>(m_cqRing + params.cq_off.head);
+		m_cqTail = reinterpret_cast<U32*>(m_cqRing + params.cq_off.tail);
+		m_cqMask = *reinterpret_cast<U32*>(m_cqRing + params.cq_off.ring_mask);
+		m_cqes = reinterpret_cast<io_uring_cqe*>(m_cqRing + params.cq_off.cqes);
+
+		// One slot per SQE so there is always space in the SQ for a free slot. The CQ is at least twice the SQ so it can't overflow
+		m_slots.resize(params.sq_entries);
+		m_freeSlots.resize(params.sq_entries);
+		for(U32 i = 0; i < params.sq_entries; ++i)
+		{
+			m_freeSlots[i] = params.sq_entries - i - 1;
+		}
+
+		return Error::kNone;
+	}
+
+	Bool hasWork() const
+	{
+		return m_freeSlots.getSize() != m_slots.getSize() || m_pendingFront < m_pending.getSize();
+	}
+
+	void queueRead(U32 slotIdx)
+	{
+		Slot& slot = m_slots[slotIdx];
+		slot.m_iovec.iov_base = slot.m_request.m_buffer;
+		slot.m_iovec.iov_len = min<PtrSize>(slot.m_request.m_size, kMaxI32);
+
+		const U32 tail = *m_sqTail; // Only this thread writes the tail
+		const U32 idx = tail & m_sqMask;
+
+		io_uring_sqe& sqe = m_sqes[idx];
+		memset(&sqe, 0, sizeof(sqe));
+		sqe.opcode = IORING_OP_READV;
+		sqe.fd = I32(slot.m_request.m_file->getNativeHandle());
+		sqe.off = slot.m_request.m_offset;
+		sqe.addr = ptrToNumber(&slot.m_iovec);
+		sqe.len = 1;
+		sqe.user_data = slotIdx;
+
+		m_sqArray[idx] = idx;
+		std::atomic_ref<U32>(*m_sqTail).store(tail + 1, std::memory_order_release);
+		++m_unsubmittedCount;
+	}
+
+	/// Move pending requests to free slots.
+	void queuePending()
+	{
+		while(m_freeSlots.getSize() && m_pendingFront < m_pending.getSize())
+		{
+			const U32 slotIdx = m_freeSlots.getBack();
+			m_freeSlots.popBack();
+			m_slots[slotIdx].m_request = m_pending[m_pendingFront++];
+			queueRead(slotIdx);
+		}
+
+		if(m_pendingFront == m_pending.getSize())
+		{
+			m_pending.resize(0);
+			m_pendingFront = 0;
+		}
+	}
+
+	/// Submit the queued SQEs and optionally wait for one completion.
+	Error enter(Bool waitForCompletion)
+	{
+		while(m_unsubmittedCount || waitForCompletion)
+		{
+			const U32 flags = (waitForCompletion) ? IORING_ENTER_GETEVENTS : 0;
+			const long ret = syscall(__NR_io_uring_enter, m_ringFd, m_unsubmittedCount, (waitForCompletion) ? 1 : 0, flags, nullptr, 0);
+			if(ret < 0)
+			{
+				if(errno == EINTR || errno == EAGAIN || errno == EBUSY)
+				{
+					continue;
+				}
+
+				ANKI_UTIL_LOGE("io_uring_enter() failed: %s", strerror(errno));
+				return Error::kFunctionFailed;
+			}
+
+			m_unsubmittedCount -= U32(ret);
+			waitForCompletion = false;
+		}
+
+		return Error::kNone;
+	}
+
+	/// Process the completed reads.
+	void reap(Atomic<U32>& failedCount)
+	{
+		U32 head = *m_cqHead; // Only this thread writes the head
+		const U32 tail = std::atomic_ref<U32>(*m_cqTail).load(std::memory_order_acquire);
+
+		while(head != tail)
+		{
+			const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+			const U32 slotIdx = U32(cqe.user_data);
+			Slot& slot = m_slots[slotIdx];
+			++head;
+
+			if(cqe.res == -EINTR || cqe.res == -EAGAIN)
+			{
+				queueRead(slotIdx);
+			}
+			else if(cqe.res <= 0)
+			{
+				ANKI_UTIL_LOGE("Async file read failed: %s", (cqe.res < 0) ? strerror(-cqe.res) : "Unexpected end of file");
+				failedCount.fetchAdd(1);
+				m_freeSlots.emplaceBack(slotIdx);
+			}
+			else if(PtrSize(cqe.res) < slot.m_request.m_size)
+			{
+				// Short read, read the rest
+				slot.m_request.m_offset += cqe.res;
+				slot.m_request.m_buffer = static_cast<U8*>(slot.m_request.m_buffer) + cqe.res;
+				slot.m_request.m_size -= cqe.res;
+				queueRead(slotIdx);
+			}
+			else
+			{
+				m_freeSlots.emplaceBack(slotIdx);
+			}
+		}
+
+		std::atomic_ref<U32>(*m_cqHead).store(head, std::memory_order_release);
+	}
+};
+#else
+class AsyncFileReader::IoUring
+{
+};
+#endif
+
+AsyncFileReader::~AsyncFileReader()
+{
+	[[maybe_unused]] const Error err = wait();
+	deleteInstance(DefaultMemoryPool::getSingleton(), m_ring);
+}
+
+Error AsyncFileReader::init(ThreadJobManager* jobManager, U32 queueDepth, [[maybe_unused]] Bool useIoUring)
+{
+	ANKI_ASSERT(queueDepth > 0);
+	m_jobManager = jobManager;
+
+#if ANKI_OS_LINUX
+	if(useIoUring)
+	{
+		m_ring = newInstance<IoUring>(DefaultMemoryPool::getSingleton());
+		if(m_ring->init(queueDepth))
+		{
+			ANKI_UTIL_LOGV("io_uring is not available, will fallback to a thread pool for the async file reads");
+			deleteInstance(DefaultMemoryPool::getSingleton(), m_ring);
+			m_ring = nullptr;
+		}
+	}
+#endif
+
+	return Error::kNone;
+}
+
+Error AsyncFileReader::submit(ConstWeakArray<AsyncFileReadRequest> requests)
+{
+#if ANKI_OS_LINUX
+	if(m_ring)
+	{
+		for(const AsyncFileReadRequest& req : requests)
+		{
+			ANKI_ASSERT(req.m_file && req.m_buffer && req.m_size > 0);
+			m_ring->m_pending.emplaceBack(req);
+		}
+
+		// Free the slots of what's already done and then start as much as possible
+		m_ring->reap(m_failedCount);
+		m_ring->queuePending();
+		return m_ring->enter(false);
+	}
+#endif
+
+	for(const AsyncFileReadRequest& req : requests)
+	{
+		ANKI_ASSERT(req.m_file && req.m_buffer && req.m_size > 0);
+
+		if(m_jobManager)
+		{
+			{
+				LockGuard lock(m_inFlightMtx);
+				++m_inFlightCount;
+			}
+
+			m_jobManager->dispatchTask([this, req]([[maybe_unused]] U32 tid) {
+				if(req.m_file->readAt(req.m_offset, req.m_buffer, req.m_size))
+				{
+					m_failedCount.fetchAdd(1);
+				}
+
+				// Signal with the lock held so the reader can't be destroyed before the notification
+				LockGuard lock(m_inFlightMtx);
+				ANKI_ASSERT(m_inFlightCount > 0);
+				if(--m_inFlightCount == 0)
+				{
+					m_inFlightCond.notifyAll();
+				}
+			});
+		}
+		else if(req.m_file->readAt(req.m_offset, req.m_buffer, req.m_size))
+		{
+			m_failedCount.fetchAdd(1);
+		}
+	}
+
+	return Error::kNone;
+}
+
+Error AsyncFileReader::wait()
+{
+#if ANKI_OS_LINUX
+	if(m_ring)
+	{
+		while(m_ring->hasWork())
+		{
+			ANKI_CHECK(m_ring->enter(true));
+			m_ring->reap(m_failedCount);
+			m_ring->queuePending();
+		}
+	}
+#endif
+
+	{
+		LockGuard lock(m_inFlightMtx);
+		while(m_inFlightCount != 0)
+		{
+			m_inFlightCond.wait(m_inFlightMtx);
+		}
+	}
+
+	return (m_failedCount.exchange(0) == 0) ? Error::kNone : Error::kFileAccess;
+}
+
+} // end namespace anki
@@ -0,0 +1,74 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Util/File.h>
+#include <AnKi/Util/Atomic.h>
+#include <AnKi/Util/Thread.h>
+#include <AnKi/Util/DynamicArray.h>
+
+namespace anki {
+
+// Forward
+class ThreadJobManager;
+
+/// @addtogroup util_file
+/// @{
+
+/// A read that AsyncFileReader will perform.
+class AsyncFileReadRequest
+{
+public:
+	const File* m_file = nullptr;
+	PtrSize m_offset = 0;
+	void* m_buffer = nullptr;
+	PtrSize m_size = 0;
+};
+
+/// Performs batches of file reads in the background so the caller can overlap the I/O with other work (eg decoding what it already read). On
+/// Linux it uses io_uring. Elsewhere, or if io_uring is not available, the reads run in a ThreadJobManager.
+/// @note It's not thread-safe. Use one per thread.
+class AsyncFileReader
+{
+public:
+	AsyncFileReader() = default;
+
+	AsyncFileReader(const AsyncFileReader&) = delete; // Non-copyable
+
+	~AsyncFileReader();
+
+	AsyncFileReader& operator=(const AsyncFileReader&) = delete; // Non-copyable
+
+	/// @param jobManager Where the fallback performs the reads. If it's nullptr the fallback reads synchronously inside submit().
+	/// @param queueDepth The max number of reads that are in flight.
+	/// @param useIoUring Try to use io_uring if it's available.
+	Error init(ThreadJobManager* jobManager = nullptr, U32 queueDepth = 64, Bool useIoUring = true);
+
+	/// Start some reads. The files and the buffers should stay alive until wait() returns.
+	Error submit(ConstWeakArray<AsyncFileReadRequest> requests);
+
+	/// Wait for all the submitted reads.
+	/// @return An error if any of the reads failed.
+	Error wait();
+
+	Bool isUsingIoUring() const
+	{
+		return m_ring != nullptr;
+	}
+
+private:
+	class IoUring;
+
+	IoUring* m_ring = nullptr;
+	ThreadJobManager* m_jobManager = nullptr;
+	U32 m_inFlightCount = 0; ///< Reads that run in the m_jobManager. Protected by m_inFlightMtx.
+	Mutex m_inFlightMtx;
+	ConditionVariable m_inFlightCond; ///< Signaled when the last read of the m_jobManager finishes.
+	Atomic<U32> m_failedCount = {0};
+};
+/// @}
+
+} // end namespace anki
@@ -270,6 +270,9 @@ public:
 	template<typename... TArgs>
 	Iterator emplace(TArgs&&... args);
 
+	/// Allocate the blocks that are needed to hold some elements. Useful before emplacing many elements at once.
+	void reserve(U32 elementCount);
+
 	/// Removes one element.
 	/// @param at Points to the position of the element to remove.
 	void erase(Iterator idx);
@@ -305,6 +308,26 @@ public:
 		return m_blockStorages.getMemoryPool();
 	}
 
+	/// Number of blocks (including the empty ones). Useful to split the array into jobs.
+	U32 getBlockCount() const
+	{
+		return m_blockMetadatas.getSize();
+	}
+
+	/// Iterate the elements of a single block. Different blocks can be iterated from different threads.
+	template<typename TFunc>
+	void iterateBlockElements(U32 blockIdx, TFunc func)
+	{
+		ANKI_ASSERT(blockIdx < m_blockMetadatas.getSize());
+		Mask mask = m_blockMetadatas[blockIdx].m_elementsInUseMask;
+		U32 localIdx;
+		while((localIdx = mask.getLeastSignificantBit()) != kMaxU32)
+		{
+			mask.unset(localIdx);
+			func(*reinterpret_cast<Value*>(&m_blockStorages[blockIdx]->m_storage[localIdx * sizeof(Value)]));
+		}
+	}
+
 	void validate() const;
 
 private:
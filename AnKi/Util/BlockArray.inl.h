@@ -84,6 +84,25 @@ typename BlockArray<T, TMemoryPool, TConfig>::Iterator BlockArray<T, TMemoryPool
 	return Iterator(this, idx);
 }
 
+template<typename T, typename TMemoryPool, typename TConfig>
+void BlockArray<T, TMemoryPool, TConfig>::reserve(U32 elementCount)
+{
+	const U32 blockCount = (elementCount + kElementCountPerBlock - 1) / kElementCountPerBlock;
+	if(blockCount > m_blockStorages.getSize())
+	{
+		m_blockMetadatas.resize(blockCount, false);
+		m_blockStorages.resize(blockCount, nullptr);
+	}
+
+	for(U32 i = 0; i < blockCount; ++i)
+	{
+		if(m_blockStorages[i] == nullptr)
+		{
+			m_blockStorages[i] = newInstance<BlockStorage>(getMemoryPool());
+		}
+	}
+}
+
 template<typename T, typename TMemoryPool, typename TConfig>
 void BlockArray<T, TMemoryPool, TConfig>::erase(Iterator it)
 {
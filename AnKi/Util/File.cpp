@@ -9,12 +9,19 @@
 #include <AnKi/Util/Assert.h>
 #include <cstring>
 #include <cstdarg>
+#include <cerrno>
 #if ANKI_OS_ANDROID
 #	include <android_native_app_glue.h>
 #	include <android/asset_manager.h>
 #endif
 #if ANKI_POSIX
 #	include <sys/stat.h>
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+#if ANKI_OS_WINDOWS
+#	include <AnKi/Util/Win32Minimal.h>
+#	include <io.h>
 #endif
 
 namespace anki {
@@ -34,6 +41,10 @@ File& File::operator=(File&& b)
 		m_file = b.m_file;
 		m_flags = b.m_flags;
 		m_size = b.m_size;
+		m_mappedData = b.m_mappedData;
+#if ANKI_OS_WINDOWS
+		m_mappingHandle = b.m_mappingHandle;
+#endif
 	}
 
 	b.zero();
@@ -197,6 +208,8 @@ void File::close()
 {
 	if(m_file)
 	{
+		unmap();
+
 #if ANKI_OS_ANDROID
 		if(!!(m_flags & FileOpenFlag::kSpecial))
 		{
@@ -269,6 +282,170 @@ Error File::read(void* buff, PtrSize size)
 	return err;
 }
 
+Error File::readAt(PtrSize offset, void* buff, PtrSize size) const
+{
+	ANKI_ASSERT(buff);
+	ANKI_ASSERT(size > 0);
+	ANKI_ASSERT(m_file);
+	ANKI_ASSERT((m_flags & FileOpenFlag::kRead) != FileOpenFlag::kNone);
+
+#if ANKI_OS_ANDROID
+	if(!!(m_flags & FileOpenFlag::kSpecial))
+	{
+		ANKI_UTIL_LOGE("Positional reads of special files are not supported");
+		return Error::kFunctionFailed;
+	}
+#endif
+
+#if ANKI_OS_WINDOWS
+	// ReadFile() with an offset still moves the file pointer of synchronous handles. Lock the stream so nothing sees the moved pointer and
+	// restore it when done
+	const HANDLE handle = HANDLE(getNativeHandle());
+	_lock_file(ANKI_CFILE);
+	LARGE_INTEGER zero = {};
+	LARGE_INTEGER position;
+	if(!SetFilePointerEx(handle, zero, &position, FILE_CURRENT))
+	{
+		_unlock_file(ANKI_CFILE);
+		ANKI_UTIL_LOGE("SetFilePointerEx() failed");
+		return Error::kFileAccess;
+	}
+#endif
+
+	Error err = Error::kNone;
+	U8* out = static_cast<U8*>(buff);
+	while(size > 0)
+	{
+#if ANKI_POSIX
+		const ssize_t readSize = pread(I32(getNativeHandle()), out, size, off_t(offset));
+		if(readSize < 0 && errno == EINTR)
+		{
+			continue;
+		}
+#else
+		OVERLAPPED overlapped = {};
+		overlapped.Offset = DWORD(offset);
+		overlapped.OffsetHigh = DWORD(offset >> 32u);
+		DWORD dwReadSize = 0;
+		const I64 readSize = ReadFile(handle, out, DWORD(min<PtrSize>(size, kMaxU32)), &dwReadSize, &overlapped) ? I64(dwReadSize) : -1;
+#endif
+
+		if(readSize <= 0)
+		{
+			ANKI_UTIL_LOGE("File read failed");
+			err = Error::kFileAccess;
+			break;
+		}
+
+		out += readSize;
+		offset += PtrSize(readSize);
+		size -= PtrSize(readSize);
+	}
+
+#if ANKI_OS_WINDOWS
+	if(!SetFilePointerEx(handle, position, nullptr, FILE_BEGIN) && !err)
+	{
+		ANKI_UTIL_LOGE("SetFilePointerEx() failed");
+		err = Error::kFileAccess;
+	}
+	_unlock_file(ANKI_CFILE);
+#endif
+
+	return err;
+}
+
+Error File::map(ConstWeakArray<U8, PtrSize>& data)
+{
+	ANKI_ASSERT(m_file);
+	ANKI_ASSERT((m_flags & FileOpenFlag::kRead) != FileOpenFlag::kNone);
+
+	if(m_mappedData == nullptr)
+	{
+#if ANKI_OS_ANDROID
+		if(!!(m_flags & FileOpenFlag::kSpecial))
+		{
+			m_mappedData = AAsset_getBuffer(ANKI_AFILE);
+			if(m_mappedData == nullptr)
+			{
+				ANKI_UTIL_LOGE("AAsset_getBuffer() failed");
+				return Error::kFunctionFailed;
+			}
+		}
+		else
+#endif
+			if(m_size > 0)
+		{
+#if ANKI_POSIX
+			void* mapped = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, I32(getNativeHandle()), 0);
+			if(mapped == MAP_FAILED)
+			{
+				ANKI_UTIL_LOGE("mmap() failed");
+				return Error::kFunctionFailed;
+			}
+
+			m_mappedData = mapped;
+#else
+			m_mappingHandle = CreateFileMappingA(HANDLE(getNativeHandle()), nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if(m_mappingHandle == nullptr)
+			{
+				ANKI_UTIL_LOGE("CreateFileMappingA() failed");
+				return Error::kFunctionFailed;
+			}
+
+			m_mappedData = MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+			if(m_mappedData == nullptr)
+			{
+				ANKI_UTIL_LOGE("MapViewOfFile() failed");
+				CloseHandle(m_mappingHandle);
+				m_mappingHandle = nullptr;
+				return Error::kFunctionFailed;
+			}
+#endif
+		}
+	}
+
+	data = ConstWeakArray<U8, PtrSize>(static_cast<const U8*>(m_mappedData), m_size);
+	return Error::kNone;
+}
+
+void File::unmap()
+{
+	if(m_mappedData == nullptr)
+	{
+		return;
+	}
+
+#if ANKI_OS_ANDROID
+	if(!!(m_flags & FileOpenFlag::kSpecial))
+	{
+		// The buffer is owned by the asset
+	}
+	else
+#endif
+	{
+#if ANKI_POSIX
+		munmap(const_cast<void*>(m_mappedData), m_size);
+#else
+		UnmapViewOfFile(m_mappedData);
+		CloseHandle(m_mappingHandle);
+		m_mappingHandle = nullptr;
+#endif
+	}
+
+	m_mappedData = nullptr;
+}
+
+I64 File::getNativeHandle() const
+{
+	ANKI_ASSERT(m_file);
+	ANKI_ASSERT(!(m_flags & FileOpenFlag::kSpecial));
+#if ANKI_POSIX
+	return fileno(ANKI_CFILE);
+#else
+	return _get_osfhandle(_fileno(ANKI_CFILE));
+#endif
+}
+
 Error File::readU32(U32& out)
 {
 	ANKI_ASSERT(m_file);
@@ -7,6 +7,7 @@
 
 #include <AnKi/Util/String.h>
 #include <AnKi/Util/Enum.h>
+#include <AnKi/Util/WeakArray.h>
 #include <cstdio>
 
 namespace anki {
@@ -45,6 +46,8 @@ enum class FileSeekOrigin
 /// - If the above are false then try to load a regular C file
 class File
 {
+	friend class AsyncFileReader;
+
 public:
 	/// Default constructor
 	File() = default;
@@ -85,6 +88,13 @@ public:
 	/// Read data from the file
 	Error read(void* buff, PtrSize size);
 
+	/// Read from an offset of the file. It doesn't use or move the position indicator so it's thread-safe. On Windows the reads of the same file
+	/// are serialized. It bypasses the buffering of read() so don't mix it with read() and seek().
+	Error readAt(PtrSize offset, void* buff, PtrSize size) const;
+
+	/// Map the whole file to memory for reading. The view stays valid until the file is closed. Calling it again returns the same view.
+	Error map(ConstWeakArray<U8, PtrSize>& data);
+
 	/// Read all the contents of a text file. If the file is not rewined it will probably fail.
 	template<typename TMemPool>
 	Error readAllText(BaseString<TMemPool>& out)
@@ -140,6 +150,10 @@ private:
 	void* m_file = nullptr; ///< A native file type
 	FileOpenFlag m_flags = FileOpenFlag::kNone; ///< All the flags. Set on open
 	PtrSize m_size = 0;
+	const void* m_mappedData = nullptr;
+#if ANKI_OS_WINDOWS
+	void* m_mappingHandle = nullptr;
+#endif
 
 	/// Get the current machine's endianness
 	static FileOpenFlag getMachineEndianness();
@@ -157,7 +171,16 @@ private:
 		m_file = nullptr;
 		m_flags = FileOpenFlag::kNone;
 		m_size = 0;
+		m_mappedData = nullptr;
+#if ANKI_OS_WINDOWS
+		m_mappingHandle = nullptr;
+#endif
 	}
+
+	void unmap();
+
+	/// Get the file descriptor (POSIX) or the HANDLE (Windows) of a C file.
+	I64 getNativeHandle() const;
 };
 /// @}
 
@@ -59,6 +59,11 @@ public:
 		return *(*(m_children.getBegin() + i));
 	}
 
+	Bool hasChildren() const
+	{
+		return !m_children.isEmpty();
+	}
+
 	/// Add a new child.
 	void addChild(Value* child);
 
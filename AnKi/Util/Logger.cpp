@@ -6,6 +6,7 @@
 #include <AnKi/Util/File.h>
 #include <AnKi/Util/Logger.h>
 #include <AnKi/Util/System.h>
+#include <AnKi/Util/MemoryPool.h>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
@@ -21,6 +22,476 @@ namespace anki {
 
 inline constexpr Array<const Char*, U(LoggerMessageType::kCount)> kMessageTypeTxt = {"I", "V", "E", "W", "F"};
 
+/// The header of a message in the ring buffers of the asynchronous mode. After the header comes the format string and then the arguments. The
+/// strings of the file, function and subsystem are assumed to be literals.
+class AsyncLoggerMessage
+{
+public:
+	U32 m_size; ///< The size of the header plus the payload. If it's zero the rest of the ring is unused and the next message is at the start.
+	LoggerMessageType m_type;
+	I32 m_line;
+	U64 m_index;
+	const Char* m_file;
+	const Char* m_func;
+	const Char* m_subsystem;
+	Array<Char, Thread::kThreadNameMaxLength + 1> m_threadName;
+};
+
+static_assert(sizeof(AsyncLoggerMessage) % 8 == 0);
+
+inline constexpr U32 kMaxAsyncLoggerMessageSize = 4 * 1024;
+
+/// A printf conversion specification.
+class FormatSpec
+{
+public:
+	const Char* m_begin; ///< Points to the %.
+	const Char* m_lengthBegin; ///< Where the length modifiers start.
+	const Char* m_end; ///< One past the conversion character.
+	Char m_conversion;
+	U32 m_starCount; ///< How many * are in the width and precision.
+	Array<Char, 3> m_length;
+};
+
+/// Parse the conversion specification that starts at c.
+/// @return False if the conversion is not supported.
+static Bool parseFormatSpec(const Char* c, FormatSpec& spec)
+{
+	ANKI_ASSERT(*c == '%');
+	spec.m_begin = c++;
+	spec.m_starCount = 0;
+
+	// Flags, width and precision
+	while(*c && strchr("-+ #0123456789.*", *c))
+	{
+		spec.m_starCount += (*c == '*');
+		++c;
+	}
+
+	// Length modifiers
+	spec.m_lengthBegin = c;
+	U32 lengthCount = 0;
+	spec.m_length = {};
+	while(*c && strchr("hlzjtL", *c) && lengthCount < 2)
+	{
+		spec.m_length[lengthCount++] = *c++;
+	}
+
+	spec.m_conversion = *c;
+	if(spec.m_conversion == '\0' || !strchr("diouxXcfFeEgGaAspn%", spec.m_conversion) || spec.m_starCount > 2)
+	{
+		return false;
+	}
+
+	spec.m_end = c + 1;
+	return true;
+}
+
+/// Writes the arguments of a message to a buffer.
+class FormatArgumentPacker
+{
+public:
+	U8* m_begin;
+	U8* m_pos;
+	U8* m_end;
+
+	Bool push(const void* data, PtrSize size)
+	{
+		const PtrSize alignedSize = getAlignedRoundUp(8, size);
+		if(m_pos + alignedSize > m_end)
+		{
+			return false;
+		}
+
+		memcpy(m_pos, data, size);
+		m_pos += alignedSize;
+		return true;
+	}
+
+	template<typename T>
+	Bool push(T value)
+	{
+		return push(&value, sizeof(value));
+	}
+
+	Bool pushString(const Char* str)
+	{
+		const U32 len = U32(strlen(str));
+		return push(len) && push(str, len + 1);
+	}
+};
+
+/// Reads what FormatArgumentPacker wrote.
+class FormatArgumentUnpacker
+{
+public:
+	const U8* m_pos;
+
+	template<typename T>
+	T pop()
+	{
+		T value;
+		memcpy(&value, m_pos, sizeof(value));
+		m_pos += getAlignedRoundUp(8, sizeof(value));
+		return value;
+	}
+
+	const Char* popString()
+	{
+		const U32 len = pop<U32>();
+		const Char* str = reinterpret_cast<const Char*>(m_pos);
+		m_pos += getAlignedRoundUp(8, len + 1);
+		return str;
+	}
+};
+
+static Bool packFormatArguments(const Char* fmt, va_list args, FormatArgumentPacker& packer)
+{
+	if(!packer.pushString(fmt))
+	{
+		return false;
+	}
+
+	for(const Char* c = strchr(fmt, '%'); c; c = strchr(c, '%'))
+	{
+		FormatSpec spec;
+		if(!parseFormatSpec(c, spec))
+		{
+			// The formatting will print the rest verbatim
+			break;
+		}
+		c = spec.m_end;
+
+		for(U32 i = 0; i < spec.m_starCount; ++i)
+		{
+			if(!packer.push(I64(va_arg(args, int))))
+			{
+				return false;
+			}
+		}
+
+		const CString length = &spec.m_length[0];
+		Bool ok = true;
+		switch(spec.m_conversion)
+		{
+		case 'd':
+		case 'i':
+		{
+			I64 value;
+			if(length == "hh")
+			{
+				value = I8(va_arg(args, int));
+			}
+			else if(length == "h")
+			{
+				value = I16(va_arg(args, int));
+			}
+			else if(length == "l")
+			{
+				value = va_arg(args, long);
+			}
+			else if(length == "ll" || length == "j")
+			{
+				value = va_arg(args, long long);
+			}
+			else if(length == "z" || length == "t")
+			{
+				value = va_arg(args, ptrdiff_t);
+			}
+			else
+			{
+				value = va_arg(args, int);
+			}
+			ok = packer.push(value);
+			break;
+		}
+		case 'o':
+		case 'u':
+		case 'x':
+		case 'X':
+		{
+			U64 value;
+			if(length == "hh")
+			{
+				value = U8(va_arg(args, unsigned int));
+			}
+			else if(length == "h")
+			{
+				value = U16(va_arg(args, unsigned int));
+			}
+			else if(length == "l")
+			{
+				value = va_arg(args, unsigned long);
+			}
+			else if(length == "ll" || length == "j")
+			{
+				value = va_arg(args, unsigned long long);
+			}
+			else if(length == "z" || length == "t")
+			{
+				value = va_arg(args, size_t);
+			}
+			else
+			{
+				value = va_arg(args, unsigned int);
+			}
+			ok = packer.push(value);
+			break;
+		}
+		case 'c':
+			ok = packer.push(I64(va_arg(args, int)));
+			break;
+		case 'f':
+		case 'F':
+		case 'e':
+		case 'E':
+		case 'g':
+		case 'G':
+		case 'a':
+		case 'A':
+			ok = packer.push((length == "L") ? F64(va_arg(args, long double)) : va_arg(args, double));
+			break;
+		case 's':
+		{
+			const Char* str = va_arg(args, const Char*);
+			ok = packer.pushString((str) ? str : "(null)");
+			break;
+		}
+		case 'p':
+			ok = packer.push(va_arg(args, void*));
+			break;
+		case 'n':
+		{
+			[[maybe_unused]] void* ignored = va_arg(args, void*);
+			break;
+		}
+		}
+
+		if(!ok)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// A string that starts on the stack and moves to the heap if it grows.
+class FormatOutput
+{
+public:
+	Array<Char, 512> m_stackStorage;
+	Char* m_str = &m_stackStorage[0];
+	PtrSize m_length = 0;
+	PtrSize m_capacity = sizeof(m_stackStorage);
+
+	~FormatOutput()
+	{
+		if(m_str != &m_stackStorage[0])
+		{
+			free(m_str);
+		}
+	}
+
+	void reserve(PtrSize extra)
+	{
+		if(m_length + extra + 1 > m_capacity)
+		{
+			const PtrSize newCapacity = max(m_capacity * 2, m_length + extra + 1);
+			Char* newStr = static_cast<Char*>(malloc(newCapacity));
+			memcpy(newStr, m_str, m_length);
+			if(m_str != &m_stackStorage[0])
+			{
+				free(m_str);
+			}
+			m_str = newStr;
+			m_capacity = newCapacity;
+		}
+	}
+
+	void append(const Char* str, PtrSize length)
+	{
+		reserve(length);
+		memcpy(m_str + m_length, str, length);
+		m_length += length;
+		m_str[m_length] = '\0';
+	}
+
+	template<typename... TArgs>
+	void appendFormated(const Char* fmt, TArgs... args)
+	{
+#if ANKI_COMPILER_GCC_COMPATIBLE
+#	pragma GCC diagnostic push
+#	pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#	pragma GCC diagnostic ignored "-Wformat-security"
+#endif
+		const I32 len = snprintf(nullptr, 0, fmt, args...);
+		if(len > 0)
+		{
+			reserve(len);
+			snprintf(m_str + m_length, len + 1, fmt, args...);
+			m_length += len;
+		}
+#if ANKI_COMPILER_GCC_COMPATIBLE
+#	pragma GCC diagnostic pop
+#endif
+	}
+};
+
+template<typename T>
+static void appendFormatedArgument(FormatOutput& out, const Char* fmt, U32 starCount, const Array<I32, 2>& stars, T value)
+{
+	if(starCount == 0)
+	{
+		out.appendFormated(fmt, value);
+	}
+	else if(starCount == 1)
+	{
+		out.appendFormated(fmt, stars[0], value);
+	}
+	else
+	{
+		out.appendFormated(fmt, stars[0], stars[1], value);
+	}
+}
+
+/// Format what packFormatArguments() packed.
+static void formatPackedArguments(const U8* packed, FormatOutput& out)
+{
+	FormatArgumentUnpacker unpacker = {packed};
+	const Char* fmt = unpacker.popString();
+
+	const Char* c = fmt;
+	while(*c)
+	{
+		const Char* percent = strchr(c, '%');
+		if(percent == nullptr)
+		{
+			out.append(c, strlen(c));
+			break;
+		}
+
+		out.append(c, percent - c);
+
+		FormatSpec spec;
+		if(!parseFormatSpec(percent, spec))
+		{
+			out.append(percent, strlen(percent));
+			break;
+		}
+		c = spec.m_end;
+
+		if(spec.m_conversion == '%')
+		{
+			out.append("%", 1);
+			continue;
+		}
+
+		Array<I32, 2> stars = {};
+		for(U32 i = 0; i < spec.m_starCount; ++i)
+		{
+			stars[i] = I32(unpacker.pop<I64>());
+		}
+
+		// Rebuild the spec using the types that were packed
+		Array<Char, 64> specStr;
+		const PtrSize flagsLength = min<PtrSize>(spec.m_lengthBegin - spec.m_begin, specStr.getSize() - 4);
+		memcpy(&specStr[0], spec.m_begin, flagsLength);
+		PtrSize i = flagsLength;
+		if(strchr("diouxX", spec.m_conversion))
+		{
+			specStr[i++] = 'l';
+			specStr[i++] = 'l';
+		}
+		specStr[i++] = spec.m_conversion;
+		specStr[i] = '\0';
+
+		switch(spec.m_conversion)
+		{
+		case 'd':
+		case 'i':
+			appendFormatedArgument(out, &specStr[0], spec.m_starCount, stars, static_cast<long long>(unpacker.pop<I64>()));
+			break;
+		case 'o':
+		case 'u':
+		case 'x':
+		case 'X':
+			appendFormatedArgument(out, &specStr[0], spec.m_starCount, stars, static_cast<unsigned long long>(unpacker.pop<U64>()));
+			break;
+		case 'c':
+			appendFormatedArgument(out, &specStr[0], spec.m_starCount, stars, I32(unpacker.pop<I64>()));
+			break;
+		case 's':
+			appendFormatedArgument(out, &specStr[0], spec.m_starCount, stars, unpacker.popString());
+			break;
+		case 'p':
+			appendFormatedArgument(out, &specStr[0], spec.m_starCount, stars, unpacker.pop<void*>());
+			break;
+		case 'n':
+			break;
+		default:
+			appendFormatedArgument(out, &specStr[0], spec.m_starCount, stars, unpacker.pop<F64>());
+		}
+	}
+}
+
+/// Single producer (the owner thread) single consumer (the logger thread) ring buffer.
+class LoggerThreadRing
+{
+public:
+	static constexpr U32 kSize = 64 * 1024;
+
+	alignas(ANKI_CACHE_LINE_SIZE) Atomic<U64> m_writePos = {0};
+	alignas(ANKI_CACHE_LINE_SIZE) Atomic<U64> m_readPos = {0};
+	Atomic<U32> m_owned = {1}; ///< If it's zero the thread that owned it is gone and another can take it.
+	alignas(8) Array<U8, kSize> m_data;
+
+	/// Get the next message.
+	const AsyncLoggerMessage* peek()
+	{
+		U64 readPos = m_readPos.load();
+		if(readPos == m_writePos.load())
+		{
+			return nullptr;
+		}
+
+		U32 offset = U32(readPos % kSize);
+		const AsyncLoggerMessage* msg = reinterpret_cast<const AsyncLoggerMessage*>(&m_data[offset]);
+		if(msg->m_size == 0)
+		{
+			// Skip the end of the ring
+			readPos += kSize - offset;
+			m_readPos.store(readPos);
+			msg = reinterpret_cast<const AsyncLoggerMessage*>(&m_data[0]);
+		}
+
+		return msg;
+	}
+
+	void pop(const AsyncLoggerMessage& msg)
+	{
+		m_readPos.fetchAdd(msg.m_size);
+	}
+};
+
+/// Releases the ring of a thread when the thread exits.
+class LoggerThreadRingOwner
+{
+public:
+	LoggerThreadRing* m_ring = nullptr;
+
+	~LoggerThreadRingOwner()
+	{
+		if(m_ring && Logger::isAllocated())
+		{
+			m_ring->m_owned.store(0);
+		}
+	}
+};
+
+static thread_local LoggerThreadRingOwner g_threadRingOwner;
+static thread_local Bool g_isLoggerThread = false;
+
 Logger::Logger()
 {
 	addMessageHandler(this, &defaultSystemMessageHandler);
@@ -34,6 +505,13 @@ Logger::Logger()
 
 Logger::~Logger()
 {
+	enableAsync(false);
+
+	for(U32 i = 0; i < m_ringCount.load(); ++i)
+	{
+		m_rings[i]->~LoggerThreadRing();
+		freeAligned(m_rings[i]);
+	}
 }
 
 void Logger::addMessageHandler(void* data, LoggerMessageHandlerCallback callback)
@@ -65,6 +543,11 @@ void Logger::removeMessageHandler(void* data, LoggerMessageHandlerCallback callb
 	}
 }
 
+void Logger::addFileMessageHandler(File* file)
+{
+	addMessageHandler(file, &fileMessageHandler);
+}
+
 void Logger::writeInternal(const Char* file, int line, const Char* func, const Char* subsystem, LoggerMessageType type, const Char* threadName,
 						   const Char* msg)
 {
@@ -107,9 +590,27 @@ void Logger::writeFormated(const Char* file, int line, const Char* func, const C
 		return;
 	}
 
-	Array<Char, 256> buffer;
 	va_list args;
 
+	if(m_asyncEnabled.load())
+	{
+		if(type != LoggerMessageType::kFatal && !g_isLoggerThread)
+		{
+			va_start(args, fmt);
+			const Bool written = writeAsync(file, line, func, subsystem, type, threadName, fmt, args);
+			va_end(args);
+
+			if(written)
+			{
+				return;
+			}
+		}
+
+		// Write the pending messages first to keep the order
+		flush();
+	}
+
+	Array<Char, 256> buffer;
 	va_start(args, fmt);
 	I len = vsnprintf(&buffer[0], sizeof(buffer), fmt, args);
 	if(len < 0)
@@ -140,6 +641,238 @@ void Logger::writeFormated(const Char* file, int line, const Char* func, const C
 	}
 }
 
+void Logger::enableAsync(Bool enable)
+{
+	if(enable == !!m_asyncEnabled.load())
+	{
+		return;
+	}
+
+	if(enable)
+	{
+		m_asyncQuit.store(0);
+		m_asyncThread.start(this, asyncThreadCallback);
+		m_asyncEnabled.store(1);
+	}
+	else
+	{
+		m_asyncEnabled.store(0);
+		flush();
+
+		m_asyncQuit.store(1);
+		wakeAsyncThread();
+		[[maybe_unused]] const Error err = m_asyncThread.join();
+	}
+}
+
+void Logger::flush()
+{
+	if(g_isLoggerThread)
+	{
+		return;
+	}
+
+	// Wait until the logger thread reaches the current end of every ring
+	const U32 ringCount = m_ringCount.load();
+	for(U32 i = 0; i < ringCount; ++i)
+	{
+		const U64 writePos = m_rings[i]->m_writePos.load();
+		while(m_rings[i]->m_readPos.load() < writePos)
+		{
+			wakeAsyncThread();
+			std::this_thread::yield();
+		}
+	}
+}
+
+Bool Logger::writeAsync(const Char* file, int line, const Char* func, const Char* subsystem, LoggerMessageType type, const Char* threadName,
+						const Char* fmt, va_list args)
+{
+	// Pack the message
+	alignas(8) Array<U8, kMaxAsyncLoggerMessageSize> storage;
+	AsyncLoggerMessage& msg = *reinterpret_cast<AsyncLoggerMessage*>(&storage[0]);
+	FormatArgumentPacker packer = {&storage[0], &storage[0] + sizeof(AsyncLoggerMessage), &storage[0] + storage.getSize()};
+
+	va_list argsCopy;
+	va_copy(argsCopy, args);
+	const Bool packed = packFormatArguments(fmt, argsCopy, packer);
+	va_end(argsCopy);
+	if(!packed)
+	{
+		return false;
+	}
+
+	LoggerThreadRing* ring = getOrCreateCurrentThreadRing();
+	if(!ring)
+	{
+		return false;
+	}
+
+	const Char* baseFile = strrchr(file, (ANKI_OS_WINDOWS) ? '\\' : '/');
+	msg.m_size = U32(packer.m_pos - packer.m_begin);
+	msg.m_type = type;
+	msg.m_line = line;
+	msg.m_file = (baseFile) ? baseFile + 1 : file;
+	msg.m_func = func;
+	msg.m_subsystem = subsystem;
+	msg.m_threadName = {};
+	strncpy(&msg.m_threadName[0], threadName, msg.m_threadName.getSize() - 1);
+
+	// Wait for space
+	U64 writePos = ring->m_writePos.load();
+	const U32 offset = U32(writePos % LoggerThreadRing::kSize);
+	const U32 sizeToEnd = LoggerThreadRing::kSize - offset;
+	const U32 requiredSize = msg.m_size + ((sizeToEnd < msg.m_size) ? sizeToEnd : 0);
+	while(writePos + requiredSize - ring->m_readPos.load() > LoggerThreadRing::kSize)
+	{
+		wakeAsyncThread();
+		std::this_thread::yield();
+	}
+
+	// Write it
+	if(sizeToEnd < msg.m_size)
+	{
+		const U32 zero = 0;
+		memcpy(&ring->m_data[offset], &zero, sizeof(zero));
+		writePos += sizeToEnd;
+	}
+
+	msg.m_index = m_asyncMessageIndex.fetchAdd(1);
+	memcpy(&ring->m_data[writePos % LoggerThreadRing::kSize], &msg, msg.m_size);
+	ring->m_writePos.store(writePos + msg.m_size);
+
+	if(m_asyncThreadSleeping.load())
+	{
+		wakeAsyncThread();
+	}
+
+	return true;
+}
+
+LoggerThreadRing* Logger::getOrCreateCurrentThreadRing()
+{
+	if(g_threadRingOwner.m_ring) [[likely]]
+	{
+		return g_threadRingOwner.m_ring;
+	}
+
+	// Try to take the ring of a thread that exited
+	const U32 ringCount = m_ringCount.load();
+	for(U32 i = 0; i < ringCount; ++i)
+	{
+		U32 expected = 0;
+		if(m_rings[i]->m_owned.compareExchange(expected, 1))
+		{
+			g_threadRingOwner.m_ring = m_rings[i];
+			return m_rings[i];
+		}
+	}
+
+	// Create a new one
+	LockGuard lock(m_ringAllocationLock);
+	if(m_ringCount.load() == kMaxThreadRingCount)
+	{
+		return nullptr;
+	}
+
+	void* mem = mallocAligned(sizeof(LoggerThreadRing), alignof(LoggerThreadRing));
+	LoggerThreadRing* ring = ::new(mem) LoggerThreadRing();
+	m_rings[m_ringCount.load()] = ring;
+	m_ringCount.fetchAdd(1);
+
+	g_threadRingOwner.m_ring = ring;
+	return ring;
+}
+
+U32 Logger::dispatchAsyncMessages()
+{
+	U32 count = 0;
+	const U32 ringCount = m_ringCount.load();
+	while(true)
+	{
+		// Get the oldest message of all the rings
+		LoggerThreadRing* ring = nullptr;
+		const AsyncLoggerMessage* msg = nullptr;
+		for(U32 i = 0; i < ringCount; ++i)
+		{
+			const AsyncLoggerMessage* m = m_rings[i]->peek();
+			if(m && (msg == nullptr || m->m_index < msg->m_index))
+			{
+				msg = m;
+				ring = m_rings[i];
+			}
+		}
+
+		if(msg == nullptr)
+		{
+			break;
+		}
+
+		FormatOutput out;
+		formatPackedArguments(reinterpret_cast<const U8*>(msg + 1), out);
+
+		LoggerMessageInfo inf = {msg->m_file, msg->m_line, msg->m_func, msg->m_type, out.m_str, msg->m_subsystem, &msg->m_threadName[0]};
+		{
+			LockGuard<Mutex> lock(m_mutex);
+			U32 handlerCount = m_handlersCount;
+			while(handlerCount-- != 0)
+			{
+				m_handlers[handlerCount].m_callback(m_handlers[handlerCount].m_data, inf);
+			}
+		}
+
+		ring->pop(*msg);
+		++count;
+	}
+
+	return count;
+}
+
+void Logger::wakeAsyncThread()
+{
+	LockGuard<Mutex> lock(m_asyncMtx);
+	m_asyncCondVar.notifyOne();
+}
+
+Error Logger::asyncThreadCallback(ThreadCallbackInfo& info)
+{
+	Logger& self = *static_cast<Logger*>(info.m_userData);
+	g_isLoggerThread = true;
+
+	while(true)
+	{
+		if(self.dispatchAsyncMessages())
+		{
+			continue;
+		}
+
+		if(self.m_asyncQuit.load())
+		{
+			break;
+		}
+
+		// Nothing to do, sleep. Check the rings again after announcing the sleep so a message that was written in the meantime is not missed
+		LockGuard<Mutex> lock(self.m_asyncMtx);
+		self.m_asyncThreadSleeping.store(1);
+
+		Bool empty = !self.m_asyncQuit.load();
+		const U32 ringCount = self.m_ringCount.load();
+		for(U32 i = 0; i < ringCount && empty; ++i)
+		{
+			empty = self.m_rings[i]->m_readPos.load() == self.m_rings[i]->m_writePos.load();
+		}
+
+		if(empty)
+		{
+			self.m_asyncCondVar.wait(self.m_asyncMtx);
+		}
+
+		self.m_asyncThreadSleeping.store(0);
+	}
+
+	return Error::kNone;
+}
+
 void Logger::defaultSystemMessageHandler(void*, const LoggerMessageInfo& info)
 {
 #if ANKI_OS_LINUX
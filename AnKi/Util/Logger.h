@@ -8,11 +8,13 @@
 #include <AnKi/Config.h>
 #include <AnKi/Util/Singleton.h>
 #include <AnKi/Util/Thread.h>
+#include <cstdarg>
 
 namespace anki {
 
 // Forward
 class File;
+class LoggerThreadRing;
 
 /// @addtogroup util_other
 /// @{
@@ -65,16 +67,29 @@ public:
 	/// Add file message handler.
 	void addFileMessageHandler(File* file);
 
-	/// Send a message.
-	void write(const Char* file, int line, const Char* func, const Char* subsystem, LoggerMessageType type, const Char* threadName, const Char* msg)
+	/// Remove a handler added with addFileMessageHandler.
+	void removeFileMessageHandler(File* file)
+	{
+		removeMessageHandler(file, &fileMessageHandler);
+	}
+
+	/// Add or remove the handler that writes to the console of the system (stdout, logcat etc). It's added by default.
+	void enableSystemMessageHandler(Bool enable)
 	{
-		// Note: m_verbosityEnabled is not accessed in a thread-safe way. It doesn't really matter though
-		if(type == LoggerMessageType::kVerbose && !m_verbosityEnabled)
+		if(enable)
 		{
-			return;
+			addMessageHandler(this, &defaultSystemMessageHandler);
 		}
+		else
+		{
+			removeMessageHandler(this, &defaultSystemMessageHandler);
+		}
+	}
 
-		writeInternal(file, line, func, subsystem, type, threadName, msg);
+	/// Send a message.
+	void write(const Char* file, int line, const Char* func, const Char* subsystem, LoggerMessageType type, const Char* threadName, const Char* msg)
+	{
+		writeFormated(file, line, func, subsystem, type, threadName, "%s", msg);
 	}
 
 	/// Send a formated message.
@@ -88,7 +103,18 @@ public:
 		m_verbosityEnabled = enable;
 	}
 
+	/// Enable or disable the asynchronous mode. In that mode the threads only copy the format string and the arguments of the messages to
+	/// per-thread lock-free ring buffers. A background thread formats them and calls the handlers. Fatal messages are always written
+	/// synchronously after flushing the rest.
+	/// @note Not thread-safe with itself.
+	void enableAsync(Bool enable);
+
+	/// Wait until all the messages that were written in the asynchronous mode reach the handlers.
+	void flush();
+
 private:
+	static constexpr U32 kMaxThreadRingCount = 64;
+
 	class Handler
 	{
 	public:
@@ -101,6 +127,18 @@ private:
 	U32 m_handlersCount = 0;
 	Bool m_verbosityEnabled = false;
 
+	// Asynchronous mode
+	Array<LoggerThreadRing*, kMaxThreadRingCount> m_rings = {};
+	Atomic<U32> m_ringCount = {0};
+	SpinLock m_ringAllocationLock;
+	Atomic<U64> m_asyncMessageIndex = {0}; ///< Orders the messages of different threads.
+	Thread m_asyncThread = {"Logger"};
+	Atomic<U32> m_asyncEnabled = {0};
+	Atomic<U32> m_asyncQuit = {0};
+	Atomic<U32> m_asyncThreadSleeping = {0};
+	Mutex m_asyncMtx;
+	ConditionVariable m_asyncCondVar;
+
 	/// Initialize the logger and add the default message handler
 	Logger();
 
@@ -111,6 +149,21 @@ private:
 
 	void writeInternal(const Char* file, int line, const Char* func, const Char* subsystem, LoggerMessageType type, const Char* threadName,
 					   const Char* msg);
+
+	/// Pack a message to the ring of the current thread.
+	/// @return False if the message can't be written asynchronously.
+	Bool writeAsync(const Char* file, int line, const Char* func, const Char* subsystem, LoggerMessageType type, const Char* threadName,
+					const Char* fmt, va_list args);
+
+	LoggerThreadRing* getOrCreateCurrentThreadRing();
+
+	/// Format and dispatch all the messages that are in the rings.
+	/// @return The number of messages.
+	U32 dispatchAsyncMessages();
+
+	void wakeAsyncThread();
+
+	static Error asyncThreadCallback(ThreadCallbackInfo& info);
 };
 
 #define ANKI_LOG(subsystem_, t, ...) \
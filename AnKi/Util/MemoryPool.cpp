@@ -178,6 +178,9 @@ void HeapMemoryPool::destroy()
 	{
 		ANKI_UTIL_LOGE("Memory pool destroyed before all memory being released (%u deallocations missed): %s", count, getName());
 	}
+#if ANKI_STATS_ENABLED
+	m_totalAllocationCount.setNonAtomically(0);
+#endif
 	BaseMemoryPool::destroy();
 }
 
@@ -194,6 +197,9 @@ void* HeapMemoryPool::allocate(PtrSize size, PtrSize alignment)
 	if(mem != nullptr)
 	{
 		m_allocationCount.fetchAdd(1);
+#if ANKI_STATS_ENABLED
+		m_totalAllocationCount.fetchAdd(1);
+#endif
 
 #if ANKI_MEM_EXTRA_CHECKS
 		memset(mem, 0, kAllocationHeaderSize);
@@ -162,7 +162,19 @@ public:
 	/// @param[in, out] ptr Memory block to deallocate.
 	void free(void* ptr);
 
+#if ANKI_STATS_ENABLED
+	/// Return the number of allocations since the pool was initialized. Unlike getAllocationCount() it doesn't decrease on free.
+	U64 getTotalAllocationCount() const
+	{
+		return m_totalAllocationCount.load();
+	}
+#endif
+
 private:
+#if ANKI_STATS_ENABLED
+	Atomic<U64> m_totalAllocationCount = {0};
+#endif
+
 #if ANKI_MEM_EXTRA_CHECKS
 	PoolSignature m_signature = 0;
 #endif
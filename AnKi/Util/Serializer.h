@@ -208,6 +208,15 @@ public:
 	template<typename T, typename TFile>
 	static Error deserialize(T*& x, BaseMemoryPool& pool, TFile& file);
 
+	/// Deserialize a binary that is already in memory without any allocations or copies. The pointers are patched in place.
+	/// @param x The struct. It points inside data.
+	/// @param data The whole binary. It should be writable, aligned to ANKI_SAFE_ALIGNMENT and it should outlive x.
+	template<typename T>
+	static Error deserializeInPlace(T*& x, WeakArray<U8, PtrSize> data);
+
+	/// Check if some data begin with the header of BinarySerializer.
+	static Bool isSerializedBinary(ConstWeakArray<U8, PtrSize> data);
+
 	/// Read a single value. Can't call this directly.
 	template<typename T>
 	void doValue([[maybe_unused]] CString varName, [[maybe_unused]] PtrSize memberOffset, [[maybe_unused]] T& x)
@@ -233,4 +233,66 @@ Error BinaryDeserializer::deserialize(T*& x, BaseMemoryPool& pool, TFile& file)
 	return Error::kNone;
 }
 
+template<typename T>
+Error BinaryDeserializer::deserializeInPlace(T*& x, WeakArray<U8, PtrSize> data)
+{
+	x = nullptr;
+	ANKI_ASSERT(isAligned(ANKI_SAFE_ALIGNMENT, data.getBegin()));
+
+	if(!isSerializedBinary(data))
+	{
+		ANKI_UTIL_LOGE("Wrong magic work in header");
+		return Error::kUserData;
+	}
+
+	const detail::BinarySerializerHeader& header = *reinterpret_cast<const detail::BinarySerializerHeader*>(data.getBegin());
+	const PtrSize dataFilePos = sizeof(header);
+
+	// Sanity checks
+	if(header.m_dataSize < sizeof(T))
+	{
+		ANKI_UTIL_LOGE("Wrong data size");
+		return Error::kUserData;
+	}
+
+	if(header.m_dataSize > data.getSize() - dataFilePos
+	   || (header.m_pointerCount
+		   && (header.m_pointerArrayFilePosition > data.getSize()
+			   || header.m_pointerCount > (data.getSize() - header.m_pointerArrayFilePosition) / sizeof(PtrSize))))
+	{
+		ANKI_UTIL_LOGE("File size doesn't match expectations");
+		return Error::kUserData;
+	}
+
+	// Fix pointers
+	U8* const baseAddress = data.getBegin() + dataFilePos;
+	for(PtrSize i = 0; i < header.m_pointerCount; ++i)
+	{
+		PtrSize offsetFromBeginOfData;
+		memcpy(&offsetFromBeginOfData, data.getBegin() + header.m_pointerArrayFilePosition + i * sizeof(PtrSize), sizeof(PtrSize));
+		if(offsetFromBeginOfData > header.m_dataSize - sizeof(PtrSize))
+		{
+			ANKI_UTIL_LOGE("Corrupt pointer");
+			return Error::kUserData;
+		}
+
+		PtrSize& ptrValue = *reinterpret_cast<PtrSize*>(baseAddress + offsetFromBeginOfData);
+		if(ptrValue >= header.m_dataSize)
+		{
+			ANKI_UTIL_LOGE("Corrupt pointer");
+			return Error::kUserData;
+		}
+
+		ptrValue += ptrToNumber(baseAddress);
+	}
+
+	x = reinterpret_cast<T*>(baseAddress);
+	return Error::kNone;
+}
+
+inline Bool BinaryDeserializer::isSerializedBinary(ConstWeakArray<U8, PtrSize> data)
+{
+	return data.getSize() >= sizeof(detail::BinarySerializerHeader) && memcmp(data.getBegin(), detail::kBinarySerializerMagic, 8) == 0;
+}
+
 } // end namespace anki
@@ -74,6 +74,38 @@ void backtraceInternal(const Function<void(CString)>& lambda)
 #endif
 }
 
+U32 getBacktraceAddresses([[maybe_unused]] WeakArray<void*> addresses)
+{
+#if ANKI_POSIX && !ANKI_OS_ANDROID
+	return U32(::backtrace(addresses.getBegin(), I32(addresses.getSize())));
+#else
+	return 0;
+#endif
+}
+
+void resolveBacktraceAddressesInternal(ConstWeakArray<void*> addresses, const Function<void(CString)>& lambda)
+{
+#if ANKI_POSIX && !ANKI_OS_ANDROID
+	char** strings = backtrace_symbols(const_cast<void* const*>(addresses.getBegin()), I32(addresses.getSize()));
+	if(strings)
+	{
+		for(U32 i = 0; i < addresses.getSize(); ++i)
+		{
+			lambda(strings[i]);
+		}
+
+		free(strings);
+	}
+#else
+	for(const void* address : addresses)
+	{
+		Array<Char, 32> str;
+		snprintf(&str[0], sizeof(str), "%p", address);
+		lambda(&str[0]);
+	}
+#endif
+}
+
 Bool runningFromATerminal()
 {
 #if ANKI_POSIX
@@ -8,6 +8,7 @@
 #include <AnKi/Util/StdTypes.h>
 #include <AnKi/Util/Function.h>
 #include <AnKi/Util/String.h>
+#include <AnKi/Util/WeakArray.h>
 #include <ctime>
 
 namespace anki {
@@ -29,6 +30,22 @@ void backtrace(TFunc func)
 	backtraceInternal(f);
 }
 
+/// Get the return addresses of the call stack without resolving the symbols. It's much cheaper than backtrace().
+/// @return The number of addresses written. It's zero if it's not supported in this OS.
+U32 getBacktraceAddresses(WeakArray<void*> addresses);
+
+/// Resolve the symbols of the addresses returned by getBacktraceAddresses().
+/// @internal
+void resolveBacktraceAddressesInternal(ConstWeakArray<void*> addresses, const Function<void(CString)>& lambda);
+
+/// @copydoc resolveBacktraceAddressesInternal
+template<typename TFunc>
+void resolveBacktraceAddresses(ConstWeakArray<void*> addresses, TFunc func)
+{
+	Function<void(CString)> f(func);
+	resolveBacktraceAddressesInternal(addresses, f);
+}
+
 /// Return true if the engine is running from a terminal emulator.
 Bool runningFromATerminal();
 
@@ -4,10 +4,75 @@
 // http://www.anki3d.org/LICENSE
 
 #include <AnKi/Util/Thread.h>
+#include <AnKi/Util/BitSet.h>
 
 namespace anki {
 
 thread_local Array<Char, Thread::kThreadNameMaxLength + 1> Thread::m_nameTls = {};
+thread_local U32 Thread::m_indexTls = kMaxU32;
+
+/// Hands out the thread indices, the smallest free first. It's trivially destructible so the threads that exit after the static destructors can
+/// still release their index.
+class ThreadIndexAllocator
+{
+public:
+	static constexpr U32 kRecycledIndexCount = 1024; ///< The indices past that are never reused.
+
+	SpinLock m_lock;
+	BitSet<kRecycledIndexCount, U64> m_freeIndices = {true};
+	U32 m_nextIndex = kRecycledIndexCount;
+
+	static ThreadIndexAllocator& getSingleton()
+	{
+		// Function static to avoid the static initialization order problems. Some threads might ask for an index during static initialization
+		static ThreadIndexAllocator allocator;
+		return allocator;
+	}
+
+	U32 allocate()
+	{
+		LockGuard lock(m_lock);
+		U32 idx = m_freeIndices.getLeastSignificantBit();
+		if(idx != kMaxU32) [[likely]]
+		{
+			m_freeIndices.unset(idx);
+		}
+		else
+		{
+			idx = m_nextIndex++;
+		}
+
+		return idx;
+	}
+
+	void free(U32 idx)
+	{
+		if(idx < kRecycledIndexCount)
+		{
+			LockGuard lock(m_lock);
+			ANKI_ASSERT(!m_freeIndices.get(idx));
+			m_freeIndices.set(idx);
+		}
+	}
+};
+
+static_assert(std::is_trivially_destructible_v<ThreadIndexAllocator>);
+
+/// Gives the index of the thread back when the thread exits.
+class Thread::ThreadIndexReleaser
+{
+public:
+	U32 m_index = kMaxU32;
+
+	~ThreadIndexReleaser()
+	{
+		ThreadIndexAllocator::getSingleton().free(m_index);
+
+		// The thread local destructors that run after this one shouldn't use the index that another thread might get. Give them an index that
+		// is too large to have a slot in anything
+		m_indexTls = kMaxU32 - 1;
+	}
+};
 
 Thread::Thread(const Char* name)
 {
@@ -36,4 +101,11 @@ const Char* Thread::getCurrentThreadName()
 	}
 }
 
+U32 Thread::allocateThreadIndex()
+{
+	thread_local ThreadIndexReleaser releaser;
+	releaser.m_index = ThreadIndexAllocator::getSingleton().allocate();
+	return releaser.m_index;
+}
+
 } // end namespace anki
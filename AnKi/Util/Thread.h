@@ -86,6 +86,18 @@ public:
 #endif
 	}
 
+	/// Get a small number that identifies the current thread. The numbers start from zero and the smallest free one is given to the thread that
+	/// first calls this method. The number of a thread is given to another thread after the first exits so the numbers stay close to the number
+	/// of threads that are alive.
+	static U32 getCurrentThreadIndex()
+	{
+		if(m_indexTls == kMaxU32) [[unlikely]]
+		{
+			m_indexTls = allocateThreadIndex();
+		}
+		return m_indexTls;
+	}
+
 	/// Pin to some core.
 	/// @param coreAffintyMask Pin the thread to a number of cores.
 	void pinToCores(const ThreadCoreAffinityMask& coreAffintyMask);
@@ -106,6 +118,7 @@ private:
 	void* m_userData = nullptr; ///< The user date to pass to the callback.
 	Array<Char, kThreadNameMaxLength + 1> m_name = {}; ///< The name of the thread.
 	static thread_local Array<Char, kThreadNameMaxLength + 1> m_nameTls;
+	static thread_local U32 m_indexTls;
 	static constexpr const Char* kDefaultThreadName = "AnKiUnnamed"; ///< the name of an unnamed thread.
 	ThreadCallback m_callback = nullptr; ///< The callback.
 
@@ -113,6 +126,10 @@ private:
 	Bool m_started = false;
 #endif
 
+	class ThreadIndexReleaser;
+
+	static U32 allocateThreadIndex();
+
 #if ANKI_OS_WINDOWS
 	static DWORD ANKI_WINAPI threadCallback(LPVOID ud);
 #endif
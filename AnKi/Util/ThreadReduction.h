@@ -0,0 +1,203 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Util/Thread.h>
+#include <AnKi/Util/Functions.h>
+
+namespace anki {
+
+/// @addtogroup util_thread
+/// @{
+
+/// Sum operation for ThreadReduction.
+class ThreadReductionSum
+{
+public:
+	template<typename T>
+	T operator()(const T& a, const T& b) const
+	{
+		return a + b;
+	}
+};
+
+/// Min operation for ThreadReduction.
+class ThreadReductionMin
+{
+public:
+	template<typename T>
+	T operator()(const T& a, const T& b) const
+	{
+		return min(a, b);
+	}
+};
+
+/// Max operation for ThreadReduction.
+class ThreadReductionMax
+{
+public:
+	template<typename T>
+	T operator()(const T& a, const T& b) const
+	{
+		return max(a, b);
+	}
+};
+
+/// Combines (sum, min, max etc) values that many threads produce without contention. Every thread updates its own cache line sized slot and the
+/// slots are combined only when the result is needed (usually once per frame).
+/// For arithmetic types the slots are atomics and all methods are thread-safe. For other types reduce(), consume() and reset() shouldn't run in
+/// parallel with update().
+/// @tparam TOp Functor that combines 2 values. It should be associative and commutative.
+/// @tparam kThreadSlotCount The threads with an index (see Thread::getCurrentThreadIndex()) larger than that share a single slot.
+template<typename T, typename TOp, U32 kThreadSlotCount = 32>
+class ThreadReduction
+{
+public:
+	/// @param identity The value that doesn't change the result when combined (eg 0 for sums).
+	ThreadReduction(const T& identity, const TOp& op = TOp())
+		: m_identity(identity)
+		, m_op(op)
+	{
+		for(Slot& slot : m_slots)
+		{
+			initSlot(slot);
+		}
+	}
+
+	ThreadReduction(const ThreadReduction&) = delete; // Non-copyable
+
+	ThreadReduction& operator=(const ThreadReduction&) = delete; // Non-copyable
+
+	/// Combine a value with the slot of the current thread.
+	/// @note Thread-safe.
+	void update(const T& value)
+	{
+		const U32 idx = Thread::getCurrentThreadIndex();
+		if(idx < kThreadSlotCount) [[likely]]
+		{
+			updateSlot(m_slots[idx], value);
+		}
+		else if constexpr(kAtomicSlots)
+		{
+			updateSlot(m_slots[kThreadSlotCount], value);
+		}
+		else
+		{
+			LockGuard lock(m_sharedSlotLock);
+			updateSlot(m_slots[kThreadSlotCount], value);
+		}
+	}
+
+	/// Same as update() but the threads that don't have a slot of their own don't touch the shared slot. The caller can fall back to something
+	/// else for them.
+	/// @return False if the current thread doesn't have a slot.
+	/// @note Thread-safe.
+	Bool tryUpdate(const T& value)
+	{
+		const U32 idx = Thread::getCurrentThreadIndex();
+		if(idx < kThreadSlotCount) [[likely]]
+		{
+			updateSlot(m_slots[idx], value);
+			return true;
+		}
+
+		return false;
+	}
+
+	/// Combine the slots of all threads.
+	T reduce() const
+	{
+		T out = m_identity;
+		for(const Slot& slot : m_slots)
+		{
+			if constexpr(kAtomicSlots)
+			{
+				out = m_op(out, slot.m_value.load());
+			}
+			else
+			{
+				out = m_op(out, slot.m_value);
+			}
+		}
+		return out;
+	}
+
+	/// Combine the slots of all threads and reset them to the identity value.
+	T consume()
+	{
+		T out = m_identity;
+		for(Slot& slot : m_slots)
+		{
+			if constexpr(kAtomicSlots)
+			{
+				out = m_op(out, slot.m_value.exchange(m_identity));
+			}
+			else
+			{
+				out = m_op(out, slot.m_value);
+				slot.m_value = m_identity;
+			}
+		}
+		return out;
+	}
+
+	void reset()
+	{
+		for(Slot& slot : m_slots)
+		{
+			initSlot(slot);
+		}
+	}
+
+private:
+	static constexpr Bool kAtomicSlots = std::is_arithmetic_v<T>;
+
+	class alignas(ANKI_CACHE_LINE_SIZE) Slot
+	{
+	public:
+		std::conditional_t<kAtomicSlots, Atomic<T>, T> m_value;
+	};
+
+	Array<Slot, kThreadSlotCount + 1> m_slots; ///< The last is shared between the threads that don't have a slot.
+	T m_identity;
+	TOp m_op;
+	SpinLock m_sharedSlotLock; ///< Only used for the non-atomic slots.
+
+	void initSlot(Slot& slot)
+	{
+		if constexpr(kAtomicSlots)
+		{
+			slot.m_value.store(m_identity);
+		}
+		else
+		{
+			slot.m_value = m_identity;
+		}
+	}
+
+	void updateSlot(Slot& slot, const T& value)
+	{
+		if constexpr(std::is_integral_v<T> && std::is_same_v<TOp, ThreadReductionSum>)
+		{
+			slot.m_value.fetchAdd(value);
+		}
+		else if constexpr(kAtomicSlots)
+		{
+			// The slot is almost never contended so the loop will run once
+			T expected = slot.m_value.load();
+			while(!slot.m_value.compareExchange(expected, m_op(expected, value)))
+			{
+			}
+		}
+		else
+		{
+			slot.m_value = m_op(slot.m_value, value);
+		}
+	}
+};
+/// @}
+
+} // end namespace anki
@@ -74,6 +74,8 @@ typedef struct _CONSOLE_SCREEN_BUFFER_INFO CONSOLE_SCREEN_BUFFER_INFO, *PCONSOLE
 
 typedef struct _SYSTEM_INFO SYSTEM_INFO, *LPSYSTEM_INFO;
 
+typedef struct _OVERLAPPED OVERLAPPED, *LPOVERLAPPED;
+
 // Thread & locks
 ANKI_WINBASEAPI HANDLE ANKI_WINAPI CreateThread(LPSECURITY_ATTRIBUTES lpThreadAttributes, SIZE_T dwStackSize, LPTHREAD_START_ROUTINE lpStartAddress,
 												LPVOID lpParameter, DWORD dwCreationFlags, LPDWORD lpThreadId);
@@ -114,6 +116,14 @@ ANKI_WINBASEAPI HANDLE ANKI_WINAPI FindFirstFileA(LPCSTR lpFileName, LPWIN32_FIN
 ANKI_WINBASEAPI BOOL ANKI_WINAPI FindClose(HANDLE hFindFile);
 ANKI_WINBASEAPI BOOL ANKI_WINAPI FindNextFileA(HANDLE hFindFile, LPWIN32_FIND_DATAA lpFindFileData);
 ANKI_WINBASEAPI DWORD ANKI_WINAPI GetTempPathA(DWORD nBufferLength, LPSTR lpBuffer);
+ANKI_WINBASEAPI BOOL ANKI_WINAPI ReadFile(HANDLE hFile, LPVOID lpBuffer, DWORD nNumberOfBytesToRead, LPDWORD lpNumberOfBytesRead,
+										  LPOVERLAPPED lpOverlapped);
+ANKI_WINBASEAPI HANDLE ANKI_WINAPI CreateFileMappingA(HANDLE hFile, LPSECURITY_ATTRIBUTES lpFileMappingAttributes, DWORD flProtect,
+													  DWORD dwMaximumSizeHigh, DWORD dwMaximumSizeLow, LPCSTR lpName);
+ANKI_WINBASEAPI LPVOID ANKI_WINAPI MapViewOfFile(HANDLE hFileMappingObject, DWORD dwDesiredAccess, DWORD dwFileOffsetHigh, DWORD dwFileOffsetLow,
+												 SIZE_T dwNumberOfBytesToMap);
+ANKI_WINBASEAPI BOOL ANKI_WINAPI UnmapViewOfFile(LPCVOID lpBaseAddress);
+ANKI_WINBASEAPI BOOL ANKI_WINAPI SetFilePointerEx(HANDLE hFile, LARGE_INTEGER liDistanceToMove, LARGE_INTEGER* lpNewFilePointer, DWORD dwMoveMethod);
 
 // Other
 ANKI_WINBASEAPI DWORD ANKI_WINAPI GetLastError(VOID);
@@ -177,6 +187,10 @@ constexpr DWORD FORMAT_MESSAGE_ARGUMENT_ARRAY = 0x00002000;
 constexpr DWORD FORMAT_MESSAGE_MAX_WIDTH_MASK = 0x000000FF;
 constexpr DWORD LANG_NEUTRAL = 0x00;
 constexpr DWORD SUBLANG_DEFAULT = 0x01;
+constexpr DWORD PAGE_READONLY = 0x02;
+constexpr DWORD FILE_MAP_READ = 0x0004;
+constexpr DWORD FILE_BEGIN = 0;
+constexpr DWORD FILE_CURRENT = 1;
 
 // Types
 typedef union _LARGE_INTEGER
@@ -321,6 +335,22 @@ typedef struct _SYSTEM_INFO
 	WORD wProcessorRevision;
 } SYSTEM_INFO, *LPSYSTEM_INFO;
 
+typedef struct _OVERLAPPED
+{
+	ULONG_PTR Internal;
+	ULONG_PTR InternalHigh;
+	union
+	{
+		struct
+		{
+			DWORD Offset;
+			DWORD OffsetHigh;
+		};
+		PVOID Pointer;
+	};
+	HANDLE hEvent;
+} OVERLAPPED, *LPOVERLAPPED;
+
 // Critical section
 inline void InitializeCriticalSection(LPCRITICAL_SECTION lpCriticalSection)
 {
@@ -446,6 +476,36 @@ inline DWORD GetTempPathA(DWORD nBufferLength, LPSTR lpBuffer)
 	return ::GetTempPathA(nBufferLength, lpBuffer);
 }
 
+inline BOOL ReadFile(HANDLE hFile, LPVOID lpBuffer, DWORD nNumberOfBytesToRead, LPDWORD lpNumberOfBytesRead, LPOVERLAPPED lpOverlapped)
+{
+	return ::ReadFile(hFile, lpBuffer, nNumberOfBytesToRead, lpNumberOfBytesRead, reinterpret_cast<::LPOVERLAPPED>(lpOverlapped));
+}
+
+inline HANDLE CreateFileMappingA(HANDLE hFile, LPSECURITY_ATTRIBUTES lpFileMappingAttributes, DWORD flProtect, DWORD dwMaximumSizeHigh,
+								 DWORD dwMaximumSizeLow, LPCSTR lpName)
+{
+	return ::CreateFileMappingA(hFile, reinterpret_cast<::LPSECURITY_ATTRIBUTES>(lpFileMappingAttributes), flProtect, dwMaximumSizeHigh,
+								dwMaximumSizeLow, lpName);
+}
+
+inline LPVOID MapViewOfFile(HANDLE hFileMappingObject, DWORD dwDesiredAccess, DWORD dwFileOffsetHigh, DWORD dwFileOffsetLow,
+							SIZE_T dwNumberOfBytesToMap)
+{
+	return ::MapViewOfFile(hFileMappingObject, dwDesiredAccess, dwFileOffsetHigh, dwFileOffsetLow, dwNumberOfBytesToMap);
+}
+
+inline BOOL UnmapViewOfFile(LPCVOID lpBaseAddress)
+{
+	return ::UnmapViewOfFile(lpBaseAddress);
+}
+
+inline BOOL SetFilePointerEx(HANDLE hFile, LARGE_INTEGER liDistanceToMove, LARGE_INTEGER* lpNewFilePointer, DWORD dwMoveMethod)
+{
+	::LARGE_INTEGER distance;
+	distance.QuadPart = liDistanceToMove.QuadPart;
+	return ::SetFilePointerEx(hFile, distance, reinterpret_cast<::LARGE_INTEGER*>(lpNewFilePointer), dwMoveMethod);
+}
+
 // Other
 inline BOOL QueryPerformanceFrequency(LARGE_INTEGER* lpFrequency)
 {
@@ -41,6 +41,18 @@ public:
 		return m_mouseBtns[i];
 	}
 
+	/// Override the state of a key. Useful for replaying recorded input.
+	void setKey(KeyCode i, U32 value)
+	{
+		m_keys[i] = value;
+	}
+
+	/// Override the state of a mouse button. Useful for replaying recorded input.
+	void setMouseButton(MouseButton i, U32 value)
+	{
+		m_mouseBtns[i] = value;
+	}
+
 	const Vec2& getMousePosition() const
 	{
 		return m_mousePosNdc;
@@ -0,0 +1,278 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Collision.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <random>
+#include <vector>
+
+using namespace anki;
+
+namespace {
+
+/// Random shapes in scalar and SoA form.
+class Shapes
+{
+public:
+	std::vector<Aabb> m_aabbs;
+	std::vector<Sphere> m_spheres;
+	std::vector<Obb> m_obbs;
+
+	Array<std::vector<F32>, 6> m_aabbData;
+	Array<std::vector<F32>, 4> m_sphereData;
+	Array<std::vector<F32>, 15> m_obbData;
+
+	AabbSoa m_aabbSoa;
+	SphereSoa m_sphereSoa;
+	ObbSoa m_obbSoa;
+
+	Shapes(U32 count, F32 worldSize, U32 seed)
+	{
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<F32> posDist(-worldSize, worldSize);
+		std::uniform_real_distribution<F32> sizeDist(0.1f, 5.0f);
+		std::uniform_real_distribution<F32> angleDist(-kPi, kPi);
+
+		for(U32 i = 0; i < count; ++i)
+		{
+			const Vec3 pos(posDist(gen), posDist(gen), posDist(gen));
+			const Vec3 size(sizeDist(gen), sizeDist(gen), sizeDist(gen));
+			m_aabbs.emplace_back(pos, pos + size);
+			m_spheres.emplace_back(pos, size.x());
+			const Mat3 rot(Euler(angleDist(gen), angleDist(gen), angleDist(gen)));
+			m_obbs.emplace_back(pos.xyz0(), Mat3x4(Vec3(0.0f), rot), size.xyz0());
+
+			for(U32 c = 0; c < 3; ++c)
+			{
+				m_aabbData[c].push_back(m_aabbs.back().getMin()[c]);
+				m_aabbData[c + 3].push_back(m_aabbs.back().getMax()[c]);
+				m_sphereData[c].push_back(pos[c]);
+				m_obbData[c].push_back(pos[c]);
+				m_obbData[c + 12].push_back(size[c]);
+				for(U32 c2 = 0; c2 < 3; ++c2)
+				{
+					m_obbData[3 + c * 3 + c2].push_back(rot(c, c2));
+				}
+			}
+			m_sphereData[3].push_back(size.x());
+		}
+
+		for(U32 c = 0; c < 3; ++c)
+		{
+			m_aabbSoa.m_min[c] = m_aabbData[c].data();
+			m_aabbSoa.m_max[c] = m_aabbData[c + 3].data();
+			m_sphereSoa.m_center[c] = m_sphereData[c].data();
+			m_obbSoa.m_center[c] = m_obbData[c].data();
+			m_obbSoa.m_extend[c] = m_obbData[c + 12].data();
+		}
+		for(U32 r = 0; r < 9; ++r)
+		{
+			m_obbSoa.m_rotation[r] = m_obbData[3 + r].data();
+		}
+		m_sphereSoa.m_radius = m_sphereData[3].data();
+		m_aabbSoa.m_count = m_sphereSoa.m_count = m_obbSoa.m_count = count;
+	}
+};
+
+} // end anonymous namespace
+
+/// Compare the bitmask and the index variants of a batched test with the scalar test.
+template<typename TQuery, typename TSoa, typename TShape>
+static U32 compareBatched(const TQuery& query, const TSoa& soa, const std::vector<TShape>& shapes)
+{
+	const U32 count = soa.m_count;
+	std::vector<U64> mask((count + 63) / 64);
+	testCollision(query, soa, WeakArray<U64>(mask.data(), U32(mask.size())));
+
+	std::vector<U32> indices(count);
+	const U32 hitCount = testCollision(query, soa, WeakArray<U32>(indices.data(), count));
+
+	U32 expectedCount = 0;
+	U32 mismatchCount = 0;
+	for(U32 i = 0; i < count; ++i)
+	{
+		const Bool expected = testCollision(query, shapes[i]);
+		const Bool inMask = (mask[i / 64] >> (i % 64)) & 1;
+		if(expected)
+		{
+			ANKI_TEST_EXPECT_LT(expectedCount, hitCount);
+			mismatchCount += (indices[expectedCount] != i);
+			++expectedCount;
+		}
+		mismatchCount += (expected != inMask);
+	}
+
+	ANKI_TEST_EXPECT_EQ(hitCount, expectedCount);
+	return mismatchCount;
+}
+
+ANKI_TEST(Collision, FunctionsBatched)
+{
+	constexpr U32 kCount = 1001; // Not a multiple of 4 on purpose
+	const Shapes shapes(kCount, 50.0f, 123);
+
+	std::mt19937 gen(321);
+	std::uniform_real_distribution<F32> posDist(-50.0f, 50.0f);
+	std::uniform_real_distribution<F32> sizeDist(1.0f, 20.0f);
+
+	for(U32 q = 0; q < 20; ++q)
+	{
+		const Vec3 pos(posDist(gen), posDist(gen), posDist(gen));
+		const Aabb aabb(pos, pos + Vec3(sizeDist(gen), sizeDist(gen), sizeDist(gen)));
+		const Sphere sphere(pos, sizeDist(gen));
+
+		ANKI_TEST_EXPECT_EQ(compareBatched(aabb, shapes.m_aabbSoa, shapes.m_aabbs), 0);
+		ANKI_TEST_EXPECT_EQ(compareBatched(aabb, shapes.m_sphereSoa, shapes.m_spheres), 0);
+		ANKI_TEST_EXPECT_EQ(compareBatched(sphere, shapes.m_aabbSoa, shapes.m_aabbs), 0);
+		ANKI_TEST_EXPECT_EQ(compareBatched(sphere, shapes.m_sphereSoa, shapes.m_spheres), 0);
+
+		// The scalar OBB tests use GJK which is approximate so allow a few disagreements on shapes that barely touch
+		ANKI_TEST_EXPECT_LEQ(compareBatched(aabb, shapes.m_obbSoa, shapes.m_obbs), 2);
+		ANKI_TEST_EXPECT_LEQ(compareBatched(sphere, shapes.m_obbSoa, shapes.m_obbs), 2);
+
+		// Planes
+		const Plane plane(Vec4(Vec3(posDist(gen), posDist(gen), posDist(gen)).getNormalized(), 0.0f), posDist(gen));
+		std::vector<F32> distances(kCount);
+		const WeakArray<F32> distancesArr(distances.data(), kCount);
+
+		testPlane(plane, shapes.m_aabbSoa, distancesArr);
+		for(U32 i = 0; i < kCount; ++i)
+		{
+			ANKI_TEST_EXPECT_NEAR(distances[i], testPlane(plane, shapes.m_aabbs[i]), 0.001f);
+		}
+
+		testPlane(plane, shapes.m_sphereSoa, distancesArr);
+		for(U32 i = 0; i < kCount; ++i)
+		{
+			ANKI_TEST_EXPECT_NEAR(distances[i], testPlane(plane, shapes.m_spheres[i]), 0.001f);
+		}
+
+		testPlane(plane, shapes.m_obbSoa, distancesArr);
+		for(U32 i = 0; i < kCount; ++i)
+		{
+			ANKI_TEST_EXPECT_NEAR(distances[i], testPlane(plane, shapes.m_obbs[i]), 0.001f);
+		}
+	}
+
+	// Broadphase
+	const Shapes otherShapes(333, 50.0f, 456);
+	std::vector<Array<U32, 2>> pairs(kCount * 8);
+	const U32 pairCount = findCollidingPairs(shapes.m_aabbSoa, otherShapes.m_aabbSoa, WeakArray<Array<U32, 2>>(pairs.data(), U32(pairs.size())));
+	ANKI_TEST_EXPECT_LEQ(pairCount, pairs.size());
+
+	U32 expectedPairCount = 0;
+	for(U32 a = 0; a < kCount; ++a)
+	{
+		for(U32 b = 0; b < otherShapes.m_aabbSoa.m_count; ++b)
+		{
+			if(testCollision(shapes.m_aabbs[a], otherShapes.m_aabbs[b]))
+			{
+				ANKI_TEST_EXPECT_EQ(pairs[expectedPairCount][0], a);
+				ANKI_TEST_EXPECT_EQ(pairs[expectedPairCount][1], b);
+				++expectedPairCount;
+			}
+		}
+	}
+	ANKI_TEST_EXPECT_EQ(pairCount, expectedPairCount);
+}
+
+ANKI_TEST(Collision, FunctionsBatchedBench)
+{
+	constexpr U32 kCount = 100'000;
+	constexpr U32 kQueryCount = 100;
+	const Shapes shapes(kCount, 500.0f, 123);
+	const Aabb aabb(Vec3(-50.0f), Vec3(50.0f));
+	const Sphere sphere(Vec3(10.0f), 50.0f);
+
+	std::vector<U32> indices(kCount);
+	const WeakArray<U32> indicesArr(indices.data(), kCount);
+
+	auto bench = [&](const Char* name, auto batchedFunc, auto scalarFunc) {
+		U32 batchedHits = 0;
+		Second begin = HighRezTimer::getCurrentTime();
+		for(U32 q = 0; q < kQueryCount; ++q)
+		{
+			batchedHits += batchedFunc();
+		}
+		const Second batchedTime = HighRezTimer::getCurrentTime() - begin;
+
+		U32 scalarHits = 0;
+		begin = HighRezTimer::getCurrentTime();
+		for(U32 q = 0; q < kQueryCount; ++q)
+		{
+			for(U32 i = 0; i < kCount; ++i)
+			{
+				scalarHits += scalarFunc(i);
+			}
+		}
+		const Second scalarTime = HighRezTimer::getCurrentTime() - begin;
+
+		const F64 shapeCount = F64(kCount) * kQueryCount;
+		ANKI_TEST_LOGI("%s: batched %.1f shapes/ms, scalar %.1f shapes/ms (%u/%u hits)", name, shapeCount / (batchedTime * 1000.0),
+					   shapeCount / (scalarTime * 1000.0), batchedHits, scalarHits);
+	};
+
+	bench(
+		"AABB vs AABBs",
+		[&]() {
+			return testCollision(aabb, shapes.m_aabbSoa, indicesArr);
+		},
+		[&](U32 i) {
+			return testCollision(aabb, shapes.m_aabbs[i]);
+		});
+
+	bench(
+		"Sphere vs spheres",
+		[&]() {
+			return testCollision(sphere, shapes.m_sphereSoa, indicesArr);
+		},
+		[&](U32 i) {
+			return testCollision(sphere, shapes.m_spheres[i]);
+		});
+
+	bench(
+		"Sphere vs AABBs",
+		[&]() {
+			return testCollision(sphere, shapes.m_aabbSoa, indicesArr);
+		},
+		[&](U32 i) {
+			return testCollision(sphere, shapes.m_aabbs[i]);
+		});
+
+	bench(
+		"AABB vs OBBs",
+		[&]() {
+			return testCollision(aabb, shapes.m_obbSoa, indicesArr);
+		},
+		[&](U32 i) {
+			return testCollision(aabb, shapes.m_obbs[i]);
+		});
+
+	bench(
+		"Sphere vs OBBs",
+		[&]() {
+			return testCollision(sphere, shapes.m_obbSoa, indicesArr);
+		},
+		[&](U32 i) {
+			return testCollision(sphere, shapes.m_obbs[i]);
+		});
+}
+
+ANKI_BENCHMARK(Collision, AabbVsAabbsBatched)
+{
+	constexpr U32 kCount = 10'000;
+	const Shapes shapes(kCount, 500.0f, 123);
+	const Aabb aabb(Vec3(-50.0f), Vec3(50.0f));
+
+	std::vector<U32> indices(kCount);
+	const WeakArray<U32> indicesArr(indices.data(), kCount);
+
+	while(bench.keepRunning())
+	{
+		const U32 hits = testCollision(aabb, shapes.m_aabbSoa, indicesArr);
+		doNotOptimizeAway(hits);
+	}
+}
@@ -0,0 +1,69 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Core/AllocationProfiler.h>
+#include <AnKi/Util/Filesystem.h>
+
+ANKI_TEST(Core, AllocationProfiler)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	CoreMemoryPool::allocateSingleton(allocAligned, nullptr);
+	g_allocationProfilerStackSamplingCVar.set(1);
+	AllocationProfiler::allocateSingleton(allocAligned, nullptr);
+
+	{
+		AllocAlignedCallback allocCb;
+		void* allocCbUserData;
+		AllocationProfiler::getSingleton().getPoolAllocationCallback("PoolA", allocCb, allocCbUserData);
+		HeapMemoryPool poolA(allocCb, allocCbUserData);
+		AllocationProfiler::getSingleton().getPoolAllocationCallback("PoolB", allocCb, allocCbUserData);
+		HeapMemoryPool poolB(allocCb, allocCbUserData);
+
+		void* a = poolA.allocate(100, 128);
+		ANKI_TEST_EXPECT_EQ(ptrToNumber(a) % 128, 0);
+		void* b = poolA.allocate(20, 4);
+		poolA.free(b);
+		void* c = poolB.allocate(64, 16);
+
+		AllocationProfiler::getSingleton().endFrame();
+
+		U32 poolCount = 0;
+		AllocationProfiler::getSingleton().iteratePools([&](CString name, const AllocationProfilerStats& stats) {
+			if(name == "PoolA")
+			{
+				ANKI_TEST_EXPECT_EQ(stats.m_liveBytes, 100);
+				ANKI_TEST_EXPECT_EQ(stats.m_allocationCount, 2);
+				ANKI_TEST_EXPECT_EQ(stats.m_frameAllocationCount, 2);
+				ANKI_TEST_EXPECT_EQ(stats.m_frameFreeCount, 1);
+			}
+			else
+			{
+				ANKI_TEST_EXPECT_EQ(stats.m_liveBytes, 64);
+				ANKI_TEST_EXPECT_EQ(stats.m_frameAllocationCount, 1);
+			}
+			++poolCount;
+		});
+		ANKI_TEST_EXPECT_EQ(poolCount, 2);
+		ANKI_TEST_EXPECT_GT(AllocationProfiler::getSingleton().getFrameAllocatingSiteCount(), 0);
+
+		// A frame without allocations
+		AllocationProfiler::getSingleton().endFrame();
+		ANKI_TEST_EXPECT_EQ(AllocationProfiler::getSingleton().getFrameAllocatingSiteCount(), 0);
+
+		String filename;
+		ANKI_TEST_EXPECT_NO_ERR(getTempDirectory(filename));
+		filename += "/AllocationProfile.txt";
+		ANKI_TEST_EXPECT_NO_ERR(AllocationProfiler::getSingleton().dump(filename));
+
+		poolA.free(a);
+		poolB.free(c);
+	}
+
+	AllocationProfiler::freeSingleton();
+	g_allocationProfilerStackSamplingCVar.set(0);
+	CoreMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
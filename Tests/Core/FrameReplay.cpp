@@ -0,0 +1,201 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Core/FrameReplay.h>
+#include <AnKi/Core/CoreTracer.h>
+#include <AnKi/Scene/SceneGraph.h>
+#include <AnKi/Window/Input.h>
+#include <AnKi/Window/NativeWindow.h>
+#include <AnKi/Util/Filesystem.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/Tracer.h>
+
+namespace anki {
+namespace {
+
+constexpr U32 kFrameCount = 3;
+
+/// The input and the camera of a recorded frame. Each frame is a bit different.
+class TestFrame
+{
+public:
+	U32 m_idx;
+
+	Second getDeltaTime() const
+	{
+		return Second(m_idx + 1) / 60.0;
+	}
+
+	Vec2 getMousePosition() const
+	{
+		return Vec2(0.1f, -0.2f) * F32(m_idx);
+	}
+
+	Transform getCameraTransform() const
+	{
+		const F32 f = F32(m_idx);
+		return Transform(Vec3(f, 2.0f * f, 3.0f * f), Mat3(Euler(0.0f, 0.5f * f, 0.0f)), Vec3(1.0f));
+	}
+
+	void setInput() const
+	{
+		Input& input = Input::getSingleton();
+		input.reset();
+		input.setKey(KeyCode::kW, m_idx + 1);
+		if(m_idx == 1)
+		{
+			input.setKey(KeyCode::kA, 1);
+		}
+		input.setMouseButton(MouseButton::kLeft, m_idx); // Not pressed in the 1st frame
+		input.moveCursor(getMousePosition());
+	}
+
+	void checkInput() const
+	{
+		const Input& input = Input::getSingleton();
+		ANKI_TEST_EXPECT_EQ(input.getKey(KeyCode::kW), m_idx + 1);
+		ANKI_TEST_EXPECT_EQ(input.getKey(KeyCode::kA), (m_idx == 1) ? 1u : 0u);
+		ANKI_TEST_EXPECT_EQ(input.getKey(KeyCode::kSpace), 0);
+		ANKI_TEST_EXPECT_EQ(input.getMouseButton(MouseButton::kLeft), m_idx);
+		ANKI_TEST_EXPECT_EQ(input.getMouseButton(MouseButton::kRight), 0);
+		ANKI_TEST_EXPECT_EQ(input.getMousePosition(), getMousePosition());
+	}
+};
+
+} // namespace
+} // namespace anki
+
+ANKI_TEST(Core, FrameReplay)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	CoreMemoryPool::allocateSingleton(allocAligned, nullptr);
+	GrMemoryPool::allocateSingleton(allocAligned, nullptr); // For the node dictionary
+	SceneMemoryPool::allocateSingleton(allocAligned, nullptr);
+	GlobalFrameIndex::allocateSingleton();
+	TransformHierarchy::allocateSingleton();
+	SceneGraph& scene = SceneGraph::allocateSingleton();
+	NativeWindowInitInfo nwinit;
+	ANKI_TEST_EXPECT_NO_ERR(NativeWindow::allocateSingleton().init(nwinit));
+	Input& input = Input::allocateSingleton();
+
+	{
+		SceneNode* camera;
+		ANKI_TEST_EXPECT_NO_ERR(scene.newSceneNode("Camera", camera));
+		scene.setActiveCameraNode(camera);
+
+		String dir;
+		ANKI_TEST_EXPECT_NO_ERR(getTempDirectory(dir));
+		dir += "/FrameReplay";
+		if(directoryExists(dir))
+		{
+			ANKI_TEST_EXPECT_NO_ERR(removeDirectory(dir));
+		}
+		ANKI_TEST_EXPECT_NO_ERR(createDirectory(dir));
+		String recordingFilename;
+		recordingFilename.sprintf("%s/FrameReplay.bin", dir.cstr());
+
+		// Record
+		{
+			FrameReplay recorder;
+			ANKI_TEST_EXPECT_NO_ERR(recorder.initRecording(recordingFilename));
+			ANKI_TEST_EXPECT_EQ(recorder.isRecording(), true);
+
+			for(U32 i = 0; i < kFrameCount; ++i)
+			{
+				const TestFrame frame = {i};
+				frame.setInput();
+				camera->setLocalTransform(frame.getCameraTransform());
+				recorder.recordFrame(frame.getDeltaTime());
+			}
+
+			ANKI_TEST_EXPECT_NO_ERR(recorder.writeRecording());
+		}
+
+#if ANKI_TRACING_ENABLED
+		// The report sums the events of each frame
+		const Bool tracingEnabled = g_tracingEnabledCVar;
+		g_tracingEnabledCVar.set(true);
+		ANKI_TEST_EXPECT_NO_ERR(CoreTracer::allocateSingleton().init(dir));
+		String reportFilename;
+		reportFilename.sprintf("%s/FrameReplayReport.csv", dir.cstr());
+		constexpr Array<CString, 2> kReportEvents = {"Frame", "SceneUpdate"};
+		CoreTracer::getSingleton().enableEventReport(reportFilename, kReportEvents);
+#endif
+
+		// Replay in a clean state
+		input.reset();
+		camera->setLocalTransform(Transform::getIdentity());
+
+		{
+			FrameReplay replayer;
+			ANKI_TEST_EXPECT_NO_ERR(replayer.initReplay(recordingFilename));
+			ANKI_TEST_EXPECT_EQ(replayer.isReplaying(), true);
+
+			for(U32 i = 0; i < kFrameCount; ++i)
+			{
+				const TestFrame frame = {i};
+
+				Second deltaTime = 0.0;
+				ANKI_TEST_EXPECT_EQ(replayer.replayInput(deltaTime), true);
+				ANKI_TEST_EXPECT_EQ(deltaTime, frame.getDeltaTime());
+				frame.checkInput();
+
+				// The user code moves the camera and the replay overrides it
+				camera->setLocalTransform(Transform::getIdentity());
+				replayer.replayCamera();
+				ANKI_TEST_EXPECT_EQ(camera->getLocalTransform(), frame.getCameraTransform());
+
+#if ANKI_TRACING_ENABLED
+				const Second now = HighRezTimer::getCurrentTime();
+				ANKI_TRACE_CUSTOM_EVENT(Frame, now, deltaTime);
+				ANKI_TRACE_CUSTOM_EVENT(SceneUpdate, now, 0.5_ms);
+				ANKI_TRACE_CUSTOM_EVENT(SceneUpdate, now, 0.5_ms);
+				CoreTracer::getSingleton().flushFrame(i);
+#endif
+			}
+
+			Second deltaTime;
+			ANKI_TEST_EXPECT_EQ(replayer.replayInput(deltaTime), false);
+		}
+
+#if ANKI_TRACING_ENABLED
+		// Writes the report
+		CoreTracer::freeSingleton();
+		g_tracingEnabledCVar.set(tracingEnabled);
+
+		// A row per replayed frame with the recorded frame time
+		String expected = "Frame,Frame (ms),SceneUpdate (ms)\n";
+		Second sum = 0.0;
+		for(U32 i = 0; i < kFrameCount; ++i)
+		{
+			const TestFrame frame = {i};
+			expected += String().sprintf("%u,%f,%f\n", i, frame.getDeltaTime() * 1000.0, 1.0);
+			sum += frame.getDeltaTime();
+		}
+		expected += String().sprintf("Mean,%f,%f\n", sum / Second(kFrameCount) * 1000.0, 1.0);
+		expected += String().sprintf("Median,%f,%f\n", TestFrame{kFrameCount / 2}.getDeltaTime() * 1000.0, 1.0);
+		expected += String().sprintf("P95,%f,%f\n", TestFrame{kFrameCount - 1}.getDeltaTime() * 1000.0, 1.0);
+
+		{
+			File file;
+			ANKI_TEST_EXPECT_NO_ERR(file.open(reportFilename, FileOpenFlag::kRead));
+			String report;
+			ANKI_TEST_EXPECT_NO_ERR(file.readAllText(report));
+			ANKI_TEST_EXPECT_EQ(report, expected);
+		}
+#endif
+
+		ANKI_TEST_EXPECT_NO_ERR(removeDirectory(dir));
+	}
+
+	Input::freeSingleton();
+	NativeWindow::freeSingleton();
+	SceneGraph::freeSingleton();
+	GlobalFrameIndex::freeSingleton();
+	GrMemoryPool::freeSingleton();
+	CoreMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
@@ -0,0 +1,185 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Core/GpuMemory/GpuReadbackMemoryPool.h>
+#include <AnKi/Util/Thread.h>
+#include <algorithm>
+
+namespace anki {
+namespace {
+
+class MockFence
+{
+public:
+	Bool m_signaled = false;
+	U32 m_blockingWaitCount = 0;
+
+	Bool clientWait(Second seconds)
+	{
+		if(seconds > 0.0 && !m_signaled)
+		{
+			// Pretend the GPU finished
+			++m_blockingWaitCount;
+			m_signaled = true;
+		}
+
+		return m_signaled;
+	}
+};
+
+class MockFencePtr
+{
+public:
+	MockFence* m_fence = nullptr;
+
+	MockFencePtr() = default;
+
+	MockFencePtr(MockFence* fence)
+		: m_fence(fence)
+	{
+	}
+
+	Bool isCreated() const
+	{
+		return m_fence != nullptr;
+	}
+
+	void reset(MockFence* fence)
+	{
+		m_fence = fence;
+	}
+
+	MockFence* operator->() const
+	{
+		return m_fence;
+	}
+};
+
+} // namespace
+} // namespace anki
+
+ANKI_TEST(Core, GpuReadbackRing)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	constexpr PtrSize kFrameSize = 1024;
+	GpuReadbackRing<MockFencePtr> ring;
+	ring.init(kFrameSize);
+	Array<MockFence, 16> fences;
+
+	// Allocations stay inside the segment of their frame and they are aligned
+	{
+		const GpuReadbackMemoryAllocation a = ring.allocate(10, 16);
+		const GpuReadbackMemoryAllocation b = ring.allocate(100, 64);
+		ANKI_TEST_EXPECT_EQ(a.isValid(), true);
+		ANKI_TEST_EXPECT_EQ(b.isValid(), true);
+		ANKI_TEST_EXPECT_EQ(a.m_offset % 16, 0);
+		ANKI_TEST_EXPECT_EQ(b.m_offset % 64, 0);
+		ANKI_TEST_EXPECT_LEQ(a.m_offset + a.m_size, b.m_offset);
+		ANKI_TEST_EXPECT_LEQ(b.m_offset + b.m_size, kFrameSize);
+		ANKI_TEST_EXPECT_EQ(a.m_frame, 0);
+
+		// Out of memory
+		ANKI_TEST_EXPECT_EQ(ring.allocate(kFrameSize, 4).isValid(), false);
+
+		// Not readable while the GPU hasn't signaled
+		ANKI_TEST_EXPECT_EQ(ring.isReadable(a), false);
+		ring.endFrame(&fences[0]);
+		ANKI_TEST_EXPECT_EQ(ring.isReadable(a), false);
+
+		// The fence is polled at the end of the frame
+		fences[0].m_signaled = true;
+		const GpuReadbackMemoryAllocation c = ring.allocate(4, 4);
+		ANKI_TEST_EXPECT_GEQ(c.m_offset, kFrameSize);
+		ANKI_TEST_EXPECT_LT(c.m_offset, 2 * kFrameSize);
+		ANKI_TEST_EXPECT_EQ(ring.isReadable(a), false);
+		ring.endFrame(&fences[1]);
+		ANKI_TEST_EXPECT_EQ(ring.isReadable(a), true);
+		ANKI_TEST_EXPECT_EQ(ring.isReadable(b), true);
+		ANKI_TEST_EXPECT_EQ(ring.isReadable(c), false);
+
+		// Recycled after kMaxFramesInFlight frames. The fence of frame 1 hasn't signaled so it needs a blocking wait
+		for(U32 i = 2; i < kMaxFramesInFlight + 1; ++i)
+		{
+			ring.endFrame(&fences[i]);
+		}
+		ANKI_TEST_EXPECT_EQ(ring.isReadable(a), false);
+		ANKI_TEST_EXPECT_EQ(fences[1].m_blockingWaitCount, 1);
+	}
+
+	// The most recent readable allocation of a token
+	{
+		Array<GpuReadbackMemoryAllocation, kMaxFramesInFlight> token;
+		U32 fenceIdx = 8;
+		for(U32 i = 0; i < kMaxFramesInFlight; ++i)
+		{
+			token[ring.getFrame() % kMaxFramesInFlight] = ring.allocate(4, 4);
+			fences[fenceIdx].m_signaled = true;
+			ring.endFrame(&fences[fenceIdx++]);
+		}
+
+		// The last frame's fence hasn't been polled yet
+		const U32 idx = ring.findMostRecent(token);
+		ANKI_TEST_EXPECT_NEQ(idx, kMaxU32);
+		ANKI_TEST_EXPECT_EQ(token[idx].m_frame, ring.getFrame() - 2);
+
+		ring.endFrame(&fences[fenceIdx++]);
+		ANKI_TEST_EXPECT_EQ(token[ring.findMostRecent(token)].m_frame, ring.getFrame() - 2);
+	}
+
+	// Many producers
+	{
+		constexpr U32 kThreadCount = 4;
+		constexpr U32 kAllocationsPerThread = 16;
+		constexpr PtrSize kAllocationSize = 4;
+
+		class Ctx
+		{
+		public:
+			GpuReadbackRing<MockFencePtr>* m_ring;
+			Array<GpuReadbackMemoryAllocation, kThreadCount * kAllocationsPerThread> m_allocations;
+			Atomic<U32> m_threadIdx = {0};
+		} ctx;
+		ctx.m_ring = &ring;
+
+		Array<Thread*, kThreadCount> threads;
+		for(U32 i = 0; i < kThreadCount; ++i)
+		{
+			threads[i] = newInstance<Thread>(DefaultMemoryPool::getSingleton(), "Producer");
+			threads[i]->start(&ctx, [](ThreadCallbackInfo& info) -> Error {
+				Ctx& ctx = *static_cast<Ctx*>(info.m_userData);
+				const U32 threadIdx = ctx.m_threadIdx.fetchAdd(1);
+				for(U32 j = 0; j < kAllocationsPerThread; ++j)
+				{
+					ctx.m_allocations[threadIdx * kAllocationsPerThread + j] = ctx.m_ring->allocate(kAllocationSize, 4);
+				}
+				return Error::kNone;
+			});
+		}
+
+		for(Thread* thread : threads)
+		{
+			ANKI_TEST_EXPECT_NO_ERR(thread->join());
+			deleteInstance(DefaultMemoryPool::getSingleton(), thread);
+		}
+
+		// Everything fits and nothing overlaps
+		std::sort(ctx.m_allocations.getBegin(), ctx.m_allocations.getEnd(),
+				  [](const GpuReadbackMemoryAllocation& a, const GpuReadbackMemoryAllocation& b) {
+					  return a.m_offset < b.m_offset;
+				  });
+		for(U32 i = 0; i < ctx.m_allocations.getSize(); ++i)
+		{
+			ANKI_TEST_EXPECT_EQ(ctx.m_allocations[i].isValid(), true);
+			if(i > 0)
+			{
+				ANKI_TEST_EXPECT_LEQ(ctx.m_allocations[i - 1].m_offset + kAllocationSize, ctx.m_allocations[i].m_offset);
+			}
+		}
+	}
+
+	DefaultMemoryPool::freeSingleton();
+}
@@ -5,8 +5,12 @@
 
 #include <Tests/Framework/Framework.h>
 #include <AnKi/Util/Filesystem.h>
+#include <AnKi/Util/HighRezTimer.h>
 #include <iostream>
+#include <fstream>
+#include <algorithm>
 #include <cstring>
+#include <cmath>
 #include <malloc.h>
 #if ANKI_OS_ANDROID
 #	include <android/log.h>
@@ -32,6 +36,22 @@ void Test::run()
 {
 	ANKI_TEST_LOG("========\nRunning %s %s\n========", suite->name.c_str(), name.c_str());
 
+	if(benchmarkCallback)
+	{
+		BenchmarkState state;
+		benchmarkCallback(state);
+
+		BenchmarkResult result;
+		result.name = suite->name + "." + name;
+		state.computeResult(result);
+
+		ANKI_TEST_LOG("%s: median %.1fns p95 %.1fns mean %.1fns stddev %.1fns allocs/iter %.2f (%" PRIu64 " iterations)", result.name.c_str(),
+					  result.medianNs, result.p95Ns, result.meanNs, result.stddevNs, result.allocationsPerIteration, result.iterations);
+
+		getTesterSingleton().benchmarkResults.push_back(result);
+		return;
+	}
+
 #if ANKI_COMPILER_GCC_COMPATIBLE
 #	pragma GCC diagnostic push
 #	pragma GCC diagnostic ignored "-Wdeprecated-declarations"
@@ -58,7 +78,126 @@ void Test::run()
 #endif
 }
 
-void Tester::addTest(const char* name, const char* suiteName, TestCallback callback)
+U64 BenchmarkState::getAllocationCount()
+{
+#if ANKI_STATS_ENABLED
+	return (DefaultMemoryPool::isAllocated()) ? DefaultMemoryPool::getSingleton().getTotalAllocationCount() : 0;
+#else
+	return 0;
+#endif
+}
+
+#if !ANKI_COMPILER_GCC_COMPATIBLE
+static const volatile void* volatile g_doNotOptimizeAwaySink = nullptr;
+
+void doNotOptimizeAwayInternal(const volatile void* ptr)
+{
+	g_doNotOptimizeAwaySink = ptr;
+}
+#endif
+
+void BenchmarkState::pauseTiming()
+{
+	m_pauseBegin = HighRezTimer::getCurrentTime();
+	m_pauseBeginAllocations = getAllocationCount();
+}
+
+void BenchmarkState::resumeTiming()
+{
+	m_pausedTime += HighRezTimer::getCurrentTime() - m_pauseBegin;
+	m_pausedAllocations += getAllocationCount() - m_pauseBeginAllocations;
+}
+
+Bool BenchmarkState::nextBatch()
+{
+	const Second now = HighRezTimer::getCurrentTime();
+	const U64 allocations = getAllocationCount();
+
+	const Second batchTime = max(now - m_batchBegin - m_pausedTime, 0.0);
+	const U64 batchAllocations = allocations - m_batchBeginAllocations - m_pausedAllocations;
+
+	switch(m_phase)
+	{
+	case Phase::kStart:
+		m_phase = Phase::kWarmup;
+		m_warmupEnd = now + m_warmupTime;
+		m_batchSize = 1;
+		break;
+	case Phase::kWarmup:
+		if(batchTime < m_minSampleTime)
+		{
+			m_batchSize *= 2;
+		}
+
+		if(now >= m_warmupEnd)
+		{
+			// Calibrate the batch size using the last batch
+			const F64 iterationTime = batchTime / F64(m_batchSize);
+			m_batchSize = (iterationTime > 0.0) ? max<U64>(1, U64(std::ceil(m_minSampleTime / iterationTime))) : m_batchSize;
+
+			m_phase = Phase::kMeasure;
+			m_measureBegin = now;
+			m_samplesNs.reserve(m_sampleCount);
+		}
+		break;
+	case Phase::kMeasure:
+		m_samplesNs.push_back(batchTime / F64(m_batchSize) * 1000000000.0);
+		m_measuredIterations += m_batchSize;
+		m_measuredAllocations += batchAllocations;
+
+		if(m_samplesNs.size() >= m_sampleCount || (m_samplesNs.size() >= 5 && now - m_measureBegin >= m_maxTime))
+		{
+			m_phase = Phase::kDone;
+			return false;
+		}
+		break;
+	default:
+		ANKI_ASSERT(!"Called keepRunning() after the benchmark ended");
+		return false;
+	}
+
+	// Start the next batch. Read the clock last to keep the bookkeeping out of the measurement
+	m_iterationsLeft = m_batchSize - 1;
+	m_pausedTime = 0.0;
+	m_pausedAllocations = 0;
+	m_batchBeginAllocations = getAllocationCount();
+	m_batchBegin = HighRezTimer::getCurrentTime();
+	return true;
+}
+
+void BenchmarkState::computeResult(BenchmarkResult& result) const
+{
+	result.iterations = m_measuredIterations;
+	if(m_samplesNs.empty())
+	{
+		return;
+	}
+
+	std::vector<F64> sorted = m_samplesNs;
+	std::sort(sorted.begin(), sorted.end());
+
+	const PtrSize count = sorted.size();
+	result.medianNs = (count % 2) ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+	result.p95Ns = sorted[min<PtrSize>(count - 1, PtrSize(std::ceil(0.95 * F64(count))) - 1)];
+
+	F64 sum = 0.0;
+	for(F64 s : sorted)
+	{
+		sum += s;
+	}
+	result.meanNs = sum / F64(count);
+
+	F64 variance = 0.0;
+	for(F64 s : sorted)
+	{
+		variance += (s - result.meanNs) * (s - result.meanNs);
+	}
+	result.stddevNs = (count > 1) ? std::sqrt(variance / F64(count - 1)) : 0.0;
+
+	result.allocationsPerIteration = F64(m_measuredAllocations) / F64(m_measuredIterations);
+}
+
+void Tester::addTest(const char* name, const char* suiteName, TestCallback callback, BenchmarkCallback benchmarkCallback)
 {
 	std::vector<TestSuite*>::iterator it;
 	for(it = suites.begin(); it != suites.end(); it++)
@@ -99,6 +238,7 @@ void Tester::addTest(const char* name, const char* suiteName, TestCallback callb
 	test->name = name;
 	test->suite = suite;
 	test->callback = callback;
+	test->benchmarkCallback = benchmarkCallback;
 }
 
 int Tester::run(int argc, char** argv)
@@ -109,13 +249,22 @@ int Tester::run(int argc, char** argv)
 
 	std::string helpMessage = "Usage: " + programName + R"( [options]
 Options:
-  --help         Print this message
-  --list-tests   List all the tests
-  --suite <name> Run tests only from this suite
-  --test <name>  Run this test. --suite needs to be specified)";
+  --help                                 Print this message
+  --list-tests                           List all the tests
+  --suite <name>                         Run tests only from this suite
+  --test <name>                          Run this test. --suite needs to be specified
+  --benchmark                            Run the benchmarks instead of the tests
+  --benchmark-out <file>                 Write the benchmark results to a .json or a .csv file
+  --benchmark-compare <baseline> <new>   Compare two benchmark result files and fail if there are regressions
+  --benchmark-threshold <percent>        How much slower the median can get before it's a regression. Default 10)";
 
 	std::string suiteName;
 	std::string testName;
+	bool benchmarks = false;
+	std::string benchmarkOut;
+	std::string compareBaseline;
+	std::string compareCurrent;
+	F64 threshold = 10.0;
 
 	for(int i = 1; i < argc; i++)
 	{
@@ -150,6 +299,42 @@ Options:
 			}
 			testName = argv[i];
 		}
+		else if(strcmp(arg, "--benchmark") == 0)
+		{
+			benchmarks = true;
+		}
+		else if(strcmp(arg, "--benchmark-out") == 0)
+		{
+			++i;
+			if(i >= argc)
+			{
+				ANKI_TEST_LOG("%s", "<file> is missing after --benchmark-out");
+				return 1;
+			}
+			benchmarkOut = argv[i];
+			benchmarks = true;
+		}
+		else if(strcmp(arg, "--benchmark-compare") == 0)
+		{
+			i += 2;
+			if(i >= argc)
+			{
+				ANKI_TEST_LOG("%s", "<baseline> <new> are missing after --benchmark-compare");
+				return 1;
+			}
+			compareBaseline = argv[i - 1];
+			compareCurrent = argv[i];
+		}
+		else if(strcmp(arg, "--benchmark-threshold") == 0)
+		{
+			++i;
+			if(i >= argc)
+			{
+				ANKI_TEST_LOG("%s", "<percent> is missing after --benchmark-threshold");
+				return 1;
+			}
+			threshold = atof(argv[i]);
+		}
 	}
 
 	// Sanity check
@@ -159,16 +344,25 @@ Options:
 		return 1;
 	}
 
+	if(compareBaseline.length() > 0)
+	{
+		return compareBenchmarkResults(compareBaseline, compareCurrent, threshold);
+	}
+
 	// Run tests
 	//
 	int passed = 0;
 	int run = 0;
-	if(argc == 1)
+	for(TestSuite* suite : suites)
 	{
-		// Run all
-		for(TestSuite* suite : suites)
+		if(suiteName.length() > 0 && suite->name != suiteName)
 		{
-			for(Test* test : suite->tests)
+			continue;
+		}
+
+		for(Test* test : suite->tests)
+		{
+			if((test->benchmarkCallback != nullptr) == benchmarks && (test->name == testName || testName.length() == 0))
 			{
 				++run;
 				test->run();
@@ -176,38 +370,171 @@ Options:
 			}
 		}
 	}
+
+	int failed = run - passed;
+	ANKI_TEST_LOG("========\nRun %d tests, failed %d", run, failed);
+
+	if(failed == 0)
+	{
+		ANKI_TEST_LOG("%s", "SUCCESS!");
+	}
+	else
+	{
+		ANKI_TEST_LOG("%s", "FAILURE");
+	}
+
+	if(benchmarkOut.length() > 0 && writeBenchmarkResults(benchmarkOut))
+	{
+		return 1;
+	}
+
+	return run - passed;
+}
+
+static bool isCsvFilename(const std::string& filename)
+{
+	return filename.length() >= 4 && filename.compare(filename.length() - 4, 4, ".csv") == 0;
+}
+
+int Tester::writeBenchmarkResults(const std::string& filename)
+{
+	FILE* file = fopen(filename.c_str(), "w");
+	if(!file)
+	{
+		ANKI_TEST_LOG("Failed to open: %s", filename.c_str());
+		return 1;
+	}
+
+	// One benchmark per line. The comparison relies on that
+	if(isCsvFilename(filename))
+	{
+		fprintf(file, "name,iterations,median_ns,p95_ns,mean_ns,stddev_ns,allocations_per_iteration\n");
+		for(const BenchmarkResult& r : benchmarkResults)
+		{
+			fprintf(file, "%s,%" PRIu64 ",%f,%f,%f,%f,%f\n", r.name.c_str(), r.iterations, r.medianNs, r.p95Ns, r.meanNs, r.stddevNs,
+					r.allocationsPerIteration);
+		}
+	}
 	else
 	{
-		for(TestSuite* suite : suites)
+		fprintf(file, "{\n\t\"benchmarks\": [\n");
+		for(PtrSize i = 0; i < benchmarkResults.size(); ++i)
+		{
+			const BenchmarkResult& r = benchmarkResults[i];
+			fprintf(file,
+					"\t\t{\"name\": \"%s\", \"iterations\": %" PRIu64
+					", \"median_ns\": %f, \"p95_ns\": %f, \"mean_ns\": %f, \"stddev_ns\": %f, \"allocations_per_iteration\": %f}%s\n",
+					r.name.c_str(), r.iterations, r.medianNs, r.p95Ns, r.meanNs, r.stddevNs, r.allocationsPerIteration,
+					(i + 1 < benchmarkResults.size()) ? "," : "");
+		}
+		fprintf(file, "\t]\n}\n");
+	}
+
+	fclose(file);
+	ANKI_TEST_LOG("Benchmark results written to %s", filename.c_str());
+	return 0;
+}
+
+/// Read a file written by Tester::writeBenchmarkResults.
+static bool readBenchmarkResults(const std::string& filename, std::vector<BenchmarkResult>& results)
+{
+	std::ifstream file(filename);
+	if(!file)
+	{
+		ANKI_TEST_LOG("Failed to open: %s", filename.c_str());
+		return false;
+	}
+
+	const bool csv = isCsvFilename(filename);
+	std::string line;
+	while(std::getline(file, line))
+	{
+		BenchmarkResult r;
+		if(csv)
 		{
-			if(suite->name == suiteName)
+			std::replace(line.begin(), line.end(), ',', ' ');
+			std::istringstream ss(line);
+			if(!(ss >> r.name >> r.iterations >> r.medianNs >> r.p95Ns >> r.meanNs >> r.stddevNs >> r.allocationsPerIteration))
 			{
-				for(Test* test : suite->tests)
+				continue; // Header
+			}
+		}
+		else
+		{
+			auto getValue = [&](const char* key, std::string& value) {
+				const std::string pattern = std::string("\"") + key + "\": ";
+				const size_t begin = line.find(pattern);
+				if(begin == std::string::npos)
 				{
-					if(test->name == testName || testName.length() == 0)
-					{
-						++run;
-						test->run();
-						++passed;
-					}
+					return false;
 				}
+
+				value = line.substr(begin + pattern.length());
+				value = value.substr(0, value.find_first_of(",}"));
+				value.erase(std::remove(value.begin(), value.end(), '"'), value.end());
+				return true;
+			};
+
+			std::string name, median, allocs;
+			if(!getValue("name", name) || !getValue("median_ns", median) || !getValue("allocations_per_iteration", allocs))
+			{
+				continue;
 			}
+
+			r.name = name;
+			r.medianNs = atof(median.c_str());
+			r.allocationsPerIteration = atof(allocs.c_str());
 		}
+
+		results.push_back(r);
 	}
 
-	int failed = run - passed;
-	ANKI_TEST_LOG("========\nRun %d tests, failed %d", run, failed);
+	return true;
+}
 
-	if(failed == 0)
+int Tester::compareBenchmarkResults(const std::string& baselineFilename, const std::string& currentFilename, F64 thresholdPercent)
+{
+	std::vector<BenchmarkResult> baseline;
+	std::vector<BenchmarkResult> current;
+	if(!readBenchmarkResults(baselineFilename, baseline) || !readBenchmarkResults(currentFilename, current))
 	{
-		ANKI_TEST_LOG("%s", "SUCCESS!");
+		return 1;
 	}
-	else
+
+	int regressions = 0;
+	for(const BenchmarkResult& r : current)
 	{
-		ANKI_TEST_LOG("%s", "FAILURE");
+		auto it = std::find_if(baseline.begin(), baseline.end(), [&](const BenchmarkResult& b) {
+			return b.name == r.name;
+		});
+
+		if(it == baseline.end())
+		{
+			ANKI_TEST_LOG("%-40s new", r.name.c_str());
+			continue;
+		}
+
+		const F64 diffPercent = (it->medianNs > 0.0) ? (r.medianNs / it->medianNs - 1.0) * 100.0 : 0.0;
+		const bool slower = diffPercent > thresholdPercent;
+		const bool moreAllocations = r.allocationsPerIteration > it->allocationsPerIteration + 0.01;
+
+		ANKI_TEST_LOG("%-40s median %.1fns -> %.1fns (%+.1f%%) allocs/iter %.2f -> %.2f%s", r.name.c_str(), it->medianNs, r.medianNs, diffPercent,
+					  it->allocationsPerIteration, r.allocationsPerIteration, (slower || moreAllocations) ? " REGRESSION" : "");
+
+		if(slower || moreAllocations)
+		{
+			++regressions;
+		}
 	}
 
-	return run - passed;
+	if(regressions)
+	{
+		ANKI_TEST_LOG("%d benchmark regressions (threshold %.1f%%)", regressions, thresholdPercent);
+		return 1;
+	}
+
+	ANKI_TEST_LOG("%s", "No benchmark regressions");
+	return 0;
 }
 
 int Tester::listTests()
@@ -24,6 +24,7 @@ namespace anki {
 class TestSuite;
 class Test;
 class Tester;
+class BenchmarkState;
 
 #define ANKI_TEST_LOGI(...) ANKI_LOG("TEST", kNormal, __VA_ARGS__)
 #define ANKI_TEST_LOGE(...) ANKI_LOG("TEST", kError, __VA_ARGS__)
@@ -33,6 +34,9 @@ class Tester;
 /// The actual test
 using TestCallback = void (*)(Test&);
 
+/// The actual benchmark
+using BenchmarkCallback = void (*)(BenchmarkState&);
+
 /// Test suite
 class TestSuite
 {
@@ -50,10 +54,113 @@ public:
 	std::string name;
 	TestSuite* suite = nullptr;
 	TestCallback callback = nullptr;
+	BenchmarkCallback benchmarkCallback = nullptr; ///< If it's not null the test is a benchmark.
 
 	void run();
 };
 
+/// The statistics of a benchmark. The times are per iteration.
+class BenchmarkResult
+{
+public:
+	std::string name; ///< Suite.Benchmark
+	U64 iterations = 0; ///< The number of measured iterations.
+	F64 medianNs = 0.0;
+	F64 p95Ns = 0.0;
+	F64 meanNs = 0.0;
+	F64 stddevNs = 0.0;
+	F64 allocationsPerIteration = 0.0; ///< Allocations from the DefaultMemoryPool. Always zero if ANKI_STATS is off.
+};
+
+/// Drives the loop of a benchmark. It warms up, calibrates the number of iterations so each sample takes a minimum amount of time and then
+/// gathers a number of samples. The clock is only read between the batches of iterations so keepRunning() is almost free.
+/// @code
+/// ANKI_BENCHMARK(Util, Foo)
+/// {
+/// 	// Setup
+/// 	while(bench.keepRunning())
+/// 	{
+/// 		// Code to measure
+/// 	}
+/// }
+/// @endcode
+class BenchmarkState
+{
+public:
+	Second m_warmupTime = 0.1;
+	Second m_minSampleTime = 0.01;
+	Second m_maxTime = 5.0; ///< Stop gathering samples after that time if there are a few already.
+	U32 m_sampleCount = 30;
+
+	/// Call it as the condition of the benchmark loop.
+	ANKI_FORCE_INLINE Bool keepRunning()
+	{
+		if(m_iterationsLeft > 0) [[likely]]
+		{
+			--m_iterationsLeft;
+			return true;
+		}
+
+		return nextBatch();
+	}
+
+	/// Exclude the code between pauseTiming() and resumeTiming() from the times and the allocation counts.
+	void pauseTiming();
+
+	/// @copydoc pauseTiming
+	void resumeTiming();
+
+	/// Compute the statistics. Call it after the loop.
+	void computeResult(BenchmarkResult& result) const;
+
+private:
+	enum class Phase : U8
+	{
+		kStart,
+		kWarmup,
+		kMeasure,
+		kDone
+	};
+
+	std::vector<F64> m_samplesNs;
+	U64 m_measuredIterations = 0;
+	U64 m_measuredAllocations = 0;
+
+	U64 m_batchSize = 1;
+	U64 m_iterationsLeft = 0;
+	Second m_batchBegin = 0.0;
+	U64 m_batchBeginAllocations = 0;
+	Second m_pausedTime = 0.0;
+	U64 m_pausedAllocations = 0;
+	Second m_pauseBegin = 0.0;
+	U64 m_pauseBeginAllocations = 0;
+
+	Second m_warmupEnd = 0.0;
+	Second m_measureBegin = 0.0;
+	Phase m_phase = Phase::kStart;
+
+	Bool nextBatch();
+
+	static U64 getAllocationCount();
+};
+
+#if !ANKI_COMPILER_GCC_COMPATIBLE
+/// Not inlined so the compiler has to assume the pointed value is read.
+void doNotOptimizeAwayInternal(const volatile void* ptr);
+#endif
+
+/// Stop the compiler from optimizing away a value that the benchmark computes but doesn't use.
+template<typename T>
+ANKI_FORCE_INLINE void doNotOptimizeAway(const T& value)
+{
+#if ANKI_COMPILER_GCC_COMPATIBLE
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	doNotOptimizeAwayInternal(&reinterpret_cast<const volatile char&>(value));
+	_ReadWriteBarrier();
+#endif
+}
+
 /// A container of test suites
 class Tester
 {
@@ -61,12 +168,21 @@ public:
 	std::vector<TestSuite*> suites;
 	std::string programName;
 
-	void addTest(const char* name, const char* suite, TestCallback callback);
+	std::vector<BenchmarkResult> benchmarkResults;
+
+	void addTest(const char* name, const char* suite, TestCallback callback, BenchmarkCallback benchmarkCallback = nullptr);
 
 	int run(int argc, char** argv);
 
 	int listTests();
 
+	/// Write the benchmark results to a JSON or a CSV file depending on the extension.
+	int writeBenchmarkResults(const std::string& filename);
+
+	/// Compare two benchmark result files and report the benchmarks whose median got slower than a threshold or that allocate more.
+	/// @return Non-zero if there are regressions.
+	int compareBenchmarkResults(const std::string& baselineFilename, const std::string& currentFilename, F64 thresholdPercent);
+
 	~Tester()
 	{
 		for(TestSuite* s : suites)
@@ -98,6 +214,20 @@ extern void deleteTesterSingleton();
 	static Foo##suiteName_##name_ yada##suiteName_##name_; \
 	void test_##suiteName_##name_(Test&)
 
+/// Create a new benchmark and add it. The body gets a BenchmarkState named "bench". Benchmarks run only with --benchmark
+#define ANKI_BENCHMARK(suiteName_, name_) \
+	using namespace anki; \
+	void bench_##suiteName_##name_(BenchmarkState&); \
+	struct FooBench##suiteName_##name_ \
+	{ \
+		FooBench##suiteName_##name_() \
+		{ \
+			getTesterSingleton().addTest(#name_, #suiteName_, nullptr, bench_##suiteName_##name_); \
+		} \
+	}; \
+	static FooBench##suiteName_##name_ yadaBench##suiteName_##name_; \
+	void bench_##suiteName_##name_(BenchmarkState& bench)
+
 /// Intermediate macro
 #define ANKI_TEST_EXPECT_EQ_IMPL(file_, line_, func_, x, y) \
 	do \
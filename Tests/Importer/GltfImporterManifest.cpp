@@ -0,0 +1,276 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Importer/GltfImporter.h>
+#include <AnKi/Util/Filesystem.h>
+#include <AnKi/Util/Hash.h>
+
+namespace anki {
+namespace {
+
+constexpr CString kMarker = "Not re-exported";
+
+/// The binary data of a single triangle: positions, normals, UVs and 16bit indices.
+class TestTriangle
+{
+public:
+	Array<F32, 9> m_positions;
+	Array<F32, 9> m_normals = {0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f};
+	Array<F32, 6> m_uvs = {0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f};
+	Array<U16, 4> m_indices = {0, 1, 2, 0}; // Padded to 4 bytes
+
+	TestTriangle(F32 x)
+		: m_positions{x, 0.0f, 0.0f, x + 1.0f, 0.0f, 0.0f, x, 1.0f, 0.0f}
+	{
+	}
+};
+
+static_assert(sizeof(TestTriangle) == 104);
+
+/// Two meshes, MeshA uses a material with a texture and MeshB a material without.
+class TestGltf
+{
+public:
+	String m_dir;
+	Array<TestTriangle, 2> m_triangles = {TestTriangle(0.0f), TestTriangle(10.0f)};
+	U8 m_texel = 128;
+
+	String getPath(CString fname) const
+	{
+		String out;
+		out.sprintf("%s/%s", m_dir.cstr(), fname.cstr());
+		return out;
+	}
+
+	Error writeBin() const
+	{
+		File file;
+		ANKI_CHECK(file.open(getPath("Scene.bin"), FileOpenFlag::kWrite | FileOpenFlag::kBinary));
+		ANKI_CHECK(file.write(&m_triangles[0], sizeof(m_triangles)));
+		return Error::kNone;
+	}
+
+	/// A 2x2 uncompressed 32bit TGA.
+	Error writeTexture() const
+	{
+		File file;
+		ANKI_CHECK(file.open(getPath("Tex.tga"), FileOpenFlag::kWrite | FileOpenFlag::kBinary));
+		const Array<U8, 18> header = {0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 2, 0, 32, 0};
+		ANKI_CHECK(file.write(&header[0], sizeof(header)));
+		Array<U8, 16> pixels;
+		pixels.fill(m_texel);
+		ANKI_CHECK(file.write(&pixels[0], sizeof(pixels)));
+		return Error::kNone;
+	}
+
+	Error writeGltf() const
+	{
+		String accessors;
+		String bufferViews;
+		for(U32 mesh = 0; mesh < 2; ++mesh)
+		{
+			const PtrSize base = mesh * sizeof(TestTriangle);
+			bufferViews += String().sprintf("%s{\"buffer\": 0, \"byteOffset\": %zu, \"byteLength\": 36},"
+											"{\"buffer\": 0, \"byteOffset\": %zu, \"byteLength\": 36},"
+											"{\"buffer\": 0, \"byteOffset\": %zu, \"byteLength\": 24},"
+											"{\"buffer\": 0, \"byteOffset\": %zu, \"byteLength\": 6}",
+											(mesh) ? "," : "", base + offsetof(TestTriangle, m_positions), base + offsetof(TestTriangle, m_normals),
+											base + offsetof(TestTriangle, m_uvs), base + offsetof(TestTriangle, m_indices));
+
+			const U32 view = mesh * 4;
+			accessors += String().sprintf("%s{\"bufferView\": %u, \"componentType\": 5126, \"count\": 3, \"type\": \"VEC3\"},"
+										  "{\"bufferView\": %u, \"componentType\": 5126, \"count\": 3, \"type\": \"VEC3\"},"
+										  "{\"bufferView\": %u, \"componentType\": 5126, \"count\": 3, \"type\": \"VEC2\"},"
+										  "{\"bufferView\": %u, \"componentType\": 5123, \"count\": 3, \"type\": \"SCALAR\"}",
+										  (mesh) ? "," : "", view, view + 1, view + 2, view + 3);
+		}
+
+		String json;
+		json.sprintf(R"({
+	"asset": {"version": "2.0"},
+	"scene": 0,
+	"scenes": [{"nodes": [0, 1]}],
+	"nodes": [{"name": "NodeA", "mesh": 0}, {"name": "NodeB", "mesh": 1, "translation": [0, 5, 0]}],
+	"meshes": [
+		{"name": "MeshA", "primitives": [{"attributes": {"POSITION": 0, "NORMAL": 1, "TEXCOORD_0": 2}, "indices": 3, "material": 0}]},
+		{"name": "MeshB", "primitives": [{"attributes": {"POSITION": 4, "NORMAL": 5, "TEXCOORD_0": 6}, "indices": 7, "material": 1}]}
+	],
+	"materials": [
+		{"name": "MtlA", "pbrMetallicRoughness": {"baseColorTexture": {"index": 0}}},
+		{"name": "MtlB", "pbrMetallicRoughness": {"baseColorFactor": [1, 0, 0, 1]}}
+	],
+	"textures": [{"source": 0}],
+	"images": [{"uri": "%s"}],
+	"buffers": [{"uri": "Scene.bin", "byteLength": %zu}],
+	"bufferViews": [%s],
+	"accessors": [%s]
+})",
+					 getPath("Tex.tga").cstr(), sizeof(m_triangles), bufferViews.cstr(), accessors.cstr());
+
+		File file;
+		ANKI_CHECK(file.open(getPath("Scene.gltf"), FileOpenFlag::kWrite));
+		ANKI_CHECK(file.writeText(json));
+		return Error::kNone;
+	}
+
+	Error import() const
+	{
+		const String outDir = getPath("Out/");
+		const String input = getPath("Scene.gltf");
+
+		GltfImporterInitInfo info;
+		info.m_inputFilename = input;
+		info.m_outDirectory = outDir;
+		info.m_rpath = "Out/";
+		info.m_texrpath = "Out/";
+		info.m_threadCount = 0;
+		info.m_incremental = true;
+
+		GltfImporter importer;
+		ANKI_CHECK(importer.init(info));
+		ANKI_CHECK(importer.writeAll());
+		return Error::kNone;
+	}
+};
+
+String outputFilename(const TestGltf& gltf, CString name, CString ext)
+{
+	String out;
+	out.sprintf("%s/Out/%s_%" PRIx64 ".%s", gltf.m_dir.cstr(), name.cstr(), computeHash(name.cstr(), name.getLength()), ext.cstr());
+	return out;
+}
+
+/// The files the importer writes for the test scene.
+class TestOutputs
+{
+public:
+	Array<String, 6> m_files;
+
+	TestOutputs(const TestGltf& gltf)
+	{
+		m_files[0] = outputFilename(gltf, "MeshA", "ankimesh");
+		m_files[1] = outputFilename(gltf, "MeshB", "ankimesh");
+		m_files[2] = outputFilename(gltf, "MtlA", "ankimtl");
+		m_files[3] = outputFilename(gltf, "MtlB", "ankimtl");
+		m_files[4] = outputFilename(gltf, "MeshA_MtlA", "ankimdl");
+		m_files[5] = outputFilename(gltf, "MeshB_MtlB", "ankimdl");
+	}
+
+	/// Overwrite all the outputs with a marker. The resources that are re-exported loose it.
+	Error mark() const
+	{
+		for(const String& fname : m_files)
+		{
+			File file;
+			ANKI_CHECK(file.open(fname, FileOpenFlag::kWrite));
+			ANKI_CHECK(file.writeText(kMarker));
+		}
+
+		return Error::kNone;
+	}
+
+	Error isMarked(U32 idx, Bool& marked) const
+	{
+		File file;
+		ANKI_CHECK(file.open(m_files[idx], FileOpenFlag::kRead));
+		String txt;
+		ANKI_CHECK(file.readAllText(txt));
+		marked = txt == kMarker;
+		return Error::kNone;
+	}
+
+	/// @param reexportedMask A bit per file that is expected to be re-exported.
+	Error check(U32 reexportedMask) const
+	{
+		for(U32 i = 0; i < m_files.getSize(); ++i)
+		{
+			Bool marked;
+			ANKI_CHECK(isMarked(i, marked));
+			const Bool reexported = (reexportedMask & (1u << i)) != 0;
+			if(marked == reexported)
+			{
+				ANKI_TEST_LOGE("%s was %s", m_files[i].cstr(), (reexported) ? "skipped" : "re-exported");
+				return Error::kFunctionFailed;
+			}
+		}
+
+		return Error::kNone;
+	}
+};
+
+} // namespace
+} // namespace anki
+
+ANKI_TEST(Importer, GltfImporterManifest)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	ImporterMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		TestGltf gltf;
+		ANKI_TEST_EXPECT_NO_ERR(getTempDirectory(gltf.m_dir));
+		gltf.m_dir += "/GltfImporterManifest";
+		if(directoryExists(gltf.m_dir))
+		{
+			ANKI_TEST_EXPECT_NO_ERR(removeDirectory(gltf.m_dir));
+		}
+		ANKI_TEST_EXPECT_NO_ERR(createDirectory(gltf.m_dir));
+		ANKI_TEST_EXPECT_NO_ERR(createDirectory(gltf.getPath("Out")));
+
+		ANKI_TEST_EXPECT_NO_ERR(gltf.writeBin());
+		ANKI_TEST_EXPECT_NO_ERR(gltf.writeTexture());
+		ANKI_TEST_EXPECT_NO_ERR(gltf.writeGltf());
+
+		const TestOutputs outputs(gltf);
+		constexpr U32 kMeshA = 1 << 0;
+		constexpr U32 kMeshB = 1 << 1;
+		constexpr U32 kMtlA = 1 << 2;
+		constexpr U32 kAll = (1 << 6) - 1;
+
+		// First import writes everything
+		ANKI_TEST_EXPECT_NO_ERR(gltf.import());
+		ANKI_TEST_EXPECT_EQ(fileExists(gltf.getPath("Out/ImportManifest.txt")), true);
+
+		// Nothing changed, everything is skipped
+		ANKI_TEST_EXPECT_NO_ERR(outputs.mark());
+		ANKI_TEST_EXPECT_NO_ERR(gltf.import());
+		ANKI_TEST_EXPECT_NO_ERR(outputs.check(0));
+
+		// Change the vertices of a single mesh
+		gltf.m_triangles[1].m_positions[4] = 2.0f;
+		ANKI_TEST_EXPECT_NO_ERR(gltf.writeBin());
+		ANKI_TEST_EXPECT_NO_ERR(gltf.import());
+		ANKI_TEST_EXPECT_NO_ERR(outputs.check(kMeshB));
+
+		// Change the image. The material that samples it is re-exported
+		ANKI_TEST_EXPECT_NO_ERR(outputs.mark());
+		gltf.m_texel = 64;
+		ANKI_TEST_EXPECT_NO_ERR(gltf.writeTexture());
+		ANKI_TEST_EXPECT_NO_ERR(gltf.import());
+		ANKI_TEST_EXPECT_NO_ERR(outputs.check(kMtlA));
+
+		// A deleted output is re-exported
+		ANKI_TEST_EXPECT_NO_ERR(outputs.mark());
+		ANKI_TEST_EXPECT_NO_ERR(removeFile(outputs.m_files[0]));
+		ANKI_TEST_EXPECT_NO_ERR(gltf.import());
+		ANKI_TEST_EXPECT_NO_ERR(outputs.check(kMeshA));
+
+		// A malformed manifest is ignored and everything is re-exported
+		{
+			ANKI_TEST_EXPECT_NO_ERR(outputs.mark());
+			File file;
+			ANKI_TEST_EXPECT_NO_ERR(file.open(gltf.getPath("Out/ImportManifest.txt"), FileOpenFlag::kWrite));
+			ANKI_TEST_EXPECT_NO_ERR(file.writeText("Garbage\n"));
+		}
+		ANKI_TEST_EXPECT_NO_ERR(gltf.import());
+		ANKI_TEST_EXPECT_NO_ERR(outputs.check(kAll));
+
+		ANKI_TEST_EXPECT_NO_ERR(removeDirectory(gltf.m_dir));
+	}
+
+	ImporterMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
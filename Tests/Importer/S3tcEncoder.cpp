@@ -0,0 +1,276 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Importer/S3tcEncoder.h>
+#include <AnKi/Util/ThreadJobManager.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/System.h>
+#include <AnKi/Util/F16.h>
+#include <random>
+#include <vector>
+
+using namespace anki;
+
+static U32 readBits(ConstWeakArray<U8> in, U32& bit, U32 bitCount)
+{
+	U32 out = 0;
+	for(U32 i = 0; i < bitCount; ++i, ++bit)
+	{
+		out |= U32((in[bit / 8] >> (bit % 8)) & 1u) << i;
+	}
+	return out;
+}
+
+static F32 maxAbsoluteDiff(const Vec3& a, const Vec3& b)
+{
+	const Vec3 d = (a - b).abs();
+	return max(d.x(), max(d.y(), d.z()));
+}
+
+static Vec3 decodeRgb565(U16 c)
+{
+	const U32 r = (c >> 11) & 31u;
+	const U32 g = (c >> 5) & 63u;
+	const U32 b = c & 31u;
+	return Vec3(F32((r << 3) | (r >> 2)), F32((g << 2) | (g >> 4)), F32((b << 3) | (b >> 2)));
+}
+
+/// Reference decoder of the 4 color mode of BC1 (which is the only one the BC3 uses).
+static void decodeBc1Color(const U8* in, Array<Vec3, 16>& out)
+{
+	const U16 c0 = U16(in[0] | (in[1] << 8));
+	const U16 c1 = U16(in[2] | (in[3] << 8));
+	Array<Vec3, 4> palette;
+	palette[0] = decodeRgb565(c0);
+	palette[1] = decodeRgb565(c1);
+	palette[2] = (palette[0] * 2.0f + palette[1]) / 3.0f;
+	palette[3] = (palette[0] + palette[1] * 2.0f) / 3.0f;
+
+	U32 indices;
+	memcpy(&indices, in + 4, sizeof(indices));
+	for(U32 i = 0; i < 16; ++i)
+	{
+		out[i] = palette[(indices >> (i * 2)) & 3u];
+	}
+}
+
+static void decodeBc3Alpha(const U8* in, Array<F32, 16>& out)
+{
+	const U32 a0 = in[0];
+	const U32 a1 = in[1];
+	Array<F32, 8> palette;
+	palette[0] = F32(a0);
+	palette[1] = F32(a1);
+	for(U32 i = 2; i < 8; ++i)
+	{
+		palette[i] =
+			(a0 > a1) ? F32(((8 - i) * a0 + (i - 1) * a1) / 7) : ((i < 6) ? F32(((6 - i) * a0 + (i - 1) * a1) / 5) : F32((i == 6) ? 0 : 255));
+	}
+
+	U32 bit = 16;
+	for(U32 i = 0; i < 16; ++i)
+	{
+		out[i] = palette[readBits(ConstWeakArray<U8>(in, 8), bit, 3)];
+	}
+}
+
+/// Reference decoder of mode 11 of BC6H unsigned.
+static Bool decodeBc6h(const U8* in, Array<Vec3, 16>& out)
+{
+	const ConstWeakArray<U8> block(in, 16);
+	U32 bit = 0;
+	if(readBits(block, bit, 5) != 3)
+	{
+		return false;
+	}
+
+	Array<UVec3, 2> endpoints;
+	for(U32 e = 0; e < 2; ++e)
+	{
+		for(U32 c = 0; c < 3; ++c)
+		{
+			const U32 q = readBits(block, bit, 10);
+			endpoints[e][c] = (q == 0) ? 0 : ((q == 1023) ? 0xFFFF : (((q << 16) + 0x8000) >> 10));
+		}
+	}
+
+	constexpr Array<U32, 16> kWeights = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+	for(U32 i = 0; i < 16; ++i)
+	{
+		const U32 idx = readBits(block, bit, (i == 0) ? 3 : 4);
+		for(U32 c = 0; c < 3; ++c)
+		{
+			const U32 interpolated = ((64 - kWeights[idx]) * endpoints[0][c] + kWeights[idx] * endpoints[1][c] + 32) >> 6;
+			out[i][c] = F16(U16((interpolated * 31) >> 6)).toF32();
+		}
+	}
+
+	return true;
+}
+
+ANKI_TEST(Importer, S3tcEncoder)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	std::mt19937 gen(123);
+	std::uniform_real_distribution<F32> dist(0.0f, 1.0f);
+
+	constexpr Array<S3tcEncoderQuality, 3> kQualities = {S3tcEncoderQuality::kFast, S3tcEncoderQuality::kNormal, S3tcEncoderQuality::kHigh};
+
+	// BC1 & BC3 with gradients plus some noise
+	{
+		constexpr U32 kBlockCount = 256;
+		Array<F32, 3> totalColorErrors = {};
+		Array<F32, 3> totalAlphaErrors = {};
+
+		for(U32 blockIdx = 0; blockIdx < kBlockCount; ++blockIdx)
+		{
+			const Vec4 base(dist(gen) * 200.0f, dist(gen) * 200.0f, dist(gen) * 200.0f, dist(gen) * 200.0f);
+			const Vec4 dir(dist(gen) * 50.0f, dist(gen) * 50.0f, dist(gen) * 50.0f, dist(gen) * 50.0f);
+
+			Array<U8Vec4, 16> pixels;
+			Array<U8Vec3, 16> pixelsRgb;
+			for(U32 i = 0; i < 16; ++i)
+			{
+				const Vec4 p = (base + dir * (F32(i) / 15.0f) + Vec4(dist(gen) * 4.0f)).clamp(0.0f, 255.0f);
+				pixels[i] = U8Vec4(p);
+				pixelsRgb[i] = pixels[i].xyz();
+			}
+
+			for(U32 q = 0; q < kQualities.getSize(); ++q)
+			{
+				Array<U8, 8> bc1;
+				encodeBc1Block(pixelsRgb, kQualities[q], bc1);
+
+				Array<U8, 16> bc3;
+				encodeBc3Block(pixels, kQualities[q], bc3);
+
+				Array<Vec3, 16> decodedBc1, decodedBc3;
+				Array<F32, 16> decodedAlpha;
+				decodeBc1Color(&bc1[0], decodedBc1);
+				decodeBc1Color(&bc3[8], decodedBc3);
+				decodeBc3Alpha(&bc3[0], decodedAlpha);
+
+				for(U32 i = 0; i < 16; ++i)
+				{
+					const Vec3 orig(pixelsRgb[i]);
+					ANKI_TEST_EXPECT_LT(maxAbsoluteDiff(decodedBc1[i], orig), 32.0f);
+					ANKI_TEST_EXPECT_LT(absolute(decodedAlpha[i] - F32(pixels[i].w())), 20.0f);
+					ANKI_TEST_EXPECT_EQ(decodedBc1[i] == decodedBc3[i], true);
+
+					totalColorErrors[q] += (decodedBc1[i] - orig).getLengthSquared();
+					totalAlphaErrors[q] += absolute(decodedAlpha[i] - F32(pixels[i].w()));
+				}
+			}
+		}
+
+		// The high quality only accepts refinements that reduce the error
+		ANKI_TEST_EXPECT_LEQ(totalColorErrors[2], totalColorErrors[1]);
+
+		ANKI_TEST_LOGI("BC1 MSE per channel: fast %f, normal %f, high %f", totalColorErrors[0] / (kBlockCount * 16 * 3),
+					   totalColorErrors[1] / (kBlockCount * 16 * 3), totalColorErrors[2] / (kBlockCount * 16 * 3));
+	}
+
+	// BC1 solid color is only limited by the 565 quantization
+	{
+		Array<U8Vec3, 16> pixels;
+		pixels.fill(U8Vec3(200, 100, 50));
+
+		Array<U8, 8> bc1;
+		encodeBc1Block(pixels, S3tcEncoderQuality::kNormal, bc1);
+		Array<Vec3, 16> decoded;
+		decodeBc1Color(&bc1[0], decoded);
+		for(const Vec3& p : decoded)
+		{
+			ANKI_TEST_EXPECT_LEQ(maxAbsoluteDiff(p, Vec3(pixels[0])), 4.0f);
+		}
+	}
+
+	// BC6H
+	{
+		for(U32 blockIdx = 0; blockIdx < 256; ++blockIdx)
+		{
+			// Keep the range of the block moderate. Gradients that span many exponents are curves in the half float space and a single region
+			// can't follow them
+			const Vec3 base(0.5f + dist(gen) * 10.0f, 0.5f + dist(gen) * 10.0f, 0.5f + dist(gen) * 10.0f);
+			const Vec3 dir(dist(gen) * 2.0f, dist(gen) * 2.0f, dist(gen) * 2.0f);
+
+			Array<Vec3, 16> pixels;
+			for(U32 i = 0; i < 16; ++i)
+			{
+				pixels[i] = base + dir * (F32(i) / 15.0f);
+			}
+
+			for(S3tcEncoderQuality quality : kQualities)
+			{
+				Array<U8, 16> bc6h;
+				encodeBc6hBlock(pixels, quality, bc6h);
+
+				Array<Vec3, 16> decoded;
+				ANKI_TEST_EXPECT_EQ(decodeBc6h(&bc6h[0], decoded), true);
+
+				for(U32 i = 0; i < 16; ++i)
+				{
+					for(U32 c = 0; c < 3; ++c)
+					{
+						ANKI_TEST_EXPECT_LT(absolute(decoded[i][c] - pixels[i][c]), max(0.1f * pixels[i][c], 0.05f));
+					}
+				}
+			}
+		}
+	}
+
+	// Surfaces. The parallel compression should produce the same result
+	{
+		constexpr U32 kSize = 512;
+		std::vector<U8> pixels(kSize * kSize * 4);
+		for(U32 y = 0; y < kSize; ++y)
+		{
+			for(U32 x = 0; x < kSize; ++x)
+			{
+				U8* p = &pixels[(y * kSize + x) * 4];
+				p[0] = U8(x / 2);
+				p[1] = U8(y / 2);
+				p[2] = U8((x + y) / 4);
+				p[3] = U8(x ^ y);
+			}
+		}
+
+		ThreadJobManager jobManager(getCpuCoresCount());
+
+		for(U32 channelCount = 3; channelCount <= 4; ++channelCount)
+		{
+			std::vector<U8> in(kSize * kSize * channelCount);
+			for(U32 i = 0; i < kSize * kSize; ++i)
+			{
+				memcpy(&in[i * channelCount], &pixels[i * 4], channelCount);
+			}
+
+			const PtrSize outSize = PtrSize(kSize / 4) * (kSize / 4) * ((channelCount == 4) ? 16 : 8);
+			std::vector<U8> serial(outSize);
+			std::vector<U8> parallel(outSize);
+
+			HighRezTimer timer;
+			timer.start();
+			compressS3tcSurface(ConstWeakArray<U8, PtrSize>(in.data(), in.size()), kSize, kSize, channelCount, false, S3tcEncoderQuality::kNormal,
+								WeakArray<U8, PtrSize>(serial.data(), serial.size()));
+			timer.stop();
+			const Second serialTime = timer.getElapsedTime();
+
+			timer.start();
+			compressS3tcSurface(ConstWeakArray<U8, PtrSize>(in.data(), in.size()), kSize, kSize, channelCount, false, S3tcEncoderQuality::kNormal,
+								WeakArray<U8, PtrSize>(parallel.data(), parallel.size()), &jobManager);
+			timer.stop();
+			const Second parallelTime = timer.getElapsedTime();
+
+			ANKI_TEST_EXPECT_EQ(memcmp(serial.data(), parallel.data(), outSize), 0);
+			ANKI_TEST_LOGI("%s %ux%u: serial %fms, parallel (%u threads) %fms", (channelCount == 3) ? "BC1" : "BC3", kSize, kSize,
+						   serialTime * 1000.0, jobManager.getThreadCount(), parallelTime * 1000.0);
+		}
+	}
+
+	DefaultMemoryPool::freeSingleton();
+}
@@ -5,6 +5,10 @@
 
 #include <Tests/Framework/Framework.h>
 #include <AnKi/Math.h>
+#include <AnKi/Math/SimdBatch.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <random>
+#include <vector>
 
 using namespace anki;
 
@@ -375,3 +379,239 @@ ANKI_TEST(Math, Mat3x4)
 		ANKI_TEST_EXPECT_EQ(m * v, Vec3(20, 44, 68));
 	}
 }
+
+ANKI_TEST(Math, Quat)
+{
+	// Compare the F32 (SIMD if enabled) with the F64 (always scalar)
+	const Quat a = Quat(Mat3(Axisang(0.7f, Vec3(1.0f, 2.0f, 3.0f).getNormalized())));
+	const Quat b = Quat(Mat3(Axisang(-1.3f, Vec3(-3.0f, 0.5f, 1.0f).getNormalized())));
+	const DQuat da(a.x(), a.y(), a.z(), a.w());
+	const DQuat db(b.x(), b.y(), b.z(), b.w());
+
+	const Quat c = a.combineRotations(b);
+	const DQuat dc = da.combineRotations(db);
+	for(U32 i = 0; i < 4; ++i)
+	{
+		ANKI_TEST_EXPECT_NEAR(c[i], F32(dc[i]), 1e-5f);
+	}
+
+	// Rotating with the combined quat is the same as rotating twice
+	const Vec3 v(1.0f, -2.0f, 0.5f);
+	const Vec3 rotated = c.rotate(v);
+	const Vec3 rotatedTwice = a.rotate(b.rotate(v));
+	const Vec3 rotatedMat = Mat3(c) * v;
+	for(U32 i = 0; i < 3; ++i)
+	{
+		ANKI_TEST_EXPECT_NEAR(rotated[i], rotatedTwice[i], 1e-5f);
+		ANKI_TEST_EXPECT_NEAR(rotated[i], rotatedMat[i], 1e-5f);
+	}
+
+	// Transform
+	const Transform trf(Vec3(1.0f, 2.0f, 3.0f), Mat3(c), Vec3(2.0f));
+	const Vec3 transformed = trf.transform(v);
+	const Vec3 transformedMat = Mat3x4(trf.getOrigin().xyz(), trf.getRotation().getRotationPart(), trf.getScale().xyz()) * v.xyz1();
+	for(U32 i = 0; i < 3; ++i)
+	{
+		ANKI_TEST_EXPECT_NEAR(transformed[i], transformedMat[i], 1e-5f);
+	}
+}
+
+static Mat3x4 randomTransform(std::mt19937& gen, Bool scale = true)
+{
+	std::uniform_real_distribution<F32> dist(-10.0f, 10.0f);
+	const Vec3 axis = Vec3(dist(gen), dist(gen), dist(gen)).getNormalized();
+	const F32 s = (scale) ? absolute(dist(gen)) + 0.1f : 1.0f;
+	return Mat3x4(Vec3(dist(gen), dist(gen), dist(gen)), Mat3(Axisang(dist(gen), axis)), Vec3(s));
+}
+
+ANKI_TEST(Math, SimdBatch)
+{
+	constexpr U32 kBatchCount = 16;
+	std::mt19937 gen(42);
+	std::uniform_real_distribution<F32> dist(-100.0f, 100.0f);
+
+	std::vector<Mat3x4x8> a(kBatchCount), b(kBatchCount), combined(kBatchCount);
+	std::vector<Vec3x8> points(kBatchCount), transformed(kBatchCount);
+	for(U32 i = 0; i < kBatchCount; ++i)
+	{
+		for(U32 l = 0; l < 8; ++l)
+		{
+			a[i].set(l, randomTransform(gen));
+			b[i].set(l, randomTransform(gen));
+			points[i].set(l, Vec3(dist(gen), dist(gen), dist(gen)));
+		}
+	}
+
+	for(SimdBatchLevel level : {SimdBatchLevel::kGeneric, getCpuSimdBatchLevel()})
+	{
+		setSimdBatchLevel(level);
+		ANKI_TEST_LOGI("Testing SIMD batch level %u", U32(getSimdBatchLevel()));
+
+		transformPoints(ConstWeakArray<Mat3x4x8>(a.data(), kBatchCount), ConstWeakArray<Vec3x8>(points.data(), kBatchCount),
+						WeakArray<Vec3x8>(transformed.data(), kBatchCount));
+		combineTransformations(ConstWeakArray<Mat3x4x8>(a.data(), kBatchCount), ConstWeakArray<Mat3x4x8>(b.data(), kBatchCount),
+							   WeakArray<Mat3x4x8>(combined.data(), kBatchCount));
+
+		for(U32 i = 0; i < kBatchCount; ++i)
+		{
+			for(U32 l = 0; l < 8; ++l)
+			{
+				const Vec3 expectedPoint = a[i].get(l) * points[i].get(l).xyz1();
+				const Mat3x4 expectedMat = a[i].get(l).combineTransformations(b[i].get(l));
+				for(U32 c = 0; c < 3; ++c)
+				{
+					ANKI_TEST_EXPECT_NEAR(transformed[i].get(l)[c], expectedPoint[c], 0.01f);
+				}
+
+				for(U32 e = 0; e < 12; ++e)
+				{
+					ANKI_TEST_EXPECT_NEAR(combined[i].get(l)(e / 4, e % 4), expectedMat(e / 4, e % 4), 0.01f);
+				}
+			}
+		}
+	}
+
+	setSimdBatchLevel(getCpuSimdBatchLevel());
+}
+
+/// The quaternion multiplication without SIMD to compare against.
+static Quat combineRotationsScalar(const Quat& a, const Quat& b)
+{
+	return Quat(a.x() * b.w() + a.y() * b.z() - a.z() * b.y() + a.w() * b.x(), -a.x() * b.z() + a.y() * b.w() + a.z() * b.x() + a.w() * b.y(),
+				a.x() * b.y() - a.y() * b.x() + a.z() * b.w() + a.w() * b.z(), -a.x() * b.x() - a.y() * b.y() - a.z() * b.z() + a.w() * b.w());
+}
+
+ANKI_TEST(Math, SimdBench)
+{
+	constexpr U32 kCount = 1024 * 8;
+	constexpr U32 kIterationCount = 200;
+	std::mt19937 gen(42);
+
+	std::vector<Quat> quats(kCount);
+	std::vector<Transform> transforms(kCount);
+	std::vector<Mat3x4> mats(kCount);
+	std::vector<Vec3> vecs(kCount);
+	for(U32 i = 0; i < kCount; ++i)
+	{
+		mats[i] = randomTransform(gen, false);
+		quats[i] = Quat(mats[i].getRotationPart());
+		transforms[i] = Transform(mats[i].getTranslationPart().xyz0(), Mat3x4(Vec3(0.0f), mats[i].getRotationPart()), Vec4(1.0f, 1.0f, 1.0f, 0.0f));
+		vecs[i] = mats[i].getTranslationPart().xyz();
+	}
+
+	auto bench = [&](const Char* name, auto func) {
+		const Second begin = HighRezTimer::getCurrentTime();
+		F32 sum = 0.0f; // Keep the compiler from optimizing everything out
+		for(U32 it = 0; it < kIterationCount; ++it)
+		{
+			sum += func();
+		}
+		const Second time = HighRezTimer::getCurrentTime() - begin;
+		ANKI_TEST_LOGI("%s: %.1f ops/ms (%f)", name, F64(kCount) * kIterationCount / (time * 1000.0), sum);
+	};
+
+	bench("Quat::combineRotations", [&]() {
+		Quat q = Quat::getIdentity();
+		for(U32 i = 0; i < kCount; ++i)
+		{
+			q = q.combineRotations(quats[i]);
+		}
+		return q.x();
+	});
+
+	bench("Quat::combineRotations scalar", [&]() {
+		Quat q = Quat::getIdentity();
+		for(U32 i = 0; i < kCount; ++i)
+		{
+			q = combineRotationsScalar(q, quats[i]);
+		}
+		return q.x();
+	});
+
+	bench("Quat::rotate", [&]() {
+		Vec3 v(1.0f, 0.0f, 0.0f);
+		for(U32 i = 0; i < kCount; ++i)
+		{
+			v = quats[i].rotate(v);
+		}
+		return v.x();
+	});
+
+	bench("Quat::slerp", [&]() {
+		Quat q = Quat::getIdentity();
+		for(U32 i = 0; i < kCount; ++i)
+		{
+			q = q.slerp(quats[i], 0.3f);
+		}
+		return q.x();
+	});
+
+	bench("Transform::combineTransformations", [&]() {
+		Transform t = Transform::getIdentity();
+		for(U32 i = 0; i < kCount; ++i)
+		{
+			t = t.combineTransformations(transforms[i]);
+		}
+		return t.getOrigin().x();
+	});
+
+	bench("Transform::transform", [&]() {
+		Vec3 v(1.0f, 0.0f, 0.0f);
+		for(U32 i = 0; i < kCount; ++i)
+		{
+			v = transforms[i].transform(v) * 0.5f;
+		}
+		return v.x();
+	});
+
+	// Batches
+	std::vector<Mat3x4x8> batchMats(kCount / 8);
+	std::vector<Mat3x4x8> batchOut(kCount / 8);
+	std::vector<Vec3x8> batchVecs(kCount / 8);
+	std::vector<Vec3x8> batchVecsOut(kCount / 8);
+	for(U32 i = 0; i < kCount; ++i)
+	{
+		batchMats[i / 8].set(i % 8, mats[i]);
+		batchVecs[i / 8].set(i % 8, vecs[i]);
+	}
+
+	const ConstWeakArray<Mat3x4x8> batchMatsArr(batchMats.data(), kCount / 8);
+
+	bench("Mat3x4::combineTransformations", [&]() {
+		for(U32 i = 0; i < kCount; ++i)
+		{
+			batchOut[0].set(0, mats[i].combineTransformations(mats[kCount - i - 1]));
+		}
+		return batchOut[0].m_elements[0][0];
+	});
+
+	bench("Mat3x4 * Vec4", [&]() {
+		F32 sum = 0.0f;
+		for(U32 i = 0; i < kCount; ++i)
+		{
+			sum += (mats[i] * vecs[i].xyz1()).x();
+		}
+		return sum;
+	});
+
+	for(SimdBatchLevel level : {SimdBatchLevel::kGeneric, getCpuSimdBatchLevel()})
+	{
+		setSimdBatchLevel(level);
+		const Char* levelName = (getSimdBatchLevel() == SimdBatchLevel::kAvx2) ? "AVX2" : "generic";
+
+		Array<Char, 128> name;
+		snprintf(name.getBegin(), name.getSize(), "combineTransformations batch %s", levelName);
+		bench(name.getBegin(), [&]() {
+			combineTransformations(batchMatsArr, batchMatsArr, WeakArray<Mat3x4x8>(batchOut.data(), kCount / 8));
+			return batchOut[0].m_elements[0][0];
+		});
+
+		snprintf(name.getBegin(), name.getSize(), "transformPoints batch %s", levelName);
+		bench(name.getBegin(), [&]() {
+			transformPoints(batchMatsArr, ConstWeakArray<Vec3x8>(batchVecs.data(), kCount / 8), WeakArray<Vec3x8>(batchVecsOut.data(), kCount / 8));
+			return batchVecsOut[0].m_x[0];
+		});
+	}
+
+	setSimdBatchLevel(getCpuSimdBatchLevel());
+}
@@ -0,0 +1,132 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Physics/PhysicsWorld.h>
+#include <AnKi/Physics/PhysicsBody.h>
+#include <AnKi/Physics/PhysicsCollisionShape.h>
+#include <AnKi/Util/ThreadJobManager.h>
+#include <AnKi/Util/System.h>
+
+ANKI_TEST(Physics, SceneQueries)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	PhysicsWorld::allocateSingleton();
+	ANKI_TEST_EXPECT_NO_ERR(PhysicsWorld::getSingleton().init(allocAligned, nullptr));
+
+	{
+		// A static floor and a box on top of it
+		PhysicsCollisionShapePtr floorShape = PhysicsWorld::getSingleton().newInstance<PhysicsBox>(Vec3(100.0f, 1.0f, 100.0f));
+		PhysicsBodyInitInfo init;
+		init.m_shape = floorShape;
+		init.m_transform.setOrigin(Vec4(0.0f, -1.0f, 0.0f, 0.0f));
+		PhysicsBodyPtr floor = PhysicsWorld::getSingleton().newInstance<PhysicsBody>(init);
+
+		PhysicsCollisionShapePtr boxShape = PhysicsWorld::getSingleton().newInstance<PhysicsBox>(Vec3(1.0f));
+		init.m_shape = boxShape;
+		init.m_transform.setOrigin(Vec4(10.0f, 1.0f, 0.0f, 0.0f));
+		PhysicsBodyPtr box = PhysicsWorld::getSingleton().newInstance<PhysicsBody>(init);
+
+		// Register the objects
+		PhysicsWorld::getSingleton().update(0.0);
+
+		constexpr U32 kQueryCount = 1000;
+		Array<PhysicsSceneQuery, kQueryCount> queries;
+		for(U32 i = 0; i < kQueryCount; ++i)
+		{
+			PhysicsSceneQuery& q = queries[i];
+			switch(i % 4)
+			{
+			case 0:
+				q.m_type = PhysicsSceneQueryType::kRayCast;
+				q.m_from = Vec3(10.0f, 10.0f, 0.0f);
+				q.m_to = Vec3(10.0f, -10.0f, 0.0f);
+				break;
+			case 1:
+				q.m_type = PhysicsSceneQueryType::kSphereSweep;
+				q.m_from = Vec3(-10.0f, 10.0f, 0.0f);
+				q.m_to = Vec3(-10.0f, -10.0f, 0.0f);
+				q.m_extend = Vec3(0.5f);
+				break;
+			case 2:
+				q.m_type = PhysicsSceneQueryType::kBoxOverlap;
+				q.m_from = Vec3(10.0f, 1.0f, 0.0f);
+				q.m_extend = Vec3(2.0f);
+				break;
+			default:
+				q.m_type = PhysicsSceneQueryType::kSphereOverlap;
+				q.m_from = Vec3(-10.0f, 10.0f, 0.0f);
+				q.m_extend = Vec3(1.0f);
+			}
+		}
+
+		Array<PhysicsSceneQueryResult, kQueryCount> results;
+		Array<PhysicsFilteredObject*, kQueryCount * 2> overlaps;
+
+		ThreadJobManager jobManager(max(2u, getCpuCoresCount()));
+
+		for(ThreadJobManager* manager : {static_cast<ThreadJobManager*>(nullptr), &jobManager})
+		{
+			PhysicsSceneQueryBatch batch;
+			batch.m_queries = queries;
+			batch.m_results = results;
+			batch.m_overlaps = overlaps;
+			batch.m_jobManager = manager;
+			PhysicsWorld::getSingleton().sceneQueries(batch);
+
+			// Box and floor
+			ANKI_TEST_EXPECT_EQ(batch.m_overlapCount, (kQueryCount / 4) * 2);
+
+			for(U32 i = 0; i < kQueryCount; ++i)
+			{
+				const PhysicsSceneQueryResult& r = results[i];
+				switch(i % 4)
+				{
+				case 0:
+					ANKI_TEST_EXPECT_EQ(r.m_object, box.get());
+					ANKI_TEST_EXPECT_NEAR(r.m_worldPosition.y(), 2.0f, 0.1f);
+					ANKI_TEST_EXPECT_NEAR(r.m_worldNormal.y(), 1.0f, 0.01f);
+					break;
+				case 1:
+					ANKI_TEST_EXPECT_EQ(r.m_object, floor.get());
+					ANKI_TEST_EXPECT_NEAR(r.m_worldPosition.y(), 0.0f, 0.1f);
+					break;
+				case 2:
+					ANKI_TEST_EXPECT_EQ(r.m_overlapCount, 2u);
+					for(U32 j = r.m_overlapsOffset; j < r.m_overlapsOffset + r.m_overlapCount; ++j)
+					{
+						ANKI_TEST_EXPECT_EQ(overlaps[j] == box.get() || overlaps[j] == floor.get(), true);
+					}
+					break;
+				default:
+					ANKI_TEST_EXPECT_EQ(r.m_object, nullptr);
+					ANKI_TEST_EXPECT_EQ(r.m_overlapCount, 0u);
+				}
+			}
+		}
+
+		// From a job of the manager that runs the queries. Its only thread is busy so the tasks of the batch can't start until it returns
+		{
+			ThreadJobManager singleThreadManager(1);
+
+			PhysicsSceneQueryBatch batch;
+			batch.m_queries = queries;
+			batch.m_results = results;
+			batch.m_overlaps = overlaps;
+			batch.m_jobManager = &singleThreadManager;
+			batch.m_queriesPerJob = 4;
+			singleThreadManager.dispatchTask([&batch]([[maybe_unused]] U32 tid) {
+				PhysicsWorld::getSingleton().sceneQueries(batch);
+			});
+			singleThreadManager.waitForAllTasksToFinish();
+
+			ANKI_TEST_EXPECT_EQ(batch.m_overlapCount, (kQueryCount / 4) * 2);
+			ANKI_TEST_EXPECT_EQ(results[0].m_object, box.get());
+		}
+	}
+
+	PhysicsWorld::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
@@ -0,0 +1,324 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Resource/ResourceDescriptor.h>
+#include <AnKi/Util/Filesystem.h>
+#include <AnKi/Util/HighRezTimer.h>
+
+using namespace anki;
+
+namespace {
+
+constexpr const char* kMaterialXml = R"(<?xml version="1.0" encoding="UTF-8" ?>
+<material>
+	<shaderProgram name="GBufferGeneric">
+		<mutation>
+			<mutator name="DIFFUSE_TEX" value="1"/>
+			<mutator name="NORMAL_TEX" value="0"/>
+			<mutator name="ALPHA_TEST" value="-1"/>
+		</mutation>
+	</shaderProgram>
+
+	<inputs>
+		<input name="m_diffTex" value="Assets/diffuse.ankitex"/>
+		<input name="m_specColor" value="0.04 0.04 0.04"/>
+		<input name="m_roughness" value="0.5"/>
+		<input name="m_count" value="3"/>
+	</inputs>
+</material>
+)";
+
+constexpr const char* kModelXml = R"(<model>
+	<modelPatches>
+		<modelPatch>
+			<mesh>Assets/a.ankimesh</mesh>
+			<material>Assets/a.ankimtl</material>
+		</modelPatch>
+		<modelPatch>
+			<mesh subMeshIndex="2">Assets/b.ankimesh</mesh>
+			<material>Assets/b.ankimtl</material>
+		</modelPatch>
+	</modelPatches>
+</model>
+)";
+
+constexpr const char* kParticleEmitterXml = R"(<particleEmitter>
+	<life min="2.0" max="3.0"/>
+	<mass value="1.5"/>
+	<forceDirection min="-1 0 -1" max="1 1 1"/>
+	<maxNumberOfParticles value="64"/>
+	<emissionPeriod value="0.2"/>
+	<particlesPerEmission value="4"/>
+	<usePhysicsEngine value="1"/>
+	<emitterBoundingVolume min="-2 -2 -2" max="2 2 2"/>
+	<material value="Assets/fire.ankimtl"/>
+</particleEmitter>
+)";
+
+constexpr const char* kSkeletonXml = R"(<skeleton>
+	<bones>
+		<bone name="root" transform="1 0 0 0 0 1 0 0 0 0 1 0" boneTransform="1 0 0 1 0 1 0 2 0 0 1 3"/>
+		<bone name="child" parent="root" transform="1 0 0 4 0 1 0 5 0 0 1 6" boneTransform="1 0 0 0 0 1 0 0 0 0 1 0"/>
+	</bones>
+</skeleton>
+)";
+
+constexpr const char* kAnimationXml = R"(<animation>
+	<channels>
+		<channel name="bone0">
+			<positionKeys>
+				<key time="0.0">1 2 3</key>
+				<key time="1.0">4 5 6</key>
+			</positionKeys>
+			<rotationKeys>
+				<key time="0.5">0 0 0 1</key>
+			</rotationKeys>
+		</channel>
+		<channel name="bone1">
+			<scaleKeys>
+				<key time="2.0">1.5</key>
+			</scaleKeys>
+		</channel>
+	</channels>
+</animation>
+)";
+
+constexpr const char* kImageAtlasXml = R"(<imageAtlas>
+	<image>Assets/atlas.ankitex</image>
+	<subImageMargin>2</subImageMargin>
+	<subImages>
+		<subImage>
+			<name>first</name>
+			<uv>0 0 0.5 0.5</uv>
+		</subImage>
+		<subImage>
+			<name>second</name>
+			<uv>0.5 0.5 1 1</uv>
+		</subImage>
+	</subImages>
+</imageAtlas>
+)";
+
+Error writeText(CString filename, CString text)
+{
+	File file;
+	ANKI_CHECK(file.open(filename, FileOpenFlag::kWrite));
+	ANKI_CHECK(file.writeText(text));
+	return Error::kNone;
+}
+
+/// Write the XML and its cooked form to 2 files.
+template<typename TBinary>
+Error writeXmlAndCooked(CString xmlText, CString xmlFilename, CString cookedFilename)
+{
+	ANKI_CHECK(writeText(xmlFilename, xmlText));
+
+	StackMemoryPool pool(allocAligned, nullptr, 4_KB);
+	ResourceDescriptorCooker cooker(pool);
+	ANKI_CHECK(cooker.cookFile(xmlFilename, cookedFilename));
+	return Error::kNone;
+}
+
+/// Load a descriptor from the XML and the cooked file and check both of them.
+template<typename TBinary, typename TFunc>
+void testDescriptor(CString xmlText, TFunc check)
+{
+	String tmpDir;
+	ANKI_TEST_EXPECT_NO_ERR(getTempDirectory(tmpDir));
+	String xmlFilename, cookedFilename;
+	xmlFilename.sprintf("%s/descriptor.xml", tmpDir.cstr());
+	cookedFilename.sprintf("%s/descriptor.bin", tmpDir.cstr());
+
+	ANKI_TEST_EXPECT_NO_ERR(writeXmlAndCooked<TBinary>(xmlText, xmlFilename, cookedFilename));
+
+	ResourceFilesystem fs;
+	for(CString filename : {xmlFilename.toCString(), cookedFilename.toCString()})
+	{
+		ResourceFilePtr file;
+		ANKI_TEST_EXPECT_NO_ERR(fs.openFile(filename, file));
+		ResourceDescriptor<TBinary> desc;
+		ANKI_TEST_EXPECT_NO_ERR(desc.load(*file));
+		ANKI_TEST_EXPECT_EQ(desc.isCooked(), filename == cookedFilename);
+		check(desc);
+	}
+
+	ANKI_TEST_EXPECT_NO_ERR(removeFile(xmlFilename));
+	ANKI_TEST_EXPECT_NO_ERR(removeFile(cookedFilename));
+}
+
+} // namespace
+
+ANKI_TEST(Resource, ResourceDescriptor)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	ResourceMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	testDescriptor<MaterialBinary>(kMaterialXml, [](const ResourceDescriptor<MaterialBinary>& desc) {
+		const MaterialBinary& b = desc.getBinary();
+		ANKI_TEST_EXPECT_EQ(desc.getString(b.m_shaderProgramOffset), "GBufferGeneric");
+		ANKI_TEST_EXPECT_EQ(b.m_mutations.getSize(), 3);
+		ANKI_TEST_EXPECT_EQ(desc.getString(b.m_mutations[2].m_nameOffset), "ALPHA_TEST");
+		ANKI_TEST_EXPECT_EQ(b.m_mutations[2].m_value, -1);
+
+		ANKI_TEST_EXPECT_EQ(b.m_inputs.getSize(), 4);
+		ANKI_TEST_EXPECT_EQ(desc.getString(b.m_inputs[0].m_valueOffset), "Assets/diffuse.ankitex");
+		ANKI_TEST_EXPECT_EQ(b.m_inputs[0].m_numberCount, 0);
+		ANKI_TEST_EXPECT_EQ(b.m_inputs[1].m_numberCount, 3);
+		ANKI_TEST_EXPECT_EQ(b.m_numbers[b.m_inputs[1].m_firstNumber + 2], 0.04);
+		ANKI_TEST_EXPECT_EQ(b.m_numbers[b.m_inputs[3].m_firstNumber], 3.0);
+	});
+
+	testDescriptor<ModelBinary>(kModelXml, [](const ResourceDescriptor<ModelBinary>& desc) {
+		const ModelBinary& b = desc.getBinary();
+		ANKI_TEST_EXPECT_EQ(b.m_patches.getSize(), 2);
+		ANKI_TEST_EXPECT_EQ(desc.getString(b.m_patches[0].m_meshOffset), "Assets/a.ankimesh");
+		ANKI_TEST_EXPECT_EQ(b.m_patches[0].m_subMeshIndex, kMaxU32);
+		ANKI_TEST_EXPECT_EQ(desc.getString(b.m_patches[1].m_materialOffset), "Assets/b.ankimtl");
+		ANKI_TEST_EXPECT_EQ(b.m_patches[1].m_subMeshIndex, 2);
+	});
+
+	testDescriptor<ParticleEmitterBinary>(kParticleEmitterXml, [](const ResourceDescriptor<ParticleEmitterBinary>& desc) {
+		const ParticleEmitterBinary& b = desc.getBinary();
+		ANKI_TEST_EXPECT_EQ(b.m_life.m_present, true);
+		ANKI_TEST_EXPECT_EQ(b.m_life.m_min[0], 2.0);
+		ANKI_TEST_EXPECT_EQ(b.m_life.m_max[0], 3.0);
+		ANKI_TEST_EXPECT_EQ(b.m_mass.m_min[0], b.m_mass.m_max[0]);
+		ANKI_TEST_EXPECT_EQ(b.m_forceDirection.m_min[2], -1.0);
+		ANKI_TEST_EXPECT_EQ(b.m_gravity.m_present, false);
+		ANKI_TEST_EXPECT_EQ(b.m_maxNumOfParticles, 64);
+		ANKI_TEST_EXPECT_EQ(b.m_particlesPerEmission, 4);
+		ANKI_TEST_EXPECT_EQ(b.m_usePhysicsEngine, true);
+		ANKI_TEST_EXPECT_EQ(b.m_emitterBoundingVolumeMax[1], 2.0f);
+		ANKI_TEST_EXPECT_EQ(desc.getString(b.m_materialOffset), "Assets/fire.ankimtl");
+	});
+
+	testDescriptor<SkeletonBinary>(kSkeletonXml, [](const ResourceDescriptor<SkeletonBinary>& desc) {
+		const SkeletonBinary& b = desc.getBinary();
+		ANKI_TEST_EXPECT_EQ(b.m_bones.getSize(), 2);
+		ANKI_TEST_EXPECT_EQ(b.m_bones[0].m_parentOffset, kMaxU32);
+		ANKI_TEST_EXPECT_EQ(b.m_bones[0].m_boneTransform[11], 3.0f);
+		ANKI_TEST_EXPECT_EQ(desc.getString(b.m_bones[1].m_parentOffset), "root");
+		ANKI_TEST_EXPECT_EQ(b.m_bones[1].m_transform[7], 5.0f);
+	});
+
+	testDescriptor<AnimationBinary>(kAnimationXml, [](const ResourceDescriptor<AnimationBinary>& desc) {
+		const AnimationBinary& b = desc.getBinary();
+		ANKI_TEST_EXPECT_EQ(b.m_channels.getSize(), 2);
+		ANKI_TEST_EXPECT_EQ(b.m_keyframes.getSize(), 4);
+
+		const AnimationBinaryChannel& ch0 = b.m_channels[0];
+		ANKI_TEST_EXPECT_EQ(desc.getString(ch0.m_nameOffset), "bone0");
+		ANKI_TEST_EXPECT_EQ(ch0.m_positionKeyCount, 2);
+		ANKI_TEST_EXPECT_EQ(b.m_keyframes[ch0.m_firstPositionKey + 1].m_value[2], 6.0f);
+		ANKI_TEST_EXPECT_EQ(ch0.m_rotationKeyCount, 1);
+		ANKI_TEST_EXPECT_EQ(b.m_keyframes[ch0.m_firstRotationKey].m_time, 0.5);
+		ANKI_TEST_EXPECT_EQ(ch0.m_scaleKeyCount, 0);
+
+		const AnimationBinaryChannel& ch1 = b.m_channels[1];
+		ANKI_TEST_EXPECT_EQ(ch1.m_positionKeyCount, 0);
+		ANKI_TEST_EXPECT_EQ(ch1.m_scaleKeyCount, 1);
+		ANKI_TEST_EXPECT_EQ(b.m_keyframes[ch1.m_firstScaleKey].m_value[0], 1.5f);
+	});
+
+	testDescriptor<ImageAtlasBinary>(kImageAtlasXml, [](const ResourceDescriptor<ImageAtlasBinary>& desc) {
+		const ImageAtlasBinary& b = desc.getBinary();
+		ANKI_TEST_EXPECT_EQ(desc.getString(b.m_imageOffset), "Assets/atlas.ankitex");
+		ANKI_TEST_EXPECT_EQ(b.m_subImageMargin, 2);
+		ANKI_TEST_EXPECT_EQ(b.m_subImages.getSize(), 2);
+		ANKI_TEST_EXPECT_EQ(desc.getString(b.m_subImages[1].m_nameOffset), "second");
+		ANKI_TEST_EXPECT_EQ(b.m_subImages[1].m_uv[0], 0.5f);
+	});
+
+	// A binary of the wrong type is rejected
+	{
+		String tmpDir;
+		ANKI_TEST_EXPECT_NO_ERR(getTempDirectory(tmpDir));
+		String xmlFilename, cookedFilename;
+		xmlFilename.sprintf("%s/descriptor.xml", tmpDir.cstr());
+		cookedFilename.sprintf("%s/descriptor.bin", tmpDir.cstr());
+		ANKI_TEST_EXPECT_NO_ERR(writeXmlAndCooked<ModelBinary>(kModelXml, xmlFilename, cookedFilename));
+
+		ResourceFilesystem fs;
+		ResourceFilePtr file;
+		ANKI_TEST_EXPECT_NO_ERR(fs.openFile(cookedFilename, file));
+		ResourceDescriptor<MaterialBinary> desc;
+		ANKI_TEST_EXPECT_ERR(desc.load(*file), Error::kUserData);
+
+		ANKI_TEST_EXPECT_NO_ERR(removeFile(xmlFilename));
+		ANKI_TEST_EXPECT_NO_ERR(removeFile(cookedFilename));
+	}
+
+	ResourceMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
+
+ANKI_TEST(Resource, ResourceDescriptorBenchmark)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	ResourceMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		// A scene with 10k materials
+		constexpr U32 kMaterialCount = 10000;
+
+		String tmpDir, xmlDir, cookedDir;
+		ANKI_TEST_EXPECT_NO_ERR(getTempDirectory(tmpDir));
+		xmlDir.sprintf("%s/DescriptorBenchmarkXml", tmpDir.cstr());
+		cookedDir.sprintf("%s/DescriptorBenchmarkCooked", tmpDir.cstr());
+		for(CString dir : {xmlDir.toCString(), cookedDir.toCString()})
+		{
+			if(directoryExists(dir))
+			{
+				ANKI_TEST_EXPECT_NO_ERR(removeDirectory(dir));
+			}
+			ANKI_TEST_EXPECT_NO_ERR(createDirectory(dir));
+		}
+
+		DynamicArray<String> xmlFilenames, cookedFilenames;
+		xmlFilenames.resize(kMaterialCount);
+		cookedFilenames.resize(kMaterialCount);
+		for(U32 i = 0; i < kMaterialCount; ++i)
+		{
+			xmlFilenames[i].sprintf("%s/%u.ankimtl", xmlDir.cstr(), i);
+			cookedFilenames[i].sprintf("%s/%u.ankimtl", cookedDir.cstr(), i);
+			ANKI_TEST_EXPECT_NO_ERR(writeXmlAndCooked<MaterialBinary>(kMaterialXml, xmlFilenames[i], cookedFilenames[i]));
+		}
+
+		ResourceFilesystem fs;
+		auto loadAll = [&](const DynamicArray<String>& filenames) -> Second {
+			HighRezTimer timer;
+			timer.start();
+			U32 inputCount = 0;
+			for(const String& filename : filenames)
+			{
+				ResourceFilePtr file;
+				ANKI_TEST_EXPECT_NO_ERR(fs.openFile(filename, file));
+				ResourceDescriptor<MaterialBinary> desc;
+				ANKI_TEST_EXPECT_NO_ERR(desc.load(*file));
+				inputCount += desc.getBinary().m_inputs.getSize();
+			}
+			timer.stop();
+
+			ANKI_TEST_EXPECT_EQ(inputCount, kMaterialCount * 4);
+			return timer.getElapsedTime();
+		};
+
+		// The files are outside the resource paths and opening them warns. Don't measure the console
+		Logger::getSingleton().enableSystemMessageHandler(false);
+		const Second xmlTime = loadAll(xmlFilenames);
+		const Second cookedTime = loadAll(cookedFilenames);
+		Logger::getSingleton().enableSystemMessageHandler(true);
+
+		ANKI_TEST_LOGI("Loading %u material descriptors. XML: %fms, cooked: %fms, speedup: %.2fx", kMaterialCount, xmlTime * 1000.0,
+					   cookedTime * 1000.0, xmlTime / cookedTime);
+
+		ANKI_TEST_EXPECT_NO_ERR(removeDirectory(xmlDir));
+		ANKI_TEST_EXPECT_NO_ERR(removeDirectory(cookedDir));
+	}
+
+	ResourceMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
@@ -10,24 +10,51 @@ ANKI_TEST(Resource, ResourceFilesystem)
 {
 	printf("Test requires the Data dir\n");
 
-	ResourceFilesystem fs;
-	ANKI_TEST_EXPECT_NO_ERR(fs.init());
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	ResourceMemoryPool::allocateSingleton(allocAligned, nullptr);
 
 	{
-		ANKI_TEST_EXPECT_NO_ERR(fs.addNewPath("Tests/Data/Dir/../Dir/", ResourceStringList(), ResourceStringList()));
-		ResourceFilePtr file;
-		ANKI_TEST_EXPECT_NO_ERR(fs.openFile("subdir0/hello.txt", file));
-		ResourceString txt;
-		ANKI_TEST_EXPECT_NO_ERR(file->readAllText(txt));
-		ANKI_TEST_EXPECT_EQ(txt, "hello\n");
-	}
+		ResourceFilesystem fs;
+		ANKI_TEST_EXPECT_NO_ERR(fs.init());
 
-	{
-		ANKI_TEST_EXPECT_NO_ERR(fs.addNewPath("./Tests/Data/Dir.AnKiZLibip", ResourceStringList(), ResourceStringList()));
-		ResourceFilePtr file;
-		ANKI_TEST_EXPECT_NO_ERR(fs.openFile("subdir0/hello.txt", file));
-		ResourceString txt;
-		ANKI_TEST_EXPECT_NO_ERR(file->readAllText(txt));
-		ANKI_TEST_EXPECT_EQ(txt, "hell\n");
+		{
+			ANKI_TEST_EXPECT_NO_ERR(fs.addNewPath("Tests/Data/Dir/../Dir/", ResourceStringList(), ResourceStringList()));
+			ResourceFilePtr file;
+			ANKI_TEST_EXPECT_NO_ERR(fs.openFile("subdir0/hello.txt", file));
+			ResourceString txt;
+			ANKI_TEST_EXPECT_NO_ERR(file->readAllText(txt));
+			ANKI_TEST_EXPECT_EQ(txt, "hello\n");
+
+			Array<Char, 4> buff = {};
+			ANKI_TEST_EXPECT_NO_ERR(file->readAt(1, &buff[0], 3));
+			ANKI_TEST_EXPECT_EQ(CString(&buff[0]), "ell");
+		}
+
+		{
+			ANKI_TEST_EXPECT_NO_ERR(fs.addNewPath("./Tests/Data/Dir.ankizip", ResourceStringList(), ResourceStringList()));
+			ResourceFilePtr file;
+			ANKI_TEST_EXPECT_NO_ERR(fs.openFile("subdir0/hello.txt", file));
+			ResourceString txt;
+			ANKI_TEST_EXPECT_NO_ERR(file->readAllText(txt));
+			ANKI_TEST_EXPECT_EQ(txt, "hell\n");
+		}
+
+		// Ranged reads of archived files decompress forward and rewind when needed
+		{
+			ResourceFilePtr file;
+			ANKI_TEST_EXPECT_NO_ERR(fs.openFile("subdir0/hello.txt", file));
+
+			Array<Char, 4> buff = {};
+			ANKI_TEST_EXPECT_NO_ERR(file->readAt(2, &buff[0], 2));
+			ANKI_TEST_EXPECT_EQ(CString(&buff[0]), "ll");
+			ANKI_TEST_EXPECT_NO_ERR(file->readAt(3, &buff[0], 2));
+			ANKI_TEST_EXPECT_EQ(CString(&buff[0]), "l\n");
+			ANKI_TEST_EXPECT_NO_ERR(file->readAt(0, &buff[0], 3));
+			ANKI_TEST_EXPECT_EQ(CString(&buff[0]), "hel");
+			ANKI_TEST_EXPECT_ANY_ERR(file->readAt(4, &buff[0], 2));
+		}
 	}
+
+	ResourceMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
 }
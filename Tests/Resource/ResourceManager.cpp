@@ -6,6 +6,9 @@
 #include <Tests/Framework/Framework.h>
 #include <AnKi/Resource/DummyResource.h>
 #include <AnKi/Resource/ResourceManager.h>
+#include <AnKi/Util/ThreadJobManager.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/System.h>
 
 ANKI_TEST(Resource, ResourceManager)
 {
@@ -72,3 +75,221 @@ ANKI_TEST(Resource, ResourceManager)
 	// Delete
 	ResourceManager::freeSingleton();
 }
+
+namespace {
+
+class RegistryTestResource : public ResourceObject
+{
+};
+
+/// Exposes the registry of a single resource type without the rest of the ResourceManager.
+class RegistryTest : public TypeResourceManager<RegistryTestResource>
+{
+public:
+	using TypeResourceManager::finishLoading;
+	using TypeResourceManager::FindResult;
+	using TypeResourceManager::findOrReserve;
+	using TypeResourceManager::unregisterResource;
+
+	Atomic<U32> m_loadCount = {0};
+
+	/// Does what ResourceManager::loadResource() does. The returned resource is retained.
+	RegistryTestResource* load(CString filename, Second loadTime = 0.0)
+	{
+		RegistryTestResource* rsrc;
+		if(findOrReserve(filename, rsrc) == FindResult::kFound)
+		{
+			return rsrc;
+		}
+
+		m_loadCount.fetchAdd(1);
+		HighRezTimer::sleep(loadTime);
+
+		rsrc = newInstance<RegistryTestResource>(ResourceMemoryPool::getSingleton());
+		rsrc->retain();
+		rsrc->setFilename(filename);
+		finishLoading(filename, rsrc);
+		return rsrc;
+	}
+
+	void release(RegistryTestResource* rsrc)
+	{
+		if(rsrc->release() == 1)
+		{
+			unregisterResource(rsrc);
+			deleteInstance(ResourceMemoryPool::getSingleton(), rsrc);
+		}
+	}
+};
+
+} // namespace
+
+ANKI_TEST(Resource, ResourceRegistry)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	ResourceMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		RegistryTest registry;
+
+		// Load and find
+		{
+			RegistryTestResource* a = registry.load("a");
+			RegistryTestResource* a2 = registry.load("a");
+			RegistryTestResource* b = registry.load("b");
+			ANKI_TEST_EXPECT_EQ(a, a2);
+			ANKI_TEST_EXPECT_NEQ(a, b);
+			ANKI_TEST_EXPECT_EQ(a->getRefcount(), 2);
+			ANKI_TEST_EXPECT_EQ(registry.m_loadCount.load(), 2);
+
+			registry.release(a);
+			registry.release(a2);
+			registry.release(b);
+
+			// Deleted so it should load again
+			a = registry.load("a");
+			ANKI_TEST_EXPECT_EQ(registry.m_loadCount.load(), 3);
+			registry.release(a);
+		}
+
+		// A failed load removes the reservation
+		{
+			RegistryTestResource* rsrc;
+			ANKI_TEST_EXPECT_EQ(registry.findOrReserve("error", rsrc) == RegistryTest::FindResult::kLoad, true);
+			registry.finishLoading("error", nullptr);
+			ANKI_TEST_EXPECT_EQ(registry.findOrReserve("error", rsrc) == RegistryTest::FindResult::kLoad, true);
+			registry.finishLoading("error", nullptr);
+		}
+
+		// A resource that is being deleted is not returned and its unregistration doesn't remove the new one
+		{
+			RegistryTestResource* dying = registry.load("dying");
+			ANKI_TEST_EXPECT_EQ(dying->release(), 1);
+
+			RegistryTestResource* replacement = registry.load("dying");
+			ANKI_TEST_EXPECT_NEQ(dying, replacement);
+
+			registry.unregisterResource(dying);
+			deleteInstance(ResourceMemoryPool::getSingleton(), dying);
+
+			RegistryTestResource* again = registry.load("dying");
+			ANKI_TEST_EXPECT_EQ(again, replacement);
+			registry.release(again);
+			registry.release(replacement);
+		}
+
+		// Many threads ask for the same files at the same time. Every file should be loaded once
+		{
+			constexpr U32 kFileCount = 4;
+			ThreadJobManager manager(max(getCpuCoresCount(), 8u));
+			const U32 threadCount = manager.getThreadCount();
+			registry.m_loadCount.setNonAtomically(0);
+
+			Array<RegistryTestResource*, 64> results;
+			ANKI_TEST_EXPECT_LEQ(threadCount * kFileCount, results.getSize());
+			for(U32 t = 0; t < threadCount; ++t)
+			{
+				manager.dispatchTask([&, t]([[maybe_unused]] U32 tid) {
+					for(U32 f = 0; f < kFileCount; ++f)
+					{
+						const U32 file = (f + t) % kFileCount;
+						results[t * kFileCount + file] = registry.load(String().sprintf("file%u", file).toCString(), 0.01);
+					}
+				});
+			}
+			manager.waitForAllTasksToFinish();
+
+			ANKI_TEST_EXPECT_EQ(registry.m_loadCount.load(), kFileCount);
+			for(U32 t = 0; t < threadCount; ++t)
+			{
+				for(U32 f = 0; f < kFileCount; ++f)
+				{
+					ANKI_TEST_EXPECT_EQ(results[t * kFileCount + f], results[f]);
+				}
+			}
+
+			for(U32 i = 0; i < threadCount * kFileCount; ++i)
+			{
+				registry.release(results[i]);
+			}
+		}
+	}
+
+	ResourceMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
+
+ANKI_TEST(Resource, ResourceRegistryLookup)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	ResourceMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		constexpr U32 kResourceCount = 50000;
+		constexpr U32 kLookupCount = 100000;
+
+		RegistryTest registry;
+		ResourceDynamicArray<RegistryTestResource*> resources;
+		ResourceDynamicArray<ResourceString> filenames;
+		filenames.resize(kResourceCount);
+		for(U32 i = 0; i < kResourceCount; ++i)
+		{
+			filenames[i].sprintf("Assets/Textures/Texture%u.ankitex", i);
+			resources.emplaceBack(registry.load(filenames[i].toCString()));
+		}
+
+		// Hashed registry
+		HighRezTimer timer;
+		timer.start();
+		U32 found = 0;
+		for(U32 i = 0; i < kLookupCount; ++i)
+		{
+			const U32 idx = (i * 7919) % kResourceCount;
+			RegistryTestResource* rsrc = registry.load(filenames[idx].toCString());
+			found += (rsrc == resources[idx]);
+			registry.release(rsrc);
+		}
+		timer.stop();
+		const Second hashedTime = timer.getElapsedTime();
+		ANKI_TEST_EXPECT_EQ(found, kLookupCount);
+		ANKI_TEST_EXPECT_EQ(registry.m_loadCount.load(), kResourceCount);
+
+		// The linear scan of a list that the registry replaced. Do less lookups because it's slow
+		constexpr U32 kLinearLookupCount = 1000;
+		ResourceList<RegistryTestResource*> list;
+		for(RegistryTestResource* rsrc : resources)
+		{
+			list.pushBack(rsrc);
+		}
+
+		timer.start();
+		found = 0;
+		for(U32 i = 0; i < kLinearLookupCount; ++i)
+		{
+			const U32 idx = (i * 7919) % kResourceCount;
+			for(RegistryTestResource* rsrc : list)
+			{
+				if(rsrc->getFilename() == filenames[idx].toCString())
+				{
+					found += (rsrc == resources[idx]);
+					break;
+				}
+			}
+		}
+		timer.stop();
+		const Second linearTime = timer.getElapsedTime();
+		ANKI_TEST_EXPECT_EQ(found, kLinearLookupCount);
+		list.destroy();
+
+		ANKI_TEST_LOGI("%u resources: hashed lookup %.1fns, linear lookup %.1fns", kResourceCount, hashedTime * 1000000000.0 / kLookupCount,
+					   linearTime * 1000000000.0 / kLinearLookupCount);
+
+		for(RegistryTestResource* rsrc : resources)
+		{
+			registry.release(rsrc);
+		}
+	}
+
+	ResourceMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
@@ -0,0 +1,134 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Resource/ScriptResource.h>
+#include <AnKi/Resource/ResourceManager.h>
+#include <AnKi/Resource/ResourceFilesystem.h>
+#include <AnKi/Script/ScriptManager.h>
+#include <AnKi/Script/ScriptEnvironment.h>
+#include <AnKi/Gr/GrManager.h>
+#include <AnKi/Window/NativeWindow.h>
+#include <AnKi/Util/Filesystem.h>
+#include <AnKi/Util/File.h>
+
+namespace anki {
+namespace {
+
+void writeTextFile(CString filename, CString text)
+{
+	File file;
+	ANKI_TEST_EXPECT_NO_ERR(file.open(filename, FileOpenFlag::kWrite));
+	ANKI_TEST_EXPECT_NO_ERR(file.writeText(text));
+}
+
+/// Get the bytecode cache files of the scripts.
+void gatherCacheFiles(CString dir, StringList& filenames)
+{
+	filenames.destroy();
+	ANKI_TEST_EXPECT_NO_ERR(walkDirectoryTree(dir, [&](CString path, Bool isDir) {
+		if(!isDir && path.find("ScriptBytecode_") != CString::kNpos)
+		{
+			filenames.pushBackSprintf("%s/%s", dir.cstr(), path.cstr());
+		}
+		return Error::kNone;
+	}));
+}
+
+/// Evaluate the script and check the global it sets.
+void checkScriptValue(const ScriptResource& script, U32 expectedValue)
+{
+	ScriptEnvironment env;
+	ANKI_TEST_EXPECT_NO_ERR(env.evalBytecode(script.getBytecode(), script.getFilename()));
+
+	String check;
+	check.sprintf("if value ~= %u then error(\"wrong value\") end", expectedValue);
+	ANKI_TEST_EXPECT_NO_ERR(env.evalString(check));
+}
+
+} // namespace
+} // namespace anki
+
+ANKI_TEST(Resource, ScriptResource)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	String dir;
+	ANKI_TEST_EXPECT_NO_ERR(getTempDirectory(dir));
+	dir += "/ScriptResource";
+	if(directoryExists(dir))
+	{
+		ANKI_TEST_EXPECT_NO_ERR(removeDirectory(dir));
+	}
+	String cacheDir = dir + "/Cache";
+	ANKI_TEST_EXPECT_NO_ERR(createDirectory(dir));
+	ANKI_TEST_EXPECT_NO_ERR(createDirectory(cacheDir));
+
+	// Same source in two files
+	writeTextFile(String(dir + "/Script.lua"), "value = 42\n");
+	writeTextFile(String(dir + "/ScriptCopy.lua"), "value = 42\n");
+
+	const Bool diskCache = g_scriptBytecodeDiskCacheCVar;
+	g_scriptBytecodeDiskCacheCVar.set(true);
+
+	initWindow();
+	GrManagerInitInfo grInit;
+	grInit.m_allocCallback = allocAligned;
+	grInit.m_cacheDirectory = cacheDir;
+	ANKI_TEST_EXPECT_NO_ERR(GrManager::allocateSingleton().init(grInit));
+	ANKI_TEST_EXPECT_NO_ERR(ResourceManager::allocateSingleton().init(allocAligned, nullptr));
+	ANKI_TEST_EXPECT_NO_ERR(ResourceManager::getSingleton().getFilesystem().addNewPath(dir, ResourceStringList(), ResourceStringList()));
+	ScriptManager::allocateSingleton(allocAligned, nullptr);
+
+	{
+		StringList cacheFiles;
+
+		// The 1st load compiles and writes the cache
+		{
+			ScriptResourcePtr script;
+			ANKI_TEST_EXPECT_NO_ERR(ResourceManager::getSingleton().loadResource("Script.lua", script));
+			ANKI_TEST_EXPECT_GT(script->getBytecode().getSize(), 0u);
+			checkScriptValue(*script, 42);
+		}
+
+		gatherCacheFiles(cacheDir, cacheFiles);
+		ANKI_TEST_EXPECT_EQ(cacheFiles.getSize(), 1);
+
+		// Replace the cached bytecode with something else to prove that the 2nd load reads the cache
+		{
+			ResourceDynamicArray<U8> bytecode;
+			ANKI_TEST_EXPECT_NO_ERR(ScriptResource::compile("value = 7\n", "@Script.lua", bytecode));
+
+			File file;
+			ANKI_TEST_EXPECT_NO_ERR(file.open(cacheFiles.getFront(), FileOpenFlag::kWrite | FileOpenFlag::kBinary));
+			ANKI_TEST_EXPECT_NO_ERR(file.write(&bytecode[0], bytecode.getSizeInBytes()));
+		}
+
+		{
+			ScriptResourcePtr script;
+			ANKI_TEST_EXPECT_NO_ERR(ResourceManager::getSingleton().loadResource("Script.lua", script));
+			checkScriptValue(*script, 7);
+		}
+
+		// Same source in another file has a different chunk name so it doesn't hit the cache
+		{
+			ScriptResourcePtr script;
+			ANKI_TEST_EXPECT_NO_ERR(ResourceManager::getSingleton().loadResource("ScriptCopy.lua", script));
+			checkScriptValue(*script, 42);
+		}
+
+		gatherCacheFiles(cacheDir, cacheFiles);
+		ANKI_TEST_EXPECT_EQ(cacheFiles.getSize(), 2);
+	}
+
+	ScriptManager::freeSingleton();
+	ResourceManager::freeSingleton();
+	GrManager::freeSingleton();
+	NativeWindow::freeSingleton();
+
+	g_scriptBytecodeDiskCacheCVar.set(diskCache);
+	ANKI_TEST_EXPECT_NO_ERR(removeDirectory(dir));
+	DefaultMemoryPool::freeSingleton();
+}
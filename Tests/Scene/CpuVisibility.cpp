@@ -0,0 +1,225 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Scene/CpuVisibility.h>
+#include <AnKi/Collision/Functions.h>
+#include <AnKi/Util/ThreadJobManager.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/System.h>
+#include <random>
+
+using namespace anki;
+
+static Array<Plane, 6> boxPlanes(F32 min, F32 max)
+{
+	return {Plane(Vec4(1.0f, 0.0f, 0.0f, 0.0f), min),   Plane(Vec4(-1.0f, 0.0f, 0.0f, 0.0f), -max), Plane(Vec4(0.0f, 1.0f, 0.0f, 0.0f), min),
+			Plane(Vec4(0.0f, -1.0f, 0.0f, 0.0f), -max), Plane(Vec4(0.0f, 0.0f, 1.0f, 0.0f), min),   Plane(Vec4(0.0f, 0.0f, -1.0f, 0.0f), -max)};
+}
+
+ANKI_TEST(Scene, CpuVisibility)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	SceneMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		constexpr U32 kObjectCount = 10'001; // Not a multiple of the SIMD width on purpose
+		std::mt19937 gen(42);
+		std::uniform_real_distribution<F32> posDist(-100.0f, 100.0f);
+		std::uniform_real_distribution<F32> sizeDist(0.01f, 5.0f);
+
+		SceneDynamicArray<Aabb> aabbs;
+		aabbs.resize(kObjectCount);
+		SceneDynamicArray<Sphere> spheres;
+		spheres.resize(kObjectCount);
+
+		CpuVisibilityBounds aabbBounds(CpuVisibilityShape::kAabb);
+		CpuVisibilityBounds sphereBounds(CpuVisibilityShape::kSphere);
+		aabbBounds.resize(kObjectCount);
+		sphereBounds.resize(kObjectCount);
+
+		for(U32 i = 0; i < kObjectCount; ++i)
+		{
+			const Vec4 min(posDist(gen), posDist(gen), posDist(gen), 0.0f);
+			aabbs[i] = Aabb(min, min + Vec4(sizeDist(gen), sizeDist(gen), sizeDist(gen), 0.0f));
+			spheres[i] = Sphere(min, sizeDist(gen));
+			aabbBounds.setAabb(i, aabbs[i]);
+			sphereBounds.setSphere(i, spheres[i]);
+		}
+
+		// Some objects are gone
+		SceneDynamicArray<Bool> alive;
+		alive.resize(kObjectCount, true);
+		for(U32 i = 0; i < kObjectCount; i += 13)
+		{
+			aabbBounds.invalidate(i);
+			sphereBounds.invalidate(i);
+			alive[i] = false;
+		}
+
+		const Array<Plane, 6> planes = boxPlanes(-30.0f, 50.0f);
+		const Vec3 origin(10.0f, 5.0f, -5.0f);
+		const F32 maxDistance = 45.0f;
+		const Array<F32, 2> lodDistances = {10.0f, 25.0f};
+
+		auto bruteForce = [&](U32 i, F32& distance) {
+			Bool visible = alive[i];
+			for(const Plane& plane : planes)
+			{
+				visible = visible && testPlane(plane, aabbs[i]) >= 0.0f;
+			}
+
+			const Vec3 closest = origin.max(aabbs[i].getMin().xyz()).min(aabbs[i].getMax().xyz());
+			distance = (closest - origin).getLength();
+			return visible && distance <= maxDistance;
+		};
+
+		auto bruteForceSphere = [&](U32 i, F32& distance) {
+			Bool visible = alive[i];
+			for(const Plane& plane : planes)
+			{
+				visible = visible && testPlane(plane, spheres[i]) >= 0.0f;
+			}
+
+			distance = max((spheres[i].getCenter().xyz() - origin).getLength() - spheres[i].getRadius(), 0.0f);
+			return visible && distance <= maxDistance;
+		};
+
+		ThreadJobManager jobManager(max(2u, getCpuCoresCount()));
+
+		SceneDynamicArray<U32> indices;
+		indices.resize(kObjectCount);
+		SceneDynamicArray<U8> lods;
+		lods.resize(kObjectCount);
+
+		for(ThreadJobManager* manager : {static_cast<ThreadJobManager*>(nullptr), &jobManager})
+		{
+			for(const CpuVisibilityBounds* bounds : {&aabbBounds, &sphereBounds})
+			{
+				CpuVisibilityQuery query;
+				query.m_planes = planes;
+				query.m_viewOrigin = origin;
+				query.m_maxDistance = maxDistance;
+				query.m_lodDistances = lodDistances;
+				query.m_jobManager = manager;
+				query.m_visibleIndices = indices;
+				query.m_visibleLods = lods;
+				bounds->cull(query);
+
+				SceneDynamicArray<U8> visibleLod;
+				visibleLod.resize(kObjectCount, kMaxU8);
+				for(U32 v = 0; v < query.m_visibleCount; ++v)
+				{
+					ANKI_TEST_EXPECT_EQ(visibleLod[indices[v]], kMaxU8); // No duplicates
+					visibleLod[indices[v]] = lods[v];
+				}
+
+				U32 expectedCount = 0;
+				for(U32 i = 0; i < kObjectCount; ++i)
+				{
+					F32 distance;
+					const Bool visible = (bounds == &aabbBounds) ? bruteForce(i, distance) : bruteForceSphere(i, distance);
+					ANKI_TEST_EXPECT_EQ(visible, visibleLod[i] != kMaxU8);
+
+					if(visible)
+					{
+						++expectedCount;
+						const U8 expectedLod = U8(U32(distance > lodDistances[0]) + U32(distance > lodDistances[1]));
+
+						// Allow the objects that sit on a LOD boundary to go either way
+						if(absolute(distance - lodDistances[0]) > kEpsilonf && absolute(distance - lodDistances[1]) > kEpsilonf)
+						{
+							ANKI_TEST_EXPECT_EQ(visibleLod[i], expectedLod);
+						}
+					}
+				}
+
+				ANKI_TEST_EXPECT_EQ(query.m_visibleCount, expectedCount);
+
+				// A small output only gets some of them
+				CpuVisibilityQuery smallQuery = query;
+				smallQuery.m_visibleIndices = WeakArray<U32>(indices.getBegin(), 10);
+				smallQuery.m_visibleLods = {};
+				bounds->cull(smallQuery);
+				ANKI_TEST_EXPECT_EQ(smallQuery.m_visibleCount, min(10u, expectedCount));
+			}
+		}
+
+		// Shrinking and growing again makes the objects invisible. Object 0 was invalidated above so only object 1 remains
+		aabbBounds.resize(2);
+		aabbBounds.resize(kObjectCount);
+		CpuVisibilityQuery query;
+		const Array<Plane, 6> allPlanes = boxPlanes(-1000.0f, 1000.0f);
+		query.m_planes = allPlanes;
+		query.m_visibleIndices = indices;
+		aabbBounds.cull(query);
+		ANKI_TEST_EXPECT_EQ(query.m_visibleCount, 1);
+		ANKI_TEST_EXPECT_EQ(indices[0], 1);
+	}
+
+	SceneMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
+
+ANKI_TEST(Scene, CpuVisibilityBench)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	SceneMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		constexpr U32 kObjectCount = 1'000'000;
+		constexpr U32 kIterationCount = 20;
+		std::mt19937 gen(42);
+		std::uniform_real_distribution<F32> posDist(-1000.0f, 1000.0f);
+		std::uniform_real_distribution<F32> sizeDist(0.1f, 5.0f);
+
+		CpuVisibilityBounds aabbBounds(CpuVisibilityShape::kAabb);
+		CpuVisibilityBounds sphereBounds(CpuVisibilityShape::kSphere);
+		aabbBounds.resize(kObjectCount);
+		sphereBounds.resize(kObjectCount);
+		for(U32 i = 0; i < kObjectCount; ++i)
+		{
+			const Vec4 min(posDist(gen), posDist(gen), posDist(gen), 0.0f);
+			aabbBounds.setAabb(i, Aabb(min, min + Vec4(sizeDist(gen), sizeDist(gen), sizeDist(gen), 0.0f)));
+			sphereBounds.setSphere(i, Sphere(min, sizeDist(gen)));
+		}
+
+		SceneDynamicArray<U32> indices;
+		indices.resize(kObjectCount);
+		SceneDynamicArray<U8> lods;
+		lods.resize(kObjectCount);
+
+		const Array<Plane, 6> planes = boxPlanes(-500.0f, 500.0f);
+		const Array<F32, 3> lodDistances = {100.0f, 300.0f, 600.0f};
+		ThreadJobManager jobManager(getCpuCoresCount());
+
+		for(ThreadJobManager* manager : {static_cast<ThreadJobManager*>(nullptr), &jobManager})
+		{
+			for(const CpuVisibilityBounds* bounds : {&aabbBounds, &sphereBounds})
+			{
+				CpuVisibilityQuery query;
+				query.m_planes = planes;
+				query.m_maxDistance = 800.0f;
+				query.m_lodDistances = lodDistances;
+				query.m_jobManager = manager;
+				query.m_visibleIndices = indices;
+				query.m_visibleLods = lods;
+
+				const Second begin = HighRezTimer::getCurrentTime();
+				for(U32 i = 0; i < kIterationCount; ++i)
+				{
+					bounds->cull(query);
+				}
+				const Second time = HighRezTimer::getCurrentTime() - begin;
+
+				ANKI_TEST_LOGI("%s %s: %.1f objects/ms (%u visible)", (bounds == &aabbBounds) ? "AABBs" : "Spheres",
+							   (manager) ? "threaded" : "single thread", F64(kObjectCount) * kIterationCount / (time * 1000.0), query.m_visibleCount);
+			}
+		}
+	}
+
+	SceneMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
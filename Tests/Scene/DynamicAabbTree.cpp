@@ -0,0 +1,279 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Scene/DynamicAabbTree.h>
+#include <AnKi/Collision/Functions.h>
+#include <AnKi/Collision/LineSegment.h>
+#include <AnKi/Util/ThreadJobManager.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/System.h>
+#include <random>
+
+using namespace anki;
+
+static Aabb randomAabb(std::mt19937& gen, F32 worldSize, F32 maxObjectSize)
+{
+	std::uniform_real_distribution<F32> posDist(-worldSize, worldSize);
+	std::uniform_real_distribution<F32> sizeDist(0.01f, maxObjectSize);
+	const Vec3 min(posDist(gen), posDist(gen), posDist(gen));
+	return Aabb(min, min + Vec3(sizeDist(gen), sizeDist(gen), sizeDist(gen)));
+}
+
+ANKI_TEST(Scene, DynamicAabbTree)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	SceneMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		constexpr U32 kObjectCount = 2000;
+		std::mt19937 gen(42);
+
+		DynamicAabbTree tree(0.0f); // No fat margin so the brute force results match exactly
+		SceneDynamicArray<Aabb> aabbs;
+		SceneDynamicArray<U32> ids;
+		SceneDynamicArray<Bool> alive;
+		aabbs.resize(kObjectCount);
+		ids.resize(kObjectCount);
+		alive.resize(kObjectCount, true);
+
+		for(U32 i = 0; i < kObjectCount; ++i)
+		{
+			aabbs[i] = randomAabb(gen, 100.0f, 5.0f);
+			ids[i] = tree.newObject(aabbs[i], numberToPtr<void*>(i + 1));
+		}
+
+		// Nothing visible before the flush
+		ANKI_TEST_EXPECT_EQ(tree.getObjectCount(), 0);
+		tree.flush();
+		ANKI_TEST_EXPECT_EQ(tree.getObjectCount(), kObjectCount);
+		tree.validate();
+
+		// Move half and delete some
+		for(U32 i = 0; i < kObjectCount; i += 2)
+		{
+			aabbs[i] = randomAabb(gen, 100.0f, 5.0f);
+			tree.moveObject(ids[i], aabbs[i]);
+		}
+
+		for(U32 i = 1; i < kObjectCount; i += 7)
+		{
+			tree.deleteObject(ids[i]);
+			alive[i] = false;
+		}
+
+		tree.flush();
+		tree.validate();
+
+		// The tree is balanced
+		ANKI_TEST_EXPECT_LEQ(tree.getHeight(), 2 * U32(log2(F32(kObjectCount))));
+
+		// Compare with brute force
+		auto check = [&](auto queryFunc, auto bruteFunc) {
+			SceneDynamicArray<Bool> found;
+			found.resize(kObjectCount, false);
+			queryFunc([&](void* userData) {
+				const U32 idx = U32(ptrToNumber(userData) - 1);
+				ANKI_TEST_EXPECT_EQ(alive[idx], true);
+				ANKI_TEST_EXPECT_EQ(found[idx], false);
+				found[idx] = true;
+			});
+
+			for(U32 i = 0; i < kObjectCount; ++i)
+			{
+				ANKI_TEST_EXPECT_EQ(found[i], alive[i] && bruteFunc(aabbs[i]));
+			}
+		};
+
+		const Aabb box(Vec3(-20.0f), Vec3(30.0f));
+		check(
+			[&](auto func) {
+				tree.queryAabb(box, func);
+			},
+			[&](const Aabb& aabb) {
+				return testCollision(box, aabb);
+			});
+
+		const Sphere sphere(Vec4(10.0f, -5.0f, 3.0f, 0.0f), 25.0f);
+		check(
+			[&](auto func) {
+				tree.querySphere(sphere, func);
+			},
+			[&](const Aabb& aabb) {
+				return testCollision(aabb, sphere);
+			});
+
+		const Vec3 from(-100.0f, -90.0f, -80.0f);
+		const Vec3 to(100.0f, 95.0f, 70.0f);
+		check(
+			[&](auto func) {
+				tree.queryRay(from, to, func);
+			},
+			[&](const Aabb& aabb) {
+				return testCollision(aabb, LineSegment(from.xyz0(), (to - from).xyz0()));
+			});
+
+		// A box made of planes that point inwards
+		const Array<Plane, 6> planes = {Plane(Vec4(1.0f, 0.0f, 0.0f, 0.0f), -20.0f), Plane(Vec4(-1.0f, 0.0f, 0.0f, 0.0f), -30.0f),
+										Plane(Vec4(0.0f, 1.0f, 0.0f, 0.0f), -20.0f), Plane(Vec4(0.0f, -1.0f, 0.0f, 0.0f), -30.0f),
+										Plane(Vec4(0.0f, 0.0f, 1.0f, 0.0f), -20.0f), Plane(Vec4(0.0f, 0.0f, -1.0f, 0.0f), -30.0f)};
+		check(
+			[&](auto func) {
+				tree.queryPlanes(planes, func);
+			},
+			[&](const Aabb& aabb) {
+				return testCollision(box, aabb);
+			});
+
+		// Batch queries should give the same results with and without threads
+		constexpr U32 kQueryCount = 256;
+		SceneDynamicArray<SpatialQuery> queries;
+		queries.resize(kQueryCount);
+		for(U32 i = 0; i < kQueryCount; ++i)
+		{
+			SpatialQuery& q = queries[i];
+			q.m_type = SpatialQueryType(i % U32(SpatialQueryType::kCount));
+			const Aabb a = randomAabb(gen, 100.0f, 20.0f);
+			q.m_from = a.getMin().xyz();
+			q.m_to = a.getMax().xyz();
+			q.m_radius = 10.0f;
+			q.m_planes = planes;
+		}
+
+		SceneDynamicArray<SpatialQueryResult> results;
+		results.resize(kQueryCount);
+		SceneDynamicArray<void*> objects;
+		objects.resize(kQueryCount * 64);
+
+		ThreadJobManager jobManager(max(2u, getCpuCoresCount()));
+
+		for(ThreadJobManager* manager : {static_cast<ThreadJobManager*>(nullptr), &jobManager})
+		{
+			SpatialQueryBatch batch;
+			batch.m_queries = queries;
+			batch.m_results = results;
+			batch.m_objects = objects;
+			batch.m_jobManager = manager;
+			batch.m_queriesPerJob = 8;
+			tree.queries(batch);
+
+			U32 totalCount = 0;
+			for(U32 i = 0; i < kQueryCount; ++i)
+			{
+				const SpatialQuery& q = queries[i];
+				U32 expectedCount = 0;
+				auto count = [&](void*) {
+					++expectedCount;
+				};
+
+				switch(q.m_type)
+				{
+				case SpatialQueryType::kAabb:
+					tree.queryAabb(Aabb(q.m_from, q.m_to), count);
+					break;
+				case SpatialQueryType::kSphere:
+					tree.querySphere(Sphere(q.m_from, q.m_radius), count);
+					break;
+				case SpatialQueryType::kRay:
+					tree.queryRay(q.m_from, q.m_to, count);
+					break;
+				default:
+					tree.queryPlanes(q.m_planes, count);
+				}
+
+				ANKI_TEST_EXPECT_EQ(results[i].m_objectCount, expectedCount);
+				totalCount += expectedCount;
+			}
+
+			ANKI_TEST_EXPECT_EQ(batch.m_objectCount, totalCount);
+		}
+
+		// Delete everything
+		for(U32 i = 0; i < kObjectCount; ++i)
+		{
+			if(alive[i])
+			{
+				tree.deleteObject(ids[i]);
+			}
+		}
+		tree.flush();
+		tree.validate();
+		ANKI_TEST_EXPECT_EQ(tree.getObjectCount(), 0);
+	}
+
+	SceneMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
+
+ANKI_TEST(Scene, DynamicAabbTreeBench)
+{
+	SceneMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	for(U32 objectCount : {10'000u, 100'000u, 1'000'000u})
+	{
+		std::mt19937 gen(objectCount);
+		const F32 worldSize = pow(F32(objectCount), 1.0f / 3.0f) * 10.0f; // Keep the density the same
+
+		DynamicAabbTree tree;
+		SceneDynamicArray<U32> ids;
+		ids.resize(objectCount);
+		SceneDynamicArray<Aabb> aabbs;
+		aabbs.resize(objectCount);
+		for(U32 i = 0; i < objectCount; ++i)
+		{
+			aabbs[i] = randomAabb(gen, worldSize, 2.0f);
+		}
+
+		// Insert
+		Second begin = HighRezTimer::getCurrentTime();
+		for(U32 i = 0; i < objectCount; ++i)
+		{
+			ids[i] = tree.newObject(aabbs[i], numberToPtr<void*>(i + 1));
+		}
+		tree.flush();
+		const Second insertTime = HighRezTimer::getCurrentTime() - begin;
+
+		// Move all of them a little (most stay inside their fat AABBs) and 10% of them a lot
+		std::uniform_real_distribution<F32> smallMove(-0.05f, 0.05f);
+		for(U32 i = 0; i < objectCount; ++i)
+		{
+			if(i % 10 == 0)
+			{
+				aabbs[i] = randomAabb(gen, worldSize, 2.0f);
+			}
+			else
+			{
+				const Vec3 offset(smallMove(gen), smallMove(gen), smallMove(gen));
+				aabbs[i] = Aabb(aabbs[i].getMin().xyz() + offset, aabbs[i].getMax().xyz() + offset);
+			}
+		}
+
+		begin = HighRezTimer::getCurrentTime();
+		for(U32 i = 0; i < objectCount; ++i)
+		{
+			tree.moveObject(ids[i], aabbs[i]);
+		}
+		tree.flush();
+		const Second refitTime = HighRezTimer::getCurrentTime() - begin;
+
+		// Query
+		constexpr U32 kQueryCount = 10'000;
+		U32 hitCount = 0;
+		begin = HighRezTimer::getCurrentTime();
+		for(U32 i = 0; i < kQueryCount; ++i)
+		{
+			tree.querySphere(Sphere(randomAabb(gen, worldSize, 1.0f).getMin(), 10.0f), [&](void*) {
+				++hitCount;
+			});
+		}
+		const Second queryTime = HighRezTimer::getCurrentTime() - begin;
+
+		ANKI_TEST_LOGI("%u objects: insert %.1f objects/ms, refit %.1f objects/ms, sphere query %.1f queries/ms (%u hits), height %u", objectCount,
+					   F64(objectCount) / (insertTime * 1000.0), F64(objectCount) / (refitTime * 1000.0), F64(kQueryCount) / (queryTime * 1000.0),
+					   hitCount, tree.getHeight());
+	}
+
+	SceneMemoryPool::freeSingleton();
+}
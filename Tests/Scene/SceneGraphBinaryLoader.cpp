@@ -0,0 +1,199 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Scene/SceneGraph.h>
+#include <AnKi/Scene/SceneBinary.h>
+#include <AnKi/Scene/Components/LightComponent.h>
+#include <AnKi/Scene/Components/CameraComponent.h>
+#include <AnKi/Util/Serializer.h>
+#include <AnKi/Util/Filesystem.h>
+
+namespace anki {
+namespace {
+
+constexpr Char kStrings[] = "Root\0Child\0Grandchild\0Camera";
+
+SceneBinaryNode newNode(U32 nameOffset, U32 parent, Vec3 origin, U32 firstComponent = 0, U32 componentCount = 0)
+{
+	SceneBinaryNode node;
+	node.m_rotation = {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+	node.m_origin = {origin.x(), origin.y(), origin.z()};
+	node.m_scale = {1.0f, 1.0f, 1.0f};
+	node.m_nameOffset = nameOffset;
+	node.m_parent = parent;
+	node.m_firstComponent = firstComponent;
+	node.m_componentCount = componentCount;
+	return node;
+}
+
+SceneBinaryProperty newProperty(SceneBinaryPropertyType type, U32 uintValue, Vec4 floatValues = Vec4(0.0f))
+{
+	SceneBinaryProperty prop;
+	prop.m_type = type;
+	prop.m_uintValue = uintValue;
+	prop.m_floatValues = {floatValues.x(), floatValues.y(), floatValues.z(), floatValues.w()};
+	return prop;
+}
+
+/// A scene with a hierarchy of 3 nodes plus a camera. The arrays are pointed by m_binary.
+class TestSceneBinary
+{
+public:
+	Array<SceneBinaryNode, 4> m_nodes;
+	Array<SceneBinaryComponent, 2> m_components;
+	Array<SceneBinaryProperty, 5> m_properties;
+	Array<Char, sizeof(kStrings)> m_strings;
+	SceneBinary m_binary;
+
+	TestSceneBinary()
+	{
+		m_nodes[0] = newNode(0, kMaxU32, Vec3(1.0f, 0.0f, 0.0f));
+		m_nodes[1] = newNode(5, 0, Vec3(0.0f, 2.0f, 0.0f), 0, 1);
+		m_nodes[2] = newNode(11, 1, Vec3(0.0f, 0.0f, 3.0f));
+		m_nodes[3] = newNode(22, kMaxU32, Vec3(0.0f), 1, 1);
+
+		m_components[0].m_type = SceneBinaryComponentType::kLight;
+		m_components[0].m_firstProperty = 0;
+		m_components[0].m_propertyCount = 3;
+		m_components[1].m_type = SceneBinaryComponentType::kCamera;
+		m_components[1].m_firstProperty = 3;
+		m_components[1].m_propertyCount = 2;
+
+		m_properties[0] = newProperty(SceneBinaryPropertyType::kLightType, U32(LightComponentType::kSpot));
+		m_properties[1] = newProperty(SceneBinaryPropertyType::kDiffuseColor, kMaxU32, Vec4(1.0f, 0.5f, 0.25f, 1.0f));
+		m_properties[2] = newProperty(SceneBinaryPropertyType::kDistance, kMaxU32, Vec4(5.0f, 0.0f, 0.0f, 0.0f));
+		m_properties[3] = newProperty(SceneBinaryPropertyType::kPerspective, kMaxU32, Vec4(0.5f, 200.0f, 1.0f, 0.0f));
+		m_properties[4] = newProperty(SceneBinaryPropertyType::kActiveCamera, kMaxU32);
+
+		memcpy(m_strings.getBegin(), kStrings, sizeof(kStrings));
+
+		memcpy(m_binary.m_magic.getBegin(), kSceneBinaryMagic, sizeof(m_binary.m_magic));
+		m_binary.m_nodes = m_nodes;
+		m_binary.m_components = m_components;
+		m_binary.m_properties = m_properties;
+		m_binary.m_strings = m_strings;
+	}
+};
+
+} // namespace
+} // namespace anki
+
+ANKI_TEST(Scene, SceneGraphBinaryLoader)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	GrMemoryPool::allocateSingleton(allocAligned, nullptr); // For the node dictionary
+	SceneMemoryPool::allocateSingleton(allocAligned, nullptr);
+	TransformHierarchy::allocateSingleton();
+	SceneGraph& scene = SceneGraph::allocateSingleton();
+
+	// Write and load
+	{
+		TestSceneBinary in;
+
+		String filename;
+		ANKI_TEST_EXPECT_NO_ERR(getTempDirectory(filename));
+		filename += "/SceneGraphBinaryLoader.ankiscene";
+		{
+			File file;
+			ANKI_TEST_EXPECT_NO_ERR(file.open(filename, FileOpenFlag::kWrite | FileOpenFlag::kBinary));
+			BinarySerializer serializer;
+			ANKI_TEST_EXPECT_NO_ERR(serializer.serialize(in.m_binary, SceneMemoryPool::getSingleton(), file));
+		}
+
+		SceneBinary* binary = nullptr;
+		{
+			File file;
+			ANKI_TEST_EXPECT_NO_ERR(file.open(filename, FileOpenFlag::kRead | FileOpenFlag::kBinary));
+			BinaryDeserializer deserializer;
+			ANKI_TEST_EXPECT_NO_ERR(deserializer.deserialize(binary, SceneMemoryPool::getSingleton(), file));
+		}
+
+		ANKI_TEST_EXPECT_NO_ERR(scene.loadSceneBinary(*binary, filename));
+		SceneMemoryPool::getSingleton().free(binary);
+		ANKI_TEST_EXPECT_NO_ERR(removeFile(filename));
+
+		ANKI_TEST_EXPECT_EQ(scene.getSceneNodesCount(), 4);
+
+		SceneNode& root = scene.findSceneNode("Root");
+		SceneNode& child = scene.findSceneNode("Child");
+		SceneNode& grandchild = scene.findSceneNode("Grandchild");
+		SceneNode& camera = scene.findSceneNode("Camera");
+
+		// Parent links
+		ANKI_TEST_EXPECT_EQ(root.getParent(), nullptr);
+		ANKI_TEST_EXPECT_EQ(child.getParent(), &root);
+		ANKI_TEST_EXPECT_EQ(grandchild.getParent(), &child);
+		ANKI_TEST_EXPECT_EQ(camera.getParent(), nullptr);
+
+		// Local transforms
+		ANKI_TEST_EXPECT_EQ(root.getLocalTransform().getOrigin().xyz(), Vec3(1.0f, 0.0f, 0.0f));
+		ANKI_TEST_EXPECT_EQ(child.getLocalTransform().getOrigin().xyz(), Vec3(0.0f, 2.0f, 0.0f));
+		ANKI_TEST_EXPECT_EQ(grandchild.getLocalTransform().getOrigin().xyz(), Vec3(0.0f, 0.0f, 3.0f));
+
+		// Components and their properties
+		ANKI_TEST_EXPECT_EQ(root.countComponentsOfType<LightComponent>(), 0);
+		ANKI_TEST_EXPECT_EQ(child.countComponentsOfType<LightComponent>(), 1);
+		ANKI_TEST_EXPECT_EQ(grandchild.countComponentsOfType<LightComponent>(), 0);
+
+		const LightComponent& light = child.getFirstComponentOfType<LightComponent>();
+		ANKI_TEST_EXPECT_EQ(light.getLightComponentType(), LightComponentType::kSpot);
+		ANKI_TEST_EXPECT_EQ(light.getDiffuseColor(), Vec4(1.0f, 0.5f, 0.25f, 1.0f));
+		ANKI_TEST_EXPECT_EQ(light.getDistance(), 5.0f);
+
+		const CameraComponent& cam = camera.getFirstComponentOfType<CameraComponent>();
+		ANKI_TEST_EXPECT_EQ(cam.getNear(), 0.5f);
+		ANKI_TEST_EXPECT_EQ(cam.getFar(), 200.0f);
+		ANKI_TEST_EXPECT_EQ(cam.getFovY(), 1.0f);
+		ANKI_TEST_EXPECT_EQ(&scene.getActiveCameraNode(), &camera);
+	}
+
+	// Corrupt binaries are rejected before anything is created
+	{
+		const U32 nodeCount = scene.getSceneNodesCount();
+
+		{
+			TestSceneBinary in;
+			in.m_binary.m_magic[7] = '0';
+			ANKI_TEST_EXPECT_ERR(scene.loadSceneBinary(in.m_binary, "Magic"), Error::kUserData);
+		}
+
+		{
+			TestSceneBinary in;
+			in.m_nodes[1].m_parent = 2; // Parents should come first
+			ANKI_TEST_EXPECT_ERR(scene.loadSceneBinary(in.m_binary, "Parent"), Error::kUserData);
+		}
+
+		{
+			TestSceneBinary in;
+			in.m_nodes[3].m_componentCount = 2;
+			ANKI_TEST_EXPECT_ERR(scene.loadSceneBinary(in.m_binary, "Component"), Error::kUserData);
+		}
+
+		{
+			TestSceneBinary in;
+			in.m_components[1].m_propertyCount = 3;
+			ANKI_TEST_EXPECT_ERR(scene.loadSceneBinary(in.m_binary, "Property"), Error::kUserData);
+		}
+
+		{
+			TestSceneBinary in;
+			in.m_properties[0] = newProperty(SceneBinaryPropertyType::kResource, 0); // There are no resources
+			ANKI_TEST_EXPECT_ERR(scene.loadSceneBinary(in.m_binary, "Resource"), Error::kUserData);
+		}
+
+		{
+			TestSceneBinary in;
+			in.m_nodes[2].m_nameOffset = sizeof(kStrings);
+			ANKI_TEST_EXPECT_ERR(scene.loadSceneBinary(in.m_binary, "Name"), Error::kUserData);
+		}
+
+		ANKI_TEST_EXPECT_EQ(scene.getSceneNodesCount(), nodeCount);
+	}
+
+	SceneGraph::freeSingleton();
+	GrMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
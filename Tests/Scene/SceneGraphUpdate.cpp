@@ -0,0 +1,117 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Scene/SceneGraph.h>
+#include <AnKi/Core/Common.h>
+#include <AnKi/Util/System.h>
+
+namespace anki {
+namespace {
+
+constexpr U32 kRootCount = 10'000;
+constexpr U32 kChildrenPerRoot = 9; ///< 100k nodes in total.
+constexpr U32 kMovingRootsPerFrame = kRootCount / 10;
+
+/// A scene of 100k nodes with their implicit MoveComponent. A few of the roots move every frame and they move their children.
+class BenchmarkScene
+{
+public:
+	SceneDynamicArray<SceneNode*> m_roots;
+	U32 m_frame = 0;
+
+	BenchmarkScene()
+	{
+		DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+		GrMemoryPool::allocateSingleton(allocAligned, nullptr); // For the node dictionary
+		SceneMemoryPool::allocateSingleton(allocAligned, nullptr);
+		CoreThreadJobManager::allocateSingleton(getCpuCoresCount());
+		GlobalFrameIndex::allocateSingleton();
+		TransformHierarchy::allocateSingleton();
+		SceneGraph& scene = SceneGraph::allocateSingleton();
+
+		m_roots.resize(kRootCount);
+		for(U32 i = 0; i < kRootCount; ++i)
+		{
+			if(scene.newSceneNode(CString(), m_roots[i]))
+			{
+				ANKI_TEST_LOGF("Failed to create a node");
+			}
+			m_roots[i]->setLocalOrigin(Vec4(F32(i), 0.0f, 0.0f, 0.0f));
+
+			for(U32 j = 0; j < kChildrenPerRoot; ++j)
+			{
+				SceneNode* child;
+				if(scene.newSceneNode(CString(), child))
+				{
+					ANKI_TEST_LOGF("Failed to create a node");
+				}
+				child->setLocalOrigin(Vec4(0.0f, F32(j), 0.0f, 0.0f));
+				m_roots[i]->addChild(child);
+			}
+		}
+
+		// Sort the hierarchy and compute the world transforms once
+		update();
+	}
+
+	~BenchmarkScene()
+	{
+		m_roots.destroy();
+		SceneGraph::freeSingleton();
+		GlobalFrameIndex::freeSingleton();
+		CoreThreadJobManager::freeSingleton();
+		GrMemoryPool::freeSingleton();
+		DefaultMemoryPool::freeSingleton();
+	}
+
+	void update()
+	{
+		for(U32 i = 0; i < kMovingRootsPerFrame; ++i)
+		{
+			SceneNode& root = *m_roots[(m_frame * kMovingRootsPerFrame + i) % kRootCount];
+			root.setLocalOrigin(root.getLocalOrigin() + Vec4(0.0f, 0.0f, 1.0f, 0.0f));
+		}
+
+		SceneGraph::getSingleton().updateNodesAndComponents(0.0, 1.0 / 60.0);
+		++GlobalFrameIndex::getSingleton().m_value;
+		++m_frame;
+	}
+};
+
+} // namespace
+} // namespace anki
+
+ANKI_BENCHMARK(Scene, Update100kNodesTypeBatched)
+{
+	const Bool typeBatched = g_typeBatchedComponentUpdateCVar;
+	g_typeBatchedComponentUpdateCVar.set(true);
+
+	{
+		BenchmarkScene scene;
+		while(bench.keepRunning())
+		{
+			scene.update();
+		}
+	}
+
+	g_typeBatchedComponentUpdateCVar.set(typeBatched);
+}
+
+ANKI_BENCHMARK(Scene, Update100kNodesHierarchical)
+{
+	const Bool typeBatched = g_typeBatchedComponentUpdateCVar;
+	g_typeBatchedComponentUpdateCVar.set(false);
+
+	{
+		BenchmarkScene scene;
+		while(bench.keepRunning())
+		{
+			scene.update();
+		}
+	}
+
+	g_typeBatchedComponentUpdateCVar.set(typeBatched);
+}
@@ -0,0 +1,189 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Scene/SceneGraph.h>
+#include <random>
+
+namespace anki {
+namespace {
+
+Transform computeWorldTransform(const SceneNode& node)
+{
+	const SceneNode* parent = node.getParent();
+	return (parent && !node.getIgnoreParentTransform()) ? computeWorldTransform(*parent).combineTransformations(node.getLocalTransform())
+														: node.getLocalTransform();
+}
+
+} // namespace
+} // namespace anki
+
+ANKI_TEST(Scene, TransformHierarchy)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	GrMemoryPool::allocateSingleton(allocAligned, nullptr); // For the node dictionary
+	SceneMemoryPool::allocateSingleton(allocAligned, nullptr);
+	TransformHierarchy& hierarchy = TransformHierarchy::allocateSingleton();
+	SceneGraph& scene = SceneGraph::allocateSingleton();
+
+	{
+		SceneNode* a;
+		SceneNode* b;
+		SceneNode* c;
+		ANKI_TEST_EXPECT_NO_ERR(scene.newSceneNode("A", a));
+		ANKI_TEST_EXPECT_NO_ERR(scene.newSceneNode("B", b));
+		ANKI_TEST_EXPECT_NO_ERR(scene.newSceneNode("C", c));
+		a->setLocalOrigin(Vec4(1.0f, 0.0f, 0.0f, 0.0f));
+		b->setLocalOrigin(Vec4(0.0f, 2.0f, 0.0f, 0.0f));
+		c->setLocalOrigin(Vec4(0.0f, 0.0f, 3.0f, 0.0f));
+
+		// A -> B -> C
+		a->addChild(b);
+		b->addChild(c);
+		hierarchy.update();
+		ANKI_TEST_EXPECT_EQ(hierarchy.getHierarchyLevelCount(), 3);
+		ANKI_TEST_EXPECT_EQ(a->getWorldTransform().getOrigin().xyz(), Vec3(1.0f, 0.0f, 0.0f));
+		ANKI_TEST_EXPECT_EQ(b->getWorldTransform().getOrigin().xyz(), Vec3(1.0f, 2.0f, 0.0f));
+		ANKI_TEST_EXPECT_EQ(c->getWorldTransform().getOrigin().xyz(), Vec3(1.0f, 2.0f, 3.0f));
+
+		// Nothing moved
+		hierarchy.update();
+		ANKI_TEST_EXPECT_EQ(c->movedThisFrame(), false);
+		ANKI_TEST_EXPECT_EQ(c->getWorldTransform().getOrigin().xyz(), Vec3(1.0f, 2.0f, 3.0f));
+
+		// Moving the root moves the whole tree
+		a->setLocalOrigin(Vec4(-1.0f, 0.0f, 0.0f, 0.0f));
+		hierarchy.update();
+		ANKI_TEST_EXPECT_EQ(c->movedThisFrame(), true);
+		ANKI_TEST_EXPECT_EQ(c->getWorldTransform().getOrigin().xyz(), Vec3(-1.0f, 2.0f, 3.0f));
+
+		// A second update in the same frame propagates the new changes and keeps the previous world transforms of the frame
+		b->setLocalOrigin(Vec4(0.0f, 4.0f, 0.0f, 0.0f));
+		hierarchy.update(false);
+		ANKI_TEST_EXPECT_EQ(c->movedThisFrame(), true);
+		ANKI_TEST_EXPECT_EQ(c->getWorldTransform().getOrigin().xyz(), Vec3(-1.0f, 4.0f, 3.0f));
+		ANKI_TEST_EXPECT_EQ(c->getPreviousWorldTransform().getOrigin().xyz(), Vec3(1.0f, 2.0f, 3.0f));
+		ANKI_TEST_EXPECT_EQ(a->getPreviousWorldTransform().getOrigin().xyz(), Vec3(1.0f, 0.0f, 0.0f));
+
+		b->setLocalOrigin(Vec4(0.0f, 2.0f, 0.0f, 0.0f));
+		hierarchy.update();
+		ANKI_TEST_EXPECT_EQ(c->getWorldTransform().getOrigin().xyz(), Vec3(-1.0f, 2.0f, 3.0f));
+		ANKI_TEST_EXPECT_EQ(c->getPreviousWorldTransform().getOrigin().xyz(), Vec3(-1.0f, 4.0f, 3.0f));
+
+		// Reparent C under A
+		c->setParent(a);
+		hierarchy.update();
+		ANKI_TEST_EXPECT_EQ(c->getParent(), a);
+		ANKI_TEST_EXPECT_EQ(hierarchy.getHierarchyLevelCount(), 2);
+		ANKI_TEST_EXPECT_EQ(c->movedThisFrame(), true);
+		ANKI_TEST_EXPECT_EQ(c->getWorldTransform().getOrigin().xyz(), Vec3(-1.0f, 0.0f, 3.0f));
+		ANKI_TEST_EXPECT_EQ(c->getPreviousWorldTransform().getOrigin().xyz(), Vec3(-1.0f, 2.0f, 3.0f));
+
+		// Move C back under B. B is still moved by A
+		c->setParent(b);
+		a->setLocalOrigin(Vec4(5.0f, 0.0f, 0.0f, 0.0f));
+		hierarchy.update();
+		ANKI_TEST_EXPECT_EQ(hierarchy.getHierarchyLevelCount(), 3);
+		ANKI_TEST_EXPECT_EQ(c->getWorldTransform().getOrigin().xyz(), Vec3(5.0f, 2.0f, 3.0f));
+
+		// Remove B from A. B and its child C are not affected by A anymore
+		a->removeChild(b);
+		hierarchy.update();
+		ANKI_TEST_EXPECT_EQ(b->getParent(), nullptr);
+		ANKI_TEST_EXPECT_EQ(c->getParent(), b);
+		ANKI_TEST_EXPECT_EQ(hierarchy.getHierarchyLevelCount(), 2);
+		ANKI_TEST_EXPECT_EQ(b->getWorldTransform().getOrigin().xyz(), Vec3(0.0f, 2.0f, 0.0f));
+		ANKI_TEST_EXPECT_EQ(c->getWorldTransform().getOrigin().xyz(), Vec3(0.0f, 2.0f, 3.0f));
+
+		a->setLocalOrigin(Vec4(10.0f, 0.0f, 0.0f, 0.0f));
+		hierarchy.update();
+		ANKI_TEST_EXPECT_EQ(a->getWorldTransform().getOrigin().xyz(), Vec3(10.0f, 0.0f, 0.0f));
+		ANKI_TEST_EXPECT_EQ(c->movedThisFrame(), false);
+		ANKI_TEST_EXPECT_EQ(c->getWorldTransform().getOrigin().xyz(), Vec3(0.0f, 2.0f, 3.0f));
+
+		// Detach C with a null parent
+		c->setParent(nullptr);
+		hierarchy.update();
+		ANKI_TEST_EXPECT_EQ(hierarchy.getHierarchyLevelCount(), 1);
+		ANKI_TEST_EXPECT_EQ(c->getWorldTransform().getOrigin().xyz(), Vec3(0.0f, 0.0f, 3.0f));
+	}
+
+	SceneGraph::freeSingleton();
+	GrMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
+
+ANKI_TEST(Scene, TransformHierarchyIncremental)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	GrMemoryPool::allocateSingleton(allocAligned, nullptr); // For the node dictionary
+	SceneMemoryPool::allocateSingleton(allocAligned, nullptr);
+	TransformHierarchy& hierarchy = TransformHierarchy::allocateSingleton();
+	SceneGraph& scene = SceneGraph::allocateSingleton();
+
+	{
+		constexpr U32 kInitialNodeCount = 1000;
+		constexpr U32 kFrameCount = 100;
+		std::mt19937 gen(123);
+		auto random = [&](U32 count) {
+			return U32(gen() % count);
+		};
+
+		SceneDynamicArray<SceneNode*> nodes;
+		auto newNode = [&]() {
+			SceneNode* node;
+			ANKI_TEST_EXPECT_NO_ERR(scene.newSceneNode(CString(), node));
+			node->setLocalOrigin(Vec4(F32(random(100)), F32(random(100)), F32(random(100)), 0.0f));
+			nodes.emplaceBack(node);
+		};
+
+		for(U32 i = 0; i < kInitialNodeCount; ++i)
+		{
+			newNode();
+		}
+
+		// A few levels to start with
+		for(U32 i = 1; i < kInitialNodeCount; i += 2)
+		{
+			nodes[i - 1]->addChild(nodes[i]);
+		}
+
+		hierarchy.update();
+		const U32 sortCount = hierarchy.getSortCount();
+
+		for(U32 frame = 0; frame < kFrameCount; ++frame)
+		{
+			for(U32 i = 0; i < 20; ++i)
+			{
+				// Move leaves around. They have no descendants so any other node can be the new parent
+				SceneNode& leaf = *nodes[random(nodes.getSize())];
+				if(!leaf.hasChildren())
+				{
+					SceneNode* parent = nodes[random(nodes.getSize())];
+					leaf.setParent((parent != &leaf && random(4) != 0) ? parent : nullptr);
+				}
+
+				nodes[random(nodes.getSize())]->setLocalOrigin(Vec4(F32(random(100)), 0.0f, 0.0f, 0.0f));
+			}
+
+			newNode();
+			nodes[random(nodes.getSize())]->setIgnoreParentTransform(random(2) == 0);
+
+			hierarchy.update();
+
+			for(const SceneNode* node : nodes)
+			{
+				ANKI_TEST_EXPECT_EQ(node->getWorldTransform(), computeWorldTransform(*node));
+			}
+		}
+
+		// Most of the changes don't need to sort the transforms from scratch
+		ANKI_TEST_EXPECT_LEQ(hierarchy.getSortCount() - sortCount, kFrameCount / 10);
+	}
+
+	SceneGraph::freeSingleton();
+	GrMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
@@ -5,6 +5,7 @@
 
 #include <Tests/Framework/Framework.h>
 #include <AnKi/Script.h>
+#include <AnKi/Resource/ScriptResource.h>
 #include <AnKi/Math.h>
 
 ANKI_TEST(Script, LuaBinder)
@@ -106,3 +107,164 @@ print(vec:getX(), vec:getY(), vec:getZ())
 
 	ScriptManager::freeSingleton();
 }
+
+ANKI_TEST(Script, LuaBinderBytecode)
+{
+	ScriptManager::allocateSingleton(allocAligned, nullptr);
+	ResourceMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	static const char* script = R"(
+vec = Vec3.new(1, 2, 3)
+vec:setY(vec:getY() + 1)
+)";
+
+	ResourceDynamicArray<U8> bytecode;
+	ANKI_TEST_EXPECT_NO_ERR(ScriptResource::compile(script, "test", bytecode));
+	ANKI_TEST_EXPECT_GT(bytecode.getSize(), 0u);
+
+	// Compiled once, evaluated in many environments
+	for(U32 i = 0; i < 2; ++i)
+	{
+		ScriptEnvironment env;
+		ANKI_TEST_EXPECT_NO_ERR(env.evalBytecode(bytecode));
+		ANKI_TEST_EXPECT_NO_ERR(env.evalString("if vec:getY() ~= 3 then error(\"wrong\") end"));
+	}
+
+	// Source with errors shouldn't compile
+	ResourceDynamicArray<U8> bytecode2;
+	ANKI_TEST_EXPECT_EQ(ScriptResource::compile("this is not lua", "test", bytecode2), Error::kUserData);
+
+	bytecode.destroy();
+	ResourceMemoryPool::freeSingleton();
+	ScriptManager::freeSingleton();
+}
+
+ANKI_TEST(Script, LuaBinderMathTemporaries)
+{
+	ScriptManager::allocateSingleton(allocAligned, nullptr);
+
+	static const char* script = R"(
+a = Vec3.new(1, 2, 3)
+b = Vec3.new(1, 1, 1)
+c = Vec3.new()
+
+a:addAssign(b)
+a:subTo(b, c)
+c:mulAssign(Vec3.new(2))
+if c:getX() ~= 2 or c:getY() ~= 4 or c:getZ() ~= 6 then error("wrong") end
+
+n = c:getNormalizedTo(Vec3.new())
+if math.abs(n:getLength() - 1) > 0.0001 then error("wrong") end
+
+-- Recycled user data should be usable
+for i = 1, 1000 do
+	local tmp = a + b
+end
+collectgarbage()
+d = Vec3.new(5)
+if d:getX() ~= 5 or d:getZ() ~= 5 then error("wrong") end
+)";
+
+	{
+		ScriptEnvironment env;
+		ANKI_TEST_EXPECT_NO_ERR(env.evalString(script));
+	}
+
+	ScriptManager::freeSingleton();
+}
+
+ANKI_TEST(Script, LuaBinderMathTemporariesBench)
+{
+	ScriptManager::allocateSingleton(allocAligned, nullptr);
+
+	// Measures the bytes that the GC will have to collect (GC is stopped) and the time with the GC running
+	static const char* script = R"(
+local iterations = 1000000
+local a = Vec4.new(1, 2, 3, 4)
+local b = Vec4.new(0.5)
+local c = Vec4.new()
+
+function operators()
+	for i = 1, iterations do
+		c = a + b * b
+	end
+end
+
+function inPlace()
+	for i = 1, iterations do
+		b:mulTo(b, c)
+		c:addAssign(a)
+	end
+end
+
+function measure(name, func)
+	collectgarbage()
+	collectgarbage("stop")
+	local kbBefore = collectgarbage("count")
+	func()
+	local kbAfter = collectgarbage("count")
+	collectgarbage("restart")
+
+	local before = os.clock()
+	func()
+	local ms = (os.clock() - before) * 1000.0
+
+	logi(string.format("%s: garbage %.1fKB, %.3fms", name, kbAfter - kbBefore, ms))
+	return kbAfter - kbBefore
+end
+
+local garbageOperators = measure("Operators", operators)
+local garbageInPlace = measure("In-place", inPlace)
+
+if garbageInPlace >= garbageOperators then
+	error("In-place variants shouldn't allocate")
+end
+)";
+
+	{
+		ScriptEnvironment env;
+		ANKI_TEST_EXPECT_NO_ERR(env.evalString(script));
+	}
+
+	ScriptManager::freeSingleton();
+}
+
+ANKI_TEST(Script, LuaBinderAllocator)
+{
+	ScriptManager::allocateSingleton(allocAligned, nullptr);
+	const U32 poolAllocationCount = ScriptMemoryPool::getSingleton().getAllocationCount();
+
+	{
+		ScriptEnvironment env;
+		const LuaMemoryStats initialStats = env.getMemoryStats();
+		ANKI_TEST_EXPECT_GT(initialStats.m_allocationCount, 0u);
+		ANKI_TEST_EXPECT_LEQ(initialStats.m_usedMemory, initialStats.m_reservedMemory);
+
+		static const char* script = R"(
+t = {}
+for i = 1, 10000 do
+	t[i] = {name = "entity" .. i, pos = Vec3.new(i, i, i)}
+end
+)";
+
+		ANKI_TEST_EXPECT_NO_ERR(env.evalString(script));
+		const LuaMemoryStats peakStats = env.getMemoryStats();
+		ANKI_TEST_EXPECT_GT(peakStats.m_usedMemory, initialStats.m_usedMemory);
+		ANKI_TEST_EXPECT_LEQ(peakStats.m_usedMemory, peakStats.m_reservedMemory);
+
+		// The small blocks are recycled, the chunks stay alive
+		ANKI_TEST_EXPECT_NO_ERR(env.evalString("t = nil; collectgarbage()"));
+		const LuaMemoryStats stats = env.getMemoryStats();
+		ANKI_TEST_EXPECT_LT(stats.m_usedMemory, peakStats.m_usedMemory);
+		ANKI_TEST_EXPECT_LT(stats.m_allocationCount, peakStats.m_allocationCount);
+
+		// Re-run. The memory should come from the free lists
+		ANKI_TEST_EXPECT_NO_ERR(env.evalString(script));
+		ANKI_TEST_EXPECT_LEQ(env.getMemoryStats().m_reservedMemory, peakStats.m_reservedMemory + 64_KB);
+	}
+
+	// Everything is released with the environment
+	ANKI_TEST_EXPECT_EQ(ScriptMemoryPool::getSingleton().getAllocationCount(), poolAllocationCount);
+
+	ScriptManager::freeSingleton();
+}
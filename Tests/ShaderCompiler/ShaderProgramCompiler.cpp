@@ -6,6 +6,7 @@
 #include <Tests/Framework/Framework.h>
 #include <AnKi/ShaderCompiler/ShaderCompiler.h>
 #include <AnKi/ShaderCompiler/ShaderDump.h>
+#include <AnKi/ShaderCompiler/ShaderParser.h>
 #include <AnKi/Util/ThreadHive.h>
 
 ANKI_TEST(ShaderCompiler, ShaderProgramCompilerSimple)
@@ -342,3 +343,70 @@ void main()
 	ANKI_LOGI("Binary disassembly:\n%s\n", dis.cstr());
 #endif
 }
+
+ANKI_TEST(ShaderCompiler, ShaderProgramCompilerDeferred)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	ShaderCompilerMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		class Fsystem : public ShaderCompilerFilesystemInterface
+		{
+		public:
+			Error readAllText([[maybe_unused]] CString filename, ShaderCompilerString& txt) final
+			{
+				txt = R"(
+#pragma anki mutator A 0 1
+#pragma anki mutator B 0 1 2
+#pragma anki skip_mutation A 1 B 2
+#pragma anki extra_compiler_args -O3 -Vd
+#pragma anki technique vert pixel
+
+#if ANKI_VERTEX_SHADER
+float4 main() : SV_POSITION { return A; }
+#else
+float4 main() : SV_TARGET0 { return B; }
+#endif
+)";
+				return Error::kNone;
+			}
+		} fsystem;
+
+		// Compile without compiling the variants. No DXC is needed for that
+		ShaderBinary* binary = nullptr;
+		ANKI_TEST_EXPECT_NO_ERR(compileShaderProgram("Deferred.ankiprog", true, false, fsystem, nullptr, nullptr, {}, binary, nullptr, true));
+
+		ANKI_TEST_EXPECT_EQ(binary->m_codeBlocks.getSize(), 0);
+		ANKI_TEST_EXPECT_EQ(binary->m_variants.getSize(), 0);
+		ANKI_TEST_EXPECT_GT(binary->m_deferredSource.getSize(), 0);
+		ANKI_TEST_EXPECT_EQ(binary->m_mutations.getSize(), 6);
+		ANKI_TEST_EXPECT_EQ(CString(binary->m_deferredCompilerArgs.getBegin()), "-O3");
+
+		U32 skippedCount = 0;
+		for(const ShaderBinaryMutation& mutation : binary->m_mutations)
+		{
+			const Bool skip = mutation.m_values[0] == 1 && mutation.m_values[1] == 2;
+			ANKI_TEST_EXPECT_EQ(mutation.m_variantIndex, (skip) ? kMaxU32 : 0);
+			skippedCount += skip;
+		}
+		ANKI_TEST_EXPECT_EQ(skippedCount, 1);
+
+		// The runtime should generate the same sources as the offline compiler
+		ShaderParser parser("Deferred.ankiprog", &fsystem, {});
+		ANKI_TEST_EXPECT_NO_ERR(parser.parse());
+
+		const Array<MutatorValue, 2> mutation = {1, 1};
+		for(ShaderType shaderType : {ShaderType::kVertex, ShaderType::kPixel})
+		{
+			ShaderCompilerString offlineSource, runtimeSource;
+			parser.generateVariant(mutation, parser.getTechniques()[0], shaderType, offlineSource);
+			generateDeferredShaderSource(*binary, mutation, 0, shaderType, runtimeSource);
+			ANKI_TEST_EXPECT_EQ(offlineSource, runtimeSource);
+		}
+
+		freeShaderBinary(binary);
+	}
+
+	ShaderCompilerMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
@@ -55,3 +55,92 @@ ANKI_TEST(ShaderCompiler, ShaderCompilerParser)
 	// printf("%s\n", variant.getSource(ShaderType::kVertex).cstr());
 #endif
 }
+
+ANKI_TEST(ShaderCompiler, ShaderCompilerParserFileCache)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+	ShaderCompilerMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		class FilesystemInterface : public ShaderCompilerFilesystemInterface
+		{
+		public:
+			Atomic<U32> m_includeReadCount = {0};
+
+			Error readAllText(CString filename, ShaderCompilerString& txt) final
+			{
+				if(filename == "AnKi/Shaders/Include.hlsl")
+				{
+					m_includeReadCount.fetchAdd(1);
+					txt = R"(
+#pragma once
+float4 includedFunc() { return 1.0; }
+)";
+				}
+				else
+				{
+					txt = R"(
+#include <AnKi/Shaders/Include.hlsl>
+#include <AnKi/Shaders/Include.hlsl>
+#pragma anki mutator M0 1 2
+#pragma anki technique vert
+
+float4 main() : SV_POSITION { return includedFunc(); }
+)";
+				}
+
+				return Error::kNone;
+			}
+		} interface;
+
+		auto generateSource = [](const ShaderParser& parser, ShaderCompilerString& source) {
+			const Array<MutatorValue, 1> mutation = {2};
+			parser.generateVariant(mutation, parser.getTechniques()[0], ShaderType::kVertex, source);
+		};
+
+		// Parse without the cache for reference
+		ShaderParser refParser("Program.ankiprog", &interface, {});
+		ANKI_TEST_EXPECT_NO_ERR(refParser.parse());
+		ShaderCompilerString refSource;
+		generateSource(refParser, refSource);
+		ANKI_TEST_EXPECT_EQ(interface.m_includeReadCount.load(), 2);
+
+		// Many programs in parallel, they share the include
+		interface.m_includeReadCount.setNonAtomically(0);
+		ShaderParserFileCache cache;
+		constexpr U32 kProgramCount = 16;
+		Atomic<U32> mismatchCount = {0};
+		{
+			ThreadJobManager jobManager(4);
+			for(U32 i = 0; i < kProgramCount; ++i)
+			{
+				jobManager.dispatchTask([&]([[maybe_unused]] U32 threadIdx) {
+					ShaderParser parser("Program.ankiprog", &interface, {}, &cache);
+					if(parser.parse() || parser.getHash() != refParser.getHash())
+					{
+						mismatchCount.fetchAdd(1);
+						return;
+					}
+
+					ShaderCompilerString source;
+					generateSource(parser, source);
+					if(source != refSource)
+					{
+						mismatchCount.fetchAdd(1);
+					}
+				});
+			}
+			jobManager.waitForAllTasksToFinish();
+		}
+
+		ANKI_TEST_EXPECT_EQ(mismatchCount.load(), 0);
+		ANKI_TEST_EXPECT_EQ(cache.getFileCount(), 1);
+
+		// Some threads might have raced to load the include but it's never read per program
+		ANKI_TEST_EXPECT_LEQ(interface.m_includeReadCount.load(), 4);
+		ANKI_TEST_EXPECT_EQ(interface.m_includeReadCount.load(), cache.getMissCount());
+	}
+
+	ShaderCompilerMemoryPool::freeSingleton();
+	DefaultMemoryPool::freeSingleton();
+}
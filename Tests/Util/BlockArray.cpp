@@ -91,6 +91,31 @@ ANKI_TEST(Util, BlockArray)
 	ANKI_TEST_EXPECT_EQ(TestFoo::m_constructorCount, TestFoo::m_destructorCount);
 	ANKI_TEST_EXPECT_EQ(TestFoo::m_copyCount, 0);
 
+	// Reserve
+	TestFoo::reset();
+	{
+		BlockArray<TestFoo> arr;
+		arr.emplace(1);
+		arr.reserve(BlockArray<TestFoo>::kElementCountPerBlock * 3 + 1);
+		ANKI_TEST_EXPECT_EQ(arr.getBlockCount(), 4);
+		ANKI_TEST_EXPECT_EQ(arr.getSize(), 1);
+
+		for(U32 i = 0; i < BlockArray<TestFoo>::kElementCountPerBlock * 4 - 1; ++i)
+		{
+			arr.emplace(2);
+		}
+		ANKI_TEST_EXPECT_EQ(arr.getBlockCount(), 4);
+		arr.validate();
+
+		I64 sum = 0;
+		for(const TestFoo& f : arr)
+		{
+			sum += f.m_x;
+		}
+		ANKI_TEST_EXPECT_EQ(sum, 1 + 2 * (BlockArray<TestFoo>::kElementCountPerBlock * 4 - 1));
+	}
+	ANKI_TEST_EXPECT_EQ(TestFoo::m_constructorCount, TestFoo::m_destructorCount);
+
 	// Fuzzy
 	TestFoo::reset();
 	{
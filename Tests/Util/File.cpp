@@ -0,0 +1,149 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Util/File.h>
+#include <AnKi/Util/Filesystem.h>
+#include <AnKi/Util/AsyncFileReader.h>
+#include <AnKi/Util/ThreadJobManager.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/System.h>
+
+using namespace anki;
+
+static U8 filePattern(PtrSize offset)
+{
+	return U8((offset * 2654435761u) >> 24u);
+}
+
+static Error createPatternFile(CString filename, PtrSize size)
+{
+	DynamicArray<U8, SingletonMemoryPoolWrapper<DefaultMemoryPool>, PtrSize> data;
+	data.resize(size);
+	for(PtrSize i = 0; i < size; ++i)
+	{
+		data[i] = filePattern(i);
+	}
+
+	File file;
+	ANKI_CHECK(file.open(filename, FileOpenFlag::kWrite | FileOpenFlag::kBinary));
+	ANKI_CHECK(file.write(data.getBegin(), size));
+	return Error::kNone;
+}
+
+ANKI_TEST(Util, FileMap)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		constexpr PtrSize kSize = 1_MB + 3;
+		ANKI_TEST_EXPECT_NO_ERR(createPatternFile("./tmp_map.bin", kSize));
+
+		File file;
+		ANKI_TEST_EXPECT_NO_ERR(file.open("./tmp_map.bin", FileOpenFlag::kRead | FileOpenFlag::kBinary));
+
+		ConstWeakArray<U8, PtrSize> data;
+		ANKI_TEST_EXPECT_NO_ERR(file.map(data));
+		ANKI_TEST_EXPECT_EQ(data.getSize(), kSize);
+
+		Bool match = true;
+		for(PtrSize i = 0; i < kSize; ++i)
+		{
+			match = match && data[i] == filePattern(i);
+		}
+		ANKI_TEST_EXPECT_EQ(match, true);
+
+		// Mapping again returns the same view
+		ConstWeakArray<U8, PtrSize> data2;
+		ANKI_TEST_EXPECT_NO_ERR(file.map(data2));
+		ANKI_TEST_EXPECT_EQ(data2.getBegin(), data.getBegin());
+
+		// Positional reads don't care about the position indicator
+		Array<U8, 16> buff;
+		ANKI_TEST_EXPECT_NO_ERR(file.readAt(kSize - buff.getSize(), &buff[0], buff.getSize()));
+		ANKI_TEST_EXPECT_EQ(buff[15], filePattern(kSize - 1));
+		ANKI_TEST_EXPECT_EQ(file.tell(), 0);
+		ANKI_TEST_EXPECT_ERR(file.readAt(kSize - 1, &buff[0], 2), Error::kFileAccess);
+
+		file.close();
+		ANKI_TEST_EXPECT_NO_ERR(removeFile("./tmp_map.bin"));
+	}
+
+	DefaultMemoryPool::freeSingleton();
+}
+
+ANKI_TEST(Util, AsyncFileReader)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		constexpr PtrSize kSize = 16_MB;
+		constexpr PtrSize kChunkSize = 64_KB;
+		constexpr U32 kChunkCount = U32(kSize / kChunkSize);
+		ANKI_TEST_EXPECT_NO_ERR(createPatternFile("./tmp_async.bin", kSize));
+
+		File file;
+		ANKI_TEST_EXPECT_NO_ERR(file.open("./tmp_async.bin", FileOpenFlag::kRead | FileOpenFlag::kBinary));
+
+		ThreadJobManager jobManager(max(getCpuCoresCount(), 2u));
+
+		DynamicArray<U8, SingletonMemoryPoolWrapper<DefaultMemoryPool>, PtrSize> out;
+		out.resize(kSize);
+
+		// Read the chunks in reverse order and with more requests than the queue depth
+		DynamicArray<AsyncFileReadRequest> requests;
+		requests.resize(kChunkCount);
+		for(U32 i = 0; i < kChunkCount; ++i)
+		{
+			const PtrSize offset = (kChunkCount - i - 1) * kChunkSize;
+			requests[i].m_file = &file;
+			requests[i].m_offset = offset;
+			requests[i].m_buffer = &out[offset];
+			requests[i].m_size = kChunkSize;
+		}
+
+		auto test = [&](CString name, ThreadJobManager* manager, Bool useIoUring) {
+			memset(out.getBegin(), 0, kSize);
+
+			AsyncFileReader reader;
+			ANKI_TEST_EXPECT_NO_ERR(reader.init(manager, 16, useIoUring));
+			if(useIoUring && !reader.isUsingIoUring())
+			{
+				ANKI_TEST_LOGI("io_uring is not available");
+			}
+
+			HighRezTimer timer;
+			timer.start();
+			ANKI_TEST_EXPECT_NO_ERR(reader.submit(ConstWeakArray<AsyncFileReadRequest>(requests.getBegin(), kChunkCount / 2)));
+			ANKI_TEST_EXPECT_NO_ERR(reader.submit(ConstWeakArray<AsyncFileReadRequest>(&requests[kChunkCount / 2], kChunkCount / 2)));
+			ANKI_TEST_EXPECT_NO_ERR(reader.wait());
+			timer.stop();
+
+			Bool match = true;
+			for(PtrSize i = 0; i < kSize; ++i)
+			{
+				match = match && out[i] == filePattern(i);
+			}
+			ANKI_TEST_EXPECT_EQ(match, true);
+
+			// Reading past the end fails
+			AsyncFileReadRequest bad = requests[0];
+			bad.m_offset = kSize - 1;
+			ANKI_TEST_EXPECT_NO_ERR(reader.submit(ConstWeakArray<AsyncFileReadRequest>(&bad, 1)));
+			ANKI_TEST_EXPECT_ERR(reader.wait(), Error::kFileAccess);
+
+			ANKI_TEST_LOGI("%-12s: %u reads of %zuKB in %fms", name.cstr(), kChunkCount, kChunkSize / 1_KB, timer.getElapsedTime() * 1000.0);
+		};
+
+		test("io_uring", nullptr, true);
+		test("Thread pool", &jobManager, false);
+		test("Synchronous", nullptr, false);
+
+		file.close();
+		ANKI_TEST_EXPECT_NO_ERR(removeFile("./tmp_async.bin"));
+	}
+
+	DefaultMemoryPool::freeSingleton();
+}
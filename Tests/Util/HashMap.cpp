@@ -274,3 +274,36 @@ ANKI_TEST(Util, HashMap)
 		akMap.destroy();
 	}
 }
+
+ANKI_BENCHMARK(Util, HashMapEmplaceFind)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		constexpr U32 kCount = 1024;
+		DynamicArray<int> vals;
+		vals.resize(kCount);
+		for(U32 i = 0; i < kCount; ++i)
+		{
+			vals[i] = int(i * 7919);
+		}
+
+		while(bench.keepRunning())
+		{
+			HashMap<int, int, Hasher> map;
+			for(int v : vals)
+			{
+				map.emplace(v, v);
+			}
+
+			int sum = 0;
+			for(int v : vals)
+			{
+				sum += *map.find(v);
+			}
+			doNotOptimizeAway(sum);
+		}
+	}
+
+	DefaultMemoryPool::freeSingleton();
+}
@@ -0,0 +1,185 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Util/Logger.h>
+#include <AnKi/Util/File.h>
+#include <AnKi/Util/Filesystem.h>
+#include <AnKi/Util/ThreadJobManager.h>
+#include <AnKi/Util/HighRezTimer.h>
+
+using namespace anki;
+
+namespace {
+
+class CapturedMessages
+{
+public:
+	static constexpr U32 kMaxMessages = 4096;
+
+	Array<Array<Char, 128>, kMaxMessages> m_messages;
+	Array<LoggerMessageType, kMaxMessages> m_types;
+	U32 m_count = 0;
+
+	static void callback(void* userData, const LoggerMessageInfo& info)
+	{
+		CapturedMessages& self = *static_cast<CapturedMessages*>(userData);
+		if(self.m_count < kMaxMessages)
+		{
+			snprintf(&self.m_messages[self.m_count][0], 128, "%s", info.m_msg);
+			self.m_types[self.m_count] = info.m_type;
+			++self.m_count;
+		}
+	}
+};
+
+} // namespace
+
+ANKI_TEST(Util, AsyncLogger)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		Logger& logger = Logger::getSingleton();
+		CapturedMessages* captured = newInstance<CapturedMessages>(DefaultMemoryPool::getSingleton());
+
+		logger.enableSystemMessageHandler(false);
+		logger.addMessageHandler(captured, &CapturedMessages::callback);
+		logger.enableAsync(true);
+
+		// The deferred formatting should produce the same as printf. Use a temporary string to make sure the logger copies it
+		{
+			Array<Char, 16> tempStr;
+			snprintf(&tempStr[0], tempStr.getSize(), "temp");
+			const Char* nullStr = nullptr;
+
+			ANKI_LOGI("%d %i %u %x %X %o %c %% %s", -1, 42, 3000000000u, 255, 255, 8, 'z', &tempStr[0]);
+			tempStr[0] = 'X';
+			ANKI_LOGW("%hhd %hu %ld %lld %zu %llx", I8(-3), U16(65535), -1234567l, -123456789012ll, PtrSize(7), 0xABCDEF0123ull);
+			ANKI_LOGE("%f %.2f %8.3e %-6g| %Lf", 1.5, 3.14159, 12345.678, 0.5, 2.25l);
+			ANKI_LOGI("%*d|%-*s|%.*s|%5s", 5, 42, 6, "ab", 3, "abcdef", "x");
+			ANKI_LOGI("%s %p", nullStr, reinterpret_cast<void*>(0x1234));
+			ANKI_LOGI("No arguments");
+		}
+
+		logger.flush();
+		ANKI_TEST_EXPECT_EQ(captured->m_count, 6);
+
+		Array<Char, 128> expected;
+		snprintf(&expected[0], expected.getSize(), "%d %i %u %x %X %o %c %% %s", -1, 42, 3000000000u, 255, 255, 8, 'z', "temp");
+		ANKI_TEST_EXPECT_EQ(CString(&captured->m_messages[0][0]), CString(&expected[0]));
+		snprintf(&expected[0], expected.getSize(), "%hhd %hu %ld %lld %zu %llx", I8(-3), U16(65535), -1234567l, -123456789012ll, PtrSize(7),
+				 0xABCDEF0123ull);
+		ANKI_TEST_EXPECT_EQ(CString(&captured->m_messages[1][0]), CString(&expected[0]));
+		snprintf(&expected[0], expected.getSize(), "%f %.2f %8.3e %-6g| %Lf", 1.5, 3.14159, 12345.678, 0.5, 2.25l);
+		ANKI_TEST_EXPECT_EQ(CString(&captured->m_messages[2][0]), CString(&expected[0]));
+		ANKI_TEST_EXPECT_EQ(CString(&captured->m_messages[3][0]), "   42|ab    |abc|    x");
+		snprintf(&expected[0], expected.getSize(), "(null) %p", reinterpret_cast<void*>(0x1234));
+		ANKI_TEST_EXPECT_EQ(CString(&captured->m_messages[4][0]), CString(&expected[0]));
+		ANKI_TEST_EXPECT_EQ(CString(&captured->m_messages[5][0]), "No arguments");
+		ANKI_TEST_EXPECT_EQ(captured->m_types[1], LoggerMessageType::kWarning);
+		ANKI_TEST_EXPECT_EQ(captured->m_types[2], LoggerMessageType::kError);
+
+		// Many threads. The messages of a thread should stay in order
+		{
+			constexpr U32 kThreadCount = 4;
+			constexpr U32 kMessagesPerThread = 500;
+			captured->m_count = 0;
+
+			ThreadJobManager manager(kThreadCount);
+			for(U32 t = 0; t < kThreadCount; ++t)
+			{
+				manager.dispatchTask([t]([[maybe_unused]] U32 tid) {
+					for(U32 i = 0; i < kMessagesPerThread; ++i)
+					{
+						ANKI_LOGI("%u %u", t, i);
+					}
+				});
+			}
+			manager.waitForAllTasksToFinish();
+			logger.flush();
+
+			ANKI_TEST_EXPECT_EQ(captured->m_count, kThreadCount * kMessagesPerThread);
+
+			Array<U32, kThreadCount> nextMessage = {};
+			Bool inOrder = true;
+			for(U32 i = 0; i < captured->m_count; ++i)
+			{
+				U32 t, idx;
+				sscanf(&captured->m_messages[i][0], "%u %u", &t, &idx);
+				inOrder = inOrder && idx == nextMessage[t]++;
+			}
+			ANKI_TEST_EXPECT_EQ(inOrder, true);
+		}
+
+		logger.enableAsync(false);
+		logger.removeMessageHandler(captured, &CapturedMessages::callback);
+		logger.enableSystemMessageHandler(true);
+		deleteInstance(DefaultMemoryPool::getSingleton(), captured);
+	}
+
+	DefaultMemoryPool::freeSingleton();
+}
+
+ANKI_TEST(Util, AsyncLoggerThroughput)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		constexpr U32 kThreadCount = 4;
+		constexpr U32 kMessagesPerThread = 20000;
+
+		Logger& logger = Logger::getSingleton();
+		File file;
+		ANKI_TEST_EXPECT_NO_ERR(file.open("./tmp_log.txt", FileOpenFlag::kWrite));
+		logger.enableSystemMessageHandler(false);
+		logger.addFileMessageHandler(&file);
+
+		ThreadJobManager manager(kThreadCount);
+
+		auto bench = [&](Bool async) {
+			logger.enableAsync(async);
+
+			HighRezTimer timer;
+			timer.start();
+			for(U32 t = 0; t < kThreadCount; ++t)
+			{
+				manager.dispatchTask([t]([[maybe_unused]] U32 tid) {
+					for(U32 i = 0; i < kMessagesPerThread; ++i)
+					{
+						ANKI_LOGI("Loading resource %s from thread %u. Progress %f", "Assets/Meshes/Sponza.ankimesh", t, F32(i) / kMessagesPerThread);
+					}
+				});
+			}
+			manager.waitForAllTasksToFinish();
+			timer.stop();
+			const Second producerTime = timer.getElapsedTime();
+
+			timer.start();
+			logger.flush();
+			timer.stop();
+			const Second flushTime = timer.getElapsedTime();
+
+			logger.enableAsync(false);
+			return Array<Second, 2>{producerTime, flushTime};
+		};
+
+		const Array<Second, 2> syncTimes = bench(false);
+		const Array<Second, 2> asyncTimes = bench(true);
+
+		logger.removeFileMessageHandler(&file);
+		logger.enableSystemMessageHandler(true);
+
+		const U32 messageCount = kThreadCount * kMessagesPerThread;
+		ANKI_TEST_LOGI("Sync logger: %.1fns per message in the logging threads", syncTimes[0] * 1000000000.0 / messageCount);
+		ANKI_TEST_LOGI("Async logger: %.1fns per message in the logging threads, %fms to flush the rest", asyncTimes[0] * 1000000000.0 / messageCount,
+					   asyncTimes[1] * 1000.0);
+
+		file.close();
+		ANKI_TEST_EXPECT_NO_ERR(removeFile("./tmp_log.txt"));
+	}
+
+	DefaultMemoryPool::freeSingleton();
+}
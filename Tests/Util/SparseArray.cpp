@@ -464,3 +464,42 @@ ANKI_TEST(Util, SparseArrayBench)
 
 	akMap.destroy();
 }
+
+ANKI_BENCHMARK(Util, SparseArrayEmplaceFindErase)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		constexpr U32 kCount = 1024;
+		std::vector<int> vals(kCount);
+		for(U32 i = 0; i < kCount; ++i)
+		{
+			vals[i] = int(i * 7919);
+		}
+
+		using AkMap = SparseArray<int, SingletonMemoryPoolWrapper<DefaultMemoryPool>, Config<U32>>;
+		AkMap akMap(Config<U32>{256, U32(log2(256.0f)), 0.9f});
+
+		while(bench.keepRunning())
+		{
+			for(int v : vals)
+			{
+				akMap.emplace(v, v);
+			}
+
+			int sum = 0;
+			for(int v : vals)
+			{
+				sum += *akMap.find(v);
+			}
+			doNotOptimizeAway(sum);
+
+			for(int v : vals)
+			{
+				akMap.erase(akMap.find(v));
+			}
+		}
+	}
+
+	DefaultMemoryPool::freeSingleton();
+}
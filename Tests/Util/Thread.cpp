@@ -42,6 +42,43 @@ ANKI_TEST(Util, Thread)
 	ANKI_TEST_EXPECT_EQ(u, 0xF00);
 }
 
+ANKI_TEST(Util, ThreadIndex)
+{
+	class Ctx
+	{
+	public:
+		Array<U32, 2> m_indices = {kMaxU32, kMaxU32};
+		Barrier m_barrier = {2};
+	};
+
+	auto getIndex = [](ThreadCallbackInfo& info) -> Error {
+		Ctx& ctx = *static_cast<Ctx*>(info.m_userData);
+		const U32 slot = (std::strcmp(info.m_threadName, "1") == 0);
+		ctx.m_indices[slot] = Thread::getCurrentThreadIndex();
+		ctx.m_barrier.wait();
+		return Error::kNone;
+	};
+
+	// Threads that are alive at the same time have different indices
+	Ctx ctx;
+	Thread a("0");
+	Thread b("1");
+	a.start(&ctx, getIndex);
+	b.start(&ctx, getIndex);
+	ANKI_TEST_EXPECT_NO_ERR(a.join());
+	ANKI_TEST_EXPECT_NO_ERR(b.join());
+	ANKI_TEST_EXPECT_NEQ(ctx.m_indices[0], ctx.m_indices[1]);
+
+	// The indices of the threads that exited are given again
+	Ctx ctx2;
+	a.start(&ctx2, getIndex);
+	b.start(&ctx2, getIndex);
+	ANKI_TEST_EXPECT_NO_ERR(a.join());
+	ANKI_TEST_EXPECT_NO_ERR(b.join());
+	ANKI_TEST_EXPECT_NEQ(ctx2.m_indices[0], ctx2.m_indices[1]);
+	ANKI_TEST_EXPECT_LEQ(max(ctx2.m_indices[0], ctx2.m_indices[1]), max(ctx.m_indices[0], ctx.m_indices[1]));
+}
+
 ANKI_TEST(Util, Mutex)
 {
 	Thread t0(nullptr), t1(nullptr);
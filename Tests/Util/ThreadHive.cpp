@@ -251,3 +251,33 @@ ANKI_TEST(Util, ThreadHiveBench)
 	ANKI_TEST_LOGI("Total time %fms. Ground truth %fms", (timeB - timeA) * 1000.0, (timeC - timeB) * 1000.0);
 	ANKI_TEST_EXPECT_EQ(sum.getNonAtomically(), serialFib);
 }
+
+ANKI_BENCHMARK(Util, ThreadHiveSubmitWait)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		ThreadHive hive(getCpuCoresCount());
+
+		ThreadHiveTestContext ctx;
+		ctx.m_count = 0;
+
+		Array<ThreadHiveTask, 64> tasks;
+		for(ThreadHiveTask& task : tasks)
+		{
+			task.m_callback = [](void* arg, [[maybe_unused]] U32 threadId, [[maybe_unused]] ThreadHive& hive,
+								 [[maybe_unused]] ThreadHiveSemaphore* sem) {
+				static_cast<ThreadHiveTestContext*>(arg)->m_countAtomic.fetchAdd(1);
+			};
+			task.m_argument = &ctx;
+		}
+
+		while(bench.keepRunning())
+		{
+			hive.submitTasks(&tasks[0], tasks.getSize());
+			hive.waitAllTasks();
+		}
+	}
+
+	DefaultMemoryPool::freeSingleton();
+}
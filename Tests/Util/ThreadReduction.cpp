@@ -0,0 +1,211 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Util/ThreadReduction.h>
+#include <AnKi/Util/ThreadJobManager.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/System.h>
+
+using namespace anki;
+
+namespace {
+
+class PairUnion
+{
+public:
+	Array<I32, 2> operator()(const Array<I32, 2>& a, const Array<I32, 2>& b) const
+	{
+		return {min(a[0], b[0]), max(a[1], b[1])};
+	}
+};
+
+} // namespace
+
+/// Run a function from many tasks at the same time.
+template<typename TFunc>
+static void runOnAllThreads(ThreadJobManager& manager, TFunc func)
+{
+	for(U32 i = 0; i < manager.getThreadCount(); ++i)
+	{
+		manager.dispatchTask([&func, i]([[maybe_unused]] U32 tid) {
+			func(i);
+		});
+	}
+
+	manager.waitForAllTasksToFinish();
+}
+
+ANKI_TEST(Util, ThreadReduction)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		constexpr U32 kUpdateCount = 10000;
+		ThreadJobManager manager(max(getCpuCoresCount(), 4u));
+		const U32 threadCount = manager.getThreadCount();
+
+		ThreadReduction<U64, ThreadReductionSum> sum(0);
+		ThreadReduction<F64, ThreadReductionSum> sumf(0.0);
+		ThreadReduction<I32, ThreadReductionMin> minimum(kMaxI32);
+		ThreadReduction<I32, ThreadReductionMax> maximum(kMinI32);
+		ThreadReduction<Array<I32, 2>, PairUnion> bounds({kMaxI32, kMinI32});
+
+		// Less slots than threads so some of them will share
+		ThreadReduction<U64, ThreadReductionSum, 1> sharedSum(0);
+		ThreadReduction<Array<I32, 2>, PairUnion, 1> sharedBounds({kMaxI32, kMinI32});
+
+		runOnAllThreads(manager, [&](U32 taskIdx) {
+			for(U32 i = 0; i < kUpdateCount; ++i)
+			{
+				const I32 value = I32(taskIdx * kUpdateCount + i);
+				sum.update(1);
+				sumf.update(0.5);
+				minimum.update(value);
+				maximum.update(value);
+				bounds.update({value, value});
+				sharedSum.update(2);
+				sharedBounds.update({value, value});
+			}
+		});
+
+		const U64 updateCount = U64(threadCount) * kUpdateCount;
+		ANKI_TEST_EXPECT_EQ(sum.reduce(), updateCount);
+		ANKI_TEST_EXPECT_EQ(sumf.reduce(), F64(updateCount) * 0.5);
+		ANKI_TEST_EXPECT_EQ(minimum.reduce(), 0);
+		ANKI_TEST_EXPECT_EQ(maximum.reduce(), I32(updateCount - 1));
+		ANKI_TEST_EXPECT_EQ(bounds.reduce()[0], 0);
+		ANKI_TEST_EXPECT_EQ(bounds.reduce()[1], I32(updateCount - 1));
+		ANKI_TEST_EXPECT_EQ(sharedSum.reduce(), updateCount * 2);
+		ANKI_TEST_EXPECT_EQ(sharedBounds.reduce()[1], I32(updateCount - 1));
+
+		// With tryUpdate() the threads without a slot handle the value themselves. Two threads that are alive at the same time have different
+		// indices so at least one of them has no slot
+		class TryUpdateCtx
+		{
+		public:
+			ThreadReduction<U64, ThreadReductionSum, 1> m_trySum = {0};
+			Atomic<U64> m_fallbackSum = {0};
+			Barrier m_barrier = {2};
+		} ctx;
+
+		Array<Thread, 2> threads = {Thread("TryUpdate0"), Thread("TryUpdate1")};
+		for(Thread& thread : threads)
+		{
+			thread.start(&ctx, [](ThreadCallbackInfo& info) -> Error {
+				TryUpdateCtx& ctx = *static_cast<TryUpdateCtx*>(info.m_userData);
+				Thread::getCurrentThreadIndex();
+				ctx.m_barrier.wait();
+
+				for(U32 i = 0; i < kUpdateCount; ++i)
+				{
+					if(!ctx.m_trySum.tryUpdate(1))
+					{
+						ctx.m_fallbackSum.fetchAdd(1);
+					}
+				}
+
+				return Error::kNone;
+			});
+		}
+
+		for(Thread& thread : threads)
+		{
+			ANKI_TEST_EXPECT_NO_ERR(thread.join());
+		}
+
+		ANKI_TEST_EXPECT_GEQ(ctx.m_fallbackSum.load(), kUpdateCount);
+		ANKI_TEST_EXPECT_EQ(ctx.m_trySum.reduce() + ctx.m_fallbackSum.load(), 2 * kUpdateCount);
+
+		// Consume resets
+		ANKI_TEST_EXPECT_EQ(sum.consume(), updateCount);
+		ANKI_TEST_EXPECT_EQ(sum.reduce(), 0);
+		sum.update(10);
+		ANKI_TEST_EXPECT_EQ(sum.reduce(), 10);
+		sum.reset();
+		ANKI_TEST_EXPECT_EQ(sum.reduce(), 0);
+
+		// Consuming in parallel with the updates shouldn't lose any value
+		U64 consumed = 0;
+		Atomic<U32> doneCount = {0};
+		for(U32 t = 0; t < threadCount; ++t)
+		{
+			manager.dispatchTask([&]([[maybe_unused]] U32 tid) {
+				for(U32 i = 0; i < kUpdateCount; ++i)
+				{
+					sum.update(1);
+				}
+				doneCount.fetchAdd(1);
+			});
+		}
+
+		while(doneCount.load() < threadCount)
+		{
+			consumed += sum.consume();
+		}
+		manager.waitForAllTasksToFinish();
+		consumed += sum.consume();
+		ANKI_TEST_EXPECT_EQ(consumed, updateCount);
+	}
+
+	DefaultMemoryPool::freeSingleton();
+}
+
+ANKI_TEST(Util, ThreadReductionContention)
+{
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	{
+		constexpr U32 kUpdateCount = 1000000;
+		ThreadJobManager manager(max(getCpuCoresCount(), 4u));
+		const U32 threadCount = manager.getThreadCount();
+		const U64 updateCount = U64(threadCount) * kUpdateCount;
+
+		auto bench = [&](const Char* name, auto updateFunc) {
+			HighRezTimer timer;
+			timer.start();
+			runOnAllThreads(manager, [&]([[maybe_unused]] U32 taskIdx) {
+				for(U32 i = 0; i < kUpdateCount; ++i)
+				{
+					updateFunc();
+				}
+			});
+			timer.stop();
+			ANKI_TEST_LOGI("%-24s: %.2f ns/update (%u threads)", name, timer.getElapsedTime() * 1000000000.0 / F64(updateCount), threadCount);
+		};
+
+		// Integer sums
+		Atomic<U64> atomic = {0};
+		bench("Atomic<U64>", [&]() {
+			atomic.fetchAdd(1);
+		});
+
+		ThreadReduction<U64, ThreadReductionSum> sum(0);
+		bench("ThreadReduction<U64>", [&]() {
+			sum.update(1);
+		});
+
+		ANKI_TEST_EXPECT_EQ(atomic.load(), updateCount);
+		ANKI_TEST_EXPECT_EQ(sum.reduce(), updateCount);
+
+		// Float sums
+		SpinLock lock;
+		F64 lockedSum = 0.0;
+		bench("SpinLock F64", [&]() {
+			LockGuard guard(lock);
+			lockedSum += 1.0;
+		});
+
+		ThreadReduction<F64, ThreadReductionSum> sumf(0.0);
+		bench("ThreadReduction<F64>", [&]() {
+			sumf.update(1.0);
+		});
+
+		ANKI_TEST_EXPECT_EQ(lockedSum, F64(updateCount));
+		ANKI_TEST_EXPECT_EQ(sumf.reduce(), F64(updateCount));
+	}
+
+	DefaultMemoryPool::freeSingleton();
+}
@@ -18,6 +18,8 @@ Options:
 -lod-factor <float>        : The decimate factor for each LOD. Default 0.25
 -light-scale <float>       : Multiply the light intensity with this number. Default is 1.0
 -import-textures <0|1>     : Import textures. Default is 0
+-binary-scene <0|1>        : Also write the scene in the binary format (Scene.ankiscene). Default is 0
+-incremental <0|1>         : Skip the resources that haven't changed since the last import. Default is 0
 -v                         : Enable verbose log
 )";
 
@@ -31,6 +33,8 @@ public:
 	Bool m_optimizeMeshes = true;
 	Bool m_optimizeAnimations = true;
 	Bool m_importTextures = false;
+	Bool m_writeBinaryScene = false;
+	Bool m_incremental = false;
 	U32 m_threadCount = kMaxU32;
 	U32 m_lodCount = 1;
 	F32 m_lodFactor = 0.25f;
@@ -198,6 +202,36 @@ static Error parseCommandLineArgs(int argc, char** argv, CmdLineArgs& info)
 				return Error::kUserData;
 			}
 		}
+		else if(strcmp(argv[i], "-binary-scene") == 0)
+		{
+			++i;
+
+			if(i < argc)
+			{
+				I val = 1;
+				ANKI_CHECK(CString(argv[i]).toNumber(val));
+				info.m_writeBinaryScene = val != 0;
+			}
+			else
+			{
+				return Error::kUserData;
+			}
+		}
+		else if(strcmp(argv[i], "-incremental") == 0)
+		{
+			++i;
+
+			if(i < argc)
+			{
+				I val = 1;
+				ANKI_CHECK(CString(argv[i]).toNumber(val));
+				info.m_incremental = val != 0;
+			}
+			else
+			{
+				return Error::kUserData;
+			}
+		}
 		else
 		{
 			return Error::kUserData;
@@ -271,6 +305,8 @@ int myMain(int argc, char** argv)
 	initInfo.m_threadCount = cmdArgs.m_threadCount;
 	initInfo.m_comment = comment;
 	initInfo.m_importTextures = cmdArgs.m_importTextures;
+	initInfo.m_writeBinaryScene = cmdArgs.m_writeBinaryScene;
+	initInfo.m_incremental = cmdArgs.m_incremental;
 
 	GltfImporter importer;
 	if(importer.init(initInfo))
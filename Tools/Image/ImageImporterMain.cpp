@@ -5,6 +5,8 @@
 
 #include <AnKi/Importer/ImageImporter.h>
 #include <AnKi/Util/Filesystem.h>
+#include <AnKi/Util/ThreadJobManager.h>
+#include <AnKi/Util/System.h>
 
 using namespace anki;
 
@@ -15,6 +17,8 @@ class Cleanup
 public:
 	DynamicArray<CString> m_inputFilenames;
 	String m_outFilename;
+	Bool m_useCompressonator = false;
+	U32 m_threadCount = getCpuCoresCount();
 };
 
 } // namespace
@@ -35,6 +39,9 @@ Options:
 -flip-image <0|1>      : Flip the image. Default is 1
 -hdr-scale <3 floats>  : Apply some scale to HDR images. Default is {1 1 1}
 -hdr-bias <3 floats>   : Apply some bias to HDR images. Default is {0 0 0}
+-s3tc-quality <q>      : Quality of the S3TC encoder. One of: fast, normal, high. Default is normal
+-compressonator <0|1>  : Use compressonator instead of the built-in S3TC encoder. Default is 0
+-j <thread count>      : Number of threads to compress with. Default is the number of cores
 )";
 
 static Error parseCommandLineArgs(int argc, char** argv, ImageImporterConfig& config, Cleanup& cleanup)
@@ -253,6 +260,66 @@ static Error parseCommandLineArgs(int argc, char** argv, ImageImporterConfig& co
 			ANKI_CHECK(CString(argv[i]).toNumber(z));
 			config.m_hdrBias = Vec3(x, y, z);
 		}
+		else if(CString(argv[i]) == "-s3tc-quality")
+		{
+			++i;
+			if(i >= argc)
+			{
+				return Error::kUserData;
+			}
+
+			if(CString(argv[i]) == "fast")
+			{
+				config.m_s3tcQuality = S3tcEncoderQuality::kFast;
+			}
+			else if(CString(argv[i]) == "normal")
+			{
+				config.m_s3tcQuality = S3tcEncoderQuality::kNormal;
+			}
+			else if(CString(argv[i]) == "high")
+			{
+				config.m_s3tcQuality = S3tcEncoderQuality::kHigh;
+			}
+			else
+			{
+				return Error::kUserData;
+			}
+		}
+		else if(CString(argv[i]) == "-compressonator")
+		{
+			++i;
+			if(i >= argc)
+			{
+				return Error::kUserData;
+			}
+
+			if(CString(argv[i]) == "1")
+			{
+				cleanup.m_useCompressonator = true;
+			}
+			else if(CString(argv[i]) == "0")
+			{
+				cleanup.m_useCompressonator = false;
+			}
+			else
+			{
+				return Error::kUserData;
+			}
+		}
+		else if(CString(argv[i]) == "-j")
+		{
+			++i;
+			if(i >= argc)
+			{
+				return Error::kUserData;
+			}
+
+			ANKI_CHECK(CString(argv[i]).toNumber(cleanup.m_threadCount));
+			if(cleanup.m_threadCount == 0)
+			{
+				return Error::kUserData;
+			}
+		}
 		else
 		{
 			// Probably input, break
@@ -328,15 +395,23 @@ int myMain(int argc, char** argv)
 	config.m_tempDirectory = tmp;
 
 #if ANKI_OS_WINDOWS
-	config.m_compressonatorFilename = ANKI_SOURCE_DIRECTORY "/ThirdParty/Bin/Windows64/Compressonator/compressonatorcli.exe";
+	const CString compressonatorFilename = ANKI_SOURCE_DIRECTORY "/ThirdParty/Bin/Windows64/Compressonator/compressonatorcli.exe";
 	config.m_astcencFilename = ANKI_SOURCE_DIRECTORY "/ThirdParty/Bin/Windows64/astcenc-avx2.exe";
 #elif ANKI_OS_LINUX
-	config.m_compressonatorFilename = ANKI_SOURCE_DIRECTORY "/ThirdParty/Bin/Linux64/Compressonator/compressonatorcli";
+	const CString compressonatorFilename = ANKI_SOURCE_DIRECTORY "/ThirdParty/Bin/Linux64/Compressonator/compressonatorcli";
 	config.m_astcencFilename = ANKI_SOURCE_DIRECTORY "/ThirdParty/Bin/Linux64/astcenc-avx2";
 #else
 #	error "Unupported"
 #endif
 
+	if(cleanup.m_useCompressonator)
+	{
+		config.m_compressonatorFilename = compressonatorFilename;
+	}
+
+	ThreadJobManager jobManager(cleanup.m_threadCount);
+	config.m_jobManager = &jobManager;
+
 	ANKI_IMPORTER_LOGI("Image importing started: %s", config.m_outFilename.cstr());
 
 	if(importImage(config))
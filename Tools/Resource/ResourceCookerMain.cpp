@@ -0,0 +1,187 @@
+// Copyright (C) 2009-present, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Resource/ResourceDescriptor.h>
+#include <AnKi/Util.h>
+using namespace anki;
+
+static constexpr const char* kUsage = R"(Compile the XML descriptors of the resources to their binary form
+Usage: %s [options] input
+The input is a descriptor file or a directory. If it's a directory all the descriptors in it will be cooked and the output is a directory with
+the same structure. The cooked files keep their names so the resources that reference them don't need to change.
+Options:
+-o <output>  : The output file or directory. Required
+-v           : Verbose log
+)";
+
+static constexpr Array<CString, 6> kDescriptorExtensions = {"ankimtl", "ankimdl", "ankipart", "ankiskel", "ankianim", "ankiatex"};
+
+class CmdLineArgs
+{
+public:
+	String m_input;
+	String m_output;
+	Bool m_verbose = false;
+};
+
+static Error parseCommandLineArgs(int argc, char** argv, CmdLineArgs& info)
+{
+	// Parse config
+	if(argc < 2)
+	{
+		return Error::kUserData;
+	}
+
+	for(I i = 1; i < argc - 1; i++)
+	{
+		if(strcmp(argv[i], "-o") == 0)
+		{
+			++i;
+
+			if(i < argc && std::strlen(argv[i]) > 0)
+			{
+				info.m_output = argv[i];
+			}
+			else
+			{
+				return Error::kUserData;
+			}
+		}
+		else if(strcmp(argv[i], "-v") == 0)
+		{
+			info.m_verbose = true;
+		}
+		else
+		{
+			return Error::kUserData;
+		}
+	}
+
+	info.m_input = argv[argc - 1];
+
+	if(info.m_output.isEmpty())
+	{
+		return Error::kUserData;
+	}
+
+	return Error::kNone;
+}
+
+static Bool isDescriptor(CString filename)
+{
+	String ext;
+	getFilepathExtension(filename, ext);
+	for(CString descExt : kDescriptorExtensions)
+	{
+		if(ext == descExt)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static Error cookFile(CString in, CString out)
+{
+	StackMemoryPool pool(allocAligned, nullptr, 64_KB);
+	ResourceDescriptorCooker cooker(pool);
+	const Error err = cooker.cookFile(in, out);
+	if(err)
+	{
+		ANKI_LOGE("Failed to cook: %s", in.cstr());
+	}
+
+	return err;
+}
+
+static Error work(const CmdLineArgs& info)
+{
+	if(!directoryExists(info.m_input))
+	{
+		return cookFile(info.m_input, info.m_output);
+	}
+
+	if(!directoryExists(info.m_output))
+	{
+		ANKI_CHECK(createDirectory(info.m_output));
+	}
+
+	U32 cookedCount = 0;
+	U32 failedCount = 0;
+	ANKI_CHECK(walkDirectoryTree(info.m_input, [&](CString fname, Bool isDir) -> Error {
+		String in, out;
+		in.sprintf("%s/%s", info.m_input.cstr(), fname.cstr());
+		out.sprintf("%s/%s", info.m_output.cstr(), fname.cstr());
+
+		if(isDir)
+		{
+			// The walk visits the parents before their children
+			if(!directoryExists(out))
+			{
+				ANKI_CHECK(createDirectory(out));
+			}
+		}
+		else if(isDescriptor(fname))
+		{
+			if(info.m_verbose)
+			{
+				ANKI_LOGI("Cooking %s", in.cstr());
+			}
+
+			// Keep going to report all the broken descriptors at once
+			if(cookFile(in, out))
+			{
+				++failedCount;
+			}
+			else
+			{
+				++cookedCount;
+			}
+		}
+
+		return Error::kNone;
+	}));
+
+	ANKI_LOGI("Cooked %u descriptors", cookedCount);
+
+	if(failedCount)
+	{
+		ANKI_LOGE("Failed to cook %u descriptors", failedCount);
+		return Error::kUserData;
+	}
+
+	return Error::kNone;
+}
+
+ANKI_MAIN_FUNCTION(myMain)
+int myMain(int argc, char** argv)
+{
+	class Dummy
+	{
+	public:
+		~Dummy()
+		{
+			DefaultMemoryPool::freeSingleton();
+		}
+	} dummy;
+
+	DefaultMemoryPool::allocateSingleton(allocAligned, nullptr);
+
+	CmdLineArgs info;
+	if(parseCommandLineArgs(argc, argv, info))
+	{
+		ANKI_LOGE(kUsage, argv[0]);
+		return 1;
+	}
+
+	if(work(info))
+	{
+		ANKI_LOGE("Cooking failed");
+		return 1;
+	}
+
+	return 0;
+}
@@ -4,25 +4,28 @@
 // http://www.anki3d.org/LICENSE
 
 #include <AnKi/ShaderCompiler/ShaderCompiler.h>
+#include <AnKi/ShaderCompiler/ShaderParser.h>
 #include <AnKi/Util.h>
 using namespace anki;
 
-static constexpr const char* kUsage = R"(Compile an AnKi shader program
-Usage: %s [options] input_shader_program_file
+static constexpr const char* kUsage = R"(Compile AnKi shader programs
+Usage: %s [options] input_shader_program_file0 [input_shader_program_file1 ...]
+Many programs are compiled in parallel and they share the parsed includes.
 Options:
--o <name of output>  : The name of the output binary
+-o <name of output>  : The name of the output binary. If there are many inputs it's the output directory
 -j <thread count>    : Number of threads. Defaults to system's max
 -I <include path>    : The path of the #include files
 -D<define_name:val>  : Extra defines to pass to the compiler
 -spirv               : Compile SPIR-V
 -dxil                : Compile DXIL
 -g                   : Include debug info
+-deferred            : Don't compile the variants. The engine will compile the variants it needs at runtime
 )";
 
 class CmdLineArgs
 {
 public:
-	String m_inputFname;
+	DynamicArray<String> m_inputFnames;
 	String m_outFname;
 	String m_includePath;
 	U32 m_threadCount = getCpuCoresCount();
@@ -31,6 +34,7 @@ public:
 	Bool m_spirv = false;
 	Bool m_dxil = false;
 	Bool m_debugInfo = false;
+	Bool m_deferVariants = false;
 };
 
 static Error parseCommandLineArgs(int argc, char** argv, CmdLineArgs& info)
@@ -41,9 +45,13 @@ static Error parseCommandLineArgs(int argc, char** argv, CmdLineArgs& info)
 		return Error::kUserData;
 	}
 
-	for(I i = 1; i < argc - 1; i++)
+	for(I i = 1; i < argc; i++)
 	{
-		if(strcmp(argv[i], "-o") == 0)
+		if(argv[i][0] != '-')
+		{
+			info.m_inputFnames.emplaceBack(argv[i]);
+		}
+		else if(strcmp(argv[i], "-o") == 0)
 		{
 			++i;
 
@@ -136,88 +144,118 @@ static Error parseCommandLineArgs(int argc, char** argv, CmdLineArgs& info)
 		{
 			info.m_debugInfo = true;
 		}
+		else if(strcmp(argv[i], "-deferred") == 0)
+		{
+			info.m_deferVariants = true;
+		}
 		else
 		{
 			return Error::kUserData;
 		}
 	}
 
-	info.m_inputFname = argv[argc - 1];
+	if(info.m_inputFnames.getSize() == 0)
+	{
+		return Error::kUserData;
+	}
 
 	return Error::kNone;
 }
 
-static Error work(const CmdLineArgs& info)
+class FSystem : public ShaderCompilerFilesystemInterface
 {
-	HeapMemoryPool pool(allocAligned, nullptr, "ProgramPool");
+public:
+	CString m_inputFname;
+	CString m_includePath;
 
-	// Load interface
-	class FSystem : public ShaderCompilerFilesystemInterface
+	Error readAllTextInternal(CString filename, ShaderCompilerString& txt)
 	{
-	public:
-		CString m_includePath;
-		U32 m_fileReadCount = 0;
+		String fname;
 
-		Error readAllTextInternal(CString filename, ShaderCompilerString& txt)
+		// The input file is not an include. Don't append the include path to it
+		if(filename == m_inputFname)
 		{
-			String fname;
+			fname.sprintf("%s", filename.cstr());
+		}
+		else
+		{
+			fname.sprintf("%s/%s", m_includePath.cstr(), filename.cstr());
+		}
 
-			// The first file is the input file. Don't append the include path to it
-			if(m_fileReadCount == 0)
-			{
-				fname.sprintf("%s", filename.cstr());
-			}
-			else
-			{
-				fname.sprintf("%s/%s", m_includePath.cstr(), filename.cstr());
-			}
-			++m_fileReadCount;
+		File file;
+		ANKI_CHECK(file.open(fname, FileOpenFlag::kRead));
+		ANKI_CHECK(file.readAllText(txt));
+		return Error::kNone;
+	}
 
-			File file;
-			ANKI_CHECK(file.open(fname, FileOpenFlag::kRead));
-			ANKI_CHECK(file.readAllText(txt));
-			return Error::kNone;
+	Error readAllText(CString filename, ShaderCompilerString& txt) final
+	{
+		const Error err = readAllTextInternal(filename, txt);
+		if(err)
+		{
+			ANKI_LOGE("Failed to read file: %s", filename.cstr());
 		}
 
-		Error readAllText(CString filename, ShaderCompilerString& txt) final
-		{
-			const Error err = readAllTextInternal(filename, txt);
-			if(err)
-			{
-				ANKI_LOGE("Failed to read file: %s", filename.cstr());
-			}
+		return err;
+	}
+};
 
-			return err;
-		}
-	} fsystem;
-	fsystem.m_includePath = info.m_includePath;
+/// Runs the variants of a single program in a job manager that is shared with other programs.
+class TaskManager : public ShaderCompilerAsyncTaskInterface
+{
+public:
+	ThreadJobManager* m_jobManager = nullptr;
+	U32 m_tasksInFlightCount = 0; ///< Protected by m_tasksInFlightMtx.
+	Mutex m_tasksInFlightMtx;
+	ConditionVariable m_tasksInFlightCond; ///< Signaled when the last task of this program finishes.
 
-	// Threading interface
-	class TaskManager : public ShaderCompilerAsyncTaskInterface
+	void enqueueTask(void (*callback)(void* userData), void* userData) final
 	{
-	public:
-		UniquePtr<ThreadJobManager, SingletonMemoryPoolDeleter<DefaultMemoryPool>> m_jobManager;
-
-		void enqueueTask(void (*callback)(void* userData), void* userData) final
 		{
-			m_jobManager->dispatchTask([callback, userData]([[maybe_unused]] U32 threadIdx) {
-				callback(userData);
-			});
+			LockGuard lock(m_tasksInFlightMtx);
+			++m_tasksInFlightCount;
 		}
 
-		Error joinTasks()
+		m_jobManager->dispatchTask([this, callback, userData]([[maybe_unused]] U32 threadIdx) {
+			callback(userData);
+
+			// Signal with the lock held so the task manager can't be destroyed before the notification
+			LockGuard lock(m_tasksInFlightMtx);
+			ANKI_ASSERT(m_tasksInFlightCount > 0);
+			if(--m_tasksInFlightCount == 0)
+			{
+				m_tasksInFlightCond.notifyAll();
+			}
+		});
+	}
+
+	Error joinTasks() final
+	{
+		// Wait only for the tasks of this program. The rest of the job manager might be busy with other programs
+		LockGuard lock(m_tasksInFlightMtx);
+		while(m_tasksInFlightCount != 0)
 		{
-			m_jobManager->waitForAllTasksToFinish();
-			return Error::kNone;
+			m_tasksInFlightCond.wait(m_tasksInFlightMtx);
 		}
-	} taskManager;
-	taskManager.m_jobManager.reset((info.m_threadCount) ? newInstance<ThreadJobManager>(DefaultMemoryPool::getSingleton(), info.m_threadCount, true)
-														: nullptr);
+
+		return Error::kNone;
+	}
+};
+
+static Error compileProgram(const CmdLineArgs& info, CString inputFname, CString outFname, ThreadJobManager* jobManager,
+							ShaderParserFileCache& fileCache)
+{
+	FSystem fsystem;
+	fsystem.m_inputFname = inputFname;
+	fsystem.m_includePath = info.m_includePath;
+
+	TaskManager taskManager;
+	taskManager.m_jobManager = jobManager;
 
 	// Compile
 	ShaderBinary* binary = nullptr;
-	ANKI_CHECK(compileShaderProgram(info.m_inputFname, info.m_spirv, info.m_debugInfo, fsystem, nullptr,
-									(info.m_threadCount) ? &taskManager : nullptr, info.m_defines, binary));
+	ANKI_CHECK(compileShaderProgram(inputFname, info.m_spirv, info.m_debugInfo, fsystem, nullptr, (jobManager) ? &taskManager : nullptr,
+									info.m_defines, binary, &fileCache, info.m_deferVariants));
 
 	class Dummy
 	{
@@ -233,7 +271,7 @@ static Error work(const CmdLineArgs& info)
 	// Store the binary
 	{
 		File file;
-		ANKI_CHECK(file.open(info.m_outFname, FileOpenFlag::kWrite | FileOpenFlag::kBinary));
+		ANKI_CHECK(file.open(outFname, FileOpenFlag::kWrite | FileOpenFlag::kBinary));
 
 		BinarySerializer serializer;
 		ANKI_CHECK(serializer.serialize(*binary, ShaderCompilerMemoryPool::getSingleton(), file));
@@ -242,6 +280,68 @@ static Error work(const CmdLineArgs& info)
 	return Error::kNone;
 }
 
+static Error work(const CmdLineArgs& info)
+{
+	// All the programs share the parsed includes and the threads that compile the variants
+	ShaderParserFileCache fileCache;
+	UniquePtr<ThreadJobManager, SingletonMemoryPoolDeleter<DefaultMemoryPool>> jobManager(
+		(info.m_threadCount) ? newInstance<ThreadJobManager>(DefaultMemoryPool::getSingleton(), info.m_threadCount, true) : nullptr);
+
+	const U32 programCount = info.m_inputFnames.getSize();
+	if(programCount == 1)
+	{
+		return compileProgram(info, info.m_inputFnames[0], info.m_outFname, jobManager.get(), fileCache);
+	}
+
+	DynamicArray<String> outFnames;
+	outFnames.resize(programCount);
+	for(U32 i = 0; i < programCount; ++i)
+	{
+		String filename;
+		getFilepathFilename(info.m_inputFnames[i], filename);
+		outFnames[i].sprintf("%s/%sbin", info.m_outFname.cstr(), filename.cstr());
+	}
+
+	// Compile many programs at the same time. These threads mostly parse and wait for their variants so they don't compete much with the
+	// threads of the job manager
+	Atomic<U32> failedCount = {0};
+	auto compile = [&](U32 i) {
+		if(compileProgram(info, info.m_inputFnames[i], outFnames[i], jobManager.get(), fileCache))
+		{
+			failedCount.fetchAdd(1);
+		}
+	};
+
+	if(jobManager)
+	{
+		ThreadJobManager programJobManager(min(programCount, info.m_threadCount));
+		for(U32 i = 0; i < programCount; ++i)
+		{
+			programJobManager.dispatchTask([&, i]([[maybe_unused]] U32 threadIdx) {
+				compile(i);
+			});
+		}
+		programJobManager.waitForAllTasksToFinish();
+	}
+	else
+	{
+		for(U32 i = 0; i < programCount; ++i)
+		{
+			compile(i);
+		}
+	}
+
+	ANKI_LOGV("Compiled %u programs. %u files were included", programCount, fileCache.getFileCount());
+
+	if(failedCount.load())
+	{
+		ANKI_LOGE("%u programs failed to compile", failedCount.load());
+		return Error::kFunctionFailed;
+	}
+
+	return Error::kNone;
+}
+
 ANKI_MAIN_FUNCTION(myMain)
 int myMain(int argc, char** argv)
 {
@@ -273,8 +373,15 @@ int myMain(int argc, char** argv)
 
 	if(info.m_outFname.isEmpty())
 	{
-		getFilepathFilename(info.m_inputFname, info.m_outFname);
-		info.m_outFname += "bin";
+		if(info.m_inputFnames.getSize() == 1)
+		{
+			getFilepathFilename(info.m_inputFnames[0], info.m_outFname);
+			info.m_outFname += "bin";
+		}
+		else
+		{
+			info.m_outFname = ".";
+		}
 	}
 
 	if(info.m_includePath.isEmpty())